@@ -49,6 +49,27 @@ macro(MITK_CREATE_MODULE_TESTS)
                            NO_FEATURE_INFO NO_BATCH_FILE ${_no_init})
     set_property(TARGET ${EXECUTABLE_TARGET} PROPERTY FOLDER "${MITK_ROOT_FOLDER}/Modules/Tests")
 
+    #
+    # The benchmarks listed in MODULE_BENCHMARKS are built into a driver of their own, which
+    # is not run by ctest. Call it with the name of a benchmark, like the test driver.
+    #
+    if(MITK_BUILD_BENCHMARKS AND MODULE_BENCHMARKS)
+      set(_testdriver ${TESTDRIVER})
+      set(TESTDRIVER ${MODULE_NAME}BenchmarkDriver)
+      set(MODULE_TEST_BENCHMARK_DRIVER ON)
+      set(_benchmarkdriver_file_list ${CMAKE_CURRENT_BINARY_DIR}/benchmarkdriver_files.cmake)
+      configure_file(${MITK_CMAKE_DIR}/mitkTestDriverFiles.cmake.in ${_benchmarkdriver_file_list} @ONLY)
+      mitk_create_executable(${TESTDRIVER}
+                             DEPENDS ${MODULE_NAME} ${MODULE_TEST_DEPENDS} ${MODULE_TEST_EXTRA_DEPENDS} MitkTestingHelper
+                             PACKAGE_DEPENDS ${MODULE_TEST_PACKAGE_DEPENDS}
+                             SUBPROJECTS ${MODULE_SUBPROJECTS}
+                             FILES_CMAKE ${_benchmarkdriver_file_list}
+                             NO_FEATURE_INFO NO_BATCH_FILE ${_no_init})
+      set_property(TARGET ${EXECUTABLE_TARGET} PROPERTY FOLDER "${MITK_ROOT_FOLDER}/Modules/Benchmarks")
+      set(MODULE_TEST_BENCHMARK_DRIVER OFF)
+      set(TESTDRIVER ${_testdriver})
+    endif()
+
     #
     # Now tell CMake which tests should be run. This is done automatically
     # for all tests in ${KITNAME}_TESTS and ${KITNAME}_IMAGE_TESTS. The IMAGE_TESTS
@@ -22,6 +22,7 @@ found in the LICENSE file.
 #include <mitkCommandLineParser.h>
 
 #include <mitkIntensityQuantifier.h>
+#include <mitkIntensityQuantifierCache.h>
 
 // STD Includes
 
@@ -188,6 +189,14 @@ public:
   itkSetMacro(Quantifier, IntensityQuantifier::Pointer);
   itkGetMacro(Quantifier, IntensityQuantifier::Pointer);
 
+  /**
+  * \brief Cache that is used by InitializeQuantifier. If set, the quantifier is taken from the
+  * cache if another feature class already initialized one with the same settings for the same
+  * image and mask. Feature classes that share a cache can be calculated concurrently.
+  */
+  itkSetMacro(QuantifierCache, IntensityQuantifierCache::Pointer);
+  itkGetMacro(QuantifierCache, IntensityQuantifierCache::Pointer);
+
   itkGetConstMacro(Direction, int);
 
   itkSetMacro(MinimumIntensity, double);
@@ -235,6 +244,10 @@ public:
   void InitializeQuantifier(const Image::Pointer & feature, const Image::Pointer &mask, unsigned int defaultBins = 256);
   std::string QuantifierParameterString();
 
+private:
+  void InitializeQuantifierInstance(IntensityQuantifier *quantifier, const Image::Pointer & feature, const Image::Pointer &mask, unsigned int defaultBins);
+  std::string QuantifierCacheKey(const Image::Pointer & feature, const Image::Pointer &mask, unsigned int defaultBins);
+
 public:
 
 //#ifndef DOXYGEN_SKIP
@@ -265,6 +278,7 @@ private:
 
   bool m_UseQuantifier = false;
   IntensityQuantifier::Pointer m_Quantifier;
+  IntensityQuantifierCache::Pointer m_QuantifierCache;
 
   double m_MinimumIntensity = 0;
   bool m_UseMinimumIntensity = false;
@@ -0,0 +1,79 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+
+#ifndef mitkIntensityQuantifierCache_h
+#define mitkIntensityQuantifierCache_h
+
+#include <MitkCLCoreExports.h>
+
+#include <mitkCommon.h>
+#include <mitkIntensityQuantifier.h>
+
+#include <itkObject.h>
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace mitk
+{
+  /**
+  * \brief Thread safe store of initialized intensity quantifiers.
+  *
+  * Most feature classes initialize their quantifier from the minimum and maximum of the
+  * (masked) image, which requires a complete pass over the image and the mask. If several
+  * feature classes share one cache (see AbstractGlobalImageFeature::SetQuantifierCache), a
+  * quantifier with the same settings for the same image and mask is only initialized once
+  * and then reused by all of them. The quantifiers returned by the cache must not be
+  * reinitialized.
+  */
+class MITKCLCORE_EXPORT IntensityQuantifierCache : public itk::Object
+{
+public:
+  mitkClassMacroItkParent(IntensityQuantifierCache, itk::Object);
+  itkFactorylessNewMacro(Self);
+
+  typedef std::function<void(IntensityQuantifier*)> InitializerType;
+
+  /**
+  * \brief Returns the quantifier stored for the given key. If there is none, a new quantifier is
+  * created and initialized by the passed function. Concurrent requests for the same key wait
+  * until the first one has finished the initialization.
+  */
+  IntensityQuantifier::Pointer GetQuantifier(const std::string &key, const InitializerType &initializer);
+
+  /**
+  * \brief Removes all stored quantifiers.
+  */
+  void Clear();
+
+  std::size_t GetNumberOfQuantifiers() const;
+
+protected:
+  IntensityQuantifierCache() = default;
+  ~IntensityQuantifierCache() override = default;
+
+private:
+  struct Entry
+  {
+    std::once_flag initialized;
+    IntensityQuantifier::Pointer quantifier;
+  };
+
+  mutable std::mutex m_Mutex;
+  std::map<std::string, std::shared_ptr<Entry> > m_Entries;
+};
+}
+
+#endif //mitkIntensityQuantifierCache_h
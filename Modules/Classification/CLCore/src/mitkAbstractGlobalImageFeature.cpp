@@ -227,46 +227,79 @@ void  mitk::AbstractGlobalImageFeature::InitializeQuantifierFromParameters(const
 
 void  mitk::AbstractGlobalImageFeature::InitializeQuantifier(const Image::Pointer & feature, const Image::Pointer &mask, unsigned int defaultBins)
 {
-  m_Quantifier = IntensityQuantifier::New();
+  if (m_QuantifierCache.IsNull())
+  {
+    m_Quantifier = IntensityQuantifier::New();
+    InitializeQuantifierInstance(m_Quantifier, feature, mask, defaultBins);
+    return;
+  }
+
+  m_Quantifier = m_QuantifierCache->GetQuantifier(QuantifierCacheKey(feature, mask, defaultBins),
+    [this, &feature, &mask, defaultBins](IntensityQuantifier *quantifier)
+    {
+      this->InitializeQuantifierInstance(quantifier, feature, mask, defaultBins);
+    });
+}
+
+std::string mitk::AbstractGlobalImageFeature::QuantifierCacheKey(const Image::Pointer & feature, const Image::Pointer &mask, unsigned int defaultBins)
+{
+  // The modification times ensure that a new image at the address of a
+  // deleted one does not reuse its quantifier.
+  std::stringstream ss;
+  ss << feature.GetPointer() << "_" << feature->GetMTime() << "_";
+  if (mask.IsNotNull())
+  {
+    ss << mask.GetPointer() << "_" << mask->GetMTime();
+  }
+  ss << "_" << GetUseMinimumIntensity() << "_" << GetMinimumIntensity()
+     << "_" << GetUseMaximumIntensity() << "_" << GetMaximumIntensity()
+     << "_" << GetUseBinsize() << "_" << GetBinsize()
+     << "_" << GetUseBins() << "_" << GetBins()
+     << "_" << GetIgnoreMask() << "_" << defaultBins;
+  return ss.str();
+}
+
+void  mitk::AbstractGlobalImageFeature::InitializeQuantifierInstance(IntensityQuantifier *quantifier, const Image::Pointer & feature, const Image::Pointer &mask, unsigned int defaultBins)
+{
   if (GetUseMinimumIntensity() && GetUseMaximumIntensity() && GetUseBinsize())
-    m_Quantifier->InitializeByBinsizeAndMaximum(GetMinimumIntensity(), GetMaximumIntensity(), GetBinsize());
+    quantifier->InitializeByBinsizeAndMaximum(GetMinimumIntensity(), GetMaximumIntensity(), GetBinsize());
   else if (GetUseMinimumIntensity() && GetUseBins() && GetUseBinsize())
-    m_Quantifier->InitializeByBinsizeAndBins(GetMinimumIntensity(), GetBins(), GetBinsize());
+    quantifier->InitializeByBinsizeAndBins(GetMinimumIntensity(), GetBins(), GetBinsize());
   else if (GetUseMinimumIntensity() && GetUseMaximumIntensity() && GetUseBins())
-    m_Quantifier->InitializeByMinimumMaximum(GetMinimumIntensity(), GetMaximumIntensity(), GetBins());
+    quantifier->InitializeByMinimumMaximum(GetMinimumIntensity(), GetMaximumIntensity(), GetBins());
   // Intialize from Image and Binsize
   else if (GetUseBinsize() && GetIgnoreMask() && GetUseMinimumIntensity())
-    m_Quantifier->InitializeByImageAndBinsizeAndMinimum(feature, GetMinimumIntensity(), GetBinsize());
+    quantifier->InitializeByImageAndBinsizeAndMinimum(feature, GetMinimumIntensity(), GetBinsize());
   else if (GetUseBinsize() && GetIgnoreMask() && GetUseMaximumIntensity())
-    m_Quantifier->InitializeByImageAndBinsizeAndMaximum(feature, GetMaximumIntensity(), GetBinsize());
+    quantifier->InitializeByImageAndBinsizeAndMaximum(feature, GetMaximumIntensity(), GetBinsize());
   else if (GetUseBinsize() && GetIgnoreMask())
-    m_Quantifier->InitializeByImageAndBinsize(feature, GetBinsize());
+    quantifier->InitializeByImageAndBinsize(feature, GetBinsize());
   // Initialize form Image, Mask and Binsize
   else if (GetUseBinsize() && GetUseMinimumIntensity())
-    m_Quantifier->InitializeByImageRegionAndBinsizeAndMinimum(feature, mask, GetMinimumIntensity(), GetBinsize());
+    quantifier->InitializeByImageRegionAndBinsizeAndMinimum(feature, mask, GetMinimumIntensity(), GetBinsize());
   else if (GetUseBinsize() && GetUseMaximumIntensity())
-    m_Quantifier->InitializeByImageRegionAndBinsizeAndMaximum(feature, mask, GetMaximumIntensity(), GetBinsize());
+    quantifier->InitializeByImageRegionAndBinsizeAndMaximum(feature, mask, GetMaximumIntensity(), GetBinsize());
   else if (GetUseBinsize())
-    m_Quantifier->InitializeByImageRegionAndBinsize(feature, mask, GetBinsize());
+    quantifier->InitializeByImageRegionAndBinsize(feature, mask, GetBinsize());
   // Intialize from Image and Bins
   else if (GetUseBins() && GetIgnoreMask() && GetUseMinimumIntensity())
-    m_Quantifier->InitializeByImageAndMinimum(feature, GetMinimumIntensity(), GetBins());
+    quantifier->InitializeByImageAndMinimum(feature, GetMinimumIntensity(), GetBins());
   else if (GetUseBins() && GetIgnoreMask() && GetUseMaximumIntensity())
-    m_Quantifier->InitializeByImageAndMaximum(feature, GetMaximumIntensity(), GetBins());
+    quantifier->InitializeByImageAndMaximum(feature, GetMaximumIntensity(), GetBins());
   else if (GetUseBins())
-    m_Quantifier->InitializeByImage(feature, GetBins());
+    quantifier->InitializeByImage(feature, GetBins());
   // Intialize from Image, Mask and Bins
   else if (GetUseBins() && GetUseMinimumIntensity())
-    m_Quantifier->InitializeByImageRegionAndMinimum(feature, mask, GetMinimumIntensity(), GetBins());
+    quantifier->InitializeByImageRegionAndMinimum(feature, mask, GetMinimumIntensity(), GetBins());
   else if (GetUseBins() && GetUseMaximumIntensity())
-    m_Quantifier->InitializeByImageRegionAndMaximum(feature, mask, GetMaximumIntensity(), GetBins());
+    quantifier->InitializeByImageRegionAndMaximum(feature, mask, GetMaximumIntensity(), GetBins());
   else if (GetUseBins())
-    m_Quantifier->InitializeByImageRegion(feature, mask, GetBins());
+    quantifier->InitializeByImageRegion(feature, mask, GetBins());
   // Default
   else if (GetIgnoreMask())
-    m_Quantifier->InitializeByImage(feature, GetBins());
+    quantifier->InitializeByImage(feature, GetBins());
   else
-    m_Quantifier->InitializeByImageRegion(feature, mask, defaultBins);
+    quantifier->InitializeByImageRegion(feature, mask, defaultBins);
 }
 
 std::string mitk::AbstractGlobalImageFeature::GetCurrentFeatureEncoding()
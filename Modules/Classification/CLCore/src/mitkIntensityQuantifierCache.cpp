@@ -0,0 +1,50 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkIntensityQuantifierCache.h>
+
+mitk::IntensityQuantifier::Pointer mitk::IntensityQuantifierCache::GetQuantifier(const std::string &key, const InitializerType &initializer)
+{
+  std::shared_ptr<Entry> entry;
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    auto &storedEntry = m_Entries[key];
+    if (!storedEntry)
+    {
+      storedEntry = std::make_shared<Entry>();
+    }
+    entry = storedEntry;
+  }
+
+  // The initialization is done outside of the map lock, so quantifiers for
+  // different keys can be initialized concurrently.
+  std::call_once(entry->initialized, [&entry, &initializer]()
+  {
+    IntensityQuantifier::Pointer quantifier = IntensityQuantifier::New();
+    initializer(quantifier);
+    entry->quantifier = quantifier;
+  });
+
+  return entry->quantifier;
+}
+
+void mitk::IntensityQuantifierCache::Clear()
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_Entries.clear();
+}
+
+std::size_t mitk::IntensityQuantifierCache::GetNumberOfQuantifiers() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_Entries.size();
+}
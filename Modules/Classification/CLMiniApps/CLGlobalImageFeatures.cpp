@@ -44,6 +44,7 @@ found in the LICENSE file.
 #include <mitkConvert2Dto3DImageFilter.h>
 
 #include <mitkCLResultWritter.h>
+#include <mitkGlobalImageFeaturesExtractor.h>
 #include <mitkVersion.h>
 
 #include <iostream>
@@ -358,7 +359,8 @@ void SaveSliceOrImageAsPNG(mitk::Image::Pointer image, mitk::Image::Pointer mask
   }
 }
 
-int main(int argc, char* argv[])
+static std::vector<mitk::AbstractGlobalImageFeature::Pointer>
+CreateFeatureCalculators()
 {
   // Commented : Updated to a common interface, include, if possible, mask is type unsigned short, uses Quantification, Comments
   //                                 Name follows standard scheme with Class Name::Feature Name
@@ -397,6 +399,12 @@ int main(int argc, char* argv[])
   features.push_back(gldzCalculator.GetPointer());
   features.push_back(ipCalculator.GetPointer());
   features.push_back(ngtdCalculator.GetPointer());
+  return features;
+}
+
+int main(int argc, char* argv[])
+{
+  std::vector<mitk::AbstractGlobalImageFeature::Pointer> features = CreateFeatureCalculators();
 
   mitkCommandLineParser parser;
   parser.setArgumentPrefix("--", "-");
@@ -578,26 +586,35 @@ int main(int argc, char* argv[])
   }
 
   log << " Configure features -";
-  for (auto cFeature : features)
+  // Every worker thread of the extractor calculates with its own, identically configured feature classes
+  auto featureFactory = [&]()
   {
-    if (param.defineGlobalMinimumIntensity)
+    auto newFeatures = CreateFeatureCalculators();
+    for (auto cFeature : newFeatures)
     {
-      cFeature->SetMinimumIntensity(param.globalMinimumIntensity);
-      cFeature->SetUseMinimumIntensity(true);
-    }
-    if (param.defineGlobalMaximumIntensity)
-    {
-      cFeature->SetMaximumIntensity(param.globalMaximumIntensity);
-      cFeature->SetUseMaximumIntensity(true);
-    }
-    if (param.defineGlobalNumberOfBins)
-    {
-      cFeature->SetBins(param.globalNumberOfBins);
-      MITK_INFO << param.globalNumberOfBins;
+      if (param.defineGlobalMinimumIntensity)
+      {
+        cFeature->SetMinimumIntensity(param.globalMinimumIntensity);
+        cFeature->SetUseMinimumIntensity(true);
+      }
+      if (param.defineGlobalMaximumIntensity)
+      {
+        cFeature->SetMaximumIntensity(param.globalMaximumIntensity);
+        cFeature->SetUseMaximumIntensity(true);
+      }
+      if (param.defineGlobalNumberOfBins)
+      {
+        cFeature->SetBins(param.globalNumberOfBins);
+      }
+      cFeature->SetParameter(parsedArgs);
+      cFeature->SetDirection(direction);
+      cFeature->SetEncodeParameters(param.encodeParameter);
     }
-    cFeature->SetParameter(parsedArgs);
-    cFeature->SetDirection(direction);
-    cFeature->SetEncodeParameters(param.encodeParameter);
+    return newFeatures;
+  };
+  if (param.defineGlobalNumberOfBins)
+  {
+    MITK_INFO << param.globalNumberOfBins;
   }
 
   bool addDescription = parsedArgs.count("description");
@@ -636,6 +653,9 @@ int main(int argc, char* argv[])
   std::vector<mitk::AbstractGlobalImageFeature::FeatureListType> allStats;
 
   log << " Begin Processing -";
+  mitk::cl::GlobalImageFeaturesExtractor extractor(featureFactory);
+  extractor.SetNumberOfThreads(param.numberOfThreads);
+
   while (imageToProcess)
   {
     if (sliceWise)
@@ -664,21 +684,25 @@ int main(int argc, char* argv[])
       mitk::IOUtil::Save(cMask, param.analysisMaskPath);
     }
 
-    mitk::AbstractGlobalImageFeature::FeatureListType stats;
-
-    for (auto cFeature : features)
-    {
-      log << " Calculating " << cFeature->GetFeatureClassName() << " -";
-      cFeature->SetMorphMask(cMorphMask);
-      cFeature->CalculateFeaturesUsingParameters(cImage, cMask, cMaskNoNaN, stats);
-    }
+    mitk::cl::GlobalImageFeaturesExtractor::Input input;
+    input.image = cImage;
+    input.mask = cMask;
+    input.maskNoNaN = cMaskNoNaN;
+    input.morphMask = cMorphMask;
+    extractor.AddInput(input);
+    ++currentSlice;
+  }
 
+  // The results of each image / slice are written as soon as all of its features are calculated.
+  extractor.Extract([&](std::size_t inputIndex, const mitk::AbstractGlobalImageFeature::FeatureListType &stats)
+  {
+    log << " Calculated input " << inputIndex << " -";
     for (std::size_t i = 0; i < stats.size(); ++i)
     {
       std::cout << stats[i].first << " - " << stats[i].second << std::endl;
     }
 
-    writer.AddHeader(description, currentSlice, stats, param.useHeader, addDescription);
+    writer.AddHeader(description, inputIndex, stats, param.useHeader, addDescription);
     if (true)
     {
       writer.AddSubjectInformation(MITK_REVISION);
@@ -686,11 +710,11 @@ int main(int argc, char* argv[])
       writer.AddSubjectInformation(param.imageName);
       writer.AddSubjectInformation(param.maskName);
     }
-    writer.AddResult(description, currentSlice, stats, param.useHeader, addDescription);
+    writer.AddResult(description, inputIndex, stats, param.useHeader, addDescription);
+    writer.Flush();
 
     allStats.push_back(stats);
-    ++currentSlice;
-  }
+  });
 
   log << " Process Slicewise -";
   if (sliceWise)
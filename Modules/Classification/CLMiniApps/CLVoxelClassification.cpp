@@ -25,7 +25,11 @@ found in the LICENSE file.
 #include <mitkIOUtil.h>
 
 #include <mitkDataCollectionUtilities.h>
+#include <mitkDataCollectionMatrixBlockIterator.h>
+#include <mitkDataCollectionSingleImageIterator.h>
 #include <mitkRandomForestIO.h>
+#include <mitkRandomImageSampler.h>
+#include <mitkImageCast.h>
 
 // ----------------------- Forest Handling ----------------------
 //#include <mitkDecisionForest.h>
@@ -44,6 +48,30 @@ found in the LICENSE file.
 //#include <mitkSpectralDensityEstimation.h>
 //#include <mitkULSIFDensityEstimation.h>
 
+// Adds a randomly subsampled copy of the mask to each element of the collection. Only the sampled voxels
+// are converted into the training matrix.
+static void AddSampledMaskToCollection(mitk::DataCollection::Pointer collection, const std::string &mask, const std::string &sampledMask, double acceptanceRate)
+{
+  typedef mitk::DataCollectionSingleImageIterator<unsigned char, 3> MaskIteratorType;
+  MaskIteratorType iter(collection, mask);
+  while (!iter.IsAtEnd())
+  {
+    mitk::Image::Pointer maskImage;
+    mitk::CastToMitkImage(iter.GetImage(), maskImage);
+
+    mitk::RandomImageSampler::Pointer sampler = mitk::RandomImageSampler::New();
+    sampler->SetInput(maskImage);
+    sampler->SetSamplingMode(mitk::RandomImageSamplerMode::SINGLE_ACCEPTANCE_RATE);
+    sampler->SetAcceptanceRate(acceptanceRate);
+    sampler->Update();
+
+    MaskIteratorType::ImageType::Pointer sampledImage;
+    mitk::CastToItkImage(sampler->GetOutput(), sampledImage);
+    iter.AddImage(sampledImage, sampledMask);
+    ++iter;
+  }
+}
+
 int main(int argc, char* argv[])
 {
   MITK_INFO << "Starting MITK_Forest Mini-App";
@@ -143,6 +171,8 @@ int main(int argc, char* argv[])
       weightLambda = 0.0;
     }
     int maximumTreeDepth =  allConfig.IntValue("Forest", "Maximum Tree Depth",10000);
+    double trainingSamplingRate = atof(allConfig.Value("Forest", "Training Sampling Rate", "1").c_str());
+    int predictionMemoryBudget = allConfig.IntValue("Forest", "Prediction Memory Budget in MB", 256);
     // TODO int randomSplit = allConfig.IntValue("Forest","Use RandomSplit",0);
     //////////////////////////////////////////////////////////////////////////////
     // Read Statistic Parameter
@@ -255,8 +285,16 @@ int main(int argc, char* argv[])
       // 4 = Zadrozny
       // 5 = Spectral
       // 6 = uLSIF
-      auto trainDataX = mitk::DCUtilities::DC3dDToMatrixXd(trainCollection, modalities, trainMask);
-      auto trainDataY = mitk::DCUtilities::DC3dDToMatrixXi(trainCollection, trainMask, trainMask);
+      std::string usedTrainMask = trainMask;
+      if (trainingSamplingRate > 0.0 && trainingSamplingRate < 1.0)
+      {
+        MITK_INFO << "Sample " << trainingSamplingRate << " of the training voxels";
+        usedTrainMask = trainMask + "_sampled";
+        AddSampledMaskToCollection(trainCollection, trainMask, usedTrainMask, trainingSamplingRate);
+      }
+
+      auto trainDataX = mitk::DCUtilities::DC3dDToMatrixXd(trainCollection, modalities, usedTrainMask);
+      auto trainDataY = mitk::DCUtilities::DC3dDToMatrixXi(trainCollection, usedTrainMask, usedTrainMask);
 
       if (useWeightedPoints)
       //if (false)
@@ -323,7 +361,7 @@ int main(int argc, char* argv[])
           est.SetWeightName("calculated_weight");
           est.Update();
         }
-        auto trainDataW = mitk::DCUtilities::DC3dDToMatrixXd(trainCollection, "calculated_weight", trainMask);
+        auto trainDataW = mitk::DCUtilities::DC3dDToMatrixXd(trainCollection, "calculated_weight", usedTrainMask);
         forest->SetPointWiseWeight(trainDataW);
         forest->UsePointWiseWeight(true);
       }
@@ -355,15 +393,7 @@ int main(int argc, char* argv[])
     //////////////////////////////////////////////////////////////////////////////
     // If required do test
     //////////////////////////////////////////////////////////////////////////////
-    MITK_INFO << "Convert Test data";
-    auto testDataX = mitk::DCUtilities::DC3dDToMatrixXd(testCollection,modalities, testMask);
-
-    MITK_INFO << "Predict Test Data";
-    auto testDataNewY = forest->Predict(testDataX);
-    auto testDataNewProb = forest->GetPointWiseProbabilities();
-    //MITK_INFO << testDataNewY;
-
-    auto maxClassValue = testDataNewProb.cols();
+    auto maxClassValue = forest->GetRandomForest().class_count();
     std::vector<std::string> names;
     for (int i = 0; i < maxClassValue; ++i)
     {
@@ -373,9 +403,19 @@ int main(int argc, char* argv[])
     }
     //names.push_back("prob-1");
     //names.push_back("prob-2");
+    std::vector<std::string> labelNames(1, resultMask);
 
-    mitk::DCUtilities::MatrixToDC3d(testDataNewY, testCollection, resultMask, testMask);
-    mitk::DCUtilities::MatrixToDC3d(testDataNewProb, testCollection, names, testMask);
+    // The test data is streamed block-wise through the forest, so the feature matrix of all voxels is never built
+    MITK_INFO << "Predict Test Data";
+    mitk::DataCollectionMatrixBlockIterator testDataIter(testCollection, modalities, testMask);
+    forest->SetPredictionMemoryBudget(static_cast<std::size_t>(predictionMemoryBudget) * 1024 * 1024);
+    forest->PredictBlockwise(
+      [&testDataIter](Eigen::MatrixXd &block) { return testDataIter.ReadBlock(block); },
+      [&testDataIter, &labelNames, &names](const Eigen::MatrixXi &labels, const Eigen::MatrixXd &probabilities)
+      {
+        testDataIter.WriteBlock(labels, labelNames);
+        testDataIter.WriteBlock(probabilities, names);
+      });
     MITK_INFO << "Converted predicted data";
     //forest.SetMaskName(testMask);
     //forest.SetCollection(testCollection);
@@ -30,6 +30,7 @@ set(CPP_FILES
 
   MiniAppUtils/mitkGlobalImageFeaturesParameter.cpp
   MiniAppUtils/mitkSplitParameterToVector.cpp
+  MiniAppUtils/mitkGlobalImageFeaturesExtractor.cpp
 
   mitkCLUtil.cpp
 
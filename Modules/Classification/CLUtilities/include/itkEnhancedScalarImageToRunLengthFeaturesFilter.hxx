@@ -158,29 +158,30 @@ namespace itk
       typedef typename RunLengthFeaturesFilterType::RunLengthFeatureName
         InternalRunLengthFeatureName;
 
+      // The run length matrices of all offsets are computed in one pass
       OffsetVectorPointer offsets = OffsetVector::New();
-      if (m_CombinedFeatureCalculation)
+      for (unsigned int i = 0; i < this->m_Offsets->Size(); ++i)
       {
-        for (int i = 0; i < this->m_Offsets->Size(); ++i)
-        {
-          offsets->push_back(m_Offsets->ElementAt(i));
-        }
+        offsets->push_back(m_Offsets->ElementAt(i));
       }
-
+      this->m_RunLengthMatrixGenerator->SetOffsets(offsets);
+      this->m_RunLengthMatrixGenerator->Update();
 
       for( offsetIt = this->m_Offsets->Begin(), offsetNum = 0;
         offsetIt != this->m_Offsets->End(); offsetIt++, offsetNum++ )
       {
-        this->m_RunLengthMatrixGenerator->SetOffset(offsetIt.Value());
+        typename RunLengthFeaturesFilterType::Pointer runLengthMatrixCalculator =
+          RunLengthFeaturesFilterType::New();
         if (m_CombinedFeatureCalculation)
         {
-          this->m_RunLengthMatrixGenerator->SetOffsets(offsets);
+          runLengthMatrixCalculator->SetInput(
+            this->m_RunLengthMatrixGenerator->GetOutput() );
+        }
+        else
+        {
+          runLengthMatrixCalculator->SetInput(
+            this->m_RunLengthMatrixGenerator->GetOutputForOffset(offsetNum) );
         }
-        this->m_RunLengthMatrixGenerator->Update();
-        typename RunLengthFeaturesFilterType::Pointer runLengthMatrixCalculator =
-          RunLengthFeaturesFilterType::New();
-        runLengthMatrixCalculator->SetInput(
-          this->m_RunLengthMatrixGenerator->GetOutput() );
         runLengthMatrixCalculator->SetNumberOfVoxels(numberOfVoxels);
         runLengthMatrixCalculator->Update();
 
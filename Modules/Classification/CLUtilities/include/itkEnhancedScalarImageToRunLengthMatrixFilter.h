@@ -35,6 +35,8 @@ found in the LICENSE file.
 #include "itkNumericTraits.h"
 #include "itkVectorContainer.h"
 
+#include <vector>
+
 namespace itk
 {
   namespace Statistics
@@ -234,6 +236,13 @@ namespace itk
       /** method to get the Histogram */
       const HistogramType * GetOutput() const;
 
+      /**
+      * Method to get the histogram of a single offset. The run lengths of all
+      * offsets are collected in one pass over the image; GetOutput() is the sum
+      * of these histograms.
+      */
+      const HistogramType * GetOutputForOffset( unsigned int offsetIndex ) const;
+
       /**
       * Set the pixel value of the mask that should be considered "inside" the
       * object. Defaults to 1.
@@ -277,6 +286,8 @@ namespace itk
       MeasurementVectorType    m_LowerBound;
       MeasurementVectorType    m_UpperBound;
       OffsetVectorPointer      m_Offsets;
+
+      std::vector<HistogramPointer> m_OffsetHistograms;
     };
   } // end of namespace Statistics
 } // end of namespace itk
@@ -32,11 +32,13 @@ found in the LICENSE file.
 
 #include "itkEnhancedScalarImageToRunLengthMatrixFilter.h"
 
-#include "itkConstNeighborhoodIterator.h"
-#include "itkNeighborhood.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
 #include "vnl/vnl_math.h"
 #include "itkMacro.h"
 
+#include <algorithm>
+#include <thread>
+
 namespace itk
 {
   namespace Statistics
@@ -162,194 +164,163 @@ namespace itk
       this->m_UpperBound[1] = this->m_MaxDistance;
       output->Initialize( size, this->m_LowerBound, this->m_UpperBound );
 
-      MeasurementVectorType run( output->GetMeasurementVectorSize() );
-      typename HistogramType::IndexType hIndex;
-
-      // Iterate over all of those pixels and offsets, adding each
-      // distance/intensity pair to the histogram
-
-      typedef ConstNeighborhoodIterator<ImageType> NeighborhoodIteratorType;
-      typename NeighborhoodIteratorType::RadiusType radius;
-      radius.Fill( 1 );
-      NeighborhoodIteratorType neighborIt( radius,
-        inputImage, inputImage->GetRequestedRegion() );
-
-      // this temp image has the same dimension for each offset
-      // moving the allocation out of loop of offsets
-      // while keeping FillBuffer with boolean false in each loop
-      typedef Image<bool, ImageDimension> BoolImageType;
-      typename BoolImageType::Pointer alreadyVisitedImage = BoolImageType::New();
-      alreadyVisitedImage->CopyInformation( inputImage );
-      alreadyVisitedImage->SetRegions( inputImage->GetRequestedRegion() );
-      alreadyVisitedImage->Allocate();
-
-      typename OffsetVector::ConstIterator offsets;
-      for( offsets = this->GetOffsets()->Begin();
-        offsets != this->GetOffsets()->End(); offsets++ )
+      const ImageType * maskImage = this->GetMaskImage();
+      const RegionType region = inputImage->GetRequestedRegion();
+      const MeasurementType lastBinMax = output->GetDimensionMaxs( 0 )[ output->GetSize( 0 ) - 1 ];
+
+      std::vector<OffsetType> offsets;
+      m_OffsetHistograms.clear();
+      typename OffsetVector::ConstIterator offsetIt;
+      for( offsetIt = this->GetOffsets()->Begin();
+        offsetIt != this->GetOffsets()->End(); offsetIt++ )
       {
-        alreadyVisitedImage->FillBuffer( false );
+        OffsetType offset = offsetIt.Value();
+        this->NormalizeOffsetDirection(offset);
+        offsets.push_back( offset );
 
-        neighborIt.GoToBegin();
-        OffsetType offset = offsets.Value();
+        HistogramPointer offsetHistogram = HistogramType::New();
+        offsetHistogram->SetMeasurementVectorSize( output->GetMeasurementVectorSize() );
+        offsetHistogram->Initialize( size, this->m_LowerBound, this->m_UpperBound );
+        m_OffsetHistograms.push_back( offsetHistogram );
+      }
 
-        this->NormalizeOffsetDirection(offset);
+      // All offsets are handled in one pass over the image. A run is counted
+      // by its first voxel in the direction of the offset, i.e. by the voxel
+      // whose predecessor (index - offset) does not belong to the run. This
+      // gives the same runs as scanning the image once per offset and marking
+      // visited voxels, but needs no visited image, so the image can be split
+      // between threads. Each thread counts into its own partial matrices,
+      // which are merged afterwards.
+      RegionType splitRegion = region;
+      const unsigned int splitDimension = ImageDimension - 1;
+      const unsigned int numberOfThreads = std::max( 1u, std::min<unsigned int>( this->GetNumberOfThreads(),
+        static_cast<unsigned int>( region.GetSize( splitDimension ) ) ) );
+
+      typedef typename HistogramType::AbsoluteFrequencyType AbsoluteFrequencyType;
+      typedef typename HistogramType::InstanceIdentifier InstanceIdentifier;
+      typedef std::vector<AbsoluteFrequencyType> CountVectorType;
+      std::vector< std::vector<CountVectorType> > threadCounts( numberOfThreads,
+        std::vector<CountVectorType>( offsets.size(), CountVectorType( output->Size(), 0 ) ) );
+
+      auto countRuns = [&]( const RegionType &threadRegion, std::vector<CountVectorType> &counts )
+      {
+        MeasurementVectorType run( output->GetMeasurementVectorSize() );
+        typename HistogramType::IndexType hIndex;
 
-        for( neighborIt.GoToBegin(); !neighborIt.IsAtEnd(); ++neighborIt )
+        ImageRegionConstIteratorWithIndex<ImageType> centerIt( inputImage, threadRegion );
+        for( centerIt.GoToBegin(); !centerIt.IsAtEnd(); ++centerIt )
         {
-          const PixelType centerPixelIntensity = neighborIt.GetCenterPixel();
-          if (centerPixelIntensity != centerPixelIntensity) // Check for invalid values
-          {
-            continue;
-          }
-          IndexType centerIndex = neighborIt.GetIndex();
-          if( centerPixelIntensity < this->m_Min ||
+          const PixelType centerPixelIntensity = centerIt.Get();
+          const IndexType centerIndex = centerIt.GetIndex();
+          if( centerPixelIntensity != centerPixelIntensity || // Check for invalid values
+            centerPixelIntensity < this->m_Min ||
             centerPixelIntensity > this->m_Max ||
-            alreadyVisitedImage->GetPixel( centerIndex ) || ( this->GetMaskImage() &&
-            this->GetMaskImage()->GetPixel( centerIndex ) !=
-            this->m_InsidePixelValue ) )
+            ( maskImage && maskImage->GetPixel( centerIndex ) != this->m_InsidePixelValue ) )
           {
             continue; // don't put a pixel in the histogram if the value
             // is out-of-bounds or is outside the mask.
           }
 
-          itkDebugMacro("===> offset = " << offset << std::endl);
-
-          MeasurementType centerBinMin = this->GetOutput()->
-            GetBinMinFromValue( 0, centerPixelIntensity );
-          MeasurementType centerBinMax = this->GetOutput()->
-            GetBinMaxFromValue( 0, centerPixelIntensity );
-          MeasurementType lastBinMax = this->GetOutput()->
-            GetDimensionMaxs( 0 )[ this->GetOutput()->GetSize( 0 ) - 1 ];
-
-          PixelType pixelIntensity( NumericTraits<PixelType>::ZeroValue() );
-          IndexType index;
+          const MeasurementType centerBinMin = output->GetBinMinFromValue( 0, centerPixelIntensity );
+          const MeasurementType centerBinMax = output->GetBinMaxFromValue( 0, centerPixelIntensity );
 
-          int steps = 0;
-          index = centerIndex + offset;
-          IndexType lastGoodIndex = centerIndex;
-          bool runLengthSegmentAlreadyVisited = false;
-
-          // Scan from the current pixel at index, following
-          // the direction of offset. Run length is computed as the
-          // length of continuous pixels whose pixel values are
-          // in the same bin.
-
-          while ( inputImage->GetRequestedRegion().IsInside(index) )
+          // Special attention paid to boundaries of bins.
+          // For the last bin, it is left close and right close.
+          // For all other bins, the bin is left close and right open.
+          auto belongsToRun = [&]( const IndexType &index ) -> bool
           {
-            pixelIntensity = inputImage->GetPixel(index);
-            // For the same offset, each run length segment can
-            // only be visited once
-            if (alreadyVisitedImage->GetPixel( index ) )
-            {
-              runLengthSegmentAlreadyVisited = true;
-              break;
-            }
-            if (pixelIntensity != pixelIntensity)
+            if( !region.IsInside( index ) )
             {
-              break;
+              return false;
             }
-
-
-            // Special attention paid to boundaries of bins.
-            // For the last bin,
-            // it is left close and right close (following the previous
-            // gerrit patch).
-            // For all
-            // other bins,
-            // the bin is left close and right open.
-
-            if ( pixelIntensity >= centerBinMin
+            const PixelType pixelIntensity = inputImage->GetPixel( index );
+            return pixelIntensity == pixelIntensity
+              && pixelIntensity >= centerBinMin
               && ( pixelIntensity < centerBinMax || ( pixelIntensity == centerBinMax && centerBinMax == lastBinMax ) )
-              && (!this->GetMaskImage() || this->GetMaskImage()->GetPixel(index) == this->m_InsidePixelValue))
-            {
-              alreadyVisitedImage->SetPixel( index, true );
-              lastGoodIndex = index;
-              index += offset;
-              steps++;
-            }
-            else
-            {
-              break;
-            }
-          }
+              && ( !maskImage || maskImage->GetPixel( index ) == this->m_InsidePixelValue );
+          };
 
-          if ( runLengthSegmentAlreadyVisited )
+          for( std::size_t offsetIndex = 0; offsetIndex < offsets.size(); ++offsetIndex )
           {
-            MITK_INFO << "Already visited 1 " << index;
-            continue;
-          }
-          IndexType lastGoodIndex2 = lastGoodIndex;
-          index = centerIndex - offset;
-          lastGoodIndex = centerIndex;
-          while ( inputImage->GetRequestedRegion().IsInside(index) )
-          {
-            pixelIntensity = inputImage->GetPixel(index);
-            if (pixelIntensity != pixelIntensity)
+            const OffsetType &offset = offsets[offsetIndex];
+            if( belongsToRun( centerIndex - offset ) )
             {
-              break;
+              continue; // counted by the first voxel of the run
             }
-            if (alreadyVisitedImage->GetPixel( index ) )
+
+            int steps = 0;
+            IndexType index = centerIndex + offset;
+            while( belongsToRun( index ) )
             {
-              if (pixelIntensity >= centerBinMin
-                && (pixelIntensity < centerBinMax || (pixelIntensity == centerBinMax && centerBinMax == lastBinMax)))
-              {
-                runLengthSegmentAlreadyVisited = true;
-              }
-              break;
+              ++steps;
+              index += offset;
             }
 
-            if ( pixelIntensity >= centerBinMin
-              && ( pixelIntensity < centerBinMax || ( pixelIntensity == centerBinMax && centerBinMax == lastBinMax ) )
-              && (!this->GetMaskImage() || this->GetMaskImage()->GetPixel(index) == this->m_InsidePixelValue))
+            run[0] = centerPixelIntensity;
+            run[1] = steps;
+
+            if( run[1] >= this->m_MinDistance && run[1] <= this->m_MaxDistance )
             {
-              alreadyVisitedImage->SetPixel( index, true );
-              lastGoodIndex = index;
-              steps++;
-              index -= offset;
+              output->GetIndex( run, hIndex );
+              counts[offsetIndex][output->GetInstanceIdentifier( hIndex )] += 1;
             }
-            else
-              break;
           }
-          if (runLengthSegmentAlreadyVisited)
+        }
+      };
+
+      std::vector<std::thread> threads;
+      const SizeValueType sliceCount = region.GetSize( splitDimension );
+      for( unsigned int threadId = 0; threadId < numberOfThreads; ++threadId )
+      {
+        const SizeValueType begin = sliceCount * threadId / numberOfThreads;
+        const SizeValueType end = sliceCount * ( threadId + 1 ) / numberOfThreads;
+        splitRegion.SetIndex( splitDimension, region.GetIndex( splitDimension ) + static_cast<IndexValueType>( begin ) );
+        splitRegion.SetSize( splitDimension, end - begin );
+        if( threadId + 1 == numberOfThreads )
+        {
+          countRuns( splitRegion, threadCounts[threadId] );
+        }
+        else
+        {
+          threads.emplace_back( countRuns, splitRegion, std::ref( threadCounts[threadId] ) );
+        }
+      }
+      for( auto &thread : threads )
+      {
+        thread.join();
+      }
+
+      for( std::size_t offsetIndex = 0; offsetIndex < offsets.size(); ++offsetIndex )
+      {
+        for( InstanceIdentifier id = 0; id < output->Size(); ++id )
+        {
+          AbsoluteFrequencyType frequency = 0;
+          for( unsigned int threadId = 0; threadId < numberOfThreads; ++threadId )
           {
-            MITK_INFO << "Already visited 2 " << index;
-            continue;
+            frequency += threadCounts[threadId][offsetIndex][id];
           }
-          PointType centerPoint;
-          inputImage->TransformIndexToPhysicalPoint(
-            centerIndex, centerPoint );
-          PointType point;
-          inputImage->TransformIndexToPhysicalPoint( lastGoodIndex, point );
-          PointType point2;
-          inputImage->TransformIndexToPhysicalPoint( lastGoodIndex2, point2 );
-
-          run[0] = centerPixelIntensity;
-          run[1] = steps;
-          //run[1] = point.EuclideanDistanceTo( point2 );
-
-          if( run[1] >= this->m_MinDistance && run[1] <= this->m_MaxDistance )
+          if( frequency > 0 )
           {
-            output->GetIndex( run, hIndex );
-            output->IncreaseFrequencyOfIndex( hIndex, 1 );
-
-            itkDebugStatement(typename HistogramType::IndexType tempMeasurementIndex;)
-              itkDebugStatement(output->GetIndex(run,tempMeasurementIndex);)
-              itkDebugMacro( "centerIndex<->index: "
-              << static_cast<int>( centerPixelIntensity )
-              << "@"<< centerIndex
-              << "<->" << static_cast<int>( pixelIntensity ) << "@" << index
-              <<", Bin# " << tempMeasurementIndex
-              << ", Measurement: (" << run[0] << ", " << run[1] << ")"
-              << ", Center bin [" << this->GetOutput()->GetBinMinFromValue( 0, run[0] )
-              << "," << this->GetOutput()->GetBinMaxFromValue( 0, run[0] ) << "]"
-              << "~[" << this->GetOutput()->GetBinMinFromValue( 1, run[1] )
-              << "," << this->GetOutput()->GetBinMaxFromValue( 1, run[1] ) << "]"
-              << std::endl );
+            m_OffsetHistograms[offsetIndex]->IncreaseFrequency( id, frequency );
+            output->IncreaseFrequency( id, frequency );
           }
         }
       }
     }
 
+    template<typename TImageType, typename THistogramFrequencyContainer>
+    const typename EnhancedScalarImageToRunLengthMatrixFilter<TImageType,
+      THistogramFrequencyContainer >::HistogramType *
+      EnhancedScalarImageToRunLengthMatrixFilter<TImageType, THistogramFrequencyContainer>
+      ::GetOutputForOffset( unsigned int offsetIndex ) const
+    {
+      if( offsetIndex >= m_OffsetHistograms.size() )
+      {
+        itkExceptionMacro( "No histogram for offset " << offsetIndex << ". Number of offsets: " << m_OffsetHistograms.size() );
+      }
+      return m_OffsetHistograms[offsetIndex].GetPointer();
+    }
+
     template<typename TImageType, typename THistogramFrequencyContainer>
     void
       EnhancedScalarImageToRunLengthMatrixFilter<TImageType, THistogramFrequencyContainer>
@@ -41,6 +41,10 @@ namespace mitk
       void AddResult(std::string desc, int slice, mitk::AbstractGlobalImageFeature::FeatureListType stats, bool , bool withDescription);
       void AddHeader(std::string, int slice, mitk::AbstractGlobalImageFeature::FeatureListType stats, bool withHeader, bool withDescription);
 
+      /** Writes all completed rows to the file. Only the modes that write one row per
+      * result (0 and 2) can stream; in mode 1 all rows are written on destruction.*/
+      void Flush();
+
     private:
       int m_Mode;
       std::size_t m_CurrentRow;
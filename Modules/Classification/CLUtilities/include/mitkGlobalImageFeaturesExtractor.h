@@ -0,0 +1,83 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkGlobalImageFeaturesExtractor_h
+#define mitkGlobalImageFeaturesExtractor_h
+
+#include "MitkCLUtilitiesExports.h"
+
+#include <mitkAbstractGlobalImageFeature.h>
+#include <mitkIntensityQuantifierCache.h>
+
+#include <functional>
+#include <vector>
+
+namespace mitk
+{
+  namespace cl
+  {
+    /**
+    * \brief Calculates the features of several feature classes for several image / mask pairs concurrently.
+    *
+    * Every combination of an input and a feature class is a task. The tasks are processed by a pool of
+    * worker threads. As the feature classes store state while calculating, every worker uses its own set
+    * of feature classes, which is created by the feature factory. All feature classes share one
+    * IntensityQuantifierCache, so the histogram range of an image and mask is only determined once,
+    * independent of the number of feature classes that use it.
+    *
+    * The results of an input are passed to the result callback as soon as all of its features are
+    * calculated. The callback is called for the inputs in the order in which they were added and never
+    * concurrently, so it can directly stream the results to a FeatureResultWritter. The feature list of
+    * an input has the same order as if the feature classes were calculated one after another.
+    */
+    class MITKCLUTILITIES_EXPORT GlobalImageFeaturesExtractor
+    {
+    public:
+      typedef mitk::AbstractGlobalImageFeature::FeatureListType FeatureListType;
+      typedef std::vector<mitk::AbstractGlobalImageFeature::Pointer> FeatureVectorType;
+
+      /** Has to return a new, completely configured set of feature classes. The order of the
+      * feature classes has to be the same for each call.*/
+      typedef std::function<FeatureVectorType()> FeatureFactoryType;
+      typedef std::function<void(std::size_t inputIndex, const FeatureListType &features)> ResultCallbackType;
+
+      struct Input
+      {
+        mitk::Image::Pointer image;
+        mitk::Image::Pointer mask;
+        mitk::Image::Pointer maskNoNaN;
+        mitk::Image::Pointer morphMask;
+      };
+
+      explicit GlobalImageFeaturesExtractor(FeatureFactoryType factory);
+
+      /** Number of worker threads. 0 (default) uses the number of cores.*/
+      void SetNumberOfThreads(unsigned int numberOfThreads);
+      unsigned int GetNumberOfThreads() const;
+
+      /** Adds an image / mask pair and returns its index.*/
+      std::size_t AddInput(const Input &input);
+      std::size_t GetNumberOfInputs() const;
+
+      /** Calculates the features of all inputs. Blocks until all results were passed to the callback.
+      * An exception thrown by a feature class is rethrown after all workers have stopped.*/
+      void Extract(const ResultCallbackType &callback);
+
+    private:
+      FeatureFactoryType m_Factory;
+      unsigned int m_NumberOfThreads;
+      std::vector<Input> m_Inputs;
+    };
+  }
+}
+
+#endif //mitkGlobalImageFeaturesExtractor_h
@@ -67,6 +67,7 @@ namespace mitk
       bool useDecimalPoint;
       char decimalPoint;
       bool encodeParameter;
+      unsigned int numberOfThreads;
 
     private:
       void ParseFileLocations(std::map<std::string, us::Any> &parsedArgs);
@@ -19,12 +19,16 @@ found in the LICENSE file.
 
 // ITK
 #include <itkEnhancedScalarImageToTextureFeaturesFilter.h>
-#include <itkShapedNeighborhoodIterator.h>
 #include <itkImageRegionConstIterator.h>
+#include <itkImageRegionIterator.h>
+#include <itkImageRegionConstIteratorWithIndex.h>
+#include <itkMultiThreader.h>
+#include <itkNeighborhood.h>
 
 // STL
 #include <sstream>
 #include <cmath>
+#include <thread>
 
 namespace mitk
 {
@@ -163,53 +167,118 @@ double mitk::CoocurenceMatrixHolder::IndexToMaxIntensity(int index)
   return m_MinimumRange + (index + 1) * m_Stepsize;
 }
 
+/** Calculates the co-occurence matrices of all offsets in a single pass over the image.
+ * Every voxel is quantized once, the image is then split between threads which
+ * accumulate partial matrices for all offsets. */
 template<typename TPixel, unsigned int VImageDimension>
 void
-CalculateCoOcMatrix(itk::Image<TPixel, VImageDimension>* itkImage,
-                    itk::Image<unsigned short, VImageDimension>* mask,
-                    itk::Offset<VImageDimension> offset,
-                    int range,
-                    mitk::CoocurenceMatrixHolder &holder)
+CalculateCoOcMatrices(itk::Image<TPixel, VImageDimension>* itkImage,
+                      itk::Image<unsigned short, VImageDimension>* mask,
+                      const std::vector<itk::Offset<VImageDimension> > &offsets,
+                      std::vector<mitk::CoocurenceMatrixHolder> &holders)
 {
   typedef itk::Image<TPixel, VImageDimension> ImageType;
   typedef itk::Image<unsigned short, VImageDimension> MaskImageType;
-  typedef itk::ShapedNeighborhoodIterator<ImageType> ShapeIterType;
-  typedef itk::ShapedNeighborhoodIterator<MaskImageType> ShapeMaskIterType;
+  typedef itk::Image<int, VImageDimension> BinImageType;
   typedef itk::ImageRegionConstIterator<ImageType> ConstIterType;
   typedef itk::ImageRegionConstIterator<MaskImageType> ConstMaskIterType;
 
+  if (offsets.empty())
+  {
+    return;
+  }
 
-  itk::Size<VImageDimension> radius;
-  radius.Fill(range+1);
-  ShapeIterType imageOffsetIter(radius, itkImage, itkImage->GetLargestPossibleRegion());
-  ShapeMaskIterType maskOffsetIter(radius, mask, mask->GetLargestPossibleRegion());
-  imageOffsetIter.ActivateOffset(offset);
-  maskOffsetIter.ActivateOffset(offset);
-  ConstIterType imageIter(itkImage, itkImage->GetLargestPossibleRegion());
-  ConstMaskIterType maskIter(mask, mask->GetLargestPossibleRegion());
-  //  iterator.GetIndex() + ci.GetNeighborhoodOffset()
   auto region = mask->GetLargestPossibleRegion();
 
+  // Bin of each voxel, -1 if the voxel is outside of the mask or not a number
+  typename BinImageType::Pointer binImage = BinImageType::New();
+  binImage->SetRegions(region);
+  binImage->Allocate();
 
+  ConstIterType imageIter(itkImage, itkImage->GetLargestPossibleRegion());
+  ConstMaskIterType maskIter(mask, mask->GetLargestPossibleRegion());
+  itk::ImageRegionIterator<BinImageType> binIter(binImage, region);
+  mitk::CoocurenceMatrixHolder &quantifier = holders.front();
   while (!maskIter.IsAtEnd())
   {
-    auto ciMask = maskOffsetIter.Begin();
-    auto ciValue = imageOffsetIter.Begin();
-    if (maskIter.Value() > 0 &&
-      ciMask.Get() > 0 &&
-      imageIter.Get() == imageIter.Get() &&
-      ciValue.Get() == ciValue.Get() &&
-      region.IsInside(maskOffsetIter.GetIndex() + ciMask.GetNeighborhoodOffset()))
+    if (maskIter.Value() > 0 && imageIter.Get() == imageIter.Get())
     {
-      int i = holder.IntensityToIndex(imageIter.Get());
-      int j = holder.IntensityToIndex(ciValue.Get());
-      holder.m_Matrix(i, j) += 1;
-      holder.m_Matrix(j, i) += 1;
+      binIter.Set(quantifier.IntensityToIndex(imageIter.Get()));
+    }
+    else
+    {
+      binIter.Set(-1);
     }
-    ++imageOffsetIter;
-    ++maskOffsetIter;
     ++imageIter;
     ++maskIter;
+    ++binIter;
+  }
+
+  const unsigned int splitDimension = VImageDimension - 1;
+  const unsigned int numberOfThreads = std::max(1u, std::min<unsigned int>(itk::MultiThreader::GetGlobalDefaultNumberOfThreads(),
+    static_cast<unsigned int>(region.GetSize(splitDimension))));
+  const int numberOfBins = quantifier.m_NumberOfBins;
+
+  std::vector<std::vector<Eigen::MatrixXd> > threadMatrices(numberOfThreads,
+    std::vector<Eigen::MatrixXd>(offsets.size(), Eigen::MatrixXd::Zero(numberOfBins, numberOfBins)));
+
+  auto accumulate = [&](const typename BinImageType::RegionType &threadRegion, std::vector<Eigen::MatrixXd> &matrices)
+  {
+    itk::ImageRegionConstIteratorWithIndex<BinImageType> iter(binImage, threadRegion);
+    for (; !iter.IsAtEnd(); ++iter)
+    {
+      const int i = iter.Get();
+      if (i < 0)
+      {
+        continue;
+      }
+      const auto index = iter.GetIndex();
+      for (std::size_t o = 0; o < offsets.size(); ++o)
+      {
+        const auto neighbourIndex = index + offsets[o];
+        if (!region.IsInside(neighbourIndex))
+        {
+          continue;
+        }
+        const int j = binImage->GetPixel(neighbourIndex);
+        if (j >= 0)
+        {
+          matrices[o](i, j) += 1;
+          matrices[o](j, i) += 1;
+        }
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  auto threadRegion = region;
+  const auto sliceCount = region.GetSize(splitDimension);
+  for (unsigned int t = 0; t < numberOfThreads; ++t)
+  {
+    const auto begin = sliceCount * t / numberOfThreads;
+    const auto end = sliceCount * (t + 1) / numberOfThreads;
+    threadRegion.SetIndex(splitDimension, region.GetIndex(splitDimension) + static_cast<itk::IndexValueType>(begin));
+    threadRegion.SetSize(splitDimension, end - begin);
+    if (t + 1 == numberOfThreads)
+    {
+      accumulate(threadRegion, threadMatrices[t]);
+    }
+    else
+    {
+      threads.emplace_back(accumulate, threadRegion, std::ref(threadMatrices[t]));
+    }
+  }
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+
+  for (std::size_t o = 0; o < offsets.size(); ++o)
+  {
+    for (unsigned int t = 0; t < numberOfThreads; ++t)
+    {
+      holders[o].m_Matrix += threadMatrices[t][o];
+    }
   }
 }
 
@@ -420,9 +489,7 @@ CalculateCoocurenceFeatures(itk::Image<TPixel, VImageDimension>* itkImage, mitk:
     offset[2] = 1;
   }
 
-  std::vector<mitk::CoocurenceMatrixFeatures> resultVector;
-  mitk::CoocurenceMatrixHolder holderOverall(rangeMin, rangeMax, numberOfBins);
-  mitk::CoocurenceMatrixFeatures overallFeature;
+  std::vector<itk::Offset<VImageDimension> > usedOffsets;
   for (std::size_t i = 0; i < offsetVector.size(); ++i)
   {
     if (config.direction > 1)
@@ -432,12 +499,18 @@ CalculateCoocurenceFeatures(itk::Image<TPixel, VImageDimension>* itkImage, mitk:
         continue;
       }
     }
+    usedOffsets.push_back(offsetVector[i]);
+  }
 
+  std::vector<mitk::CoocurenceMatrixHolder> holders(usedOffsets.size(), mitk::CoocurenceMatrixHolder(rangeMin, rangeMax, numberOfBins));
+  CalculateCoOcMatrices<TPixel, VImageDimension>(itkImage, maskImage, usedOffsets, holders);
 
-    offset = offsetVector[i];
-    mitk::CoocurenceMatrixHolder holder(rangeMin, rangeMax, numberOfBins);
+  std::vector<mitk::CoocurenceMatrixFeatures> resultVector;
+  mitk::CoocurenceMatrixHolder holderOverall(rangeMin, rangeMax, numberOfBins);
+  mitk::CoocurenceMatrixFeatures overallFeature;
+  for (auto &holder : holders)
+  {
     mitk::CoocurenceMatrixFeatures coocResults;
-    CalculateCoOcMatrix<TPixel, VImageDimension>(itkImage, maskImage, offset, config.range, holder);
     holderOverall.m_Matrix += holder.m_Matrix;
     CalculateFeatures(holder, coocResults);
     resultVector.push_back(coocResults);
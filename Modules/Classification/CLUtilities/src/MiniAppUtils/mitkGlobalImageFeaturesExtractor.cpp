@@ -0,0 +1,166 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkGlobalImageFeaturesExtractor.h>
+
+#include <mitkExceptionMacro.h>
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+mitk::cl::GlobalImageFeaturesExtractor::GlobalImageFeaturesExtractor(FeatureFactoryType factory) :
+m_Factory(factory),
+m_NumberOfThreads(0)
+{
+}
+
+void mitk::cl::GlobalImageFeaturesExtractor::SetNumberOfThreads(unsigned int numberOfThreads)
+{
+  m_NumberOfThreads = numberOfThreads;
+}
+
+unsigned int mitk::cl::GlobalImageFeaturesExtractor::GetNumberOfThreads() const
+{
+  return m_NumberOfThreads;
+}
+
+std::size_t mitk::cl::GlobalImageFeaturesExtractor::AddInput(const Input &input)
+{
+  m_Inputs.push_back(input);
+  return m_Inputs.size() - 1;
+}
+
+std::size_t mitk::cl::GlobalImageFeaturesExtractor::GetNumberOfInputs() const
+{
+  return m_Inputs.size();
+}
+
+void mitk::cl::GlobalImageFeaturesExtractor::Extract(const ResultCallbackType &callback)
+{
+  if (m_Inputs.empty())
+  {
+    return;
+  }
+
+  auto cache = mitk::IntensityQuantifierCache::New();
+
+  // The feature sets are created in the calling thread, as the factory
+  // is not required to be thread safe.
+  unsigned int numberOfThreads = m_NumberOfThreads > 0 ? m_NumberOfThreads : std::max(1u, std::thread::hardware_concurrency());
+  std::vector<FeatureVectorType> featureSets;
+  featureSets.push_back(m_Factory());
+  const std::size_t numberOfFeatureClasses = featureSets.front().size();
+  const std::size_t numberOfTasks = m_Inputs.size() * numberOfFeatureClasses;
+  numberOfThreads = static_cast<unsigned int>(std::min<std::size_t>(numberOfThreads, std::max<std::size_t>(numberOfTasks, 1)));
+  while (featureSets.size() < numberOfThreads)
+  {
+    featureSets.push_back(m_Factory());
+  }
+  for (auto &featureSet : featureSets)
+  {
+    if (featureSet.size() != numberOfFeatureClasses)
+    {
+      mitkThrow() << "Feature factory of GlobalImageFeaturesExtractor returned sets of different size.";
+    }
+    for (auto &feature : featureSet)
+    {
+      feature->SetQuantifierCache(cache);
+    }
+  }
+
+  // results[input][featureClass]
+  std::vector<std::vector<FeatureListType> > results(m_Inputs.size(), std::vector<FeatureListType>(numberOfFeatureClasses));
+  std::vector<std::size_t> openTasks(m_Inputs.size(), numberOfFeatureClasses);
+  std::size_t nextInputToEmit = 0;
+  std::mutex resultMutex;
+
+  std::atomic<std::size_t> nextTask(0);
+  std::atomic<bool> aborted(false);
+  std::exception_ptr error;
+
+  // Passes all inputs whose features are complete to the callback, keeping the order of the inputs.
+  // Has to be called with the locked result mutex.
+  auto emitFinishedInputs = [&]()
+  {
+    while (nextInputToEmit < m_Inputs.size() && openTasks[nextInputToEmit] == 0)
+    {
+      FeatureListType features;
+      for (auto &featureList : results[nextInputToEmit])
+      {
+        features.insert(features.end(), featureList.begin(), featureList.end());
+        FeatureListType().swap(featureList);
+      }
+      callback(nextInputToEmit, features);
+      ++nextInputToEmit;
+    }
+  };
+
+  auto worker = [&](FeatureVectorType &featureSet)
+  {
+    while (!aborted)
+    {
+      const std::size_t task = nextTask++;
+      if (task >= numberOfTasks)
+      {
+        break;
+      }
+      // Tasks are ordered by input, so the first inputs are completed (and emitted) first.
+      const std::size_t inputIndex = task / numberOfFeatureClasses;
+      const std::size_t featureIndex = task % numberOfFeatureClasses;
+      const Input &input = m_Inputs[inputIndex];
+
+      try
+      {
+        FeatureListType featureList;
+        auto &feature = featureSet[featureIndex];
+        feature->SetMorphMask(input.morphMask);
+        feature->CalculateFeaturesUsingParameters(input.image, input.mask, input.maskNoNaN, featureList);
+
+        std::lock_guard<std::mutex> lock(resultMutex);
+        results[inputIndex][featureIndex].swap(featureList);
+        --openTasks[inputIndex];
+        emitFinishedInputs();
+      }
+      catch (...)
+      {
+        std::lock_guard<std::mutex> lock(resultMutex);
+        if (!error)
+        {
+          error = std::current_exception();
+        }
+        aborted = true;
+      }
+    }
+  };
+
+  // Inputs without any task (no feature classes) are complete right away.
+  emitFinishedInputs();
+
+  std::vector<std::thread> threads;
+  for (unsigned int i = 1; i < numberOfThreads; ++i)
+  {
+    threads.emplace_back(worker, std::ref(featureSets[i]));
+  }
+  worker(featureSets[0]);
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+
+  if (error)
+  {
+    std::rethrow_exception(error);
+  }
+}
@@ -13,6 +13,7 @@ found in the LICENSE file.
 #include <mitkGlobalImageFeaturesParameter.h>
 
 
+#include <algorithm>
 #include <fstream>
 #include <itkFileTools.h>
 #include <itksys/SystemTools.hxx>
@@ -55,6 +56,7 @@ void mitk::cl::GlobalImageFeaturesParameter::AddParameter(mitkCommandLineParser
   parser.addArgument("binsize", "binsize", mitkCommandLineParser::Float, "Int", "Size of bins that is used. If set, it is overwritten by more specific bin count", us::Any());
   parser.addArgument("ignore-mask-for-histogram", "ignore-mask", mitkCommandLineParser::Bool, "Bool", "If the whole image is used to calculate the histogram. ", us::Any());
   parser.addArgument("encode-parameter-in-name", "encode-parameter", mitkCommandLineParser::Bool, "Bool", "If true, the parameters used for each feature is encoded in its name. ", us::Any());
+  parser.addArgument("threads", "threads", mitkCommandLineParser::Int, "Int", "Number of threads that calculate feature classes and slices concurrently. Default: number of cores. ", us::Any());
 }
 
 void mitk::cl::GlobalImageFeaturesParameter::ParseParameter(std::map<std::string, us::Any> parsedArgs)
@@ -213,4 +215,9 @@ void mitk::cl::GlobalImageFeaturesParameter::ParseGlobalFeatureParameter(std::ma
   {
     encodeParameter = true;
   }
+  numberOfThreads = 0;
+  if (parsedArgs.count("threads"))
+  {
+    numberOfThreads = std::max(0, us::any_cast<int>(parsedArgs["threads"]));
+  }
 }
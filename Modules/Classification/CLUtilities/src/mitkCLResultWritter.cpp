@@ -182,3 +182,19 @@ void mitk::cl::FeatureResultWritter::AddHeader(std::string, int slice, mitk::Abs
     NewRow("EndOfMeasurement");
   }
 }
+
+void mitk::cl::FeatureResultWritter::Flush()
+{
+  if (m_Mode == 1)
+  {
+    return;
+  }
+
+  for (std::size_t i = 0; i < m_CurrentRow; ++i)
+  {
+    m_Output << m_List[i] << std::endl;
+  }
+  m_List.erase(m_List.begin(), m_List.begin() + m_CurrentRow);
+  m_CurrentRow = 0;
+  m_Output.flush();
+}
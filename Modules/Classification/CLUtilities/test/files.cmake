@@ -13,6 +13,8 @@ set(MODULE_TESTS
   mitkGIFNeighbouringGreyLevelDependenceFeatureTest
   mitkGIFVolumetricDensityStatisticsTest
   mitkGIFVolumetricStatisticsTest
+  mitkGlobalImageFeaturesExtractorTest
+  itkEnhancedScalarImageToRunLengthMatrixFilterTest
   #mitkSmoothedClassProbabilitesTest.cpp
   #mitkGlobalFeaturesTest.cpp
 )
@@ -0,0 +1,152 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkTestingMacros.h>
+#include <mitkTestFixture.h>
+
+#include <itkEnhancedScalarImageToRunLengthMatrixFilter.h>
+
+class itkEnhancedScalarImageToRunLengthMatrixFilterTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(itkEnhancedScalarImageToRunLengthMatrixFilterTestSuite);
+
+  MITK_TEST(OffsetHistograms_KnownRuns);
+  MITK_TEST(OffsetHistograms_EqualSingleOffsetRuns);
+
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  typedef itk::Image<double, 3> ImageType;
+  typedef itk::Statistics::EnhancedScalarImageToRunLengthMatrixFilter<ImageType> FilterType;
+
+  ImageType::Pointer m_Image;
+  ImageType::Pointer m_Mask;
+
+  FilterType::Pointer CreateFilter()
+  {
+    FilterType::Pointer filter = FilterType::New();
+    filter->SetInput(m_Image);
+    filter->SetMaskImage(m_Mask);
+    filter->SetNumberOfBinsPerAxis(2);
+    filter->SetPixelValueMinMax(1, 2);
+    filter->SetDistanceValueMinMax(0, 4);
+    return filter;
+  }
+
+  static FilterType::OffsetType Offset(int x, int y, int z)
+  {
+    FilterType::OffsetType offset;
+    offset[0] = x;
+    offset[1] = y;
+    offset[2] = z;
+    return offset;
+  }
+
+  static double Frequency(const FilterType::HistogramType *histogram, unsigned int intensityBin, unsigned int distanceBin)
+  {
+    FilterType::HistogramType::IndexType index(2);
+    index[0] = intensityBin;
+    index[1] = distanceBin;
+    return histogram->GetFrequency(index);
+  }
+
+public:
+
+  /** 4x4x2 image, each row is (1, 1, 2, 2). The second slice is outside of the mask.*/
+  void setUp() override
+  {
+    ImageType::RegionType region;
+    ImageType::SizeType size;
+    size[0] = 4;
+    size[1] = 4;
+    size[2] = 2;
+    region.SetSize(size);
+
+    m_Image = ImageType::New();
+    m_Image->SetRegions(region);
+    m_Image->Allocate();
+    m_Mask = ImageType::New();
+    m_Mask->SetRegions(region);
+    m_Mask->Allocate();
+
+    ImageType::IndexType index;
+    for (index[2] = 0; index[2] < 2; ++index[2])
+    {
+      for (index[1] = 0; index[1] < 4; ++index[1])
+      {
+        for (index[0] = 0; index[0] < 4; ++index[0])
+        {
+          m_Image->SetPixel(index, index[0] < 2 ? 1 : 2);
+          m_Mask->SetPixel(index, index[2] == 0 ? 1 : 0);
+        }
+      }
+    }
+  }
+
+  void OffsetHistograms_KnownRuns()
+  {
+    FilterType::OffsetVectorPointer offsets = FilterType::OffsetVector::New();
+    offsets->push_back(Offset(1, 0, 0));
+    offsets->push_back(Offset(0, 1, 0));
+
+    FilterType::Pointer filter = CreateFilter();
+    filter->SetOffsets(offsets);
+    filter->Update();
+
+    // Along x, every row has two runs of two voxels (one step)
+    const FilterType::HistogramType *xHistogram = filter->GetOutputForOffset(0);
+    CPPUNIT_ASSERT_EQUAL(4.0, Frequency(xHistogram, 0, 0));
+    CPPUNIT_ASSERT_EQUAL(4.0, Frequency(xHistogram, 1, 0));
+    CPPUNIT_ASSERT_EQUAL(0.0, Frequency(xHistogram, 0, 1));
+    CPPUNIT_ASSERT_EQUAL(0.0, Frequency(xHistogram, 1, 1));
+
+    // Along y, every column is one run of four voxels (three steps)
+    const FilterType::HistogramType *yHistogram = filter->GetOutputForOffset(1);
+    CPPUNIT_ASSERT_EQUAL(0.0, Frequency(yHistogram, 0, 0));
+    CPPUNIT_ASSERT_EQUAL(0.0, Frequency(yHistogram, 1, 0));
+    CPPUNIT_ASSERT_EQUAL(2.0, Frequency(yHistogram, 0, 1));
+    CPPUNIT_ASSERT_EQUAL(2.0, Frequency(yHistogram, 1, 1));
+
+    // The output is the sum over all offsets
+    CPPUNIT_ASSERT_EQUAL(4.0, Frequency(filter->GetOutput(), 0, 0));
+    CPPUNIT_ASSERT_EQUAL(2.0, Frequency(filter->GetOutput(), 1, 1));
+  }
+
+  void OffsetHistograms_EqualSingleOffsetRuns()
+  {
+    FilterType::OffsetVectorPointer offsets = FilterType::OffsetVector::New();
+    offsets->push_back(Offset(1, 0, 0));
+    offsets->push_back(Offset(1, 1, 0));
+    offsets->push_back(Offset(-1, 1, 0));
+    offsets->push_back(Offset(0, 0, 1));
+
+    FilterType::Pointer filter = CreateFilter();
+    filter->SetOffsets(offsets);
+    filter->Update();
+
+    for (unsigned int i = 0; i < offsets->Size(); ++i)
+    {
+      FilterType::Pointer singleFilter = CreateFilter();
+      singleFilter->SetOffset(offsets->ElementAt(i));
+      singleFilter->Update();
+
+      const FilterType::HistogramType *expected = singleFilter->GetOutput();
+      const FilterType::HistogramType *histogram = filter->GetOutputForOffset(i);
+      for (unsigned int id = 0; id < expected->Size(); ++id)
+      {
+        CPPUNIT_ASSERT_EQUAL(expected->GetFrequency(id), histogram->GetFrequency(id));
+      }
+    }
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(itkEnhancedScalarImageToRunLengthMatrixFilter)
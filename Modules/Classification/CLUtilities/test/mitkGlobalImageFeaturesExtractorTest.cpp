@@ -0,0 +1,139 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkTestingMacros.h>
+#include <mitkTestFixture.h>
+#include "mitkIOUtil.h"
+
+#include <mitkGlobalImageFeaturesExtractor.h>
+#include <mitkGIFCooccurenceMatrix2.h>
+#include <mitkGIFFirstOrderHistogramStatistics.h>
+#include <mitkGIFGreyLevelSizeZone.h>
+#include <mitkGIFVolumetricStatistics.h>
+
+class mitkGlobalImageFeaturesExtractorTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkGlobalImageFeaturesExtractorTestSuite);
+
+  MITK_TEST(Extract_EqualsSerialCalculation);
+  MITK_TEST(QuantifierCache_SharesQuantifier);
+
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  mitk::Image::Pointer m_IBSI_Phantom_Image_Small;
+  mitk::Image::Pointer m_IBSI_Phantom_Image_Large;
+  mitk::Image::Pointer m_IBSI_Phantom_Mask_Small;
+  mitk::Image::Pointer m_IBSI_Phantom_Mask_Large;
+
+  static mitk::cl::GlobalImageFeaturesExtractor::FeatureVectorType CreateFeatures()
+  {
+    mitk::AbstractGlobalImageFeature::ParameterTypes parameter;
+    parameter["volume"] = us::Any(true);
+    parameter["first-order-histogram"] = us::Any(true);
+    parameter["cooccurence2"] = us::Any(true);
+    parameter["grey-level-sizezone"] = us::Any(true);
+
+    mitk::cl::GlobalImageFeaturesExtractor::FeatureVectorType features;
+    features.push_back(mitk::GIFVolumetricStatistics::New().GetPointer());
+    features.push_back(mitk::GIFFirstOrderHistogramStatistics::New().GetPointer());
+    features.push_back(mitk::GIFCooccurenceMatrix2::New().GetPointer());
+    features.push_back(mitk::GIFGreyLevelSizeZone::New().GetPointer());
+    for (auto feature : features)
+    {
+      feature->SetParameter(parameter);
+    }
+    return features;
+  }
+
+public:
+
+  void setUp(void) override
+  {
+    m_IBSI_Phantom_Image_Small = mitk::IOUtil::Load<mitk::Image>(GetTestDataFilePath("Radiomics/IBSI_Phantom_Image_Small.nrrd"));
+    m_IBSI_Phantom_Image_Large = mitk::IOUtil::Load<mitk::Image>(GetTestDataFilePath("Radiomics/IBSI_Phantom_Image_Large.nrrd"));
+    m_IBSI_Phantom_Mask_Small = mitk::IOUtil::Load<mitk::Image>(GetTestDataFilePath("Radiomics/IBSI_Phantom_Mask_Small.nrrd"));
+    m_IBSI_Phantom_Mask_Large = mitk::IOUtil::Load<mitk::Image>(GetTestDataFilePath("Radiomics/IBSI_Phantom_Mask_Large.nrrd"));
+  }
+
+  void Extract_EqualsSerialCalculation()
+  {
+    std::vector<mitk::cl::GlobalImageFeaturesExtractor::Input> inputs(2);
+    inputs[0].image = m_IBSI_Phantom_Image_Small;
+    inputs[0].mask = m_IBSI_Phantom_Mask_Small;
+    inputs[1].image = m_IBSI_Phantom_Image_Large;
+    inputs[1].mask = m_IBSI_Phantom_Mask_Large;
+
+    mitk::cl::GlobalImageFeaturesExtractor extractor(&CreateFeatures);
+    extractor.SetNumberOfThreads(4);
+    for (auto &input : inputs)
+    {
+      input.maskNoNaN = input.mask;
+      input.morphMask = input.mask;
+      extractor.AddInput(input);
+    }
+
+    std::vector<std::size_t> emittedInputs;
+    std::vector<mitk::AbstractGlobalImageFeature::FeatureListType> results;
+    extractor.Extract([&](std::size_t inputIndex, const mitk::AbstractGlobalImageFeature::FeatureListType &features)
+    {
+      emittedInputs.push_back(inputIndex);
+      results.push_back(features);
+    });
+
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Every input should be passed once to the callback.", std::size_t(2), results.size());
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Inputs should be passed in order.", std::size_t(0), emittedInputs[0]);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Inputs should be passed in order.", std::size_t(1), emittedInputs[1]);
+
+    for (std::size_t i = 0; i < inputs.size(); ++i)
+    {
+      mitk::AbstractGlobalImageFeature::FeatureListType serialResults;
+      for (auto feature : CreateFeatures())
+      {
+        feature->SetMorphMask(inputs[i].morphMask);
+        feature->CalculateFeaturesUsingParameters(inputs[i].image, inputs[i].mask, inputs[i].maskNoNaN, serialResults);
+      }
+
+      CPPUNIT_ASSERT_EQUAL_MESSAGE("Extractor should calculate the same features as the serial calculation.", serialResults.size(), results[i].size());
+      for (std::size_t j = 0; j < serialResults.size(); ++j)
+      {
+        CPPUNIT_ASSERT_EQUAL_MESSAGE("Features should have the same order.", serialResults[j].first, results[i][j].first);
+        if (serialResults[j].second == serialResults[j].second)
+        {
+          CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE(serialResults[j].first, serialResults[j].second, results[i][j].second, 1e-10);
+        }
+      }
+    }
+  }
+
+  void QuantifierCache_SharesQuantifier()
+  {
+    auto cache = mitk::IntensityQuantifierCache::New();
+    auto first = mitk::GIFFirstOrderHistogramStatistics::New();
+    auto second = mitk::GIFGreyLevelSizeZone::New();
+    first->SetQuantifierCache(cache);
+    second->SetQuantifierCache(cache);
+
+    first->InitializeQuantifier(m_IBSI_Phantom_Image_Large, m_IBSI_Phantom_Mask_Large);
+    second->InitializeQuantifier(m_IBSI_Phantom_Image_Large, m_IBSI_Phantom_Mask_Large);
+    CPPUNIT_ASSERT_MESSAGE("Equal settings should share the quantifier.", first->GetQuantifier() == second->GetQuantifier());
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), cache->GetNumberOfQuantifiers());
+
+    second->SetUseBins(true);
+    second->SetBins(16);
+    second->InitializeQuantifier(m_IBSI_Phantom_Image_Large, m_IBSI_Phantom_Mask_Large);
+    CPPUNIT_ASSERT_MESSAGE("Different settings should not share the quantifier.", first->GetQuantifier() != second->GetQuantifier());
+    CPPUNIT_ASSERT_EQUAL(16u, second->GetQuantifier()->GetBins());
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkGlobalImageFeaturesExtractor)
@@ -21,6 +21,8 @@ found in the LICENSE file.
 
 #include <mitkBaseData.h>
 
+#include <functional>
+
 namespace mitk
 {
   class MITKCLVIGRARANDOMFOREST_EXPORT VigraRandomForestClassifier : public AbstractClassifier
@@ -42,6 +44,23 @@ namespace mitk
     Eigen::MatrixXi Predict(const Eigen::MatrixXd &X) override;
     Eigen::MatrixXi PredictWeighted(const Eigen::MatrixXd &X);
 
+    /** Fills the rows of the passed matrix (shape = [block size, n_features]) with the features of the next samples
+     * and returns the number of filled rows. Returning 0 ends the prediction.*/
+    typedef std::function<Eigen::Index(Eigen::MatrixXd &)> FeatureBlockReaderType;
+    /** Receives the labels (shape = [n_samples, 1]) and class probabilities of the samples of the last read block.*/
+    typedef std::function<void(const Eigen::MatrixXi &, const Eigen::MatrixXd &)> PredictionBlockWriterType;
+
+    ///
+    /// @brief Predicts the classes of samples that are streamed block-wise instead of being passed as one matrix.
+    /// The block size is chosen so that the features, labels and probabilities of one block fit into the
+    /// PredictionMemoryBudget. Each block is predicted by all threads like in Predict().
+    ///
+    void PredictBlockwise(const FeatureBlockReaderType &reader, const PredictionBlockWriterType &writer);
+
+    /** Number of bytes used for the feature, label and probability matrices of one block in PredictBlockwise().*/
+    itkSetMacro(PredictionMemoryBudget, std::size_t);
+    itkGetConstMacro(PredictionMemoryBudget, std::size_t);
+
 
     bool SupportsPointWiseWeight() override;
     bool SupportsPointWiseProbability() override;
@@ -80,6 +99,7 @@ namespace mitk
     Eigen::MatrixXd m_TreeWeights;
 
     Parameter * m_Parameter;
+    std::size_t m_PredictionMemoryBudget;
     vigra::RandomForest<int> m_RandomForest;
 
     static ITK_THREAD_RETURN_TYPE TrainTreesCallback(void *);
@@ -17,6 +17,9 @@ found in the LICENSE file.
 #include <mitkLinearSplitting.h>
 #include <mitkProperties.h>
 
+// STD includes
+#include <algorithm>
+
 // Vigra includes
 #include <vigra/random_forest.hxx>
 #include <vigra/random_forest/rf_split.hxx>
@@ -94,7 +97,8 @@ struct mitk::VigraRandomForestClassifier::PredictionData
 };
 
 mitk::VigraRandomForestClassifier::VigraRandomForestClassifier()
-  :m_Parameter(nullptr)
+  :m_Parameter(nullptr),
+  m_PredictionMemoryBudget(256 * 1024 * 1024)
 {
   itk::SimpleMemberCommand<mitk::VigraRandomForestClassifier>::Pointer command = itk::SimpleMemberCommand<mitk::VigraRandomForestClassifier>::New();
   command->SetCallbackFunction(this, &mitk::VigraRandomForestClassifier::ConvertParameter);
@@ -235,6 +239,35 @@ Eigen::MatrixXi mitk::VigraRandomForestClassifier::PredictWeighted(const Eigen::
 
 
 
+void mitk::VigraRandomForestClassifier::PredictBlockwise(const FeatureBlockReaderType &reader, const PredictionBlockWriterType &writer)
+{
+  const Eigen::Index numberOfFeatures = m_RandomForest.feature_count();
+  const std::size_t bytesPerSample = sizeof(double) * (numberOfFeatures + m_RandomForest.class_count()) + sizeof(int);
+  const Eigen::Index blockSize = std::max<Eigen::Index>(m_PredictionMemoryBudget / bytesPerSample, 1);
+
+  Eigen::MatrixXd features(blockSize, numberOfFeatures);
+  while (true)
+  {
+    if (features.rows() != blockSize)
+    {
+      features.resize(blockSize, numberOfFeatures);
+    }
+
+    const Eigen::Index numberOfSamples = reader(features);
+    if (numberOfSamples <= 0)
+    {
+      break;
+    }
+    if (numberOfSamples < blockSize)
+    {
+      features.conservativeResize(numberOfSamples, Eigen::NoChange);
+    }
+
+    this->Predict(features);
+    writer(m_OutLabel, m_OutProbability);
+  }
+}
+
 void mitk::VigraRandomForestClassifier::SetTreeWeights(Eigen::MatrixXd weights)
 {
   m_TreeWeights = weights;
@@ -23,6 +23,8 @@ found in the LICENSE file.
 #include <mitkImageCast.h>
 #include <mitkStandaloneDataStorage.h>
 
+#include <algorithm>
+
 class mitkVigraRandomForestTestSuite : public mitk::TestFixture
 {
   CPPUNIT_TEST_SUITE(mitkVigraRandomForestTestSuite  );
@@ -35,6 +37,7 @@ class mitkVigraRandomForestTestSuite : public mitk::TestFixture
   MITK_TEST(TrainThreadedDecisionForest_MatlabDataSet_shouldReturnTrue);
   MITK_TEST(PredictWeightedDecisionForest_SetWeightsToZero_shouldReturnTrue);
   MITK_TEST(TrainThreadedDecisionForest_BreastCancerDataSet_shouldReturnTrue);
+  MITK_TEST(PredictBlockwise_MatlabDataSet_shouldEqualPredict);
   CPPUNIT_TEST_SUITE_END();
 
 private:
@@ -172,6 +175,54 @@ public:
   }
 
 
+  // ------------------------------------------------------------------------------------------------------
+  // ------------------------------------------------------------------------------------------------------
+  /*
+  The block-wise prediction with a small memory budget has to yield the same result as the prediction
+  of the complete feature matrix.
+  */
+  void PredictBlockwise_MatlabDataSet_shouldEqualPredict()
+  {
+    auto & Features_Training = FeatureData_Matlab.first;
+    auto & Features_Testing = FeatureData_Matlab.second;
+    auto & Labels_Training = LabelData_Matlab.first;
+
+    classifier->Train(Features_Training,Labels_Training);
+    Eigen::MatrixXi classes = classifier->Predict(Features_Testing);
+    Eigen::MatrixXd probabilities = classifier->GetPointWiseProbabilities();
+
+    // budget for 7 samples per block, so the last block is incomplete
+    const std::size_t bytesPerSample = sizeof(double) * (Features_Testing.cols() + probabilities.cols()) + sizeof(int);
+    classifier->SetPredictionMemoryBudget(7 * bytesPerSample);
+
+    Eigen::MatrixXi blockClasses(classes.rows(), 1);
+    Eigen::MatrixXd blockProbabilities(probabilities.rows(), probabilities.cols());
+    Eigen::Index readRows = 0;
+    Eigen::Index writtenRows = 0;
+    unsigned int numberOfBlocks = 0;
+
+    classifier->PredictBlockwise(
+      [&](Eigen::MatrixXd &block)
+      {
+        const Eigen::Index rows = std::min(block.rows(), Features_Testing.rows() - readRows);
+        block.topRows(rows) = Features_Testing.middleRows(readRows, rows);
+        readRows += rows;
+        return rows;
+      },
+      [&](const Eigen::MatrixXi &labels, const Eigen::MatrixXd &blockProbability)
+      {
+        blockClasses.middleRows(writtenRows, labels.rows()) = labels;
+        blockProbabilities.middleRows(writtenRows, labels.rows()) = blockProbability;
+        writtenRows += labels.rows();
+        ++numberOfBlocks;
+      });
+
+    CPPUNIT_ASSERT_EQUAL(classes.rows(), writtenRows);
+    CPPUNIT_ASSERT_EQUAL(static_cast<unsigned int>((classes.rows() + 6) / 7), numberOfBlocks);
+    CPPUNIT_ASSERT_MESSAGE("Block-wise labels differ from Predict().", classes == blockClasses);
+    CPPUNIT_ASSERT_MESSAGE("Block-wise probabilities differ from Predict().", probabilities.isApprox(blockProbabilities));
+  }
+
   // ------------------------------------------------------------------------------------------------------
   // ------------------------------------------------------------------------------------------------------
   /*Reading an file, which includes the trainingdataset and the testdataset, and convert the
@@ -0,0 +1,101 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkDataCollectionMatrixBlockIterator.h>
+
+#include <mitkDataCollectionUtilities.h>
+
+#include <algorithm>
+
+mitk::DataCollectionMatrixBlockIterator::DataCollectionMatrixBlockIterator(DataCollection::Pointer dc, const std::vector<std::string> &names, std::string mask)
+  : m_Collection(dc), m_Mask(mask), m_MaskIterator(dc, mask), m_LastBlockSize(0)
+{
+  for (std::size_t i = 0; i < names.size(); ++i)
+  {
+    DoubleIteratorType iter(dc, names[i]);
+    m_DataIterators.push_back(iter);
+  }
+}
+
+Eigen::Index mitk::DataCollectionMatrixBlockIterator::ReadBlock(Eigen::MatrixXd &block)
+{
+  const int numberOfNames = m_DataIterators.size();
+
+  Eigen::Index row = 0;
+  while (row < block.rows() && !m_MaskIterator.IsAtEnd())
+  {
+    if (m_MaskIterator.GetVoxel() > 0)
+    {
+      for (int col = 0; col < numberOfNames; ++col)
+      {
+        block(row, col) = m_DataIterators[col].GetVoxel();
+      }
+      ++row;
+    }
+    for (int col = 0; col < numberOfNames; ++col)
+    {
+      ++(m_DataIterators[col]);
+    }
+    ++m_MaskIterator;
+  }
+
+  m_LastBlockSize = row;
+  return row;
+}
+
+template <typename TDataIterator, typename TMatrix>
+void mitk::DataCollectionMatrixBlockIterator::WriteColumn(OutputIterators<TDataIterator> &output, const TMatrix &matrix, Eigen::Index col, Eigen::Index numberOfRows)
+{
+  Eigen::Index row = 0;
+  while (row < numberOfRows && !output.mask.IsAtEnd())
+  {
+    if (output.mask.GetVoxel() > 0)
+    {
+      output.data.SetVoxel(matrix(row, col));
+      ++row;
+    }
+    ++(output.data);
+    ++(output.mask);
+  }
+}
+
+void mitk::DataCollectionMatrixBlockIterator::WriteBlock(const Eigen::MatrixXd &matrix, const std::vector<std::string> &names)
+{
+  const Eigen::Index numberOfRows = std::min(matrix.rows(), m_LastBlockSize);
+  for (std::size_t col = 0; col < names.size(); ++col)
+  {
+    auto finding = m_DoubleOutputs.find(names[col]);
+    if (finding == m_DoubleOutputs.end())
+    {
+      DCUtilities::EnsureDoubleImageInDC(m_Collection, names[col], m_Mask);
+      OutputIterators<DoubleIteratorType> output = { MaskIteratorType(m_Collection, m_Mask), DoubleIteratorType(m_Collection, names[col]) };
+      finding = m_DoubleOutputs.insert(std::make_pair(names[col], output)).first;
+    }
+    WriteColumn(finding->second, matrix, col, numberOfRows);
+  }
+}
+
+void mitk::DataCollectionMatrixBlockIterator::WriteBlock(const Eigen::MatrixXi &matrix, const std::vector<std::string> &names)
+{
+  const Eigen::Index numberOfRows = std::min(matrix.rows(), m_LastBlockSize);
+  for (std::size_t col = 0; col < names.size(); ++col)
+  {
+    auto finding = m_UCharOutputs.find(names[col]);
+    if (finding == m_UCharOutputs.end())
+    {
+      DCUtilities::EnsureUCharImageInDC(m_Collection, names[col], m_Mask);
+      OutputIterators<UCharIteratorType> output = { MaskIteratorType(m_Collection, m_Mask), UCharIteratorType(m_Collection, names[col]) };
+      finding = m_UCharOutputs.insert(std::make_pair(names[col], output)).first;
+    }
+    WriteColumn(finding->second, matrix, col, numberOfRows);
+  }
+}
@@ -0,0 +1,74 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkDataCollectionMatrixBlockIterator_h
+#define mitkDataCollectionMatrixBlockIterator_h
+
+#include <MitkDataCollectionExports.h>
+
+#include <mitkDataCollection.h>
+#include <mitkDataCollectionImageIterator.h>
+#include <Eigen/Dense>
+
+#include <map>
+
+namespace mitk
+{
+  /**
+  \brief Block-wise counterpart of DCUtilities::DC3dDToMatrixXd and DCUtilities::MatrixToDC3d.
+
+  The voxels inside of the mask are read in blocks of rows, so only one block of the feature matrix has to be kept
+  in memory. Results for a block can be written back into the collection with WriteBlock(). The rows of the passed
+  matrix are assigned to the same voxels that were read by the corresponding call of ReadBlock(). Missing result
+  images are created like in DCUtilities::MatrixToDC3d.
+  */
+  class MITKDATACOLLECTION_EXPORT DataCollectionMatrixBlockIterator
+  {
+  public:
+    DataCollectionMatrixBlockIterator(DataCollection::Pointer dc, const std::vector<std::string> &names, std::string mask);
+
+    /** Reads the next masked voxels into the rows of block (at most block.rows() voxels).
+     * @return number of rows that were filled. 0 if all voxels of the mask have been read.*/
+    Eigen::Index ReadBlock(Eigen::MatrixXd &block);
+
+    /** Writes the first rows of the matrix to the images names (one image per column).*/
+    void WriteBlock(const Eigen::MatrixXd &matrix, const std::vector<std::string> &names);
+    void WriteBlock(const Eigen::MatrixXi &matrix, const std::vector<std::string> &names);
+
+  private:
+    typedef DataCollectionImageIterator<unsigned char, 3> MaskIteratorType;
+    typedef DataCollectionImageIterator<double, 3> DoubleIteratorType;
+    typedef DataCollectionImageIterator<unsigned char, 3> UCharIteratorType;
+
+    template <typename TDataIterator>
+    struct OutputIterators
+    {
+      MaskIteratorType mask;
+      TDataIterator data;
+    };
+
+    template <typename TDataIterator, typename TMatrix>
+    static void WriteColumn(OutputIterators<TDataIterator> &output, const TMatrix &matrix, Eigen::Index col, Eigen::Index numberOfRows);
+
+    DataCollection::Pointer m_Collection;
+    std::string m_Mask;
+
+    MaskIteratorType m_MaskIterator;
+    std::vector<DoubleIteratorType> m_DataIterators;
+    Eigen::Index m_LastBlockSize;
+
+    std::map<std::string, OutputIterators<DoubleIteratorType> > m_DoubleOutputs;
+    std::map<std::string, OutputIterators<UCharIteratorType> > m_UCharOutputs;
+  };
+}
+
+#endif
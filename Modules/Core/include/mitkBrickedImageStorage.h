@@ -0,0 +1,164 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkBrickedImageStorage_h
+#define mitkBrickedImageStorage_h
+
+#include <MitkCoreExports.h>
+#include <mitkCommon.h>
+#include <mitkPixelType.h>
+
+#include <itkImageRegion.h>
+#include <itkLightObject.h>
+
+#include <fstream>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace mitk
+{
+  class Image;
+
+  /** \brief Pixel storage of 3D+t images that do not fit into memory.
+   *
+   * The pixels are stored in cubic bricks (64^3 voxels by default) in a local brick file, one
+   * brick after the other and time step by time step. Only the bricks that intersect a requested
+   * region are read from the file. They are kept in a least recently used cache whose size is
+   * limited by a memory budget (512 MiB by default). Modified bricks are written back to the file
+   * when they are evicted from the cache or Flush() is called.
+   *
+   * The brick file consists of a small header (pixel type, dimensions and brick size in native
+   * byte order) followed by the bricks. Bricks at the upper borders of the image are stored with
+   * the full brick size as well, so the position of each brick in the file is known.
+   *
+   * Use mitk::Image::SetBrickedStorage() to back an image by a storage. Slices, volumes and
+   * regions of such an image (see mitk::Image::GetRegionData() and mitk::ImageReadAccessor) are
+   * read from the bricks each time they are requested and not kept by the image. Data written via
+   * mitk::ImageWriteAccessor or mitk::Image::SetImportVolume() etc. is written to the bricks.
+   *
+   * ReadRegion() may be called concurrently. WriteRegion() must not be called concurrently with
+   * accesses to the same bricks.
+   */
+  class MITKCORE_EXPORT BrickedImageStorage : public itk::LightObject
+  {
+  public:
+    mitkClassMacroItkParent(BrickedImageStorage, itk::LightObject);
+
+    /** Opens an existing brick file. Throws an mitk::Exception if the file cannot be opened or
+     * is no valid brick file. Files that are not writable are opened read-only.*/
+    mitkNewMacro1Param(Self, const std::string &);
+
+    typedef itk::ImageRegion<3> RegionType;
+
+    /** Header at the beginning of brick files.*/
+    struct Header;
+
+    /** Creates a brick file of the passed pixel type and dimensions (x, y, z and t) with all pixels
+     * set to zero. An existing file is overwritten. Throws an mitk::Exception on failure.*/
+    static Pointer Create(const std::string &fileName,
+                          const PixelType &pixelType,
+                          const unsigned int *dimensions,
+                          unsigned int brickSize = 64);
+
+    /** Creates a brick file with the pixel type, dimensions and pixels of the passed 3D or 3D+t image.*/
+    static Pointer Create(const std::string &fileName, const Image *image, unsigned int brickSize = 64);
+
+    const std::string &GetFileName() const { return m_FileName; }
+    const PixelType &GetPixelType() const { return m_PixelType; }
+    /** Dimensions x, y, z and t.*/
+    const unsigned int *GetDimensions() const { return m_Dimensions; }
+    unsigned int GetBrickSize() const { return m_BrickSize; }
+    bool IsReadOnly() const { return m_ReadOnly; }
+
+    /** Maximum size of the cached bricks in bytes. Bricks that are in use are never evicted, so the
+     * cache may exceed the budget temporarily.*/
+    void SetMemoryBudget(std::size_t bytes);
+    std::size_t GetMemoryBudget() const;
+    std::size_t GetCachedBytes() const;
+
+    /** Number of bricks read from the file and number of brick requests served by the cache.*/
+    unsigned long GetNumberOfBrickReads() const;
+    unsigned long GetNumberOfCacheHits() const;
+
+    /** Copies the pixels of the region of the passed time step into the buffer, which must hold
+     * region.GetNumberOfPixels() pixels. Throws an mitk::Exception if the region is not inside the image.*/
+    void ReadRegion(const RegionType &region, unsigned int timeStep, void *buffer) const;
+
+    /** Copies the pixels of the buffer into the region of the passed time step.*/
+    void WriteRegion(const RegionType &region, unsigned int timeStep, const void *buffer);
+
+    /** Writes all modified bricks to the file.*/
+    void Flush();
+
+    /** Writes all modified bricks to the file and empties the cache.*/
+    void ClearCache();
+
+  protected:
+    explicit BrickedImageStorage(const std::string &fileName);
+    BrickedImageStorage(const std::string &fileName, const Header &header);
+    ~BrickedImageStorage() override;
+
+  private:
+    BrickedImageStorage(const BrickedImageStorage &) = delete;
+    BrickedImageStorage &operator=(const BrickedImageStorage &) = delete;
+
+    struct Brick
+    {
+      std::vector<char> data;
+      bool modified;
+    };
+
+    typedef std::shared_ptr<Brick> BrickPointer;
+    typedef std::list<std::pair<std::size_t, BrickPointer>> BrickListType;
+
+    /** Checks the region and calls the functor for each brick that intersects it with the index
+     * and the coordinates of the brick and the begin and end index of the intersection.*/
+    template <typename TFunctor>
+    void ForEachBrick(const RegionType &region, unsigned int timeStep, TFunctor functor) const;
+
+    BrickPointer GetBrick(std::size_t brickIndex) const;
+    void InsertBrickUnlocked(std::size_t brickIndex, const BrickPointer &brick) const;
+    /** Evicts least recently used bricks until the budget is met. Bricks that are in use are skipped.*/
+    void EvictBricksUnlocked() const;
+    void ReadBrickFromFile(std::size_t brickIndex, char *data) const;
+    void WriteBrickToFile(std::size_t brickIndex, const char *data) const;
+    std::size_t GetBrickOffset(std::size_t brickIndex) const;
+
+    std::string m_FileName;
+    PixelType m_PixelType;
+    unsigned int m_Dimensions[4];
+    unsigned int m_BrickSize;
+    /** Number of bricks in x, y and z direction.*/
+    unsigned int m_NumberOfBricks[3];
+    std::size_t m_BytesPerPixel;
+    std::size_t m_BytesPerBrick;
+    std::size_t m_HeaderSize;
+    bool m_ReadOnly;
+
+    mutable std::mutex m_FileMutex;
+    mutable std::fstream m_File;
+
+    mutable std::mutex m_CacheMutex;
+    mutable BrickListType m_Bricks;
+    mutable std::unordered_map<std::size_t, BrickListType::iterator> m_BrickMap;
+    mutable std::size_t m_CachedBytes;
+    std::size_t m_MemoryBudget;
+    mutable unsigned long m_NumberOfBrickReads;
+    mutable unsigned long m_NumberOfCacheHits;
+  };
+}
+
+#endif
@@ -159,6 +159,9 @@ namespace mitk
     /// To be called by a toolkit specific CallbackFromGUIThreadImplementation.
     static void RegisterImplementation(CallbackFromGUIThreadImplementation *implementation);
 
+    /// True if a toolkit specific implementation has been registered, i.e. there is a GUI thread to call.
+    static bool HasImplementation();
+
     /// Change the current application cursor
     void CallThisFromGUIThread(itk::Command *, itk::EventObject *e = nullptr);
 
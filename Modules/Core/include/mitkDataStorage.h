@@ -98,7 +98,7 @@ namespace mitk
     //## (see definition of NodePredicateBase for details).
     //## The method returns a set of SmartPointers to the DataNodes that fulfill the
     //## conditions. A set of all objects can be retrieved with the GetAll() method;
-    SetOfObjects::ConstPointer GetSubset(const NodePredicateBase *condition) const;
+    virtual SetOfObjects::ConstPointer GetSubset(const NodePredicateBase *condition) const;
 
     //##Documentation
     //## @brief returns a set of source objects for a given node that meet the given condition(s).
@@ -108,6 +108,18 @@ namespace mitk
       this->m_ZMax = zMax;
     }
 
+    /** \brief Project a slab around the plane while reslicing (see vtkImageReslice::SetSlabMode()).
+    * The numberOfSlices samples along the plane normal are spaced by the z spacing (SetOutputSpacingZDirection())
+    * and reduced by the mode (VTK_IMAGE_SLAB_MIN, VTK_IMAGE_SLAB_MAX, VTK_IMAGE_SLAB_MEAN or VTK_IMAGE_SLAB_SUM)
+    * while the slice is resliced, so no 3D slab is created. A numberOfSlices of 1 (default) disables the projection.
+    * Only used for an output dimension of 2.
+    */
+    void SetSlabMode(int mode, int numberOfSlices)
+    {
+      this->m_SlabMode = mode;
+      this->m_SlabNumberOfSlices = numberOfSlices;
+    }
+
     /** \brief Get the bounding box of the slice [xMin, xMax, yMin, yMax, zMin, zMax]
     * The method uses the input of the filter to calculate the bounds.
     * It is recommended to use
@@ -180,6 +192,10 @@ namespace mitk
 
     int m_ZMax;
 
+    int m_SlabMode;
+
+    int m_SlabNumberOfSlices;
+
     ResliceInterpolation m_InterpolationMode;
 
     bool m_InPlaneResampleExtentByGeometry; // Resampling grid corresponds to:  false->image    true->worldgeometry
@@ -32,6 +32,16 @@ namespace mitk
    * faster by several orders of magnitude as long as the input image was
    * neither changed nor modified.
    *
+   * The rows of the output image are sampled in parallel. Planes whose pixels
+   * are all located on the voxel grid of the input image (e.g. axis-aligned
+   * planes through voxel centers) are copied voxel by voxel for nearest
+   * neighbor and linear interpolation. For all other planes, the continuous
+   * index is stepped incrementally along the rows instead of transforming
+   * each pixel from world coordinates.
+   *
+   * Input images that are backed by a mitk::BrickedImageStorage are only
+   * read in the bounding region of the output plane.
+   *
    * This filter is completely based on ITK compared to the VTK-based
    * mitk::ExtractSliceFilter. It is more robust, easy to use, and produces
    * an mitk::Image with valid geometry. Generally it is not as fast as
@@ -67,8 +77,6 @@ namespace mitk
     ~ExtractSliceFilter2() override;
 
     void AllocateOutputs() override;
-    // void BeforeThreadedGenerateData() override;
-    // void ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType threadId) override;
     void GenerateData() override;
     void VerifyInputInformation() override;
 
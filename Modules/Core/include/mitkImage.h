@@ -14,6 +14,7 @@ found in the LICENSE file.
 #define MITKIMAGE_H_HEADER_INCLUDED_C1C2FCD2
 
 #include "mitkBaseData.h"
+#include "mitkBrickedImageStorage.h"
 #include "mitkImageAccessorBase.h"
 #include "mitkImageDataItem.h"
 #include "mitkImageDescriptor.h"
@@ -31,6 +32,10 @@ found in the LICENSE file.
 #include <itkHistogram.h>
 #endif
 
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+
 class vtkImageData;
 
 namespace itk
@@ -73,6 +78,7 @@ namespace mitk
   {
     friend class SubImageSelector;
 
+    friend class ImageDataItem;
     friend class ImageAccessorBase;
     friend class ImageVtkAccessor;
     friend class ImageVtkReadAccessor;
@@ -134,7 +140,8 @@ namespace mitk
     /** @brief Get the data vector of the complete image, i.e., of all channels linked together.
 
     If you only want to access a slice, volume at a specific time or single channel
-    use one of the SubImageSelector classes.
+    use one of the SubImageSelector classes. Throws mitk::Exception for bricked images (see SetBrickedStorage()),
+    since writes to the returned memory would not reach the bricks.
      \deprecatedSince{2012_09} Please use image accessors instead: See Doxygen/Related-Pages/Concepts/Image. This method
     can be replaced by ImageWriteAccessor::GetData() or ImageReadAccessor::GetData() */
     DEPRECATED(virtual void *GetData());
@@ -160,6 +167,9 @@ namespace mitk
 
     //##Documentation
     //## @brief Get a volume at a specific time @a t of channel @a n as a vtkImageData.
+    //##
+    //## Throws mitk::Exception for bricked images (see SetBrickedStorage()), which do not keep their volumes.
+    //## Use GetRegionData() or ImageReadAccessor instead.
     virtual vtkImageData *GetVtkImageData(int t = 0, int n = 0);
     virtual const vtkImageData *GetVtkImageData(int t = 0, int n = 0) const;
 
@@ -182,6 +192,44 @@ namespace mitk
     //## @brief Check whether the channel @a n is set
     bool IsChannelSet(int n = 0) const override;
 
+    //##Documentation
+    //## @brief Announce that the pixel data of channel 0 is filled slice by slice in the background.
+    //##
+    //## Streaming readers call this after the image has been initialized and its volumes have been
+    //## allocated. They report every decoded slice via SetSliceLoaded() and call EndProgressiveLoading()
+    //## when they are done. Slices that are not loaded yet keep their initial content. Mappers use
+    //## GetNumberOfLoadedSlices() to display the slices as soon as they arrive.
+    //## All progressive loading methods are thread-safe and do not call Modified().
+    void BeginProgressiveLoading();
+
+    //##Documentation
+    //## @brief Report that slice @a s at time @a t has been written completely.
+    //##
+    //## The cached statistics of the slice are invalidated.
+    void SetSliceLoaded(int s, int t = 0);
+
+    //##Documentation
+    //## @brief Report that no further slices will be written. Wakes up WaitForProgressiveLoading().
+    void EndProgressiveLoading();
+
+    //##Documentation
+    //## @brief True between BeginProgressiveLoading() and EndProgressiveLoading().
+    bool IsLoadingProgressively() const;
+
+    //##Documentation
+    //## @brief Check whether slice @a s at time @a t has been loaded.
+    //## Always true for images that are not loaded progressively.
+    bool IsSliceLoaded(int s, int t = 0) const;
+
+    //##Documentation
+    //## @brief Number of slices (of all time steps) reported via SetSliceLoaded() since the last
+    //## BeginProgressiveLoading(). Zero if the image has never been loaded progressively.
+    unsigned int GetNumberOfLoadedSlices() const;
+
+    //##Documentation
+    //## @brief Block until the progressive loading of the image has ended.
+    void WaitForProgressiveLoading() const;
+
     //##Documentation
     //## @brief Set @a data as slice @a s at time @a t in channel @a n. It is in
     //## the responsibility of the caller to ensure that the data vector @a data
@@ -259,6 +307,49 @@ namespace mitk
                                   int n = 0,
                                   ImportMemoryManagementType importMemoryManagement = CopyMemory);
 
+    //##Documentation
+    //## @brief Reference the mapped @a file as channel @a n.
+    //##
+    //## Pixel data is read from the file when it is accessed for the first time. Writing (e.g.
+    //## via ImageWriteAccessor) modifies private copies of the touched pages, never the file.
+    //## The mapping is kept alive as long as the channel or any of its slices or volumes is used.
+    //## Returns false if the mapped region is smaller than a channel.
+    //## @sa MemoryMappedFile
+    virtual bool SetMappedChannel(MemoryMappedFile *file, int n = 0);
+
+    //##Documentation
+    //## @brief Back the (single) channel of the image by the bricks of @a storage.
+    //##
+    //## The image must be initialized with the pixel type and dimensions of the storage. Slices,
+    //## volumes and regions (see GetRegionData()) are read from the bricks they intersect each time
+    //## they are requested and are not kept by the image. The whole channel is kept until the bricks
+    //## are written otherwise or, while it is not used, slices or volumes are read. All of them are
+    //## copies: changes reach the bricks only if they are made via ImageWriteAccessor or SetImportSlice() etc.
+    //## Data that has been set before is discarded. Returns false if the storage does not match the image.
+    //## @sa BrickedImageStorage
+    virtual bool SetBrickedStorage(BrickedImageStorage *storage);
+
+    //##Documentation
+    //## @brief The storage set by SetBrickedStorage(), or nullptr.
+    BrickedImageStorage *GetBrickedStorage() const;
+
+    //##Documentation
+    //## @brief Reference volume @a sourceT of channel @a sourceN of @a source as volume @a t of
+    //## channel @a n without copying it.
+    //##
+    //## Both images share the memory of the volume (copy-on-write) until one of them requests
+    //## write access to it (ImageWriteAccessor or SetImportVolume() etc.). Only then the writing
+    //## image copies the volume (or the channel, if the whole channel is written). Volumes whose
+    //## memory is not owned by the source (see ImportMemoryManagementType) are copied right away.
+    //## Returns false if the volumes differ in pixel type or dimensions.
+    //## @sa IsVolumeShared
+    virtual bool SetSharedVolume(const Image *source, int sourceT = 0, int sourceN = 0, int t = 0, int n = 0);
+
+    //##Documentation
+    //## @brief True if volume @a t of channel @a n shares its memory with other images
+    //## (see SetSharedVolume()).
+    bool IsVolumeShared(int t = 0, int n = 0) const;
+
     //##Documentation
     //## initialize new (or re-initialize) image information
     //## @warning Initialize() by pic assumes a plane, evenly spaced geometry starting at (0,0,0).
@@ -555,6 +646,18 @@ namespace mitk
                                                 void *data = nullptr,
                                                 ImportMemoryManagementType importMemoryManagement = CopyMemory) const;
 
+    /**
+    * \brief Get a copy of the pixels of @a region of volume @a t in channel @a n.
+    *
+    * Bricked images (see SetBrickedStorage()) read only the bricks that intersect the region
+    * unless the volume is in memory anyway. If @a data is passed, the pixels are copied into it
+    * and the returned item references it. Returns nullptr if the region is not inside the image.
+    */
+    virtual ImageDataItemPointer GetRegionData(const itk::ImageRegion<3> &region,
+                                               int t = 0,
+                                               int n = 0,
+                                               void *data = nullptr) const;
+
     /**
     \brief (DEPRECATED) Get the minimum for scalar images
     */
@@ -728,6 +831,84 @@ namespace mitk
     bool IsVolumeSet_unlocked(int t, int n) const;
     bool IsChannelSet_unlocked(int n) const;
 
+    /** Reads slice, volume or region of volume @a t from the bricked storage into a new data item.*/
+    ImageDataItemPointer ReadBrickedData(const itk::ImageRegion<3> &region,
+                                         int t,
+                                         unsigned int dimension,
+                                         void *data = nullptr) const;
+
+    /** Writes @a data to @a region of time step @a t (all time steps if negative) of the bricked storage
+     * and takes care of the data according to @a importMemoryManagement (see SetImportSlice() etc.).*/
+    bool SetBrickedData(void *data,
+                        const itk::ImageRegion<3> &region,
+                        int t,
+                        ImportMemoryManagementType importMemoryManagement);
+
+    /** Writes the pixels of @a item to the bricked storage, if it has been read from it (see ReadBrickedData()).*/
+    void WriteBrickedData(const ImageDataItem *item);
+
+    /** Writes @a data to @a region of time step @a t of the bricked storage, or of all time steps if @a t is negative.*/
+    void WriteBrickedData(const itk::ImageRegion<3> &region, int t, const void *data);
+
+    /** Drops m_BrickedChannel, unless it is used elsewhere.*/
+    void ReleaseBrickedChannel_unlocked() const;
+
+    BrickedImageStorage::Pointer m_BrickedStorage;
+    /** The channel read from the bricked storage (see GetChannelData()).*/
+    mutable ImageDataItemPointer m_BrickedChannel;
+
+    /** Returns the item to write to for the write access to @a item (nullptr means the first
+     * channel): if the memory of the item is shared with other images, the volume or channel
+     * that contains it is copied first (see SetSharedVolume()).*/
+    const ImageDataItem *PrepareWriteAccess(const ImageDataItem *item);
+
+    /** True while the pixels may be written without passing PrepareWriteAccess(), i.e. while write
+     * accessors (also those of itk images imported from the image) or writable vtkImageData of its items exist.*/
+    bool IsBeingWritten() const;
+
+    /** Lets the sources of the referenced volumes (see m_ReferencedVolumes) copy them, if their memory is
+     * shared with other images, and references the copies instead.*/
+    void DetachReferencedVolumes();
+
+    /** Returns @a item after making the image its owner, so that writes through the deprecated
+     * ImageDataItem::GetData() pass PrepareWriteAccess().*/
+    ImageDataItemPointer SetItemOwner(const ImageDataItemPointer &item) const;
+
+    /** Copy volume @a t or channel @a n, if its memory is shared with other images.*/
+    void DetachVolume_unlocked(int t, int n);
+    void DetachChannel_unlocked(int n);
+
+    void AddSharedRoot_unlocked(const ImageDataItem *root, const std::shared_ptr<void> &token) const;
+    bool IsSharedRoot_unlocked(const ImageDataItem *root) const;
+    void AddDetachedRoot_unlocked(const ImageDataItem *root) const;
+    /** Also forgets detached roots that have been deleted in the meantime.*/
+    bool IsDetachedRoot_unlocked(const ImageDataItem *root) const;
+    /** Drops the copy-on-write tokens of roots that are no longer referenced by any data item of the image.*/
+    void ReleaseUnusedSharedRoots_unlocked() const;
+
+    /** Root items of the data shared with other images and their copy-on-write tokens. The memory of a
+     * root is shared as long as more than one image holds its token.*/
+    mutable std::vector<std::pair<ImageDataItem::ConstPointer, std::shared_ptr<void>>> m_SharedRoots;
+    /** Roots the image stopped sharing, to recognize outdated items of them on write access. A root is
+     * forgotten as soon as it is deleted, i.e. neither other images nor outdated items use it anymore.*/
+    mutable std::vector<std::pair<const ImageDataItem *, std::weak_ptr<void>>> m_DetachedRoots;
+
+    /** Identifies the image towards its data items and other images without keeping it alive.*/
+    std::shared_ptr<Image *> m_CopyOnWriteOwner;
+
+    /** Volume @a T of channel @a N that references the memory of volume @a SourceT of channel
+     * @a SourceN of another image, so that writing to it writes to the source (see
+     * SubImageSelector::SetReferencedVolumeItem()).*/
+    struct ReferencedVolume
+    {
+      int T;
+      int N;
+      std::weak_ptr<Image *> Source;
+      int SourceT;
+      int SourceN;
+    };
+    std::vector<ReferencedVolume> m_ReferencedVolumes;
+
     /** Stores all existing ImageReadAccessors */
     mutable std::vector<ImageAccessorBase *> m_Readers;
     /** Stores all existing ImageWriteAccessors */
@@ -739,6 +920,14 @@ namespace mitk
     itk::SimpleFastMutexLock m_ReadWriteLock;
     /** A mutex, which needs to be locked to manage m_VtkReaders */
     itk::SimpleFastMutexLock m_VtkReadersLock;
+
+    /** Slice completion flags (one per slice and time step) of a progressive load */
+    std::vector<bool> m_LoadedSlices;
+    unsigned int m_NumberOfLoadedSlices;
+    bool m_LoadingProgressively;
+    /** A mutex, which needs to be locked to manage the progressive loading state */
+    mutable std::mutex m_ProgressiveLoadingMutex;
+    mutable std::condition_variable m_ProgressiveLoadingFinished;
   };
 
   /**
@@ -121,6 +121,10 @@ namespace mitk
     /** Defines if the accessed image part lies coherently in memory */
     bool m_CoherentMemory;
 
+    /** Keeps the accessed image part alive, which the image does not keep for bricked images
+     * (see Image::SetBrickedStorage()) */
+    ImageDataItem::ConstPointer m_DataItem;
+
     /** \brief Pointer to a WaitLock struct, that allows other ImageAccessors to wait for this ImageAccessor */
     ImageAccessorWaitLock *m_WaitLock;
 
@@ -18,8 +18,11 @@ found in the LICENSE file.
 //#include <mitkIpPic.h>
 //#include "mitkPixelType.h"
 #include "mitkImageDescriptor.h"
+#include "mitkMemoryMappedFile.h"
 //#include "mitkImageVtkAccessor.h"
 
+#include <memory>
+
 class vtkImageData;
 
 namespace mitk
@@ -90,8 +93,12 @@ namespace mitk
 
     /**
     \deprecatedSince{2012_09} Please use image accessors instead: See Doxygen/Related-Pages/Concepts/Image. This method
-    can be replaced by ImageWriteAccessor::GetData() or ImageReadAccessor::GetData() */
-    DEPRECATED(void *GetData() const) { return m_Data; }
+    can be replaced by ImageWriteAccessor::GetData() or ImageReadAccessor::GetData()
+
+    The caller may write to the returned memory, so the image the item belongs to copies the memory
+    first, if it is shared with other images (see Image::SetSharedVolume()). Items of bricked images
+    (see Image::SetBrickedStorage()) are copies of the bricks, writing to them does not change the image. */
+    DEPRECATED(void *GetData() const);
     bool IsComplete() const { return m_IsComplete; }
     void SetComplete(bool complete) { m_IsComplete = complete; }
     int GetOffset() const { return m_Offset; }
@@ -130,6 +137,12 @@ namespace mitk
     size_t GetSize() const { return m_Size; }
     virtual void Modified() const;
 
+    /** True if the data references a mapped file (see Image::SetImportChannel(MemoryMappedFile*, int)).*/
+    bool IsMemoryMapped() const { return m_MemoryMappedFile.IsNotNull(); }
+
+    /** True if the data was allocated from the image memory pool (see ImageMemoryPool).*/
+    bool IsPooled() const { return m_Pooled; }
+
   protected:
     unsigned char *m_Data;
 
@@ -149,8 +162,30 @@ namespace mitk
   private:
     void ComputeItemSize(const unsigned int *dimensions, unsigned int dimension);
 
+    /** Allocates the data of the item, from the image memory pool if its size is pooled.*/
+    void AllocateData();
+
     ImageDataItem::ConstPointer m_Parent;
 
+    /** Keeps the mapping of the referenced data alive.*/
+    MemoryMappedFile::Pointer m_MemoryMappedFile;
+
+    bool m_Pooled;
+
+    /** Token of the images that share the data of this (root) item (see Image::SetSharedVolume()).*/
+    mutable std::weak_ptr<void> m_CopyOnWriteToken;
+
+    /** Expires with this (root) item, so that images that stopped sharing it forget about it.*/
+    mutable std::shared_ptr<void> m_LifetimeToken;
+
+    /** Image that handed out the item (see GetData()).*/
+    mutable std::weak_ptr<Image *> m_Owner;
+
+    /** True if the item is a copy of pixels of a bricked image (see Image::SetBrickedStorage()),
+     * which starts at m_BrickedIndex of time step m_Timestep (all time steps if negative).*/
+    bool m_IsBrickedCopy = false;
+    long m_BrickedIndex[3] = {0, 0, 0};
+
     unsigned int m_Dimension;
 
     unsigned int m_Dimensions[MAX_IMAGE_DIMENSIONS];
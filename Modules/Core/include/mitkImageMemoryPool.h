@@ -0,0 +1,116 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkImageMemoryPool_h
+#define mitkImageMemoryPool_h
+
+#include <MitkCoreExports.h>
+
+#include <cstddef>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace mitk
+{
+  /** \brief Size class pool for the pixel memory of image data items.
+   *
+   * Per-slice pipelines (e.g. ImageTimeSelector, ImageSliceSelector, ExtractSliceFilter2 and the
+   * slices of segmentation tools) allocate and release buffers of the same few sizes on every
+   * interaction. ImageDataItem therefore allocates blocks up to GetMaximumBlockSize() from the pool
+   * of GetInstance(). Released blocks are kept in a free list per size class and are handed out
+   * again instead of being returned to the system, as long as the cached blocks do not exceed
+   * GetCapacity(). Larger (usually long-living) volumes are allocated as before.
+   *
+   * Sizes are rounded up to size classes of four steps per power of two (at least one page), so at
+   * most a quarter of a block is wasted. On Linux, blocks of at least two MiB are mapped directly and
+   * may be backed by transparent huge pages (see SetUseHugePages()), which saves page faults and TLB
+   * misses for large slices. Huge pages are ignored on other platforms.
+   *
+   * All methods are thread-safe.
+   */
+  class MITKCORE_EXPORT ImageMemoryPool
+  {
+  public:
+    struct Statistics
+    {
+      /** Number of calls of Allocate() and the number of those served by the free lists.*/
+      unsigned long NumberOfAllocations;
+      unsigned long NumberOfReuses;
+      unsigned long NumberOfReleases;
+      /** Size of all blocks that are allocated and not released yet, and its maximum so far.*/
+      std::size_t BytesInUse;
+      std::size_t PeakBytesInUse;
+      /** Size of all released blocks that are kept for reuse.*/
+      std::size_t BytesCached;
+    };
+
+    /** The pool used by ImageDataItem.*/
+    static ImageMemoryPool &GetInstance();
+
+    /** Size of the size class of the passed size, i.e. the size of the block that is actually allocated.*/
+    static std::size_t GetSizeClass(std::size_t size);
+
+    ImageMemoryPool();
+    /** Frees the cached blocks. Blocks that are still in use are not freed.*/
+    ~ImageMemoryPool();
+
+    /** Allocates a block of at least the passed size. Throws an itk::MemoryAllocationError on failure.*/
+    void *Allocate(std::size_t size);
+
+    /** Releases a block of Allocate(). The size must be the one the block was allocated with.*/
+    void Release(void *data, std::size_t size);
+
+    /** True if the pool is enabled and blocks of the passed size are pooled.*/
+    bool IsPooled(std::size_t size) const;
+
+    /** Disabling the pool frees the cached blocks. Blocks in use are still released to the pool.*/
+    void SetEnabled(bool enabled);
+    bool GetEnabled() const;
+
+    /** Blocks larger than the maximum block size (64 MiB by default) are not pooled.*/
+    void SetMaximumBlockSize(std::size_t bytes);
+    std::size_t GetMaximumBlockSize() const;
+
+    /** Maximum size of the cached blocks (256 MiB by default). Blocks that are released while the
+     * cache is full are freed.*/
+    void SetCapacity(std::size_t bytes);
+    std::size_t GetCapacity() const;
+
+    /** Advise the system to back blocks of at least two MiB by huge pages (off by default).*/
+    void SetUseHugePages(bool useHugePages);
+    bool GetUseHugePages() const;
+
+    Statistics GetStatistics() const;
+
+    /** Frees all cached blocks.*/
+    void Trim();
+
+  private:
+    ImageMemoryPool(const ImageMemoryPool &) = delete;
+    ImageMemoryPool &operator=(const ImageMemoryPool &) = delete;
+
+    void *AllocateBlock(std::size_t sizeClass) const;
+    static void FreeBlock(void *data, std::size_t sizeClass);
+    void TrimUnlocked(std::size_t capacity);
+
+    mutable std::mutex m_Mutex;
+    std::unordered_map<std::size_t, std::vector<void *>> m_FreeBlocks;
+    bool m_Enabled;
+    std::size_t m_MaximumBlockSize;
+    std::size_t m_Capacity;
+    bool m_UseHugePages;
+    Statistics m_Statistics;
+  };
+}
+
+#endif
@@ -53,6 +53,19 @@ namespace mitk
 
     ImageReadAccessor(const Image *image, const ImageDataItem *iDI = nullptr);
 
+    /** \brief Orders read access for a copy of a region of volume @a t
+     *
+     * For bricked images (see Image::SetBrickedStorage()) only the bricks that intersect the region
+     * are read. Other images are locked while the region is copied.
+     *  \throws mitk::Exception if the region is not inside the image
+     *  \throws mitk::MemoryIsLockedException if the volume is exclusively locked and
+     * mitk::ImageAccessorBase::ExceptionIfLocked is set in OptionFlags
+     */
+    ImageReadAccessor(const Image *image,
+                      const itk::ImageRegion<3> &region,
+                      int t = 0,
+                      int OptionFlags = ImageAccessorBase::DefaultBehavior);
+
     /** Destructor informs Image to unlock memory. */
     ~ImageReadAccessor() override;
 
@@ -60,6 +73,14 @@ namespace mitk
     const Image *GetImage() const override;
 
   private:
+    ImageReadAccessor(ImageDataItem::Pointer regionData, const Image *image, int OptionFlags);
+
+    /** \brief copies the region of volume @a t, honoring the locks of the volume */
+    static ImageDataItem::Pointer CopyRegion(const Image *image,
+                                             const itk::ImageRegion<3> &region,
+                                             int t,
+                                             int OptionFlags);
+
     /** \brief manages a consistent read access and locks the ordered image part */
     void OrganizeReadAccess();
 
@@ -67,6 +88,9 @@ namespace mitk
     ImageReadAccessor(const ImageReadAccessor &);
 
     ImageConstPointer m_Image;
+
+    /** Copy of the region, if a region was ordered.*/
+    ImageDataItem::Pointer m_RegionData;
   };
 }
 
@@ -20,6 +20,10 @@ found in the LICENSE file.
 #include <itkHistogram.h>
 #endif
 
+#include <itkSimpleFastMutexLock.h>
+
+#include <vector>
+
 namespace mitk
 {
   /**
@@ -32,6 +36,13 @@ namespace mitk
     GetStatistics() method in mitk::Image class.
 
     Minimum or maximum might by infinite values. 2nd minimum and maximum are guaranteed to be finite values.
+
+    The extrema are computed lazily, in parallel and cached per time step in blocks of whole slices. The scalar
+    histogram reuses the cached extrema as its bounds. When the image is modified, only the blocks whose memory has
+    been reported through InvalidateMemoryRange() are recomputed (ImageWriteAccessor does this when it is released).
+    Only the first Modified() of the image after a report is attributed to the reported ranges. Any other
+    modification, e.g. after writes that bypass the image accessors, causes all blocks to be recomputed. Bricked
+    images (see Image::SetBrickedStorage()) are read slab by slab and only their histogram is cached.
     */
   class MITKCORE_EXPORT ImageStatisticsHolder
   {
@@ -137,22 +148,65 @@ namespace mitk
 
     bool IsValidTimeStep(int t) const;
 
-    template <typename ItkImageType>
-    friend void _ComputeExtremaInItkImage(const ItkImageType *itkImage,
-                                          mitk::ImageStatisticsHolder *statisticsHolder,
-                                          int t);
+    //##Documentation
+    //## \brief Marks the cached extrema of all blocks overlapping the memory range [begin, end) as outdated.
+    //## Only these blocks are recomputed after the next modification of the image. Thread-safe.
+    void InvalidateMemoryRange(const void *begin, const void *end);
 
-    template <typename ItkImageType>
-    friend void _ComputeExtremaInItkVectorImage(const ItkImageType *itkImage,
-                                                mitk::ImageStatisticsHolder *statisticsHolder,
-                                                int t,
-                                                unsigned int component);
+    //##Documentation
+    //## \brief Called on every modification of the image, see InvalidateMemoryRange().
+    void OnImageModified();
 
   protected:
+    //##Documentation
+    //## \brief Extrema of one block (a number of whole slices) of a time step.
+    struct BlockExtrema
+    {
+      BlockExtrema();
+
+      ScalarType Min;
+      ScalarType Max;
+      ScalarType SecondMin;
+      ScalarType SecondMax;
+      unsigned int CountOfMin;
+      unsigned int CountOfMax;
+    };
+
+    //##Documentation
+    //## \brief Cached blocks and histogram of one time step, valid for the buffer they were computed from.
+    struct TimeStepCache
+    {
+      TimeStepCache();
+
+      const void *Buffer;
+      std::size_t NumberOfBytes;
+      unsigned int Component;
+      std::size_t VoxelsPerBlock;
+      std::size_t BytesPerBlock;
+      std::vector<BlockExtrema> Blocks;
+      std::vector<bool> BlockValid;
+      std::vector<unsigned long> BlockEpoch;
+      HistogramType::Pointer Histogram;
+    };
+
     virtual void ResetImageStatistics();
 
     virtual void ComputeImageStatistics(int t = 0, unsigned int component = 0);
 
+    //##Documentation
+    //## \brief Recomputes the outdated blocks of time step \a t in parallel and merges all blocks into the extrema of \a t.
+    void ComputeExtremaFromBlocks(int t, unsigned int component);
+
+    //##Documentation
+    //## \brief Computes the extrema of time step \a t of a bricked image slab by slab, without reading the whole volume.
+    void ComputeExtremaFromBrickedSlabs(int t, unsigned int component);
+
+    void SetExtrema(int t, const BlockExtrema &extrema);
+
+    //##Documentation
+    //## \brief True, if extrema and histogram can be computed directly from the pixel buffer of the image.
+    bool IsBlockwiseComputationSupported() const;
+
     virtual void Expand(unsigned int timeSteps);
 
     ImageTimeSelector::Pointer GetTimeSelector();
@@ -170,6 +224,15 @@ namespace mitk
     mutable std::vector<ScalarType> m_Scalar2ndMax;
 
     itk::TimeStamp m_LastRecomputeTimeStamp;
+
+    std::vector<TimeStepCache> m_TimeStepCaches;
+    bool m_InvalidatedSinceRecompute;
+    /** True if memory ranges have been reported, but the image has not been modified since.*/
+    bool m_ReportPending;
+    /** Modification time of the image up to which all modifications have been reported.*/
+    itk::ModifiedTimeType m_ReportedMTime;
+    unsigned long m_ImageModifiedObserverTag;
+    itk::SimpleFastMutexLock m_CacheMutex;
   };
 
 } // end namespace
@@ -23,6 +23,11 @@ namespace mitk
   //##
   //## If the input is generated by a ProcessObject, only the required data is
   //## requested.
+  //## The output references the memory of the input volume, so writing to the
+  //## output writes to the input. If the input volume is shared with other images,
+  //## it is copied not before the output is written (see ImageWriteAccessor).
+  //## Use Image::Clone() or Image::SetSharedVolume() for an independent,
+  //## copy-on-write volume.
   //## @ingroup Process
   class MITKCORE_EXPORT ImageTimeSelector : public SubImageSelector
   {
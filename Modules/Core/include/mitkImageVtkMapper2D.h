@@ -19,6 +19,7 @@ found in the LICENSE file.
 // MITK Rendering
 #include "mitkBaseRenderer.h"
 #include "mitkExtractSliceFilter.h"
+#include "mitkResliceCache.h"
 #include "mitkVtkMapper.h"
 
 // VTK
@@ -38,6 +39,7 @@ class vtkMitkThickSlicesFilter;
 class vtkPolyData;
 class vtkMitkApplyLevelWindowToRGBFilter;
 class vtkMitkLevelWindowFilter;
+class vtkMatrix4x4;
 
 namespace mitk
 {
@@ -50,7 +52,10 @@ namespace mitk
    * First, the image is resliced by means of vtkImageReslice. The volume image
    * serves as input to the mapper in addition to spatial placement of the slice and a few other
    * properties such as thick slices. This code was already present in the old version
-   * (mitkImageMapperGL2D).
+   * (mitkImageMapperGL2D). Thick slices are configured by the properties "reslice.thickslices"
+   * (ResliceMethodProperty), "reslice.thickslices.num" and "reslice.thickslices.percentile" (FloatProperty,
+   * default 90) of the plane node. The mip, minip and sum modes are projected by the reslicer itself,
+   * the other modes by vtkMitkThickSlicesFilter.
    *
    * Next, the obtained slice (m_ReslicedImage) is put into a vtkMitkLevelWindowFilter
    * and the scalar levelwindow, opacity levelwindow and optional clipping to
@@ -88,6 +93,9 @@ namespace mitk
    *   - \b "texture interpolation": (BoolProperty) texture interpolation of the image
    *   - \b "reslice interpolation": (VtkResliceInterpolationProperty) reslice interpolation of the image
    *   - \b "in plane resample extent by geometry": (BoolProperty) Do it or not
+   *   - \b "reslice cache size": (IntProperty) Number of resliced slices that are kept per render window,
+   *          so that scrolling back to them does not reslice the image again. The neighbouring slices of the
+   *          current one are resliced in the background. 0 disables the cache (see mitk::ResliceCache).
    *   - \b "bounding box": (BoolProperty) Is the Bounding Box of the image shown or not
    *   - \b "layer": (IntProperty) Layer of the image
    *   - \b "volume annotation color": (ColorProperty) color of the volume annotation, TODO has to be reimplemented
@@ -181,9 +189,19 @@ namespace mitk
       /** \brief Timestamp of last update of stored data. */
       itk::TimeStamp m_LastUpdateTime;
 
+      /** \brief Number of loaded slices of a progressively loaded image at the last update. */
+      unsigned int m_NumberOfLoadedSlices;
+
       /** \brief mmPerPixel relation between pixel and mm. (World spacing).*/
       mitk::ScalarType *m_mmPerPixel;
 
+      /** \brief Recently resliced slices and prefetched neighbours of the current slice. */
+      mitk::ResliceCache m_ResliceCache;
+      /** \brief Reslice axes of the current slice (either copied from m_Reslicer or from the cache). */
+      vtkSmartPointer<vtkMatrix4x4> m_ResliceAxes;
+      /** \brief Spacing of the current slice (either copied from m_Reslicer or from the cache). m_mmPerPixel points to it. */
+      mitk::ScalarType m_CachedSpacing[2];
+
       /** \brief This filter is used to apply the level window to Grayvalue and RBG(A) images. */
       vtkSmartPointer<vtkMitkLevelWindowFilter> m_LevelWindowFilter;
 
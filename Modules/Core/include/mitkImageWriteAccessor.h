@@ -55,6 +55,9 @@ namespace mitk
     /** \brief manages a consistent write access and locks the ordered image part */
     void OrganizeWriteAccess();
 
+    /** \brief copies the ordered image part first, if its memory is shared with other images */
+    static const ImageDataItem *PrepareWriteAccess(Image *image, const ImageDataItem *iDI);
+
     ImageWriteAccessor &operator=(const ImageWriteAccessor &); // Not implemented on purpose.
     ImageWriteAccessor(const ImageWriteAccessor &);
 
@@ -100,6 +100,25 @@ namespace mitk
     //## @param limit the maximum number of items on the stack
     void SetUndoLimit(std::size_t limit) override;
 
+    //##Documentation
+    //## @brief Gets the limit on the memory of the undo history in bytes.
+    //## The 0 value means that there is no limit, which is the default.
+    std::size_t GetMemoryLimit() const;
+
+    //##Documentation
+    //## @brief Sets a limit on the memory of the undo history.
+    //## If the items on the undo stack occupy more than the given number
+    //## of bytes (see UndoStackItem::GetMemorySize()), the oldest items
+    //## will be dropped from the bottom of the undo stack. Items are dropped
+    //## by whole groups (see UndoStackItem::GetGroupEventId()) and the most
+    //## recent group is always kept. The 0 value means that there is no limit.
+    //## @param bytes the maximum memory of the items on the stack
+    void SetMemoryLimit(std::size_t bytes);
+
+    //##Documentation
+    //## @brief Returns the memory occupied by the items on the undo stack in bytes
+    std::size_t GetUndoListMemorySize() const;
+
     //##Documentation
     //## @brief Returns the ObjectEventId of the
     //## top element in the OperationHistory
@@ -128,6 +147,10 @@ namespace mitk
     //## elements in the list and to clear the list
     void ClearList(UndoContainer *list);
 
+    //## @brief Pushes the item to the undo stack and drops the oldest
+    //## items until the stack satisfies both the undo limit and the memory limit
+    void PushToUndoList(UndoStackItem *item);
+
     UndoContainer m_UndoList;
 
     UndoContainer m_RedoList;
@@ -135,8 +158,15 @@ namespace mitk
   private:
     int FirstObjectEventIdOfCurrentGroup(UndoContainer &stack);
 
+    void ApplyUndoLimits();
+    void DropOldestUndoItem();
+
     std::size_t m_UndoLimit;
 
+    std::size_t m_MemoryLimit;
+
+    std::size_t m_UndoListMemorySize;
+
   };
 
 #pragma GCC visibility push(default)
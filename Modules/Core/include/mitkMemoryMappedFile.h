@@ -0,0 +1,79 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkMemoryMappedFile_h
+#define mitkMemoryMappedFile_h
+
+#include <MitkCoreExports.h>
+#include <mitkCommon.h>
+
+#include <itkLightObject.h>
+
+#include <string>
+
+namespace mitk
+{
+  /** \brief Private mapping of a region of a file into memory.
+   *
+   * The pages of the region are read from the file when they are accessed for the first
+   * time, so mapping a huge file is (nearly) free. The mapping is copy-on-write: writing to
+   * the memory creates private copies of the touched pages, the file itself is never changed.
+   * The file must not be truncated by others while it is mapped.
+   *
+   * Used by mitk::Image::SetImportChannel(MemoryMappedFile*, int) to reference the pixel data
+   * of uncompressed image files instead of reading them into memory.
+   */
+  class MITKCORE_EXPORT MemoryMappedFile : public itk::LightObject
+  {
+  public:
+    mitkClassMacroItkParent(MemoryMappedFile, itk::LightObject);
+
+    /** Maps size bytes of the file, beginning at the passed offset. Throws an mitk::Exception
+     * if the file cannot be mapped or is too small.*/
+    mitkNewMacro3Param(Self, const std::string &, std::size_t, std::size_t);
+
+    void *GetData() const { return m_Data; }
+    std::size_t GetSize() const { return m_Size; }
+    const std::string &GetFileName() const { return m_FileName; }
+
+    /** Copies all pages that are still backed by the file into private memory, so the file may be
+     * overwritten afterwards. Pointers to the data stay valid. Not supported on Windows, where mapped
+     * files cannot be overwritten at all.*/
+    void Detach();
+
+    /** Detaches all existing mappings of the passed file. Paths are compared after resolving relative
+     * paths and symbolic links. mitk::AbstractFileWriter calls this for the output location, writers
+     * that write additional files (e.g. the data file of a MetaImage header) have to call it for them.*/
+    static void DetachMappings(const std::string &fileName);
+
+    /** Size of a file in bytes, or -1 if it does not exist.*/
+    static long long GetFileSize(const std::string &fileName);
+
+  protected:
+    MemoryMappedFile(const std::string &fileName, std::size_t offset, std::size_t size);
+    ~MemoryMappedFile() override;
+
+  private:
+    MemoryMappedFile(const MemoryMappedFile &) = delete;
+    MemoryMappedFile &operator=(const MemoryMappedFile &) = delete;
+
+    std::string m_FileName;
+    std::string m_CanonicalFileName;
+    /** Begin of the mapping, which starts at an offset that is a multiple of the allocation granularity.*/
+    void *m_Mapping;
+    std::size_t m_MappingSize;
+    void *m_Data;
+    std::size_t m_Size;
+  };
+}
+
+#endif
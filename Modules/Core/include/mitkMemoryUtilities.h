@@ -35,6 +35,18 @@ namespace mitk
      */
     static size_t GetTotalSizeOfPhysicalRam();
 
+    /**
+     * Returns the size in bytes of the image memory that is currently
+     * allocated from the pool of image data items (see ImageMemoryPool).
+     */
+    static size_t GetImageMemoryPoolUsage();
+
+    /**
+     * Returns the size in bytes of the released image memory that the pool
+     * of image data items keeps for reuse.
+     */
+    static size_t GetImageMemoryPoolCachedSize();
+
     /**
      * Allocates an array of a given number of elements. Each element
      * has a size of sizeof(ElementType). The function returns nullptr, if the array
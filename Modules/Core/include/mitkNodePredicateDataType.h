@@ -40,6 +40,10 @@ namespace mitk
     //## @brief Checks, if the nodes data object is of a specific data type
     bool CheckNode(const mitk::DataNode *node) const override;
 
+    //##Documentation
+    //## @brief Name of the data type (as returned by GetNameOfClass()) that is checked
+    const std::string &GetValidDataType() const { return m_ValidDataType; }
+
   protected:
     //##Documentation
     //## @brief Protected constructor, use static instantiation functions instead
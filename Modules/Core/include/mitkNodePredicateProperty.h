@@ -44,6 +44,16 @@ namespace mitk
     //## @brief Checks, if the nodes contains a property that is equal to m_ValidProperty
     bool CheckNode(const mitk::DataNode *node) const override;
 
+    //##Documentation
+    //## @brief Name of the property that is checked
+    const std::string &GetValidPropertyName() const { return m_ValidPropertyName; }
+    //##Documentation
+    //## @brief Property value the node property is compared to (nullptr if only the existence is checked)
+    const mitk::BaseProperty *GetValidProperty() const { return m_ValidProperty; }
+    //##Documentation
+    //## @brief Renderer whose specific property is checked (nullptr for the non-renderer-specific property)
+    const mitk::BaseRenderer *GetRenderer() const { return m_Renderer; }
+
   protected:
     //##Documentation
     //## @brief Constructor to check for a named property
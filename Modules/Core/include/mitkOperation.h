@@ -16,6 +16,8 @@ found in the LICENSE file.
 #include <MitkCoreExports.h>
 #include <itkEventObject.h>
 
+#include <cstddef>
+
 #include <mitkCommon.h>
 
 namespace mitk
@@ -39,6 +41,13 @@ namespace mitk
 
     OperationType GetOperationType();
 
+    //##Documentation
+    //## @brief Approximate number of bytes occupied by the operation.
+    //##
+    //## Used by LimitedLinearUndo to limit the undo history by memory. Operations
+    //## that hold large data (e.g. image slices) add the size of this data.
+    virtual std::size_t GetMemorySize() const;
+
   protected:
     OperationType m_OperationType;
   };
@@ -74,6 +74,11 @@ namespace mitk
     virtual void ReverseOperations();
     virtual void ReverseAndExecute();
 
+    //##Documentation
+    //## @brief Returns the approximate number of bytes occupied by this item
+    //## (see Operation::GetMemorySize())
+    virtual std::size_t GetMemorySize() const;
+
     //##Documentation
     //## @brief Increases the current ObjectEventId
     //## For example if a button click generates operations the ObjectEventId has to be incremented to be able to undo
@@ -170,6 +175,9 @@ namespace mitk
     //## and false if it already has been deleted
     virtual bool IsValid();
 
+    //## @brief Includes the memory of both operations
+    std::size_t GetMemorySize() const override;
+
   protected:
     void OnObjectDeleted();
 
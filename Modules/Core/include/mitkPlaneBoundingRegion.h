@@ -0,0 +1,47 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkPlaneBoundingRegion_h
+#define mitkPlaneBoundingRegion_h
+
+#include <MitkCoreExports.h>
+#include <mitkImage.h>
+#include <mitkPlaneGeometry.h>
+
+#include <itkImageRegion.h>
+
+namespace mitk
+{
+  /** \brief Helpers to sample planes of bricked images (see mitk::BrickedImageStorage) without
+   * reading their whole volume: the bounding region of the plane in index coordinates of the
+   * image is extracted into a small image with a correspondingly shifted geometry.
+   */
+  namespace PlaneBoundingRegion
+  {
+    /** \brief Bounding box of the plane (including its thickness) in index coordinates of the image
+     * geometry, enlarged by @a margin voxels (e.g. for interpolation kernels or thick slices) and
+     * clipped to the image. The region is never empty, even if the plane does not intersect the image.
+     */
+    MITKCORE_EXPORT itk::ImageRegion<3> Compute(const BaseGeometry *imageGeometry,
+                                                const PlaneGeometry *plane,
+                                                unsigned int margin);
+
+    /** \brief 3D image with the pixels of @a region of volume @a t of the image, positioned at the
+     * same world coordinates. Throws an mitk::Exception if the region is not inside the image.
+     */
+    MITKCORE_EXPORT Image::Pointer ExtractImage(const Image *image,
+                                                const itk::ImageRegion<3> &region,
+                                                TimeStepType t = 0);
+  }
+}
+
+#endif
@@ -0,0 +1,147 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkResliceCache_h
+#define mitkResliceCache_h
+
+#include <MitkCoreExports.h>
+
+#include <mitkExtractSliceFilter.h>
+#include <mitkImage.h>
+#include <mitkPlaneGeometry.h>
+
+#include <vtkImageData.h>
+#include <vtkMatrix4x4.h>
+#include <vtkSmartPointer.h>
+
+#include <condition_variable>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mitk
+{
+  /** \brief Least recently used cache of resliced slices with prefetching on a worker thread.
+   *
+   * ImageVtkMapper2D keeps one cache per renderer, so scrolling back to a slice that was shown
+   * recently does not reslice the image again. A slice is identified by a Key that consists of the
+   * image and its modification time, the plane geometry, the time step and the reslice parameters.
+   * Thus, modified images or changed properties simply never hit outdated slices.
+   *
+   * Prefetch() reslices the passed planes (e.g. the neighbours of the current slice) on a worker
+   * thread and adds them to the cache. The worker uses its own ExtractSliceFilter and its own image
+   * instance that references the memory of the volume, so the pipeline of the rendered image is never
+   * touched concurrently. The worker reslices under a read access of the rendered image and skips
+   * slices of volumes that are written meanwhile.
+   */
+  class MITKCORE_EXPORT ResliceCache
+  {
+  public:
+    struct Key
+    {
+      const Image *image;
+      /** Maximum of the modification times of the image and its geometry.*/
+      itk::ModifiedTimeType imageTime;
+      /** Matrix and offset of the index to world transform and bounds of the plane.*/
+      double plane[18];
+      TimeStepType timeStep;
+      int interpolationMode;
+      bool inPlaneResampleExtentByGeometry;
+      int thickSlicesMode;
+      int thickSlicesNum;
+      double thickSlicesPercentile;
+
+      bool operator==(const Key &other) const;
+    };
+
+    /** Everything ImageVtkMapper2D takes from an updated reslicer.*/
+    struct Slice
+    {
+      vtkSmartPointer<vtkImageData> image;
+      vtkSmartPointer<vtkMatrix4x4> resliceAxes;
+      ScalarType spacing[2];
+    };
+
+    static Key CreateKey(const Image *image,
+                         const PlaneGeometry *plane,
+                         TimeStepType timeStep,
+                         ExtractSliceFilter::ResliceInterpolation interpolationMode,
+                         bool inPlaneResampleExtentByGeometry,
+                         int thickSlicesMode = 0,
+                         int thickSlicesNum = 1,
+                         double thickSlicesPercentile = 0.0);
+
+    /** Deep copies the passed image and the reslice axes and spacing of the (updated) reslicer.*/
+    static Slice CreateSlice(vtkImageData *image, ExtractSliceFilter *reslicer);
+
+    ResliceCache();
+    /** Stops the worker thread. Pending prefetch requests are dropped.*/
+    ~ResliceCache();
+
+    /** Maximum number of slices in the cache. 0 disables the cache.*/
+    void SetCapacity(unsigned int capacity);
+    unsigned int GetCapacity() const;
+    unsigned int GetNumberOfSlices() const;
+
+    /** Returns true and the slice if the key is cached. The slice becomes the most recently used one.*/
+    bool Find(const Key &key, Slice &slice);
+    void Insert(const Key &key, const Slice &slice);
+    void Clear();
+
+    /** Reslices the thin (2D) slices of the passed planes on the worker thread and inserts them into the cache.
+     * Planes that are already cached are skipped. Requests of earlier calls that are not processed yet are
+     * dropped, as they most probably belong to slices the user already scrolled past.
+     * Must be called from the thread that owns the image (usually the rendering thread).*/
+    void Prefetch(const Image *image,
+                  const std::vector<PlaneGeometry::ConstPointer> &planes,
+                  TimeStepType timeStep,
+                  ExtractSliceFilter::ResliceInterpolation interpolationMode,
+                  bool inPlaneResampleExtentByGeometry);
+
+    /** Blocks until all pending prefetch requests are processed.*/
+    void WaitForPrefetch();
+
+  private:
+    ResliceCache(const ResliceCache &) = delete;
+    ResliceCache &operator=(const ResliceCache &) = delete;
+
+    void InsertUnlocked(const Key &key, const Slice &slice);
+    bool ContainsUnlocked(const Key &key) const;
+    void RunPrefetchThread();
+
+    typedef std::list<std::pair<Key, Slice>> EntryListType;
+
+    mutable std::mutex m_Mutex;
+    EntryListType m_Entries;
+    unsigned int m_Capacity;
+
+    /** Image instance that references the volume of the rendered image (see class description).*/
+    Image::Pointer m_PrefetchImage;
+    Image::ConstPointer m_PrefetchSourceImage;
+    /** Volume of the rendered image whose memory m_PrefetchImage references.*/
+    ImageDataItem::ConstPointer m_PrefetchVolume;
+    itk::ModifiedTimeType m_PrefetchImageTime;
+    TimeStepType m_PrefetchTimeStep;
+
+    std::vector<std::pair<Key, PlaneGeometry::ConstPointer>> m_PrefetchRequests;
+    ExtractSliceFilter::ResliceInterpolation m_PrefetchInterpolationMode;
+    bool m_PrefetchInPlaneResampleExtentByGeometry;
+    bool m_Prefetching;
+    bool m_StopPrefetchThread;
+    std::condition_variable m_PrefetchCondition;
+    std::condition_variable m_PrefetchFinished;
+    std::thread m_PrefetchThread;
+  };
+}
+
+#endif
@@ -17,6 +17,9 @@ found in the LICENSE file.
 #include "mitkDataStorage.h"
 #include "mitkMessage.h"
 #include <map>
+#include <set>
+#include <string>
+#include <vector>
 
 namespace mitk
 {
@@ -88,6 +91,26 @@ namespace mitk
     //##
     SetOfObjects::ConstPointer GetAll() const override;
 
+    //##Documentation
+    //## @brief returns a set of data objects that meet the given condition
+    //##
+    //## In contrast to DataStorage::GetSubset(), this method uses a secondary index of the stored nodes
+    //## (data type and the values of the indexed property keys) to determine a set of candidate nodes
+    //## for NodePredicateDataType, NodePredicateProperty and NodePredicateAnd/Or compositions thereof.
+    //## Only the candidates are checked against the condition. Conditions that cannot be answered
+    //## by the index fall back to a linear scan of all nodes. The result is identical in both cases.
+    SetOfObjects::ConstPointer GetSubset(const NodePredicateBase *condition) const override;
+
+    //##Documentation
+    //## @brief Adds a (non renderer specific) property key to the secondary index
+    //##
+    //## By default "name", "helper object" and "binary" are indexed.
+    void AddIndexedPropertyKey(const std::string &propertyKey);
+
+    //##Documentation
+    //## @brief returns the property keys that are covered by the secondary index
+    std::set<std::string> GetIndexedPropertyKeys() const;
+
     /*ITK Mutex */
     mutable itk::SimpleFastMutexLock m_Mutex;
 
@@ -96,6 +119,20 @@ namespace mitk
     //## @brief noncyclical directed graph data structure to store the nodes with their relation
     typedef std::map<mitk::DataNode::ConstPointer, SetOfObjects::ConstPointer> AdjacencyList;
 
+    //##Documentation
+    //## @brief set of nodes as used by the secondary index. Ordered by address like AdjacencyList.
+    typedef std::set<const mitk::DataNode *> IndexedNodeSet;
+
+    //##Documentation
+    //## @brief indexed values of a single node and the objects that are observed to keep them up to date
+    struct IndexEntry
+    {
+      unsigned long NodeObserverTag = 0;
+      std::string DataType;
+      std::map<std::string, std::string> PropertyValues;
+      std::vector<std::pair<itk::Object::Pointer, unsigned long>> Observations;
+    };
+
     //##Documentation
     //## @brief Standard Constructor for ::New() instantiation
     StandaloneDataStorage();
@@ -122,12 +159,56 @@ namespace mitk
     //## @brief Prints the contents of the StandaloneDataStorage to os. Do not call directly, call ->Print() instead
     void PrintSelf(std::ostream &os, itk::Indent indent) const override;
 
+    //##Documentation
+    //## @brief Adds a node to the secondary index and starts observing it. m_IndexMutex has to be locked.
+    void AddToIndex(const mitk::DataNode *node);
+
+    //##Documentation
+    //## @brief Removes a node from the secondary index and stops observing it. m_IndexMutex has to be locked.
+    void RemoveFromIndex(const mitk::DataNode *node);
+
+    //##Documentation
+    //## @brief (Re)computes the indexed values of a node. m_IndexMutex has to be locked.
+    void FillIndexEntry(const mitk::DataNode *node, IndexEntry &entry);
+
+    //##Documentation
+    //## @brief Removes the indexed values of a node and stops observing its properties. m_IndexMutex has to be locked.
+    void ClearIndexEntry(const mitk::DataNode *node, IndexEntry &entry);
+
+    //##Documentation
+    //## @brief Re-indexes all nodes that were modified since the last query. m_IndexMutex has to be locked.
+    void UpdateDirtyIndexEntries() const;
+
+    //##Documentation
+    //## @brief Determines a superset of the nodes that fulfill condition by means of the secondary index.
+    //##
+    //## Returns false, if the condition cannot be answered by the index. m_IndexMutex has to be locked.
+    bool LookUpIndexCandidates(const NodePredicateBase *condition, IndexedNodeSet &candidates) const;
+
+    //##Documentation
+    //## @brief Marks the node that is related to caller as dirty in the secondary index
+    void OnIndexedObjectModified(const itk::Object *caller, const itk::EventObject &event);
+
     //##Documentation
     //## @brief Nodes and their relation are stored in m_SourceNodes
     AdjacencyList m_SourceNodes;
     //##Documentation
     //## @brief Nodes are stored in reverse relation for easier traversal in the opposite direction of the relation
     AdjacencyList m_DerivedNodes;
+
+    //##Documentation
+    //## @brief Protects the secondary index. Always lock m_Mutex first, if both are needed.
+    mutable itk::SimpleFastMutexLock m_IndexMutex;
+    std::map<const mitk::DataNode *, IndexEntry> m_IndexEntries;
+    std::map<std::string, IndexedNodeSet> m_DataTypeIndex;
+    //##Documentation
+    //## @brief property key -> value (as string) -> nodes
+    std::map<std::string, std::map<std::string, IndexedNodeSet>> m_PropertyIndex;
+    std::set<std::string> m_IndexedPropertyKeys;
+    //##Documentation
+    //## @brief observed property (list) -> nodes that are affected by its modification
+    std::multimap<const itk::Object *, const mitk::DataNode *> m_IndexObservedObjects;
+    IndexedNodeSet m_DirtyIndexNodes;
   };
 } // namespace mitk
 #endif /* MITKSTANDALONEDATASTORAGE_H_HEADER_INCLUDED_ */
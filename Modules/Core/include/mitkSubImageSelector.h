@@ -52,6 +52,11 @@ namespace mitk
     void SetSliceItem(mitk::Image::ImageDataItemPointer dataItem, int s = 0, int t = 0, int n = 0);
     void SetVolumeItem(mitk::Image::ImageDataItemPointer dataItem, int t = 0, int n = 0);
     void SetChannelItem(mitk::Image::ImageDataItemPointer dataItem, int n = 0);
+    /** References volume @a t of channel @a n of the input as volume @a outputT of channel @a outputN of
+     * the output without copying it, so writing to the output writes to the input. If the input volume
+     * is shared with other images (see Image::SetSharedVolume()), the input copies it not before the
+     * output is written.*/
+    void SetReferencedVolumeItem(int t = 0, int n = 0, int outputT = 0, int outputN = 0);
   };
 
 } // namespace mitk
@@ -46,13 +46,22 @@ public:
   vtkGetMacro(HandleBoundaries, int);
   vtkBooleanMacro(HandleBoundaries, int);
 
+  // Description:
+  // Get/Set the percentile (0-100) that is projected in PERCENTILE mode.
+  // The value of the sample with the rank round(Percentile / 100 * (N - 1))
+  // of the N samples along the slab is used.
+  vtkSetClampMacro(Percentile, double, 0.0, 100.0);
+  vtkGetMacro(Percentile, double);
+
   enum
   {
     MIP = 0,
     SUM,
     WEIGHTED,
     MINIP,
-    MEAN
+    MEAN,
+    MEDIAN,
+    PERCENTILE
   };
 
 protected:
@@ -61,6 +70,7 @@ protected:
 
   int HandleBoundaries;
   int Dimensionality;
+  double Percentile;
 
   int RequestInformation(vtkInformation *, vtkInformationVector **, vtkInformationVector *) override;
   int RequestUpdateExtent(vtkInformation *, vtkInformationVector **, vtkInformationVector *) override;
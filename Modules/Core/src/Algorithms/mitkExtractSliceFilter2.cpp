@@ -14,11 +14,15 @@ found in the LICENSE file.
 #include <mitkExceptionMacro.h>
 #include <mitkImageAccessByItk.h>
 #include <mitkImageWriteAccessor.h>
+#include <mitkPlaneBoundingRegion.h>
 
 #include <itkBSplineInterpolateImageFunction.h>
 #include <itkLinearInterpolateImageFunction.h>
+#include <itkMultiThreader.h>
 #include <itkNearestNeighborInterpolateImageFunction.h>
 
+#include <algorithm>
+#include <cmath>
 #include <limits>
 
 struct mitk::ExtractSliceFilter2::Impl
@@ -74,15 +78,39 @@ namespace
     result = interpolateImageFunction.GetPointer();
   }
 
-  template <typename TPixel, unsigned int VImageDimension>
-  void GenerateData(const itk::Image<TPixel, VImageDimension>* inputImage, mitk::Image* outputImage, const mitk::ExtractSliceFilter2::OutputImageRegionType& outputRegion, itk::Object* interpolateImageFunction)
+  /** Output pixels closer than this (in voxels) to the voxel grid are treated as voxel samples.*/
+  const double GridTolerance = 1e-6;
+
+  bool IsOnGrid(double value)
   {
-    typedef itk::Image<TPixel, VImageDimension> TInputImage;
-    typedef itk::InterpolateImageFunction<TInputImage> TInterpolateImageFunction;
+    return std::abs(value - std::round(value)) <= GridTolerance;
+  }
 
-    auto outputGeometry = outputImage->GetSlicedGeometry()->GetPlaneGeometry(0);
-    auto interpolator = static_cast<TInterpolateImageFunction*>(interpolateImageFunction);
+  /** The output plane is an affine image of the input index space, so the continuous index of the output
+   * pixel (x, y) is Origin + y * YStep + x * XStep. Thus, the physical point to index transform is evaluated
+   * three times per update instead of once per pixel.*/
+  struct SliceIndexMapping
+  {
+    itk::ContinuousIndex<mitk::ScalarType, 3> Origin;
+    itk::Vector<mitk::ScalarType, 3> XStep;
+    itk::Vector<mitk::ScalarType, 3> YStep;
+
+    /** True if all output pixels are located on the voxel grid, e.g. for axis-aligned planes through voxel
+     * centers. Nearest neighbor and linear interpolation reduce to copying voxels then.*/
+    bool IsOnGrid() const
+    {
+      for (unsigned int i = 0; i < 3; ++i)
+      {
+        if (!::IsOnGrid(Origin[i]) || !::IsOnGrid(XStep[i]) || !::IsOnGrid(YStep[i]))
+          return false;
+      }
+      return true;
+    }
+  };
 
+  template <typename TPixel>
+  SliceIndexMapping CreateSliceIndexMapping(const itk::Image<TPixel, 3>* inputImage, const mitk::PlaneGeometry* outputGeometry)
+  {
     auto origin = outputGeometry->GetOrigin();
     auto spacing = outputGeometry->GetSpacing();
     auto xDirection = outputGeometry->GetAxisVector(0);
@@ -91,45 +119,303 @@ namespace
     xDirection.Normalize();
     yDirection.Normalize();
 
-    auto spacingAlongXDirection = xDirection * spacing[0];
-    auto spacingAlongYDirection = yDirection * spacing[1];
+    itk::ContinuousIndex<mitk::ScalarType, 3> xIndex;
+    itk::ContinuousIndex<mitk::ScalarType, 3> yIndex;
 
-    const std::size_t pixelSize = outputImage->GetPixelType().GetSize();
-    const std::size_t width = outputGeometry->GetExtent(0);
-    const std::size_t xBegin = outputRegion.GetIndex(0);
-    const std::size_t yBegin = outputRegion.GetIndex(1);
-    const std::size_t xEnd = xBegin + outputRegion.GetSize(0);
-    const std::size_t yEnd = yBegin + outputRegion.GetSize(1);
+    SliceIndexMapping mapping;
+    inputImage->TransformPhysicalPointToContinuousIndex(origin, mapping.Origin);
+    inputImage->TransformPhysicalPointToContinuousIndex(origin + xDirection * spacing[0], xIndex);
+    inputImage->TransformPhysicalPointToContinuousIndex(origin + yDirection * spacing[1], yIndex);
 
-    mitk::ImageWriteAccessor writeAccess(outputImage, nullptr, mitk::ImageAccessorBase::IgnoreLock);
-    auto data = static_cast<char*>(writeAccess.GetData());
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+      mapping.XStep[i] = xIndex[i] - mapping.Origin[i];
+      mapping.YStep[i] = yIndex[i] - mapping.Origin[i];
+    }
+
+    return mapping;
+  }
 
-    const TPixel backgroundPixel = std::numeric_limits<TPixel>::lowest();
-    TPixel pixel;
+  /** Samples rows of the output slice directly from the pixel buffer of the input image. The kernels
+   * reproduce the results of the corresponding ITK interpolate image functions, which are only used
+   * for cubic interpolation.*/
+  template <typename TPixel>
+  class SliceSampler
+  {
+  public:
+    typedef itk::Image<TPixel, 3> ImageType;
+    typedef itk::BSplineInterpolateImageFunction<ImageType> CubicInterpolatorType;
+
+    SliceSampler(const ImageType* image, const SliceIndexMapping& mapping)
+      : m_Region(image->GetLargestPossibleRegion()),
+        m_Buffer(image->GetBufferPointer()),
+        m_Mapping(mapping),
+        m_Background(std::numeric_limits<TPixel>::lowest())
+    {
+      const auto& bufferedRegion = image->GetBufferedRegion();
 
-    itk::ContinuousIndex<mitk::ScalarType, 3> index;
-    mitk::Point3D yPoint;
-    mitk::Point3D point;
+      for (unsigned int i = 0; i < 3; ++i)
+      {
+        m_Start[i] = bufferedRegion.GetIndex(i);
+        m_End[i] = bufferedRegion.GetIndex(i) + static_cast<itk::IndexValueType>(bufferedRegion.GetSize(i)) - 1;
+        m_Stride[i] = 0 == i ? 1 : image->GetOffsetTable()[i];
+      }
+    }
 
-    for (std::size_t y = yBegin; y < yEnd; ++y)
+    /** Output pixels on the voxel grid: a row is a (strided) copy of voxels.*/
+    void GatherRow(std::size_t y, std::size_t xBegin, std::size_t xEnd, TPixel* row) const
     {
-      yPoint = origin + spacingAlongYDirection * y;
+      itk::IndexValueType rowIndex[3];
+      itk::IndexValueType step[3];
+      itk::OffsetValueType stepOffset = 0;
 
-      for (std::size_t x = xBegin; x < xEnd; ++x)
+      // range of the row that is located inside of the buffer
+      double first = static_cast<double>(xBegin);
+      double last = static_cast<double>(xEnd) - 1.0;
+
+      for (unsigned int i = 0; i < 3; ++i)
       {
-        point = yPoint + spacingAlongXDirection * x;
+        rowIndex[i] = static_cast<itk::IndexValueType>(std::round(m_Mapping.Origin[i] + m_Mapping.YStep[i] * y));
+        step[i] = static_cast<itk::IndexValueType>(std::round(m_Mapping.XStep[i]));
+        stepOffset += step[i] * m_Stride[i];
 
-        if (inputImage->TransformPhysicalPointToContinuousIndex(point, index))
+        if (0 == step[i])
         {
-          pixel = interpolator->EvaluateAtContinuousIndex(index);
-          memcpy(static_cast<void*>(data + pixelSize * (width * y + x)), static_cast<const void*>(&pixel), pixelSize);
+          if (rowIndex[i] < m_Start[i] || rowIndex[i] > m_End[i])
+            last = first - 1.0;
         }
         else
         {
-          memcpy(static_cast<void*>(data + pixelSize * (width * y + x)), static_cast<const void*>(&backgroundPixel), pixelSize);
+          const double startX = static_cast<double>(m_Start[i] - rowIndex[i]) / step[i];
+          const double endX = static_cast<double>(m_End[i] - rowIndex[i]) / step[i];
+          first = std::max(first, std::ceil(std::min(startX, endX)));
+          last = std::min(last, std::floor(std::max(startX, endX)));
+        }
+      }
+
+      if (last < first)
+      {
+        std::fill(row + xBegin, row + xEnd, m_Background);
+        return;
+      }
+
+      const auto insideBegin = static_cast<std::size_t>(first);
+      const auto insideEnd = static_cast<std::size_t>(last) + 1;
+
+      std::fill(row + xBegin, row + insideBegin, m_Background);
+      std::fill(row + insideEnd, row + xEnd, m_Background);
+
+      itk::OffsetValueType offset = 0;
+      for (unsigned int i = 0; i < 3; ++i)
+        offset += (rowIndex[i] + step[i] * static_cast<itk::IndexValueType>(insideBegin) - m_Start[i]) * m_Stride[i];
+
+      const TPixel* voxel = m_Buffer + offset;
+
+      if (1 == stepOffset)
+      {
+        std::copy(voxel, voxel + (insideEnd - insideBegin), row + insideBegin);
+      }
+      else
+      {
+        for (std::size_t x = insideBegin; x < insideEnd; ++x, voxel += stepOffset)
+          row[x] = *voxel;
+      }
+    }
+
+    void NearestNeighborRow(std::size_t y, std::size_t xBegin, std::size_t xEnd, TPixel* row) const
+    {
+      itk::ContinuousIndex<mitk::ScalarType, 3> index;
+
+      for (std::size_t x = xBegin; x < xEnd; ++x)
+      {
+        if (!this->ComputeIndex(x, y, index))
+        {
+          row[x] = m_Background;
+          continue;
+        }
+
+        itk::OffsetValueType offset = 0;
+        for (unsigned int i = 0; i < 3; ++i)
+        {
+          // rounding half up like itk::NearestNeighborInterpolateImageFunction
+          const auto nearest = static_cast<itk::IndexValueType>(std::floor(index[i] + 0.5));
+          offset += (std::min(std::max(nearest, m_Start[i]), m_End[i]) - m_Start[i]) * m_Stride[i];
+        }
+
+        row[x] = m_Buffer[offset];
+      }
+    }
+
+    void LinearRow(std::size_t y, std::size_t xBegin, std::size_t xEnd, TPixel* row) const
+    {
+      typedef typename itk::NumericTraits<TPixel>::RealType RealType;
+
+      itk::ContinuousIndex<mitk::ScalarType, 3> index;
+      mitk::ScalarType distance[3];
+      itk::OffsetValueType next[3];
+
+      for (std::size_t x = xBegin; x < xEnd; ++x)
+      {
+        if (!this->ComputeIndex(x, y, index))
+        {
+          row[x] = m_Background;
+          continue;
+        }
+
+        // like itk::LinearInterpolateImageFunction, the lower voxel is clamped to the start index
+        // and the upper voxel to the end index of the buffer
+        itk::OffsetValueType offset = 0;
+        for (unsigned int i = 0; i < 3; ++i)
+        {
+          const auto base = std::max(static_cast<itk::IndexValueType>(std::floor(index[i])), m_Start[i]);
+          distance[i] = std::max(index[i] - static_cast<mitk::ScalarType>(base), 0.0);
+          offset += (base - m_Start[i]) * m_Stride[i];
+          next[i] = base < m_End[i] ? m_Stride[i] : 0;
         }
+
+        const TPixel* voxel = m_Buffer + offset;
+
+        const RealType valx00 = this->Lerp(voxel[0], voxel[next[0]], distance[0]);
+        const RealType valx10 = this->Lerp(voxel[next[1]], voxel[next[0] + next[1]], distance[0]);
+        const RealType valx01 = this->Lerp(voxel[next[2]], voxel[next[0] + next[2]], distance[0]);
+        const RealType valx11 = this->Lerp(voxel[next[1] + next[2]], voxel[next[0] + next[1] + next[2]], distance[0]);
+        const RealType valxy0 = valx00 + (valx10 - valx00) * distance[1];
+        const RealType valxy1 = valx01 + (valx11 - valx01) * distance[1];
+
+        row[x] = static_cast<TPixel>(valxy0 + (valxy1 - valxy0) * distance[2]);
+      }
+    }
+
+    /** The weights and indices of the B-spline evaluation are passed per thread, as the interpolate
+     * image function itself is shared by all threads.*/
+    void CubicRow(std::size_t y,
+                  std::size_t xBegin,
+                  std::size_t xEnd,
+                  TPixel* row,
+                  const CubicInterpolatorType* interpolator,
+                  vnl_matrix<long>& evaluateIndex,
+                  vnl_matrix<double>& weights) const
+    {
+      itk::ContinuousIndex<mitk::ScalarType, 3> index;
+
+      for (std::size_t x = xBegin; x < xEnd; ++x)
+      {
+        row[x] = this->ComputeIndex(x, y, index)
+          ? static_cast<TPixel>(interpolator->EvaluateAtContinuousIndex(index, evaluateIndex, weights))
+          : m_Background;
       }
     }
+
+  private:
+    static typename itk::NumericTraits<TPixel>::RealType Lerp(TPixel a, TPixel b, mitk::ScalarType distance)
+    {
+      typedef typename itk::NumericTraits<TPixel>::RealType RealType;
+      return static_cast<RealType>(a) + (static_cast<RealType>(b) - static_cast<RealType>(a)) * distance;
+    }
+
+    bool ComputeIndex(std::size_t x, std::size_t y, itk::ContinuousIndex<mitk::ScalarType, 3>& index) const
+    {
+      for (unsigned int i = 0; i < 3; ++i)
+        index[i] = m_Mapping.Origin[i] + m_Mapping.YStep[i] * y + m_Mapping.XStep[i] * x;
+
+      return m_Region.IsInside(index);
+    }
+
+    typename ImageType::RegionType m_Region;
+    const TPixel* m_Buffer;
+    SliceIndexMapping m_Mapping;
+    TPixel m_Background;
+    itk::IndexValueType m_Start[3];
+    itk::IndexValueType m_End[3];
+    itk::OffsetValueType m_Stride[3];
+  };
+
+  template <typename TPixel>
+  struct SliceJob
+  {
+    const SliceSampler<TPixel>* Sampler;
+    mitk::ExtractSliceFilter2::Interpolator Interpolator;
+    bool IsOnGrid;
+    const itk::Object* InterpolateImageFunction;
+    TPixel* Data;
+    std::size_t Width;
+    std::size_t Height;
+  };
+
+  /** Each thread samples a contiguous block of rows.*/
+  template <typename TPixel>
+  ITK_THREAD_RETURN_TYPE SliceThreaderCallback(void* arg)
+  {
+    typedef typename SliceSampler<TPixel>::CubicInterpolatorType CubicInterpolatorType;
+
+    auto info = static_cast<itk::MultiThreader::ThreadInfoStruct*>(arg);
+    auto job = static_cast<SliceJob<TPixel>*>(info->UserData);
+
+    const std::size_t yBegin = job->Height * info->ThreadID / info->NumberOfThreads;
+    const std::size_t yEnd = job->Height * (info->ThreadID + 1) / info->NumberOfThreads;
+
+    vnl_matrix<long> evaluateIndex;
+    vnl_matrix<double> weights;
+    const CubicInterpolatorType* cubicInterpolator = nullptr;
+
+    if (mitk::ExtractSliceFilter2::Cubic == job->Interpolator)
+    {
+      cubicInterpolator = static_cast<const CubicInterpolatorType*>(job->InterpolateImageFunction);
+      evaluateIndex.set_size(3, cubicInterpolator->GetSplineOrder() + 1);
+      weights.set_size(3, cubicInterpolator->GetSplineOrder() + 1);
+    }
+
+    for (std::size_t y = yBegin; y < yEnd; ++y)
+    {
+      TPixel* row = job->Data + job->Width * y;
+
+      if (nullptr != cubicInterpolator)
+        job->Sampler->CubicRow(y, 0, job->Width, row, cubicInterpolator, evaluateIndex, weights);
+      else if (job->IsOnGrid)
+        job->Sampler->GatherRow(y, 0, job->Width, row);
+      else if (mitk::ExtractSliceFilter2::Linear == job->Interpolator)
+        job->Sampler->LinearRow(y, 0, job->Width, row);
+      else
+        job->Sampler->NearestNeighborRow(y, 0, job->Width, row);
+    }
+
+    return ITK_THREAD_RETURN_VALUE;
+  }
+
+  /** Picks the fastest exact kernel for the plane: voxels are copied if all output pixels are located on the
+   * voxel grid (not for cubic interpolation, as the B-spline is only approximately interpolating in floating
+   * point arithmetic), otherwise the index of each pixel is stepped incrementally along the rows.*/
+  template <typename TPixel, unsigned int VImageDimension>
+  void GenerateData(const itk::Image<TPixel, VImageDimension>* inputImage, mitk::Image* outputImage, mitk::ExtractSliceFilter2::Interpolator interpolator, itk::Object* interpolateImageFunction)
+  {
+    auto outputGeometry = outputImage->GetSlicedGeometry()->GetPlaneGeometry(0);
+
+    const std::size_t width = outputGeometry->GetExtent(0);
+    const std::size_t height = outputGeometry->GetExtent(1);
+
+    if (0 == width || 0 == height)
+      return;
+
+    const SliceIndexMapping mapping = CreateSliceIndexMapping(inputImage, outputGeometry);
+    const SliceSampler<TPixel> sampler(inputImage, mapping);
+
+    mitk::ImageWriteAccessor writeAccess(outputImage, nullptr, mitk::ImageAccessorBase::IgnoreLock);
+
+    SliceJob<TPixel> job;
+    job.Sampler = &sampler;
+    job.Interpolator = interpolator;
+    job.IsOnGrid = mitk::ExtractSliceFilter2::Cubic != interpolator && mapping.IsOnGrid();
+    job.InterpolateImageFunction = interpolateImageFunction;
+    job.Data = static_cast<TPixel*>(writeAccess.GetData());
+    job.Width = width;
+    job.Height = height;
+
+    itk::MultiThreader::Pointer threader = itk::MultiThreader::New();
+    const auto numberOfThreads = static_cast<itk::ThreadIdType>(std::max<std::size_t>(
+      1, std::min<std::size_t>(itk::MultiThreader::GetGlobalDefaultNumberOfThreads(), height)));
+    threader->SetNumberOfThreads(numberOfThreads);
+    threader->SetSingleMethod(SliceThreaderCallback<TPixel>, &job);
+    threader->SingleMethodExecute();
   }
 
   void VerifyInputImage(const mitk::Image* inputImage)
@@ -181,49 +467,42 @@ void mitk::ExtractSliceFilter2::AllocateOutputs()
   auto outputImage = this->GetOutput();
   auto pixelType = inputImage->GetPixelType();
 
+  // The slice is allocated by the image on first access, i.e., from the image memory pool. Thus, the
+  // memory of the previous slice, which is released here, is reused by the next one.
   outputImage->Initialize(pixelType, 1, *outputGeometry);
-
-  auto data = new char[static_cast<std::size_t>(pixelType.GetSize() * outputGeometry->GetExtent(0) * outputGeometry->GetExtent(1))];
-
-  try
-  {
-    if (!outputImage->SetImportVolume(data, 0, 0, mitk::Image::ReferenceMemory))
-      throw;
-  }
-  catch (...)
-  {
-    delete[] data;
-  }
 }
 
-/*void mitk::ExtractSliceFilter2::BeforeThreadedGenerateData()
+void mitk::ExtractSliceFilter2::GenerateData()
 {
-  if (nullptr != m_Impl->InterpolateImageFunction && this->GetInput()->GetMTime() < this->GetMTime())
-    return;
-
   const auto* inputImage = this->GetInput();
-  AccessFixedDimensionByItk_2(inputImage, CreateInterpolateImageFunction, 3, this->GetInterpolator(), m_Impl->InterpolateImageFunction);
-}
 
-void mitk::ExtractSliceFilter2::ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType)
-{
-  const auto* inputImage = this->GetInput();
-  AccessFixedDimensionByItk_3(inputImage, ::GenerateData, 3, this->GetOutput(), outputRegionForThread, m_Impl->InterpolateImageFunction);
-}*/
+  // Bricked images are only read in the bounding region of the output plane. The margin covers the
+  // neighbours of linear interpolation and lets the B-spline coefficients, which are computed for the
+  // region only, converge to the ones of the whole image.
+  if (nullptr != inputImage->GetBrickedStorage())
+  {
+    const unsigned int margin = Cubic == this->GetInterpolator() ? 8 : 1;
+    auto region = PlaneBoundingRegion::Compute(inputImage->GetGeometry(), this->GetOutputGeometry(), margin);
+    auto regionImage = PlaneBoundingRegion::ExtractImage(inputImage, region);
 
-void mitk::ExtractSliceFilter2::GenerateData()
-{
-  if (nullptr != m_Impl->InterpolateImageFunction && this->GetInput()->GetMTime() < this->GetMTime())
-    return;
+    itk::Object::Pointer interpolateImageFunction;
+    if (Cubic == this->GetInterpolator())
+      AccessFixedDimensionByItk_2(regionImage.GetPointer(), CreateInterpolateImageFunction, 3, this->GetInterpolator(), interpolateImageFunction);
 
-  const auto* inputImage = this->GetInput();
+    this->AllocateOutputs();
+
+    AccessFixedDimensionByItk_3(regionImage.GetPointer(), ::GenerateData, 3, this->GetOutput(), this->GetInterpolator(), interpolateImageFunction);
+    return;
+  }
 
-  AccessFixedDimensionByItk_2(inputImage, CreateInterpolateImageFunction, 3, this->GetInterpolator(), m_Impl->InterpolateImageFunction);
+  // Only cubic interpolation needs the ITK interpolate image function. Its B-spline coefficients are
+  // reused as long as the input image is not modified.
+  if (Cubic == this->GetInterpolator() && (nullptr == m_Impl->InterpolateImageFunction || inputImage->GetMTime() > m_Impl->InterpolateImageFunction->GetMTime()))
+    AccessFixedDimensionByItk_2(inputImage, CreateInterpolateImageFunction, 3, this->GetInterpolator(), m_Impl->InterpolateImageFunction);
 
   this->AllocateOutputs();
-  auto outputRegion = this->GetOutput()->GetLargestPossibleRegion();
 
-  AccessFixedDimensionByItk_3(inputImage, ::GenerateData, 3, this->GetOutput(), outputRegion, m_Impl->InterpolateImageFunction);
+  AccessFixedDimensionByItk_3(inputImage, ::GenerateData, 3, this->GetOutput(), this->GetInterpolator(), m_Impl->InterpolateImageFunction);
 }
 
 void mitk::ExtractSliceFilter2::SetInput(const InputImageType* image)
@@ -68,10 +68,8 @@ void mitk::ImageTimeSelector::GenerateData()
   // do we really need a complete volume at a time?
   if (requestedRegion.GetSize(2) > 1)
   {
-    mitk::ImageDataItem::Pointer im = this->GetVolumeData(m_TimeNr, m_ChannelNr)->Clone();
-    im->SetTimestep(0);
-    im->SetManageMemory(false);
-    this->SetVolumeItem(im, 0);
+    // the output references the memory of the input volume, so writing to the output writes to the input
+    this->SetReferencedVolumeItem(m_TimeNr, m_ChannelNr);
   }
   else
     // no, so take just a slice!
@@ -62,6 +62,26 @@ void mitk::SubImageSelector::SetSliceItem(mitk::Image::ImageDataItemPointer data
   output->m_Slices[pos] = dataItem;
 }
 
+void mitk::SubImageSelector::SetReferencedVolumeItem(int t, int n, int outputT, int outputN)
+{
+  mitk::Image::Pointer input = this->GetInput();
+  mitk::Image::Pointer output = this->GetOutput();
+  if (output->IsValidVolume(outputT, outputN) == false)
+    return;
+
+  mitk::Image::ImageDataItemPointer volume = input->GetVolumeData(t, n);
+  if (volume.IsNull())
+    return;
+
+  mitk::Image::ImageDataItemPointer dataItem =
+    new mitk::ImageDataItem(*volume, output->m_ImageDescriptor, outputT, 3, nullptr, false, 0);
+  dataItem->SetComplete(true);
+  this->SetVolumeItem(dataItem, outputT, outputN);
+
+  // the output lets the input copy the volume on write access, if it is shared (see Image::PrepareWriteAccess())
+  output->m_ReferencedVolumes.push_back({outputT, outputN, input->m_CopyOnWriteOwner, t, n});
+}
+
 mitk::SubImageSelector::SubImageSelector()
 {
 }
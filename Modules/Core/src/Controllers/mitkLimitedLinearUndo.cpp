@@ -13,8 +13,10 @@ found in the LICENSE file.
 #include "mitkLimitedLinearUndo.h"
 #include <mitkRenderingManager.h>
 
+#include <iterator>
+
 mitk::LimitedLinearUndo::LimitedLinearUndo()
-: m_UndoLimit(0)
+: m_UndoLimit(0), m_MemoryLimit(0), m_UndoListMemorySize(0)
 {
   // nothing to do
 }
@@ -28,6 +30,9 @@ mitk::LimitedLinearUndo::~LimitedLinearUndo()
 
 void mitk::LimitedLinearUndo::ClearList(UndoContainer *list)
 {
+  if (list == &m_UndoList)
+    m_UndoListMemorySize = 0;
+
   while (!list->empty())
   {
     UndoStackItem *item = list->back();
@@ -49,13 +54,7 @@ bool mitk::LimitedLinearUndo::SetOperationEvent(UndoStackItem *stackItem)
     InvokeEvent(RedoEmptyEvent());
   }
 
-  if (0 != m_UndoLimit && m_UndoList.size() == m_UndoLimit)
-  {
-    auto item = m_UndoList.front();
-    m_UndoList.pop_front();
-    delete item;
-  }
-  m_UndoList.push_back(operationEvent);
+  this->PushToUndoList(operationEvent);
 
   InvokeEvent(UndoNotEmptyEvent());
 
@@ -97,6 +96,7 @@ bool mitk::LimitedLinearUndo::Undo(int oeid)
   {
     m_UndoList.back()->ReverseAndExecute();
 
+    m_UndoListMemorySize -= m_UndoList.back()->GetMemorySize();
     m_RedoList.push_back(m_UndoList.back()); // move to redo stack
     m_UndoList.pop_back();
     InvokeEvent(RedoNotEmptyEvent());
@@ -137,6 +137,7 @@ bool mitk::LimitedLinearUndo::Redo(int oeid)
   {
     m_RedoList.back()->ReverseAndExecute();
 
+    m_UndoListMemorySize += m_RedoList.back()->GetMemorySize();
     m_UndoList.push_back(m_RedoList.back());
     m_RedoList.pop_back();
     InvokeEvent(UndoNotEmptyEvent());
@@ -182,14 +183,68 @@ void mitk::LimitedLinearUndo::SetUndoLimit(std::size_t undoLimit)
 {
   if (undoLimit != m_UndoLimit)
   {
-    if (m_UndoList.size() > undoLimit)
-    {
-      m_UndoList.erase(m_UndoList.begin(), m_UndoList.end() - undoLimit);
-    }
     m_UndoLimit = undoLimit;
+    this->ApplyUndoLimits();
+  }
+}
+
+std::size_t mitk::LimitedLinearUndo::GetMemoryLimit() const
+{
+  return m_MemoryLimit;
+}
+
+void mitk::LimitedLinearUndo::SetMemoryLimit(std::size_t bytes)
+{
+  if (bytes != m_MemoryLimit)
+  {
+    m_MemoryLimit = bytes;
+    this->ApplyUndoLimits();
   }
 }
 
+std::size_t mitk::LimitedLinearUndo::GetUndoListMemorySize() const
+{
+  return m_UndoListMemorySize;
+}
+
+void mitk::LimitedLinearUndo::PushToUndoList(UndoStackItem *item)
+{
+  m_UndoListMemorySize += item->GetMemorySize();
+  m_UndoList.push_back(item);
+  this->ApplyUndoLimits();
+}
+
+void mitk::LimitedLinearUndo::ApplyUndoLimits()
+{
+  while (0 != m_UndoLimit && m_UndoList.size() > m_UndoLimit)
+  {
+    this->DropOldestUndoItem();
+  }
+
+  // drop whole groups, so that a coarse undo never reverts half of a group
+  while (0 != m_MemoryLimit && m_UndoListMemorySize > m_MemoryLimit)
+  {
+    const int groupEventId = m_UndoList.front()->GetGroupEventId();
+    auto groupEnd = m_UndoList.begin();
+    while (groupEnd != m_UndoList.end() && (*groupEnd)->GetGroupEventId() == groupEventId)
+      ++groupEnd;
+
+    // the most recent group is always kept
+    if (groupEnd == m_UndoList.end())
+      break;
+
+    for (auto count = std::distance(m_UndoList.begin(), groupEnd); count > 0; --count)
+      this->DropOldestUndoItem();
+  }
+}
+
+void mitk::LimitedLinearUndo::DropOldestUndoItem()
+{
+  m_UndoListMemorySize -= m_UndoList.front()->GetMemorySize();
+  delete m_UndoList.front();
+  m_UndoList.pop_front();
+}
+
 int mitk::LimitedLinearUndo::GetLastObjectEventIdInList()
 {
   return m_UndoList.back()->GetObjectEventId();
@@ -0,0 +1,445 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkBrickedImageStorage.h"
+
+#include <mitkExceptionMacro.h>
+#include <mitkImage.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkLogMacros.h>
+
+#include <itkRawImageIO.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+struct mitk::BrickedImageStorage::Header
+{
+  char magic[8];
+  /** 0x01020304 written in the byte order of the writing machine.*/
+  std::uint32_t byteOrderMark;
+  std::int32_t componentType;
+  std::int32_t pixelType;
+  std::uint32_t numberOfComponents;
+  std::uint32_t dimensions[4];
+  std::uint32_t brickSize;
+  char reserved[20];
+};
+
+namespace
+{
+  const char Magic[8] = {'M', 'I', 'T', 'K', 'B', 'R', 'K', '\1'};
+  const std::uint32_t ByteOrderMark = 0x01020304;
+
+  typedef mitk::BrickedImageStorage::Header Header;
+
+  Header ReadHeader(const std::string &fileName)
+  {
+    std::ifstream file(fileName.c_str(), std::ios::binary);
+    if (!file)
+      mitkThrow() << "Cannot open brick file \"" << fileName << "\".";
+
+    Header header;
+    file.read(reinterpret_cast<char *>(&header), sizeof(Header));
+    if (!file || !std::equal(Magic, Magic + sizeof(Magic), header.magic))
+      mitkThrow() << "\"" << fileName << "\" is no brick file.";
+
+    if (header.byteOrderMark != ByteOrderMark)
+      mitkThrow() << "Brick file \"" << fileName << "\" was written on a machine with a different byte order.";
+
+    if (0 == header.brickSize || 0 == header.numberOfComponents ||
+        std::count(header.dimensions, header.dimensions + 4, 0u) != 0)
+      mitkThrow() << "Brick file \"" << fileName << "\" has an invalid header.";
+
+    return header;
+  }
+
+  mitk::PixelType MakePixelType(const Header &header)
+  {
+    auto imageIO = itk::RawImageIO<unsigned char, 3>::New();
+    imageIO->SetComponentType(static_cast<itk::ImageIOBase::IOComponentType>(header.componentType));
+    imageIO->SetPixelType(static_cast<itk::ImageIOBase::IOPixelType>(header.pixelType));
+    imageIO->SetNumberOfComponents(header.numberOfComponents);
+    return mitk::MakePixelType(imageIO.GetPointer());
+  }
+
+  unsigned int GetNumberOfBricks(unsigned int dimension, unsigned int brickSize)
+  {
+    return (dimension + brickSize - 1) / brickSize;
+  }
+}
+
+mitk::BrickedImageStorage::Pointer mitk::BrickedImageStorage::Create(const std::string &fileName,
+                                                                     const PixelType &pixelType,
+                                                                     const unsigned int *dimensions,
+                                                                     unsigned int brickSize)
+{
+  if (0 == brickSize || std::count(dimensions, dimensions + 4, 0u) != 0)
+    mitkThrow() << "Cannot create brick file \"" << fileName << "\" with empty dimensions or bricks.";
+
+  Header header;
+  std::memset(&header, 0, sizeof(Header));
+  std::copy(Magic, Magic + sizeof(Magic), header.magic);
+  header.byteOrderMark = ByteOrderMark;
+  header.componentType = pixelType.GetComponentType();
+  header.pixelType = pixelType.GetPixelType();
+  header.numberOfComponents = static_cast<std::uint32_t>(pixelType.GetNumberOfComponents());
+  std::copy(dimensions, dimensions + 4, header.dimensions);
+  header.brickSize = brickSize;
+
+  std::size_t numberOfBricks = dimensions[3];
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    numberOfBricks *= GetNumberOfBricks(dimensions[i], brickSize);
+  }
+  const std::size_t fileSize =
+    sizeof(Header) + numberOfBricks * brickSize * brickSize * brickSize * pixelType.GetSize();
+
+  {
+    std::ofstream file(fileName.c_str(), std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char *>(&header), sizeof(Header));
+    // the (sparse) bricks in between are zero
+    file.seekp(static_cast<std::streamoff>(fileSize - 1));
+    file.put('\0');
+    if (!file)
+      mitkThrow() << "Cannot create brick file \"" << fileName << "\".";
+  }
+
+  Pointer storage = new Self(fileName, header);
+  storage->UnRegister();
+  return storage;
+}
+
+mitk::BrickedImageStorage::Pointer mitk::BrickedImageStorage::Create(const std::string &fileName,
+                                                                     const Image *image,
+                                                                     unsigned int brickSize)
+{
+  if (nullptr == image || !image->IsInitialized() || image->GetDimension() < 2 || image->GetDimension() > 4)
+    mitkThrow() << "Cannot create brick file \"" << fileName << "\" of an uninitialized or non-3D+t image.";
+
+  unsigned int dimensions[4] = {image->GetDimension(0), image->GetDimension(1), 1, 1};
+  if (image->GetDimension() > 2)
+    dimensions[2] = image->GetDimension(2);
+  if (image->GetDimension() > 3)
+    dimensions[3] = image->GetDimension(3);
+
+  Pointer storage = Create(fileName, image->GetPixelType(), dimensions, brickSize);
+
+  RegionType region;
+  region.SetSize(0, dimensions[0]);
+  region.SetSize(1, dimensions[1]);
+  region.SetSize(2, dimensions[2]);
+  for (unsigned int t = 0; t < dimensions[3]; ++t)
+  {
+    ImageReadAccessor readAccess(image, image->GetVolumeData(t));
+    storage->WriteRegion(region, t, readAccess.GetData());
+  }
+  storage->Flush();
+
+  return storage;
+}
+
+mitk::BrickedImageStorage::BrickedImageStorage(const std::string &fileName)
+  : BrickedImageStorage(fileName, ReadHeader(fileName))
+{
+}
+
+mitk::BrickedImageStorage::BrickedImageStorage(const std::string &fileName, const Header &header)
+  : m_FileName(fileName),
+    m_PixelType(MakePixelType(header)),
+    m_BrickSize(header.brickSize),
+    m_BytesPerPixel(m_PixelType.GetSize()),
+    m_BytesPerBrick(static_cast<std::size_t>(header.brickSize) * header.brickSize * header.brickSize *
+                    m_PixelType.GetSize()),
+    m_HeaderSize(sizeof(Header)),
+    m_ReadOnly(false),
+    m_CachedBytes(0),
+    m_MemoryBudget(512 * 1024 * 1024),
+    m_NumberOfBrickReads(0),
+    m_NumberOfCacheHits(0)
+{
+  std::copy(header.dimensions, header.dimensions + 4, m_Dimensions);
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    m_NumberOfBricks[i] = GetNumberOfBricks(m_Dimensions[i], m_BrickSize);
+  }
+
+  m_File.open(fileName.c_str(), std::ios::in | std::ios::out | std::ios::binary);
+  if (!m_File.is_open())
+  {
+    m_File.clear();
+    m_File.open(fileName.c_str(), std::ios::in | std::ios::binary);
+    m_ReadOnly = true;
+  }
+
+  if (!m_File.is_open())
+    mitkThrow() << "Cannot open brick file \"" << fileName << "\".";
+}
+
+mitk::BrickedImageStorage::~BrickedImageStorage()
+{
+  try
+  {
+    this->Flush();
+  }
+  catch (const Exception &e)
+  {
+    MITK_ERROR << e.GetDescription();
+  }
+}
+
+void mitk::BrickedImageStorage::SetMemoryBudget(std::size_t bytes)
+{
+  std::lock_guard<std::mutex> lock(m_CacheMutex);
+  m_MemoryBudget = bytes;
+  this->EvictBricksUnlocked();
+}
+
+std::size_t mitk::BrickedImageStorage::GetMemoryBudget() const
+{
+  std::lock_guard<std::mutex> lock(m_CacheMutex);
+  return m_MemoryBudget;
+}
+
+std::size_t mitk::BrickedImageStorage::GetCachedBytes() const
+{
+  std::lock_guard<std::mutex> lock(m_CacheMutex);
+  return m_CachedBytes;
+}
+
+unsigned long mitk::BrickedImageStorage::GetNumberOfBrickReads() const
+{
+  std::lock_guard<std::mutex> lock(m_CacheMutex);
+  return m_NumberOfBrickReads;
+}
+
+unsigned long mitk::BrickedImageStorage::GetNumberOfCacheHits() const
+{
+  std::lock_guard<std::mutex> lock(m_CacheMutex);
+  return m_NumberOfCacheHits;
+}
+
+template <typename TFunctor>
+void mitk::BrickedImageStorage::ForEachBrick(const RegionType &region, unsigned int timeStep, TFunctor functor) const
+{
+  const auto &index = region.GetIndex();
+  const auto &size = region.GetSize();
+
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    if (index[i] < 0 || 0 == size[i] || index[i] + size[i] > m_Dimensions[i])
+      mitkThrow() << "Region " << region << " is not inside the bricked image.";
+  }
+  if (timeStep >= m_Dimensions[3])
+    mitkThrow() << "Time step " << timeStep << " is not inside the bricked image.";
+
+  long first[3], last[3];
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    first[i] = index[i] / m_BrickSize;
+    last[i] = (index[i] + size[i] - 1) / m_BrickSize;
+  }
+
+  long begin[3], end[3];
+  for (long z = first[2]; z <= last[2]; ++z)
+  {
+    for (long y = first[1]; y <= last[1]; ++y)
+    {
+      for (long x = first[0]; x <= last[0]; ++x)
+      {
+        const long brick[3] = {x, y, z};
+        for (unsigned int i = 0; i < 3; ++i)
+        {
+          begin[i] = std::max<long>(index[i], brick[i] * m_BrickSize);
+          end[i] = std::min<long>(index[i] + size[i], (brick[i] + 1) * m_BrickSize);
+        }
+
+        const std::size_t brickIndex =
+          ((static_cast<std::size_t>(timeStep) * m_NumberOfBricks[2] + z) * m_NumberOfBricks[1] + y) *
+            m_NumberOfBricks[0] +
+          x;
+
+        functor(brickIndex, brick, begin, end);
+      }
+    }
+  }
+}
+
+void mitk::BrickedImageStorage::ReadRegion(const RegionType &region, unsigned int timeStep, void *buffer) const
+{
+  const auto &index = region.GetIndex();
+  const auto &size = region.GetSize();
+  auto *pixels = static_cast<char *>(buffer);
+
+  this->ForEachBrick(region, timeStep, [&](std::size_t brickIndex, const long *brick, const long *begin, const long *end) {
+    const BrickPointer brickData = this->GetBrick(brickIndex);
+    const std::size_t rowSize = (end[0] - begin[0]) * m_BytesPerPixel;
+
+    for (long z = begin[2]; z < end[2]; ++z)
+    {
+      for (long y = begin[1]; y < end[1]; ++y)
+      {
+        const std::size_t source =
+          ((z - brick[2] * m_BrickSize) * m_BrickSize + (y - brick[1] * m_BrickSize)) * m_BrickSize +
+          (begin[0] - brick[0] * m_BrickSize);
+        const std::size_t target = ((z - index[2]) * size[1] + (y - index[1])) * size[0] + (begin[0] - index[0]);
+        std::memcpy(pixels + target * m_BytesPerPixel, brickData->data.data() + source * m_BytesPerPixel, rowSize);
+      }
+    }
+  });
+}
+
+void mitk::BrickedImageStorage::WriteRegion(const RegionType &region, unsigned int timeStep, const void *buffer)
+{
+  if (m_ReadOnly)
+    mitkThrow() << "Brick file \"" << m_FileName << "\" is read-only.";
+
+  const auto &index = region.GetIndex();
+  const auto &size = region.GetSize();
+  const auto *pixels = static_cast<const char *>(buffer);
+
+  this->ForEachBrick(region, timeStep, [&](std::size_t brickIndex, const long *brick, const long *begin, const long *end) {
+    const BrickPointer brickData = this->GetBrick(brickIndex);
+    const std::size_t rowSize = (end[0] - begin[0]) * m_BytesPerPixel;
+
+    for (long z = begin[2]; z < end[2]; ++z)
+    {
+      for (long y = begin[1]; y < end[1]; ++y)
+      {
+        const std::size_t target =
+          ((z - brick[2] * m_BrickSize) * m_BrickSize + (y - brick[1] * m_BrickSize)) * m_BrickSize +
+          (begin[0] - brick[0] * m_BrickSize);
+        const std::size_t source = ((z - index[2]) * size[1] + (y - index[1])) * size[0] + (begin[0] - index[0]);
+        std::memcpy(brickData->data.data() + target * m_BytesPerPixel, pixels + source * m_BytesPerPixel, rowSize);
+      }
+    }
+
+    std::lock_guard<std::mutex> lock(m_CacheMutex);
+    brickData->modified = true;
+  });
+}
+
+void mitk::BrickedImageStorage::Flush()
+{
+  std::lock_guard<std::mutex> lock(m_CacheMutex);
+  for (auto &brick : m_Bricks)
+  {
+    if (brick.second->modified)
+    {
+      this->WriteBrickToFile(brick.first, brick.second->data.data());
+      brick.second->modified = false;
+    }
+  }
+
+  std::lock_guard<std::mutex> fileLock(m_FileMutex);
+  m_File.flush();
+}
+
+void mitk::BrickedImageStorage::ClearCache()
+{
+  this->Flush();
+
+  std::lock_guard<std::mutex> lock(m_CacheMutex);
+  m_Bricks.clear();
+  m_BrickMap.clear();
+  m_CachedBytes = 0;
+}
+
+mitk::BrickedImageStorage::BrickPointer mitk::BrickedImageStorage::GetBrick(std::size_t brickIndex) const
+{
+  {
+    std::lock_guard<std::mutex> lock(m_CacheMutex);
+    auto iter = m_BrickMap.find(brickIndex);
+    if (iter != m_BrickMap.end())
+    {
+      m_Bricks.splice(m_Bricks.begin(), m_Bricks, iter->second);
+      ++m_NumberOfCacheHits;
+      return iter->second->second;
+    }
+  }
+
+  // other bricks can be served from the cache meanwhile
+  auto brick = std::make_shared<Brick>();
+  brick->data.resize(m_BytesPerBrick);
+  brick->modified = false;
+  this->ReadBrickFromFile(brickIndex, brick->data.data());
+
+  std::lock_guard<std::mutex> lock(m_CacheMutex);
+  auto iter = m_BrickMap.find(brickIndex);
+  if (iter != m_BrickMap.end())
+  {
+    // read by another thread in the meantime
+    m_Bricks.splice(m_Bricks.begin(), m_Bricks, iter->second);
+    return iter->second->second;
+  }
+
+  ++m_NumberOfBrickReads;
+  this->InsertBrickUnlocked(brickIndex, brick);
+  return brick;
+}
+
+void mitk::BrickedImageStorage::InsertBrickUnlocked(std::size_t brickIndex, const BrickPointer &brick) const
+{
+  m_Bricks.emplace_front(brickIndex, brick);
+  m_BrickMap[brickIndex] = m_Bricks.begin();
+  m_CachedBytes += m_BytesPerBrick;
+  this->EvictBricksUnlocked();
+}
+
+void mitk::BrickedImageStorage::EvictBricksUnlocked() const
+{
+  // walk from the least to the most recently used brick
+  auto iter = m_Bricks.end();
+  while (m_CachedBytes > m_MemoryBudget && iter != m_Bricks.begin())
+  {
+    --iter;
+    if (iter->second.use_count() > 1)
+      continue;
+
+    if (iter->second->modified)
+      this->WriteBrickToFile(iter->first, iter->second->data.data());
+
+    m_BrickMap.erase(iter->first);
+    iter = m_Bricks.erase(iter);
+    m_CachedBytes -= m_BytesPerBrick;
+  }
+}
+
+std::size_t mitk::BrickedImageStorage::GetBrickOffset(std::size_t brickIndex) const
+{
+  return m_HeaderSize + brickIndex * m_BytesPerBrick;
+}
+
+void mitk::BrickedImageStorage::ReadBrickFromFile(std::size_t brickIndex, char *data) const
+{
+  std::lock_guard<std::mutex> lock(m_FileMutex);
+  m_File.seekg(static_cast<std::streamoff>(this->GetBrickOffset(brickIndex)));
+  m_File.read(data, m_BytesPerBrick);
+  if (!m_File)
+  {
+    m_File.clear();
+    mitkThrow() << "Cannot read brick " << brickIndex << " of brick file \"" << m_FileName << "\".";
+  }
+}
+
+void mitk::BrickedImageStorage::WriteBrickToFile(std::size_t brickIndex, const char *data) const
+{
+  std::lock_guard<std::mutex> lock(m_FileMutex);
+  m_File.seekp(static_cast<std::streamoff>(this->GetBrickOffset(brickIndex)));
+  m_File.write(data, m_BytesPerBrick);
+  if (!m_File)
+  {
+    m_File.clear();
+    mitkThrow() << "Cannot write brick " << brickIndex << " of brick file \"" << m_FileName << "\".";
+  }
+}
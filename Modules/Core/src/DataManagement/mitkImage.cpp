@@ -13,6 +13,7 @@ found in the LICENSE file.
 // MITK
 #include "mitkImage.h"
 #include "mitkCompareImageDataFilter.h"
+#include "mitkImageReadAccessor.h"
 #include "mitkImageStatisticsHolder.h"
 #include "mitkImageVtkReadAccessor.h"
 #include "mitkImageVtkWriteAccessor.h"
@@ -26,7 +27,9 @@ found in the LICENSE file.
 #include <itkMutexLockHolder.h>
 
 // Other
+#include <algorithm>
 #include <cmath>
+#include <memory>
 
 #define FILL_C_ARRAY(_arr, _size, _value)                                                                              \
   for (unsigned int i = 0u; i < _size; i++)                                                                            \
@@ -35,13 +38,29 @@ found in the LICENSE file.
     _arr[i] = _value;                                                                                                  \
   }
 
+namespace
+{
+  /** Guards the copy-on-write tokens of the data items, which are shared by several images.*/
+  std::mutex CopyOnWriteMutex;
+
+  const mitk::ImageDataItem *GetRootItem(const mitk::ImageDataItem *item)
+  {
+    while (item->GetParent().IsNotNull())
+      item = item->GetParent().GetPointer();
+    return item;
+  }
+}
+
 mitk::Image::Image()
   : m_Dimension(0),
     m_Dimensions(nullptr),
     m_ImageDescriptor(nullptr),
     m_OffsetTable(nullptr),
     m_CompleteData(nullptr),
-    m_ImageStatistics(nullptr)
+    m_ImageStatistics(nullptr),
+    m_CopyOnWriteOwner(std::make_shared<Image *>(this)),
+    m_NumberOfLoadedSlices(0),
+    m_LoadingProgressively(false)
 {
   m_Dimensions = new unsigned int[MAX_IMAGE_DIMENSIONS];
   FILL_C_ARRAY(m_Dimensions, MAX_IMAGE_DIMENSIONS, 0u);
@@ -56,7 +75,10 @@ mitk::Image::Image(const Image &other)
     m_ImageDescriptor(nullptr),
     m_OffsetTable(nullptr),
     m_CompleteData(nullptr),
-    m_ImageStatistics(nullptr)
+    m_ImageStatistics(nullptr),
+    m_CopyOnWriteOwner(std::make_shared<Image *>(this)),
+    m_NumberOfLoadedSlices(0),
+    m_LoadingProgressively(false)
 {
   m_Dimensions = new unsigned int[MAX_IMAGE_DIMENSIONS];
   FILL_C_ARRAY(m_Dimensions, MAX_IMAGE_DIMENSIONS, 0u);
@@ -68,22 +90,11 @@ mitk::Image::Image(const Image &other)
   TimeGeometry::Pointer cloned = other.GetTimeGeometry()->Clone();
   this->SetTimeGeometry(cloned.GetPointer());
 
-  if (this->GetDimension() > 3)
+  // the volumes are copied not before one of the images is written
+  const unsigned int timeSteps = this->GetDimension() > 3 ? this->GetDimension(3) : 1;
+  for (unsigned int i = 0u; i < timeSteps; ++i)
   {
-    const unsigned int time_steps = this->GetDimension(3);
-
-    for (unsigned int i = 0u; i < time_steps; ++i)
-    {
-      ImageDataItemPointer volume = other.GetVolumeData(i);
-
-      this->SetVolume(volume->GetData(), i);
-    }
-  }
-  else
-  {
-    ImageDataItemPointer volume = other.GetVolumeData(0);
-
-    this->SetVolume(volume->GetData(), 0);
+    this->SetSharedVolume(&other, i, 0, i, 0);
   }
 }
 
@@ -124,14 +135,22 @@ void *mitk::Image::GetData()
     if (GetSource()->Updating() == false)
       GetSource()->UpdateOutputInformation();
   }
+
+  // writes to the memory would never reach the bricks
+  if (m_BrickedStorage.IsNotNull())
+    mitkThrow() << "Image::GetData() is not available for bricked images. Use ImageReadAccessor or "
+                   "ImageWriteAccessor instead.";
+
+  // the caller may write to the returned memory
+  this->PrepareWriteAccess(nullptr);
   m_CompleteData = GetChannelData();
 
   // update channel's data
   // if data was not available at creation point, the m_Data of channel descriptor is nullptr
   // if data present, it won't be overwritten
-  m_ImageDescriptor->GetChannelDescriptor(0).SetData(m_CompleteData->GetData());
+  m_ImageDescriptor->GetChannelDescriptor(0).SetData(m_CompleteData->m_Data);
 
-  return m_CompleteData->GetData();
+  return m_CompleteData->m_Data;
 }
 
 template <class T>
@@ -190,7 +209,9 @@ double mitk::Image::GetPixelValueByIndex(const itk::Index<3> &position, unsigned
                                                                  position[2] * imageDims[0] * imageDims[1] +
                                                                  timestep * imageDims[0] * imageDims[1] * imageDims[2]);
 
-    mitkPixelTypeMultiplex3(AccessPixel, ptype, this->GetData(), offset, value);
+    // reading does not need to copy memory shared with other images, unlike GetData()
+    ImageDataItemPointer channel = this->GetChannelData();
+    mitkPixelTypeMultiplex3(AccessPixel, ptype, channel.IsNotNull() ? channel->m_Data : nullptr, offset, value);
   }
 
   return value;
@@ -223,7 +244,16 @@ vtkImageData *mitk::Image::GetVtkImageData(int t, int n)
     if (GetSource()->Updating() == false)
       GetSource()->UpdateOutputInformation();
   }
+
+  // the image data would refer to a volume read from the bricks, which is not kept
+  if (m_BrickedStorage.IsNotNull() && 0 == n)
+    mitkThrow() << "Image::GetVtkImageData() is not available for bricked images. Use GetRegionData() or "
+                   "ImageReadAccessor instead.";
+
+  // the caller may write to the returned image data
   ImageDataItemPointer volume = GetVolumeData(t, n);
+  if (volume.IsNotNull())
+    volume = const_cast<ImageDataItem *>(this->PrepareWriteAccess(volume));
   return volume.GetPointer() == nullptr ? nullptr : volume->GetVtkImageAccessor(this)->GetVtkImageData();
 }
 
@@ -236,6 +266,11 @@ const vtkImageData *mitk::Image::GetVtkImageData(int t, int n) const
     if (GetSource()->Updating() == false)
       GetSource()->UpdateOutputInformation();
   }
+  // the image data would refer to a volume read from the bricks, which is not kept
+  if (m_BrickedStorage.IsNotNull() && 0 == n)
+    mitkThrow() << "Image::GetVtkImageData() is not available for bricked images. Use GetRegionData() or "
+                   "ImageReadAccessor instead.";
+
   ImageDataItemPointer volume = GetVolumeData(t, n);
   return volume.GetPointer() == nullptr ? nullptr : volume->GetVtkImageAccessor(this)->GetVtkImageData();
 }
@@ -244,7 +279,7 @@ mitk::Image::ImageDataItemPointer mitk::Image::GetSliceData(
   int s, int t, int n, void *data, ImportMemoryManagementType importMemoryManagement) const
 {
   MutexHolder lock(m_ImageDataArraysLock);
-  return GetSliceData_unlocked(s, t, n, data, importMemoryManagement);
+  return SetItemOwner(GetSliceData_unlocked(s, t, n, data, importMemoryManagement));
 }
 
 mitk::Image::ImageDataItemPointer mitk::Image::GetSliceData_unlocked(
@@ -293,6 +328,19 @@ mitk::Image::ImageDataItemPointer mitk::Image::GetSliceData_unlocked(
     return m_Slices[pos] = sl;
   }
 
+  // slices of bricked images are read from the bricks each time and not kept, so the memory
+  // used for them is bounded by the brick cache of the storage
+  if (m_BrickedStorage.IsNotNull() && 0 == n)
+  {
+    itk::ImageRegion<3> region;
+    region.SetIndex(2, s);
+    region.SetSize(0, m_Dimensions[0]);
+    region.SetSize(1, m_Dimensions[1]);
+    region.SetSize(2, 1);
+    this->ReleaseBrickedChannel_unlocked();
+    return ReadBrickedData(region, t, 2);
+  }
+
   // slice is unavailable. Can we calculate it?
   if ((GetSource().IsNotNull()) && (GetSource()->Updating() == false))
   {
@@ -329,7 +377,7 @@ mitk::Image::ImageDataItemPointer mitk::Image::GetVolumeData(int t,
                                                              ImportMemoryManagementType importMemoryManagement) const
 {
   MutexHolder lock(m_ImageDataArraysLock);
-  return GetVolumeData_unlocked(t, n, data, importMemoryManagement);
+  return SetItemOwner(GetVolumeData_unlocked(t, n, data, importMemoryManagement));
 }
 mitk::Image::ImageDataItemPointer mitk::Image::GetVolumeData_unlocked(
   int t, int n, void *data, ImportMemoryManagementType importMemoryManagement) const
@@ -362,6 +410,17 @@ mitk::Image::ImageDataItemPointer mitk::Image::GetVolumeData_unlocked(
     return m_Volumes[pos] = vol;
   }
 
+  // like slices, volumes of bricked images are read from the bricks each time and not kept
+  if (m_BrickedStorage.IsNotNull() && 0 == n)
+  {
+    itk::ImageRegion<3> region;
+    region.SetSize(0, m_Dimensions[0]);
+    region.SetSize(1, m_Dimensions[1]);
+    region.SetSize(2, this->GetDimension(2));
+    this->ReleaseBrickedChannel_unlocked();
+    return ReadBrickedData(region, t, 3);
+  }
+
   // let's see if all slices of the volume are set, so that we can (could) combine them to a volume
   bool complete = true;
   unsigned int s;
@@ -406,7 +465,7 @@ mitk::Image::ImageDataItemPointer mitk::Image::GetVolumeData_unlocked(
         {
           // copy data of slices in volume
           size_t offset = ((size_t)s) * size;
-          std::memcpy(static_cast<char *>(vol->GetData()) + offset, sl->GetData(), size);
+          std::memcpy(reinterpret_cast<char *>(vol->m_Data) + offset, sl->m_Data, size);
 
           // FIXME mitkIpPicDescriptor * pic = sl->GetPicDescriptor();
 
@@ -459,7 +518,7 @@ mitk::Image::ImageDataItemPointer mitk::Image::GetChannelData(int n,
                                                               ImportMemoryManagementType importMemoryManagement) const
 {
   MutexHolder lock(m_ImageDataArraysLock);
-  return GetChannelData_unlocked(n, data, importMemoryManagement);
+  return SetItemOwner(GetChannelData_unlocked(n, data, importMemoryManagement));
 }
 
 mitk::Image::ImageDataItemPointer mitk::Image::GetChannelData_unlocked(
@@ -472,6 +531,29 @@ mitk::Image::ImageDataItemPointer mitk::Image::GetChannelData_unlocked(
   if ((ch.GetPointer() != nullptr) && (ch->IsComplete()))
     return ch;
 
+  // the channel of bricked images is read from the bricks and kept only until the bricks are
+  // written otherwise or, while it is not used, volumes or slices are read
+  if (m_BrickedStorage.IsNotNull() && 0 == n)
+  {
+    if (m_BrickedChannel.IsNotNull())
+      return m_BrickedChannel;
+
+    itk::ImageRegion<3> region;
+    region.SetSize(0, m_Dimensions[0]);
+    region.SetSize(1, m_Dimensions[1]);
+    region.SetSize(2, this->GetDimension(2));
+
+    ch = new ImageDataItem(m_ImageDescriptor, m_Dimensions[3] > 1 ? -1 : 0, nullptr, true);
+    const size_t volumeSize = m_OffsetTable[3] * this->m_ImageDescriptor->GetChannelTypeById(n).GetSize();
+    for (unsigned int t = 0; t < m_Dimensions[3]; ++t)
+    {
+      m_BrickedStorage->ReadRegion(region, t, ch->m_Data + t * volumeSize);
+    }
+    ch->m_IsBrickedCopy = true;
+    ch->SetComplete(true);
+    return m_BrickedChannel = ch;
+  }
+
   // let's see if all volumes are set, so that we can (could) combine them to a channel
   if (IsChannelSet_unlocked(n))
   {
@@ -511,7 +593,7 @@ mitk::Image::ImageDataItemPointer mitk::Image::GetChannelData_unlocked(
         {
           // copy data of volume in channel
           size_t offset = ((size_t)t) * m_OffsetTable[3] * (ptypeSize);
-          std::memcpy(static_cast<char *>(ch->GetData()) + offset, vol->GetData(), size);
+          std::memcpy(reinterpret_cast<char *>(ch->m_Data) + offset, vol->m_Data, size);
 
           // REVEIW FIX mitkIpPicDescriptor * pic = vol->GetPicDescriptor();
 
@@ -534,6 +616,10 @@ mitk::Image::ImageDataItemPointer mitk::Image::GetChannelData_unlocked(
       // REVIEW FIX
       //   if(ch->GetPicDescriptor()->info->tags_head==nullptr)
       //     mitkIpFuncCopyTags(ch->GetPicDescriptor(), m_Volumes[GetVolumeIndex(0,n)]->GetPicDescriptor());
+
+      // the volumes were copied into the channel, so shared volumes may not be referenced anymore
+      if (!m_SharedRoots.empty())
+        this->ReleaseUnusedSharedRoots_unlocked();
     }
     return m_Channels[n] = ch;
   }
@@ -596,7 +682,7 @@ bool mitk::Image::IsSliceSet_unlocked(int s, int t, int n) const
   {
     return true;
   }
-  return false;
+  return m_BrickedStorage.IsNotNull() && 0 == n;
 }
 
 bool mitk::Image::IsVolumeSet(int t, int n) const
@@ -621,6 +707,10 @@ bool mitk::Image::IsVolumeSet_unlocked(int t, int n) const
   if ((ch.GetPointer() != nullptr) && (ch->IsComplete()))
     return true;
 
+  // can it be read from the bricks?
+  if (m_BrickedStorage.IsNotNull() && 0 == n)
+    return true;
+
   // let's see if all slices of the volume are set, so that we can (could) combine them to a volume
   unsigned int s;
   for (s = 0; s < m_Dimensions[2]; ++s)
@@ -660,6 +750,82 @@ bool mitk::Image::IsChannelSet_unlocked(int n) const
   return true;
 }
 
+void mitk::Image::BeginProgressiveLoading()
+{
+  std::lock_guard<std::mutex> lock(m_ProgressiveLoadingMutex);
+  const unsigned int slices = std::max(1u, m_Dimensions[2]);
+  const unsigned int timeSteps = std::max(1u, m_Dimensions[3]);
+  m_LoadedSlices.assign(static_cast<std::size_t>(slices) * timeSteps, false);
+  m_NumberOfLoadedSlices = 0;
+  m_LoadingProgressively = true;
+}
+
+void mitk::Image::SetSliceLoaded(int s, int t)
+{
+  if (!IsValidSlice(s, t, 0))
+    return;
+
+  {
+    std::lock_guard<std::mutex> lock(m_ProgressiveLoadingMutex);
+    const std::size_t index = static_cast<std::size_t>(t) * std::max(1u, m_Dimensions[2]) + s;
+    if (index >= m_LoadedSlices.size() || m_LoadedSlices[index])
+      return;
+
+    m_LoadedSlices[index] = true;
+    ++m_NumberOfLoadedSlices;
+  }
+
+  // statistics that have been computed before the slice arrived are outdated now
+  ImageDataItemPointer volume;
+  {
+    MutexHolder lock(m_ImageDataArraysLock);
+    volume = m_Volumes[GetVolumeIndex(t, 0)];
+  }
+  if (volume.IsNotNull() && m_ImageStatistics != nullptr)
+  {
+    const std::size_t bytesPerSlice = m_OffsetTable[2] * this->GetPixelType(0).GetSize();
+    const char *slice = reinterpret_cast<const char *>(volume->m_Data) + s * bytesPerSlice;
+    m_ImageStatistics->InvalidateMemoryRange(slice, slice + bytesPerSlice);
+  }
+}
+
+void mitk::Image::EndProgressiveLoading()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_ProgressiveLoadingMutex);
+    m_LoadingProgressively = false;
+  }
+  m_ProgressiveLoadingFinished.notify_all();
+}
+
+bool mitk::Image::IsLoadingProgressively() const
+{
+  std::lock_guard<std::mutex> lock(m_ProgressiveLoadingMutex);
+  return m_LoadingProgressively;
+}
+
+bool mitk::Image::IsSliceLoaded(int s, int t) const
+{
+  std::lock_guard<std::mutex> lock(m_ProgressiveLoadingMutex);
+  if (!m_LoadingProgressively)
+    return true;
+
+  const std::size_t index = static_cast<std::size_t>(t) * std::max(1u, m_Dimensions[2]) + s;
+  return index < m_LoadedSlices.size() && m_LoadedSlices[index];
+}
+
+unsigned int mitk::Image::GetNumberOfLoadedSlices() const
+{
+  std::lock_guard<std::mutex> lock(m_ProgressiveLoadingMutex);
+  return m_NumberOfLoadedSlices;
+}
+
+void mitk::Image::WaitForProgressiveLoading() const
+{
+  std::unique_lock<std::mutex> lock(m_ProgressiveLoadingMutex);
+  m_ProgressiveLoadingFinished.wait(lock, [this] { return !m_LoadingProgressively; });
+}
+
 bool mitk::Image::SetSlice(const void *data, int s, int t, int n)
 {
   // const_cast is no risk for ImportMemoryManagementType == CopyMemory
@@ -682,6 +848,22 @@ bool mitk::Image::SetImportSlice(void *data, int s, int t, int n, ImportMemoryMa
 {
   if (IsValidSlice(s, t, n) == false)
     return false;
+
+  // pixels of bricked images are written to the bricks
+  if (m_BrickedStorage.IsNotNull() && 0 == n)
+  {
+    itk::ImageRegion<3> region;
+    region.SetIndex(2, s);
+    region.SetSize(0, m_Dimensions[0]);
+    region.SetSize(1, m_Dimensions[1]);
+    region.SetSize(2, 1);
+    return this->SetBrickedData(data, region, t, importMemoryManagement);
+  }
+
+  {
+    MutexHolder lock(m_ImageDataArraysLock);
+    this->DetachVolume_unlocked(t, n);
+  }
   ImageDataItemPointer sl;
   const size_t ptypeSize = this->m_ImageDescriptor->GetChannelTypeById(n).GetSize();
 
@@ -694,9 +876,11 @@ bool mitk::Image::SetImportSlice(void *data, int s, int t, int n, ImportMemoryMa
       if (sl.GetPointer() == nullptr)
         return false;
     }
-    if (sl->GetData() != data)
-      std::memcpy(sl->GetData(), data, m_OffsetTable[2] * (ptypeSize));
+    if (sl->m_Data != data)
+      std::memcpy(sl->m_Data, data, m_OffsetTable[2] * (ptypeSize));
     sl->Modified();
+    if (m_ImageStatistics != nullptr)
+      m_ImageStatistics->InvalidateMemoryRange(sl->m_Data, reinterpret_cast<char *>(sl->m_Data) + m_OffsetTable[2] * ptypeSize);
     // we have changed the data: call Modified()!
     Modified();
   }
@@ -705,8 +889,8 @@ bool mitk::Image::SetImportSlice(void *data, int s, int t, int n, ImportMemoryMa
     sl = AllocateSliceData(s, t, n, data, importMemoryManagement);
     if (sl.GetPointer() == nullptr)
       return false;
-    if (sl->GetData() != data)
-      std::memcpy(sl->GetData(), data, m_OffsetTable[2] * (ptypeSize));
+    if (sl->m_Data != data)
+      std::memcpy(sl->m_Data, data, m_OffsetTable[2] * (ptypeSize));
     // we just added a missing slice, which is not regarded as modification.
     // Therefore, we do not call Modified()!
   }
@@ -718,6 +902,21 @@ bool mitk::Image::SetImportVolume(void *data, int t, int n, ImportMemoryManageme
   if (IsValidVolume(t, n) == false)
     return false;
 
+  // pixels of bricked images are written to the bricks
+  if (m_BrickedStorage.IsNotNull() && 0 == n)
+  {
+    itk::ImageRegion<3> region;
+    region.SetSize(0, m_Dimensions[0]);
+    region.SetSize(1, m_Dimensions[1]);
+    region.SetSize(2, this->GetDimension(2));
+    return this->SetBrickedData(data, region, t, importMemoryManagement);
+  }
+
+  {
+    MutexHolder lock(m_ImageDataArraysLock);
+    this->DetachVolume_unlocked(t, n);
+  }
+
   const size_t ptypeSize = this->m_ImageDescriptor->GetChannelTypeById(n).GetSize();
   ImageDataItemPointer vol;
   if (IsVolumeSet(t, n))
@@ -729,9 +928,11 @@ bool mitk::Image::SetImportVolume(void *data, int t, int n, ImportMemoryManageme
       if (vol.GetPointer() == nullptr)
         return false;
     }
-    if (vol->GetData() != data)
-      std::memcpy(vol->GetData(), data, m_OffsetTable[3] * (ptypeSize));
+    if (vol->m_Data != data)
+      std::memcpy(vol->m_Data, data, m_OffsetTable[3] * (ptypeSize));
     vol->Modified();
+    if (m_ImageStatistics != nullptr)
+      m_ImageStatistics->InvalidateMemoryRange(vol->m_Data, reinterpret_cast<char *>(vol->m_Data) + m_OffsetTable[3] * ptypeSize);
     vol->SetComplete(true);
     // we have changed the data: call Modified()!
     Modified();
@@ -741,12 +942,12 @@ bool mitk::Image::SetImportVolume(void *data, int t, int n, ImportMemoryManageme
     vol = AllocateVolumeData(t, n, data, importMemoryManagement);
     if (vol.GetPointer() == nullptr)
       return false;
-    if (vol->GetData() != data)
+    if (vol->m_Data != data)
     {
-      std::memcpy(vol->GetData(), data, m_OffsetTable[3] * (ptypeSize));
+      std::memcpy(vol->m_Data, data, m_OffsetTable[3] * (ptypeSize));
     }
     vol->SetComplete(true);
-    this->m_ImageDescriptor->GetChannelDescriptor(n).SetData(vol->GetData());
+    this->m_ImageDescriptor->GetChannelDescriptor(n).SetData(vol->m_Data);
     // we just added a missing Volume, which is not regarded as modification.
     // Therefore, we do not call Modified()!
   }
@@ -763,6 +964,21 @@ bool mitk::Image::SetImportChannel(void *data, int n, ImportMemoryManagementType
   if (IsValidChannel(n) == false)
     return false;
 
+  // pixels of bricked images are written to the bricks
+  if (m_BrickedStorage.IsNotNull() && 0 == n)
+  {
+    itk::ImageRegion<3> region;
+    region.SetSize(0, m_Dimensions[0]);
+    region.SetSize(1, m_Dimensions[1]);
+    region.SetSize(2, this->GetDimension(2));
+    return this->SetBrickedData(data, region, -1, importMemoryManagement);
+  }
+
+  {
+    MutexHolder lock(m_ImageDataArraysLock);
+    this->DetachChannel_unlocked(n);
+  }
+
   // channel descriptor
 
   const size_t ptypeSize = this->m_ImageDescriptor->GetChannelTypeById(n).GetSize();
@@ -777,9 +993,11 @@ bool mitk::Image::SetImportChannel(void *data, int n, ImportMemoryManagementType
       if (ch.GetPointer() == nullptr)
         return false;
     }
-    if (ch->GetData() != data)
-      std::memcpy(ch->GetData(), data, m_OffsetTable[4] * (ptypeSize));
+    if (ch->m_Data != data)
+      std::memcpy(ch->m_Data, data, m_OffsetTable[4] * (ptypeSize));
     ch->Modified();
+    if (m_ImageStatistics != nullptr)
+      m_ImageStatistics->InvalidateMemoryRange(ch->m_Data, reinterpret_cast<char *>(ch->m_Data) + m_OffsetTable[4] * ptypeSize);
     ch->SetComplete(true);
     // we have changed the data: call Modified()!
     Modified();
@@ -789,17 +1007,626 @@ bool mitk::Image::SetImportChannel(void *data, int n, ImportMemoryManagementType
     ch = AllocateChannelData(n, data, importMemoryManagement);
     if (ch.GetPointer() == nullptr)
       return false;
-    if (ch->GetData() != data)
-      std::memcpy(ch->GetData(), data, m_OffsetTable[4] * (ptypeSize));
+    if (ch->m_Data != data)
+      std::memcpy(ch->m_Data, data, m_OffsetTable[4] * (ptypeSize));
     ch->SetComplete(true);
 
-    this->m_ImageDescriptor->GetChannelDescriptor(n).SetData(ch->GetData());
+    this->m_ImageDescriptor->GetChannelDescriptor(n).SetData(ch->m_Data);
     // we just added a missing Channel, which is not regarded as modification.
     // Therefore, we do not call Modified()!
   }
   return true;
 }
 
+bool mitk::Image::SetMappedChannel(MemoryMappedFile *file, int n)
+{
+  if (nullptr == file || IsValidChannel(n) == false)
+    return false;
+
+  const size_t ptypeSize = this->m_ImageDescriptor->GetChannelTypeById(n).GetSize();
+  if (file->GetSize() < m_OffsetTable[4] * ptypeSize)
+    return false;
+
+  if (!this->SetImportChannel(file->GetData(), n, ReferenceMemory))
+    return false;
+
+  // a channel that was already set and manages its memory got a copy of the data
+  MutexHolder lock(m_ImageDataArraysLock);
+  if (m_Channels[n].IsNotNull() && m_Channels[n]->m_Data == file->GetData())
+    m_Channels[n]->m_MemoryMappedFile = file;
+
+  return true;
+}
+
+bool mitk::Image::SetBrickedStorage(BrickedImageStorage *storage)
+{
+  if (nullptr == storage || !this->IsInitialized() || this->GetNumberOfChannels() != 1 || m_Dimension > 4 ||
+      storage->GetPixelType() != this->GetPixelType(0))
+    return false;
+
+  for (unsigned int i = 0; i < 4; ++i)
+  {
+    if (storage->GetDimensions()[i] != this->GetDimension(i))
+      return false;
+  }
+
+  {
+    MutexHolder lock(m_ImageDataArraysLock);
+    std::fill(m_Slices.begin(), m_Slices.end(), nullptr);
+    std::fill(m_Volumes.begin(), m_Volumes.end(), nullptr);
+    std::fill(m_Channels.begin(), m_Channels.end(), nullptr);
+    m_CompleteData = nullptr;
+    m_BrickedStorage = storage;
+    m_BrickedChannel = nullptr;
+  }
+
+  this->Modified();
+  return true;
+}
+
+mitk::BrickedImageStorage *mitk::Image::GetBrickedStorage() const
+{
+  return m_BrickedStorage;
+}
+
+bool mitk::Image::SetSharedVolume(const Image *source, int sourceT, int sourceN, int t, int n)
+{
+  if (nullptr == source || !source->IsValidVolume(sourceT, sourceN) || !this->IsValidVolume(t, n) ||
+      source->GetPixelType(sourceN) != this->GetPixelType(n))
+    return false;
+
+  for (int i = 0; i < 3; ++i)
+  {
+    if (source->GetDimension(i) != this->GetDimension(i))
+      return false;
+  }
+
+  if (source == this && sourceT == t && sourceN == n)
+    return true;
+
+  ImageDataItemPointer volume = source->GetVolumeData(sourceT, sourceN);
+  if (volume.IsNull())
+    return false;
+
+  // volumes read from the bricks are temporary copies, while bricked images write the pixels to their bricks
+  if (volume->m_IsBrickedCopy || (m_BrickedStorage.IsNotNull() && 0 == n))
+    return this->SetImportVolume(volume->m_Data, t, n, CopyMemory);
+
+  const ImageDataItem *root = GetRootItem(volume);
+  if (!root->GetManageMemory() && !root->IsMemoryMapped())
+  {
+    // the memory belongs to someone else, who may change or free it at any time
+    return this->SetImportVolume(volume->m_Data, t, n, CopyMemory);
+  }
+
+  if (source->IsBeingWritten())
+  {
+    // the writers would change the shared memory behind the back of this image
+    try
+    {
+      ImageReadAccessor access(source, volume, ImageAccessorBase::ExceptionIfLocked);
+      return this->SetImportVolume(const_cast<void *>(access.GetData()), t, n, CopyMemory);
+    }
+    catch (const MemoryIsLockedException &)
+    {
+      // waiting could dead-lock, if the writer belongs to the calling thread
+      ImageReadAccessor access(source, volume, ImageAccessorBase::IgnoreLock);
+      return this->SetImportVolume(const_cast<void *>(access.GetData()), t, n, CopyMemory);
+    }
+  }
+
+  std::shared_ptr<void> token;
+  {
+    std::lock_guard<std::mutex> lock(CopyOnWriteMutex);
+    token = root->m_CopyOnWriteToken.lock();
+    if (!token)
+    {
+      token = std::make_shared<char>(0);
+      root->m_CopyOnWriteToken = token;
+    }
+  }
+
+  {
+    MutexHolder lock(source->m_ImageDataArraysLock);
+    source->AddSharedRoot_unlocked(root, token);
+  }
+
+  bool modified = false;
+  {
+    MutexHolder lock(m_ImageDataArraysLock);
+    modified = this->IsVolumeSet_unlocked(t, n);
+
+    ImageDataItemPointer sharedVolume = new ImageDataItem(*volume, m_ImageDescriptor, t, 3, nullptr, false, 0);
+    sharedVolume->SetComplete(true);
+    m_Volumes[this->GetVolumeIndex(t, n)] = sharedVolume;
+
+    // get rid of slices and channel - they may point to the old volume
+    for (unsigned int s = 0; s < m_Dimensions[2]; ++s)
+      m_Slices[this->GetSliceIndex(s, t, n)] = nullptr;
+    m_Channels[n] = nullptr;
+    m_CompleteData = nullptr;
+
+    if (0 == t)
+      m_ImageDescriptor->GetChannelDescriptor(n).SetData(sharedVolume->m_Data);
+
+    this->AddSharedRoot_unlocked(root, token);
+    this->ReleaseUnusedSharedRoots_unlocked();
+  }
+
+  // like SetImportVolume(), replacing a volume is a modification, adding a missing one is not
+  if (modified)
+    this->Modified();
+  return true;
+}
+
+bool mitk::Image::IsVolumeShared(int t, int n) const
+{
+  if (!this->IsValidVolume(t, n))
+    return false;
+
+  MutexHolder lock(m_ImageDataArraysLock);
+  const ImageDataItem *item = m_Volumes[this->GetVolumeIndex(t, n)];
+  if (nullptr == item)
+    item = m_Channels[n];
+
+  return nullptr != item && this->IsSharedRoot_unlocked(GetRootItem(item));
+}
+
+const mitk::ImageDataItem *mitk::Image::PrepareWriteAccess(const ImageDataItem *item)
+{
+  if (!m_ReferencedVolumes.empty())
+    this->DetachReferencedVolumes();
+
+  MutexHolder lock(m_ImageDataArraysLock);
+  if (m_SharedRoots.empty() && m_DetachedRoots.empty())
+    return item;
+
+  if (nullptr == item)
+  {
+    // whole image access (see ImageAccessorBase) uses the channel, which is copied if necessary
+    this->DetachChannel_unlocked(0);
+    return nullptr;
+  }
+
+  // only items of shared or detached roots need to be looked up, all others are written as they are
+  const ImageDataItem *root = GetRootItem(item);
+  if (!this->IsDetachedRoot_unlocked(root) && !this->IsSharedRoot_unlocked(root))
+    return item;
+
+  enum
+  {
+    Unknown,
+    Slice,
+    Volume,
+    Channel
+  } kind = Unknown;
+  int s = 0, t = 0, n = 0;
+
+  for (int channel = 0; Unknown == kind && channel < static_cast<int>(this->GetNumberOfChannels()); ++channel)
+  {
+    if (m_Channels[channel] == item)
+    {
+      kind = Channel;
+      n = channel;
+    }
+    for (int timeStep = 0; Unknown == kind && timeStep < static_cast<int>(m_Dimensions[3]); ++timeStep)
+    {
+      if (m_Volumes[this->GetVolumeIndex(timeStep, channel)] == item)
+      {
+        kind = Volume;
+        t = timeStep;
+        n = channel;
+      }
+      for (int slice = 0; Unknown == kind && slice < static_cast<int>(m_Dimensions[2]); ++slice)
+      {
+        if (m_Slices[this->GetSliceIndex(slice, timeStep, channel)] == item)
+        {
+          kind = Slice;
+          s = slice;
+          t = timeStep;
+          n = channel;
+        }
+      }
+    }
+  }
+
+  if (Unknown == kind)
+  {
+    // an outdated item, e.g. requested before the memory was shared or copied
+    const size_t ptypeSize = this->m_ImageDescriptor->GetChannelTypeById(0).GetSize();
+    const size_t sliceSize = m_OffsetTable[2] * ptypeSize;
+    const size_t volumeSize = m_OffsetTable[3] * ptypeSize;
+
+    n = 0;
+    t = std::max(item->m_Timestep, 0);
+    if (item->m_Timestep < 0 || item->GetSize() > volumeSize)
+    {
+      kind = Channel;
+    }
+    else if (item->GetSize() < volumeSize && item->GetSize() == sliceSize)
+    {
+      size_t offset = item->GetOffset();
+      if (item->GetParent().IsNotNull() && item->GetParent()->m_Timestep < 0)
+        offset -= t * volumeSize;
+      s = static_cast<int>(offset / sliceSize);
+      kind = Slice;
+    }
+    else
+    {
+      kind = Volume;
+    }
+
+    if ((Slice == kind && !this->IsValidSlice(s, t, n)) || (Volume == kind && !this->IsValidVolume(t, n)))
+      return item;
+  }
+
+  switch (kind)
+  {
+    case Slice:
+      this->DetachVolume_unlocked(t, n);
+      return this->GetSliceData_unlocked(s, t, n, nullptr, CopyMemory).GetPointer();
+    case Volume:
+      this->DetachVolume_unlocked(t, n);
+      return this->GetVolumeData_unlocked(t, n, nullptr, CopyMemory).GetPointer();
+    default:
+      this->DetachChannel_unlocked(n);
+      return this->GetChannelData_unlocked(n, nullptr, CopyMemory).GetPointer();
+  }
+}
+
+bool mitk::Image::IsBeingWritten() const
+{
+  m_ReadWriteLock.Lock();
+  const bool hasWriters = !m_Writers.empty();
+  m_ReadWriteLock.Unlock();
+  if (hasWriters)
+    return true;
+
+  MutexHolder lock(m_ImageDataArraysLock);
+  for (const auto *items : {&m_Channels, &m_Volumes, &m_Slices})
+  {
+    for (const auto &item : *items)
+    {
+      if (item.IsNotNull() && nullptr != item->m_VtkImageWriteAccessor)
+        return true;
+    }
+  }
+  return false;
+}
+
+void mitk::Image::DetachReferencedVolumes()
+{
+  std::vector<ReferencedVolume> referencedVolumes;
+  {
+    MutexHolder lock(m_ImageDataArraysLock);
+    referencedVolumes = m_ReferencedVolumes;
+  }
+
+  for (const auto &referenced : referencedVolumes)
+  {
+    std::shared_ptr<Image *> owner = referenced.Source.lock();
+    if (!owner || nullptr == *owner || !(*owner)->IsVolumeShared(referenced.SourceT, referenced.SourceN))
+      continue;
+
+    Image *source = *owner;
+    ImageDataItemPointer sourceVolume = source->GetVolumeData(referenced.SourceT, referenced.SourceN);
+    const ImageDataItem *sharedRoot = GetRootItem(sourceVolume);
+    {
+      // the volume may have been replaced since it was referenced
+      MutexHolder lock(m_ImageDataArraysLock);
+      const ImageDataItem *volume = m_Volumes[this->GetVolumeIndex(referenced.T, referenced.N)];
+      if (nullptr == volume || GetRootItem(volume) != sharedRoot)
+        continue;
+    }
+
+    // the source copies its volume, writing to this image still writes to the source
+    const ImageDataItem *detachedVolume = source->PrepareWriteAccess(sourceVolume);
+
+    MutexHolder lock(m_ImageDataArraysLock);
+    ImageDataItemPointer volume =
+      new ImageDataItem(*detachedVolume, m_ImageDescriptor, referenced.T, 3, nullptr, false, 0);
+    volume->SetComplete(true);
+    m_Volumes[this->GetVolumeIndex(referenced.T, referenced.N)] = volume;
+
+    // get rid of slices and channel - they may point to the shared volume
+    for (unsigned int s = 0; s < m_Dimensions[2]; ++s)
+      m_Slices[this->GetSliceIndex(s, referenced.T, referenced.N)] = nullptr;
+    if (m_Channels[referenced.N].IsNotNull() && GetRootItem(m_Channels[referenced.N]) == sharedRoot)
+      m_Channels[referenced.N] = nullptr;
+    m_CompleteData = nullptr;
+
+    if (0 == referenced.T)
+      m_ImageDescriptor->GetChannelDescriptor(referenced.N).SetData(volume->m_Data);
+
+    // outdated items of the shared volume are redirected to the copy
+    this->AddDetachedRoot_unlocked(sharedRoot);
+  }
+}
+
+mitk::Image::ImageDataItemPointer mitk::Image::SetItemOwner(const ImageDataItemPointer &item) const
+{
+  // items of other images (e.g. referenced by an ImageSliceSelector) keep their owner
+  if (item.IsNotNull() && item->m_Owner.expired())
+    item->m_Owner = m_CopyOnWriteOwner;
+  return item;
+}
+
+void mitk::Image::DetachVolume_unlocked(int t, int n)
+{
+  if (m_SharedRoots.empty() || !this->IsVolumeSet_unlocked(t, n))
+    return;
+
+  ImageDataItemPointer volume = this->GetVolumeData_unlocked(t, n, nullptr, CopyMemory);
+  if (volume.IsNull())
+    return;
+
+  const ImageDataItem *root = GetRootItem(volume);
+  if (!this->IsSharedRoot_unlocked(root))
+    return;
+
+  ImageDataItemPointer copy =
+    new ImageDataItem(this->m_ImageDescriptor->GetChannelTypeById(n), t, 3, m_Dimensions, nullptr, true);
+  std::memcpy(copy->m_Data, volume->m_Data, std::min(copy->GetSize(), volume->GetSize()));
+  copy->SetComplete(true);
+  m_Volumes[this->GetVolumeIndex(t, n)] = copy;
+
+  // get rid of slices - they may point to the shared volume
+  for (unsigned int s = 0; s < m_Dimensions[2]; ++s)
+    m_Slices[this->GetSliceIndex(s, t, n)] = nullptr;
+  if (m_Channels[n].IsNotNull() && GetRootItem(m_Channels[n]) == root)
+    m_Channels[n] = nullptr;
+  m_CompleteData = nullptr;
+
+  if (0 == t)
+    m_ImageDescriptor->GetChannelDescriptor(n).SetData(copy->m_Data);
+
+  this->ReleaseUnusedSharedRoots_unlocked();
+}
+
+void mitk::Image::DetachChannel_unlocked(int n)
+{
+  if (m_SharedRoots.empty() || !this->IsChannelSet_unlocked(n))
+    return;
+
+  // combining the volumes of several time steps copies them anyway
+  ImageDataItemPointer channel = this->GetChannelData_unlocked(n, nullptr, CopyMemory);
+  if (channel.IsNull() || !this->IsSharedRoot_unlocked(GetRootItem(channel)))
+    return;
+
+  ImageDataItemPointer copy = new ImageDataItem(this->m_ImageDescriptor, -1, nullptr, true);
+  std::memcpy(copy->m_Data, channel->m_Data, std::min(copy->GetSize(), channel->GetSize()));
+  copy->SetComplete(true);
+  m_Channels[n] = copy;
+
+  // get rid of volumes and slices - they may point to the shared channel
+  for (unsigned int t = 0; t < m_Dimensions[3]; ++t)
+  {
+    m_Volumes[this->GetVolumeIndex(t, n)] = nullptr;
+    for (unsigned int s = 0; s < m_Dimensions[2]; ++s)
+      m_Slices[this->GetSliceIndex(s, t, n)] = nullptr;
+  }
+  m_CompleteData = nullptr;
+
+  m_ImageDescriptor->GetChannelDescriptor(n).SetData(copy->m_Data);
+
+  this->ReleaseUnusedSharedRoots_unlocked();
+}
+
+void mitk::Image::AddSharedRoot_unlocked(const ImageDataItem *root, const std::shared_ptr<void> &token) const
+{
+  m_DetachedRoots.erase(std::remove_if(m_DetachedRoots.begin(),
+                                      m_DetachedRoots.end(),
+                                      [root](const auto &entry) { return entry.first == root; }),
+                        m_DetachedRoots.end());
+
+  for (const auto &entry : m_SharedRoots)
+  {
+    if (entry.first == root)
+      return;
+  }
+  m_SharedRoots.emplace_back(root, token);
+}
+
+bool mitk::Image::IsSharedRoot_unlocked(const ImageDataItem *root) const
+{
+  for (const auto &entry : m_SharedRoots)
+  {
+    if (entry.first == root)
+      return entry.second.use_count() > 1;
+  }
+  return false;
+}
+
+void mitk::Image::AddDetachedRoot_unlocked(const ImageDataItem *root) const
+{
+  std::weak_ptr<void> lifetime;
+  {
+    std::lock_guard<std::mutex> lock(CopyOnWriteMutex);
+    if (!root->m_LifetimeToken)
+      root->m_LifetimeToken = std::make_shared<char>(0);
+    lifetime = root->m_LifetimeToken;
+  }
+
+  if (!this->IsDetachedRoot_unlocked(root))
+    m_DetachedRoots.emplace_back(root, lifetime);
+}
+
+bool mitk::Image::IsDetachedRoot_unlocked(const ImageDataItem *root) const
+{
+  m_DetachedRoots.erase(std::remove_if(m_DetachedRoots.begin(),
+                                      m_DetachedRoots.end(),
+                                      [](const auto &entry) { return entry.second.expired(); }),
+                        m_DetachedRoots.end());
+
+  for (const auto &entry : m_DetachedRoots)
+  {
+    if (entry.first == root)
+      return true;
+  }
+  return false;
+}
+
+void mitk::Image::ReleaseUnusedSharedRoots_unlocked() const
+{
+  std::vector<const ImageDataItem *> roots;
+  for (const auto *items : {&m_Channels, &m_Volumes, &m_Slices})
+  {
+    for (const auto &item : *items)
+    {
+      if (item.IsNotNull())
+        roots.push_back(GetRootItem(item));
+    }
+  }
+
+  for (auto iter = m_SharedRoots.begin(); iter != m_SharedRoots.end();)
+  {
+    if (roots.end() == std::find(roots.begin(), roots.end(), iter->first.GetPointer()))
+    {
+      this->AddDetachedRoot_unlocked(iter->first);
+      iter = m_SharedRoots.erase(iter);
+    }
+    else
+    {
+      ++iter;
+    }
+  }
+}
+
+mitk::Image::ImageDataItemPointer mitk::Image::GetRegionData(const itk::ImageRegion<3> &region,
+                                                             int t,
+                                                             int n,
+                                                             void *data) const
+{
+  if (IsValidVolume(t, n) == false)
+    return nullptr;
+
+  itk::ImageRegion<3> largestRegion;
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    largestRegion.SetSize(i, this->GetDimension(i));
+  }
+  if (!largestRegion.IsInside(region))
+    return nullptr;
+
+  MutexHolder lock(m_ImageDataArraysLock);
+
+  ImageDataItemPointer vol = m_Volumes[GetVolumeIndex(t, n)];
+  const bool isInMemory = (vol.IsNotNull() && vol->IsComplete()) ||
+                          (m_Channels[n].IsNotNull() && m_Channels[n]->IsComplete());
+  if (m_BrickedStorage.IsNotNull() && 0 == n && !isInMemory)
+  {
+    this->ReleaseBrickedChannel_unlocked();
+    return ReadBrickedData(region, t, 3, data);
+  }
+
+  vol = GetVolumeData_unlocked(t, n, nullptr, CopyMemory);
+  if (vol.IsNull())
+    return nullptr;
+
+  unsigned int dimensions[3];
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    dimensions[i] = static_cast<unsigned int>(region.GetSize(i));
+  }
+  ImageDataItemPointer item = new ImageDataItem(this->GetPixelType(n), t, 3, dimensions, data, false);
+
+  const size_t ptypeSize = this->m_ImageDescriptor->GetChannelTypeById(n).GetSize();
+  const size_t rowSize = dimensions[0] * ptypeSize;
+  const auto *source = reinterpret_cast<const char *>(vol->m_Data);
+  auto *target = reinterpret_cast<char *>(item->m_Data);
+  for (unsigned int z = 0; z < dimensions[2]; ++z)
+  {
+    for (unsigned int y = 0; y < dimensions[1]; ++y, target += rowSize)
+    {
+      const size_t offset = (region.GetIndex(2) + z) * m_OffsetTable[2] + (region.GetIndex(1) + y) * m_OffsetTable[1] +
+                            region.GetIndex(0);
+      std::memcpy(target, source + offset * ptypeSize, rowSize);
+    }
+  }
+
+  item->SetComplete(true);
+  return item;
+}
+
+void mitk::Image::ReleaseBrickedChannel_unlocked() const
+{
+  if (m_BrickedChannel.IsNotNull() && 1 == m_BrickedChannel->GetReferenceCount())
+    m_BrickedChannel = nullptr;
+}
+
+mitk::Image::ImageDataItemPointer mitk::Image::ReadBrickedData(const itk::ImageRegion<3> &region,
+                                                               int t,
+                                                               unsigned int dimension,
+                                                               void *data) const
+{
+  unsigned int dimensions[3];
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    dimensions[i] = static_cast<unsigned int>(region.GetSize(i));
+  }
+
+  ImageDataItemPointer item = new ImageDataItem(this->GetPixelType(0), t, dimension, dimensions, data, false);
+  m_BrickedStorage->ReadRegion(region, t, item->m_Data);
+  item->m_IsBrickedCopy = true;
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    item->m_BrickedIndex[i] = region.GetIndex(i);
+  }
+  item->SetComplete(true);
+  return item;
+}
+
+bool mitk::Image::SetBrickedData(void *data,
+                                 const itk::ImageRegion<3> &region,
+                                 int t,
+                                 ImportMemoryManagementType importMemoryManagement)
+{
+  // the bricks cannot reference the data, so it is always copied
+  std::unique_ptr<unsigned char[]> managedData(
+    importMemoryManagement == ManageMemory ? static_cast<unsigned char *>(data) : nullptr);
+
+  this->WriteBrickedData(region, t, data);
+  // the pixels are replaced: call Modified()!
+  this->Modified();
+  return true;
+}
+
+void mitk::Image::WriteBrickedData(const ImageDataItem *item)
+{
+  if (nullptr == item || !item->m_IsBrickedCopy)
+    return;
+
+  itk::ImageRegion<3> region;
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    region.SetIndex(i, item->m_BrickedIndex[i]);
+    region.SetSize(i, i < item->m_Dimension ? item->m_Dimensions[i] : 1);
+  }
+  this->WriteBrickedData(region, item->m_Timestep, item->m_Data);
+}
+
+void mitk::Image::WriteBrickedData(const itk::ImageRegion<3> &region, int t, const void *data)
+{
+  if (m_BrickedStorage.IsNull())
+    return;
+
+  {
+    // the kept channel would still show the old pixels, unless they have been written to it
+    MutexHolder lock(m_ImageDataArraysLock);
+    if (m_BrickedChannel.IsNotNull() && m_BrickedChannel->m_Data != data)
+      m_BrickedChannel = nullptr;
+  }
+
+  const size_t volumeSize = region.GetNumberOfPixels() * this->GetPixelType(0).GetSize();
+  const unsigned int firstTimeStep = t < 0 ? 0 : t;
+  const unsigned int endTimeStep = t < 0 ? m_Dimensions[3] : firstTimeStep + 1;
+  for (unsigned int timeStep = firstTimeStep; timeStep < endTimeStep; ++timeStep)
+  {
+    m_BrickedStorage->WriteRegion(
+      region, timeStep, static_cast<const char *>(data) + (timeStep - firstTimeStep) * volumeSize);
+  }
+}
+
 void mitk::Image::Initialize()
 {
   ImageDataItemPointerArray::iterator it, end;
@@ -816,6 +1643,11 @@ void mitk::Image::Initialize()
     (*it) = nullptr;
   }
   m_CompleteData = nullptr;
+  m_BrickedStorage = nullptr;
+  m_BrickedChannel = nullptr;
+  m_SharedRoots.clear();
+  m_DetachedRoots.clear();
+  m_ReferencedVolumes.clear();
 
   if (m_ImageStatistics == nullptr)
   {
@@ -1268,7 +2100,7 @@ mitk::Image::ImageDataItemPointer mitk::Image::AllocateVolumeData_unlocked(
   {
     vol = new ImageDataItem(chPixelType, t, 3, m_Dimensions, nullptr, true);
     if (data != nullptr)
-      std::memcpy(vol->GetData(), data, m_OffsetTable[3] * (ptypeSize));
+      std::memcpy(vol->m_Data, data, m_OffsetTable[3] * (ptypeSize));
   }
   else
   {
@@ -1296,7 +2128,7 @@ mitk::Image::ImageDataItemPointer mitk::Image::AllocateChannelData_unlocked(
 
     ch = new ImageDataItem(this->m_ImageDescriptor, -1, nullptr, true);
     if (data != nullptr)
-      std::memcpy(ch->GetData(), data, m_OffsetTable[4] * (ptypeSize));
+      std::memcpy(ch->m_Data, data, m_OffsetTable[4] * (ptypeSize));
   }
   else
   {
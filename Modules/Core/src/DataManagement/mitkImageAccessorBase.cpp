@@ -90,8 +90,9 @@ mitk::ImageAccessorBase::ImageAccessorBase(ImageConstPointer image,
 
     // Organize first image channel
     image->m_ReadWriteLock.Lock();
-    imageDataItem = image->GetChannelData();
+    m_DataItem = image->GetChannelData();
     image->m_ReadWriteLock.Unlock();
+    imageDataItem = m_DataItem;
 
     // Set memory area
     m_AddressBegin = imageDataItem->m_Data;
@@ -102,6 +103,7 @@ mitk::ImageAccessorBase::ImageAccessorBase(ImageConstPointer image,
   if (imageDataItem && m_SubRegion == nullptr)
   {
     m_CoherentMemory = true;
+    m_DataItem = imageDataItem;
 
     // Set memory area
     m_AddressBegin = imageDataItem->m_Data;
@@ -11,6 +11,7 @@ found in the LICENSE file.
 ============================================================================*/
 
 #include "mitkImageDataItem.h"
+#include "mitkImageMemoryPool.h"
 #include "mitkMemoryUtilities.h"
 #include <vtkImageData.h>
 #include <vtkPointData.h>
@@ -48,6 +49,7 @@ mitk::ImageDataItem::ImageDataItem(const ImageDataItem &aParent,
     m_IsComplete(false),
     m_Size(0),
     m_Parent(&aParent),
+    m_Pooled(false),
     m_Dimension(dimension),
     m_Timestep(timestep)
 {
@@ -90,7 +92,12 @@ mitk::ImageDataItem::~ImageDataItem()
   if (m_Parent.IsNull())
   {
     if (m_ManageMemory)
-      delete[] m_Data;
+    {
+      if (m_Pooled)
+        mitk::ImageMemoryPool::GetInstance().Release(m_Data, m_Size);
+      else
+        delete[] m_Data;
+    }
   }
   delete m_PixelType;
 }
@@ -108,6 +115,7 @@ mitk::ImageDataItem::ImageDataItem(const mitk::ImageDescriptor::Pointer desc,
     m_Offset(0),
     m_IsComplete(false),
     m_Size(0),
+    m_Pooled(false),
     m_Dimension(desc->GetNumberOfDimensions()),
     m_Timestep(timestep)
 {
@@ -122,8 +130,7 @@ mitk::ImageDataItem::ImageDataItem(const mitk::ImageDescriptor::Pointer desc,
 
   if (m_Data == nullptr)
   {
-    m_Data = mitk::MemoryUtilities::AllocateElements<unsigned char>(m_Size);
-    m_ManageMemory = true;
+    this->AllocateData();
   }
 
   m_ReferenceCount = 0;
@@ -145,6 +152,7 @@ mitk::ImageDataItem::ImageDataItem(const mitk::PixelType &type,
     m_IsComplete(false),
     m_Size(0),
     m_Parent(nullptr),
+    m_Pooled(false),
     m_Dimension(dimension),
     m_Timestep(timestep)
 {
@@ -157,8 +165,7 @@ mitk::ImageDataItem::ImageDataItem(const mitk::PixelType &type,
 
   if (m_Data == nullptr)
   {
-    m_Data = mitk::MemoryUtilities::AllocateElements<unsigned char>(m_Size);
-    m_ManageMemory = true;
+    this->AllocateData();
   }
 
   m_ReferenceCount = 0;
@@ -176,6 +183,8 @@ mitk::ImageDataItem::ImageDataItem(const ImageDataItem &other)
     m_IsComplete(other.m_IsComplete),
     m_Size(other.m_Size),
     m_Parent(other.m_Parent),
+    m_MemoryMappedFile(other.m_MemoryMappedFile),
+    m_Pooled(other.m_Pooled),
     m_Dimension(other.m_Dimension),
     m_Timestep(other.m_Timestep)
 {
@@ -184,6 +193,28 @@ mitk::ImageDataItem::ImageDataItem(const ImageDataItem &other)
     m_Dimensions[i] = other.m_Dimensions[i];
 }
 
+void *mitk::ImageDataItem::GetData() const
+{
+  // the caller may write to the memory, so memory shared with other images is copied first
+  std::shared_ptr<Image *> owner = m_Owner.lock();
+  if (owner && nullptr != *owner)
+  {
+    const ImageDataItem *item = (*owner)->PrepareWriteAccess(this);
+    if (nullptr != item)
+      return item->m_Data;
+  }
+  return m_Data;
+}
+
+void mitk::ImageDataItem::AllocateData()
+{
+  auto &pool = mitk::ImageMemoryPool::GetInstance();
+  m_Pooled = pool.IsPooled(m_Size);
+  m_Data = m_Pooled ? static_cast<unsigned char *>(pool.Allocate(m_Size))
+                    : mitk::MemoryUtilities::AllocateElements<unsigned char>(m_Size);
+  m_ManageMemory = true;
+}
+
 itk::LightObject::Pointer mitk::ImageDataItem::InternalClone() const
 {
   Self::Pointer newGeometry = new Self(*this);
@@ -0,0 +1,239 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkImageMemoryPool.h"
+
+#include <itkMacro.h>
+
+#include <algorithm>
+#include <iterator>
+#include <new>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+namespace
+{
+  const std::size_t MinimumSizeClass = 4096;
+
+  /** Blocks of at least this size are mapped directly on Linux, so they may be backed by huge pages.*/
+  const std::size_t HugePageSize = 2 * 1024 * 1024;
+}
+
+mitk::ImageMemoryPool &mitk::ImageMemoryPool::GetInstance()
+{
+  // never destroyed, as static images may release their memory after the destruction of static objects
+  static auto *instance = new ImageMemoryPool;
+  return *instance;
+}
+
+std::size_t mitk::ImageMemoryPool::GetSizeClass(std::size_t size)
+{
+  if (size <= MinimumSizeClass)
+    return MinimumSizeClass;
+
+  // four steps between consecutive powers of two
+  std::size_t powerOfTwo = MinimumSizeClass;
+  while (powerOfTwo < (size - 1) / 2 + 1)
+    powerOfTwo *= 2;
+
+  const std::size_t step = powerOfTwo / 4;
+  return (size + step - 1) / step * step;
+}
+
+mitk::ImageMemoryPool::ImageMemoryPool()
+  : m_Enabled(true),
+    m_MaximumBlockSize(64 * 1024 * 1024),
+    m_Capacity(256 * 1024 * 1024),
+    m_UseHugePages(false),
+    m_Statistics()
+{
+}
+
+mitk::ImageMemoryPool::~ImageMemoryPool()
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  this->TrimUnlocked(0);
+}
+
+void *mitk::ImageMemoryPool::Allocate(std::size_t size)
+{
+  const std::size_t sizeClass = GetSizeClass(size);
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    ++m_Statistics.NumberOfAllocations;
+    m_Statistics.BytesInUse += sizeClass;
+    m_Statistics.PeakBytesInUse = std::max(m_Statistics.PeakBytesInUse, m_Statistics.BytesInUse);
+
+    auto freeBlocks = m_FreeBlocks.find(sizeClass);
+    if (freeBlocks != m_FreeBlocks.end() && !freeBlocks->second.empty())
+    {
+      void *data = freeBlocks->second.back();
+      freeBlocks->second.pop_back();
+      m_Statistics.BytesCached -= sizeClass;
+      ++m_Statistics.NumberOfReuses;
+      return data;
+    }
+  }
+
+  // allocate outside of the lock, as mapping fresh memory may take a while
+  void *data = this->AllocateBlock(sizeClass);
+  if (nullptr == data)
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Statistics.BytesInUse -= sizeClass;
+    throw itk::MemoryAllocationError(__FILE__, __LINE__, "Failed to allocate memory.", ITK_LOCATION);
+  }
+  return data;
+}
+
+void mitk::ImageMemoryPool::Release(void *data, std::size_t size)
+{
+  if (nullptr == data)
+    return;
+
+  const std::size_t sizeClass = GetSizeClass(size);
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    ++m_Statistics.NumberOfReleases;
+    m_Statistics.BytesInUse -= sizeClass;
+
+    if (m_Enabled && sizeClass <= GetSizeClass(m_MaximumBlockSize) &&
+        m_Statistics.BytesCached + sizeClass <= m_Capacity)
+    {
+      m_FreeBlocks[sizeClass].push_back(data);
+      m_Statistics.BytesCached += sizeClass;
+      return;
+    }
+  }
+
+  FreeBlock(data, sizeClass);
+}
+
+bool mitk::ImageMemoryPool::IsPooled(std::size_t size) const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_Enabled && size <= m_MaximumBlockSize;
+}
+
+void mitk::ImageMemoryPool::SetEnabled(bool enabled)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_Enabled = enabled;
+  if (!enabled)
+    this->TrimUnlocked(0);
+}
+
+bool mitk::ImageMemoryPool::GetEnabled() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_Enabled;
+}
+
+void mitk::ImageMemoryPool::SetMaximumBlockSize(std::size_t bytes)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_MaximumBlockSize = bytes;
+}
+
+std::size_t mitk::ImageMemoryPool::GetMaximumBlockSize() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_MaximumBlockSize;
+}
+
+void mitk::ImageMemoryPool::SetCapacity(std::size_t bytes)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_Capacity = bytes;
+  this->TrimUnlocked(bytes);
+}
+
+std::size_t mitk::ImageMemoryPool::GetCapacity() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_Capacity;
+}
+
+void mitk::ImageMemoryPool::SetUseHugePages(bool useHugePages)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_UseHugePages = useHugePages;
+}
+
+bool mitk::ImageMemoryPool::GetUseHugePages() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_UseHugePages;
+}
+
+mitk::ImageMemoryPool::Statistics mitk::ImageMemoryPool::GetStatistics() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_Statistics;
+}
+
+void mitk::ImageMemoryPool::Trim()
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  this->TrimUnlocked(0);
+}
+
+void mitk::ImageMemoryPool::TrimUnlocked(std::size_t capacity)
+{
+  for (auto iter = m_FreeBlocks.begin(); iter != m_FreeBlocks.end() && m_Statistics.BytesCached > capacity;)
+  {
+    auto &blocks = iter->second;
+    while (!blocks.empty() && m_Statistics.BytesCached > capacity)
+    {
+      FreeBlock(blocks.back(), iter->first);
+      blocks.pop_back();
+      m_Statistics.BytesCached -= iter->first;
+    }
+
+    iter = blocks.empty() ? m_FreeBlocks.erase(iter) : std::next(iter);
+  }
+}
+
+void *mitk::ImageMemoryPool::AllocateBlock(std::size_t sizeClass) const
+{
+#ifdef __linux__
+  if (sizeClass >= HugePageSize)
+  {
+    void *data = mmap(nullptr, sizeClass, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (MAP_FAILED == data)
+      return nullptr;
+
+#ifdef MADV_HUGEPAGE
+    if (this->GetUseHugePages())
+      madvise(data, sizeClass, MADV_HUGEPAGE);
+#endif
+    return data;
+  }
+#endif
+
+  return new (std::nothrow) unsigned char[sizeClass];
+}
+
+void mitk::ImageMemoryPool::FreeBlock(void *data, std::size_t sizeClass)
+{
+#ifdef __linux__
+  if (sizeClass >= HugePageSize)
+  {
+    munmap(data, sizeClass);
+    return;
+  }
+#endif
+
+  delete[] static_cast<unsigned char *>(data);
+}
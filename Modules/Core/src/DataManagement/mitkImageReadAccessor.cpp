@@ -54,6 +54,61 @@ mitk::ImageReadAccessor::ImageReadAccessor(const mitk::Image *image, const Image
   OrganizeReadAccess();
 }
 
+mitk::ImageReadAccessor::ImageReadAccessor(const mitk::Image *image,
+                                           const itk::ImageRegion<3> &region,
+                                           int t,
+                                           int OptionFlags)
+  : ImageReadAccessor(CopyRegion(image, region, t, OptionFlags), image, OptionFlags)
+{
+}
+
+mitk::ImageReadAccessor::ImageReadAccessor(ImageDataItem::Pointer regionData, const mitk::Image *image, int OptionFlags)
+  : ImageAccessorBase(image, regionData, OptionFlags), m_Image(image), m_RegionData(regionData)
+{
+  // the copy is private to this accessor, so locking it only keeps the bookkeeping consistent
+  if (!(OptionFlags & ImageAccessorBase::IgnoreLock))
+  {
+    try
+    {
+      OrganizeReadAccess();
+    }
+    catch (...)
+    {
+      delete m_WaitLock;
+      throw;
+    }
+  }
+}
+
+mitk::ImageDataItem::Pointer mitk::ImageReadAccessor::CopyRegion(const mitk::Image *image,
+                                                                const itk::ImageRegion<3> &region,
+                                                                int t,
+                                                                int OptionFlags)
+{
+  if (nullptr == image)
+    mitkThrow() << "ImageReadAccessor: No image was specified.";
+
+  ImageDataItem::Pointer regionData;
+  if (nullptr != image->GetBrickedStorage() || (OptionFlags & ImageAccessorBase::IgnoreLock))
+  {
+    regionData = image->GetRegionData(region, t);
+  }
+  else
+  {
+    ImageDataItem::Pointer volume = image->GetVolumeData(t);
+    if (volume.IsNotNull())
+    {
+      ImageReadAccessor volumeAccess(image, volume.GetPointer(), OptionFlags);
+      regionData = image->GetRegionData(region, t);
+    }
+  }
+
+  if (regionData.IsNull())
+    mitkThrow() << "ImageReadAccessor: Region " << region << " of time step " << t << " is not inside the image.";
+
+  return regionData;
+}
+
 mitk::ImageReadAccessor::~ImageReadAccessor()
 {
   if (!(m_Options & ImageAccessorBase::IgnoreLock))
@@ -12,10 +12,317 @@ found in the LICENSE file.
 #include "mitkImageStatisticsHolder.h"
 
 #include "mitkHistogramGenerator.h"
+#include "mitkImageReadAccessor.h"
 #include <mitkProperties.h>
 
+#include <itkCommand.h>
+#include <itkMultiThreader.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+namespace
+{
+  typedef mitk::ImageStatisticsHolder::HistogramType HistogramType;
+
+  /** Minimum number of voxels per block. Blocks always consist of whole slices, so that slice-wise edits only
+      invalidate a single block. */
+  const std::size_t MINIMUM_VOXELS_PER_BLOCK = 16384;
+
+  /** Same as the default of itk::Statistics::SampleToHistogramFilter, which has been used to generate the histogram. */
+  const double HISTOGRAM_MARGINAL_SCALE = 100.0;
+
+  /** Strided view on the components of one time step of the pixel buffer. */
+  struct BufferView
+  {
+    const void *Data;
+    int ComponentType;
+    std::size_t NumberOfComponents;
+    unsigned int Component;
+    std::size_t NumberOfVoxels;
+    std::size_t VoxelsPerBlock;
+  };
+
+  template <typename TExtrema>
+  void AddValue(TExtrema &extrema, double value)
+  {
+    // update min
+    if (value < extrema.Min)
+    {
+      extrema.SecondMin = extrema.Min;
+      extrema.Min = value;
+      extrema.CountOfMin = 1;
+    }
+    else if (value == extrema.Min)
+    {
+      ++extrema.CountOfMin;
+    }
+    else if (value < extrema.SecondMin)
+    {
+      extrema.SecondMin = value;
+    }
+
+    // update max
+    if (value > extrema.Max)
+    {
+      extrema.SecondMax = extrema.Max;
+      extrema.Max = value;
+      extrema.CountOfMax = 1;
+    }
+    else if (value == extrema.Max)
+    {
+      ++extrema.CountOfMax;
+    }
+    else if (value > extrema.SecondMax)
+    {
+      extrema.SecondMax = value;
+    }
+  }
+
+  /** Merges the extrema of two disjoint sets of voxels. */
+  template <typename TExtrema>
+  void MergeExtrema(TExtrema &target, const TExtrema &source)
+  {
+    if (source.Min < target.Min)
+    {
+      target.SecondMin = std::min(target.Min, source.SecondMin);
+      target.Min = source.Min;
+      target.CountOfMin = source.CountOfMin;
+    }
+    else if (source.Min == target.Min)
+    {
+      target.SecondMin = std::min(target.SecondMin, source.SecondMin);
+      target.CountOfMin += source.CountOfMin;
+    }
+    else
+    {
+      target.SecondMin = std::min(target.SecondMin, source.Min);
+    }
+
+    if (source.Max > target.Max)
+    {
+      target.SecondMax = std::max(target.Max, source.SecondMax);
+      target.Max = source.Max;
+      target.CountOfMax = source.CountOfMax;
+    }
+    else if (source.Max == target.Max)
+    {
+      target.SecondMax = std::max(target.SecondMax, source.SecondMax);
+      target.CountOfMax += source.CountOfMax;
+    }
+    else
+    {
+      target.SecondMax = std::max(target.SecondMax, source.Max);
+    }
+  }
+
+  template <typename TComponent, typename TExtrema>
+  void ComputeExtrema(const BufferView &view, std::size_t begin, std::size_t end, TExtrema &extrema)
+  {
+    const TComponent *data = static_cast<const TComponent *>(view.Data) + view.Component;
+    for (std::size_t i = begin; i < end; ++i)
+    {
+      AddValue(extrema, static_cast<double>(data[i * view.NumberOfComponents]));
+    }
+  }
+
+  template <typename TComponent>
+  void FillFrequencies(const BufferView &view,
+                       std::size_t begin,
+                       std::size_t end,
+                       const HistogramType *histogram,
+                       std::vector<HistogramType::AbsoluteFrequencyType> &frequencies)
+  {
+    const TComponent *data = static_cast<const TComponent *>(view.Data) + view.Component;
+    HistogramType::MeasurementVectorType measurement(1);
+    HistogramType::IndexType index(1);
+    for (std::size_t i = begin; i < end; ++i)
+    {
+      measurement[0] = static_cast<double>(data[i * view.NumberOfComponents]);
+      if (histogram->GetIndex(measurement, index))
+        ++frequencies[index[0]];
+    }
+  }
+
+  /** Calls functor.Run<TComponent>() for the given component type. Returns false for unsupported types. */
+  template <typename TFunctor>
+  bool DispatchComponentType(int componentType, TFunctor &functor)
+  {
+    switch (componentType)
+    {
+      case itk::ImageIOBase::UCHAR:
+        functor.template Run<unsigned char>();
+        return true;
+      case itk::ImageIOBase::CHAR:
+        functor.template Run<char>();
+        return true;
+      case itk::ImageIOBase::USHORT:
+        functor.template Run<unsigned short>();
+        return true;
+      case itk::ImageIOBase::SHORT:
+        functor.template Run<short>();
+        return true;
+      case itk::ImageIOBase::UINT:
+        functor.template Run<unsigned int>();
+        return true;
+      case itk::ImageIOBase::INT:
+        functor.template Run<int>();
+        return true;
+      case itk::ImageIOBase::ULONG:
+        functor.template Run<unsigned long>();
+        return true;
+      case itk::ImageIOBase::LONG:
+        functor.template Run<long>();
+        return true;
+      case itk::ImageIOBase::FLOAT:
+        functor.template Run<float>();
+        return true;
+      case itk::ImageIOBase::DOUBLE:
+        functor.template Run<double>();
+        return true;
+      default:
+        return false;
+    }
+  }
+
+  struct NoOperation
+  {
+    template <typename TComponent>
+    void Run()
+    {
+    }
+  };
+
+  /** Work shared by the threads: blocks are handed out one after the other. */
+  template <typename TExtrema>
+  struct BlockJob
+  {
+    BufferView View;
+    const std::vector<std::size_t> *Blocks;
+    std::atomic<std::size_t> NextBlock;
+
+    // extrema computation
+    std::vector<TExtrema> *Extrema;
+
+    // histogram computation
+    const HistogramType *Histogram;
+    std::vector<std::vector<HistogramType::AbsoluteFrequencyType>> *ThreadFrequencies;
+  };
+
+  template <typename TExtrema>
+  struct BlockWorker
+  {
+    BlockJob<TExtrema> *Job;
+    itk::ThreadIdType ThreadId;
+    std::size_t Begin;
+    std::size_t End;
+    std::size_t BlockNumber;
+
+    template <typename TComponent>
+    void Run()
+    {
+      if (Job->Histogram != nullptr)
+        FillFrequencies<TComponent>(Job->View, Begin, End, Job->Histogram, (*Job->ThreadFrequencies)[ThreadId]);
+      else
+        ComputeExtrema<TComponent>(Job->View, Begin, End, (*Job->Extrema)[BlockNumber]);
+    }
+  };
+
+  template <typename TExtrema>
+  ITK_THREAD_RETURN_TYPE BlockThreaderCallback(void *arg)
+  {
+    auto info = static_cast<itk::MultiThreader::ThreadInfoStruct *>(arg);
+    auto job = static_cast<BlockJob<TExtrema> *>(info->UserData);
+
+    BlockWorker<TExtrema> worker;
+    worker.Job = job;
+    worker.ThreadId = info->ThreadID;
+
+    for (std::size_t i = job->NextBlock++; i < job->Blocks->size(); i = job->NextBlock++)
+    {
+      worker.BlockNumber = i;
+      const std::size_t block = (*job->Blocks)[i];
+      worker.Begin = block * job->View.VoxelsPerBlock;
+      worker.End = std::min(worker.Begin + job->View.VoxelsPerBlock, job->View.NumberOfVoxels);
+      DispatchComponentType(job->View.ComponentType, worker);
+    }
+
+    return ITK_THREAD_RETURN_VALUE;
+  }
+
+  template <typename TExtrema>
+  void ProcessBlocksInParallel(BlockJob<TExtrema> &job)
+  {
+    job.NextBlock = 0;
+
+    itk::MultiThreader::Pointer threader = itk::MultiThreader::New();
+    const auto numberOfThreads = static_cast<itk::ThreadIdType>(std::max<std::size_t>(
+      1, std::min<std::size_t>(itk::MultiThreader::GetGlobalDefaultNumberOfThreads(), job.Blocks->size())));
+    threader->SetNumberOfThreads(numberOfThreads);
+
+    if (job.ThreadFrequencies != nullptr)
+      job.ThreadFrequencies->assign(threader->GetNumberOfThreads(),
+                                    std::vector<HistogramType::AbsoluteFrequencyType>(job.Histogram->Size(), 0));
+
+    threader->SetSingleMethod(BlockThreaderCallback<TExtrema>, &job);
+    threader->SingleMethodExecute();
+  }
+
+  /** Calls functor(view) for the slabs of whole slices of time step t of a bricked image. Each slab is as thick as
+      a brick, so that the bricks of a single slab are read at a time instead of the whole volume. */
+  template <typename TFunctor>
+  void ForEachBrickedSlab(const mitk::Image *image, int t, unsigned int component, TFunctor functor)
+  {
+    const mitk::PixelType pixelType = image->GetPixelType(0);
+    const unsigned int slabThickness = image->GetBrickedStorage()->GetBrickSize();
+
+    itk::ImageRegion<3> region;
+    region.SetSize(0, image->GetDimension(0));
+    region.SetSize(1, image->GetDimension(1));
+    for (unsigned int z = 0; z < image->GetDimension(2); z += slabThickness)
+    {
+      region.SetIndex(2, z);
+      region.SetSize(2, std::min(slabThickness, image->GetDimension(2) - z));
+      mitk::ImageReadAccessor readAccess(image, region, t);
+
+      BufferView view;
+      view.Data = readAccess.GetData();
+      view.ComponentType = pixelType.GetComponentType();
+      view.NumberOfComponents = pixelType.GetNumberOfComponents();
+      view.Component = component;
+      view.NumberOfVoxels = region.GetNumberOfPixels();
+      view.VoxelsPerBlock = MINIMUM_VOXELS_PER_BLOCK;
+      functor(view);
+    }
+  }
+
+  std::vector<std::size_t> AllBlocks(const BufferView &view)
+  {
+    std::vector<std::size_t> blocks((view.NumberOfVoxels + view.VoxelsPerBlock - 1) / view.VoxelsPerBlock);
+    for (std::size_t i = 0; i < blocks.size(); ++i)
+      blocks[i] = i;
+    return blocks;
+  }
+}
+
+mitk::ImageStatisticsHolder::BlockExtrema::BlockExtrema()
+  : Min(itk::NumericTraits<ScalarType>::max()),
+    Max(itk::NumericTraits<ScalarType>::NonpositiveMin()),
+    SecondMin(itk::NumericTraits<ScalarType>::max()),
+    SecondMax(itk::NumericTraits<ScalarType>::NonpositiveMin()),
+    CountOfMin(0),
+    CountOfMax(0)
+{
+}
+
+mitk::ImageStatisticsHolder::TimeStepCache::TimeStepCache()
+  : Buffer(nullptr), NumberOfBytes(0), Component(0), VoxelsPerBlock(0), BytesPerBlock(0)
+{
+}
+
 mitk::ImageStatisticsHolder::ImageStatisticsHolder(mitk::Image *image)
-  : m_Image(image)
+  : m_Image(image), m_InvalidatedSinceRecompute(false), m_ReportPending(false), m_ReportedMTime(0)
 {
   m_CountOfMinValuedVoxels.resize(1, 0);
   m_CountOfMaxValuedVoxels.resize(1, 0);
@@ -26,16 +333,108 @@ mitk::ImageStatisticsHolder::ImageStatisticsHolder(mitk::Image *image)
 
   mitk::HistogramGenerator::Pointer generator = mitk::HistogramGenerator::New();
   m_HistogramGeneratorObject = generator;
+
+  auto command = itk::SimpleMemberCommand<ImageStatisticsHolder>::New();
+  command->SetCallbackFunction(this, &ImageStatisticsHolder::OnImageModified);
+  m_ImageModifiedObserverTag = m_Image->AddObserver(itk::ModifiedEvent(), command);
 }
 
 mitk::ImageStatisticsHolder::~ImageStatisticsHolder()
 {
+  m_Image->RemoveObserver(m_ImageModifiedObserverTag);
   m_HistogramGeneratorObject = nullptr;
 }
 
+void mitk::ImageStatisticsHolder::OnImageModified()
+{
+  // the first modification after a report belongs to the reported memory ranges
+  m_CacheMutex.Lock();
+  if (m_ReportPending)
+  {
+    m_ReportedMTime = m_Image->GetMTime();
+    m_ReportPending = false;
+  }
+  m_CacheMutex.Unlock();
+}
+
 const mitk::ImageStatisticsHolder::HistogramType *mitk::ImageStatisticsHolder::GetScalarHistogram(
   int t, unsigned int /*component*/)
 {
+  if (this->IsBlockwiseComputationSupported() && m_Image->GetPixelType(0).GetNumberOfComponents() == 1)
+  {
+    // the extrema are the bounds of the histogram, so both share the cached blocks
+    this->ComputeImageStatistics(t, 0);
+
+    m_CacheMutex.Lock();
+    const bool isCached = static_cast<std::size_t>(t) < m_TimeStepCaches.size();
+    HistogramType::Pointer cachedHistogram = isCached ? m_TimeStepCaches[t].Histogram : nullptr;
+    m_CacheMutex.Unlock();
+    if (cachedHistogram.IsNotNull())
+      return cachedHistogram;
+
+    const ScalarType min = m_ScalarMin[t];
+    const ScalarType max = m_ScalarMax[t];
+    auto *generator = static_cast<mitk::HistogramGenerator *>(m_HistogramGeneratorObject.GetPointer());
+    const auto numberOfBins = static_cast<unsigned int>(generator->GetSize());
+
+    if (isCached && std::isfinite(min) && std::isfinite(max) && min <= max)
+    {
+      // bounds as chosen by itk::Statistics::SampleToHistogramFilter for the same number of bins
+      HistogramType::SizeType size(1);
+      HistogramType::MeasurementVectorType lowerBound(1);
+      HistogramType::MeasurementVectorType upperBound(1);
+      size[0] = numberOfBins;
+      lowerBound[0] = min;
+      upperBound[0] = max + ((max - min) / static_cast<double>(numberOfBins)) / HISTOGRAM_MARGINAL_SCALE;
+
+      HistogramType::Pointer histogram = HistogramType::New();
+      histogram->SetMeasurementVectorSize(1);
+      histogram->Initialize(size, lowerBound, upperBound);
+
+      auto fillHistogram = [&histogram](const BufferView &view) {
+        const std::vector<std::size_t> blocks = AllBlocks(view);
+        std::vector<std::vector<HistogramType::AbsoluteFrequencyType>> threadFrequencies;
+
+        BlockJob<BlockExtrema> job;
+        job.View = view;
+        job.Blocks = &blocks;
+        job.Extrema = nullptr;
+        job.Histogram = histogram;
+        job.ThreadFrequencies = &threadFrequencies;
+        ProcessBlocksInParallel(job);
+
+        for (const auto &frequencies : threadFrequencies)
+          for (unsigned int bin = 0; bin < frequencies.size(); ++bin)
+            histogram->IncreaseFrequency(bin, frequencies[bin]);
+      };
+
+      if (nullptr != m_Image->GetBrickedStorage())
+      {
+        ForEachBrickedSlab(m_Image, t, 0, fillHistogram);
+      }
+      else
+      {
+        ImageDataItemPointer volume = m_Image->GetVolumeData(t);
+        ImageReadAccessor readAccess(m_Image, volume);
+
+        BufferView view;
+        view.Data = readAccess.GetData();
+        view.ComponentType = m_Image->GetPixelType(0).GetComponentType();
+        view.NumberOfComponents = 1;
+        view.Component = 0;
+        view.NumberOfVoxels = volume->GetSize() / m_Image->GetPixelType(0).GetSize();
+        view.VoxelsPerBlock = MINIMUM_VOXELS_PER_BLOCK;
+        fillHistogram(view);
+      }
+
+      // the cache keeps the histogram alive until the image is modified
+      m_CacheMutex.Lock();
+      m_TimeStepCaches[t].Histogram = histogram;
+      m_CacheMutex.Unlock();
+      return histogram;
+    }
+  }
+
   mitk::ImageTimeSelector *timeSelector = this->GetTimeSelector();
   if (timeSelector != nullptr)
   {
@@ -94,163 +493,195 @@ void mitk::ImageStatisticsHolder::ResetImageStatistics()
   m_CountOfMaxValuedVoxels.assign(1, 0);
 }
 
-#include "mitkImageAccessByItk.h"
+void mitk::ImageStatisticsHolder::InvalidateMemoryRange(const void *begin, const void *end)
+{
+  const char *rangeBegin = static_cast<const char *>(begin);
+  const char *rangeEnd = static_cast<const char *>(end);
+
+  m_CacheMutex.Lock();
+  for (auto &cache : m_TimeStepCaches)
+  {
+    const char *buffer = static_cast<const char *>(cache.Buffer);
+    if (buffer == nullptr || rangeEnd <= buffer || rangeBegin >= buffer + cache.NumberOfBytes)
+      continue;
 
-//#define BOUNDINGOBJECT_IGNORE
+    const std::size_t firstByte = rangeBegin > buffer ? rangeBegin - buffer : 0;
+    const std::size_t endByte = std::min<std::size_t>(rangeEnd - buffer, cache.NumberOfBytes);
+    const std::size_t endBlock = std::min((endByte + cache.BytesPerBlock - 1) / cache.BytesPerBlock, cache.Blocks.size());
+
+    for (std::size_t block = firstByte / cache.BytesPerBlock; block < endBlock; ++block)
+    {
+      cache.BlockValid[block] = false;
+      ++cache.BlockEpoch[block];
+    }
+    cache.Histogram = nullptr;
+  }
+  m_InvalidatedSinceRecompute = true;
+  m_ReportPending = true;
+  m_CacheMutex.Unlock();
+}
 
-template <typename ItkImageType>
-void mitk::_ComputeExtremaInItkImage(const ItkImageType *itkImage, mitk::ImageStatisticsHolder *statisticsHolder, int t)
+bool mitk::ImageStatisticsHolder::IsBlockwiseComputationSupported() const
 {
-  typename ItkImageType::RegionType region;
-  region = itkImage->GetBufferedRegion();
-  if (region.Crop(itkImage->GetRequestedRegion()) == false)
-    return;
-  if (region != itkImage->GetRequestedRegion())
-    return;
+  // used to avoid statistics calculation on Odf images. property will be replaced as soons as bug 17928 is merged and
+  // the diffusion image refactoring is complete.
+  mitk::BoolProperty *isSh = dynamic_cast<mitk::BoolProperty *>(m_Image->GetProperty("IsShImage").GetPointer());
+  mitk::BoolProperty *isOdf = dynamic_cast<mitk::BoolProperty *>(m_Image->GetProperty("IsOdfImage").GetPointer());
+  const mitk::PixelType pType = m_Image->GetPixelType(0);
 
-  itk::ImageRegionConstIterator<ItkImageType> it(itkImage, region);
-  typedef typename ItkImageType::PixelType TPixel;
-  TPixel value = 0;
+  NoOperation componentTypeCheck;
+  if (!DispatchComponentType(pType.GetComponentType(), componentTypeCheck))
+    return false;
 
-  if (statisticsHolder == nullptr || !statisticsHolder->IsValidTimeStep(t))
-    return;
-  statisticsHolder->Expand(t + 1); // make sure we have initialized all arrays
-  statisticsHolder->m_CountOfMinValuedVoxels[t] = 0;
-  statisticsHolder->m_CountOfMaxValuedVoxels[t] = 0;
+  if (pType.GetNumberOfComponents() == 1 && (pType.GetPixelType() != itk::ImageIOBase::UNKNOWNPIXELTYPE) &&
+      (pType.GetPixelType() != itk::ImageIOBase::VECTOR))
+    return true;
 
-  statisticsHolder->m_Scalar2ndMin[t] = statisticsHolder->m_ScalarMin[t] = itk::NumericTraits<ScalarType>::max();
-  statisticsHolder->m_Scalar2ndMax[t] = statisticsHolder->m_ScalarMax[t] =
-    itk::NumericTraits<ScalarType>::NonpositiveMin();
+  // we have a vector image
+  return pType.GetPixelType() == itk::ImageIOBase::VECTOR && (!isOdf || !isOdf->GetValue()) &&
+         (!isSh || !isSh->GetValue());
+}
 
-  while (!it.IsAtEnd())
-  {
-    value = it.Get();
-#ifdef BOUNDINGOBJECT_IGNORE
-    if (value > -32765)
-    {
-#endif
-      // update min
-      if (value < statisticsHolder->m_ScalarMin[t])
-      {
-        statisticsHolder->m_Scalar2ndMin[t] = statisticsHolder->m_ScalarMin[t];
-        statisticsHolder->m_ScalarMin[t] = value;
-        statisticsHolder->m_CountOfMinValuedVoxels[t] = 1;
-      }
-      else if (value == statisticsHolder->m_ScalarMin[t])
-      {
-        ++statisticsHolder->m_CountOfMinValuedVoxels[t];
-      }
-      else if (value < statisticsHolder->m_Scalar2ndMin[t])
-      {
-        statisticsHolder->m_Scalar2ndMin[t] = value;
-      }
+void mitk::ImageStatisticsHolder::ComputeExtremaFromBrickedSlabs(int t, unsigned int component)
+{
+  const PixelType pixelType = m_Image->GetPixelType(0);
+  if (pixelType.GetNumberOfComponents() > 1 && component >= pixelType.GetNumberOfComponents())
+    return;
 
-      // update max
-      if (value > statisticsHolder->m_ScalarMax[t])
-      {
-        statisticsHolder->m_Scalar2ndMax[t] = statisticsHolder->m_ScalarMax[t];
-        statisticsHolder->m_ScalarMax[t] = value;
-        statisticsHolder->m_CountOfMaxValuedVoxels[t] = 1;
-      }
-      else if (value == statisticsHolder->m_ScalarMax[t])
-      {
-        ++statisticsHolder->m_CountOfMaxValuedVoxels[t];
-      }
-      else if (value > statisticsHolder->m_Scalar2ndMax[t])
-      {
-        statisticsHolder->m_Scalar2ndMax[t] = value;
-      }
-#ifdef BOUNDINGOBJECT_IGNORE
-    }
-#endif
+  BlockExtrema extrema;
+  ForEachBrickedSlab(m_Image, t, pixelType.GetNumberOfComponents() > 1 ? component : 0, [&extrema](const BufferView &view) {
+    const std::vector<std::size_t> blocks = AllBlocks(view);
+    std::vector<BlockExtrema> blockExtrema(blocks.size());
+
+    BlockJob<BlockExtrema> job;
+    job.View = view;
+    job.Blocks = &blocks;
+    job.Extrema = &blockExtrema;
+    job.Histogram = nullptr;
+    job.ThreadFrequencies = nullptr;
+    ProcessBlocksInParallel(job);
+
+    for (const auto &block : blockExtrema)
+      MergeExtrema(extrema, block);
+  });
+
+  // the cache holds no blocks, since the slabs are no persistent buffers, but the histogram
+  m_CacheMutex.Lock();
+  if (static_cast<std::size_t>(t) >= m_TimeStepCaches.size())
+    m_TimeStepCaches.resize(t + 1);
+  m_CacheMutex.Unlock();
+
+  this->SetExtrema(t, extrema);
+}
 
-    ++it;
-  }
+void mitk::ImageStatisticsHolder::SetExtrema(int t, const BlockExtrema &extrema)
+{
+  m_ScalarMin[t] = extrema.Min;
+  m_ScalarMax[t] = extrema.Max;
+  m_Scalar2ndMin[t] = extrema.SecondMin;
+  m_Scalar2ndMax[t] = extrema.SecondMax;
+  m_CountOfMinValuedVoxels[t] = extrema.CountOfMin;
+  m_CountOfMaxValuedVoxels[t] = extrema.CountOfMax;
 
   //// guard for wrong 2dMin/Max on single constant value images
-  if (statisticsHolder->m_ScalarMax[t] == statisticsHolder->m_ScalarMin[t])
+  if (m_ScalarMax[t] == m_ScalarMin[t])
   {
-    statisticsHolder->m_Scalar2ndMax[t] = statisticsHolder->m_Scalar2ndMin[t] = statisticsHolder->m_ScalarMax[t];
+    m_Scalar2ndMax[t] = m_Scalar2ndMin[t] = m_ScalarMax[t];
   }
-  statisticsHolder->m_LastRecomputeTimeStamp.Modified();
+  m_LastRecomputeTimeStamp.Modified();
 }
 
-template <typename ItkImageType>
-void mitk::_ComputeExtremaInItkVectorImage(const ItkImageType *itkImage,
-                                           mitk::ImageStatisticsHolder *statisticsHolder,
-                                           int t,
-                                           unsigned int component)
+void mitk::ImageStatisticsHolder::ComputeExtremaFromBlocks(int t, unsigned int component)
 {
-  typename ItkImageType::RegionType region;
-  region = itkImage->GetBufferedRegion();
-  if (region.Crop(itkImage->GetRequestedRegion()) == false)
-    return;
-  if (region != itkImage->GetRequestedRegion())
+  if (nullptr != m_Image->GetBrickedStorage())
+  {
+    this->ComputeExtremaFromBrickedSlabs(t, component);
     return;
+  }
 
-  itk::ImageRegionConstIterator<ItkImageType> it(itkImage, region);
+  ImageDataItemPointer volume = m_Image->GetVolumeData(t);
+  if (volume.IsNull())
+    return;
 
-  if (statisticsHolder == nullptr || !statisticsHolder->IsValidTimeStep(t))
+  // holds off writers of this time step while the blocks are read
+  ImageReadAccessor readAccess(m_Image, volume);
+
+  const PixelType pixelType = m_Image->GetPixelType(0);
+  BufferView view;
+  view.Data = readAccess.GetData();
+  view.ComponentType = pixelType.GetComponentType();
+  view.NumberOfComponents = pixelType.GetNumberOfComponents();
+  view.Component = pixelType.GetNumberOfComponents() > 1 ? component : 0;
+  view.NumberOfVoxels = volume->GetSize() / pixelType.GetSize();
+  if (view.NumberOfVoxels == 0 || view.Component >= view.NumberOfComponents)
     return;
-  statisticsHolder->Expand(t + 1); // make sure we have initialized all arrays
-  statisticsHolder->m_CountOfMinValuedVoxels[t] = 0;
-  statisticsHolder->m_CountOfMaxValuedVoxels[t] = 0;
 
-  statisticsHolder->m_Scalar2ndMin[t] = statisticsHolder->m_ScalarMin[t] = itk::NumericTraits<ScalarType>::max();
-  statisticsHolder->m_Scalar2ndMax[t] = statisticsHolder->m_ScalarMax[t] =
-    itk::NumericTraits<ScalarType>::NonpositiveMin();
+  const std::size_t voxelsPerSlice =
+    std::min<std::size_t>(std::max<std::size_t>(1, m_Image->GetDimension(0) * m_Image->GetDimension(1)), view.NumberOfVoxels);
+  view.VoxelsPerBlock = std::max<std::size_t>(1, MINIMUM_VOXELS_PER_BLOCK / voxelsPerSlice) * voxelsPerSlice;
+  const std::size_t numberOfBlocks = (view.NumberOfVoxels + view.VoxelsPerBlock - 1) / view.VoxelsPerBlock;
 
-  while (!it.IsAtEnd())
+  // find the outdated blocks, (re)initialize the cache if the buffer changed
+  std::vector<std::size_t> outdatedBlocks;
+  std::vector<unsigned long> epochs;
+
+  m_CacheMutex.Lock();
+  if (static_cast<std::size_t>(t) >= m_TimeStepCaches.size())
+    m_TimeStepCaches.resize(t + 1);
+
+  TimeStepCache &cache = m_TimeStepCaches[t];
+  if (cache.Buffer != view.Data || cache.NumberOfBytes != volume->GetSize() || cache.Component != view.Component ||
+      cache.VoxelsPerBlock != view.VoxelsPerBlock)
   {
-    double value = it.Get()[component];
-#ifdef BOUNDINGOBJECT_IGNORE
-    if (value > -32765)
-    {
-#endif
-      // update min
-      if (value < statisticsHolder->m_ScalarMin[t])
-      {
-        statisticsHolder->m_Scalar2ndMin[t] = statisticsHolder->m_ScalarMin[t];
-        statisticsHolder->m_ScalarMin[t] = value;
-        statisticsHolder->m_CountOfMinValuedVoxels[t] = 1;
-      }
-      else if (value == statisticsHolder->m_ScalarMin[t])
-      {
-        ++statisticsHolder->m_CountOfMinValuedVoxels[t];
-      }
-      else if (value < statisticsHolder->m_Scalar2ndMin[t])
-      {
-        statisticsHolder->m_Scalar2ndMin[t] = value;
-      }
+    cache.Buffer = view.Data;
+    cache.NumberOfBytes = volume->GetSize();
+    cache.Component = view.Component;
+    cache.VoxelsPerBlock = view.VoxelsPerBlock;
+    cache.BytesPerBlock = view.VoxelsPerBlock * pixelType.GetSize();
+    cache.Blocks.assign(numberOfBlocks, BlockExtrema());
+    cache.BlockValid.assign(numberOfBlocks, false);
+    cache.BlockEpoch.assign(numberOfBlocks, 0);
+    cache.Histogram = nullptr;
+  }
 
-      // update max
-      if (value > statisticsHolder->m_ScalarMax[t])
-      {
-        statisticsHolder->m_Scalar2ndMax[t] = statisticsHolder->m_ScalarMax[t];
-        statisticsHolder->m_ScalarMax[t] = value;
-        statisticsHolder->m_CountOfMaxValuedVoxels[t] = 1;
-      }
-      else if (value == statisticsHolder->m_ScalarMax[t])
-      {
-        ++statisticsHolder->m_CountOfMaxValuedVoxels[t];
-      }
-      else if (value > statisticsHolder->m_Scalar2ndMax[t])
-      {
-        statisticsHolder->m_Scalar2ndMax[t] = value;
-      }
-#ifdef BOUNDINGOBJECT_IGNORE
+  for (std::size_t block = 0; block < numberOfBlocks; ++block)
+  {
+    if (!cache.BlockValid[block])
+    {
+      outdatedBlocks.push_back(block);
+      epochs.push_back(cache.BlockEpoch[block]);
     }
-#endif
+  }
+  m_CacheMutex.Unlock();
 
-    ++it;
+  std::vector<BlockExtrema> computedExtrema(outdatedBlocks.size());
+  if (!outdatedBlocks.empty())
+  {
+    BlockJob<BlockExtrema> job;
+    job.View = view;
+    job.Blocks = &outdatedBlocks;
+    job.Extrema = &computedExtrema;
+    job.Histogram = nullptr;
+    job.ThreadFrequencies = nullptr;
+    ProcessBlocksInParallel(job);
   }
 
-  //// guard for wrong 2dMin/Max on single constant value images
-  if (statisticsHolder->m_ScalarMax[t] == statisticsHolder->m_ScalarMin[t])
+  // store the new blocks unless they have been invalidated in the meantime and merge all blocks
+  BlockExtrema extrema;
+
+  m_CacheMutex.Lock();
+  TimeStepCache &updatedCache = m_TimeStepCaches[t];
+  for (std::size_t i = 0; i < outdatedBlocks.size(); ++i)
   {
-    statisticsHolder->m_Scalar2ndMax[t] = statisticsHolder->m_Scalar2ndMin[t] = statisticsHolder->m_ScalarMax[t];
+    const std::size_t block = outdatedBlocks[i];
+    updatedCache.Blocks[block] = computedExtrema[i];
+    updatedCache.BlockValid[block] = updatedCache.BlockEpoch[block] == epochs[i];
   }
-  statisticsHolder->m_LastRecomputeTimeStamp.Modified();
+  for (const auto &blockExtrema : updatedCache.Blocks)
+    MergeExtrema(extrema, blockExtrema);
+  m_CacheMutex.Unlock();
+
+  this->SetExtrema(t, extrema);
 }
 
 void mitk::ImageStatisticsHolder::ComputeImageStatistics(int t, unsigned int component)
@@ -259,10 +690,28 @@ void mitk::ImageStatisticsHolder::ComputeImageStatistics(int t, unsigned int com
   if (!m_Image->IsValidTimeStep(t))
     return;
 
-  // image modified?
-  if (this->m_Image->GetMTime() > m_LastRecomputeTimeStamp.GetMTime())
+  m_CacheMutex.Lock();
+  const bool invalidated = m_InvalidatedSinceRecompute;
+  m_CacheMutex.Unlock();
+
+  // image modified? (progressively loaded images report new slices without calling Modified())
+  if (this->m_Image->GetMTime() > m_LastRecomputeTimeStamp.GetMTime() || invalidated)
+  {
     this->ResetImageStatistics();
 
+    m_CacheMutex.Lock();
+    // a modification after the last reported one might have changed any voxel. Memory ranges of bricked
+    // images are copies of the bricks, so any change invalidates the whole cache.
+    if (this->m_Image->GetMTime() > m_ReportedMTime || nullptr != m_Image->GetBrickedStorage())
+    {
+      m_TimeStepCaches.clear();
+      m_ReportedMTime = this->m_Image->GetMTime();
+    }
+    m_InvalidatedSinceRecompute = false;
+    m_ReportPending = false;
+    m_CacheMutex.Unlock();
+  }
+
   Expand(t + 1);
 
   // do we have valid information already?
@@ -270,36 +719,9 @@ void mitk::ImageStatisticsHolder::ComputeImageStatistics(int t, unsigned int com
       m_Scalar2ndMin[t] != itk::NumericTraits<ScalarType>::max())
     return; // Values already calculated before...
 
-  // used to avoid statistics calculation on Odf images. property will be replaced as soons as bug 17928 is merged and
-  // the diffusion image refactoring is complete.
-  mitk::BoolProperty *isSh = dynamic_cast<mitk::BoolProperty *>(m_Image->GetProperty("IsShImage").GetPointer());
-  mitk::BoolProperty *isOdf = dynamic_cast<mitk::BoolProperty *>(m_Image->GetProperty("IsOdfImage").GetPointer());
-  const mitk::PixelType pType = m_Image->GetPixelType(0);
-  if (pType.GetNumberOfComponents() == 1 && (pType.GetPixelType() != itk::ImageIOBase::UNKNOWNPIXELTYPE) &&
-      (pType.GetPixelType() != itk::ImageIOBase::VECTOR))
+  if (this->IsBlockwiseComputationSupported())
   {
-    // recompute
-    mitk::ImageTimeSelector::Pointer timeSelector = this->GetTimeSelector();
-    if (timeSelector.IsNotNull())
-    {
-      timeSelector->SetTimeNr(t);
-      timeSelector->UpdateLargestPossibleRegion();
-      const mitk::Image *image = timeSelector->GetOutput();
-      AccessByItk_2(image, _ComputeExtremaInItkImage, this, t);
-    }
-  }
-  else if (pType.GetPixelType() == itk::ImageIOBase::VECTOR &&
-           (!isOdf || !isOdf->GetValue()) && (!isSh || !isSh->GetValue())) // we have a vector image
-  {
-    // recompute
-    mitk::ImageTimeSelector::Pointer timeSelector = this->GetTimeSelector();
-    if (timeSelector.IsNotNull())
-    {
-      timeSelector->SetTimeNr(t);
-      timeSelector->UpdateLargestPossibleRegion();
-      const mitk::Image *image = timeSelector->GetOutput();
-      AccessVectorPixelTypeByItk_n(image, _ComputeExtremaInItkVectorImage, (this, t, component));
-    }
+    this->ComputeExtremaFromBlocks(t, component);
   }
   else
   {
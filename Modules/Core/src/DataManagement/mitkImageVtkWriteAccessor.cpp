@@ -13,6 +13,7 @@ found in the LICENSE file.
 #include "mitkImageVtkWriteAccessor.h"
 
 #include "mitkImage.h"
+#include "mitkImageStatisticsHolder.h"
 
 #include <vtkImageData.h>
 
@@ -36,6 +37,10 @@ mitk::ImageVtkWriteAccessor::ImageVtkWriteAccessor(ImagePointer iP,
 
 mitk::ImageVtkWriteAccessor::~ImageVtkWriteAccessor()
 {
+  // let the statistics recompute only the written part of the image
+  if (m_Image->GetStatistics() != nullptr)
+    m_Image->GetStatistics()->InvalidateMemoryRange(m_AddressBegin, m_AddressEnd);
+
   m_Image->m_VtkReadersLock.Lock();
 
   auto it = std::find(m_Image->m_VtkReaders.begin(), m_Image->m_VtkReaders.end(), this);
@@ -11,19 +11,43 @@ found in the LICENSE file.
 ============================================================================*/
 
 #include "mitkImageWriteAccessor.h"
+#include "mitkImageStatisticsHolder.h"
 
 mitk::ImageWriteAccessor::ImageWriteAccessor(ImagePointer image, const mitk::ImageDataItem *iDI, int OptionFlags)
-  : ImageAccessorBase(image.GetPointer(), iDI, OptionFlags), m_Image(image)
+  : ImageAccessorBase(image.GetPointer(), PrepareWriteAccess(image, iDI), OptionFlags), m_Image(image)
 
 {
   OrganizeWriteAccess();
 }
 
+const mitk::ImageDataItem *mitk::ImageWriteAccessor::PrepareWriteAccess(Image *image, const ImageDataItem *iDI)
+{
+  // memory shared with other images is copied before it is written (see Image::SetSharedVolume())
+  if (nullptr == image || !image->IsInitialized())
+    return iDI;
+
+  return image->PrepareWriteAccess(iDI);
+}
+
 mitk::ImageWriteAccessor::~ImageWriteAccessor()
 {
   // In case of non-coherent memory, copied area needs to be written back
   // TODO
 
+  // the pixels of bricked images are copies, which are written back to the bricks
+  try
+  {
+    m_Image->WriteBrickedData(m_DataItem);
+  }
+  catch (const Exception &e)
+  {
+    MITK_ERROR << e.GetDescription();
+  }
+
+  // let the statistics recompute only the written part of the image
+  if (m_Image->GetStatistics() != nullptr)
+    m_Image->GetStatistics()->InvalidateMemoryRange(m_AddressBegin, m_AddressEnd);
+
   m_Image->m_ReadWriteLock.Lock();
 
   // delete self from list of ImageReadAccessors in Image
@@ -0,0 +1,173 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkMemoryMappedFile.h"
+
+#include <mitkExceptionMacro.h>
+
+#include <itksys/SystemTools.hxx>
+
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+  std::size_t GetAllocationGranularity()
+  {
+#ifdef _WIN32
+    SYSTEM_INFO systemInfo;
+    GetSystemInfo(&systemInfo);
+    return systemInfo.dwAllocationGranularity;
+#else
+    return static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+#endif
+  }
+
+  /** Full path with resolved symbolic links, so that different names of the same file can be compared.*/
+  std::string GetCanonicalPath(const std::string &fileName)
+  {
+    const std::string fullPath = itksys::SystemTools::CollapseFullPath(fileName);
+    const std::string realPath = itksys::SystemTools::GetRealPath(fullPath);
+    return realPath.empty() ? fullPath : realPath;
+  }
+
+  /** All existing mappings, so writers can detach the mappings of the files they overwrite.*/
+  std::mutex MappingsMutex;
+  std::vector<mitk::MemoryMappedFile *> Mappings;
+}
+
+void mitk::MemoryMappedFile::DetachMappings(const std::string &fileName)
+{
+  const std::string canonicalPath = GetCanonicalPath(fileName);
+
+  std::lock_guard<std::mutex> lock(MappingsMutex);
+  for (auto *mapping : Mappings)
+  {
+    if (mapping->m_CanonicalFileName == canonicalPath)
+      mapping->Detach();
+  }
+}
+
+void mitk::MemoryMappedFile::Detach()
+{
+#ifndef _WIN32
+  // writing to a page of a private mapping replaces it by a private copy
+  const std::size_t pageSize = GetAllocationGranularity();
+  auto *pages = static_cast<volatile char *>(m_Mapping);
+  for (std::size_t offset = 0; offset < m_MappingSize; offset += pageSize)
+  {
+    pages[offset] = pages[offset];
+  }
+#endif
+}
+
+long long mitk::MemoryMappedFile::GetFileSize(const std::string &fileName)
+{
+#ifdef _WIN32
+  WIN32_FILE_ATTRIBUTE_DATA attributes;
+  if (!GetFileAttributesExA(fileName.c_str(), GetFileExInfoStandard, &attributes))
+    return -1;
+
+  LARGE_INTEGER size;
+  size.HighPart = attributes.nFileSizeHigh;
+  size.LowPart = attributes.nFileSizeLow;
+  return size.QuadPart;
+#else
+  struct stat status;
+  if (0 != stat(fileName.c_str(), &status) || !S_ISREG(status.st_mode))
+    return -1;
+
+  return static_cast<long long>(status.st_size);
+#endif
+}
+
+mitk::MemoryMappedFile::MemoryMappedFile(const std::string &fileName, std::size_t offset, std::size_t size)
+  : m_FileName(fileName),
+    m_CanonicalFileName(GetCanonicalPath(fileName)),
+    m_Mapping(nullptr),
+    m_MappingSize(0),
+    m_Data(nullptr),
+    m_Size(size)
+{
+  if (0 == size)
+    mitkThrow() << "Cannot map an empty region of \"" << fileName << "\".";
+
+  const long long fileSize = GetFileSize(fileName);
+  if (fileSize < 0 || static_cast<unsigned long long>(fileSize) < offset + size)
+    mitkThrow() << "File \"" << fileName << "\" does not contain " << size << " bytes at offset " << offset << ".";
+
+  const std::size_t granularity = GetAllocationGranularity();
+  const std::size_t mappingOffset = offset - offset % granularity;
+  m_MappingSize = size + (offset - mappingOffset);
+
+#ifdef _WIN32
+  HANDLE file = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (INVALID_HANDLE_VALUE == file)
+    mitkThrow() << "Cannot open \"" << fileName << "\".";
+
+  // the mapping object and the view keep the file open, so the handles can be closed right away
+  HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+  CloseHandle(file);
+  if (nullptr == mapping)
+    mitkThrow() << "Cannot map \"" << fileName << "\".";
+
+  m_Mapping = MapViewOfFile(mapping,
+                            FILE_MAP_COPY,
+                            static_cast<DWORD>(static_cast<unsigned long long>(mappingOffset) >> 32),
+                            static_cast<DWORD>(mappingOffset & 0xFFFFFFFF),
+                            m_MappingSize);
+  CloseHandle(mapping);
+  if (nullptr == m_Mapping)
+    mitkThrow() << "Cannot map \"" << fileName << "\".";
+#else
+  const int file = open(fileName.c_str(), O_RDONLY);
+  if (file < 0)
+    mitkThrow() << "Cannot open \"" << fileName << "\".";
+
+  // MAP_PRIVATE with write access: pages are copied on the first write and never written back
+  void *mapping = mmap(nullptr, m_MappingSize, PROT_READ | PROT_WRITE, MAP_PRIVATE, file, static_cast<off_t>(mappingOffset));
+  close(file);
+  if (MAP_FAILED == mapping)
+    mitkThrow() << "Cannot map \"" << fileName << "\".";
+
+  m_Mapping = mapping;
+#endif
+
+  m_Data = static_cast<char *>(m_Mapping) + (offset - mappingOffset);
+
+  std::lock_guard<std::mutex> lock(MappingsMutex);
+  Mappings.push_back(this);
+}
+
+mitk::MemoryMappedFile::~MemoryMappedFile()
+{
+  {
+    std::lock_guard<std::mutex> lock(MappingsMutex);
+    Mappings.erase(std::remove(Mappings.begin(), Mappings.end(), this), Mappings.end());
+  }
+
+#ifdef _WIN32
+  UnmapViewOfFile(m_Mapping);
+#else
+  munmap(m_Mapping, m_MappingSize);
+#endif
+}
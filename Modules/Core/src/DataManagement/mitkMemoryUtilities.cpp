@@ -11,6 +11,7 @@ found in the LICENSE file.
 ============================================================================*/
 
 #include "mitkMemoryUtilities.h"
+#include "mitkImageMemoryPool.h"
 
 #include <cstdio>
 #if _MSC_VER
@@ -91,6 +92,16 @@ size_t mitk::MemoryUtilities::GetTotalSizeOfPhysicalRam()
 #endif
 }
 
+size_t mitk::MemoryUtilities::GetImageMemoryPoolUsage()
+{
+  return ImageMemoryPool::GetInstance().GetStatistics().BytesInUse;
+}
+
+size_t mitk::MemoryUtilities::GetImageMemoryPoolCachedSize()
+{
+  return ImageMemoryPool::GetInstance().GetStatistics().BytesCached;
+}
+
 #ifndef _MSC_VER
 #ifndef __APPLE__
 int mitk::MemoryUtilities::ReadStatmFromProcFS(
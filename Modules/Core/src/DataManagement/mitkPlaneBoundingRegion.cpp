@@ -0,0 +1,101 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkPlaneBoundingRegion.h"
+
+#include <mitkExceptionMacro.h>
+#include <mitkImageWriteAccessor.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+itk::ImageRegion<3> mitk::PlaneBoundingRegion::Compute(const BaseGeometry *imageGeometry,
+                                                       const PlaneGeometry *plane,
+                                                       unsigned int margin)
+{
+  double lower[3], upper[3];
+  std::fill(lower, lower + 3, std::numeric_limits<double>::max());
+  std::fill(upper, upper + 3, std::numeric_limits<double>::lowest());
+
+  // the plane is convex, so the index coordinates of its corners bound all of its points
+  const auto &bounds = plane->GetBounds();
+  for (unsigned int corner = 0; corner < 8; ++corner)
+  {
+    Point3D planeIndex;
+    planeIndex[0] = bounds[(corner & 1) ? 1 : 0];
+    planeIndex[1] = bounds[(corner & 2) ? 3 : 2];
+    planeIndex[2] = bounds[(corner & 4) ? 5 : 4];
+
+    Point3D world, index;
+    plane->IndexToWorld(planeIndex, world);
+    imageGeometry->WorldToIndex(world, index);
+
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+      lower[i] = std::min(lower[i], index[i]);
+      upper[i] = std::max(upper[i], index[i]);
+    }
+  }
+
+  itk::ImageRegion<3> region;
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    const auto last = std::max(
+      static_cast<itk::IndexValueType>(std::round(imageGeometry->GetExtent(i))) - 1, itk::IndexValueType(0));
+    const auto first = static_cast<itk::IndexValueType>(std::floor(lower[i])) - static_cast<itk::IndexValueType>(margin);
+    const auto past = static_cast<itk::IndexValueType>(std::ceil(upper[i])) + static_cast<itk::IndexValueType>(margin);
+    const auto begin = std::min(std::max(first, itk::IndexValueType(0)), last);
+    const auto end = std::min(std::max(past, itk::IndexValueType(0)), last);
+
+    region.SetIndex(i, begin);
+    region.SetSize(i, end - begin + 1);
+  }
+
+  return region;
+}
+
+mitk::Image::Pointer mitk::PlaneBoundingRegion::ExtractImage(const Image *image,
+                                                            const itk::ImageRegion<3> &region,
+                                                            TimeStepType t)
+{
+  const BaseGeometry *geometry = image->GetTimeGeometry()->GetGeometryForTimeStep(t);
+  if (nullptr == geometry)
+    mitkThrow() << "Image has no geometry for time step " << t << ".";
+
+  Point3D regionIndex;
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    regionIndex[i] = region.GetIndex(i);
+  }
+
+  Point3D regionOrigin;
+  geometry->IndexToWorld(regionIndex, regionOrigin);
+
+  BaseGeometry::Pointer regionGeometry = geometry->Clone();
+  regionGeometry->SetOrigin(regionOrigin);
+  BaseGeometry::BoundsArrayType bounds = regionGeometry->GetBounds();
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    bounds[2 * i + 1] = bounds[2 * i] + region.GetSize(i);
+  }
+  regionGeometry->SetBounds(bounds);
+
+  auto regionImage = Image::New();
+  regionImage->Initialize(image->GetPixelType(), *regionGeometry);
+
+  ImageWriteAccessor writeAccess(regionImage);
+  if (image->GetRegionData(region, t, 0, writeAccess.GetData()).IsNull())
+    mitkThrow() << "Region " << region << " is not inside the image.";
+
+  return regionImage;
+}
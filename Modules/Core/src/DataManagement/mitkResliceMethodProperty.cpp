@@ -40,6 +40,8 @@ void mitk::ResliceMethodProperty::AddThickSlicesTypes()
   AddEnum("weighted", (IdType)3);
   AddEnum("minip", (IdType)4);
   AddEnum("mean", (IdType)5);
+  AddEnum("median", (IdType)6);
+  AddEnum("percentile", (IdType)7);
 }
 
 itk::LightObject::Pointer mitk::ResliceMethodProperty::InternalClone() const
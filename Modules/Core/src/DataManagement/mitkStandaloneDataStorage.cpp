@@ -12,16 +12,26 @@ found in the LICENSE file.
 
 #include "mitkStandaloneDataStorage.h"
 
+#include "itkCommand.h"
 #include "itkMutexLockHolder.h"
 #include "itkSimpleFastMutexLock.h"
 #include "mitkDataNode.h"
 #include "mitkGroupTagProperty.h"
+#include "mitkNodePredicateAnd.h"
 #include "mitkNodePredicateBase.h"
+#include "mitkNodePredicateDataType.h"
+#include "mitkNodePredicateOr.h"
 #include "mitkNodePredicateProperty.h"
 #include "mitkProperties.h"
 
+#include <algorithm>
+#include <iterator>
+
 mitk::StandaloneDataStorage::StandaloneDataStorage() : mitk::DataStorage()
 {
+  m_IndexedPropertyKeys.insert("name");
+  m_IndexedPropertyKeys.insert("helper object");
+  m_IndexedPropertyKeys.insert("binary");
 }
 
 mitk::StandaloneDataStorage::~StandaloneDataStorage()
@@ -30,6 +40,10 @@ mitk::StandaloneDataStorage::~StandaloneDataStorage()
   {
     this->RemoveListeners(it->first);
   }
+
+  itk::MutexLockHolder<itk::SimpleFastMutexLock> indexLocked(m_IndexMutex);
+  while (!m_IndexEntries.empty())
+    this->RemoveFromIndex(m_IndexEntries.begin()->first);
 }
 
 bool mitk::StandaloneDataStorage::IsInitialized() const
@@ -81,6 +95,9 @@ void mitk::StandaloneDataStorage::Add(mitk::DataNode *node, const mitk::DataStor
 
     // register for ITK changed events
     this->AddListeners(node);
+
+    itk::MutexLockHolder<itk::SimpleFastMutexLock> indexLocked(m_IndexMutex);
+    this->AddToIndex(node);
   }
 
   /* Notify observers */
@@ -112,6 +129,9 @@ void mitk::StandaloneDataStorage::Remove(const mitk::DataNode *node)
     /* remove node from both relation adjacency lists */
     this->RemoveFromRelation(node, m_SourceNodes);
     this->RemoveFromRelation(node, m_DerivedNodes);
+
+    itk::MutexLockHolder<itk::SimpleFastMutexLock> indexLocked(m_IndexMutex);
+    this->RemoveFromIndex(node);
   }
 }
 
@@ -251,6 +271,298 @@ mitk::DataStorage::SetOfObjects::ConstPointer mitk::StandaloneDataStorage::GetDe
   return this->GetRelations(node, m_DerivedNodes, condition, onlyDirectDerivations);
 }
 
+mitk::DataStorage::SetOfObjects::ConstPointer mitk::StandaloneDataStorage::GetSubset(
+  const NodePredicateBase *condition) const
+{
+  if (condition == nullptr)
+    return this->GetAll();
+
+  /* Collect the candidates under lock, but check the condition without holding m_Mutex, because
+     predicates (e.g. NodePredicateSource) may query the data storage themselves. */
+  std::vector<mitk::DataNode::Pointer> candidates;
+  {
+    itk::MutexLockHolder<itk::SimpleFastMutexLock> locked(m_Mutex);
+    if (!IsInitialized())
+      throw std::logic_error("DataStorage not initialized");
+
+    itk::MutexLockHolder<itk::SimpleFastMutexLock> indexLocked(m_IndexMutex);
+    this->UpdateDirtyIndexEntries();
+
+    IndexedNodeSet indexCandidates;
+    if (this->LookUpIndexCandidates(condition, indexCandidates))
+    {
+      candidates.reserve(indexCandidates.size());
+      for (auto node : indexCandidates)
+        candidates.push_back(const_cast<mitk::DataNode *>(node));
+    }
+    else
+    {
+      candidates.reserve(m_SourceNodes.size());
+      for (auto it = m_SourceNodes.cbegin(); it != m_SourceNodes.cend(); ++it)
+        if (it->first.IsNotNull())
+          candidates.push_back(const_cast<mitk::DataNode *>(it->first.GetPointer()));
+    }
+  }
+
+  mitk::DataStorage::SetOfObjects::Pointer result = mitk::DataStorage::SetOfObjects::New();
+  for (const auto &node : candidates)
+    if (condition->CheckNode(node))
+      result->InsertElement(result->Size(), node);
+
+  return SetOfObjects::ConstPointer(result);
+}
+
+void mitk::StandaloneDataStorage::AddIndexedPropertyKey(const std::string &propertyKey)
+{
+  if (propertyKey.empty())
+    throw std::invalid_argument("invalid property key");
+
+  itk::MutexLockHolder<itk::SimpleFastMutexLock> indexLocked(m_IndexMutex);
+  if (!m_IndexedPropertyKeys.insert(propertyKey).second)
+    return;
+
+  /* all nodes have to be re-indexed to cover the new key */
+  for (const auto &entry : m_IndexEntries)
+    m_DirtyIndexNodes.insert(entry.first);
+}
+
+std::set<std::string> mitk::StandaloneDataStorage::GetIndexedPropertyKeys() const
+{
+  itk::MutexLockHolder<itk::SimpleFastMutexLock> indexLocked(m_IndexMutex);
+  return m_IndexedPropertyKeys;
+}
+
+void mitk::StandaloneDataStorage::AddToIndex(const mitk::DataNode *node)
+{
+  if (node == nullptr || m_IndexEntries.find(node) != m_IndexEntries.end())
+    return;
+
+  /* node modifications cover SetData() and the addition/removal of properties */
+  itk::MemberCommand<StandaloneDataStorage>::Pointer command = itk::MemberCommand<StandaloneDataStorage>::New();
+  command->SetCallbackFunction(this, &StandaloneDataStorage::OnIndexedObjectModified);
+
+  IndexEntry &entry = m_IndexEntries[node];
+  entry.NodeObserverTag = const_cast<mitk::DataNode *>(node)->AddObserver(itk::ModifiedEvent(), command);
+  this->FillIndexEntry(node, entry);
+}
+
+void mitk::StandaloneDataStorage::RemoveFromIndex(const mitk::DataNode *node)
+{
+  auto entryIter = m_IndexEntries.find(node);
+  if (entryIter == m_IndexEntries.end())
+    return;
+
+  this->ClearIndexEntry(node, entryIter->second);
+  const_cast<mitk::DataNode *>(node)->RemoveObserver(entryIter->second.NodeObserverTag);
+  m_IndexEntries.erase(entryIter);
+  m_DirtyIndexNodes.erase(node);
+}
+
+void mitk::StandaloneDataStorage::FillIndexEntry(const mitk::DataNode *node, IndexEntry &entry)
+{
+  itk::MemberCommand<StandaloneDataStorage>::Pointer command = itk::MemberCommand<StandaloneDataStorage>::New();
+  command->SetCallbackFunction(this, &StandaloneDataStorage::OnIndexedObjectModified);
+
+  auto observe = [&](itk::Object *object) {
+    entry.Observations.push_back(std::make_pair(itk::Object::Pointer(object), object->AddObserver(itk::ModifiedEvent(), command)));
+    m_IndexObservedObjects.insert(std::make_pair(object, node));
+  };
+
+  mitk::BaseData *data = node->GetData();
+  if (data != nullptr)
+  {
+    entry.DataType = data->GetNameOfClass();
+    m_DataTypeIndex[entry.DataType].insert(node);
+
+    /* node properties fall back on data properties, so their addition/removal has to be observed too */
+    if (data->GetPropertyList().IsNotNull())
+      observe(data->GetPropertyList());
+  }
+
+  for (const auto &key : m_IndexedPropertyKeys)
+  {
+    mitk::BaseProperty *property = node->GetProperty(key.c_str());
+    if (property == nullptr)
+      continue;
+
+    /* value changes of a property are not propagated to the node, observe the property itself */
+    observe(property);
+    entry.PropertyValues[key] = property->GetValueAsString();
+    m_PropertyIndex[key][entry.PropertyValues[key]].insert(node);
+  }
+}
+
+void mitk::StandaloneDataStorage::ClearIndexEntry(const mitk::DataNode *node, IndexEntry &entry)
+{
+  if (!entry.DataType.empty())
+  {
+    auto typeIter = m_DataTypeIndex.find(entry.DataType);
+    if (typeIter != m_DataTypeIndex.end())
+    {
+      typeIter->second.erase(node);
+      if (typeIter->second.empty())
+        m_DataTypeIndex.erase(typeIter);
+    }
+  }
+
+  for (const auto &propertyValue : entry.PropertyValues)
+  {
+    auto keyIter = m_PropertyIndex.find(propertyValue.first);
+    if (keyIter == m_PropertyIndex.end())
+      continue;
+
+    auto valueIter = keyIter->second.find(propertyValue.second);
+    if (valueIter != keyIter->second.end())
+    {
+      valueIter->second.erase(node);
+      if (valueIter->second.empty())
+        keyIter->second.erase(valueIter);
+    }
+  }
+
+  for (auto &observation : entry.Observations)
+  {
+    observation.first->RemoveObserver(observation.second);
+
+    auto range = m_IndexObservedObjects.equal_range(observation.first.GetPointer());
+    for (auto observedIter = range.first; observedIter != range.second; ++observedIter)
+      if (observedIter->second == node)
+      {
+        m_IndexObservedObjects.erase(observedIter);
+        break;
+      }
+  }
+
+  entry.DataType.clear();
+  entry.PropertyValues.clear();
+  entry.Observations.clear();
+}
+
+void mitk::StandaloneDataStorage::UpdateDirtyIndexEntries() const
+{
+  if (m_DirtyIndexNodes.empty())
+    return;
+
+  auto *self = const_cast<StandaloneDataStorage *>(this);
+  for (auto node : m_DirtyIndexNodes)
+  {
+    auto entryIter = self->m_IndexEntries.find(node);
+    if (entryIter == self->m_IndexEntries.end())
+      continue;
+
+    self->ClearIndexEntry(node, entryIter->second);
+    self->FillIndexEntry(node, entryIter->second);
+  }
+  self->m_DirtyIndexNodes.clear();
+}
+
+bool mitk::StandaloneDataStorage::LookUpIndexCandidates(const NodePredicateBase *condition,
+                                                        IndexedNodeSet &candidates) const
+{
+  candidates.clear();
+
+  if (const auto *dataTypePredicate = dynamic_cast<const NodePredicateDataType *>(condition))
+  {
+    auto typeIter = m_DataTypeIndex.find(dataTypePredicate->GetValidDataType());
+    if (typeIter != m_DataTypeIndex.end())
+      candidates = typeIter->second;
+    return true;
+  }
+
+  if (const auto *propertyPredicate = dynamic_cast<const NodePredicateProperty *>(condition))
+  {
+    if (propertyPredicate->GetRenderer() != nullptr)
+      return false;
+
+    auto keyIter = m_PropertyIndex.find(propertyPredicate->GetValidPropertyName());
+    if (m_IndexedPropertyKeys.find(propertyPredicate->GetValidPropertyName()) == m_IndexedPropertyKeys.end())
+      return false;
+    if (keyIter == m_PropertyIndex.end())
+      return true;
+
+    if (propertyPredicate->GetValidProperty() == nullptr)
+    {
+      for (const auto &value : keyIter->second)
+        candidates.insert(value.second.begin(), value.second.end());
+    }
+    else
+    {
+      /* equal properties have equal string representations, so this is a superset of the matches */
+      auto valueIter = keyIter->second.find(propertyPredicate->GetValidProperty()->GetValueAsString());
+      if (valueIter != keyIter->second.end())
+        candidates = valueIter->second;
+    }
+    return true;
+  }
+
+  if (const auto *andPredicate = dynamic_cast<const NodePredicateAnd *>(condition))
+  {
+    /* intersect all children the index can answer, the others are checked on the candidates */
+    bool indexed = false;
+    for (const auto &child : andPredicate->GetPredicates())
+    {
+      IndexedNodeSet childCandidates;
+      if (!this->LookUpIndexCandidates(child, childCandidates))
+        continue;
+
+      if (!indexed)
+      {
+        candidates.swap(childCandidates);
+        indexed = true;
+      }
+      else
+      {
+        IndexedNodeSet intersection;
+        std::set_intersection(candidates.begin(),
+                              candidates.end(),
+                              childCandidates.begin(),
+                              childCandidates.end(),
+                              std::inserter(intersection, intersection.end()));
+        candidates.swap(intersection);
+      }
+
+      if (candidates.empty())
+        break;
+    }
+    return indexed;
+  }
+
+  if (const auto *orPredicate = dynamic_cast<const NodePredicateOr *>(condition))
+  {
+    /* a union is only complete if every child can be answered by the index */
+    const auto children = orPredicate->GetPredicates();
+    if (children.empty())
+      return false;
+
+    for (const auto &child : children)
+    {
+      IndexedNodeSet childCandidates;
+      if (!this->LookUpIndexCandidates(child, childCandidates))
+      {
+        candidates.clear();
+        return false;
+      }
+      candidates.insert(childCandidates.begin(), childCandidates.end());
+    }
+    return true;
+  }
+
+  return false;
+}
+
+void mitk::StandaloneDataStorage::OnIndexedObjectModified(const itk::Object *caller, const itk::EventObject &)
+{
+  itk::MutexLockHolder<itk::SimpleFastMutexLock> indexLocked(m_IndexMutex);
+
+  const auto *node = dynamic_cast<const mitk::DataNode *>(caller);
+  if (node != nullptr && m_IndexEntries.find(node) != m_IndexEntries.end())
+    m_DirtyIndexNodes.insert(node);
+
+  auto range = m_IndexObservedObjects.equal_range(caller);
+  for (auto observedIter = range.first; observedIter != range.second; ++observedIter)
+    m_DirtyIndexNodes.insert(observedIter->second);
+}
+
 void mitk::StandaloneDataStorage::PrintSelf(std::ostream &os, itk::Indent indent) const
 {
   os << indent << "StandaloneDataStorage:\n";
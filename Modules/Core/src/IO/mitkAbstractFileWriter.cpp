@@ -16,6 +16,7 @@ found in the LICENSE file.
 #include <mitkCustomMimeType.h>
 #include <mitkExceptionMacro.h>
 #include <mitkIOUtil.h>
+#include <mitkMemoryMappedFile.h>
 
 #include <mitkFileReaderWriterBase.h>
 
@@ -40,6 +41,11 @@ namespace mitk
   AbstractFileWriter::LocalFile::LocalFile(IFileWriter *writer)
     : d(new Impl(writer->GetOutputLocation(), writer->GetOutputStream()))
   {
+    // images loaded from the file to be overwritten must not reference it anymore
+    if (d->m_Stream == nullptr)
+    {
+      MemoryMappedFile::DetachMappings(d->m_Location);
+    }
   }
 
   AbstractFileWriter::LocalFile::~LocalFile()
@@ -78,6 +84,7 @@ namespace mitk
     }
     else
     {
+      MemoryMappedFile::DetachMappings(writer->GetOutputLocation());
       m_Stream = new std::ofstream(writer->GetOutputLocation().c_str(), mode);
       this->init(m_Stream->rdbuf());
     }
@@ -20,6 +20,7 @@ found in the LICENSE file.
 #include <mitkImage.h>
 #include <mitkImageReadAccessor.h>
 #include <mitkLocaleSwitch.h>
+#include <mitkMemoryMappedFile.h>
 
 #include <itkImage.h>
 #include <itkImageFileReader.h>
@@ -27,7 +28,10 @@ found in the LICENSE file.
 #include <itkImageIORegion.h>
 #include <itkMetaDataObject.h>
 
+#include <itksys/SystemTools.hxx>
+
 #include <algorithm>
+#include <fstream>
 
 namespace mitk
 {
@@ -237,6 +241,204 @@ namespace mitk
     return result;
   };
 
+  /**Helper function that splits a header line "key <separator> value" and trims key and value.*/
+  bool SplitHeaderLine(const std::string &line, const std::string &separator, std::string &key, std::string &value)
+  {
+    const auto position = line.find(separator);
+    if (std::string::npos == position)
+      return false;
+
+    key = itksys::SystemTools::TrimWhitespace(line.substr(0, position));
+    value = itksys::SystemTools::TrimWhitespace(line.substr(position + separator.size()));
+    return true;
+  }
+
+  bool IsBigEndianHost()
+  {
+    const unsigned short one = 1;
+    return 0 == *reinterpret_cast<const unsigned char *>(&one);
+  }
+
+  /**Helper function that resolves the data file of a detached header relative to the header.*/
+  std::string GetDataFileName(const std::string &headerFileName, const std::string &dataFileName)
+  {
+    const std::string headerPath = itksys::SystemTools::GetFilenamePath(headerFileName);
+    if (headerPath.empty() || itksys::SystemTools::FileIsFullPath(dataFileName))
+      return dataFileName;
+
+    return headerPath + "/" + dataFileName;
+  }
+
+  /**Helper function that checks if the pixel data of a MetaImage file (mha/mhd) are stored in a single
+   * uncompressed binary file in native byte order and determines file and offset of the data.*/
+  bool GetMetaImageDataLocation(const std::string &path, std::size_t dataSize, std::string &dataFileName, long long &offset)
+  {
+    std::ifstream header(path.c_str(), std::ios::binary);
+    std::string line, key, value, lowerValue;
+    bool binaryData = false;
+    bool isBigEndian = IsBigEndianHost();
+    long long headerSize = 0;
+
+    while (std::getline(header, line))
+    {
+      if (!SplitHeaderLine(line, "=", key, value))
+        continue;
+
+      lowerValue = itksys::SystemTools::LowerCase(value);
+
+      if ("CompressedData" == key && "false" != lowerValue)
+        return false;
+      else if ("BinaryData" == key)
+        binaryData = "true" == lowerValue;
+      else if ("BinaryDataByteOrderMSB" == key || "ElementByteOrderMSB" == key)
+        isBigEndian = "true" == lowerValue;
+      else if ("HeaderSize" == key)
+        headerSize = std::stoll(value);
+      else if ("ElementDataFile" == key)
+      {
+        // the element data file is always the last entry of the header
+        if ("local" == lowerValue)
+        {
+          dataFileName = path;
+          offset = headerSize == -1 ? -1 : static_cast<long long>(header.tellg()) + headerSize;
+        }
+        else
+        {
+          // lists of files and file name patterns are not mapped
+          if ("list" == lowerValue.substr(0, 4) || std::string::npos != value.find('%') || std::string::npos != value.find(' '))
+            return false;
+
+          dataFileName = GetDataFileName(path, value);
+          offset = headerSize;
+        }
+        break;
+      }
+    }
+
+    if (!binaryData || dataFileName.empty() || isBigEndian != IsBigEndianHost())
+      return false;
+
+    if (-1 == offset)
+      offset = MemoryMappedFile::GetFileSize(dataFileName) - static_cast<long long>(dataSize);
+
+    return true;
+  }
+
+  /**Helper function that checks if the pixel data of a NRRD file are stored in a single file with raw
+   * encoding in native byte order and determines file and offset of the data.*/
+  bool GetNrrdDataLocation(const std::string &path, std::size_t dataSize, std::string &dataFileName, long long &offset)
+  {
+    std::ifstream header(path.c_str(), std::ios::binary);
+    std::string line, key, value;
+
+    if (!std::getline(header, line) || 0 != line.compare(0, 4, "NRRD"))
+      return false;
+
+    bool rawEncoding = false;
+    bool isBigEndian = IsBigEndianHost();
+    long long byteSkip = 0;
+    bool isHeaderComplete = false;
+
+    while (std::getline(header, line))
+    {
+      line = itksys::SystemTools::TrimWhitespace(line);
+
+      // an empty line separates the header from attached data
+      if (line.empty())
+      {
+        isHeaderComplete = true;
+        break;
+      }
+
+      // skip comments and key/value pairs, which do not affect the data
+      if ('#' == line[0] || std::string::npos != line.find(":=") || !SplitHeaderLine(line, ":", key, value))
+        continue;
+
+      if ("encoding" == key)
+        rawEncoding = "raw" == value;
+      else if ("endian" == key)
+        isBigEndian = "big" == value;
+      else if ("byte skip" == key || "byteskip" == key)
+        byteSkip = std::stoll(value);
+      else if ("line skip" == key || "lineskip" == key)
+      {
+        if (0 != std::stoll(value))
+          return false;
+      }
+      else if ("data file" == key || "datafile" == key)
+      {
+        // lists of files and file name patterns are not mapped
+        if (0 == value.compare(0, 4, "LIST") || std::string::npos != value.find(' '))
+          return false;
+
+        dataFileName = GetDataFileName(path, value);
+      }
+    }
+
+    if (!rawEncoding || isBigEndian != IsBigEndianHost())
+      return false;
+
+    if (dataFileName.empty())
+    {
+      if (!isHeaderComplete)
+        return false;
+
+      dataFileName = path;
+      offset = static_cast<long long>(header.tellg());
+    }
+    else
+    {
+      offset = 0;
+    }
+
+    if (-1 == byteSkip)
+      offset = MemoryMappedFile::GetFileSize(dataFileName) - static_cast<long long>(dataSize);
+    else
+      offset += byteSkip;
+
+    return true;
+  }
+
+  /**Helper function that maps the pixel data of uncompressed MetaImage and NRRD files instead of
+   * reading them. Returns nullptr if the data cannot be mapped, e.g. because it is compressed or
+   * stored in foreign byte order.*/
+  MemoryMappedFile::Pointer MapPixelData(const itk::ImageIOBase *imageIO, const std::string &path)
+  {
+#ifdef _WIN32
+    // Windows does not allow to overwrite a mapped file, which would break saving an image
+    // to the file it was loaded from
+    return nullptr;
+#else
+    const std::size_t dataSize = imageIO->GetImageSizeInBytes();
+    const std::string imageIOName = imageIO->GetNameOfClass();
+
+    std::string dataFileName;
+    long long offset = -1;
+
+    try
+    {
+      bool isMappable = false;
+
+      if ("MetaImageIO" == imageIOName)
+        isMappable = GetMetaImageDataLocation(path, dataSize, dataFileName, offset);
+      // ITK permutes the axes of NRRD files whose components are not stored first
+      else if ("NrrdImageIO" == imageIOName && 1 == imageIO->GetNumberOfComponents())
+        isMappable = GetNrrdDataLocation(path, dataSize, dataFileName, offset);
+
+      if (!isMappable || offset < 0)
+        return nullptr;
+
+      return MemoryMappedFile::New(dataFileName, static_cast<std::size_t>(offset), dataSize);
+    }
+    catch (const std::exception &e)
+    {
+      MITK_WARN << "Pixel data of " << path << " cannot be mapped, it is read instead: " << e.what();
+    }
+
+    return nullptr;
+#endif
+  }
+
   std::vector<BaseData::Pointer> ItkImageIO::Read()
   {
     std::vector<BaseData::Pointer> result;
@@ -263,6 +465,7 @@ namespace mitk
     m_ImageIO->ReadImageInformation();
 
     unsigned int ndim = m_ImageIO->GetNumberOfDimensions();
+    const bool isFileDimensionSupported = ndim >= MINDIM && ndim <= MAXDIM;
     if (ndim < MINDIM || ndim > MAXDIM)
     {
       MITK_WARN << "Sorry, only dimensions 2, 3 and 4 are supported. The given file has " << ndim
@@ -312,11 +515,17 @@ namespace mitk
 
     MITK_INFO << "ioRegion: " << ioRegion << std::endl;
     m_ImageIO->SetIORegion(ioRegion);
-    void *buffer = new unsigned char[m_ImageIO->GetImageSizeInBytes()];
-    m_ImageIO->Read(buffer);
 
     image->Initialize(MakePixelType(m_ImageIO), ndim, dimensions);
-    image->SetImportChannel(buffer, 0, Image::ManageMemory);
+
+    // Uncompressed pixel data is mapped, so it is read lazily when it is accessed for the first time.
+    MemoryMappedFile::Pointer mappedFile = isFileDimensionSupported ? MapPixelData(m_ImageIO, path) : nullptr;
+    if (mappedFile.IsNull() || !image->SetMappedChannel(mappedFile))
+    {
+      void *buffer = new unsigned char[m_ImageIO->GetImageSizeInBytes()];
+      m_ImageIO->Read(buffer);
+      image->SetImportChannel(buffer, 0, Image::ManageMemory);
+    }
 
     const itk::MetaDataDictionary &dictionary = m_ImageIO->GetMetaDataDictionary();
 
@@ -530,6 +739,15 @@ namespace mitk
 
     MITK_INFO << "Writing image: " << path << std::endl;
 
+    // the output location is detached by LocalFile, but a MetaImage header is written together with a data file
+    const std::string extension = itksys::SystemTools::GetFilenameLastExtension(path);
+    if (itksys::SystemTools::LowerCase(extension) == ".mhd")
+    {
+      const std::string dataFileName = path.substr(0, path.size() - extension.size());
+      MemoryMappedFile::DetachMappings(dataFileName + ".raw");
+      MemoryMappedFile::DetachMappings(dataFileName + ".zraw");
+    }
+
     try
     {
       // Implementation of writer using itkImageIO directly. This skips the use
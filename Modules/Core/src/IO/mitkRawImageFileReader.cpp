@@ -15,7 +15,9 @@ found in the LICENSE file.
 #include "mitkIOMimeTypes.h"
 #include "mitkITKImageImport.h"
 #include "mitkImageCast.h"
+#include "mitkMemoryMappedFile.h"
 
+#include <itkByteSwapper.h>
 #include <itkImage.h>
 #include <itkImageFileReader.h>
 #include <itkRawImageIO.h>
@@ -176,6 +178,36 @@ mitk::BaseData::Pointer mitk::RawImageFileReaderService::TypedRead(const std::st
   reader->SetImageIO(io);
   reader->SetFileName(path);
 
+#ifndef _WIN32
+  // Pixel data in native byte order is mapped, so it is read lazily when it is accessed for the first time.
+  // The data is located at the end of the file, like itk::RawImageIO assumes without a given header size.
+  if ((endianity == BIG) == itk::ByteSwapper<TPixel>::SystemIsBigEndian())
+  {
+    try
+    {
+      reader->UpdateOutputInformation();
+
+      const long long fileSize = MemoryMappedFile::GetFileSize(path);
+      const std::size_t dataSize = reader->GetOutput()->GetLargestPossibleRegion().GetNumberOfPixels() * sizeof(TPixel);
+
+      if (fileSize >= static_cast<long long>(dataSize))
+      {
+        auto mappedFile = MemoryMappedFile::New(path, static_cast<std::size_t>(fileSize) - dataSize, dataSize);
+
+        mitk::Image::Pointer image = mitk::Image::New();
+        image->InitializeByItk(reader->GetOutput());
+
+        if (image->SetMappedChannel(mappedFile))
+          return image.GetPointer();
+      }
+    }
+    catch (const std::exception &e)
+    {
+      MITK_WARN << "Pixel data of " << path << " cannot be mapped, it is read instead: " << e.what();
+    }
+  }
+#endif
+
   try
   {
     reader->Update();
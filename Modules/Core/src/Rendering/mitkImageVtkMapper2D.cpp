@@ -17,10 +17,13 @@ found in the LICENSE file.
 #include <mitkLevelWindowProperty.h>
 #include <mitkLookupTableProperty.h>
 #include <mitkPixelType.h>
+#include <mitkPlaneBoundingRegion.h>
 #include <mitkPlaneGeometry.h>
 #include <mitkProperties.h>
 #include <mitkPropertyNameHelper.h>
+#include <mitkRenderingManager.h>
 #include <mitkResliceMethodProperty.h>
+#include <mitkSlicedGeometry3D.h>
 #include <mitkVtkResliceInterpolationProperty.h>
 
 //#include <mitkTransferFunction.h>
@@ -55,6 +58,8 @@ found in the LICENSE file.
 #include <itkRGBAPixel.h>
 #include <mitkRenderingModeProperty.h>
 
+#include <algorithm>
+
 mitk::ImageVtkMapper2D::ImageVtkMapper2D()
 {
 }
@@ -144,14 +149,7 @@ void mitk::ImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer *rendere
     return;
   }
 
-  // set main input for ExtractSliceFilter
-  localStorage->m_Reslicer->SetInput(image);
   localStorage->m_Reslicer->SetWorldGeometry(worldGeometry);
-  localStorage->m_Reslicer->SetTimeStep(this->GetTimestep());
-
-  // set the transformation of the image to adapt reslice axis
-  localStorage->m_Reslicer->SetResliceTransformByGeometry(
-    image->GetTimeGeometry()->GetGeometryForTimeStep(this->GetTimestep()));
 
   // is the geometry of the slice based on the input image or the worldgeometry?
   bool inPlaneResampleExtentByGeometry = false;
@@ -160,6 +158,7 @@ void mitk::ImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer *rendere
 
   // Initialize the interpolation mode for resampling; switch to nearest
   // neighbor if the input image is too small.
+  ExtractSliceFilter::ResliceInterpolation resliceInterpolation = ExtractSliceFilter::RESLICE_NEAREST;
   if ((image->GetDimension() >= 3) && (image->GetDimension(2) > 1))
   {
     VtkResliceInterpolationProperty *resliceInterpolationProperty;
@@ -174,20 +173,17 @@ void mitk::ImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer *rendere
     switch (interpolationMode)
     {
       case VTK_RESLICE_NEAREST:
-        localStorage->m_Reslicer->SetInterpolationMode(ExtractSliceFilter::RESLICE_NEAREST);
+        resliceInterpolation = ExtractSliceFilter::RESLICE_NEAREST;
         break;
       case VTK_RESLICE_LINEAR:
-        localStorage->m_Reslicer->SetInterpolationMode(ExtractSliceFilter::RESLICE_LINEAR);
+        resliceInterpolation = ExtractSliceFilter::RESLICE_LINEAR;
         break;
       case VTK_RESLICE_CUBIC:
-        localStorage->m_Reslicer->SetInterpolationMode(ExtractSliceFilter::RESLICE_CUBIC);
+        resliceInterpolation = ExtractSliceFilter::RESLICE_CUBIC;
         break;
     }
   }
-  else
-  {
-    localStorage->m_Reslicer->SetInterpolationMode(ExtractSliceFilter::RESLICE_NEAREST);
-  }
+  localStorage->m_Reslicer->SetInterpolationMode(resliceInterpolation);
 
   // set the vtk output property to true, makes sure that no unneeded mitk image convertion
   // is done.
@@ -196,6 +192,7 @@ void mitk::ImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer *rendere
   // Thickslicing
   int thickSlicesMode = 0;
   int thickSlicesNum = 1;
+  float thickSlicesPercentile = 90.0f;
   // Thick slices parameters
   if (image->GetPixelType().GetNumberOfComponents() == 1) // for now only single component are allowed
   {
@@ -214,6 +211,8 @@ void mitk::ImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer *rendere
         if (thickSlicesNum < 1)
           thickSlicesNum = 1;
       }
+
+      dn->GetFloatProperty("reslice.thickslices.percentile", thickSlicesPercentile, renderer);
     }
     else
     {
@@ -223,7 +222,61 @@ void mitk::ImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer *rendere
 
   const auto *planeGeometry = dynamic_cast<const PlaneGeometry *>(worldGeometry);
 
-  if (thickSlicesMode > 0)
+  // Look up the slice in the cache. Slices of progressively loaded images change without a call to
+  // Modified(), so they are not cached until the image is loaded completely.
+  int resliceCacheSize = 32;
+  datanode->GetIntProperty("reslice cache size", resliceCacheSize, renderer);
+  if (image->IsLoadingProgressively())
+  {
+    localStorage->m_ResliceCache.Clear();
+    resliceCacheSize = 0;
+  }
+  localStorage->m_ResliceCache.SetCapacity(std::max(resliceCacheSize, 0));
+
+  const bool useResliceCache = resliceCacheSize > 0 && planeGeometry != nullptr &&
+                               dynamic_cast<const AbstractTransformGeometry *>(worldGeometry) == nullptr;
+
+  ResliceCache::Key sliceKey;
+  ResliceCache::Slice slice;
+  bool isSliceCached = false;
+  if (useResliceCache)
+  {
+    sliceKey = ResliceCache::CreateKey(image,
+                                       planeGeometry,
+                                       this->GetTimestep(),
+                                       resliceInterpolation,
+                                       inPlaneResampleExtentByGeometry,
+                                       thickSlicesMode,
+                                       thickSlicesNum,
+                                       thickSlicesMode == 7 ? thickSlicesPercentile : 0.0);
+    isSliceCached = localStorage->m_ResliceCache.Find(sliceKey, slice);
+  }
+
+  // set main input for ExtractSliceFilter. Of bricked images only the region around the plane
+  // (enlarged by the thick slices and the interpolation kernel) is read, and only if the slice
+  // is not cached.
+  Image::Pointer resliceInput = image;
+  TimeStepType resliceTimeStep = this->GetTimestep();
+  if (!isSliceCached && nullptr != image->GetBrickedStorage() && nullptr != planeGeometry &&
+      nullptr == dynamic_cast<const AbstractTransformGeometry *>(worldGeometry))
+  {
+    const auto region = PlaneBoundingRegion::Compute(
+      image->GetTimeGeometry()->GetGeometryForTimeStep(resliceTimeStep), planeGeometry, thickSlicesNum + 2);
+    resliceInput = PlaneBoundingRegion::ExtractImage(image, region, resliceTimeStep);
+    resliceTimeStep = 0;
+  }
+  localStorage->m_Reslicer->SetInput(resliceInput);
+  localStorage->m_Reslicer->SetTimeStep(resliceTimeStep);
+
+  // set the transformation of the image to adapt reslice axis
+  localStorage->m_Reslicer->SetResliceTransformByGeometry(
+    resliceInput->GetTimeGeometry()->GetGeometryForTimeStep(resliceTimeStep));
+
+  if (isSliceCached)
+  {
+    localStorage->m_ReslicedImage = slice.image;
+  }
+  else if (thickSlicesMode > 0)
   {
     double dataZSpacing = 1.0;
 
@@ -248,23 +301,55 @@ void mitk::ImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer *rendere
 
     dataZSpacing = 1.0 / normInIndex.GetNorm();
 
-    localStorage->m_Reslicer->SetOutputDimensionality(3);
-    localStorage->m_Reslicer->SetOutputSpacingZDirection(dataZSpacing);
-    localStorage->m_Reslicer->SetOutputExtentZDirection(-thickSlicesNum, 0 + thickSlicesNum);
-
-    // Do the reslicing. Modified() is called to make sure that the reslicer is
-    // executed even though the input geometry information did not change; this
-    // is necessary when the input /em data, but not the /em geometry changes.
-    localStorage->m_TSFilter->SetThickSliceMode(thickSlicesMode - 1);
-    localStorage->m_TSFilter->SetInputData(localStorage->m_Reslicer->GetVtkOutput());
-
-    // vtkFilter=>mitkFilter=>vtkFilter update mechanism will fail without calling manually
-    localStorage->m_Reslicer->Modified();
-    localStorage->m_Reslicer->Update();
+    // mip, minip and sum (which is an average, see vtkMitkThickSlicesFilter) are reduced by the reslicer
+    // while it samples the slab, so the slab is never materialized as 3D image.
+    int slabMode = -1;
+    switch (thickSlicesMode)
+    {
+      case 1:
+        slabMode = VTK_IMAGE_SLAB_MAX;
+        break;
+      case 2:
+        slabMode = VTK_IMAGE_SLAB_MEAN;
+        break;
+      case 4:
+        slabMode = VTK_IMAGE_SLAB_MIN;
+        break;
+    }
 
-    localStorage->m_TSFilter->Modified();
-    localStorage->m_TSFilter->Update();
-    localStorage->m_ReslicedImage = localStorage->m_TSFilter->GetOutput();
+    if (slabMode >= 0)
+    {
+      localStorage->m_Reslicer->SetOutputDimensionality(2);
+      localStorage->m_Reslicer->SetOutputSpacingZDirection(dataZSpacing);
+      localStorage->m_Reslicer->SetOutputExtentZDirection(0, 0);
+      localStorage->m_Reslicer->SetSlabMode(slabMode, 2 * thickSlicesNum + 1);
+
+      localStorage->m_Reslicer->Modified();
+      localStorage->m_Reslicer->UpdateLargestPossibleRegion();
+      localStorage->m_ReslicedImage = localStorage->m_Reslicer->GetVtkOutput();
+    }
+    else
+    {
+      localStorage->m_Reslicer->SetOutputDimensionality(3);
+      localStorage->m_Reslicer->SetOutputSpacingZDirection(dataZSpacing);
+      localStorage->m_Reslicer->SetOutputExtentZDirection(-thickSlicesNum, 0 + thickSlicesNum);
+      localStorage->m_Reslicer->SetSlabMode(VTK_IMAGE_SLAB_MEAN, 1);
+
+      // Do the reslicing. Modified() is called to make sure that the reslicer is
+      // executed even though the input geometry information did not change; this
+      // is necessary when the input /em data, but not the /em geometry changes.
+      localStorage->m_TSFilter->SetThickSliceMode(thickSlicesMode - 1);
+      localStorage->m_TSFilter->SetPercentile(thickSlicesPercentile);
+      localStorage->m_TSFilter->SetInputData(localStorage->m_Reslicer->GetVtkOutput());
+
+      // vtkFilter=>mitkFilter=>vtkFilter update mechanism will fail without calling manually
+      localStorage->m_Reslicer->Modified();
+      localStorage->m_Reslicer->Update();
+
+      localStorage->m_TSFilter->Modified();
+      localStorage->m_TSFilter->Update();
+      localStorage->m_ReslicedImage = localStorage->m_TSFilter->GetOutput();
+    }
   }
   else
   {
@@ -272,6 +357,7 @@ void mitk::ImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer *rendere
     localStorage->m_Reslicer->SetOutputDimensionality(2);
     localStorage->m_Reslicer->SetOutputSpacingZDirection(1.0);
     localStorage->m_Reslicer->SetOutputExtentZDirection(0, 0);
+    localStorage->m_Reslicer->SetSlabMode(VTK_IMAGE_SLAB_MEAN, 1);
 
     localStorage->m_Reslicer->Modified();
     // start the pipeline with updating the largest possible, needed if the geometry of the input has changed
@@ -279,6 +365,45 @@ void mitk::ImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer *rendere
     localStorage->m_ReslicedImage = localStorage->m_Reslicer->GetVtkOutput();
   }
 
+  if (!isSliceCached)
+  {
+    if (useResliceCache)
+    {
+      slice = ResliceCache::CreateSlice(localStorage->m_ReslicedImage, localStorage->m_Reslicer);
+      localStorage->m_ResliceCache.Insert(sliceKey, slice);
+    }
+    else
+    {
+      slice.resliceAxes = vtkSmartPointer<vtkMatrix4x4>::New();
+      slice.resliceAxes->DeepCopy(localStorage->m_Reslicer->GetResliceAxes());
+      slice.spacing[0] = localStorage->m_Reslicer->GetOutputSpacing()[0];
+      slice.spacing[1] = localStorage->m_Reslicer->GetOutputSpacing()[1];
+    }
+  }
+  localStorage->m_ResliceAxes = slice.resliceAxes;
+
+  // reslice the neighbouring slices in the background, as the user most probably scrolls to them next
+  if (useResliceCache && thickSlicesMode == 0 && renderer->GetWorldTimeGeometry() != nullptr)
+  {
+    BaseGeometry::Pointer rendererGeometry =
+      renderer->GetWorldTimeGeometry()->GetGeometryForTimeStep(renderer->GetTimeStep());
+    const auto *slicedGeometry = dynamic_cast<const SlicedGeometry3D *>(rendererGeometry.GetPointer());
+    if (slicedGeometry != nullptr)
+    {
+      const int currentSlice = static_cast<int>(renderer->GetSlice());
+      std::vector<PlaneGeometry::ConstPointer> neighbours;
+      for (int distance : {1, -1, 2, -2})
+      {
+        if (slicedGeometry->IsValidSlice(currentSlice + distance))
+        {
+          neighbours.emplace_back(slicedGeometry->GetPlaneGeometry(currentSlice + distance));
+        }
+      }
+      localStorage->m_ResliceCache.Prefetch(
+        image, neighbours, this->GetTimestep(), resliceInterpolation, inPlaneResampleExtentByGeometry);
+    }
+  }
+
   // Bounds information for reslicing (only reuqired if reference geometry
   // is present)
   // this used for generating a vtkPLaneSource with the right size
@@ -290,7 +415,9 @@ void mitk::ImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer *rendere
   localStorage->m_Reslicer->GetClippedPlaneBounds(sliceBounds);
 
   // get the spacing of the slice
-  localStorage->m_mmPerPixel = localStorage->m_Reslicer->GetOutputSpacing();
+  localStorage->m_CachedSpacing[0] = slice.spacing[0];
+  localStorage->m_CachedSpacing[1] = slice.spacing[1];
+  localStorage->m_mmPerPixel = localStorage->m_CachedSpacing;
 
   // calculate minimum bounding rect of IMAGE in texture
   {
@@ -675,6 +802,20 @@ void mitk::ImageVtkMapper2D::Update(mitk::BaseRenderer *renderer)
   {
     this->GenerateDataForRenderer(renderer);
   }
+  else if (data->GetNumberOfLoadedSlices() != localStorage->m_NumberOfLoadedSlices)
+  {
+    // slices of a progressively loaded image arrived without a call to Modified(),
+    // so the reslicer has to be told that its input changed
+    data->GetVtkImageData(this->GetTimestep())->Modified();
+    this->GenerateDataForRenderer(renderer);
+  }
+  localStorage->m_NumberOfLoadedSlices = data->GetNumberOfLoadedSlices();
+
+  // keep polling for new slices until the image is loaded completely
+  if (data->IsLoadingProgressively())
+  {
+    RenderingManager::GetInstance()->RequestUpdate(renderer->GetRenderWindow());
+  }
 
   // since we have checked that nothing important has changed, we can set
   // m_LastUpdateTime to the current time
@@ -1028,7 +1169,7 @@ void mitk::ImageVtkMapper2D::TransformActor(mitk::BaseRenderer *renderer)
   LocalStorage *localStorage = m_LSH.GetLocalStorage(renderer);
   // get the transformation matrix of the reslicer in order to render the slice as axial, coronal or saggital
   vtkSmartPointer<vtkTransform> trans = vtkSmartPointer<vtkTransform>::New();
-  vtkSmartPointer<vtkMatrix4x4> matrix = localStorage->m_Reslicer->GetResliceAxes();
+  vtkSmartPointer<vtkMatrix4x4> matrix = localStorage->m_ResliceAxes;
   trans->SetMatrix(matrix);
   // transform the plane/contour (the actual actor) to the corresponding view (axial, coronal or saggital)
   localStorage->m_Actor->SetUserTransform(trans);
@@ -1077,7 +1218,7 @@ mitk::ImageVtkMapper2D::LocalStorage::~LocalStorage()
 }
 
 mitk::ImageVtkMapper2D::LocalStorage::LocalStorage()
-  : m_VectorComponentExtractor(vtkSmartPointer<vtkImageExtractComponents>::New())
+  : m_VectorComponentExtractor(vtkSmartPointer<vtkImageExtractComponents>::New()), m_NumberOfLoadedSlices(0)
 {
   m_LevelWindowFilter = vtkSmartPointer<vtkMitkLevelWindowFilter>::New();
 
@@ -1094,6 +1235,10 @@ mitk::ImageVtkMapper2D::LocalStorage::LocalStorage()
   m_TSFilter = vtkSmartPointer<vtkMitkThickSlicesFilter>::New();
   m_OutlinePolyData = vtkSmartPointer<vtkPolyData>::New();
   m_ReslicedImage = vtkSmartPointer<vtkImageData>::New();
+  m_ResliceAxes = vtkSmartPointer<vtkMatrix4x4>::New();
+  m_CachedSpacing[0] = 1.0;
+  m_CachedSpacing[1] = 1.0;
+  m_mmPerPixel = m_CachedSpacing;
   m_EmptyPolyData = vtkSmartPointer<vtkPolyData>::New();
 
   // the following actions are always the same and thus can be performed
@@ -0,0 +1,381 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkResliceCache.h"
+
+#include <mitkImageReadAccessor.h>
+#include <mitkLogMacros.h>
+
+#include <algorithm>
+
+bool mitk::ResliceCache::Key::operator==(const Key &other) const
+{
+  return image == other.image && imageTime == other.imageTime && timeStep == other.timeStep &&
+         interpolationMode == other.interpolationMode &&
+         inPlaneResampleExtentByGeometry == other.inPlaneResampleExtentByGeometry &&
+         thickSlicesMode == other.thickSlicesMode && thickSlicesNum == other.thickSlicesNum &&
+         thickSlicesPercentile == other.thickSlicesPercentile &&
+         std::equal(plane, plane + 18, other.plane);
+}
+
+mitk::ResliceCache::Key mitk::ResliceCache::CreateKey(const Image *image,
+                                                      const PlaneGeometry *plane,
+                                                      TimeStepType timeStep,
+                                                      ExtractSliceFilter::ResliceInterpolation interpolationMode,
+                                                      bool inPlaneResampleExtentByGeometry,
+                                                      int thickSlicesMode,
+                                                      int thickSlicesNum,
+                                                      double thickSlicesPercentile)
+{
+  Key key;
+  key.image = image;
+  key.imageTime = image->GetMTime();
+  const BaseGeometry *imageGeometry = image->GetTimeGeometry()->GetGeometryForTimeStep(timeStep);
+  if (imageGeometry != nullptr)
+  {
+    key.imageTime = std::max(key.imageTime, imageGeometry->GetMTime());
+  }
+
+  // the slice is compared by value, as the renderers pass clones of the planes of their sliced geometry
+  const auto &matrix = plane->GetIndexToWorldTransform()->GetMatrix();
+  const auto &offset = plane->GetIndexToWorldTransform()->GetOffset();
+  const auto &bounds = plane->GetBounds();
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    for (unsigned int j = 0; j < 3; ++j)
+    {
+      key.plane[i * 3 + j] = matrix[i][j];
+    }
+    key.plane[9 + i] = offset[i];
+  }
+  for (unsigned int i = 0; i < 6; ++i)
+  {
+    key.plane[12 + i] = bounds[i];
+  }
+
+  key.timeStep = timeStep;
+  key.interpolationMode = interpolationMode;
+  key.inPlaneResampleExtentByGeometry = inPlaneResampleExtentByGeometry;
+  key.thickSlicesMode = thickSlicesMode;
+  key.thickSlicesNum = thickSlicesNum;
+  key.thickSlicesPercentile = thickSlicesPercentile;
+  return key;
+}
+
+mitk::ResliceCache::Slice mitk::ResliceCache::CreateSlice(vtkImageData *image, ExtractSliceFilter *reslicer)
+{
+  Slice slice;
+  slice.image = vtkSmartPointer<vtkImageData>::New();
+  slice.image->DeepCopy(image);
+  slice.resliceAxes = vtkSmartPointer<vtkMatrix4x4>::New();
+  slice.resliceAxes->DeepCopy(reslicer->GetResliceAxes());
+  const ScalarType *spacing = reslicer->GetOutputSpacing();
+  slice.spacing[0] = spacing[0];
+  slice.spacing[1] = spacing[1];
+  return slice;
+}
+
+mitk::ResliceCache::ResliceCache()
+  : m_Capacity(32),
+    m_PrefetchImageTime(0),
+    m_PrefetchTimeStep(0),
+    m_PrefetchInterpolationMode(ExtractSliceFilter::RESLICE_NEAREST),
+    m_PrefetchInPlaneResampleExtentByGeometry(false),
+    m_Prefetching(false),
+    m_StopPrefetchThread(false)
+{
+}
+
+mitk::ResliceCache::~ResliceCache()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_StopPrefetchThread = true;
+    m_PrefetchRequests.clear();
+  }
+  m_PrefetchCondition.notify_all();
+
+  if (m_PrefetchThread.joinable())
+  {
+    m_PrefetchThread.join();
+  }
+}
+
+void mitk::ResliceCache::SetCapacity(unsigned int capacity)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_Capacity = capacity;
+  while (m_Entries.size() > m_Capacity)
+  {
+    m_Entries.pop_back();
+  }
+}
+
+unsigned int mitk::ResliceCache::GetCapacity() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_Capacity;
+}
+
+unsigned int mitk::ResliceCache::GetNumberOfSlices() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return static_cast<unsigned int>(m_Entries.size());
+}
+
+bool mitk::ResliceCache::Find(const Key &key, Slice &slice)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  for (auto iter = m_Entries.begin(); iter != m_Entries.end(); ++iter)
+  {
+    if (iter->first == key)
+    {
+      m_Entries.splice(m_Entries.begin(), m_Entries, iter);
+      slice = m_Entries.front().second;
+      return true;
+    }
+  }
+  return false;
+}
+
+void mitk::ResliceCache::Insert(const Key &key, const Slice &slice)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  this->InsertUnlocked(key, slice);
+}
+
+void mitk::ResliceCache::Clear()
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_Entries.clear();
+  m_PrefetchRequests.clear();
+  m_PrefetchImage = nullptr;
+  m_PrefetchSourceImage = nullptr;
+  m_PrefetchVolume = nullptr;
+}
+
+void mitk::ResliceCache::InsertUnlocked(const Key &key, const Slice &slice)
+{
+  if (m_Capacity == 0)
+  {
+    return;
+  }
+
+  for (auto iter = m_Entries.begin(); iter != m_Entries.end(); ++iter)
+  {
+    if (iter->first == key)
+    {
+      m_Entries.erase(iter);
+      break;
+    }
+  }
+
+  m_Entries.emplace_front(key, slice);
+  while (m_Entries.size() > m_Capacity)
+  {
+    m_Entries.pop_back();
+  }
+}
+
+bool mitk::ResliceCache::ContainsUnlocked(const Key &key) const
+{
+  for (const auto &entry : m_Entries)
+  {
+    if (entry.first == key)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+void mitk::ResliceCache::Prefetch(const Image *image,
+                                  const std::vector<PlaneGeometry::ConstPointer> &planes,
+                                  TimeStepType timeStep,
+                                  ExtractSliceFilter::ResliceInterpolation interpolationMode,
+                                  bool inPlaneResampleExtentByGeometry)
+{
+  // the worker reslices the whole volume, which would materialize bricked images
+  if (nullptr == image || !image->IsInitialized() || !image->IsVolumeSet(timeStep) ||
+      image->GetNumberOfChannels() != 1 || nullptr != image->GetBrickedStorage())
+  {
+    return;
+  }
+
+  std::vector<std::pair<Key, PlaneGeometry::ConstPointer>> requests;
+  requests.reserve(planes.size());
+  for (const auto &plane : planes)
+  {
+    if (plane.IsNotNull())
+    {
+      requests.emplace_back(
+        CreateKey(image, plane, timeStep, interpolationMode, inPlaneResampleExtentByGeometry), plane);
+    }
+  }
+
+  if (requests.empty())
+  {
+    return;
+  }
+
+  const itk::ModifiedTimeType imageTime = requests.front().first.imageTime;
+
+  std::unique_lock<std::mutex> lock(m_Mutex);
+  if (m_Capacity == 0)
+  {
+    return;
+  }
+
+  requests.erase(std::remove_if(requests.begin(),
+                                requests.end(),
+                                [this](const std::pair<Key, PlaneGeometry::ConstPointer> &request) {
+                                  return this->ContainsUnlocked(request.first);
+                                }),
+                 requests.end());
+
+  if (requests.empty())
+  {
+    return;
+  }
+
+  // the worker must not touch the pipeline of the rendered image; so it gets an own image that
+  // references the memory of the requested volume. The volume item keeps this memory alive.
+  if (m_PrefetchImage.IsNull() || m_PrefetchSourceImage.GetPointer() != image || m_PrefetchImageTime != imageTime ||
+      m_PrefetchTimeStep != timeStep)
+  {
+    lock.unlock();
+    Image::Pointer prefetchImage = Image::New();
+    prefetchImage->Initialize(image);
+    ImageDataItem::ConstPointer volume = image->GetVolumeData(timeStep).GetPointer();
+    if (volume.IsNull())
+    {
+      return;
+    }
+
+    try
+    {
+      // only reads the address, the worker reads the memory under its own read access
+      ImageReadAccessor accessor(image, volume, ImageAccessorBase::ExceptionIfLocked);
+      if (!prefetchImage->SetImportVolume(
+            const_cast<void *>(accessor.GetData()), timeStep, 0, Image::ReferenceMemory))
+      {
+        return;
+      }
+    }
+    catch (const MemoryIsLockedException &)
+    {
+      // the volume is written right now, its slices would be outdated anyway
+      return;
+    }
+    lock.lock();
+
+    m_PrefetchImage = prefetchImage;
+    m_PrefetchSourceImage = image;
+    m_PrefetchVolume = volume;
+    m_PrefetchImageTime = imageTime;
+    m_PrefetchTimeStep = timeStep;
+  }
+
+  m_PrefetchRequests = std::move(requests);
+  m_PrefetchInterpolationMode = interpolationMode;
+  m_PrefetchInPlaneResampleExtentByGeometry = inPlaneResampleExtentByGeometry;
+
+  if (!m_PrefetchThread.joinable())
+  {
+    m_PrefetchThread = std::thread(&ResliceCache::RunPrefetchThread, this);
+  }
+
+  lock.unlock();
+  m_PrefetchCondition.notify_one();
+}
+
+void mitk::ResliceCache::WaitForPrefetch()
+{
+  std::unique_lock<std::mutex> lock(m_Mutex);
+  m_PrefetchFinished.wait(lock, [this] { return m_StopPrefetchThread || (m_PrefetchRequests.empty() && !m_Prefetching); });
+}
+
+void mitk::ResliceCache::RunPrefetchThread()
+{
+  ExtractSliceFilter::Pointer reslicer = ExtractSliceFilter::New();
+  reslicer->SetVtkOutputRequest(true);
+  reslicer->SetOutputDimensionality(2);
+
+  std::unique_lock<std::mutex> lock(m_Mutex);
+  while (true)
+  {
+    m_PrefetchCondition.wait(lock, [this] { return m_StopPrefetchThread || !m_PrefetchRequests.empty(); });
+
+    if (m_StopPrefetchThread)
+    {
+      break;
+    }
+
+    const Key key = m_PrefetchRequests.front().first;
+    PlaneGeometry::ConstPointer plane = m_PrefetchRequests.front().second;
+    m_PrefetchRequests.erase(m_PrefetchRequests.begin());
+
+    if (!this->ContainsUnlocked(key))
+    {
+      Image::Pointer image = m_PrefetchImage;
+      // the volume item keeps the referenced memory alive, even if the cache is cleared or the source image is
+      // initialized again meanwhile; the source image is needed to synchronize with its write accessors
+      Image::ConstPointer sourceImage = m_PrefetchSourceImage;
+      ImageDataItem::ConstPointer volume = m_PrefetchVolume;
+      const ExtractSliceFilter::ResliceInterpolation interpolationMode = m_PrefetchInterpolationMode;
+      const bool inPlaneResampleExtentByGeometry = m_PrefetchInPlaneResampleExtentByGeometry;
+      m_Prefetching = true;
+      lock.unlock();
+
+      bool success = false;
+      Slice slice;
+      try
+      {
+        // the memory must not be written while it is resliced
+        ImageReadAccessor accessor(sourceImage, volume, ImageAccessorBase::ExceptionIfLocked);
+
+        reslicer->SetInput(image);
+        reslicer->SetWorldGeometry(plane);
+        reslicer->SetTimeStep(key.timeStep);
+        reslicer->SetResliceTransformByGeometry(image->GetTimeGeometry()->GetGeometryForTimeStep(key.timeStep));
+        reslicer->SetInPlaneResampleExtentByGeometry(inPlaneResampleExtentByGeometry);
+        reslicer->SetInterpolationMode(interpolationMode);
+        reslicer->Modified();
+        reslicer->UpdateLargestPossibleRegion();
+        slice = CreateSlice(reslicer->GetVtkOutput(), reslicer);
+        success = true;
+      }
+      catch (const MemoryIsLockedException &)
+      {
+        // the volume is written right now, so the slice would be outdated anyway
+      }
+      catch (const std::exception &e)
+      {
+        MITK_WARN << "Prefetching of slice failed: " << e.what();
+      }
+
+      lock.lock();
+      m_Prefetching = false;
+      if (success)
+      {
+        this->InsertUnlocked(key, slice);
+      }
+    }
+
+    if (m_PrefetchRequests.empty())
+    {
+      m_PrefetchFinished.notify_all();
+    }
+  }
+
+  m_PrefetchFinished.notify_all();
+}
@@ -22,16 +22,15 @@ found in the LICENSE file.
 
 #include <vtkStreamingDemandDrivenPipeline.h>
 
-// used for acos etc.
+// used for ceil
 #include <cmath>
 
-// used for PI
-#include <itkMath.h>
+#include <algorithm>
+#include <limits>
+#include <vector>
 
 #include <mitkLogMacros.h>
 
-static const double PI = itk::Math::pi;
-
 vtkStandardNewMacro(vtkMitkLevelWindowFilter);
 
 vtkMitkLevelWindowFilter::vtkMitkLevelWindowFilter()
@@ -81,63 +80,93 @@ void vtkMitkLevelWindowFilter::SetOpacityPiecewiseFunction(vtkPiecewiseFunction
   }
 }
 
-// This code was copied from the iil. The template works only for float and double.
 // Internal method which should never be used anywhere else and should not be in th header.
-// Convert color pixels from (R,G,B) to (H,S,I).
-// Reference: "Digital Image Processing, 2nd. edition", R. Gonzalez and R. Woods. Prentice Hall, 2002.
+// Computes the columns [xBegin, xEnd) of row y of the extent that are inside of the clipping bounds.
+// The range is empty if the row is outside of the vertical clipping bounds.
+static void vtkGetClippedColumns(const int outExt[6], const double *clippingBounds, int y, int &xBegin, int &xEnd)
+{
+  xBegin = outExt[0];
+  xEnd = outExt[0];
+
+  if (y >= clippingBounds[2] && y < clippingBounds[3])
+  {
+    // for integer x: x >= bound <=> x >= ceil(bound) and x < bound <=> x < ceil(bound)
+    const double first = static_cast<double>(outExt[0]);
+    const double last = static_cast<double>(outExt[1] + 1);
+    xBegin = static_cast<int>(std::min(std::max(std::ceil(clippingBounds[0]), first), last));
+    xEnd = static_cast<int>(std::min(std::max(std::ceil(clippingBounds[1]), first), last));
+    xEnd = std::max(xBegin, xEnd);
+  }
+}
+
+// Internal method which should never be used anywhere else and should not be in th header.
+// Writes transparent RGBA pixels.
 template <class T>
-void RGBtoHSI(T *RGB, T *HSI)
+void vtkClearRGBAPixels(T *output, int numberOfPixels)
 {
-  T R = RGB[0], G = RGB[1], B = RGB[2], nR = (R < 0 ? 0 : (R > 255 ? 255 : R)) / 255,
-    nG = (G < 0 ? 0 : (G > 255 ? 255 : G)) / 255, nB = (B < 0 ? 0 : (B > 255 ? 255 : B)) / 255,
-    m = nR < nG ? (nR < nB ? nR : nB) : (nG < nB ? nG : nB),
-    theta = (T)(std::acos(0.5f * ((nR - nG) + (nR - nB)) / std::sqrt(std::pow(nR - nG, 2) + (nR - nB) * (nG - nB))) *
-                180 / PI),
-    sum = nR + nG + nB;
-  T H = 0, S = 0, I = 0;
-  if (theta > 0)
-    H = (nB <= nG) ? theta : 360 - theta;
-  if (sum > 0)
-    S = 1 - 3 / sum * m;
-  I = sum / 3;
-  HSI[0] = (T)H;
-  HSI[1] = (T)S;
-  HSI[2] = (T)I;
+  std::fill(output, output + 4 * numberOfPixels, static_cast<T>(0));
 }
 
-// This code was copied from the iil. The template works only for float and double.
 // Internal method which should never be used anywhere else and should not be in th header.
-// Convert color pixels from (H,S,I) to (R,G,B).
+// Maps the gray values to indices of a linear lookup table. The loop has no branches, so that the
+// compiler vectorizes it for all pixel types.
 template <class T>
-void HSItoRGB(T *HSI, T *RGB)
+void vtkComputeLookupTableIndices(
+  const T *input, int numberOfPixels, float scale, float bias, float maxIndex, int *indices)
 {
-  T H = (T)HSI[0], S = (T)HSI[1], I = (T)HSI[2], a = I * (1 - S), R = 0, G = 0, B = 0;
-  if (H < 120)
+  for (int i = 0; i < numberOfPixels; ++i)
   {
-    B = a;
-    R = (T)(I * (1 + S * std::cos(H * PI / 180) / std::cos((60 - H) * PI / 180)));
-    G = 3 * I - (R + B);
+    const float index = static_cast<float>(input[i]) * scale + bias;
+    // std::max(0, ...) as outer operation also maps NaN to 0
+    indices[i] = static_cast<int>(std::max(0.0f, std::min(index, maxIndex)));
   }
-  else if (H < 240)
-  {
-    H -= 120;
-    R = a;
-    G = (T)(I * (1 + S * std::cos(H * PI / 180) / std::cos((60 - H) * PI / 180)));
-    B = 3 * I - (R + G);
-  }
-  else
+}
+
+// Internal method which should never be used anywhere else and should not be in th header.
+// Applies the color level window to RGB(A) pixels. As the level window only changes the intensity
+// of the HSI color space, hue and saturation are preserved. HSI to RGB is linear in the intensity
+// for a fixed hue and saturation, so the conversion to HSI and back reduces to scaling the clamped
+// RGB values by the ratio of the new and the old intensity (black pixels become gray).
+// This avoids the trigonometric functions per pixel and lets the compiler vectorize the loop.
+template <class T>
+void vtkApplyLevelWindowOnRGBAPixels(const T *input,
+                                     T *output,
+                                     int numberOfPixels,
+                                     int numberOfComponents,
+                                     double scale,
+                                     double bias,
+                                     double scaleOpac,
+                                     double biasOpac)
+{
+  const bool hasAlpha = numberOfComponents >= 4;
+
+  for (int i = 0; i < numberOfPixels; ++i)
   {
-    H -= 240;
-    G = a;
-    B = (T)(I * (1 + S * std::cos(H * PI / 180) / std::cos((60 - H) * PI / 180)));
-    R = 3 * I - (G + B);
+    const T *inputPixel = input + i * numberOfComponents;
+    T *outputPixel = output + 4 * i;
+
+    const double r = std::min(std::max(static_cast<double>(inputPixel[0]), 0.0), 255.0);
+    const double g = std::min(std::max(static_cast<double>(inputPixel[1]), 0.0), 255.0);
+    const double b = std::min(std::max(static_cast<double>(inputPixel[2]), 0.0), 255.0);
+    const double sum = r + g + b;
+
+    // level/window mechanism for intensity in HSI space (intensity in [0, 255])
+    const double intensity = std::min(std::max(sum / 3.0 * scale - bias, 0.0), 255.0);
+    const double ratio = sum > 0.0 ? 3.0 * intensity / sum : 0.0;
+    const double gray = sum > 0.0 ? 0.0 : intensity;
+
+    outputPixel[0] = static_cast<T>(std::min(r * ratio + gray, 255.0));
+    outputPixel[1] = static_cast<T>(std::min(g * ratio + gray, 255.0));
+    outputPixel[2] = static_cast<T>(std::min(b * ratio + gray, 255.0));
+
+    // level/window mechanism for opacity
+    double alpha = 255.0;
+    if (hasAlpha)
+    {
+      alpha = std::min(std::max(static_cast<double>(inputPixel[3]) * scaleOpac - biasOpac, 0.0), 255.0);
+    }
+    outputPixel[3] = static_cast<T>(static_cast<unsigned char>(alpha));
   }
-  R *= 255;
-  G *= 255;
-  B *= 255;
-  RGB[0] = (T)(R < 0 ? 0 : (R > 255 ? 255 : R));
-  RGB[1] = (T)(G < 0 ? 0 : (G > 255 ? 255 : G));
-  RGB[2] = (T)(B < 0 ? 0 : (B > 255 ? 255 : B));
 }
 
 // Internal method which should never be used anywhere else and should not be in th header.
@@ -178,95 +207,18 @@ void vtkApplyLookupTableOnRGBA(vtkMitkLevelWindowFilter *self,
   {
     T *inputSI = inputIt.BeginSpan();
     T *outputSI = outputIt.BeginSpan();
-    T *outputSIEnd = outputIt.EndSpan();
+    const int numberOfPixels = static_cast<int>(outputIt.EndSpan() - outputSI) / 4;
 
-    if (y >= clippingBounds[2] && y < clippingBounds[3])
-    {
-      int x = outExt[0];
+    int xBegin, xEnd;
+    vtkGetClippedColumns(outExt, clippingBounds, y, xBegin, xEnd);
+    const int begin = xBegin - outExt[0];
+    const int end = xEnd - outExt[0];
+
+    vtkClearRGBAPixels(outputSI, begin);
+    vtkApplyLevelWindowOnRGBAPixels(
+      inputSI + begin * maxC, outputSI + 4 * begin, end - begin, maxC, scale, bias, scaleOpac, biasOpac);
+    vtkClearRGBAPixels(outputSI + 4 * end, numberOfPixels - end);
 
-      while (outputSI != outputSIEnd)
-      {
-        if (x >= clippingBounds[0] && x < clippingBounds[1])
-        {
-          double rgb[3], alpha, hsi[3];
-
-          // level/window mechanism for intensity in HSI space
-          rgb[0] = static_cast<double>(*inputSI);
-          inputSI++;
-          rgb[1] = static_cast<double>(*inputSI);
-          inputSI++;
-          rgb[2] = static_cast<double>(*inputSI);
-          inputSI++;
-
-          RGBtoHSI<double>(rgb, hsi);
-          hsi[2] = hsi[2] * 255.0 * scale - bias;
-          hsi[2] = (hsi[2] > 255.0 ? 255 : (hsi[2] < 0.0 ? 0 : hsi[2]));
-          hsi[2] /= 255.0;
-          HSItoRGB<double>(hsi, rgb);
-
-          *outputSI = static_cast<T>(rgb[0]);
-          outputSI++;
-          *outputSI = static_cast<T>(rgb[1]);
-          outputSI++;
-          *outputSI = static_cast<T>(rgb[2]);
-          outputSI++;
-
-          unsigned char finalAlpha = 255;
-
-          // RGBA case
-          if (maxC >= 4)
-          {
-            // level/window mechanism for opacity
-            alpha = static_cast<double>(*inputSI);
-            inputSI++;
-            alpha = alpha * scaleOpac - biasOpac;
-            if (alpha > 255.0)
-            {
-              alpha = 255.0;
-            }
-            else if (alpha < 0.0)
-            {
-              alpha = 0.0;
-            }
-            finalAlpha = static_cast<unsigned char>(alpha);
-
-            for (int c = 4; c < maxC; c++)
-              inputSI++;
-          }
-
-          *outputSI = static_cast<T>(finalAlpha);
-          outputSI++;
-        }
-        else
-        {
-          inputSI += maxC;
-          *outputSI = 0;
-          outputSI++;
-          *outputSI = 0;
-          outputSI++;
-          *outputSI = 0;
-          outputSI++;
-          *outputSI = 0;
-          outputSI++;
-        }
-
-        x++;
-      }
-    }
-    else
-    {
-      while (outputSI != outputSIEnd)
-      {
-        *outputSI = 0;
-        outputSI++;
-        *outputSI = 0;
-        outputSI++;
-        *outputSI = 0;
-        outputSI++;
-        *outputSI = 0;
-        outputSI++;
-      }
-    }
     inputIt.NextSpan();
     outputIt.NextSpan();
     y++;
@@ -275,10 +227,14 @@ void vtkApplyLookupTableOnRGBA(vtkMitkLevelWindowFilter *self,
 
 // Internal method which should never be used anywhere else and should not be in th header.
 //----------------------------------------------------------------------------
-// This templated function executes the filter for any type of data.
+// This templated function executes the filter for any type of data and linear vtkLookupTables.
 template <class T>
-void vtkApplyLookupTableOnScalarsFast(
-  vtkMitkLevelWindowFilter *self, vtkImageData *inData, vtkImageData *outData, int outExt[6], T *)
+void vtkApplyLookupTableOnScalarsFast(vtkMitkLevelWindowFilter *self,
+                                      vtkImageData *inData,
+                                      vtkImageData *outData,
+                                      int outExt[6],
+                                      double *clippingBounds,
+                                      T *)
 {
   vtkImageIterator<T> inputIt(inData, outExt);
   vtkImageIterator<unsigned char> outputIt(outData, outExt);
@@ -299,32 +255,46 @@ void vtkApplyLookupTableOnScalarsFast(
   // due to later conversion to int for rounding
   bias += 0.5f;
 
+  // the indices are computed block wise (vectorized), the colors are fetched afterwards
+  const int blockSize = 256;
+  int indices[blockSize];
+
+  int y = outExt[2];
+
   // Loop through ouput pixels
   while (!outputIt.IsAtEnd())
   {
     unsigned char *outputSI = outputIt.BeginSpan();
-    unsigned char *outputSIEnd = outputIt.EndSpan();
+    const int numberOfPixels = static_cast<int>(outputIt.EndSpan() - outputSI) / 4;
 
     T *inputSI = inputIt.BeginSpan();
 
-    while (outputSI != outputSIEnd)
-    {
-      // map to an index
-      auto idx = static_cast<int>(*inputSI * scale + bias);
+    int xBegin, xEnd;
+    vtkGetClippedColumns(outExt, clippingBounds, y, xBegin, xEnd);
+    const int begin = xBegin - outExt[0];
+    const int end = xEnd - outExt[0];
 
-      if (idx < 0)
-        idx = 0;
-      else if (idx > maxIndex)
-        idx = maxIndex;
+    vtkClearRGBAPixels(outputSI, begin);
 
-      *reinterpret_cast<int *>(outputSI) = realLookupTable[idx];
+    for (int blockBegin = begin; blockBegin < end; blockBegin += blockSize)
+    {
+      const int blockPixels = std::min(blockSize, end - blockBegin);
+      vtkComputeLookupTableIndices(
+        inputSI + blockBegin, blockPixels, scale, bias, static_cast<float>(maxIndex), indices);
 
-      inputSI++;
-      outputSI += 4;
+      // copy the 4 (RGBA) chars as a single int
+      int *outputPixels = reinterpret_cast<int *>(outputSI + 4 * blockBegin);
+      for (int i = 0; i < blockPixels; ++i)
+      {
+        outputPixels[i] = realLookupTable[indices[i]];
+      }
     }
 
+    vtkClearRGBAPixels(outputSI + 4 * end, numberOfPixels - end);
+
     inputIt.NextSpan();
     outputIt.NextSpan();
+    y++;
   }
 }
 
@@ -349,55 +319,61 @@ void vtkApplyLookupTableOnScalars(vtkMitkLevelWindowFilter *self,
   while (!outputIt.IsAtEnd())
   {
     unsigned char *outputSI = outputIt.BeginSpan();
-    unsigned char *outputSIEnd = outputIt.EndSpan();
+    const int numberOfPixels = static_cast<int>(outputIt.EndSpan() - outputSI) / 4;
 
-    // do we iterate over the inner vertical clipping bounds
-    if (y >= clippingBounds[2] && y < clippingBounds[3])
-    {
-      T *inputSI = inputIt.BeginSpan();
+    T *inputSI = inputIt.BeginSpan();
 
-      int x = outExt[0];
+    int xBegin, xEnd;
+    vtkGetClippedColumns(outExt, clippingBounds, y, xBegin, xEnd);
+    const int begin = xBegin - outExt[0];
+    const int end = xEnd - outExt[0];
 
-      while (outputSI != outputSIEnd)
-      {
-        // is this pixel within horizontal clipping bounds
-        if (x >= clippingBounds[0] && x < clippingBounds[1])
-        {
-          // fetching original value
-          auto grayValue = static_cast<double>(*inputSI);
-          // applying lookuptable - copy the 4 (RGBA) chars as a single int
-          *reinterpret_cast<int *>(outputSI) = *reinterpret_cast<int *>(lookupTable->MapValue(grayValue));
-        }
-        else
-        {
-          // outer horizontal clipping bounds - write a transparent RGBA pixel as a single int
-          *reinterpret_cast<int *>(outputSI) = 0;
-        }
-
-        inputSI++;
-        outputSI += 4;
-        x++;
-      }
-    }
-    else
+    vtkClearRGBAPixels(outputSI, begin);
+
+    for (int i = begin; i < end; ++i)
     {
-      // outer vertical clipping bounds - write a transparent RGBA line as ints
-      while (outputSI != outputSIEnd)
-      {
-        *reinterpret_cast<int *>(outputSI) = 0;
-        outputSI += 4;
-      }
+      // fetching original value
+      auto grayValue = static_cast<double>(inputSI[i]);
+      // applying lookuptable - copy the 4 (RGBA) chars as a single int
+      *reinterpret_cast<int *>(outputSI + 4 * i) = *reinterpret_cast<int *>(lookupTable->MapValue(grayValue));
     }
 
+    vtkClearRGBAPixels(outputSI + 4 * end, numberOfPixels - end);
+
     inputIt.NextSpan();
     outputIt.NextSpan();
     y++;
   }
 }
 
+// Internal method which should never be used anywhere else and should not be in th header.
+// Maps one gray value with the color transfer function and the optional opacity function.
+static int vtkMapValueWithTransferFunctions(vtkColorTransferFunction *lookupTable,
+                                            vtkPiecewiseFunction *opacityFunction,
+                                            double grayValue)
+{
+  // applying directly colortransferfunction
+  // because vtkColorTransferFunction::MapValue is not threadsafe
+  double rgba[4];
+  lookupTable->GetColor(grayValue, rgba); // RGB mapping
+  rgba[3] = 1.0;
+  if (opacityFunction)
+    rgba[3] = opacityFunction->GetValue(grayValue); // Alpha mapping
+
+  int color;
+  auto *colorChars = reinterpret_cast<unsigned char *>(&color);
+  for (int i = 0; i < 4; ++i)
+  {
+    colorChars[i] = static_cast<unsigned char>(255.0 * rgba[i] + 0.5);
+  }
+  return color;
+}
+
 // Internal method which should never be used anywhere else and should not be in th header.
 //----------------------------------------------------------------------------
 // This templated function executes the filter for any type of data.
+// For integer pixel types, the transfer functions are evaluated once per gray value that occurs
+// in the extent (if these are less than the pixels) and the pixels are mapped by a table afterwards.
 template <class T>
 void vtkApplyLookupTableOnScalarsCTF(vtkMitkLevelWindowFilter *self,
                                      vtkImageData *inData,
@@ -406,68 +382,87 @@ void vtkApplyLookupTableOnScalarsCTF(vtkMitkLevelWindowFilter *self,
                                      double *clippingBounds,
                                      T *)
 {
-  vtkImageIterator<T> inputIt(inData, outExt);
-  vtkImageIterator<unsigned char> outputIt(outData, outExt);
   auto *lookupTable = dynamic_cast<vtkColorTransferFunction *>(self->GetLookupTable());
   vtkPiecewiseFunction *opacityFunction = self->GetOpacityPiecewiseFunction();
 
+  std::vector<int> colorTable;
+  T minValue = 0;
+
+  if (std::numeric_limits<T>::is_integer)
+  {
+    // determine the range of gray values inside of the clipping bounds
+    vtkImageIterator<T> rangeIt(inData, outExt);
+    T maxValue = 0;
+    long long numberOfPixels = 0;
+    int y = outExt[2];
+    while (!rangeIt.IsAtEnd())
+    {
+      const T *inputSI = rangeIt.BeginSpan();
+      int xBegin, xEnd;
+      vtkGetClippedColumns(outExt, clippingBounds, y, xBegin, xEnd);
+      if (xBegin < xEnd)
+      {
+        const auto range =
+          std::minmax_element(inputSI + (xBegin - outExt[0]), inputSI + (xEnd - outExt[0]));
+        minValue = numberOfPixels == 0 ? *range.first : std::min(minValue, *range.first);
+        maxValue = numberOfPixels == 0 ? *range.second : std::max(maxValue, *range.second);
+        numberOfPixels += xEnd - xBegin;
+      }
+      rangeIt.NextSpan();
+      y++;
+    }
+
+    const double numberOfValues = static_cast<double>(maxValue) - static_cast<double>(minValue) + 1.0;
+    if (numberOfPixels > 0 && numberOfValues <= static_cast<double>(numberOfPixels))
+    {
+      colorTable.resize(static_cast<std::size_t>(numberOfValues));
+      for (std::size_t i = 0; i < colorTable.size(); ++i)
+      {
+        colorTable[i] = vtkMapValueWithTransferFunctions(
+          lookupTable, opacityFunction, static_cast<double>(minValue) + static_cast<double>(i));
+      }
+    }
+  }
+
+  vtkImageIterator<T> inputIt(inData, outExt);
+  vtkImageIterator<unsigned char> outputIt(outData, outExt);
+
   int y = outExt[2];
 
   // Loop through ouput pixels
   while (!outputIt.IsAtEnd())
   {
     unsigned char *outputSI = outputIt.BeginSpan();
-    unsigned char *outputSIEnd = outputIt.EndSpan();
+    const int numberOfPixels = static_cast<int>(outputIt.EndSpan() - outputSI) / 4;
 
-    // do we iterate over the inner vertical clipping bounds
-    if (y >= clippingBounds[2] && y < clippingBounds[3])
-    {
-      T *inputSI = inputIt.BeginSpan();
+    T *inputSI = inputIt.BeginSpan();
+
+    int xBegin, xEnd;
+    vtkGetClippedColumns(outExt, clippingBounds, y, xBegin, xEnd);
+    const int begin = xBegin - outExt[0];
+    const int end = xEnd - outExt[0];
 
-      int x = outExt[0];
+    vtkClearRGBAPixels(outputSI, begin);
 
-      while (outputSI != outputSIEnd)
+    auto *outputPixels = reinterpret_cast<int *>(outputSI);
+    if (!colorTable.empty())
+    {
+      for (int i = begin; i < end; ++i)
       {
-        // is this pixel within horizontal clipping bounds
-        if (x >= clippingBounds[0] && x < clippingBounds[1])
-        {
-          // fetching original value
-          auto grayValue = static_cast<double>(*inputSI);
-
-          // applying directly colortransferfunction
-          // because vtkColorTransferFunction::MapValue is not threadsafe
-          double rgba[4];
-          lookupTable->GetColor(grayValue, rgba); // RGB mapping
-          rgba[3] = 1.0;
-          if (opacityFunction)
-            rgba[3] = opacityFunction->GetValue(grayValue); // Alpha mapping
-
-          for (int i = 0; i < 4; ++i)
-          {
-            outputSI[i] = static_cast<unsigned char>(255.0 * rgba[i] + 0.5);
-          }
-        }
-        else
-        {
-          // outer horizontal clipping bounds - write a transparent RGBA pixel as a single int
-          *reinterpret_cast<int *>(outputSI) = 0;
-        }
-
-        inputSI++;
-        outputSI += 4;
-        x++;
+        outputPixels[i] = colorTable[static_cast<std::size_t>(inputSI[i] - minValue)];
       }
     }
     else
     {
-      // outer vertical clipping bounds - write a transparent RGBA line as ints
-      while (outputSI != outputSIEnd)
+      for (int i = begin; i < end; ++i)
       {
-        *reinterpret_cast<int *>(outputSI) = 0;
-        outputSI += 4;
+        outputPixels[i] =
+          vtkMapValueWithTransferFunctions(lookupTable, opacityFunction, static_cast<double>(inputSI[i]));
       }
     }
 
+    vtkClearRGBAPixels(outputSI + 4 * end, numberOfPixels - end);
+
     inputIt.NextSpan();
     outputIt.NextSpan();
     y++;
@@ -504,18 +499,15 @@ void vtkMitkLevelWindowFilter::ThreadedExecute(vtkImageData *inData, vtkImageDat
   }
   else
   {
-    bool dontClip = extent[2] >= m_ClippingBounds[2] && extent[3] <= m_ClippingBounds[3] &&
-                    extent[0] >= m_ClippingBounds[0] && extent[1] <= m_ClippingBounds[1];
-
     if (this->GetLookupTable())
       this->GetLookupTable()->Build();
 
     auto *vlt = dynamic_cast<vtkLookupTable *>(this->GetLookupTable());
     auto *ctf = dynamic_cast<vtkColorTransferFunction *>(this->GetLookupTable());
 
-    bool linearLookupTable = vlt && vlt->GetScale() == VTK_SCALE_LINEAR;
-
-    bool useFast = dontClip && linearLookupTable;
+    // the fast path does not support the below/above range colors of the lookup table
+    bool useFast = vlt && vlt->GetScale() == VTK_SCALE_LINEAR && !vlt->GetUseBelowRangeColor() &&
+                   !vlt->GetUseAboveRangeColor();
 
     if (ctf)
     {
@@ -532,8 +524,8 @@ void vtkMitkLevelWindowFilter::ThreadedExecute(vtkImageData *inData, vtkImageDat
     {
       switch (inData->GetScalarType())
       {
-        vtkTemplateMacro(
-          vtkApplyLookupTableOnScalarsFast(this, inData, outData, extent, static_cast<VTK_TT *>(nullptr)));
+        vtkTemplateMacro(vtkApplyLookupTableOnScalarsFast(
+          this, inData, outData, extent, m_ClippingBounds, static_cast<VTK_TT *>(nullptr)));
         default:
           vtkErrorMacro(<< "Execute: Unknown ScalarType");
           return;
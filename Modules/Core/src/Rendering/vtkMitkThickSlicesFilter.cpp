@@ -20,8 +20,10 @@ found in the LICENSE file.
 #include "vtkPointData.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
+#include <algorithm>
 #include <cmath>
 #include <sstream>
+#include <vector>
 
 vtkStandardNewMacro(vtkMitkThickSlicesFilter);
 
@@ -31,6 +33,7 @@ vtkMitkThickSlicesFilter::vtkMitkThickSlicesFilter()
 {
   this->HandleBoundaries = 1;
   this->Dimensionality = 2;
+  this->Percentile = 50.0;
 
   this->m_CurrentMode = MIP;
 
@@ -44,6 +47,7 @@ void vtkMitkThickSlicesFilter::PrintSelf(ostream &os, vtkIndent indent)
   this->Superclass::PrintSelf(os, indent);
   os << indent << "HandleBoundaries: " << this->HandleBoundaries << "\n";
   os << indent << "Dimensionality: " << this->Dimensionality << "\n";
+  os << indent << "Percentile: " << this->Percentile << "\n";
 }
 
 //----------------------------------------------------------------------------
@@ -334,6 +338,39 @@ r[2] = -0.5 / r[2];
       }
     }
     break;
+
+    case vtkMitkThickSlicesFilter::MEDIAN:
+    case vtkMitkThickSlicesFilter::PERCENTILE:
+    {
+      const double percentile =
+        self->GetThickSliceMode() == vtkMitkThickSlicesFilter::MEDIAN ? 50.0 : self->GetPercentile();
+      const int size = _maxZ - _minZ + 1;
+      const auto rank = static_cast<int>(std::floor(percentile / 100.0 * (size - 1) + 0.5));
+
+      // samples along the slab of the current pixel (one buffer per thread)
+      std::vector<T> samples(size);
+
+      for (idxY = 0; idxY <= maxY; idxY++)
+      {
+        for (idxX = 0; idxX <= maxX; idxX++)
+        {
+          for (int z = _minZ; z <= _maxZ; z++)
+          {
+            samples[z - _minZ] = inPtr[z * inIncs[2]];
+          }
+
+          std::nth_element(samples.begin(), samples.begin() + rank, samples.end());
+
+          // do X axis
+          *outPtr = samples[rank];
+          outPtr++;
+          inPtr++;
+        }
+        outPtr += outIncY;
+        inPtr += inIncY;
+      }
+    }
+    break;
   }
 }
 
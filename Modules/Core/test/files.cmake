@@ -37,6 +37,10 @@ set(MODULE_TESTS
   mitkGeometryDataToSurfaceFilterTest.cpp
   mitkImageCastTest.cpp
   mitkImageDataItemTest.cpp
+  mitkImageCopyOnWriteTest.cpp
+  mitkImageMemoryPoolTest.cpp
+  mitkMemoryMappedFileTest.cpp
+  mitkBrickedImageStorageTest.cpp
   mitkImageGeneratorTest.cpp
   mitkIOUtilTest.cpp
   mitkBaseDataTest.cpp
@@ -68,6 +72,7 @@ set(MODULE_TESTS
   mitkSurfaceToSurfaceFilterTest.cpp
   mitkTimeGeometryTest.cpp
   mitkProportionalTimeGeometryTest.cpp
+  mitkLimitedLinearUndoTest.cpp
   mitkUndoControllerTest.cpp
   mitkVtkWidgetRenderingTest.cpp
   mitkVerboseLimitedLinearUndoTest.cpp
@@ -77,13 +82,18 @@ set(MODULE_TESTS
   mitkRenderingManagerTest.cpp
   mitkCompositePixelValueToStringTest.cpp
   vtkMitkThickSlicesFilterTest.cpp
+  vtkMitkLevelWindowFilterTest.cpp
   mitkNodePredicateSourceTest.cpp
+  mitkStandaloneDataStorageIndexTest.cpp
+  mitkImageStatisticsHolderTest.cpp
   mitkNodePredicateDataPropertyTest.cpp
   mitkNodePredicateFunctionTest.cpp
   mitkVectorTest.cpp
   mitkClippedSurfaceBoundsCalculatorTest.cpp
   mitkExceptionTest.cpp
   mitkExtractSliceFilterTest.cpp
+  mitkExtractSliceFilter2Test.cpp
+  mitkResliceCacheTest.cpp
   mitkLogTest.cpp
   mitkImageDimensionConverterTest.cpp
   mitkLoggingAdapterTest.cpp
@@ -185,6 +195,13 @@ if(NOT WIN32)
  set(MODULE_CUSTOM_TESTS ${MODULE_CUSTOM_TESTS} mitkSurfaceDepthSortingTest.cpp)
 endif()
 
+# Built into a driver of their own with MITK_BUILD_BENCHMARKS, not run by ctest
+set(MODULE_BENCHMARKS
+  mitkStandaloneDataStorageIndexBenchmark.cpp
+  mitkExtractSliceFilter2Benchmark.cpp
+  vtkMitkLevelWindowFilterBenchmark.cpp
+)
+
 set(RESOURCE_FILES
   Interactions/AddAndRemovePoints.xml
   Interactions/globalConfig.xml
@@ -0,0 +1,332 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkBrickedImageStorage.h>
+#include <mitkExtractSliceFilter2.h>
+#include <mitkIOUtil.h>
+#include <mitkImage.h>
+#include <mitkImageGenerator.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkImageStatisticsHolder.h>
+#include <mitkImageWriteAccessor.h>
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <itksys/SystemTools.hxx>
+
+#include <fstream>
+#include <vector>
+
+class mitkBrickedImageStorageTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkBrickedImageStorageTestSuite);
+  MITK_TEST(Create_FromImage_ReadRegionEqualsImage);
+  MITK_TEST(WriteRegion_Reopen_PersistsPixels);
+  MITK_TEST(New_InvalidFile_Throws);
+  MITK_TEST(SetMemoryBudget_ReadAllBricks_EvictsBricks);
+  MITK_TEST(GetSliceData_BrickedImage_EqualsImage);
+  MITK_TEST(ImageReadAccessor_Region_EqualsImage);
+  MITK_TEST(ExtractSliceFilter2_BrickedImage_ReadsIntersectedBricksOnly);
+  MITK_TEST(ImageWriteAccessor_BrickedImage_WritesToBricks);
+  MITK_TEST(SetImportSlice_BrickedImage_WritesToBricks);
+  MITK_TEST(GetChannelData_BrickedImage_KeptUntilBricksAreWritten);
+  MITK_TEST(GetStatistics_BrickedImage_EqualsImage);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  std::string m_TempDirectory;
+  mitk::Image::Pointer m_Image;
+
+  /** Pixel at index (x, y, z) of the (40 x 36 x 20) test image.*/
+  short GetPixel(unsigned int x, unsigned int y, unsigned int z) const
+  {
+    mitk::ImageReadAccessor readAccess(m_Image);
+    return static_cast<const short *>(readAccess.GetData())[(z * 36 + y) * 40 + x];
+  }
+
+  static mitk::BrickedImageStorage::RegionType CreateRegion(
+    long x, long y, long z, unsigned long width, unsigned long height, unsigned long depth)
+  {
+    mitk::BrickedImageStorage::RegionType::IndexType index = {{x, y, z}};
+    mitk::BrickedImageStorage::RegionType::SizeType size = {{width, height, depth}};
+    return mitk::BrickedImageStorage::RegionType(index, size);
+  }
+
+  void CheckRegion(const mitk::BrickedImageStorage::RegionType &region, const short *pixels) const
+  {
+    const auto &index = region.GetIndex();
+    const auto &size = region.GetSize();
+    for (unsigned int z = 0; z < size[2]; ++z)
+    {
+      for (unsigned int y = 0; y < size[1]; ++y)
+      {
+        for (unsigned int x = 0; x < size[0]; ++x)
+        {
+          CPPUNIT_ASSERT_EQUAL(this->GetPixel(index[0] + x, index[1] + y, index[2] + z),
+                               pixels[(z * size[1] + y) * size[0] + x]);
+        }
+      }
+    }
+  }
+
+  mitk::Image::Pointer CreateBrickedImage(mitk::BrickedImageStorage *storage) const
+  {
+    auto image = mitk::Image::New();
+    image->Initialize(m_Image->GetPixelType(), *m_Image->GetTimeGeometry());
+    CPPUNIT_ASSERT_MESSAGE("Storage matches the image.", image->SetBrickedStorage(storage));
+    return image;
+  }
+
+public:
+  void setUp() override
+  {
+    m_TempDirectory = mitk::IOUtil::CreateTemporaryDirectory("mitkBrickedImageStorageTest-XXXXXX");
+    m_Image = mitk::ImageGenerator::GenerateRandomImage<short>(40, 36, 20, 1, 1.0, 0.8, 1.2, 1000.0, -1000.0);
+  }
+
+  void tearDown() override
+  {
+    m_Image = nullptr;
+    itksys::SystemTools::RemoveADirectory(m_TempDirectory.c_str());
+  }
+
+  void Create_FromImage_ReadRegionEqualsImage()
+  {
+    auto storage = mitk::BrickedImageStorage::Create(m_TempDirectory + "/image.brk", m_Image, 16);
+    CPPUNIT_ASSERT_EQUAL(40u, storage->GetDimensions()[0]);
+    CPPUNIT_ASSERT_EQUAL(1u, storage->GetDimensions()[3]);
+    CPPUNIT_ASSERT(m_Image->GetPixelType() == storage->GetPixelType());
+
+    const auto region = CreateRegion(5, 14, 3, 30, 20, 15);
+    std::vector<short> pixels(region.GetNumberOfPixels());
+    storage->ReadRegion(region, 0, pixels.data());
+    this->CheckRegion(region, pixels.data());
+
+    CPPUNIT_ASSERT_THROW(storage->ReadRegion(CreateRegion(30, 0, 0, 11, 1, 1), 0, pixels.data()), mitk::Exception);
+    CPPUNIT_ASSERT_THROW(storage->ReadRegion(region, 1, pixels.data()), mitk::Exception);
+  }
+
+  void WriteRegion_Reopen_PersistsPixels()
+  {
+    const std::string fileName = m_TempDirectory + "/image.brk";
+    const auto region = CreateRegion(14, 14, 14, 4, 4, 4);
+    std::vector<short> pixels(region.GetNumberOfPixels(), 1234);
+    {
+      auto storage = mitk::BrickedImageStorage::Create(fileName, m_Image, 16);
+      storage->WriteRegion(region, 0, pixels.data());
+    }
+
+    auto storage = mitk::BrickedImageStorage::New(fileName);
+    std::vector<short> readPixels(region.GetNumberOfPixels());
+    storage->ReadRegion(region, 0, readPixels.data());
+    CPPUNIT_ASSERT_MESSAGE("Written pixels are persisted.", pixels == readPixels);
+
+    short pixel = 0;
+    storage->ReadRegion(CreateRegion(13, 14, 14, 1, 1, 1), 0, &pixel);
+    CPPUNIT_ASSERT_EQUAL(this->GetPixel(13, 14, 14), pixel);
+  }
+
+  void New_InvalidFile_Throws()
+  {
+    const std::string fileName = m_TempDirectory + "/invalid.brk";
+    {
+      std::ofstream file(fileName.c_str(), std::ios::binary);
+      file << std::string(128, 'x');
+    }
+    CPPUNIT_ASSERT_THROW(mitk::BrickedImageStorage::New(fileName), mitk::Exception);
+    CPPUNIT_ASSERT_THROW(mitk::BrickedImageStorage::New(m_TempDirectory + "/missing.brk"), mitk::Exception);
+  }
+
+  void SetMemoryBudget_ReadAllBricks_EvictsBricks()
+  {
+    auto storage = mitk::BrickedImageStorage::Create(m_TempDirectory + "/image.brk", m_Image, 8);
+    const std::size_t bytesPerBrick = 8 * 8 * 8 * sizeof(short);
+    storage->SetMemoryBudget(4 * bytesPerBrick);
+
+    std::vector<short> pixels(40 * 36 * 20);
+    storage->ReadRegion(CreateRegion(0, 0, 0, 40, 36, 20), 0, pixels.data());
+    CPPUNIT_ASSERT(storage->GetCachedBytes() <= 4 * bytesPerBrick);
+    CPPUNIT_ASSERT_EQUAL(5ul * 5ul * 3ul, storage->GetNumberOfBrickReads());
+
+    // the most recently used brick is still cached
+    short pixel = 0;
+    storage->ReadRegion(CreateRegion(39, 35, 19, 1, 1, 1), 0, &pixel);
+    CPPUNIT_ASSERT_EQUAL(1ul, storage->GetNumberOfCacheHits());
+
+    storage->SetMemoryBudget(0);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), storage->GetCachedBytes());
+
+    storage->SetMemoryBudget(4 * bytesPerBrick);
+    storage->ReadRegion(CreateRegion(0, 0, 0, 40, 36, 20), 0, pixels.data());
+    storage->ClearCache();
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), storage->GetCachedBytes());
+  }
+
+  void GetSliceData_BrickedImage_EqualsImage()
+  {
+    auto storage = mitk::BrickedImageStorage::Create(m_TempDirectory + "/image.brk", m_Image, 16);
+    auto image = this->CreateBrickedImage(storage);
+
+    auto sliceData = image->GetSliceData(7);
+    CPPUNIT_ASSERT(sliceData.IsNotNull());
+    this->CheckRegion(CreateRegion(0, 0, 7, 40, 36, 1), static_cast<const short *>(sliceData->GetData()));
+    CPPUNIT_ASSERT_EQUAL(3ul * 3ul, storage->GetNumberOfBrickReads());
+
+    // volumes are read on request, but not kept
+    mitk::ImageReadAccessor readAccess(image);
+    this->CheckRegion(CreateRegion(0, 0, 0, 40, 36, 20), static_cast<const short *>(readAccess.GetData()));
+    CPPUNIT_ASSERT(image->GetVolumeData(0) != image->GetVolumeData(0));
+  }
+
+  void ImageReadAccessor_Region_EqualsImage()
+  {
+    const auto region = CreateRegion(3, 20, 17, 10, 16, 3);
+    {
+      mitk::ImageReadAccessor readAccess(m_Image, region);
+      this->CheckRegion(region, static_cast<const short *>(readAccess.GetData()));
+    }
+
+    auto storage = mitk::BrickedImageStorage::Create(m_TempDirectory + "/image.brk", m_Image, 16);
+    auto image = this->CreateBrickedImage(storage);
+
+    mitk::ImageReadAccessor readAccess(image, region);
+    this->CheckRegion(region, static_cast<const short *>(readAccess.GetData()));
+    CPPUNIT_ASSERT_EQUAL(2ul, storage->GetNumberOfBrickReads());
+
+    CPPUNIT_ASSERT_THROW(mitk::ImageReadAccessor(image, CreateRegion(0, 0, 18, 1, 1, 3)), mitk::Exception);
+  }
+
+  void ExtractSliceFilter2_BrickedImage_ReadsIntersectedBricksOnly()
+  {
+    auto storage = mitk::BrickedImageStorage::Create(m_TempDirectory + "/image.brk", m_Image, 8);
+    auto image = this->CreateBrickedImage(storage);
+
+    // axial plane through the voxel centers of slice 11
+    mitk::Point3D origin = m_Image->GetGeometry()->GetOrigin();
+    origin[2] += 11 * m_Image->GetGeometry()->GetSpacing()[2];
+    mitk::Vector3D right, down;
+    mitk::FillVector3D(right, 1.0, 0.0, 0.0);
+    mitk::FillVector3D(down, 0.0, 1.0, 0.0);
+    auto plane = mitk::PlaneGeometry::New();
+    plane->InitializeStandardPlane(40, 36, right, down, &m_Image->GetGeometry()->GetSpacing());
+    plane->SetOrigin(origin);
+    plane->SetImageGeometry(true);
+
+    for (auto interpolator : {mitk::ExtractSliceFilter2::NearestNeighbor, mitk::ExtractSliceFilter2::Linear})
+    {
+      auto filter = mitk::ExtractSliceFilter2::New();
+      filter->SetInput(m_Image);
+      filter->SetOutputGeometry(plane);
+      filter->SetInterpolator(interpolator);
+      filter->Update();
+      mitk::Image::Pointer expectedSlice = filter->GetOutput();
+
+      auto brickedFilter = mitk::ExtractSliceFilter2::New();
+      brickedFilter->SetInput(image);
+      brickedFilter->SetOutputGeometry(plane);
+      brickedFilter->SetInterpolator(interpolator);
+      brickedFilter->Update();
+
+      mitk::ImageReadAccessor expectedAccess(expectedSlice);
+      mitk::ImageReadAccessor readAccess(brickedFilter->GetOutput());
+      const auto *expectedPixels = static_cast<const short *>(expectedAccess.GetData());
+      const auto *pixels = static_cast<const short *>(readAccess.GetData());
+      for (std::size_t i = 0; i < 40 * 36; ++i)
+      {
+        CPPUNIT_ASSERT_EQUAL(expectedPixels[i], pixels[i]);
+      }
+    }
+
+    CPPUNIT_ASSERT_MESSAGE("Only the bricks around the plane are read.",
+                           storage->GetNumberOfBrickReads() < 5ul * 5ul * 3ul);
+  }
+
+  void ImageWriteAccessor_BrickedImage_WritesToBricks()
+  {
+    auto storage = mitk::BrickedImageStorage::Create(m_TempDirectory + "/image.brk", m_Image, 16);
+    auto image = this->CreateBrickedImage(storage);
+
+    {
+      mitk::ImageWriteAccessor writeAccess(image, image->GetVolumeData(0));
+      static_cast<short *>(writeAccess.GetData())[(5 * 36 + 6) * 40 + 7] = 4321;
+    }
+    {
+      mitk::ImageWriteAccessor writeAccess(image);
+      static_cast<short *>(writeAccess.GetData())[(15 * 36 + 16) * 40 + 17] = -4321;
+    }
+
+    short pixel = 0;
+    storage->ReadRegion(CreateRegion(7, 6, 5, 1, 1, 1), 0, &pixel);
+    CPPUNIT_ASSERT_EQUAL(short(4321), pixel);
+    storage->ReadRegion(CreateRegion(17, 16, 15, 1, 1, 1), 0, &pixel);
+    CPPUNIT_ASSERT_EQUAL(short(-4321), pixel);
+    storage->ReadRegion(CreateRegion(8, 6, 5, 1, 1, 1), 0, &pixel);
+    CPPUNIT_ASSERT_EQUAL(this->GetPixel(8, 6, 5), pixel);
+  }
+
+  void SetImportSlice_BrickedImage_WritesToBricks()
+  {
+    auto storage = mitk::BrickedImageStorage::Create(m_TempDirectory + "/image.brk", m_Image, 16);
+    auto image = this->CreateBrickedImage(storage);
+
+    std::vector<short> slice(40 * 36, 777);
+    CPPUNIT_ASSERT(image->SetImportSlice(slice.data(), 9));
+
+    mitk::ImageReadAccessor readAccess(image, CreateRegion(0, 0, 9, 40, 36, 1));
+    const auto *pixels = static_cast<const short *>(readAccess.GetData());
+    CPPUNIT_ASSERT_MESSAGE("Imported slice is written to the bricks.", std::vector<short>(pixels, pixels + 40 * 36) == slice);
+    CPPUNIT_ASSERT_THROW(image->GetVtkImageData(), mitk::Exception);
+  }
+
+  void GetChannelData_BrickedImage_KeptUntilBricksAreWritten()
+  {
+    auto storage = mitk::BrickedImageStorage::Create(m_TempDirectory + "/image.brk", m_Image, 16);
+    auto image = this->CreateBrickedImage(storage);
+
+    auto channel = image->GetChannelData();
+    const auto brickReads = storage->GetNumberOfBrickReads();
+    CPPUNIT_ASSERT(channel == image->GetChannelData());
+    CPPUNIT_ASSERT_EQUAL(brickReads, storage->GetNumberOfBrickReads());
+
+    std::vector<short> slice(40 * 36, 777);
+    CPPUNIT_ASSERT(image->SetImportSlice(slice.data(), 9));
+
+    auto writtenChannel = image->GetChannelData();
+    CPPUNIT_ASSERT(channel != writtenChannel);
+    CPPUNIT_ASSERT_EQUAL(short(777), static_cast<const short *>(writtenChannel->GetData())[9 * 36 * 40]);
+  }
+
+  void GetStatistics_BrickedImage_EqualsImage()
+  {
+    auto storage = mitk::BrickedImageStorage::Create(m_TempDirectory + "/image.brk", m_Image, 8);
+    auto image = this->CreateBrickedImage(storage);
+    storage->SetMemoryBudget(4 * 8 * 8 * 8 * sizeof(short));
+
+    auto *statistics = image->GetStatistics();
+    CPPUNIT_ASSERT_EQUAL(m_Image->GetStatistics()->GetScalarValueMin(), statistics->GetScalarValueMin());
+    CPPUNIT_ASSERT_EQUAL(m_Image->GetStatistics()->GetScalarValueMax(), statistics->GetScalarValueMax());
+    CPPUNIT_ASSERT_EQUAL(m_Image->GetStatistics()->GetScalarValue2ndMin(), statistics->GetScalarValue2ndMin());
+    CPPUNIT_ASSERT_EQUAL(m_Image->GetStatistics()->GetCountOfMaxValuedVoxels(),
+                         statistics->GetCountOfMaxValuedVoxels());
+    CPPUNIT_ASSERT_EQUAL(m_Image->GetStatistics()->GetScalarHistogram()->GetTotalFrequency(),
+                         statistics->GetScalarHistogram()->GetTotalFrequency());
+    CPPUNIT_ASSERT(storage->GetCachedBytes() <= 4 * 8 * 8 * 8 * sizeof(short));
+
+    {
+      mitk::ImageWriteAccessor writeAccess(image, image->GetSliceData(3));
+      static_cast<short *>(writeAccess.GetData())[0] = 5000;
+    }
+    CPPUNIT_ASSERT_EQUAL(mitk::ScalarType(5000), statistics->GetScalarValueMax());
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkBrickedImageStorage)
@@ -0,0 +1,121 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkExtractSliceFilter2.h>
+#include <mitkImageGenerator.h>
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <itkTimeProbe.h>
+
+#include <string>
+#include <utility>
+
+/** Reports the update time of the slice extraction for all interpolators. Only built with MITK_BUILD_BENCHMARKS.*/
+class mitkExtractSliceFilter2BenchmarkSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkExtractSliceFilter2BenchmarkSuite);
+  MITK_TEST(Update);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  static mitk::Image::Pointer CreateImage(unsigned int size)
+  {
+    return mitk::ImageGenerator::GenerateRandomImage<short>(size, size, size, 1, 1.0, 0.8, 1.2, 1000.0, -1000.0);
+  }
+
+  /** Plane through the voxel center of the passed index with the passed in-plane directions.*/
+  static mitk::PlaneGeometry::Pointer CreatePlane(const mitk::Image *image,
+                                                  const mitk::Point3D &index,
+                                                  const mitk::Vector3D &right,
+                                                  const mitk::Vector3D &down,
+                                                  mitk::ScalarType width,
+                                                  mitk::ScalarType height,
+                                                  const mitk::Vector3D &spacing)
+  {
+    mitk::Point3D origin;
+    image->GetGeometry()->IndexToWorld(index, origin);
+
+    auto plane = mitk::PlaneGeometry::New();
+    plane->InitializeStandardPlane(width, height, right, down, &spacing);
+    plane->SetOrigin(origin);
+    plane->SetImageGeometry(true);
+    return plane;
+  }
+
+  static mitk::PlaneGeometry::Pointer CreateAxialPlane(const mitk::Image *image, mitk::ScalarType slice)
+  {
+    mitk::Point3D index;
+    mitk::FillVector3D(index, 0.0, 0.0, slice);
+    mitk::Vector3D right, down;
+    mitk::FillVector3D(right, 1.0, 0.0, 0.0);
+    mitk::FillVector3D(down, 0.0, 1.0, 0.0);
+    const auto *dimensions = image->GetDimensions();
+    return CreatePlane(image, index, right, down, dimensions[0], dimensions[1], image->GetGeometry()->GetSpacing());
+  }
+
+  static mitk::PlaneGeometry::Pointer CreateObliquePlane(const mitk::Image *image)
+  {
+    mitk::Point3D index;
+    const auto *dimensions = image->GetDimensions();
+    mitk::FillVector3D(index, 0.3, 0.2, dimensions[2] / 2.0);
+    mitk::Vector3D right, down, spacing;
+    mitk::FillVector3D(right, 1.0, 0.3, 0.1);
+    mitk::FillVector3D(down, -0.2, 1.0, 0.4);
+    mitk::FillVector3D(spacing, 0.7, 0.7, 1.0);
+    return CreatePlane(image, index, right, down, dimensions[0], dimensions[1], spacing);
+  }
+
+public:
+  void Update()
+  {
+    const std::pair<mitk::ExtractSliceFilter2::Interpolator, std::string> interpolators[] = {
+      {mitk::ExtractSliceFilter2::NearestNeighbor, "nearest neighbor"},
+      {mitk::ExtractSliceFilter2::Linear, "linear"},
+      {mitk::ExtractSliceFilter2::Cubic, "cubic"}};
+
+    for (unsigned int size : {64, 128, 256})
+    {
+      mitk::Image::Pointer image = CreateImage(size);
+
+      const std::pair<mitk::PlaneGeometry::Pointer, std::string> planes[] = {
+        {CreateAxialPlane(image, size / 2), "axial"}, {CreateObliquePlane(image), "oblique"}};
+
+      for (const auto &interpolator : interpolators)
+      {
+        for (const auto &plane : planes)
+        {
+          auto filter = mitk::ExtractSliceFilter2::New();
+          filter->SetInput(image);
+          filter->SetOutputGeometry(plane.first);
+          filter->SetInterpolator(interpolator.first);
+          // the first update of cubic interpolation computes the B-spline coefficients of the whole volume
+          filter->Update();
+
+          itk::TimeProbe probe;
+          for (int i = 0; i < 10; ++i)
+          {
+            filter->Modified();
+            probe.Start();
+            filter->Update();
+            probe.Stop();
+          }
+
+          MITK_INFO << plane.second << " slice of " << size << "^3 voxels, " << interpolator.second
+                    << " interpolation: " << probe.GetMean() << " s";
+        }
+      }
+    }
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkExtractSliceFilter2Benchmark)
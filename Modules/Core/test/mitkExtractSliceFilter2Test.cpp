@@ -0,0 +1,236 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkExtractSliceFilter2.h>
+#include <mitkImageCast.h>
+#include <mitkImageGenerator.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <itkBSplineInterpolateImageFunction.h>
+#include <itkLinearInterpolateImageFunction.h>
+#include <itkNearestNeighborInterpolateImageFunction.h>
+
+#include <cstdlib>
+#include <limits>
+#include <vector>
+
+class mitkExtractSliceFilter2TestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkExtractSliceFilter2TestSuite);
+  MITK_TEST(AxialPlane_NearestNeighbor_EqualsItkInterpolator);
+  MITK_TEST(AxialPlane_Linear_EqualsItkInterpolator);
+  MITK_TEST(SagittalPlane_Linear_EqualsItkInterpolator);
+  MITK_TEST(ObliquePlane_NearestNeighbor_EqualsItkInterpolator);
+  MITK_TEST(ObliquePlane_Linear_EqualsItkInterpolator);
+  MITK_TEST(ObliquePlane_Cubic_EqualsItkInterpolator);
+  MITK_TEST(PlanePartlyOutside_Linear_EqualsItkInterpolator);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  typedef itk::Image<short, 3> ItkImageType;
+
+  mitk::Image::Pointer m_Image;
+
+  static mitk::Image::Pointer CreateImage(unsigned int size)
+  {
+    return mitk::ImageGenerator::GenerateRandomImage<short>(size, size, size, 1, 1.0, 0.8, 1.2, 1000.0, -1000.0);
+  }
+
+  /** Plane through the voxel center of the passed index with the passed in-plane directions.*/
+  static mitk::PlaneGeometry::Pointer CreatePlane(const mitk::Image *image,
+                                                  const mitk::Point3D &index,
+                                                  const mitk::Vector3D &right,
+                                                  const mitk::Vector3D &down,
+                                                  mitk::ScalarType width,
+                                                  mitk::ScalarType height,
+                                                  const mitk::Vector3D &spacing)
+  {
+    mitk::Point3D origin;
+    image->GetGeometry()->IndexToWorld(index, origin);
+
+    auto plane = mitk::PlaneGeometry::New();
+    plane->InitializeStandardPlane(width, height, right, down, &spacing);
+    plane->SetOrigin(origin);
+    plane->SetImageGeometry(true);
+    return plane;
+  }
+
+  static mitk::PlaneGeometry::Pointer CreateAxialPlane(const mitk::Image *image, mitk::ScalarType slice)
+  {
+    mitk::Point3D index;
+    mitk::FillVector3D(index, 0.0, 0.0, slice);
+    mitk::Vector3D right, down;
+    mitk::FillVector3D(right, 1.0, 0.0, 0.0);
+    mitk::FillVector3D(down, 0.0, 1.0, 0.0);
+    const auto *dimensions = image->GetDimensions();
+    return CreatePlane(image, index, right, down, dimensions[0], dimensions[1], image->GetGeometry()->GetSpacing());
+  }
+
+  static mitk::PlaneGeometry::Pointer CreateObliquePlane(const mitk::Image *image)
+  {
+    mitk::Point3D index;
+    const auto *dimensions = image->GetDimensions();
+    mitk::FillVector3D(index, 0.3, 0.2, dimensions[2] / 2.0);
+    mitk::Vector3D right, down, spacing;
+    mitk::FillVector3D(right, 1.0, 0.3, 0.1);
+    mitk::FillVector3D(down, -0.2, 1.0, 0.4);
+    mitk::FillVector3D(spacing, 0.7, 0.7, 1.0);
+    return CreatePlane(image, index, right, down, dimensions[0], dimensions[1], spacing);
+  }
+
+  static mitk::Image::Pointer ExtractSlice(const mitk::Image *image,
+                                           mitk::PlaneGeometry *plane,
+                                           mitk::ExtractSliceFilter2::Interpolator interpolator)
+  {
+    auto filter = mitk::ExtractSliceFilter2::New();
+    filter->SetInput(image);
+    filter->SetOutputGeometry(plane);
+    filter->SetInterpolator(interpolator);
+    filter->Update();
+    return filter->GetOutput();
+  }
+
+  /** Samples the slice pixel by pixel with the ITK interpolate image function, as the filter did before
+   * it got its own kernels.*/
+  static std::vector<short> ExtractReferenceSlice(const mitk::Image *image,
+                                                  const mitk::PlaneGeometry *plane,
+                                                  mitk::ExtractSliceFilter2::Interpolator interpolator)
+  {
+    ItkImageType::Pointer itkImage;
+    mitk::CastToItkImage(image, itkImage);
+
+    itk::InterpolateImageFunction<ItkImageType>::Pointer interpolateImageFunction;
+    switch (interpolator)
+    {
+      case mitk::ExtractSliceFilter2::NearestNeighbor:
+        interpolateImageFunction = itk::NearestNeighborInterpolateImageFunction<ItkImageType>::New().GetPointer();
+        break;
+
+      case mitk::ExtractSliceFilter2::Linear:
+        interpolateImageFunction = itk::LinearInterpolateImageFunction<ItkImageType>::New().GetPointer();
+        break;
+
+      default:
+      {
+        auto bSplineInterpolateImageFunction = itk::BSplineInterpolateImageFunction<ItkImageType>::New();
+        bSplineInterpolateImageFunction->SetSplineOrder(2);
+        interpolateImageFunction = bSplineInterpolateImageFunction.GetPointer();
+      }
+    }
+    interpolateImageFunction->SetInputImage(itkImage);
+
+    auto xDirection = plane->GetAxisVector(0);
+    auto yDirection = plane->GetAxisVector(1);
+    xDirection.Normalize();
+    yDirection.Normalize();
+
+    const auto width = static_cast<unsigned int>(plane->GetExtent(0));
+    const auto height = static_cast<unsigned int>(plane->GetExtent(1));
+    std::vector<short> slice(width * height);
+
+    itk::ContinuousIndex<mitk::ScalarType, 3> index;
+    for (unsigned int y = 0; y < height; ++y)
+    {
+      for (unsigned int x = 0; x < width; ++x)
+      {
+        const mitk::Point3D point =
+          plane->GetOrigin() + yDirection * plane->GetSpacing()[1] * y + xDirection * plane->GetSpacing()[0] * x;
+        slice[y * width + x] = itkImage->TransformPhysicalPointToContinuousIndex(point, index)
+                                 ? static_cast<short>(interpolateImageFunction->EvaluateAtContinuousIndex(index))
+                                 : std::numeric_limits<short>::lowest();
+      }
+    }
+
+    return slice;
+  }
+
+  /** Interpolated values are truncated to short, so tiny differences of the computed indices (e.g. an index
+   * of 0.9999999999 that is treated as voxel 1 by the filter) may change them by one.*/
+  void TestEqualsItkInterpolator(mitk::PlaneGeometry *plane,
+                                 mitk::ExtractSliceFilter2::Interpolator interpolator,
+                                 int tolerance)
+  {
+    mitk::Image::Pointer slice = ExtractSlice(m_Image, plane, interpolator);
+    const std::vector<short> expectedSlice = ExtractReferenceSlice(m_Image, plane, interpolator);
+
+    mitk::ImageReadAccessor readAccess(slice);
+    const auto *pixels = static_cast<const short *>(readAccess.GetData());
+
+    for (std::size_t i = 0; i < expectedSlice.size(); ++i)
+    {
+      CPPUNIT_ASSERT_MESSAGE("Pixel differs from ITK interpolate image function.",
+                             std::abs(expectedSlice[i] - pixels[i]) <= tolerance);
+    }
+  }
+
+public:
+  void setUp() override { m_Image = CreateImage(32); }
+
+  void tearDown() override { m_Image = nullptr; }
+
+  void AxialPlane_NearestNeighbor_EqualsItkInterpolator()
+  {
+    this->TestEqualsItkInterpolator(CreateAxialPlane(m_Image, 7), mitk::ExtractSliceFilter2::NearestNeighbor, 0);
+  }
+
+  void AxialPlane_Linear_EqualsItkInterpolator()
+  {
+    this->TestEqualsItkInterpolator(CreateAxialPlane(m_Image, 31), mitk::ExtractSliceFilter2::Linear, 1);
+  }
+
+  void SagittalPlane_Linear_EqualsItkInterpolator()
+  {
+    mitk::Point3D index;
+    mitk::FillVector3D(index, 12.0, 31.0, 0.0);
+    mitk::Vector3D right, down;
+    mitk::FillVector3D(right, 0.0, -1.0, 0.0);
+    mitk::FillVector3D(down, 0.0, 0.0, 1.0);
+    mitk::Vector3D spacing;
+    mitk::FillVector3D(spacing, 0.8, 1.2, 1.0);
+
+    this->TestEqualsItkInterpolator(
+      CreatePlane(m_Image, index, right, down, 32, 32, spacing), mitk::ExtractSliceFilter2::Linear, 1);
+  }
+
+  void ObliquePlane_NearestNeighbor_EqualsItkInterpolator()
+  {
+    this->TestEqualsItkInterpolator(CreateObliquePlane(m_Image), mitk::ExtractSliceFilter2::NearestNeighbor, 0);
+  }
+
+  void ObliquePlane_Linear_EqualsItkInterpolator()
+  {
+    this->TestEqualsItkInterpolator(CreateObliquePlane(m_Image), mitk::ExtractSliceFilter2::Linear, 1);
+  }
+
+  void ObliquePlane_Cubic_EqualsItkInterpolator()
+  {
+    this->TestEqualsItkInterpolator(CreateObliquePlane(m_Image), mitk::ExtractSliceFilter2::Cubic, 1);
+  }
+
+  void PlanePartlyOutside_Linear_EqualsItkInterpolator()
+  {
+    mitk::Point3D index;
+    mitk::FillVector3D(index, -10.0, 5.0, 3.0);
+    mitk::Vector3D right, down;
+    mitk::FillVector3D(right, 1.0, 0.0, 0.0);
+    mitk::FillVector3D(down, 0.0, 0.0, 1.0);
+    mitk::Vector3D spacing;
+    mitk::FillVector3D(spacing, 1.0, 1.2, 1.0);
+
+    this->TestEqualsItkInterpolator(
+      CreatePlane(m_Image, index, right, down, 48, 48, spacing), mitk::ExtractSliceFilter2::Linear, 1);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkExtractSliceFilter2)
@@ -0,0 +1,237 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkImage.h>
+#include <mitkImageGenerator.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkImageTimeSelector.h>
+#include <mitkImageWriteAccessor.h>
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <vtkImageData.h>
+
+#include <vector>
+
+class mitkImageCopyOnWriteTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkImageCopyOnWriteTestSuite);
+  MITK_TEST(Clone_NotWritten_SharesMemory);
+  MITK_TEST(Clone_WriteAccessHeld_CopiesMemory);
+  MITK_TEST(Clone_VtkImageDataExported_CopiesMemory);
+  MITK_TEST(WriteAccess_SharedImage_CopiesMemory);
+  MITK_TEST(WriteAccess_SoleOwner_DoesNotCopy);
+  MITK_TEST(WriteAccess_Volume_CopiesWrittenVolumeOnly);
+  MITK_TEST(ImageTimeSelector_SharedInput_WritesToInputOnly);
+  MITK_TEST(ImageTimeSelector_NotWritten_SharesMemory);
+  MITK_TEST(GetData_Write_LeavesCloneUnchanged);
+  MITK_TEST(SetSharedVolume_ReferencedMemory_CopiesVolume);
+  MITK_TEST(SetSharedVolume_DifferentDimensions_ReturnsFalse);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  static const void *GetAddress(mitk::Image *image, mitk::ImageDataItem *item = nullptr)
+  {
+    mitk::ImageReadAccessor readAccess(image, item);
+    return readAccess.GetData();
+  }
+
+  static short GetFirstPixel(mitk::Image *image, mitk::ImageDataItem *item = nullptr)
+  {
+    mitk::ImageReadAccessor readAccess(image, item);
+    return *static_cast<const short *>(readAccess.GetData());
+  }
+
+  static void SetFirstPixel(mitk::Image *image, short value, mitk::ImageDataItem *item = nullptr)
+  {
+    mitk::ImageWriteAccessor writeAccess(image, item);
+    *static_cast<short *>(writeAccess.GetData()) = value;
+  }
+
+public:
+  void Clone_NotWritten_SharesMemory()
+  {
+    auto image = mitk::ImageGenerator::GenerateGradientImage<short>(16, 16, 8);
+    auto clone = image->Clone();
+
+    CPPUNIT_ASSERT_EQUAL(GetAddress(image), GetAddress(clone));
+    CPPUNIT_ASSERT(image->IsVolumeShared());
+    CPPUNIT_ASSERT(clone->IsVolumeShared());
+  }
+
+  void Clone_WriteAccessHeld_CopiesMemory()
+  {
+    auto image = mitk::ImageGenerator::GenerateGradientImage<short>(16, 16, 8);
+    const short pixel = GetFirstPixel(image);
+
+    mitk::ImageWriteAccessor writeAccess(image);
+    auto clone = image->Clone();
+    *static_cast<short *>(writeAccess.GetData()) = pixel + 1;
+
+    CPPUNIT_ASSERT(!image->IsVolumeShared());
+    CPPUNIT_ASSERT(!clone->IsVolumeShared());
+    CPPUNIT_ASSERT(writeAccess.GetData() != GetAddress(clone));
+    CPPUNIT_ASSERT_EQUAL(pixel, GetFirstPixel(clone));
+  }
+
+  void Clone_VtkImageDataExported_CopiesMemory()
+  {
+    auto image = mitk::ImageGenerator::GenerateGradientImage<short>(16, 16, 8);
+    const short pixel = GetFirstPixel(image);
+
+    vtkImageData *vtkImage = image->GetVtkImageData();
+    auto clone = image->Clone();
+    *static_cast<short *>(vtkImage->GetScalarPointer()) = pixel + 1;
+
+    CPPUNIT_ASSERT(!clone->IsVolumeShared());
+    CPPUNIT_ASSERT_EQUAL(short(pixel + 1), GetFirstPixel(image));
+    CPPUNIT_ASSERT_EQUAL(pixel, GetFirstPixel(clone));
+  }
+
+  void WriteAccess_SharedImage_CopiesMemory()
+  {
+    auto image = mitk::ImageGenerator::GenerateGradientImage<short>(16, 16, 8);
+    const short pixel = GetFirstPixel(image);
+    auto clone = image->Clone();
+
+    SetFirstPixel(clone, pixel + 1);
+
+    CPPUNIT_ASSERT(GetAddress(image) != GetAddress(clone));
+    CPPUNIT_ASSERT_EQUAL(pixel, GetFirstPixel(image));
+    CPPUNIT_ASSERT_EQUAL(short(pixel + 1), GetFirstPixel(clone));
+    CPPUNIT_ASSERT(!image->IsVolumeShared());
+    CPPUNIT_ASSERT(!clone->IsVolumeShared());
+  }
+
+  void WriteAccess_SoleOwner_DoesNotCopy()
+  {
+    auto image = mitk::ImageGenerator::GenerateGradientImage<short>(16, 16, 8);
+    auto clone = image->Clone();
+    const void *address = GetAddress(clone);
+
+    image = nullptr;
+    CPPUNIT_ASSERT(!clone->IsVolumeShared());
+
+    SetFirstPixel(clone, 42);
+    CPPUNIT_ASSERT_EQUAL(address, GetAddress(clone));
+  }
+
+  void WriteAccess_Volume_CopiesWrittenVolumeOnly()
+  {
+    auto image = mitk::ImageGenerator::GenerateRandomImage<short>(8, 8, 4, 3, 1.0, 1.0, 1.0, 1000.0, -1000.0);
+    auto clone = image->Clone();
+    const short pixel = GetFirstPixel(image, image->GetVolumeData(1));
+
+    SetFirstPixel(clone, pixel + 1, clone->GetVolumeData(1));
+
+    CPPUNIT_ASSERT(clone->IsVolumeShared(0));
+    CPPUNIT_ASSERT(!clone->IsVolumeShared(1));
+    CPPUNIT_ASSERT(clone->IsVolumeShared(2));
+    CPPUNIT_ASSERT_EQUAL(GetAddress(image, image->GetVolumeData(2)), GetAddress(clone, clone->GetVolumeData(2)));
+    CPPUNIT_ASSERT_EQUAL(pixel, GetFirstPixel(image, image->GetVolumeData(1)));
+    CPPUNIT_ASSERT_EQUAL(short(pixel + 1), GetFirstPixel(clone, clone->GetVolumeData(1)));
+
+    // outdated items of the shared volume are redirected to the copy
+    auto slice = clone->GetSliceData(0, 2);
+    {
+      mitk::ImageReadAccessor readAccess(image, image->GetVolumeData(0));
+      clone->SetImportVolume(readAccess.GetData(), 2);
+    }
+    SetFirstPixel(clone, pixel, slice);
+    CPPUNIT_ASSERT(!clone->IsVolumeShared(2));
+    CPPUNIT_ASSERT_EQUAL(pixel, GetFirstPixel(clone, clone->GetVolumeData(2)));
+  }
+
+  void ImageTimeSelector_SharedInput_WritesToInputOnly()
+  {
+    auto image = mitk::ImageGenerator::GenerateRandomImage<short>(8, 8, 4, 3, 1.0, 1.0, 1.0, 1000.0, -1000.0);
+    auto clone = image->Clone();
+    const short pixel = GetFirstPixel(image, image->GetVolumeData(1));
+
+    auto timeSelector = mitk::ImageTimeSelector::New();
+    timeSelector->SetInput(clone);
+    timeSelector->SetTimeNr(1);
+    timeSelector->UpdateLargestPossibleRegion();
+    mitk::Image::Pointer output = timeSelector->GetOutput();
+
+    // writing to the output lets the input copy its shared volume first
+    SetFirstPixel(output, pixel + 1);
+    CPPUNIT_ASSERT(!clone->IsVolumeShared(1));
+    CPPUNIT_ASSERT_EQUAL(GetAddress(clone, clone->GetVolumeData(1)), GetAddress(output));
+    CPPUNIT_ASSERT_EQUAL(short(pixel + 1), GetFirstPixel(clone, clone->GetVolumeData(1)));
+    CPPUNIT_ASSERT_EQUAL(pixel, GetFirstPixel(image, image->GetVolumeData(1)));
+  }
+
+  void ImageTimeSelector_NotWritten_SharesMemory()
+  {
+    auto image = mitk::ImageGenerator::GenerateRandomImage<short>(8, 8, 4, 3, 1.0, 1.0, 1.0, 1000.0, -1000.0);
+    auto clone = image->Clone();
+
+    auto timeSelector = mitk::ImageTimeSelector::New();
+    timeSelector->SetInput(clone);
+    timeSelector->SetTimeNr(1);
+    timeSelector->UpdateLargestPossibleRegion();
+    mitk::Image::Pointer output = timeSelector->GetOutput();
+
+    CPPUNIT_ASSERT(clone->IsVolumeShared(1));
+    CPPUNIT_ASSERT_EQUAL(GetAddress(image, image->GetVolumeData(1)), GetAddress(output));
+  }
+
+  void GetData_Write_LeavesCloneUnchanged()
+  {
+    auto image = mitk::ImageGenerator::GenerateRandomImage<short>(8, 8, 4, 3, 1.0, 1.0, 1.0, 1000.0, -1000.0);
+    auto clone = image->Clone();
+    const short pixel = GetFirstPixel(image, image->GetVolumeData(1));
+
+    *static_cast<short *>(clone->GetVolumeData(1)->GetData()) = pixel + 1;
+    CPPUNIT_ASSERT_EQUAL(pixel, GetFirstPixel(image, image->GetVolumeData(1)));
+    CPPUNIT_ASSERT_EQUAL(short(pixel + 1), GetFirstPixel(clone, clone->GetVolumeData(1)));
+
+    // the deprecated Image::GetData() copies the whole channel
+    const short firstPixel = GetFirstPixel(image);
+    auto otherClone = image->Clone();
+    *static_cast<short *>(otherClone->GetData()) = firstPixel + 1;
+    CPPUNIT_ASSERT_EQUAL(firstPixel, GetFirstPixel(image));
+    CPPUNIT_ASSERT_EQUAL(short(firstPixel + 1), GetFirstPixel(otherClone));
+  }
+
+  void SetSharedVolume_ReferencedMemory_CopiesVolume()
+  {
+    unsigned int dimensions[3] = {8, 8, 4};
+    std::vector<short> buffer(8 * 8 * 4, 7);
+
+    auto image = mitk::Image::New();
+    image->Initialize(mitk::MakeScalarPixelType<short>(), 3, dimensions);
+    image->SetImportVolume(buffer.data(), 0, 0, mitk::Image::ReferenceMemory);
+
+    auto other = mitk::Image::New();
+    other->Initialize(image);
+    CPPUNIT_ASSERT(other->SetSharedVolume(image));
+
+    CPPUNIT_ASSERT(!other->IsVolumeShared());
+    CPPUNIT_ASSERT(GetAddress(other) != static_cast<const void *>(buffer.data()));
+    CPPUNIT_ASSERT_EQUAL(short(7), GetFirstPixel(other));
+  }
+
+  void SetSharedVolume_DifferentDimensions_ReturnsFalse()
+  {
+    auto image = mitk::ImageGenerator::GenerateGradientImage<short>(16, 16, 8);
+    auto other = mitk::ImageGenerator::GenerateGradientImage<short>(16, 16, 4);
+    auto otherPixelType = mitk::ImageGenerator::GenerateGradientImage<float>(16, 16, 8);
+
+    CPPUNIT_ASSERT(!other->SetSharedVolume(image));
+    CPPUNIT_ASSERT(!otherPixelType->SetSharedVolume(image));
+    CPPUNIT_ASSERT(!image->IsVolumeShared());
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkImageCopyOnWriteTest)
@@ -0,0 +1,163 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkExtractSliceFilter2.h>
+#include <mitkImage.h>
+#include <mitkImageGenerator.h>
+#include <mitkImageMemoryPool.h>
+#include <mitkMemoryUtilities.h>
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <cstring>
+
+class mitkImageMemoryPoolTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkImageMemoryPoolTestSuite);
+  MITK_TEST(GetSizeClass_WastesAtMostAQuarter);
+  MITK_TEST(Allocate_AfterRelease_ReusesBlock);
+  MITK_TEST(Release_CacheFull_FreesBlock);
+  MITK_TEST(IsPooled_LargeBlock_ReturnsFalse);
+  MITK_TEST(Allocate_HugePages_IsWritable);
+  MITK_TEST(ImageDataItem_SmallImage_IsPooled);
+  MITK_TEST(ExtractSliceFilter2_Update_ReusesSliceMemory);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void GetSizeClass_WastesAtMostAQuarter()
+  {
+    CPPUNIT_ASSERT_EQUAL(std::size_t(4096), mitk::ImageMemoryPool::GetSizeClass(0));
+    CPPUNIT_ASSERT_EQUAL(std::size_t(4096), mitk::ImageMemoryPool::GetSizeClass(4096));
+    CPPUNIT_ASSERT_EQUAL(std::size_t(5120), mitk::ImageMemoryPool::GetSizeClass(4097));
+    CPPUNIT_ASSERT_EQUAL(std::size_t(8192), mitk::ImageMemoryPool::GetSizeClass(8192));
+    CPPUNIT_ASSERT_EQUAL(std::size_t(10240), mitk::ImageMemoryPool::GetSizeClass(8193));
+
+    for (std::size_t size = 4097; size < 10000000; size = size * 3 / 2 + 7)
+    {
+      const std::size_t sizeClass = mitk::ImageMemoryPool::GetSizeClass(size);
+      CPPUNIT_ASSERT(sizeClass >= size);
+      CPPUNIT_ASSERT(sizeClass - size <= size / 4);
+    }
+  }
+
+  void Allocate_AfterRelease_ReusesBlock()
+  {
+    mitk::ImageMemoryPool pool;
+    void *block = pool.Allocate(10000);
+    CPPUNIT_ASSERT_EQUAL(mitk::ImageMemoryPool::GetSizeClass(10000), pool.GetStatistics().BytesInUse);
+
+    pool.Release(block, 10000);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), pool.GetStatistics().BytesInUse);
+    CPPUNIT_ASSERT_EQUAL(mitk::ImageMemoryPool::GetSizeClass(10000), pool.GetStatistics().BytesCached);
+
+    // same size class
+    CPPUNIT_ASSERT_EQUAL(block, pool.Allocate(9500));
+
+    const auto statistics = pool.GetStatistics();
+    CPPUNIT_ASSERT_EQUAL(2ul, statistics.NumberOfAllocations);
+    CPPUNIT_ASSERT_EQUAL(1ul, statistics.NumberOfReuses);
+    CPPUNIT_ASSERT_EQUAL(1ul, statistics.NumberOfReleases);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), statistics.BytesCached);
+    CPPUNIT_ASSERT_EQUAL(statistics.BytesInUse, statistics.PeakBytesInUse);
+
+    pool.Release(block, 9500);
+  }
+
+  void Release_CacheFull_FreesBlock()
+  {
+    mitk::ImageMemoryPool pool;
+    pool.SetCapacity(8192);
+
+    void *blocks[3] = {pool.Allocate(4096), pool.Allocate(4096), pool.Allocate(4096)};
+    for (auto *block : blocks)
+      pool.Release(block, 4096);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(8192), pool.GetStatistics().BytesCached);
+
+    pool.SetCapacity(4096);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(4096), pool.GetStatistics().BytesCached);
+
+    pool.Trim();
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), pool.GetStatistics().BytesCached);
+  }
+
+  void IsPooled_LargeBlock_ReturnsFalse()
+  {
+    mitk::ImageMemoryPool pool;
+    pool.SetMaximumBlockSize(1000000);
+    CPPUNIT_ASSERT(pool.IsPooled(1000000));
+    CPPUNIT_ASSERT(!pool.IsPooled(1000001));
+
+    pool.SetEnabled(false);
+    CPPUNIT_ASSERT(!pool.IsPooled(1000));
+  }
+
+  void Allocate_HugePages_IsWritable()
+  {
+    mitk::ImageMemoryPool pool;
+    pool.SetUseHugePages(true);
+
+    const std::size_t size = 5 * 1024 * 1024;
+    auto *block = static_cast<char *>(pool.Allocate(size));
+    std::memset(block, 1, size);
+    CPPUNIT_ASSERT_EQUAL(char(1), block[size - 1]);
+
+    pool.Release(block, size);
+    CPPUNIT_ASSERT_EQUAL(static_cast<void *>(block), pool.Allocate(size));
+    pool.Release(block, size);
+  }
+
+  void ImageDataItem_SmallImage_IsPooled()
+  {
+    const std::size_t usage = mitk::MemoryUtilities::GetImageMemoryPoolUsage();
+
+    unsigned int dimensions[2] = {100, 100};
+    auto image = mitk::Image::New();
+    image->Initialize(mitk::MakeScalarPixelType<short>(), 2, dimensions);
+
+    auto volume = image->GetVolumeData(0);
+    CPPUNIT_ASSERT(volume->IsPooled());
+    CPPUNIT_ASSERT(mitk::MemoryUtilities::GetImageMemoryPoolUsage() >= usage + 100 * 100 * sizeof(short));
+
+    volume = nullptr;
+    image = nullptr;
+    CPPUNIT_ASSERT_EQUAL(usage, mitk::MemoryUtilities::GetImageMemoryPoolUsage());
+  }
+
+  void ExtractSliceFilter2_Update_ReusesSliceMemory()
+  {
+    auto image = mitk::ImageGenerator::GenerateGradientImage<short>(64, 64, 16);
+
+    mitk::Vector3D right, down;
+    mitk::FillVector3D(right, 1.0, 0.0, 0.0);
+    mitk::FillVector3D(down, 0.0, 1.0, 0.0);
+    auto plane = mitk::PlaneGeometry::New();
+    plane->InitializeStandardPlane(64, 64, right, down, &image->GetGeometry()->GetSpacing());
+    plane->SetOrigin(image->GetGeometry()->GetOrigin());
+    plane->SetImageGeometry(true);
+
+    auto filter = mitk::ExtractSliceFilter2::New();
+    filter->SetInput(image);
+    filter->SetOutputGeometry(plane);
+    filter->Update();
+
+    const auto reuses = mitk::ImageMemoryPool::GetInstance().GetStatistics().NumberOfReuses;
+    for (int i = 0; i < 10; ++i)
+    {
+      filter->Modified();
+      filter->Update();
+    }
+
+    CPPUNIT_ASSERT(mitk::ImageMemoryPool::GetInstance().GetStatistics().NumberOfReuses >= reuses + 10);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkImageMemoryPool)
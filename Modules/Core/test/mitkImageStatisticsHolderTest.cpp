@@ -0,0 +1,188 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+#include "mitkImageGenerator.h"
+#include "mitkImageReadAccessor.h"
+#include "mitkImageStatisticsHolder.h"
+#include "mitkImageWriteAccessor.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+  struct ReferenceExtrema
+  {
+    double Min, Max, SecondMin, SecondMax;
+    unsigned int CountOfMin, CountOfMax;
+  };
+
+  /** Brute force computation of the values provided by the statistics holder. */
+  ReferenceExtrema ComputeReferenceExtrema(const short *data, std::size_t numberOfVoxels)
+  {
+    std::vector<short> values(data, data + numberOfVoxels);
+    std::sort(values.begin(), values.end());
+
+    ReferenceExtrema reference;
+    reference.Min = values.front();
+    reference.Max = values.back();
+    reference.CountOfMin = static_cast<unsigned int>(std::count(values.begin(), values.end(), values.front()));
+    reference.CountOfMax = static_cast<unsigned int>(std::count(values.begin(), values.end(), values.back()));
+    reference.SecondMin = values[std::min<std::size_t>(reference.CountOfMin, values.size() - 1)];
+    reference.SecondMax = values[values.size() - 1 - std::min<std::size_t>(reference.CountOfMax, values.size() - 1)];
+    return reference;
+  }
+}
+
+class mitkImageStatisticsHolderTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkImageStatisticsHolderTestSuite);
+  MITK_TEST(GetScalarValues_RandomImage_EqualBruteForce);
+  MITK_TEST(GetScalarValues_PartialWrite_AreUpdated);
+  MITK_TEST(GetScalarValues_UnreportedWriteAfterReportedWrite_AreUpdated);
+  MITK_TEST(GetScalarValues_TimeSteps_AreIndependent);
+  MITK_TEST(GetScalarValues_ProgressivelyLoadedSlice_AreUpdated);
+  MITK_TEST(GetScalarHistogram_RandomImage_ContainsAllVoxels);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  mitk::Image::Pointer m_Image;
+
+  static const unsigned int DIMENSION = 64;
+
+  void CheckAgainstReference(unsigned int t)
+  {
+    mitk::ImageReadAccessor readAccess(m_Image, m_Image->GetVolumeData(t));
+    const auto reference = ComputeReferenceExtrema(static_cast<const short *>(readAccess.GetData()),
+                                                   DIMENSION * DIMENSION * DIMENSION);
+
+    auto statistics = m_Image->GetStatistics();
+    CPPUNIT_ASSERT_EQUAL(reference.Min, statistics->GetScalarValueMin(t));
+    CPPUNIT_ASSERT_EQUAL(reference.Max, statistics->GetScalarValueMax(t));
+    CPPUNIT_ASSERT_EQUAL(reference.SecondMin, statistics->GetScalarValue2ndMin(t));
+    CPPUNIT_ASSERT_EQUAL(reference.SecondMax, statistics->GetScalarValue2ndMax(t));
+    CPPUNIT_ASSERT_EQUAL(static_cast<double>(reference.CountOfMin), statistics->GetCountOfMinValuedVoxels(t));
+    CPPUNIT_ASSERT_EQUAL(static_cast<double>(reference.CountOfMax), statistics->GetCountOfMaxValuedVoxels(t));
+  }
+
+public:
+  void setUp() override
+  {
+    m_Image = mitk::ImageGenerator::GenerateRandomImage<short>(DIMENSION, DIMENSION, DIMENSION, 2, 1, 1, 1, 1000, -1000);
+  }
+
+  void tearDown() override { m_Image = nullptr; }
+
+  void GetScalarValues_RandomImage_EqualBruteForce() { CheckAgainstReference(0); }
+
+  void GetScalarValues_PartialWrite_AreUpdated()
+  {
+    CheckAgainstReference(0);
+
+    {
+      mitk::ImageWriteAccessor writeAccess(m_Image, m_Image->GetVolumeData(0));
+      short *data = static_cast<short *>(writeAccess.GetData());
+      const std::size_t sliceOffset = 10 * DIMENSION * DIMENSION;
+      data[sliceOffset] = 2000;
+      data[sliceOffset + 1] = -2000;
+    }
+    m_Image->Modified();
+    CheckAgainstReference(0);
+    CPPUNIT_ASSERT_EQUAL(2000.0, m_Image->GetStatistics()->GetScalarValueMax(0));
+    CPPUNIT_ASSERT_EQUAL(-2000.0, m_Image->GetStatistics()->GetScalarValueMin(0));
+
+    // undo the change: the previous extrema have to come back
+    {
+      mitk::ImageWriteAccessor writeAccess(m_Image, m_Image->GetVolumeData(0));
+      short *data = static_cast<short *>(writeAccess.GetData());
+      const std::size_t sliceOffset = 10 * DIMENSION * DIMENSION;
+      data[sliceOffset] = 0;
+      data[sliceOffset + 1] = 0;
+    }
+    m_Image->Modified();
+    CheckAgainstReference(0);
+  }
+
+  void GetScalarValues_UnreportedWriteAfterReportedWrite_AreUpdated()
+  {
+    CheckAgainstReference(0);
+
+    {
+      mitk::ImageWriteAccessor writeAccess(m_Image, m_Image->GetVolumeData(0));
+      static_cast<short *>(writeAccess.GetData())[10 * DIMENSION * DIMENSION] = 2000;
+    }
+    m_Image->Modified();
+
+    // a write that bypasses the accessors is not reported, the whole volume has to be recomputed
+    short *data = static_cast<short *>(m_Image->GetVolumeData(0)->GetData());
+    data[40 * DIMENSION * DIMENSION] = 4000;
+    m_Image->Modified();
+
+    CheckAgainstReference(0);
+    CPPUNIT_ASSERT_EQUAL(4000.0, m_Image->GetStatistics()->GetScalarValueMax(0));
+  }
+
+  void GetScalarValues_TimeSteps_AreIndependent()
+  {
+    {
+      mitk::ImageWriteAccessor writeAccess(m_Image, m_Image->GetVolumeData(1));
+      static_cast<short *>(writeAccess.GetData())[0] = 5000;
+    }
+    m_Image->Modified();
+
+    CheckAgainstReference(0);
+    CheckAgainstReference(1);
+    CPPUNIT_ASSERT_EQUAL(5000.0, m_Image->GetStatistics()->GetScalarValueMax(1));
+    CPPUNIT_ASSERT(m_Image->GetStatistics()->GetScalarValueMax(0) < 5000.0);
+  }
+
+  void GetScalarValues_ProgressivelyLoadedSlice_AreUpdated()
+  {
+    m_Image->BeginProgressiveLoading();
+    CPPUNIT_ASSERT(m_Image->IsLoadingProgressively());
+    CPPUNIT_ASSERT(!m_Image->IsSliceLoaded(3, 0));
+    CheckAgainstReference(0);
+
+    // a streaming reader writes without accessors and without calling Modified()
+    short *data = static_cast<short *>(m_Image->GetVolumeData(0)->GetData());
+    data[3 * DIMENSION * DIMENSION] = 3000;
+    m_Image->SetSliceLoaded(3, 0);
+
+    CPPUNIT_ASSERT(m_Image->IsSliceLoaded(3, 0));
+    CPPUNIT_ASSERT_EQUAL(1u, m_Image->GetNumberOfLoadedSlices());
+    CheckAgainstReference(0);
+    CPPUNIT_ASSERT_EQUAL(3000.0, m_Image->GetStatistics()->GetScalarValueMax(0));
+
+    m_Image->EndProgressiveLoading();
+    m_Image->WaitForProgressiveLoading();
+    CPPUNIT_ASSERT(!m_Image->IsLoadingProgressively());
+    CPPUNIT_ASSERT(m_Image->IsSliceLoaded(4, 0));
+  }
+
+  void GetScalarHistogram_RandomImage_ContainsAllVoxels()
+  {
+    auto statistics = m_Image->GetStatistics();
+    const auto *histogram = statistics->GetScalarHistogram(0);
+    CPPUNIT_ASSERT(histogram != nullptr);
+    CPPUNIT_ASSERT_EQUAL(static_cast<double>(DIMENSION * DIMENSION * DIMENSION),
+                         static_cast<double>(histogram->GetTotalFrequency()));
+    CPPUNIT_ASSERT_EQUAL(statistics->GetScalarValueMin(0), histogram->GetBinMin(0, 0));
+
+    // a second request is served from the cache
+    CPPUNIT_ASSERT(statistics->GetScalarHistogram(0) == histogram);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkImageStatisticsHolder)
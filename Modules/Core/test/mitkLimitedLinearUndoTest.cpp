@@ -0,0 +1,191 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkInteractionConst.h>
+#include <mitkLimitedLinearUndo.h>
+#include <mitkOperationEvent.h>
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+#include <mitkVerboseLimitedLinearUndo.h>
+
+namespace
+{
+  /** Operation that pretends to hold the given number of bytes.*/
+  class MemoryOperation : public mitk::Operation
+  {
+  public:
+    MemoryOperation(std::size_t memorySize) : Operation(mitk::OpTEST), m_MemorySize(memorySize) {}
+    std::size_t GetMemorySize() const override { return m_MemorySize; }
+
+  private:
+    std::size_t m_MemorySize;
+  };
+
+  /** Creates an item of its own group, or of the current group if newGroup is false.*/
+  mitk::OperationEvent *CreateOperationEvent(std::size_t memorySize, bool newGroup = true)
+  {
+    auto *operationEvent = new mitk::OperationEvent(
+      nullptr, new MemoryOperation(memorySize), new MemoryOperation(memorySize), "Test");
+    mitk::OperationEvent::IncCurrObjectEventId();
+    if (newGroup)
+      mitk::OperationEvent::IncCurrGroupEventId();
+    return operationEvent;
+  }
+}
+
+class mitkLimitedLinearUndoTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkLimitedLinearUndoTestSuite);
+  MITK_TEST(GetMemorySize_OperationEvent_IncludesBothOperations);
+  MITK_TEST(GetMemoryLimit_Default_IsUnlimited);
+  MITK_TEST(UndoRedo_MemorySize_FollowsUndoList);
+  MITK_TEST(SetOperationEvent_MemoryLimitExceeded_DropsWholeGroups);
+  MITK_TEST(SetOperationEvent_MemoryLimitExceeded_DropsOldestItems);
+  MITK_TEST(SetOperationEvent_ItemLargerThanLimit_KeepsItem);
+  MITK_TEST(SetMemoryLimit_Decreased_DropsOldestItems);
+  MITK_TEST(SetUndoLimit_Decreased_DropsOldestItems);
+  MITK_TEST(VerboseLimitedLinearUndo_MemoryLimitExceeded_DropsOldestItems);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void GetMemorySize_OperationEvent_IncludesBothOperations()
+  {
+    auto *operationEvent = CreateOperationEvent(1000);
+    CPPUNIT_ASSERT(operationEvent->GetMemorySize() >= 2000);
+    CPPUNIT_ASSERT(operationEvent->GetMemorySize() < 3000);
+    delete operationEvent;
+  }
+
+  void GetMemoryLimit_Default_IsUnlimited()
+  {
+    auto undoModel = mitk::LimitedLinearUndo::New();
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), undoModel->GetMemoryLimit());
+  }
+
+  void UndoRedo_MemorySize_FollowsUndoList()
+  {
+    auto undoModel = mitk::LimitedLinearUndo::New();
+    undoModel->SetOperationEvent(CreateOperationEvent(1000));
+    const std::size_t itemMemorySize = undoModel->GetUndoListMemorySize();
+    undoModel->SetOperationEvent(CreateOperationEvent(1000));
+    CPPUNIT_ASSERT_EQUAL(2 * itemMemorySize, undoModel->GetUndoListMemorySize());
+
+    undoModel->Undo();
+    CPPUNIT_ASSERT_EQUAL(itemMemorySize, undoModel->GetUndoListMemorySize());
+    undoModel->Redo();
+    CPPUNIT_ASSERT_EQUAL(2 * itemMemorySize, undoModel->GetUndoListMemorySize());
+
+    undoModel->Clear();
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), undoModel->GetUndoListMemorySize());
+  }
+
+  void SetOperationEvent_MemoryLimitExceeded_DropsWholeGroups()
+  {
+    auto undoModel = mitk::LimitedLinearUndo::New();
+    undoModel->SetMemoryLimit(9 * 1000 * 1000);
+
+    // a group of three items followed by single items of 2 MB each
+    undoModel->SetOperationEvent(CreateOperationEvent(1000 * 1000, false));
+    undoModel->SetOperationEvent(CreateOperationEvent(1000 * 1000, false));
+    undoModel->SetOperationEvent(CreateOperationEvent(1000 * 1000));
+    undoModel->SetOperationEvent(CreateOperationEvent(1000 * 1000));
+    CPPUNIT_ASSERT(undoModel->GetUndoListMemorySize() >= 8 * 1000 * 1000);
+
+    // exceeding the limit by one item drops the whole group
+    undoModel->SetOperationEvent(CreateOperationEvent(1000 * 1000));
+    CPPUNIT_ASSERT(undoModel->GetUndoListMemorySize() >= 4 * 1000 * 1000);
+    CPPUNIT_ASSERT(undoModel->GetUndoListMemorySize() < 5 * 1000 * 1000);
+  }
+
+  void SetOperationEvent_MemoryLimitExceeded_DropsOldestItems()
+  {
+    auto undoModel = mitk::LimitedLinearUndo::New();
+    undoModel->SetMemoryLimit(10 * 1000 * 1000);
+
+    for (int i = 0; i < 10; ++i)
+      undoModel->SetOperationEvent(CreateOperationEvent(1000 * 1000));
+
+    CPPUNIT_ASSERT(undoModel->GetUndoListMemorySize() <= 10 * 1000 * 1000);
+    CPPUNIT_ASSERT(undoModel->GetUndoListMemorySize() >= 8 * 1000 * 1000);
+
+    // undo stops at the bottom of the stack
+    int numberOfUndos = 0;
+    while (undoModel->Undo())
+      ++numberOfUndos;
+    CPPUNIT_ASSERT_EQUAL(3, numberOfUndos);
+  }
+
+  void SetOperationEvent_ItemLargerThanLimit_KeepsItem()
+  {
+    auto undoModel = mitk::LimitedLinearUndo::New();
+    undoModel->SetMemoryLimit(1000);
+
+    undoModel->SetOperationEvent(CreateOperationEvent(10000));
+    undoModel->SetOperationEvent(CreateOperationEvent(10000));
+
+    CPPUNIT_ASSERT(undoModel->GetUndoListMemorySize() >= 20000);
+    CPPUNIT_ASSERT(undoModel->GetUndoListMemorySize() < 30000);
+  }
+
+  void SetMemoryLimit_Decreased_DropsOldestItems()
+  {
+    auto undoModel = mitk::LimitedLinearUndo::New();
+    for (int i = 0; i < 10; ++i)
+      undoModel->SetOperationEvent(CreateOperationEvent(1000 * 1000));
+    CPPUNIT_ASSERT(undoModel->GetUndoListMemorySize() >= 20 * 1000 * 1000);
+
+    undoModel->SetMemoryLimit(5 * 1000 * 1000);
+    CPPUNIT_ASSERT(undoModel->GetUndoListMemorySize() <= 5 * 1000 * 1000);
+
+    undoModel->SetMemoryLimit(0);
+    for (int i = 0; i < 10; ++i)
+      undoModel->SetOperationEvent(CreateOperationEvent(1000 * 1000));
+    CPPUNIT_ASSERT(undoModel->GetUndoListMemorySize() >= 20 * 1000 * 1000);
+  }
+
+  void SetUndoLimit_Decreased_DropsOldestItems()
+  {
+    auto undoModel = mitk::LimitedLinearUndo::New();
+    for (int i = 0; i < 10; ++i)
+      undoModel->SetOperationEvent(CreateOperationEvent(100));
+
+    undoModel->SetUndoLimit(4);
+    const std::size_t memorySize = undoModel->GetUndoListMemorySize();
+    CPPUNIT_ASSERT_EQUAL(memorySize, 4 * CreateOperationEventMemorySize(100));
+
+    undoModel->SetOperationEvent(CreateOperationEvent(100));
+    CPPUNIT_ASSERT_EQUAL(memorySize, undoModel->GetUndoListMemorySize());
+  }
+
+  void VerboseLimitedLinearUndo_MemoryLimitExceeded_DropsOldestItems()
+  {
+    auto undoModel = mitk::VerboseLimitedLinearUndo::New();
+    undoModel->SetMemoryLimit(10 * 1000 * 1000);
+
+    for (int i = 0; i < 10; ++i)
+      undoModel->SetOperationEvent(CreateOperationEvent(1000 * 1000));
+
+    CPPUNIT_ASSERT(undoModel->GetUndoListMemorySize() <= 10 * 1000 * 1000);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(4), undoModel->GetUndoDescriptions().size());
+  }
+
+private:
+  static std::size_t CreateOperationEventMemorySize(std::size_t operationMemorySize)
+  {
+    auto *operationEvent = CreateOperationEvent(operationMemorySize);
+    const std::size_t memorySize = operationEvent->GetMemorySize();
+    delete operationEvent;
+    return memorySize;
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkLimitedLinearUndo)
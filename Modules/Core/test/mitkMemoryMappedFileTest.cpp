@@ -0,0 +1,178 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkIOUtil.h>
+#include <mitkImage.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkImageWriteAccessor.h>
+#include <mitkMemoryMappedFile.h>
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <itksys/SystemTools.hxx>
+
+#include <fstream>
+#include <vector>
+
+class mitkMemoryMappedFileTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkMemoryMappedFileTestSuite);
+  MITK_TEST(New_UnalignedOffset_MapsRegion);
+  MITK_TEST(New_RegionBeyondEndOfFile_Throws);
+  MITK_TEST(Write_MappedData_DoesNotChangeFile);
+  MITK_TEST(Load_UncompressedNrrd_IsMemoryMapped);
+  MITK_TEST(Load_UncompressedMetaImage_IsMemoryMapped);
+  MITK_TEST(Save_ToMappedFile_WritesModifiedImage);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  std::string m_TempDirectory;
+  std::vector<short> m_Pixels;
+
+  static bool IsBigEndianHost()
+  {
+    const unsigned short one = 1;
+    return 0 == *reinterpret_cast<const unsigned char *>(&one);
+  }
+
+  std::string WriteFile(const std::string &fileName, const std::string &header)
+  {
+    const std::string path = m_TempDirectory + "/" + fileName;
+    std::ofstream file(path.c_str(), std::ios::binary);
+    file << header;
+    file.write(reinterpret_cast<const char *>(m_Pixels.data()), m_Pixels.size() * sizeof(short));
+    return path;
+  }
+
+  std::string WriteNrrd()
+  {
+    return this->WriteFile("image.nrrd",
+                           std::string("NRRD0004\ntype: short\ndimension: 3\nsizes: 4 5 6\nendian: ") +
+                             (IsBigEndianHost() ? "big" : "little") + "\nencoding: raw\n\n");
+  }
+
+  /** Reads the pixels at the end of the file.*/
+  std::vector<short> ReadPixels(const std::string &path)
+  {
+    std::vector<short> pixels(m_Pixels.size());
+    std::ifstream file(path.c_str(), std::ios::binary);
+    file.seekg(-static_cast<std::streamoff>(pixels.size() * sizeof(short)), std::ios::end);
+    file.read(reinterpret_cast<char *>(pixels.data()), pixels.size() * sizeof(short));
+    return pixels;
+  }
+
+  void CheckPixels(const mitk::Image *image, const std::vector<short> &expectedPixels)
+  {
+    mitk::ImageReadAccessor readAccess(image);
+    const auto *pixels = static_cast<const short *>(readAccess.GetData());
+    for (std::size_t i = 0; i < expectedPixels.size(); ++i)
+    {
+      CPPUNIT_ASSERT_EQUAL(expectedPixels[i], pixels[i]);
+    }
+  }
+
+public:
+  void setUp() override
+  {
+    m_TempDirectory = mitk::IOUtil::CreateTemporaryDirectory("mitkMemoryMappedFileTest-XXXXXX");
+    m_Pixels.resize(4 * 5 * 6);
+    for (std::size_t i = 0; i < m_Pixels.size(); ++i)
+    {
+      m_Pixels[i] = static_cast<short>(i * 7 - 300);
+    }
+  }
+
+  void tearDown() override { itksys::SystemTools::RemoveADirectory(m_TempDirectory.c_str()); }
+
+  void New_UnalignedOffset_MapsRegion()
+  {
+    const std::string path = this->WriteFile("data.raw", "abc");
+
+    auto mappedFile = mitk::MemoryMappedFile::New(path, 3, m_Pixels.size() * sizeof(short));
+    CPPUNIT_ASSERT_EQUAL(m_Pixels.size() * sizeof(short), mappedFile->GetSize());
+
+    const auto *pixels = static_cast<const short *>(mappedFile->GetData());
+    for (std::size_t i = 0; i < m_Pixels.size(); ++i)
+    {
+      CPPUNIT_ASSERT_EQUAL(m_Pixels[i], pixels[i]);
+    }
+  }
+
+  void New_RegionBeyondEndOfFile_Throws()
+  {
+    const std::string path = this->WriteFile("data.raw", "abc");
+    CPPUNIT_ASSERT_THROW(mitk::MemoryMappedFile::New(path, 4, m_Pixels.size() * sizeof(short)), mitk::Exception);
+    CPPUNIT_ASSERT_THROW(mitk::MemoryMappedFile::New(m_TempDirectory + "/missing.raw", 0, 1), mitk::Exception);
+  }
+
+  void Write_MappedData_DoesNotChangeFile()
+  {
+    const std::string path = this->WriteFile("data.raw", "");
+    {
+      auto mappedFile = mitk::MemoryMappedFile::New(path, 0, m_Pixels.size() * sizeof(short));
+      static_cast<short *>(mappedFile->GetData())[0] = 42;
+      CPPUNIT_ASSERT_EQUAL(short(42), static_cast<const short *>(mappedFile->GetData())[0]);
+    }
+
+    auto mappedFile = mitk::MemoryMappedFile::New(path, 0, m_Pixels.size() * sizeof(short));
+    CPPUNIT_ASSERT_EQUAL(m_Pixels[0], static_cast<const short *>(mappedFile->GetData())[0]);
+  }
+
+  void Load_UncompressedNrrd_IsMemoryMapped()
+  {
+    auto image = mitk::IOUtil::Load<mitk::Image>(this->WriteNrrd());
+
+#ifndef _WIN32
+    CPPUNIT_ASSERT_MESSAGE("Raw NRRD data is mapped.", image->GetChannelData()->IsMemoryMapped());
+#endif
+    CPPUNIT_ASSERT_EQUAL(6u, image->GetDimension(2));
+    this->CheckPixels(image, m_Pixels);
+  }
+
+  void Load_UncompressedMetaImage_IsMemoryMapped()
+  {
+    const std::string path =
+      this->WriteFile("image.mha",
+                      std::string("ObjectType = Image\nNDims = 3\nBinaryData = True\nBinaryDataByteOrderMSB = ") +
+                        (IsBigEndianHost() ? "True" : "False") +
+                        "\nCompressedData = False\nDimSize = 4 5 6\nElementType = MET_SHORT\nElementDataFile = LOCAL\n");
+
+    auto image = mitk::IOUtil::Load<mitk::Image>(path);
+
+#ifndef _WIN32
+    CPPUNIT_ASSERT_MESSAGE("Uncompressed MetaImage data is mapped.", image->GetChannelData()->IsMemoryMapped());
+#endif
+    this->CheckPixels(image, m_Pixels);
+  }
+
+  void Save_ToMappedFile_WritesModifiedImage()
+  {
+    const std::string path = this->WriteNrrd();
+    auto image = mitk::IOUtil::Load<mitk::Image>(path);
+
+    std::vector<short> modifiedPixels = m_Pixels;
+    modifiedPixels[5] = 1234;
+    {
+      mitk::ImageWriteAccessor writeAccess(image);
+      static_cast<short *>(writeAccess.GetData())[5] = 1234;
+    }
+
+    CPPUNIT_ASSERT_MESSAGE("Modifying the image does not change the file.", m_Pixels == this->ReadPixels(path));
+
+    // the (compressed) file is written from the mapped data of the file itself
+    mitk::IOUtil::Save(image, path);
+    this->CheckPixels(image, modifiedPixels);
+    this->CheckPixels(mitk::IOUtil::Load<mitk::Image>(path), modifiedPixels);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkMemoryMappedFile)
@@ -0,0 +1,155 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkImageGenerator.h>
+#include <mitkResliceCache.h>
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <vtkDataArray.h>
+#include <vtkPointData.h>
+
+class mitkResliceCacheTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkResliceCacheTestSuite);
+  MITK_TEST(Find_InsertedSlice_ReturnsSlice);
+  MITK_TEST(Insert_MoreSlicesThanCapacity_EvictsLeastRecentlyUsed);
+  MITK_TEST(Find_ModifiedImage_ReturnsFalse);
+  MITK_TEST(Prefetch_Planes_EqualsExtractSliceFilter);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  mitk::Image::Pointer m_Image;
+
+  mitk::PlaneGeometry::Pointer CreateAxialPlane(int slice)
+  {
+    mitk::PlaneGeometry::Pointer plane = mitk::PlaneGeometry::New();
+    plane->InitializeStandardPlane(m_Image->GetGeometry(), mitk::PlaneGeometry::Axial, slice, true, false);
+    return plane;
+  }
+
+  mitk::ResliceCache::Key CreateKey(int slice)
+  {
+    return mitk::ResliceCache::CreateKey(
+      m_Image, this->CreateAxialPlane(slice), 0, mitk::ExtractSliceFilter::RESLICE_NEAREST, false);
+  }
+
+  mitk::ResliceCache::Slice Reslice(int slice)
+  {
+    mitk::ExtractSliceFilter::Pointer reslicer = mitk::ExtractSliceFilter::New();
+    reslicer->SetInput(m_Image);
+    reslicer->SetWorldGeometry(this->CreateAxialPlane(slice));
+    reslicer->SetResliceTransformByGeometry(m_Image->GetTimeGeometry()->GetGeometryForTimeStep(0));
+    reslicer->SetVtkOutputRequest(true);
+    reslicer->Update();
+    return mitk::ResliceCache::CreateSlice(reslicer->GetVtkOutput(), reslicer);
+  }
+
+public:
+  void setUp() override
+  {
+    m_Image = mitk::ImageGenerator::GenerateGradientImage<float>(8, 8, 8);
+  }
+
+  void tearDown() override { m_Image = nullptr; }
+
+  void Find_InsertedSlice_ReturnsSlice()
+  {
+    mitk::ResliceCache cache;
+    const mitk::ResliceCache::Slice slice = this->Reslice(3);
+    cache.Insert(this->CreateKey(3), slice);
+
+    mitk::ResliceCache::Slice cachedSlice;
+    CPPUNIT_ASSERT_MESSAGE("Slice of a plane with equal parameters is found.", cache.Find(this->CreateKey(3), cachedSlice));
+    CPPUNIT_ASSERT(cachedSlice.image == slice.image);
+    CPPUNIT_ASSERT(!cache.Find(this->CreateKey(4), cachedSlice));
+
+    const auto linearKey = mitk::ResliceCache::CreateKey(
+      m_Image, this->CreateAxialPlane(3), 0, mitk::ExtractSliceFilter::RESLICE_LINEAR, false);
+    CPPUNIT_ASSERT_MESSAGE("Other interpolation mode is not found.", !cache.Find(linearKey, cachedSlice));
+  }
+
+  void Insert_MoreSlicesThanCapacity_EvictsLeastRecentlyUsed()
+  {
+    mitk::ResliceCache cache;
+    cache.SetCapacity(2);
+
+    cache.Insert(this->CreateKey(0), this->Reslice(0));
+    cache.Insert(this->CreateKey(1), this->Reslice(1));
+
+    mitk::ResliceCache::Slice cachedSlice;
+    CPPUNIT_ASSERT(cache.Find(this->CreateKey(0), cachedSlice));
+
+    cache.Insert(this->CreateKey(2), this->Reslice(2));
+    CPPUNIT_ASSERT_EQUAL(2u, cache.GetNumberOfSlices());
+    CPPUNIT_ASSERT_MESSAGE("Recently used slice was evicted.", cache.Find(this->CreateKey(0), cachedSlice));
+    CPPUNIT_ASSERT_MESSAGE("Least recently used slice was not evicted.", !cache.Find(this->CreateKey(1), cachedSlice));
+    CPPUNIT_ASSERT(cache.Find(this->CreateKey(2), cachedSlice));
+
+    cache.SetCapacity(0);
+    CPPUNIT_ASSERT_EQUAL(0u, cache.GetNumberOfSlices());
+    cache.Insert(this->CreateKey(2), this->Reslice(2));
+    CPPUNIT_ASSERT_EQUAL(0u, cache.GetNumberOfSlices());
+  }
+
+  void Find_ModifiedImage_ReturnsFalse()
+  {
+    mitk::ResliceCache cache;
+    cache.Insert(this->CreateKey(3), this->Reslice(3));
+
+    m_Image->Modified();
+
+    mitk::ResliceCache::Slice cachedSlice;
+    CPPUNIT_ASSERT_MESSAGE("Slice of the unmodified image is found.", !cache.Find(this->CreateKey(3), cachedSlice));
+  }
+
+  void Prefetch_Planes_EqualsExtractSliceFilter()
+  {
+    mitk::ResliceCache cache;
+    std::vector<mitk::PlaneGeometry::ConstPointer> planes;
+    for (int slice : {2, 4, 5})
+    {
+      planes.emplace_back(this->CreateAxialPlane(slice));
+    }
+
+    cache.Prefetch(m_Image, planes, 0, mitk::ExtractSliceFilter::RESLICE_NEAREST, false);
+    cache.WaitForPrefetch();
+    CPPUNIT_ASSERT_EQUAL(3u, cache.GetNumberOfSlices());
+
+    for (int slice : {2, 4, 5})
+    {
+      mitk::ResliceCache::Slice cachedSlice;
+      CPPUNIT_ASSERT_MESSAGE("Prefetched slice is found.", cache.Find(this->CreateKey(slice), cachedSlice));
+
+      const mitk::ResliceCache::Slice expectedSlice = this->Reslice(slice);
+      CPPUNIT_ASSERT(mitk::Equal(expectedSlice.spacing[0], cachedSlice.spacing[0]));
+      CPPUNIT_ASSERT(mitk::Equal(expectedSlice.spacing[1], cachedSlice.spacing[1]));
+      for (int i = 0; i < 4; ++i)
+      {
+        for (int j = 0; j < 4; ++j)
+        {
+          CPPUNIT_ASSERT(mitk::Equal(expectedSlice.resliceAxes->GetElement(i, j), cachedSlice.resliceAxes->GetElement(i, j)));
+        }
+      }
+
+      vtkDataArray *expectedScalars = expectedSlice.image->GetPointData()->GetScalars();
+      vtkDataArray *cachedScalars = cachedSlice.image->GetPointData()->GetScalars();
+      CPPUNIT_ASSERT_EQUAL(expectedScalars->GetNumberOfTuples(), cachedScalars->GetNumberOfTuples());
+      for (vtkIdType id = 0; id < expectedScalars->GetNumberOfTuples(); ++id)
+      {
+        CPPUNIT_ASSERT_EQUAL(expectedScalars->GetTuple1(id), cachedScalars->GetTuple1(id));
+      }
+    }
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkResliceCache)
@@ -0,0 +1,109 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+#include "mitkImage.h"
+#include "mitkNodePredicateAnd.h"
+#include "mitkNodePredicateDataType.h"
+#include "mitkNodePredicateProperty.h"
+#include "mitkProperties.h"
+#include "mitkStandaloneDataStorage.h"
+#include "mitkStringProperty.h"
+#include "mitkSurface.h"
+
+#include <itkTimeProbe.h>
+
+#include <sstream>
+
+namespace
+{
+  /** Evaluates the predicate on every node, i.e. the way DataStorage::GetSubset() works without index. */
+  mitk::DataStorage::SetOfObjects::ConstPointer LinearSubset(const mitk::DataStorage *storage,
+                                                            const mitk::NodePredicateBase *predicate)
+  {
+    auto result = mitk::DataStorage::SetOfObjects::New();
+    auto all = storage->GetAll();
+    for (auto node : *all)
+      if (predicate->CheckNode(node))
+        result->InsertElement(result->Size(), node);
+    return result.GetPointer();
+  }
+
+  void FillDataStorage(mitk::DataStorage *storage, unsigned int numberOfNodes)
+  {
+    for (unsigned int i = 0; i < numberOfNodes; ++i)
+    {
+      auto node = mitk::DataNode::New();
+      std::ostringstream name;
+      name << "node" << i;
+      node->SetName(name.str());
+      if (i % 3 == 0)
+        node->SetData(mitk::Image::New());
+      else if (i % 3 == 1)
+        node->SetData(mitk::Surface::New());
+      node->SetBoolProperty("helper object", i % 5 == 0);
+      if (i % 2 == 0)
+        node->SetBoolProperty("binary", i % 4 == 0);
+      storage->Add(node);
+    }
+  }
+}
+
+/** Reports query latency of indexed and linear queries against the number of nodes.
+ * Only built with MITK_BUILD_BENCHMARKS. */
+class mitkStandaloneDataStorageIndexBenchmarkSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkStandaloneDataStorageIndexBenchmarkSuite);
+  MITK_TEST(GetSubset);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void GetSubset()
+  {
+    const unsigned int numberOfQueries = 100;
+    auto isBinaryImage = mitk::NodePredicateAnd::New(
+      mitk::NodePredicateDataType::New("Image"),
+      mitk::NodePredicateProperty::New("binary", mitk::BoolProperty::New(true)));
+    auto isNamed = mitk::NodePredicateProperty::New("name", mitk::StringProperty::New("node1"));
+
+    for (unsigned int numberOfNodes : {100u, 1000u, 5000u})
+    {
+      auto dataStorage = mitk::StandaloneDataStorage::New();
+      FillDataStorage(dataStorage, numberOfNodes);
+
+      itk::TimeProbe indexedProbe;
+      indexedProbe.Start();
+      for (unsigned int i = 0; i < numberOfQueries; ++i)
+      {
+        dataStorage->GetNamedNode("node1");
+        dataStorage->GetSubset(isBinaryImage);
+      }
+      indexedProbe.Stop();
+
+      itk::TimeProbe linearProbe;
+      linearProbe.Start();
+      for (unsigned int i = 0; i < numberOfQueries; ++i)
+      {
+        LinearSubset(dataStorage, isNamed);
+        LinearSubset(dataStorage, isBinaryImage);
+      }
+      linearProbe.Stop();
+
+      MITK_INFO << numberOfNodes << " nodes: indexed " << indexedProbe.GetMean() * 1000.0 / numberOfQueries
+                << " ms/query, linear " << linearProbe.GetMean() * 1000.0 / numberOfQueries << " ms/query";
+    }
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkStandaloneDataStorageIndexBenchmark)
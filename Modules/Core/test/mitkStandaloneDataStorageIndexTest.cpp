@@ -0,0 +1,179 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+#include "mitkImage.h"
+#include "mitkNodePredicateAnd.h"
+#include "mitkNodePredicateDataType.h"
+#include "mitkNodePredicateNot.h"
+#include "mitkNodePredicateOr.h"
+#include "mitkNodePredicateProperty.h"
+#include "mitkProperties.h"
+#include "mitkStandaloneDataStorage.h"
+#include "mitkStringProperty.h"
+#include "mitkSurface.h"
+
+#include <sstream>
+
+namespace
+{
+  /** Evaluates the predicate on every node, i.e. the way DataStorage::GetSubset() works without index. */
+  mitk::DataStorage::SetOfObjects::ConstPointer LinearSubset(const mitk::DataStorage *storage,
+                                                            const mitk::NodePredicateBase *predicate)
+  {
+    auto result = mitk::DataStorage::SetOfObjects::New();
+    auto all = storage->GetAll();
+    for (auto node : *all)
+      if (predicate->CheckNode(node))
+        result->InsertElement(result->Size(), node);
+    return result.GetPointer();
+  }
+
+  bool EqualSets(const mitk::DataStorage::SetOfObjects *a, const mitk::DataStorage::SetOfObjects *b)
+  {
+    if (a->Size() != b->Size())
+      return false;
+
+    for (mitk::DataStorage::SetOfObjects::ElementIdentifier i = 0; i < a->Size(); ++i)
+      if (a->GetElement(i) != b->GetElement(i))
+        return false;
+
+    return true;
+  }
+
+  void FillDataStorage(mitk::DataStorage *storage, unsigned int numberOfNodes)
+  {
+    for (unsigned int i = 0; i < numberOfNodes; ++i)
+    {
+      auto node = mitk::DataNode::New();
+      std::ostringstream name;
+      name << "node" << i;
+      node->SetName(name.str());
+      if (i % 3 == 0)
+        node->SetData(mitk::Image::New());
+      else if (i % 3 == 1)
+        node->SetData(mitk::Surface::New());
+      node->SetBoolProperty("helper object", i % 5 == 0);
+      if (i % 2 == 0)
+        node->SetBoolProperty("binary", i % 4 == 0);
+      storage->Add(node);
+    }
+  }
+}
+
+class mitkStandaloneDataStorageIndexTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkStandaloneDataStorageIndexTestSuite);
+  MITK_TEST(GetSubset_IndexedPredicates_EqualsLinearScan);
+  MITK_TEST(GetSubset_NotIndexedPredicates_EqualsLinearScan);
+  MITK_TEST(GetSubset_ModifiedNodes_IndexIsUpdated);
+  MITK_TEST(GetSubset_RemovedNodes_AreNotReturned);
+  MITK_TEST(AddIndexedPropertyKey_ExistingNodes_AreIndexed);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  mitk::StandaloneDataStorage::Pointer m_DataStorage;
+
+  void CheckAgainstLinearScan(const mitk::NodePredicateBase *predicate, const std::string &message)
+  {
+    auto indexed = m_DataStorage->GetSubset(predicate);
+    auto linear = LinearSubset(m_DataStorage, predicate);
+    CPPUNIT_ASSERT_MESSAGE(message, EqualSets(indexed, linear));
+  }
+
+public:
+  void setUp() override
+  {
+    m_DataStorage = mitk::StandaloneDataStorage::New();
+    FillDataStorage(m_DataStorage, 100);
+  }
+
+  void tearDown() override { m_DataStorage = nullptr; }
+
+  void GetSubset_IndexedPredicates_EqualsLinearScan()
+  {
+    auto isImage = mitk::NodePredicateDataType::New("Image");
+    auto isHelper = mitk::NodePredicateProperty::New("helper object", mitk::BoolProperty::New(true));
+    auto hasBinary = mitk::NodePredicateProperty::New("binary");
+    auto isNamed = mitk::NodePredicateProperty::New("name", mitk::StringProperty::New("node42"));
+
+    CheckAgainstLinearScan(isImage, "Data type predicate");
+    CheckAgainstLinearScan(isHelper, "Property value predicate");
+    CheckAgainstLinearScan(hasBinary, "Property existence predicate");
+    CheckAgainstLinearScan(isNamed, "Name predicate");
+    CheckAgainstLinearScan(mitk::NodePredicateAnd::New(isImage, isHelper), "AND predicate");
+    CheckAgainstLinearScan(mitk::NodePredicateOr::New(isNamed, isHelper), "OR predicate");
+
+    CPPUNIT_ASSERT_MESSAGE("GetNamedNode() finds node", m_DataStorage->GetNamedNode("node42") != nullptr);
+    CPPUNIT_ASSERT_MESSAGE("GetNamedNode() does not find unknown node", m_DataStorage->GetNamedNode("unknown") == nullptr);
+  }
+
+  void GetSubset_NotIndexedPredicates_EqualsLinearScan()
+  {
+    auto isImage = mitk::NodePredicateDataType::New("Image");
+    auto isNotHelper = mitk::NodePredicateNot::New(
+      mitk::NodePredicateProperty::New("helper object", mitk::BoolProperty::New(true)));
+    auto isVisible = mitk::NodePredicateProperty::New("visible", mitk::BoolProperty::New(true));
+
+    CheckAgainstLinearScan(isNotHelper, "NOT predicate");
+    CheckAgainstLinearScan(isVisible, "Not indexed property key");
+    CheckAgainstLinearScan(mitk::NodePredicateAnd::New(isImage, isNotHelper), "AND with not indexed child");
+    CheckAgainstLinearScan(mitk::NodePredicateOr::New(isImage, isNotHelper), "OR with not indexed child");
+  }
+
+  void GetSubset_ModifiedNodes_IndexIsUpdated()
+  {
+    auto node = m_DataStorage->GetNamedNode("node1");
+    CPPUNIT_ASSERT(node != nullptr);
+
+    // value change of an existing property object
+    dynamic_cast<mitk::StringProperty *>(node->GetProperty("name"))->SetValue("renamed");
+    CPPUNIT_ASSERT_MESSAGE("Renamed node is found", m_DataStorage->GetNamedNode("renamed") == node);
+    CPPUNIT_ASSERT_MESSAGE("Old name is gone", m_DataStorage->GetNamedNode("node1") == nullptr);
+
+    // addition of a new property
+    node->SetBoolProperty("binary", true);
+    CheckAgainstLinearScan(mitk::NodePredicateProperty::New("binary", mitk::BoolProperty::New(true)), "Added property");
+
+    // replaced data
+    node->SetData(mitk::Image::New());
+    CheckAgainstLinearScan(mitk::NodePredicateDataType::New("Image"), "Replaced data");
+    CheckAgainstLinearScan(mitk::NodePredicateDataType::New("Surface"), "Replaced data");
+  }
+
+  void GetSubset_RemovedNodes_AreNotReturned()
+  {
+    auto node = m_DataStorage->GetNamedNode("node3");
+    CPPUNIT_ASSERT(node != nullptr);
+
+    m_DataStorage->Remove(node);
+    CPPUNIT_ASSERT_MESSAGE("Removed node is not found", m_DataStorage->GetNamedNode("node3") == nullptr);
+    CheckAgainstLinearScan(mitk::NodePredicateDataType::New("Image"), "Data type after removal");
+  }
+
+  void AddIndexedPropertyKey_ExistingNodes_AreIndexed()
+  {
+    auto node = m_DataStorage->GetNamedNode("node7");
+    node->SetStringProperty("organ", "liver");
+
+    m_DataStorage->AddIndexedPropertyKey("organ");
+    CPPUNIT_ASSERT(m_DataStorage->GetIndexedPropertyKeys().count("organ") == 1);
+
+    auto isLiver = mitk::NodePredicateProperty::New("organ", mitk::StringProperty::New("liver"));
+    auto result = m_DataStorage->GetSubset(isLiver);
+    CPPUNIT_ASSERT_MESSAGE("Node is found by new key", result->Size() == 1 && result->GetElement(0) == node);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkStandaloneDataStorageIndex)
@@ -0,0 +1,143 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <vtkMitkLevelWindowFilter.h>
+
+#include <vtkColorTransferFunction.h>
+#include <vtkImageData.h>
+#include <vtkLookupTable.h>
+#include <vtkPiecewiseFunction.h>
+#include <vtkSmartPointer.h>
+
+#include <itkTimeProbe.h>
+
+/** Reports the run time of the level window filter for the supported pixel types and lookup tables.
+ * Only built with MITK_BUILD_BENCHMARKS.*/
+class vtkMitkLevelWindowFilterBenchmarkSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(vtkMitkLevelWindowFilterBenchmarkSuite);
+  MITK_TEST(LinearLookupTable);
+  MITK_TEST(ColorTransferFunction);
+  MITK_TEST(RGBAImage);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  /** Size of the test images; big enough to log meaningful run times of the filter.*/
+  static const int ImageSize = 1024;
+
+  double m_ClippingBounds[4];
+
+  template <typename TPixel>
+  vtkSmartPointer<vtkImageData> CreateImage(int scalarType, double offset)
+  {
+    auto image = vtkSmartPointer<vtkImageData>::New();
+    image->SetExtent(0, ImageSize - 1, 0, ImageSize - 1, 0, 0);
+    image->AllocateScalars(scalarType, 1);
+
+    auto *pixels = static_cast<TPixel *>(image->GetScalarPointer());
+    for (int i = 0; i < ImageSize * ImageSize; ++i)
+    {
+      pixels[i] = static_cast<TPixel>(offset + (i % 331) * 0.75);
+    }
+    return image;
+  }
+
+  void ApplyFilter(vtkMitkLevelWindowFilter *filter, vtkImageData *image, vtkScalarsToColors *lookupTable,
+                   const std::string &name)
+  {
+    filter->SetInputData(image);
+    filter->SetLookupTable(lookupTable);
+    filter->SetClippingBounds(m_ClippingBounds);
+
+    itk::TimeProbe probe;
+    probe.Start();
+    filter->Update();
+    probe.Stop();
+    MITK_INFO << "Level window of " << ImageSize << "x" << ImageSize << " " << name << " pixels: " << probe.GetTotal()
+              << " s";
+  }
+
+  template <typename TPixel>
+  void ApplyLinearLookupTable(int scalarType, double offset, const std::string &name)
+  {
+    auto lookupTable = vtkSmartPointer<vtkLookupTable>::New();
+    lookupTable->SetNumberOfTableValues(256);
+    lookupTable->SetTableRange(0.0, 256.0);
+    for (int i = 0; i < 256; ++i)
+    {
+      lookupTable->SetTableValue(i, i / 255.0, 0.0, 1.0 - i / 255.0, 1.0);
+    }
+
+    auto filter = vtkSmartPointer<vtkMitkLevelWindowFilter>::New();
+    this->ApplyFilter(filter, this->CreateImage<TPixel>(scalarType, offset), lookupTable, name);
+  }
+
+public:
+  void setUp() override
+  {
+    m_ClippingBounds[0] = 10.5;
+    m_ClippingBounds[1] = ImageSize - 20;
+    m_ClippingBounds[2] = 3;
+    m_ClippingBounds[3] = ImageSize - 7.25;
+  }
+
+  void LinearLookupTable()
+  {
+    this->ApplyLinearLookupTable<short>(VTK_SHORT, -20.0, "short");
+    this->ApplyLinearLookupTable<unsigned short>(VTK_UNSIGNED_SHORT, 0.0, "unsigned short");
+    this->ApplyLinearLookupTable<float>(VTK_FLOAT, -20.0, "float");
+  }
+
+  void ColorTransferFunction()
+  {
+    auto transferFunction = vtkSmartPointer<vtkColorTransferFunction>::New();
+    transferFunction->AddRGBPoint(0.0, 0.0, 0.0, 1.0);
+    transferFunction->AddRGBPoint(100.0, 1.0, 0.5, 0.0);
+    transferFunction->AddRGBPoint(200.0, 1.0, 1.0, 1.0);
+
+    auto opacityFunction = vtkSmartPointer<vtkPiecewiseFunction>::New();
+    opacityFunction->AddPoint(0.0, 0.0);
+    opacityFunction->AddPoint(150.0, 1.0);
+
+    auto filter = vtkSmartPointer<vtkMitkLevelWindowFilter>::New();
+    filter->SetOpacityPiecewiseFunction(opacityFunction);
+    this->ApplyFilter(filter, this->CreateImage<short>(VTK_SHORT, -20.0), transferFunction,
+                      "short (color transfer function)");
+  }
+
+  void RGBAImage()
+  {
+    auto image = vtkSmartPointer<vtkImageData>::New();
+    image->SetExtent(0, ImageSize - 1, 0, ImageSize - 1, 0, 0);
+    image->AllocateScalars(VTK_UNSIGNED_CHAR, 4);
+
+    auto *pixels = static_cast<unsigned char *>(image->GetScalarPointer());
+    for (int i = 0; i < ImageSize * ImageSize; ++i)
+    {
+      pixels[4 * i] = 100;
+      pixels[4 * i + 1] = 50;
+      pixels[4 * i + 2] = 20;
+      pixels[4 * i + 3] = 128;
+    }
+
+    auto lookupTable = vtkSmartPointer<vtkLookupTable>::New();
+    lookupTable->SetTableRange(0.0, 127.5);
+
+    auto filter = vtkSmartPointer<vtkMitkLevelWindowFilter>::New();
+    this->ApplyFilter(filter, image, lookupTable, "RGBA");
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(vtkMitkLevelWindowFilterBenchmark)
@@ -0,0 +1,223 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <vtkMitkLevelWindowFilter.h>
+
+#include <vtkColorTransferFunction.h>
+#include <vtkImageData.h>
+#include <vtkLookupTable.h>
+#include <vtkPiecewiseFunction.h>
+#include <vtkSmartPointer.h>
+
+#include <algorithm>
+#include <cmath>
+
+class vtkMitkLevelWindowFilterTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(vtkMitkLevelWindowFilterTestSuite);
+  MITK_TEST(LinearLookupTable_ClippedShortImage_MapsToTableColors);
+  MITK_TEST(LinearLookupTable_ClippedUnsignedShortImage_MapsToTableColors);
+  MITK_TEST(LinearLookupTable_ClippedFloatImage_MapsToTableColors);
+  MITK_TEST(ColorTransferFunction_ClippedShortImage_EqualsGetColor);
+  MITK_TEST(RGBAImage_LevelWindow_ScalesIntensity);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  /** Size of the test images; big enough to be split among the threads of the filter.*/
+  static const int ImageSize = 256;
+
+  double m_ClippingBounds[4];
+
+  template <typename TPixel>
+  vtkSmartPointer<vtkImageData> CreateImage(int scalarType, double offset)
+  {
+    auto image = vtkSmartPointer<vtkImageData>::New();
+    image->SetExtent(0, ImageSize - 1, 0, ImageSize - 1, 0, 0);
+    image->AllocateScalars(scalarType, 1);
+
+    auto *pixels = static_cast<TPixel *>(image->GetScalarPointer());
+    for (int i = 0; i < ImageSize * ImageSize; ++i)
+    {
+      pixels[i] = static_cast<TPixel>(offset + (i % 331) * 0.75);
+    }
+    return image;
+  }
+
+  bool IsInsideClippingBounds(int x, int y) const
+  {
+    return x >= m_ClippingBounds[0] && x < m_ClippingBounds[1] && y >= m_ClippingBounds[2] &&
+           y < m_ClippingBounds[3];
+  }
+
+  vtkSmartPointer<vtkImageData> ApplyFilter(vtkImageData *image, vtkScalarsToColors *lookupTable)
+  {
+    auto filter = vtkSmartPointer<vtkMitkLevelWindowFilter>::New();
+    filter->SetInputData(image);
+    filter->SetLookupTable(lookupTable);
+    filter->SetClippingBounds(m_ClippingBounds);
+    filter->Update();
+
+    return filter->GetOutput();
+  }
+
+  /** The table range [0, 256] with 256 colors maps each gray value to the table index round(value).*/
+  template <typename TPixel>
+  void TestLinearLookupTable(int scalarType, double offset, const std::string &name)
+  {
+    vtkSmartPointer<vtkImageData> image = this->CreateImage<TPixel>(scalarType, offset);
+
+    auto lookupTable = vtkSmartPointer<vtkLookupTable>::New();
+    lookupTable->SetNumberOfTableValues(256);
+    lookupTable->SetTableRange(0.0, 256.0);
+    for (int i = 0; i < 256; ++i)
+    {
+      lookupTable->SetTableValue(i, i / 255.0, 0.0, 1.0 - i / 255.0, 1.0);
+    }
+
+    vtkSmartPointer<vtkImageData> output = this->ApplyFilter(image, lookupTable);
+
+    const auto *pixels = static_cast<const TPixel *>(image->GetScalarPointer());
+    const auto *colors = static_cast<const unsigned char *>(output->GetScalarPointer());
+    for (int y = 0; y < ImageSize; ++y)
+    {
+      for (int x = 0; x < ImageSize; ++x)
+      {
+        const int i = y * ImageSize + x;
+        const unsigned char *color = colors + 4 * i;
+        if (this->IsInsideClippingBounds(x, y))
+        {
+          const int index = std::min(std::max(static_cast<int>(std::floor(pixels[i] + 0.5)), 0), 255);
+          const unsigned char *expectedColor = lookupTable->GetPointer(index);
+          CPPUNIT_ASSERT_MESSAGE("Wrong color of " + name + " pixel.", std::equal(color, color + 4, expectedColor));
+        }
+        else
+        {
+          CPPUNIT_ASSERT_MESSAGE("Clipped " + name + " pixel is not transparent.",
+                                 color[0] == 0 && color[1] == 0 && color[2] == 0 && color[3] == 0);
+        }
+      }
+    }
+  }
+
+public:
+  void setUp() override
+  {
+    m_ClippingBounds[0] = 10.5;
+    m_ClippingBounds[1] = ImageSize - 20;
+    m_ClippingBounds[2] = 3;
+    m_ClippingBounds[3] = ImageSize - 7.25;
+  }
+
+  void LinearLookupTable_ClippedShortImage_MapsToTableColors()
+  {
+    this->TestLinearLookupTable<short>(VTK_SHORT, -20.0, "short");
+  }
+
+  void LinearLookupTable_ClippedUnsignedShortImage_MapsToTableColors()
+  {
+    this->TestLinearLookupTable<unsigned short>(VTK_UNSIGNED_SHORT, 0.0, "unsigned short");
+  }
+
+  void LinearLookupTable_ClippedFloatImage_MapsToTableColors()
+  {
+    this->TestLinearLookupTable<float>(VTK_FLOAT, -20.0, "float");
+  }
+
+  void ColorTransferFunction_ClippedShortImage_EqualsGetColor()
+  {
+    vtkSmartPointer<vtkImageData> image = this->CreateImage<short>(VTK_SHORT, -20.0);
+
+    auto transferFunction = vtkSmartPointer<vtkColorTransferFunction>::New();
+    transferFunction->AddRGBPoint(0.0, 0.0, 0.0, 1.0);
+    transferFunction->AddRGBPoint(100.0, 1.0, 0.5, 0.0);
+    transferFunction->AddRGBPoint(200.0, 1.0, 1.0, 1.0);
+
+    auto opacityFunction = vtkSmartPointer<vtkPiecewiseFunction>::New();
+    opacityFunction->AddPoint(0.0, 0.0);
+    opacityFunction->AddPoint(150.0, 1.0);
+
+    auto filter = vtkSmartPointer<vtkMitkLevelWindowFilter>::New();
+    filter->SetOpacityPiecewiseFunction(opacityFunction);
+    filter->SetInputData(image);
+    filter->SetLookupTable(transferFunction);
+    filter->SetClippingBounds(m_ClippingBounds);
+    filter->Update();
+
+    const auto *pixels = static_cast<const short *>(image->GetScalarPointer());
+    const auto *colors = static_cast<const unsigned char *>(filter->GetOutput()->GetScalarPointer());
+    for (int y = 0; y < ImageSize; ++y)
+    {
+      for (int x = 0; x < ImageSize; ++x)
+      {
+        const int i = y * ImageSize + x;
+        if (!this->IsInsideClippingBounds(x, y))
+        {
+          continue;
+        }
+
+        double rgba[4];
+        transferFunction->GetColor(pixels[i], rgba);
+        rgba[3] = opacityFunction->GetValue(pixels[i]);
+        for (int c = 0; c < 4; ++c)
+        {
+          CPPUNIT_ASSERT_EQUAL(static_cast<int>(255.0 * rgba[c] + 0.5), static_cast<int>(colors[4 * i + c]));
+        }
+      }
+    }
+  }
+
+  /** The table range [0, 127.5] doubles the intensity, hue and saturation are preserved.*/
+  void RGBAImage_LevelWindow_ScalesIntensity()
+  {
+    auto image = vtkSmartPointer<vtkImageData>::New();
+    image->SetExtent(0, ImageSize - 1, 0, ImageSize - 1, 0, 0);
+    image->AllocateScalars(VTK_UNSIGNED_CHAR, 4);
+
+    auto *pixels = static_cast<unsigned char *>(image->GetScalarPointer());
+    for (int i = 0; i < ImageSize * ImageSize; ++i)
+    {
+      pixels[4 * i] = 100;
+      pixels[4 * i + 1] = 50;
+      pixels[4 * i + 2] = 20;
+      pixels[4 * i + 3] = 128;
+    }
+    // a black pixel has no intensity to scale
+    pixels[4 * (20 * ImageSize + 20)] = 0;
+    pixels[4 * (20 * ImageSize + 20) + 1] = 0;
+    pixels[4 * (20 * ImageSize + 20) + 2] = 0;
+
+    auto lookupTable = vtkSmartPointer<vtkLookupTable>::New();
+    lookupTable->SetTableRange(0.0, 127.5);
+
+    vtkSmartPointer<vtkImageData> output = this->ApplyFilter(image, lookupTable);
+    const auto *colors = static_cast<const unsigned char *>(output->GetScalarPointer());
+
+    const unsigned char *color = colors + 4 * (10 * ImageSize + 30);
+    CPPUNIT_ASSERT(std::abs(color[0] - 200) <= 1);
+    CPPUNIT_ASSERT(std::abs(color[1] - 100) <= 1);
+    CPPUNIT_ASSERT(std::abs(color[2] - 40) <= 1);
+    CPPUNIT_ASSERT_EQUAL(128, static_cast<int>(color[3]));
+
+    const unsigned char *black = colors + 4 * (20 * ImageSize + 20);
+    CPPUNIT_ASSERT_EQUAL(0, static_cast<int>(black[0]));
+    CPPUNIT_ASSERT_EQUAL(0, static_cast<int>(black[1]));
+    CPPUNIT_ASSERT_EQUAL(0, static_cast<int>(black[2]));
+
+    const unsigned char *clipped = colors + 4 * (1 * ImageSize + 30);
+    CPPUNIT_ASSERT_EQUAL(0, static_cast<int>(clipped[3]));
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(vtkMitkLevelWindowFilter)
@@ -107,6 +107,12 @@ int vtkMitkThickSlicesFilterTest(int, char *[])
   thickSliceFilter->Update();
   vtkMitkThickSlicesFilterTestHelper::EvaluateResult(1, thickSliceFilter->GetOutput(), "Mean");
 
+  // Median
+  thickSliceFilter->SetThickSliceMode(5);
+  thickSliceFilter->Modified();
+  thickSliceFilter->Update();
+  vtkMitkThickSlicesFilterTestHelper::EvaluateResult(1, thickSliceFilter->GetOutput(), "Median");
+
   //////////////////////////////////////////////////////////////////////////
   // Image looks like:
   // 333333333
@@ -149,6 +155,24 @@ int vtkMitkThickSlicesFilterTest(int, char *[])
   thickSliceFilter->Update();
   vtkMitkThickSlicesFilterTestHelper::EvaluateResult(6, thickSliceFilter->GetOutput(), "Mean");
 
+  // Median (rank round(0.5 * 5) = 3)
+  thickSliceFilter->SetThickSliceMode(5);
+  thickSliceFilter->Modified();
+  thickSliceFilter->Update();
+  vtkMitkThickSlicesFilterTestHelper::EvaluateResult(6, thickSliceFilter->GetOutput(), "Median");
+
+  // Percentile (rank round(0.2 * 5) = 1)
+  thickSliceFilter->SetThickSliceMode(6);
+  thickSliceFilter->SetPercentile(20.0);
+  thickSliceFilter->Modified();
+  thickSliceFilter->Update();
+  vtkMitkThickSlicesFilterTestHelper::EvaluateResult(4, thickSliceFilter->GetOutput(), "Percentile 20");
+
+  thickSliceFilter->SetPercentile(100.0);
+  thickSliceFilter->Modified();
+  thickSliceFilter->Update();
+  vtkMitkThickSlicesFilterTestHelper::EvaluateResult(8, thickSliceFilter->GetOutput(), "Percentile 100");
+
   thickSliceFilter->Delete();
 
   MITK_TEST_END()
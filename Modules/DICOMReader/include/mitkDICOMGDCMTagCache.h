@@ -14,9 +14,12 @@ found in the LICENSE file.
 #define mitkDICOMGDCMTagCache_h
 
 #include "mitkDICOMTagCache.h"
+#include "mitkDICOMPersistentTagCache.h"
 
+#include <map>
 #include <set>
 #include <memory>
+#include <vector>
 
 #include <gdcmScanner.h>
 
@@ -43,6 +46,16 @@ namespace mitk
 
       void InitCache(const std::set<DICOMTag>& scannedTags, const std::shared_ptr<gdcm::Scanner>& scanner, const StringList& inputFiles);
 
+      /**
+      \brief Initializes the cache from the results of several scanners, e.g. of a parallel scan,
+      and from tag values taken from a DICOMPersistentTagCache.
+      Every input file is looked up in @a persistedValues first and then in the scanners.
+      @pre @a scanners must not be empty.
+      */
+      void InitCache(const std::set<DICOMTag>& scannedTags, const std::vector<std::shared_ptr<gdcm::Scanner>>& scanners,
+        const std::map<std::string, DICOMPersistentTagCache::TagValueMapType>& persistedValues, const StringList& inputFiles);
+
+      /** \brief Returns the (first) scanner the cache was initialized with. */
       const gdcm::Scanner& GetScanner() const;
 
   protected:
@@ -52,7 +65,10 @@ namespace mitk
 
       std::set<DICOMTag> m_ScannedTags;
 
-      std::shared_ptr<gdcm::Scanner> m_Scanner;
+      std::vector<std::shared_ptr<gdcm::Scanner>> m_Scanners;
+
+      /** Storage of the values that have not been scanned but taken from a persistent cache. */
+      std::set<std::string> m_PersistedValues;
 
       DICOMDatasetAccessingImageFrameList m_ScanResult;
 
@@ -17,9 +17,11 @@ found in the LICENSE file.
 #include "itkMutexLock.h"
 #include "mitkDICOMFileReader.h"
 #include "mitkDICOMDatasetSorter.h"
+#include "mitkDICOMPersistentTagCache.h"
 #include "mitkDICOMGDCMImageFrameInfo.h"
 #include "mitkEquiDistantBlocksSorter.h"
 #include "mitkNormalDirectionConsistencySorter.h"
+#include "mitkITKDICOMSeriesReaderHelper.h"
 #include "MitkDICOMReaderExports.h"
 
 
@@ -227,6 +229,28 @@ class MITKDICOMREADER_EXPORT DICOMITKSeriesGDCMReader : public DICOMFileReader
 
     bool GetFixTiltByShearing() const;
 
+    /**
+      \brief Persistent tag cache used when the reader scans its input files itself,
+      i.e. when no tag cache was given via SetTagCache(). See DICOMPersistentTagCache.
+    */
+    void SetPersistentTagCache(DICOMPersistentTagCache* cache);
+    DICOMPersistentTagCache* GetPersistentTagCache() const;
+
+    /**
+      \brief Controls whether plain 3D volumes are loaded progressively (default: off).
+
+      With streaming, LoadImages() returns as soon as the images are allocated. Their slices are
+      decoded by background threads and become available one after another, see
+      mitk::Image::BeginProgressiveLoading(). Use mitk::Image::WaitForProgressiveLoading() before
+      processing the pixels. Blocks that need tilt correction, 3D+t blocks and multi-frame files
+      are loaded as usual.
+
+      The "C" locale (see PushLocale()) stays active until the background threads are done. The
+      reader owns the threads: destroying it cancels the slices that are not decoded yet.
+    */
+    void SetStreamingLoad(bool on);
+    bool GetStreamingLoad() const;
+
     /**
       \brief Controls whether groups of only two images are accepted when ensuring consecutive slices via EquiDistantBlocksSorter.
     */
@@ -345,6 +369,8 @@ class MITKDICOMREADER_EXPORT DICOMITKSeriesGDCMReader : public DICOMFileReader
 
     bool m_SimpleVolumeReading;
 
+    bool m_StreamingLoad;
+
   private:
 
     SortingBlockList m_SortingResultInProgress;
@@ -366,10 +392,15 @@ class MITKDICOMREADER_EXPORT DICOMITKSeriesGDCMReader : public DICOMFileReader
     mutable std::stack<std::string> m_ReplacedCLocales;
     mutable std::stack<std::locale> m_ReplacedCinLocales;
 
+    /** Threads that decode the slices of streamed images (see SetStreamingLoad()). */
+    mutable std::vector<std::shared_ptr<ITKDICOMSeriesReaderHelper::StreamingDecoder>> m_StreamingDecoders;
+
     double m_DecimalPlacesForOrientation;
 
     DICOMTagCache::Pointer m_TagCache;
     bool m_ExternalCache;
+
+    DICOMPersistentTagCache::Pointer m_PersistentTagCache;
 };
 
 }
@@ -0,0 +1,124 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkDICOMPersistentTagCache_h
+#define mitkDICOMPersistentTagCache_h
+
+#include "itkObjectFactory.h"
+#include "mitkCommon.h"
+
+#include "mitkDICOMTagPath.h"
+#include "MitkDICOMReaderExports.h"
+
+#include <map>
+#include <set>
+#include <string>
+
+namespace mitk
+{
+
+  /**
+    \ingroup DICOMReaderModule
+    \brief Stores scanned tag values of DICOM files between sessions.
+
+    DICOMTagScanner implementations consult this cache before they parse a file.
+    An entry is used only if the file still has the size and modification time that
+    it had when it was scanned, and if the entry covers all tags that are requested.
+    Files that had to be parsed are added to the cache afterwards.
+
+    Entries are kept separately per scanner class, because the scanners do not
+    normalize values (e.g. padding) in the same way.
+
+    The cache can be written to and read from a file with Save() and Load().
+    A module wide default location for this file can be set via SetDefaultFileName();
+    it is used by the DICOM reader services. The default is empty, i.e. no
+    persistent caching.
+
+    @remark The class is not thread-safe. Scanners access it only from the thread
+    that calls Scan().
+  */
+  class MITKDICOMREADER_EXPORT DICOMPersistentTagCache : public itk::Object
+  {
+    public:
+      mitkClassMacroItkParent(DICOMPersistentTagCache, itk::Object);
+      itkFactorylessNewMacro(DICOMPersistentTagCache);
+
+      typedef std::map<DICOMTagPath, std::string> TagValueMapType;
+      typedef std::set<DICOMTagPath> TagPathSetType;
+
+      /**
+        \brief Replaces the content of the cache by the content of the given file.
+        \return false if the file does not exist or could not be parsed. The cache is empty then.
+      */
+      bool Load(const std::string& fileName);
+
+      /**
+        \brief Writes all entries to the given file.
+        Throws an mitk::Exception if the file cannot be written.
+      */
+      void Save(const std::string& fileName) const;
+
+      /**
+        \brief Retrieves the tag values of a file that have been stored by a scanner of the given class.
+        \return true if an up to date entry exists that covers all paths in @a tags.
+      */
+      bool Lookup(const std::string& scannerName, const std::string& fileName, const TagPathSetType& tags,
+        TagValueMapType& values) const;
+
+      /**
+        \brief Stores the tag values of a file that has been scanned for @a tags.
+        The size and modification time of the file are taken from the file system.
+      */
+      void Store(const std::string& scannerName, const std::string& fileName, const TagPathSetType& tags,
+        const TagValueMapType& values);
+
+      void Clear();
+
+      std::size_t GetNumberOfEntries() const;
+
+      /** \brief True if entries have been stored since the last Load() or Save(). */
+      bool HasUnsavedChanges() const;
+
+      static void SetDefaultFileName(const std::string& fileName);
+      static std::string GetDefaultFileName();
+
+    protected:
+
+      DICOMPersistentTagCache();
+      ~DICOMPersistentTagCache() override;
+
+    private:
+
+      struct Entry
+      {
+        Entry() : Size(0), ModificationTime(0) {}
+
+        unsigned long long Size;
+        long long ModificationTime;
+        TagPathSetType ScannedTags;
+        TagValueMapType Values;
+      };
+
+      typedef std::pair<std::string, std::string> KeyType;
+
+      static bool GetFileStatus(const std::string& fileName, unsigned long long& size, long long& modificationTime);
+
+      std::map<KeyType, Entry> m_Entries;
+      mutable bool m_UnsavedChanges;
+
+      static std::string s_DefaultFileName;
+
+      DICOMPersistentTagCache(const DICOMPersistentTagCache&);
+  };
+}
+
+#endif
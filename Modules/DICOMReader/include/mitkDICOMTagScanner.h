@@ -19,6 +19,7 @@ found in the LICENSE file.
 #include "mitkDICOMEnums.h"
 #include "mitkDICOMTagPath.h"
 #include "mitkDICOMTagCache.h"
+#include "mitkDICOMPersistentTagCache.h"
 #include "mitkDICOMDatasetAccessingImageFrameInfo.h"
 
 namespace mitk
@@ -86,8 +87,26 @@ namespace mitk
       */
       virtual DICOMTagCache::Pointer GetScanCache() const = 0;
 
+      /**
+      \brief Cache with the tag values of previously scanned files.
+      Files with an up to date entry are not parsed by Scan(); all files
+      that had to be parsed are added to the cache. Default is no cache.
+      */
+      itkSetObjectMacro(PersistentTagCache, DICOMPersistentTagCache);
+      itkGetObjectMacro(PersistentTagCache, DICOMPersistentTagCache);
+
+      /**
+      \brief Number of threads that parse files in parallel.
+      0 (default) uses one thread per processor core.
+      */
+      itkSetMacro(NumberOfThreads, unsigned int);
+      itkGetConstMacro(NumberOfThreads, unsigned int);
+
     protected:
 
+      /** \brief Number of threads to use for parsing the given number of files. */
+      unsigned int GetNumberOfScanThreads(std::size_t numberOfFiles) const;
+
       /** \brief Return active C locale */
       static std::string GetActiveLocale();
       /**
@@ -104,6 +123,9 @@ namespace mitk
       DICOMTagScanner();
       ~DICOMTagScanner() override;
 
+      DICOMPersistentTagCache::Pointer m_PersistentTagCache;
+      unsigned int m_NumberOfThreads;
+
     private:
 
       static itk::MutexLock::Pointer s_LocaleMutex;
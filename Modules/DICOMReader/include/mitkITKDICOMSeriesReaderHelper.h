@@ -19,6 +19,9 @@ found in the LICENSE file.
 
 #include <itkGDCMImageIO.h>
 
+#include <functional>
+#include <memory>
+
 /* Forward deceleration of an DCMTK class. Used in the txx but part of the interface.*/
 class OFDateTime;
 
@@ -39,6 +42,32 @@ class ITKDICOMSeriesReaderHelper
     Image::Pointer Load( const StringContainer& filenames, bool correctTilt, const GantryTiltInformation& tiltInfo );
     Image::Pointer Load3DnT( const StringContainerList& filenamesLists, bool correctTilt, const GantryTiltInformation& tiltInfo );
 
+    /**
+      \brief Threads that decode the slices of a streamed image (see LoadStreaming()).
+
+      Destroying the decoder cancels the slices that are not being decoded yet and joins the threads.
+    */
+    class StreamingDecoder;
+
+    /**
+      \brief Loads a 3D volume of single-frame files progressively (see mitk::Image::BeginProgressiveLoading()).
+
+      The image is allocated and returned before its pixels are decoded. Background threads
+      decode one file per slice into the image, starting at the center slice and continuing
+      outwards, and report each slice via mitk::Image::SetSliceLoaded(). The threads are owned
+      by the decoder returned by GetStreamingDecoder(). \a finished is called by the last thread
+      when all slices are decoded or the decoding has been canceled. Slices that have not been
+      decoded (canceled or failed) are set to zero before mitk::Image::EndProgressiveLoading() is called
+      and are not reported via mitk::Image::SetSliceLoaded(), so GetNumberOfLoadedSlices() stays below
+      the number of slices.
+
+      \return nullptr if the files cannot be streamed (e.g. multi-frame files). Load() has to be used then.
+    */
+    Image::Pointer LoadStreaming( const StringContainer& filenames, const std::function<void()>& finished = nullptr );
+
+    /** \brief Decoder of the image returned by the last successful LoadStreaming() call. */
+    std::shared_ptr<StreamingDecoder> GetStreamingDecoder() const;
+
     static bool CanHandleFile(const std::string& filename);
 
   private:
@@ -90,6 +119,15 @@ class ITKDICOMSeriesReaderHelper
                     const GantryTiltInformation& tiltInfo,
                     itk::GDCMImageIO::Pointer& io);
 
+    template <typename PixelType>
+    Image::Pointer
+    LoadDICOMByITKStreaming( const StringContainer& filenames, const std::function<void()>& finished );
+
+    /** Starts the threads that decode the slices of a streamed image. */
+    static std::shared_ptr<StreamingDecoder> DecodeSlicesInBackground( Image* image,
+                                                                       const StringContainer& filenames,
+                                                                       const std::function<void()>& finished );
+
     template <typename PixelType>
     Image::Pointer
     LoadDICOMByITK3DnT( const StringContainerList& filenames,
@@ -97,7 +135,7 @@ class ITKDICOMSeriesReaderHelper
                         const GantryTiltInformation& tiltInfo,
                         itk::GDCMImageIO::Pointer& io);
 
-
+    std::shared_ptr<StreamingDecoder> m_StreamingDecoder;
 };
 
 }
@@ -12,8 +12,12 @@ found in the LICENSE file.
 
 #include "mitkITKDICOMSeriesReaderHelper.h"
 
+#include <mitkImageWriteAccessor.h>
+
 #include <itkImageSeriesReader.h>
 #include <itkResampleImageFilter.h>
+
+#include <cstring>
 //#include <itkAffineTransform.h>
 //#include <itkLinearInterpolateImageFunction.h>
 //#include <itkTimeProbesCollectorBase.h>
@@ -72,6 +76,49 @@ mitk::ITKDICOMSeriesReaderHelper
   return image;
 }
 
+template <typename PixelType>
+mitk::Image::Pointer
+mitk::ITKDICOMSeriesReaderHelper
+::LoadDICOMByITKStreaming( const StringContainer& filenames, const std::function<void()>& finished )
+{
+  typedef itk::Image<PixelType, 3> ImageType;
+  typedef itk::ImageSeriesReader<ImageType> ReaderType;
+
+  // only the headers are read here to get exactly the geometry that the regular reading would produce
+  itk::GDCMImageIO::Pointer io = itk::GDCMImageIO::New();
+  typename ReaderType::Pointer reader = ReaderType::New();
+
+  reader->SetImageIO(io);
+  reader->ReverseOrderOff(); // see LoadDICOMByITK()
+  reader->SetFileNames(filenames);
+  reader->UpdateOutputInformation();
+
+  // streaming decodes one file per slice
+  if (io->GetNumberOfDimensions() > 2 && io->GetDimensions(2) > 1)
+  {
+    return nullptr;
+  }
+
+  typename ImageType::Pointer header = reader->GetOutput();
+  if (header->GetLargestPossibleRegion().GetSize()[2] != filenames.size())
+  {
+    return nullptr;
+  }
+
+  mitk::Image::Pointer image = mitk::Image::New();
+  image->InitializeByItk(header.GetPointer());
+
+  // slices that fail to load stay empty
+  {
+    mitk::ImageWriteAccessor accessor(image);
+    std::memset(accessor.GetData(), 0, image->GetVolumeData(0)->GetSize());
+  }
+
+  m_StreamingDecoder = DecodeSlicesInBackground(image, filenames, finished);
+
+  return image;
+}
+
 #define MITK_DEBUG_OUTPUT_FILELIST(list)\
   MITK_DEBUG << "-------------------------------------------"; \
   for (StringContainer::const_iterator _iter = (list).cbegin(); _iter!=(list).cend(); ++_iter) \
@@ -21,6 +21,7 @@ found in the LICENSE file.
 #include <mitkDICOMProperty.h>
 #include "legacy/mitkDicomSeriesReader.h"
 #include <mitkDICOMDCMTKTagScanner.h>
+#include <mitkDICOMPersistentTagCache.h>
 #include <mitkLocaleSwitch.h>
 #include "mitkIPropertyProvider.h"
 #include "mitkPropertyNameHelper.h"
@@ -128,8 +129,31 @@ std::vector<itk::SmartPointer<BaseData> > BaseDICOMReaderService::Read()
           mitk::DICOMDCMTKTagScanner::Pointer scanner = mitk::DICOMDCMTKTagScanner::New();
           scanner->AddTagPaths(reader->GetTagsOfInterest());
           scanner->SetInputFiles(relevantFiles);
+
+          // re-opening known files does not require to parse them again
+          const std::string tagCacheFileName = mitk::DICOMPersistentTagCache::GetDefaultFileName();
+          mitk::DICOMPersistentTagCache::Pointer persistentTagCache;
+          if (!tagCacheFileName.empty())
+          {
+            persistentTagCache = mitk::DICOMPersistentTagCache::New();
+            persistentTagCache->Load(tagCacheFileName);
+            scanner->SetPersistentTagCache(persistentTagCache);
+          }
+
           scanner->Scan();
 
+          if (persistentTagCache.IsNotNull() && persistentTagCache->HasUnsavedChanges())
+          {
+            try
+            {
+              persistentTagCache->Save(tagCacheFileName);
+            }
+            catch (const mitk::Exception& e)
+            {
+              MITK_WARN << "Cannot update DICOM tag cache: " << e.GetDescription();
+            }
+          }
+
           reader->SetTagCache(scanner->GetScanCache());
           reader->AnalyzeInputFiles();
           reader->LoadImages();
@@ -16,6 +16,11 @@ found in the LICENSE file.
 #include <dcmtk/dcmdata/dcfilefo.h>
 #include <dcmtk/dcmdata/dcpath.h>
 
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+
 mitk::DICOMDCMTKTagScanner::DICOMDCMTKTagScanner()
 {
 }
@@ -98,61 +103,157 @@ mitk::DICOMTagPath DcmPathToTagPath(DcmPath * dcmpath)
   return result;
 }
 
+namespace
+{
+  /** Reads all requested tag paths from a file. Returns nullptr if the file cannot be read. */
+  mitk::DICOMGenericImageFrameInfo::Pointer ScanFile(const std::string& fileName,
+    const std::set<mitk::DICOMTagPath>& scannedTags, DcmPathProcessor& processor)
+  {
+    DcmFileFormat dfile;
+    OFCondition cond = dfile.loadFile(fileName.c_str());
+    if (cond.bad())
+    {
+      return nullptr;
+    }
+
+    mitk::DICOMGenericImageFrameInfo::Pointer info = mitk::DICOMGenericImageFrameInfo::New(fileName);
+
+    for (const auto& path : scannedTags)
+    {
+      std::string tagPath = DICOMTagPathToDCMTKSearchPath(path);
+      cond = processor.findOrCreatePath(dfile.getDataset(), tagPath.c_str());
+      if (cond.good())
+      {
+        OFList< DcmPath * > findings;
+        processor.getResults(findings);
+        for (const auto& finding : findings)
+        {
+          auto element = dynamic_cast<DcmElement*>(finding->back()->m_obj);
+          if (!element)
+          {
+            auto item = dynamic_cast<DcmItem*>(finding->back()->m_obj);
+            if (item)
+            {
+              element = item->getElement(finding->back()->m_itemNo);
+            }
+          }
+
+          if (element)
+          {
+            OFString value;
+            cond = element->getOFStringArray(value);
+            if (cond.good())
+            {
+              info->SetTagValue(DcmPathToTagPath(finding), std::string(value.c_str()));
+            }
+          }
+        }
+      }
+    }
+
+    return info;
+  }
+}
+
 void mitk::DICOMDCMTKTagScanner::Scan()
 {
   this->PushLocale();
 
   try
   {
-    DcmPathProcessor processor;
-    processor.setItemWildcardSupport(true);
-
-    DICOMGenericTagCache::Pointer newCache = DICOMGenericTagCache::New();
+    const std::size_t numberOfFiles = m_InputFilenames.size();
+    std::vector<DICOMGenericImageFrameInfo::Pointer> infos(numberOfFiles);
 
-    for (const auto& fileName : this->m_InputFilenames)
+    // files with up to date entries in the persistent cache are not parsed at all
+    std::vector<std::size_t> filesToScan;
+    filesToScan.reserve(numberOfFiles);
+    for (std::size_t i = 0; i < numberOfFiles; ++i)
     {
-      DcmFileFormat dfile;
-      OFCondition cond = dfile.loadFile(fileName.c_str());
-      if (cond.bad())
+      DICOMPersistentTagCache::TagValueMapType values;
+      if (m_PersistentTagCache.IsNotNull() &&
+          m_PersistentTagCache->Lookup(this->GetNameOfClass(), m_InputFilenames[i], m_ScannedTags, values))
       {
-        MITK_ERROR << "Error when scanning for tags. Cannot open given file. File: " << fileName;
+        infos[i] = DICOMGenericImageFrameInfo::New(m_InputFilenames[i]);
+        for (const auto& value : values)
+        {
+          infos[i]->SetTagValue(value.first, value.second);
+        }
       }
       else
       {
-        DICOMGenericImageFrameInfo::Pointer info = DICOMGenericImageFrameInfo::New(fileName);
+        filesToScan.push_back(i);
+      }
+    }
+
+    // parse the remaining files in parallel, each thread takes the next file that is not yet scanned
+    std::atomic<std::size_t> nextFile(0);
+    std::exception_ptr scanError;
+    std::mutex errorMutex;
+
+    auto worker = [&]()
+    {
+      try
+      {
+        DcmPathProcessor processor;
+        processor.setItemWildcardSupport(true);
 
-        for (const auto& path : this->m_ScannedTags)
+        for (std::size_t next = nextFile++; next < filesToScan.size(); next = nextFile++)
         {
-          std::string tagPath = DICOMTagPathToDCMTKSearchPath(path);
-          cond = processor.findOrCreatePath(dfile.getDataset(), tagPath.c_str());
-          if (cond.good())
+          const std::size_t fileIndex = filesToScan[next];
+          infos[fileIndex] = ScanFile(m_InputFilenames[fileIndex], m_ScannedTags, processor);
+        }
+      }
+      catch (...)
+      {
+        std::lock_guard<std::mutex> lock(errorMutex);
+        scanError = std::current_exception();
+        nextFile = filesToScan.size();
+      }
+    };
+
+    const unsigned int numberOfThreads = this->GetNumberOfScanThreads(filesToScan.size());
+    std::vector<std::thread> threads;
+    for (unsigned int i = 1; i < numberOfThreads; ++i)
+    {
+      threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : threads)
+    {
+      thread.join();
+    }
+
+    if (scanError)
+    {
+      std::rethrow_exception(scanError);
+    }
+
+    for (const auto fileIndex : filesToScan)
+    {
+      if (infos[fileIndex].IsNull())
+      {
+        // unreadable files are not cached, so that they are reported again
+        MITK_ERROR << "Error when scanning for tags. Cannot open given file. File: " << m_InputFilenames[fileIndex];
+      }
+      else if (m_PersistentTagCache.IsNotNull())
+      {
+        DICOMPersistentTagCache::TagValueMapType values;
+        for (const auto& path : m_ScannedTags)
+        {
+          for (const auto& finding : infos[fileIndex]->GetTagValueAsString(path))
           {
-            OFList< DcmPath * > findings;
-            processor.getResults(findings);
-            for (const auto& finding : findings)
-            {
-              auto element = dynamic_cast<DcmElement*>(finding->back()->m_obj);
-              if (!element)
-              {
-                auto item = dynamic_cast<DcmItem*>(finding->back()->m_obj);
-                if (item)
-                {
-                  element = item->getElement(finding->back()->m_itemNo);
-                }
-              }
-
-              if (element)
-              {
-                OFString value;
-                cond = element->getOFStringArray(value);
-                if (cond.good())
-                {
-                  info->SetTagValue(DcmPathToTagPath(finding), std::string(value.c_str()));
-                }
-              }
-            }
+            values[finding.path] = finding.value;
           }
         }
+        m_PersistentTagCache->Store(this->GetNameOfClass(), m_InputFilenames[fileIndex], m_ScannedTags, values);
+      }
+    }
+
+    DICOMGenericTagCache::Pointer newCache = DICOMGenericTagCache::New();
+    for (const auto& info : infos)
+    {
+      if (info.IsNotNull())
+      {
         newCache->AddFrameInfo(info);
       }
     }
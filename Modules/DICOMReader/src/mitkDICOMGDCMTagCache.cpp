@@ -83,22 +83,59 @@ mitk::DICOMDatasetAccessingImageFrameList mitk::DICOMGDCMTagCache::GetFrameInfoL
 void
 mitk::DICOMGDCMTagCache::InitCache(const std::set<DICOMTag>& scannedTags, const std::shared_ptr<gdcm::Scanner>& scanner, const StringList& inputFiles)
 {
+  this->InitCache(scannedTags, std::vector<std::shared_ptr<gdcm::Scanner>>(1, scanner),
+    std::map<std::string, DICOMPersistentTagCache::TagValueMapType>(), inputFiles);
+}
+
+void
+mitk::DICOMGDCMTagCache::InitCache(const std::set<DICOMTag>& scannedTags, const std::vector<std::shared_ptr<gdcm::Scanner>>& scanners,
+  const std::map<std::string, DICOMPersistentTagCache::TagValueMapType>& persistedValues, const StringList& inputFiles)
+{
+  if (scanners.empty())
+  {
+    mitkThrow() << "Invalid call to DICOMGDCMTagCache::InitCache(). At least one scanner is required.";
+  }
+
   m_ScannedTags = scannedTags;
   m_InputFilenames = inputFiles;
-  m_Scanner = scanner;
+  m_Scanners = scanners;
+  m_PersistedValues.clear();
 
   m_ScanResult.clear();
   m_ScanResult.reserve(m_InputFilenames.size());
 
   for (auto inputIter = m_InputFilenames.cbegin(); inputIter != m_InputFilenames.cend(); ++inputIter)
   {
-    m_ScanResult.push_back(DICOMGDCMImageFrameInfo::New(DICOMImageFrameInfo::New(*inputIter, 0),
-      m_Scanner->GetMapping(inputIter->c_str())).GetPointer());
+    gdcm::Scanner::TagToValue mapping;
+
+    const auto persisted = persistedValues.find(*inputIter);
+    if (persisted != persistedValues.cend())
+    {
+      // the frame infos refer to the values, so they are stored with the cache like gdcm::Scanner does
+      for (const auto& value : persisted->second)
+      {
+        const DICOMTag& tag = value.first.GetFirstNode().tag;
+        mapping[gdcm::Tag(tag.GetGroup(), tag.GetElement())] = m_PersistedValues.insert(value.second).first->c_str();
+      }
+    }
+    else
+    {
+      for (const auto& scanner : m_Scanners)
+      {
+        if (scanner->IsKey(inputIter->c_str()))
+        {
+          mapping = scanner->GetMapping(inputIter->c_str());
+          break;
+        }
+      }
+    }
+
+    m_ScanResult.push_back(DICOMGDCMImageFrameInfo::New(DICOMImageFrameInfo::New(*inputIter, 0), mapping).GetPointer());
   }
 }
 
 const gdcm::Scanner&
 mitk::DICOMGDCMTagCache::GetScanner() const
 {
-  return *(this->m_Scanner);
+  return *(this->m_Scanners.front());
 }
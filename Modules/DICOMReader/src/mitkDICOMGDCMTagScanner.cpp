@@ -16,6 +16,8 @@ found in the LICENSE file.
 
 #include <gdcmScanner.h>
 
+#include <thread>
+
 mitk::DICOMGDCMTagScanner::DICOMGDCMTagScanner()
 {
   m_GDCMScanner = std::make_shared<gdcm::Scanner>();
@@ -93,10 +95,85 @@ void mitk::DICOMGDCMTagScanner::SetInputFiles( const StringList& filenames )
 void mitk::DICOMGDCMTagScanner::Scan()
 {
   // TODO integrate push/pop locale??
-  m_GDCMScanner->Scan( m_InputFilenames );
+  DICOMPersistentTagCache::TagPathSetType scannedPaths;
+  for (const auto& tag : m_ScannedTags)
+  {
+    scannedPaths.insert(DICOMTagPath(tag));
+  }
+
+  // files with up to date entries in the persistent cache are not parsed at all
+  std::map<std::string, DICOMPersistentTagCache::TagValueMapType> persistedValues;
+  StringList filesToScan;
+  for (const auto& fileName : m_InputFilenames)
+  {
+    DICOMPersistentTagCache::TagValueMapType values;
+    if (m_PersistentTagCache.IsNotNull() &&
+        m_PersistentTagCache->Lookup(this->GetNameOfClass(), fileName, scannedPaths, values))
+    {
+      persistedValues[fileName].swap(values);
+    }
+    else
+    {
+      filesToScan.push_back(fileName);
+    }
+  }
+
+  // the remaining files are split into contiguous parts, each scanned by its own gdcm::Scanner
+  const unsigned int numberOfThreads = this->GetNumberOfScanThreads(filesToScan.size());
+  std::vector<std::shared_ptr<gdcm::Scanner>> scanners(1, m_GDCMScanner);
+  std::vector<StringList> parts(numberOfThreads);
+  for (unsigned int i = 0; i < numberOfThreads; ++i)
+  {
+    if (i > 0)
+    {
+      scanners.push_back(std::make_shared<gdcm::Scanner>());
+      for (const auto& tag : m_ScannedTags)
+      {
+        scanners.back()->AddTag(gdcm::Tag(tag.GetGroup(), tag.GetElement()));
+      }
+    }
+
+    const std::size_t begin = filesToScan.size() * i / numberOfThreads;
+    const std::size_t end = filesToScan.size() * (i + 1) / numberOfThreads;
+    parts[i].assign(filesToScan.begin() + begin, filesToScan.begin() + end);
+  }
+
+  std::vector<std::thread> threads;
+  for (unsigned int i = 1; i < numberOfThreads; ++i)
+  {
+    threads.emplace_back([&scanners, &parts, i]() { scanners[i]->Scan(parts[i]); });
+  }
+  m_GDCMScanner->Scan(parts[0]);
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+
+  if (m_PersistentTagCache.IsNotNull())
+  {
+    for (unsigned int i = 0; i < numberOfThreads; ++i)
+    {
+      for (const auto& fileName : parts[i])
+      {
+        // unreadable files are not cached, so that they are parsed again
+        if (!scanners[i]->IsKey(fileName.c_str()))
+        {
+          continue;
+        }
+
+        DICOMPersistentTagCache::TagValueMapType values;
+        for (const auto& tagValue : scanners[i]->GetMapping(fileName.c_str()))
+        {
+          values[DICOMTagPath(tagValue.first.GetGroup(), tagValue.first.GetElement())] =
+            tagValue.second != nullptr ? tagValue.second : "";
+        }
+        m_PersistentTagCache->Store(this->GetNameOfClass(), fileName, scannedPaths, values);
+      }
+    }
+  }
 
   DICOMGDCMTagCache::Pointer newCache = DICOMGDCMTagCache::New();
-  newCache->InitCache(m_ScannedTags, m_GDCMScanner, m_InputFilenames);
+  newCache->InitCache(m_ScannedTags, scanners, persistedValues, m_InputFilenames);
 
   m_Cache = newCache;
 }
@@ -28,6 +28,7 @@ mitk::DICOMITKSeriesGDCMReader::DICOMITKSeriesGDCMReader( unsigned int decimalPl
 : DICOMFileReader()
 , m_FixTiltByShearing(m_DefaultFixTiltByShearing)
 , m_SimpleVolumeReading( simpleVolumeImport )
+, m_StreamingLoad( false )
 , m_DecimalPlacesForOrientation( decimalPlacesForOrientation )
 , m_ExternalCache(false)
 {
@@ -38,6 +39,7 @@ mitk::DICOMITKSeriesGDCMReader::DICOMITKSeriesGDCMReader( unsigned int decimalPl
 mitk::DICOMITKSeriesGDCMReader::DICOMITKSeriesGDCMReader( const DICOMITKSeriesGDCMReader& other )
 : DICOMFileReader( other )
 , m_FixTiltByShearing( other.m_FixTiltByShearing)
+, m_StreamingLoad( other.m_StreamingLoad )
 , m_SortingResultInProgress( other.m_SortingResultInProgress )
 , m_Sorter( other.m_Sorter )
 , m_EquiDistantBlocksSorter( other.m_EquiDistantBlocksSorter->Clone() )
@@ -47,11 +49,14 @@ mitk::DICOMITKSeriesGDCMReader::DICOMITKSeriesGDCMReader( const DICOMITKSeriesGD
 , m_DecimalPlacesForOrientation( other.m_DecimalPlacesForOrientation )
 , m_TagCache( other.m_TagCache )
 , m_ExternalCache(other.m_ExternalCache)
+, m_PersistentTagCache( other.m_PersistentTagCache )
 {
 }
 
 mitk::DICOMITKSeriesGDCMReader::~DICOMITKSeriesGDCMReader()
 {
+  // the decoding threads restore the locale via PopLocale() when they are done
+  m_StreamingDecoders.clear();
 }
 
 mitk::DICOMITKSeriesGDCMReader& mitk::DICOMITKSeriesGDCMReader::
@@ -61,6 +66,7 @@ mitk::DICOMITKSeriesGDCMReader& mitk::DICOMITKSeriesGDCMReader::
   {
     DICOMFileReader::operator                =( other );
     this->m_FixTiltByShearing                = other.m_FixTiltByShearing;
+    this->m_StreamingLoad                    = other.m_StreamingLoad;
     this->m_SortingResultInProgress          = other.m_SortingResultInProgress;
     this->m_Sorter                           = other.m_Sorter; // TODO should clone the list items
     this->m_EquiDistantBlocksSorter          = other.m_EquiDistantBlocksSorter->Clone();
@@ -69,6 +75,7 @@ mitk::DICOMITKSeriesGDCMReader& mitk::DICOMITKSeriesGDCMReader::
     this->m_ReplacedCinLocales               = other.m_ReplacedCinLocales;
     this->m_DecimalPlacesForOrientation      = other.m_DecimalPlacesForOrientation;
     this->m_TagCache                         = other.m_TagCache;
+    this->m_PersistentTagCache               = other.m_PersistentTagCache;
   }
   return *this;
 }
@@ -119,6 +126,27 @@ bool mitk::DICOMITKSeriesGDCMReader::GetFixTiltByShearing() const
   return m_FixTiltByShearing;
 }
 
+void mitk::DICOMITKSeriesGDCMReader::SetPersistentTagCache( DICOMPersistentTagCache* cache )
+{
+  m_PersistentTagCache = cache;
+}
+
+mitk::DICOMPersistentTagCache* mitk::DICOMITKSeriesGDCMReader::GetPersistentTagCache() const
+{
+  return m_PersistentTagCache;
+}
+
+void mitk::DICOMITKSeriesGDCMReader::SetStreamingLoad( bool on )
+{
+  this->Modified();
+  m_StreamingLoad = on;
+}
+
+bool mitk::DICOMITKSeriesGDCMReader::GetStreamingLoad() const
+{
+  return m_StreamingLoad;
+}
+
 void mitk::DICOMITKSeriesGDCMReader::SetAcceptTwoSlicesGroups( bool accept ) const
 {
   this->Modified();
@@ -237,6 +265,7 @@ void mitk::DICOMITKSeriesGDCMReader::AnalyzeInputFiles()
 
     filescanner->SetInputFiles( inputFilenames );
     filescanner->AddTagPaths( this->GetTagsOfInterest() );
+    filescanner->SetPersistentTagCache( m_PersistentTagCache );
 
     PushLocale();
     filescanner->Scan();
@@ -450,7 +479,34 @@ bool mitk::DICOMITKSeriesGDCMReader::LoadMitkImageForImageBlockDescriptor(
   bool success( true );
   try
   {
-    mitk::Image::Pointer mitkImage = helper.Load( filenames, m_FixTiltByShearing && hasTilt, tiltInfo );
+    mitk::Image::Pointer mitkImage;
+    if ( m_StreamingLoad && !( m_FixTiltByShearing && hasTilt ) )
+    {
+      // the background threads parse the files as well, so they keep the "C" locale until they are done
+      PushLocale();
+      try
+      {
+        mitkImage = helper.LoadStreaming( filenames, [this]() { this->PopLocale(); } );
+      }
+      catch ( ... )
+      {
+        PopLocale();
+        throw;
+      }
+
+      if ( mitkImage.IsNotNull() )
+      {
+        m_StreamingDecoders.push_back( helper.GetStreamingDecoder() );
+      }
+      else
+      {
+        PopLocale();
+      }
+    }
+    if ( mitkImage.IsNull() )
+    {
+      mitkImage = helper.Load( filenames, m_FixTiltByShearing && hasTilt, tiltInfo );
+    }
     block.SetMitkImage( mitkImage );
   }
   catch ( const std::exception& e )
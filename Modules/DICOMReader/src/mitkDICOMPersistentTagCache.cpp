@@ -0,0 +1,287 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkDICOMPersistentTagCache.h"
+
+#include <mitkExceptionMacro.h>
+#include <mitkLogMacros.h>
+
+#include <itksys/SystemTools.hxx>
+
+#include <algorithm>
+#include <fstream>
+#include <vector>
+
+namespace
+{
+  const char* const FILE_SIGNATURE = "MITK DICOM tag cache 1";
+
+  // strings are written with a length prefix, so that values may contain any character
+  void WriteString(std::ostream& stream, const std::string& value)
+  {
+    stream << value.size() << ':' << value;
+  }
+
+  bool ReadString(std::istream& stream, std::string& value)
+  {
+    std::size_t length = 0;
+    char separator = 0;
+    if (!(stream >> length) || !stream.get(separator) || separator != ':')
+      return false;
+
+    value.resize(length);
+    return length == 0 || stream.read(&value[0], length);
+  }
+}
+
+std::string mitk::DICOMPersistentTagCache::s_DefaultFileName;
+
+mitk::DICOMPersistentTagCache::DICOMPersistentTagCache()
+: m_UnsavedChanges(false)
+{
+}
+
+mitk::DICOMPersistentTagCache::~DICOMPersistentTagCache()
+{
+}
+
+void mitk::DICOMPersistentTagCache::SetDefaultFileName(const std::string& fileName)
+{
+  s_DefaultFileName = fileName;
+}
+
+std::string mitk::DICOMPersistentTagCache::GetDefaultFileName()
+{
+  return s_DefaultFileName;
+}
+
+bool mitk::DICOMPersistentTagCache::GetFileStatus(const std::string& fileName, unsigned long long& size, long long& modificationTime)
+{
+  if (!itksys::SystemTools::FileExists(fileName.c_str(), true))
+  {
+    return false;
+  }
+
+  size = itksys::SystemTools::FileLength(fileName.c_str());
+  modificationTime = itksys::SystemTools::ModifiedTime(fileName.c_str());
+  return true;
+}
+
+bool mitk::DICOMPersistentTagCache::Lookup(const std::string& scannerName, const std::string& fileName,
+  const TagPathSetType& tags, TagValueMapType& values) const
+{
+  const auto finding = m_Entries.find(KeyType(scannerName, fileName));
+  if (finding == m_Entries.cend())
+  {
+    return false;
+  }
+
+  const Entry& entry = finding->second;
+  unsigned long long size = 0;
+  long long modificationTime = 0;
+  if (!GetFileStatus(fileName, size, modificationTime) || size != entry.Size || modificationTime != entry.ModificationTime)
+  {
+    return false;
+  }
+
+  if (!std::includes(entry.ScannedTags.cbegin(), entry.ScannedTags.cend(), tags.cbegin(), tags.cend()))
+  {
+    return false;
+  }
+
+  values = entry.Values;
+  return true;
+}
+
+void mitk::DICOMPersistentTagCache::Store(const std::string& scannerName, const std::string& fileName,
+  const TagPathSetType& tags, const TagValueMapType& values)
+{
+  Entry newEntry;
+  if (!GetFileStatus(fileName, newEntry.Size, newEntry.ModificationTime))
+  {
+    return;
+  }
+
+  Entry& entry = m_Entries[KeyType(scannerName, fileName)];
+  if (entry.Size != newEntry.Size || entry.ModificationTime != newEntry.ModificationTime)
+  {
+    entry = newEntry;
+  }
+
+  // the values of an unchanged file are extended by the newly scanned tags
+  entry.ScannedTags.insert(tags.cbegin(), tags.cend());
+  for (const auto& value : values)
+  {
+    entry.Values[value.first] = value.second;
+  }
+
+  m_UnsavedChanges = true;
+  this->Modified();
+}
+
+void mitk::DICOMPersistentTagCache::Clear()
+{
+  m_Entries.clear();
+  m_UnsavedChanges = true;
+  this->Modified();
+}
+
+std::size_t mitk::DICOMPersistentTagCache::GetNumberOfEntries() const
+{
+  return m_Entries.size();
+}
+
+bool mitk::DICOMPersistentTagCache::HasUnsavedChanges() const
+{
+  return m_UnsavedChanges;
+}
+
+void mitk::DICOMPersistentTagCache::Save(const std::string& fileName) const
+{
+  std::ofstream stream(fileName.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!stream.is_open())
+  {
+    mitkThrow() << "Cannot write DICOM tag cache file " << fileName;
+  }
+
+  // tag paths are written only once, the entries refer to their index
+  std::map<DICOMTagPath, std::size_t> pathIndices;
+  for (const auto& entry : m_Entries)
+  {
+    for (const auto& path : entry.second.ScannedTags)
+      pathIndices.insert(std::make_pair(path, pathIndices.size()));
+    for (const auto& value : entry.second.Values)
+      pathIndices.insert(std::make_pair(value.first, pathIndices.size()));
+  }
+
+  std::vector<const DICOMTagPath*> paths(pathIndices.size());
+  for (const auto& pathIndex : pathIndices)
+  {
+    paths[pathIndex.second] = &pathIndex.first;
+  }
+
+  stream << FILE_SIGNATURE << '\n' << paths.size() << '\n';
+  for (const auto path : paths)
+  {
+    WriteString(stream, path->ToStr());
+    stream << '\n';
+  }
+
+  stream << m_Entries.size() << '\n';
+  for (const auto& entry : m_Entries)
+  {
+    WriteString(stream, entry.first.first);
+    stream << ' ';
+    WriteString(stream, entry.first.second);
+    stream << ' ' << entry.second.Size << ' ' << entry.second.ModificationTime << ' '
+           << entry.second.ScannedTags.size() << ' ' << entry.second.Values.size() << '\n';
+
+    for (const auto& path : entry.second.ScannedTags)
+    {
+      stream << pathIndices[path] << ' ';
+    }
+    stream << '\n';
+
+    for (const auto& value : entry.second.Values)
+    {
+      stream << pathIndices[value.first] << ' ';
+      WriteString(stream, value.second);
+      stream << '\n';
+    }
+  }
+
+  if (!stream.good())
+  {
+    mitkThrow() << "Error while writing DICOM tag cache file " << fileName;
+  }
+
+  m_UnsavedChanges = false;
+}
+
+bool mitk::DICOMPersistentTagCache::Load(const std::string& fileName)
+{
+  m_Entries.clear();
+  m_UnsavedChanges = false;
+  this->Modified();
+
+  std::ifstream stream(fileName.c_str(), std::ios::in | std::ios::binary);
+  if (!stream.is_open())
+  {
+    return false;
+  }
+
+  std::string signature;
+  std::getline(stream, signature);
+  if (signature != FILE_SIGNATURE)
+  {
+    MITK_WARN << "Ignoring DICOM tag cache file with unknown format: " << fileName;
+    return false;
+  }
+
+  try
+  {
+    std::size_t numberOfPaths = 0;
+    if (!(stream >> numberOfPaths))
+      mitkThrow() << "missing path table";
+
+    std::vector<DICOMTagPath> paths(numberOfPaths);
+    std::string pathString;
+    for (auto& path : paths)
+    {
+      if (!ReadString(stream, pathString))
+        mitkThrow() << "invalid tag path";
+      path.FromStr(pathString);
+    }
+
+    std::size_t numberOfEntries = 0;
+    if (!(stream >> numberOfEntries))
+      mitkThrow() << "missing entries";
+
+    for (std::size_t i = 0; i < numberOfEntries; ++i)
+    {
+      KeyType key;
+      Entry entry;
+      std::size_t numberOfScannedTags = 0;
+      std::size_t numberOfValues = 0;
+
+      if (!ReadString(stream, key.first) || !ReadString(stream, key.second) ||
+          !(stream >> entry.Size >> entry.ModificationTime >> numberOfScannedTags >> numberOfValues))
+        mitkThrow() << "invalid entry";
+
+      std::size_t pathIndex = 0;
+      for (std::size_t j = 0; j < numberOfScannedTags; ++j)
+      {
+        if (!(stream >> pathIndex) || pathIndex >= paths.size())
+          mitkThrow() << "invalid tag path index";
+        entry.ScannedTags.insert(entry.ScannedTags.cend(), paths[pathIndex]);
+      }
+
+      std::string value;
+      for (std::size_t j = 0; j < numberOfValues; ++j)
+      {
+        if (!(stream >> pathIndex) || pathIndex >= paths.size() || stream.get() != ' ' || !ReadString(stream, value))
+          mitkThrow() << "invalid tag value";
+        entry.Values.insert(entry.Values.cend(), std::make_pair(paths[pathIndex], value));
+      }
+
+      m_Entries.insert(m_Entries.cend(), std::make_pair(key, entry));
+    }
+  }
+  catch (const std::exception& e)
+  {
+    MITK_WARN << "Ignoring corrupt DICOM tag cache file " << fileName << ": " << e.what();
+    m_Entries.clear();
+    return false;
+  }
+
+  return true;
+}
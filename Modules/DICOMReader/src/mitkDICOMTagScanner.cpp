@@ -12,9 +12,13 @@ found in the LICENSE file.
 
 #include "mitkDICOMTagScanner.h"
 
+#include <algorithm>
+#include <thread>
+
 itk::MutexLock::Pointer mitk::DICOMTagScanner::s_LocaleMutex = itk::MutexLock::New();
 
 mitk::DICOMTagScanner::DICOMTagScanner()
+: m_NumberOfThreads(0)
 {
 }
 
@@ -66,6 +70,20 @@ void mitk::DICOMTagScanner::PopLocale() const
   s_LocaleMutex->Unlock();
 }
 
+unsigned int mitk::DICOMTagScanner::GetNumberOfScanThreads(std::size_t numberOfFiles) const
+{
+  unsigned int numberOfThreads = m_NumberOfThreads;
+  if (numberOfThreads == 0)
+  {
+    numberOfThreads = std::max(1u, std::thread::hardware_concurrency());
+  }
+
+  // a thread per few files does not pay off
+  const std::size_t minimumFilesPerThread = 4;
+  return static_cast<unsigned int>(
+    std::max<std::size_t>(1, std::min<std::size_t>(numberOfThreads, numberOfFiles / minimumFilesPerThread)));
+}
+
 std::string mitk::DICOMTagScanner::GetActiveLocale()
 {
   return setlocale(LC_NUMERIC, nullptr);
@@ -32,6 +32,13 @@ found in the LICENSE file.
 
 #include "dcmtk/dcmdata/dcvrda.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <system_error>
+#include <thread>
+
 
 const mitk::DICOMTag mitk::ITKDICOMSeriesReaderHelper::AcquisitionDateTag = mitk::DICOMTag( 0x0008, 0x0022 );
 const mitk::DICOMTag mitk::ITKDICOMSeriesReaderHelper::AcquisitionTimeTag = mitk::DICOMTag( 0x0008, 0x0032 );
@@ -122,6 +129,250 @@ mitk::Image::Pointer mitk::ITKDICOMSeriesReaderHelper::Load( const StringContain
   return nullptr;
 }
 
+#define switchStreamingCase( IOType, T ) \
+  case IOType:                           \
+    return LoadDICOMByITKStreaming<T>( filenames, finished );
+
+mitk::Image::Pointer mitk::ITKDICOMSeriesReaderHelper::LoadStreaming( const StringContainer& filenames,
+                                                                      const std::function<void()>& finished )
+{
+  if ( filenames.empty() )
+  {
+    return nullptr;
+  }
+
+  typedef itk::GDCMImageIO DcmIoType;
+  DcmIoType::Pointer io = DcmIoType::New();
+
+  if ( !io->CanReadFile( filenames.front().c_str() ) )
+  {
+    return nullptr;
+  }
+
+  io->SetFileName( filenames.front().c_str() );
+  io->ReadImageInformation();
+
+  if ( io->GetPixelType() == itk::ImageIOBase::SCALAR )
+  {
+    switch ( io->GetComponentType() )
+    {
+      switchStreamingCase( DcmIoType::UCHAR, unsigned char )
+      switchStreamingCase( DcmIoType::CHAR, char )
+      switchStreamingCase( DcmIoType::USHORT, unsigned short )
+      switchStreamingCase( DcmIoType::SHORT, short )
+      switchStreamingCase( DcmIoType::UINT, unsigned int )
+      switchStreamingCase( DcmIoType::INT, int )
+      switchStreamingCase( DcmIoType::ULONG, long unsigned int )
+      switchStreamingCase( DcmIoType::LONG, long int )
+      switchStreamingCase( DcmIoType::FLOAT, float )
+      switchStreamingCase( DcmIoType::DOUBLE, double )
+      default:
+        break;
+    }
+  }
+  else if ( io->GetPixelType() == itk::ImageIOBase::RGB )
+  {
+    switch ( io->GetComponentType() )
+    {
+      switchStreamingCase( DcmIoType::UCHAR, itk::RGBPixel<unsigned char> )
+      switchStreamingCase( DcmIoType::CHAR, itk::RGBPixel<char> )
+      switchStreamingCase( DcmIoType::USHORT, itk::RGBPixel<unsigned short> )
+      switchStreamingCase( DcmIoType::SHORT, itk::RGBPixel<short> )
+      switchStreamingCase( DcmIoType::UINT, itk::RGBPixel<unsigned int> )
+      switchStreamingCase( DcmIoType::INT, itk::RGBPixel<int> )
+      switchStreamingCase( DcmIoType::ULONG, itk::RGBPixel<long unsigned int> )
+      switchStreamingCase( DcmIoType::LONG, itk::RGBPixel<long int> )
+      switchStreamingCase( DcmIoType::FLOAT, itk::RGBPixel<float> )
+      switchStreamingCase( DcmIoType::DOUBLE, itk::RGBPixel<double> )
+      default:
+        break;
+    }
+  }
+
+  // unsupported types are reported by Load()
+  return nullptr;
+}
+
+namespace
+{
+  /** State shared by the threads that decode the slices of one streamed image. */
+  struct StreamingJob
+  {
+    mitk::Image::Pointer Image;
+    mitk::ITKDICOMSeriesReaderHelper::StringContainer Filenames;
+    std::vector<unsigned int> SliceOrder;
+    std::size_t BytesPerSlice;
+    int ComponentType;
+    std::function<void()> Finished;
+    std::atomic<std::size_t> NextSlice;
+    std::atomic<unsigned int> RunningThreads;
+  };
+
+  /** Sets the slices that have not been decoded (canceled or failed) to zero instead of leaving them uninitialized. */
+  void ClearUndecodedSlices( const StreamingJob& job )
+  {
+    unsigned int numberOfClearedSlices = 0;
+    for ( unsigned int slice = 0; slice < job.Filenames.size(); ++slice )
+    {
+      if ( job.Image->IsSliceLoaded( slice ) )
+      {
+        continue;
+      }
+
+      mitk::ImageWriteAccessor accessor( job.Image, job.Image->GetSliceData( slice ) );
+      std::memset( accessor.GetData(), 0, job.BytesPerSlice );
+      ++numberOfClearedSlices;
+    }
+
+    if ( numberOfClearedSlices > 0 )
+    {
+      MITK_WARN << numberOfClearedSlices << " of " << job.Filenames.size()
+                << " slices of the streamed DICOM image have not been decoded and are set to zero.";
+    }
+  }
+
+  void DecodeSlices( std::shared_ptr<StreamingJob> job )
+  {
+    itk::GDCMImageIO::Pointer io = itk::GDCMImageIO::New();
+
+    for ( std::size_t i = job->NextSlice++; i < job->SliceOrder.size(); i = job->NextSlice++ )
+    {
+      const unsigned int slice = job->SliceOrder[i];
+      const std::string& filename = job->Filenames[slice];
+      try
+      {
+        io->SetFileName( filename );
+        io->ReadImageInformation();
+
+        if ( static_cast<int>( io->GetComponentType() ) != job->ComponentType
+             || io->GetImageSizeInBytes() != job->BytesPerSlice )
+        {
+          MITK_ERROR << "Cannot stream DICOM file " << filename << ", its pixels differ from the first file of the series.";
+          continue;
+        }
+
+        {
+          mitk::ImageWriteAccessor accessor( job->Image, job->Image->GetSliceData( slice ) );
+          io->Read( accessor.GetData() );
+        }
+        job->Image->SetSliceLoaded( slice );
+      }
+      catch ( const std::exception& e )
+      {
+        MITK_ERROR << "Error encountered when streaming DICOM file " << filename << ": " << e.what();
+      }
+    }
+
+    if ( --job->RunningThreads == 0 )
+    {
+      try
+      {
+        ClearUndecodedSlices( *job );
+      }
+      catch ( const std::exception& e )
+      {
+        MITK_ERROR << "Error encountered when clearing the undecoded slices of a streamed DICOM image: " << e.what();
+      }
+
+      // no slice is written anymore, the waiting threads can go on
+      job->Image->EndProgressiveLoading();
+      if ( job->Finished )
+      {
+        job->Finished();
+      }
+    }
+  }
+}
+
+namespace mitk
+{
+  class ITKDICOMSeriesReaderHelper::StreamingDecoder
+  {
+  public:
+    explicit StreamingDecoder( const std::shared_ptr<StreamingJob>& job ) : m_Job( job ) {}
+
+    ~StreamingDecoder()
+    {
+      // the threads stop after their current slice
+      m_Job->NextSlice = m_Job->SliceOrder.size();
+      for ( auto& thread : m_Threads )
+      {
+        thread.join();
+      }
+    }
+
+    void Start( unsigned int numberOfThreads )
+    {
+      m_Job->RunningThreads = numberOfThreads;
+
+      for ( unsigned int i = 0; i < numberOfThreads; ++i )
+      {
+        try
+        {
+          m_Threads.emplace_back( DecodeSlices, m_Job );
+        }
+        catch ( const std::system_error& e )
+        {
+          // decode the remaining slices here instead of in the threads that could not be started
+          MITK_WARN << "Cannot start DICOM decoding thread: " << e.what();
+          m_Job->RunningThreads -= numberOfThreads - i - 1;
+          DecodeSlices( m_Job );
+          break;
+        }
+      }
+    }
+
+  private:
+    StreamingDecoder( const StreamingDecoder& ) = delete;
+    StreamingDecoder& operator=( const StreamingDecoder& ) = delete;
+
+    std::shared_ptr<StreamingJob> m_Job;
+    std::vector<std::thread> m_Threads;
+  };
+}
+
+std::shared_ptr<mitk::ITKDICOMSeriesReaderHelper::StreamingDecoder>
+  mitk::ITKDICOMSeriesReaderHelper::DecodeSlicesInBackground( Image* image,
+                                                              const StringContainer& filenames,
+                                                              const std::function<void()>& finished )
+{
+  auto job = std::make_shared<StreamingJob>();
+  job->Image = image;
+  job->Filenames = filenames;
+  job->BytesPerSlice = static_cast<std::size_t>( image->GetDimension( 0 ) ) * image->GetDimension( 1 )
+                       * image->GetPixelType().GetSize();
+  job->ComponentType = static_cast<int>( image->GetPixelType().GetComponentType() );
+  job->Finished = finished;
+  job->NextSlice = 0;
+
+  // the views show the center slice of a new image, so it is decoded first
+  const int numberOfSlices = static_cast<int>( filenames.size() );
+  const int center = numberOfSlices / 2;
+  job->SliceOrder.push_back( center );
+  for ( int distance = 1; static_cast<int>( job->SliceOrder.size() ) < numberOfSlices; ++distance )
+  {
+    if ( center - distance >= 0 )
+      job->SliceOrder.push_back( center - distance );
+    if ( center + distance < numberOfSlices )
+      job->SliceOrder.push_back( center + distance );
+  }
+
+  const unsigned int numberOfThreads =
+    std::max( 1u, std::min( std::thread::hardware_concurrency(), static_cast<unsigned int>( numberOfSlices ) ) );
+
+  image->BeginProgressiveLoading();
+
+  auto decoder = std::make_shared<StreamingDecoder>( job );
+  decoder->Start( numberOfThreads );
+  return decoder;
+}
+
+std::shared_ptr<mitk::ITKDICOMSeriesReaderHelper::StreamingDecoder>
+  mitk::ITKDICOMSeriesReaderHelper::GetStreamingDecoder() const
+{
+  return m_StreamingDecoder;
+}
+
 #define switch3DnTCase( IOType, T ) \
   case IOType:                      \
     return LoadDICOMByITK3DnT<T>( filenamesLists, correctTilt, tiltInfo, io );
@@ -4,6 +4,8 @@ set(MODULE_TESTS
   mitkDICOMSimpleVolumeImportTest.cpp
   mitkDICOMTagPathTest.cpp
   mitkDICOMPropertyTest.cpp
+  mitkDICOMPersistentTagCacheTest.cpp
+  mitkDICOMStreamingLoadTest.cpp
 )
 
 set(MODULE_CUSTOM_TESTS
@@ -11,6 +13,12 @@ set(MODULE_CUSTOM_TESTS
   mitkDICOMITKSeriesGDCMReaderBasicsTest.cpp
 )
 
+# Built into a driver of their own with MITK_BUILD_BENCHMARKS, not run by ctest
+set(MODULE_BENCHMARKS
+  mitkDICOMPersistentTagCacheBenchmark.cpp
+  mitkDICOMStreamingLoadBenchmark.cpp
+)
+
 set(CPP_FILES
   mitkDICOMNullFileReader.cpp
   mitkDICOMFilenameSorter.cpp
@@ -0,0 +1,150 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkDICOMDCMTKTagScanner.h"
+#include "mitkDICOMGDCMTagScanner.h"
+#include "mitkDICOMPersistentTagCache.h"
+
+#include "mitkIOUtil.h"
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+#include <itkTimeProbe.h>
+#include <itksys/SystemTools.hxx>
+
+#include <fstream>
+
+/** Reports the times of cold and warm tag scans and of sequential and parallel scans.
+ * Only built with MITK_BUILD_BENCHMARKS. */
+class mitkDICOMPersistentTagCacheBenchmarkSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkDICOMPersistentTagCacheBenchmarkSuite);
+
+  MITK_TEST(WarmDCMTKScan);
+  MITK_TEST(WarmGDCMScan);
+  MITK_TEST(ParallelScan);
+
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+
+  mitk::StringList ctFiles;
+  mitk::DICOMTagPath instanceUID;
+  std::string cacheFileName;
+
+  // scanning the same files several times gives enough files to split them among threads
+  mitk::StringList GetManyFiles() const
+  {
+    mitk::StringList files;
+    for (int i = 0; i < 5; ++i)
+    {
+      files.insert(files.end(), ctFiles.begin(), ctFiles.end());
+    }
+    return files;
+  }
+
+  double ScanWithDCMTK(const mitk::StringList& files, mitk::DICOMPersistentTagCache* cache, unsigned int threads)
+  {
+    mitk::DICOMDCMTKTagScanner::Pointer scanner = mitk::DICOMDCMTKTagScanner::New();
+    scanner->SetInputFiles(files);
+    scanner->AddTagPath(instanceUID);
+    scanner->SetPersistentTagCache(cache);
+    scanner->SetNumberOfThreads(threads);
+
+    itk::TimeProbe probe;
+    probe.Start();
+    scanner->Scan();
+    probe.Stop();
+
+    return probe.GetTotal();
+  }
+
+  double ScanWithGDCM(const mitk::StringList& files, mitk::DICOMPersistentTagCache* cache)
+  {
+    mitk::DICOMGDCMTagScanner::Pointer scanner = mitk::DICOMGDCMTagScanner::New();
+    scanner->SetInputFiles(files);
+    scanner->AddTag(mitk::DICOMTag(0x0008, 0x0018));
+    scanner->SetPersistentTagCache(cache);
+
+    itk::TimeProbe probe;
+    probe.Start();
+    scanner->Scan();
+    probe.Stop();
+
+    return probe.GetTotal();
+  }
+
+public:
+
+  void setUp() override
+  {
+    ctFiles.clear();
+    ctFiles.push_back(GetTestDataFilePath("TinyCTAbdomen/100"));
+    ctFiles.push_back(GetTestDataFilePath("TinyCTAbdomen/101"));
+    ctFiles.push_back(GetTestDataFilePath("TinyCTAbdomen/102"));
+    ctFiles.push_back(GetTestDataFilePath("TinyCTAbdomen/104"));
+
+    instanceUID = mitk::DICOMTagPath(0x0008, 0x0018);
+
+    std::ofstream stream;
+    cacheFileName = mitk::IOUtil::CreateTemporaryFile(stream, "tagcache-XXXXXX.txt");
+    stream.close();
+  }
+
+  void tearDown() override
+  {
+    itksys::SystemTools::RemoveFile(cacheFileName.c_str());
+  }
+
+  void WarmDCMTKScan()
+  {
+    const mitk::StringList files = GetManyFiles();
+
+    mitk::DICOMPersistentTagCache::Pointer cache = mitk::DICOMPersistentTagCache::New();
+    const double coldTime = ScanWithDCMTK(files, cache, 0);
+    cache->Save(cacheFileName);
+
+    mitk::DICOMPersistentTagCache::Pointer loadedCache = mitk::DICOMPersistentTagCache::New();
+    loadedCache->Load(cacheFileName);
+    const double warmTime = ScanWithDCMTK(files, loadedCache, 0);
+
+    MITK_INFO << "DCMTK tag scan of " << files.size() << " files: cold " << coldTime << " s, warm " << warmTime << " s";
+  }
+
+  void WarmGDCMScan()
+  {
+    const mitk::StringList files = GetManyFiles();
+
+    mitk::DICOMPersistentTagCache::Pointer cache = mitk::DICOMPersistentTagCache::New();
+    const double coldTime = ScanWithGDCM(files, cache);
+    cache->Save(cacheFileName);
+
+    mitk::DICOMPersistentTagCache::Pointer loadedCache = mitk::DICOMPersistentTagCache::New();
+    loadedCache->Load(cacheFileName);
+    const double warmTime = ScanWithGDCM(files, loadedCache);
+
+    MITK_INFO << "GDCM tag scan of " << files.size() << " files: cold " << coldTime << " s, warm " << warmTime << " s";
+  }
+
+  void ParallelScan()
+  {
+    const mitk::StringList files = GetManyFiles();
+
+    const double sequentialTime = ScanWithDCMTK(files, nullptr, 1);
+    const double parallelTime = ScanWithDCMTK(files, nullptr, 8);
+
+    MITK_INFO << "DCMTK tag scan of " << files.size() << " files: 1 thread " << sequentialTime << " s, 8 threads "
+              << parallelTime << " s";
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkDICOMPersistentTagCacheBenchmark)
@@ -0,0 +1,220 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkDICOMDCMTKTagScanner.h"
+#include "mitkDICOMGDCMTagScanner.h"
+#include "mitkDICOMPersistentTagCache.h"
+
+#include "mitkIOUtil.h"
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+#include <itksys/SystemTools.hxx>
+
+#include <fstream>
+
+class mitkDICOMPersistentTagCacheTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkDICOMPersistentTagCacheTestSuite);
+
+  MITK_TEST(SaveAndLoad);
+  MITK_TEST(WarmDCMTKScan);
+  MITK_TEST(WarmGDCMScan);
+  MITK_TEST(ParallelScan);
+  MITK_TEST(ModifiedFileIsRescanned);
+
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+
+  mitk::StringList ctFiles;
+  mitk::DICOMTagPath instanceUID;
+  std::string cacheFileName;
+
+  // scanning the same files several times gives enough files to split them among threads
+  mitk::StringList GetManyFiles() const
+  {
+    mitk::StringList files;
+    for (int i = 0; i < 5; ++i)
+    {
+      files.insert(files.end(), ctFiles.begin(), ctFiles.end());
+    }
+    return files;
+  }
+
+  void ScanWithDCMTK(const mitk::StringList& files, mitk::DICOMPersistentTagCache* cache, unsigned int threads,
+    mitk::DICOMDatasetAccessingImageFrameList& frames)
+  {
+    mitk::DICOMDCMTKTagScanner::Pointer scanner = mitk::DICOMDCMTKTagScanner::New();
+    scanner->SetInputFiles(files);
+    scanner->AddTagPath(instanceUID);
+    scanner->SetPersistentTagCache(cache);
+    scanner->SetNumberOfThreads(threads);
+
+    scanner->Scan();
+    frames = scanner->GetFrameInfoList();
+  }
+
+  void CheckInstanceUIDs(const mitk::DICOMDatasetAccessingImageFrameList& frames,
+    const mitk::DICOMDatasetAccessingImageFrameList& reference)
+  {
+    CPPUNIT_ASSERT_MESSAGE("Wrong number of frames", frames.size() == reference.size());
+    for (std::size_t i = 0; i < frames.size(); ++i)
+    {
+      CPPUNIT_ASSERT_MESSAGE("Frames are not in input order", frames[i]->Filename == reference[i]->Filename);
+
+      auto findings = frames[i]->GetTagValueAsString(instanceUID);
+      auto referenceFindings = reference[i]->GetTagValueAsString(instanceUID);
+      CPPUNIT_ASSERT_MESSAGE("Wrong number of findings", findings.size() == 1 && referenceFindings.size() == 1);
+      CPPUNIT_ASSERT_MESSAGE("Invalid finding", findings.front().isValid);
+      CPPUNIT_ASSERT_MESSAGE("Wrong value", findings.front().value == referenceFindings.front().value);
+    }
+  }
+
+public:
+
+  void setUp() override
+  {
+    ctFiles.clear();
+    ctFiles.push_back(GetTestDataFilePath("TinyCTAbdomen/100"));
+    ctFiles.push_back(GetTestDataFilePath("TinyCTAbdomen/101"));
+    ctFiles.push_back(GetTestDataFilePath("TinyCTAbdomen/102"));
+    ctFiles.push_back(GetTestDataFilePath("TinyCTAbdomen/104"));
+
+    instanceUID = mitk::DICOMTagPath(0x0008, 0x0018);
+
+    std::ofstream stream;
+    cacheFileName = mitk::IOUtil::CreateTemporaryFile(stream, "tagcache-XXXXXX.txt");
+    stream.close();
+  }
+
+  void tearDown() override
+  {
+    itksys::SystemTools::RemoveFile(cacheFileName.c_str());
+  }
+
+  void SaveAndLoad()
+  {
+    mitk::DICOMPersistentTagCache::Pointer cache = mitk::DICOMPersistentTagCache::New();
+    mitk::DICOMDatasetAccessingImageFrameList frames;
+    ScanWithDCMTK(ctFiles, cache, 0, frames);
+
+    CPPUNIT_ASSERT_MESSAGE("Scanned files are not cached", cache->GetNumberOfEntries() == ctFiles.size());
+    CPPUNIT_ASSERT_MESSAGE("New entries are not flagged", cache->HasUnsavedChanges());
+
+    cache->Save(cacheFileName);
+    CPPUNIT_ASSERT_MESSAGE("Saved cache is flagged", !cache->HasUnsavedChanges());
+
+    mitk::DICOMPersistentTagCache::Pointer loadedCache = mitk::DICOMPersistentTagCache::New();
+    CPPUNIT_ASSERT_MESSAGE("Cannot load cache", loadedCache->Load(cacheFileName));
+    CPPUNIT_ASSERT_MESSAGE("Wrong number of loaded entries", loadedCache->GetNumberOfEntries() == ctFiles.size());
+
+    mitk::DICOMPersistentTagCache::TagValueMapType values;
+    CPPUNIT_ASSERT_MESSAGE("Entry not found",
+      loadedCache->Lookup("DICOMDCMTKTagScanner", ctFiles.front(), { instanceUID }, values));
+    CPPUNIT_ASSERT_MESSAGE("Wrong value", values[instanceUID] == "1.2.276.0.99.1.4.8323329.3795.1303917947.940051");
+
+    mitk::DICOMTagPath notScanned(0x0010, 0x0010);
+    CPPUNIT_ASSERT_MESSAGE("Entry is used for tags that were not scanned",
+      !loadedCache->Lookup("DICOMDCMTKTagScanner", ctFiles.front(), { instanceUID, notScanned }, values));
+    CPPUNIT_ASSERT_MESSAGE("Entry is used for another scanner",
+      !loadedCache->Lookup("DICOMGDCMTagScanner", ctFiles.front(), { instanceUID }, values));
+
+    CPPUNIT_ASSERT_MESSAGE("Missing file can be loaded", !loadedCache->Load(cacheFileName + ".missing"));
+    CPPUNIT_ASSERT_MESSAGE("Cache is not empty after failed load", loadedCache->GetNumberOfEntries() == 0);
+  }
+
+  void WarmDCMTKScan()
+  {
+    const mitk::StringList files = GetManyFiles();
+
+    mitk::DICOMPersistentTagCache::Pointer cache = mitk::DICOMPersistentTagCache::New();
+    mitk::DICOMDatasetAccessingImageFrameList coldFrames;
+    ScanWithDCMTK(files, cache, 0, coldFrames);
+    cache->Save(cacheFileName);
+
+    mitk::DICOMPersistentTagCache::Pointer loadedCache = mitk::DICOMPersistentTagCache::New();
+    loadedCache->Load(cacheFileName);
+    mitk::DICOMDatasetAccessingImageFrameList warmFrames;
+    ScanWithDCMTK(files, loadedCache, 0, warmFrames);
+
+    CPPUNIT_ASSERT_MESSAGE("Warm scan parsed files", !loadedCache->HasUnsavedChanges());
+    CheckInstanceUIDs(warmFrames, coldFrames);
+  }
+
+  void WarmGDCMScan()
+  {
+    const mitk::StringList files = GetManyFiles();
+    const mitk::DICOMTag tag(0x0008, 0x0018);
+
+    mitk::DICOMPersistentTagCache::Pointer cache = mitk::DICOMPersistentTagCache::New();
+
+    mitk::DICOMGDCMTagScanner::Pointer coldScanner = mitk::DICOMGDCMTagScanner::New();
+    coldScanner->SetInputFiles(files);
+    coldScanner->AddTag(tag);
+    coldScanner->SetPersistentTagCache(cache);
+
+    coldScanner->Scan();
+
+    cache->Save(cacheFileName);
+    mitk::DICOMPersistentTagCache::Pointer loadedCache = mitk::DICOMPersistentTagCache::New();
+    loadedCache->Load(cacheFileName);
+
+    mitk::DICOMGDCMTagScanner::Pointer warmScanner = mitk::DICOMGDCMTagScanner::New();
+    warmScanner->SetInputFiles(files);
+    warmScanner->AddTag(tag);
+    warmScanner->SetPersistentTagCache(loadedCache);
+
+    warmScanner->Scan();
+
+    CPPUNIT_ASSERT_MESSAGE("Warm scan parsed files", !loadedCache->HasUnsavedChanges());
+    CheckInstanceUIDs(warmScanner->GetFrameInfoList(), coldScanner->GetFrameInfoList());
+  }
+
+  void ParallelScan()
+  {
+    const mitk::StringList files = GetManyFiles();
+
+    mitk::DICOMDatasetAccessingImageFrameList sequentialFrames;
+    ScanWithDCMTK(files, nullptr, 1, sequentialFrames);
+    mitk::DICOMDatasetAccessingImageFrameList parallelFrames;
+    ScanWithDCMTK(files, nullptr, 8, parallelFrames);
+
+    CheckInstanceUIDs(parallelFrames, sequentialFrames);
+  }
+
+  void ModifiedFileIsRescanned()
+  {
+    std::ofstream stream;
+    const std::string copiedFile = mitk::IOUtil::CreateTemporaryFile(stream, "dicom-XXXXXX.dcm");
+    stream.close();
+    itksys::SystemTools::CopyAFile(ctFiles.front().c_str(), copiedFile.c_str());
+
+    mitk::DICOMPersistentTagCache::Pointer cache = mitk::DICOMPersistentTagCache::New();
+    mitk::DICOMDatasetAccessingImageFrameList frames;
+    ScanWithDCMTK({ copiedFile }, cache, 0, frames);
+
+    mitk::DICOMPersistentTagCache::TagValueMapType values;
+    CPPUNIT_ASSERT_MESSAGE("Entry not found", cache->Lookup("DICOMDCMTKTagScanner", copiedFile, { instanceUID }, values));
+
+    // changing the size invalidates the entry
+    std::ofstream append(copiedFile.c_str(), std::ios::app | std::ios::binary);
+    append << '\0';
+    append.close();
+    CPPUNIT_ASSERT_MESSAGE("Entry of modified file is used",
+      !cache->Lookup("DICOMDCMTKTagScanner", copiedFile, { instanceUID }, values));
+
+    itksys::SystemTools::RemoveFile(copiedFile.c_str());
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkDICOMPersistentTagCache)
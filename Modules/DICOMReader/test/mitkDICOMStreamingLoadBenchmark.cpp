@@ -0,0 +1,88 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkDICOMITKSeriesGDCMReader.h"
+
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+#include <itkTimeProbe.h>
+#include <itksys/Directory.hxx>
+
+#include <algorithm>
+
+/** Reports how long LoadImages() takes to return with and without streaming load.
+ * Only built with MITK_BUILD_BENCHMARKS. */
+class mitkDICOMStreamingLoadBenchmarkSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkDICOMStreamingLoadBenchmarkSuite);
+
+  MITK_TEST(LoadImages);
+
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+
+  mitk::StringList ctFiles;
+
+  mitk::DICOMITKSeriesGDCMReader::Pointer Read(bool streaming, double& seconds)
+  {
+    mitk::DICOMITKSeriesGDCMReader::Pointer reader = mitk::DICOMITKSeriesGDCMReader::New();
+    reader->SetInputFiles(ctFiles);
+    reader->SetStreamingLoad(streaming);
+    reader->AnalyzeInputFiles();
+
+    itk::TimeProbe probe;
+    probe.Start();
+    reader->LoadImages();
+    probe.Stop();
+
+    seconds = probe.GetTotal();
+    return reader;
+  }
+
+public:
+
+  void setUp() override
+  {
+    // the slices of TinyCTAbdomen are named 100, 101, ...
+    const std::string directoryName = GetTestDataFilePath("TinyCTAbdomen");
+    itksys::Directory directory;
+    directory.Load(directoryName.c_str());
+
+    ctFiles.clear();
+    for (unsigned long i = 0; i < directory.GetNumberOfFiles(); ++i)
+    {
+      const std::string name = directory.GetFile(i);
+      if (name.size() == 3 && name[0] == '1')
+      {
+        ctFiles.push_back(directoryName + "/" + name);
+      }
+    }
+    std::sort(ctFiles.begin(), ctFiles.end());
+  }
+
+  void LoadImages()
+  {
+    CPPUNIT_ASSERT_MESSAGE("No test data", !ctFiles.empty());
+
+    double regularTime = 0.0;
+    double streamingTime = 0.0;
+    auto regularReader = Read(false, regularTime);
+    auto streamingReader = Read(true, streamingTime);
+
+    MITK_INFO << "Loading of " << ctFiles.size() << " slices returned after " << regularTime << " s (regular), "
+              << streamingTime << " s (streaming)";
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkDICOMStreamingLoadBenchmark)
@@ -0,0 +1,136 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkDICOMITKSeriesGDCMReader.h"
+
+#include "mitkImage.h"
+#include "mitkImageReadAccessor.h"
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+#include <itksys/Directory.hxx>
+
+#include <algorithm>
+#include <clocale>
+#include <cstring>
+
+class mitkDICOMStreamingLoadTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkDICOMStreamingLoadTestSuite);
+
+  MITK_TEST(StreamedImagesEqualRegularImages);
+  MITK_TEST(StreamingIsOffByDefault);
+  MITK_TEST(DestroyingReader_EndsDecodingAndRestoresLocale);
+
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+
+  mitk::StringList ctFiles;
+
+  mitk::DICOMITKSeriesGDCMReader::Pointer Read(bool streaming)
+  {
+    mitk::DICOMITKSeriesGDCMReader::Pointer reader = mitk::DICOMITKSeriesGDCMReader::New();
+    reader->SetInputFiles(ctFiles);
+    reader->SetStreamingLoad(streaming);
+    reader->AnalyzeInputFiles();
+    reader->LoadImages();
+    return reader;
+  }
+
+public:
+
+  void setUp() override
+  {
+    // the slices of TinyCTAbdomen are named 100, 101, ...
+    const std::string directoryName = GetTestDataFilePath("TinyCTAbdomen");
+    itksys::Directory directory;
+    directory.Load(directoryName.c_str());
+
+    ctFiles.clear();
+    for (unsigned long i = 0; i < directory.GetNumberOfFiles(); ++i)
+    {
+      const std::string name = directory.GetFile(i);
+      if (name.size() == 3 && name[0] == '1')
+      {
+        ctFiles.push_back(directoryName + "/" + name);
+      }
+    }
+    std::sort(ctFiles.begin(), ctFiles.end());
+  }
+
+  void StreamedImagesEqualRegularImages()
+  {
+    CPPUNIT_ASSERT_MESSAGE("No test data", !ctFiles.empty());
+
+    auto regularReader = Read(false);
+    auto streamingReader = Read(true);
+
+    CPPUNIT_ASSERT_EQUAL(regularReader->GetNumberOfOutputs(), streamingReader->GetNumberOfOutputs());
+    for (unsigned int o = 0; o < regularReader->GetNumberOfOutputs(); ++o)
+    {
+      mitk::Image::Pointer regularImage = regularReader->GetOutput(o).GetMitkImage();
+      mitk::Image::Pointer streamedImage = streamingReader->GetOutput(o).GetMitkImage();
+      CPPUNIT_ASSERT(regularImage.IsNotNull() && streamedImage.IsNotNull());
+
+      streamedImage->WaitForProgressiveLoading();
+      CPPUNIT_ASSERT_MESSAGE("Not all slices have been loaded",
+        streamedImage->GetNumberOfLoadedSlices() == streamedImage->GetDimension(2));
+      CPPUNIT_ASSERT_MESSAGE("Streamed image differs", mitk::Equal(*regularImage, *streamedImage, mitk::eps, true));
+    }
+  }
+
+  void StreamingIsOffByDefault()
+  {
+    mitk::DICOMITKSeriesGDCMReader::Pointer reader = mitk::DICOMITKSeriesGDCMReader::New();
+    CPPUNIT_ASSERT(!reader->GetStreamingLoad());
+
+    auto regularReader = Read(false);
+    for (unsigned int o = 0; o < regularReader->GetNumberOfOutputs(); ++o)
+    {
+      CPPUNIT_ASSERT(!regularReader->GetOutput(o).GetMitkImage()->IsLoadingProgressively());
+    }
+  }
+
+  void DestroyingReader_EndsDecodingAndRestoresLocale()
+  {
+    CPPUNIT_ASSERT_MESSAGE("No test data", !ctFiles.empty());
+
+    const std::string locale = setlocale(LC_NUMERIC, nullptr);
+    mitk::Image::Pointer image;
+    {
+      auto reader = Read(true);
+      image = reader->GetOutput(0).GetMitkImage();
+    }
+
+    CPPUNIT_ASSERT(image.IsNotNull());
+    CPPUNIT_ASSERT(!image->IsLoadingProgressively());
+    CPPUNIT_ASSERT_EQUAL(locale, std::string(setlocale(LC_NUMERIC, nullptr)));
+
+    // the slices that have not been decoded are zero
+    auto regularReader = Read(false);
+    mitk::Image::Pointer regularImage = regularReader->GetOutput(0).GetMitkImage();
+    mitk::ImageReadAccessor regularAccess(regularImage);
+    mitk::ImageReadAccessor access(image);
+    const std::size_t bytesPerSlice = image->GetDimension(0) * image->GetDimension(1) * image->GetPixelType().GetSize();
+    for (unsigned int slice = 0; slice < image->GetDimension(2); ++slice)
+    {
+      const auto *regularPixels = static_cast<const char *>(regularAccess.GetData()) + slice * bytesPerSlice;
+      const auto *pixels = static_cast<const char *>(access.GetData()) + slice * bytesPerSlice;
+      const bool decoded = 0 == std::memcmp(regularPixels, pixels, bytesPerSlice);
+      const bool cleared = std::all_of(pixels, pixels + bytesPerSlice, [](char byte) { return 0 == byte; });
+      CPPUNIT_ASSERT_MESSAGE("Slice is neither decoded nor cleared", decoded || cleared);
+    }
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkDICOMStreamingLoad)
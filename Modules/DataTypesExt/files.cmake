@@ -26,6 +26,7 @@ set(CPP_FILES
   mitkMesh.cpp
   mitkMultiStepper.cpp
   mitkPlane.cpp
+  mitkSparseImagePatch.cpp
   mitkSurfaceDeformationDataInteractor3D.cpp
   mitkUnstructuredGrid.cpp
   mitkUnstructuredGridSource.cpp
@@ -14,8 +14,12 @@ found in the LICENSE file.
 #define mitkApplyDiffImageIIncluded
 
 #include "MitkDataTypesExtExports.h"
-#include "mitkCompressedImageContainer.h"
+#include "mitkImage.h"
 #include "mitkOperation.h"
+#include "mitkSparseImagePatch.h"
+
+#include <memory>
+#include <vector>
 
 namespace mitk
 {
@@ -31,7 +35,9 @@ namespace mitk
    used to keep the image alive -- the purpose of this class is undo and the undo
    stack should not keep things alive forever.
 
-   To save memory, zlib compression is used via CompressedImageContainer.
+   To save memory, only the pixels that are not zero are kept (see SparseImagePatch), one patch
+   per time step of the difference image. DiffImageApplier applies these pixels directly; the full
+   difference image is only restored by GetDiffImage() on request.
 
    @ingroup Undo
    @ingroup ToolManagerEtAl
@@ -50,7 +56,10 @@ namespace mitk
 
     unsigned long m_DeleteTag;
 
-    CompressedImageContainer::Pointer zlibContainer;
+    std::unique_ptr<PixelType> m_DiffPixelType;
+    std::vector<unsigned int> m_DiffImageDimensions;
+    BaseGeometry::Pointer m_DiffImageGeometry;
+    std::vector<SparseImagePatch> m_DiffPatches;
 
   public:
     /**
@@ -76,6 +85,15 @@ namespace mitk
     Image *GetImage() { return m_Image; }
     Image::Pointer GetDiffImage();
 
+    /** \brief Dimensions of the difference image (empty if no difference image was passed).*/
+    const std::vector<unsigned int> &GetDiffImageDimensions() const { return m_DiffImageDimensions; }
+    /** \brief Pixel type of the difference image (nullptr if no difference image was passed).*/
+    const PixelType *GetDiffPixelType() const { return m_DiffPixelType.get(); }
+    /** \brief The pixels of the given time step of the difference image that are not zero.*/
+    const SparseImagePatch &GetDiffPatch(unsigned int timeStep = 0) const { return m_DiffPatches.at(timeStep); }
+
+    std::size_t GetMemorySize() const override;
+
     bool IsImageStillValid() { return m_ImageStillValid; }
   };
 
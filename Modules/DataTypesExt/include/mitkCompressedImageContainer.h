@@ -56,6 +56,11 @@ namespace mitk
      */
     Image::Pointer GetImage();
 
+    /**
+     * \brief Number of bytes of the compressed data of all time steps.
+     */
+    std::size_t GetCompressedSize() const;
+
   protected:
     CompressedImageContainer(); // purposely hidden
     ~CompressedImageContainer() override;
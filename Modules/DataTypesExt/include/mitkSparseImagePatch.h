@@ -0,0 +1,95 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkSparseImagePatch_h_Included
+#define mitkSparseImagePatch_h_Included
+
+#include "MitkDataTypesExtExports.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace mitk
+{
+  /**
+    \brief Run-length encoded set of pixel values of an image buffer.
+
+    Stores only the runs of consecutive pixels that differ from a reference buffer (or that are
+    not zero) together with their values. Applying the patch to a buffer writes the stored values
+    and leaves all other pixels untouched, so both creating and applying a patch do not have to
+    touch more than the changed pixels (apart from the comparison while creating).
+
+    Segmentation tools usually change a small part of a slice, so undo information stored as
+    patches takes much less memory than the full slice or volume and does not need to be
+    (de)compressed.
+
+    Pixels are compared bytewise, i.e. the patch reproduces the values exactly for any pixel type.
+
+    \ingroup Undo
+  */
+  class MITKDATATYPESEXT_EXPORT SparseImagePatch
+  {
+  public:
+    /** \brief Consecutive pixels of the patch, given as offset (in pixels) and number of pixels.*/
+    struct Run
+    {
+      std::size_t Offset;
+      std::size_t Length;
+    };
+
+    SparseImagePatch();
+
+    /**
+      \brief Creates a patch that holds the pixels of target that differ from reference.
+
+      Both buffers hold numberOfPixels pixels of pixelSize bytes each. Applying the patch to a
+      copy of reference yields target. If reference is nullptr, all pixels of target that are
+      not zero are stored.
+    */
+    static SparseImagePatch Create(const void *reference,
+                                   const void *target,
+                                   std::size_t numberOfPixels,
+                                   std::size_t pixelSize);
+
+    /** \brief Writes the values of the patch to the buffer. The buffer has to hold at least
+     * GetNumberOfPixels() pixels of GetPixelSize() bytes.*/
+    void Apply(void *buffer) const;
+
+    /** \brief True if no pixel differs.*/
+    bool IsEmpty() const { return m_Runs.empty(); }
+
+    std::size_t GetPixelSize() const { return m_PixelSize; }
+
+    /** \brief Number of pixels of the buffers the patch was created for.*/
+    std::size_t GetNumberOfPixels() const { return m_NumberOfPixels; }
+
+    /** \brief Number of pixels stored in the patch.*/
+    std::size_t GetNumberOfChangedPixels() const;
+
+    const std::vector<Run> &GetRuns() const { return m_Runs; }
+
+    /** \brief Returns the stored values of all runs, one after the other.*/
+    const std::vector<char> &GetValues() const { return m_Values; }
+
+    /** \brief Approximate number of bytes occupied by the patch.*/
+    std::size_t GetMemorySize() const;
+
+  private:
+    std::size_t m_PixelSize;
+    std::size_t m_NumberOfPixels;
+    std::vector<Run> m_Runs;
+    std::vector<char> m_Values;
+  };
+
+} // namespace mitk
+
+#endif
@@ -12,8 +12,13 @@ found in the LICENSE file.
 
 #include "mitkApplyDiffImageOperation.h"
 
+#include "mitkImageReadAccessor.h"
+#include "mitkImageWriteAccessor.h"
+
 #include <itkCommand.h>
 
+#include <cstring>
+
 mitk::ApplyDiffImageOperation::ApplyDiffImageOperation(OperationType operationType,
                                                        Image *image,
                                                        Image *diffImage,
@@ -39,9 +44,22 @@ mitk::ApplyDiffImageOperation::ApplyDiffImageOperation(OperationType operationTy
     command->SetCallbackFunction(this, &ApplyDiffImageOperation::OnImageDeleted);
     m_DeleteTag = image->AddObserver(itk::DeleteEvent(), command);
 
-    // keep a compressed version of the image
-    zlibContainer = CompressedImageContainer::New();
-    zlibContainer->SetImage(diffImage);
+    // keep the changed (non-zero) pixels only
+    m_DiffPixelType.reset(new PixelType(diffImage->GetPixelType()));
+    for (unsigned int i = 0; i < diffImage->GetDimension(); ++i)
+      m_DiffImageDimensions.push_back(diffImage->GetDimension(i));
+    m_DiffImageGeometry = diffImage->GetGeometry()->Clone();
+
+    const unsigned int numberOfTimeSteps = diffImage->GetDimension() > 3 ? diffImage->GetDimension(3) : 1;
+    const std::size_t pixelSize = m_DiffPixelType->GetSize();
+    std::size_t numberOfPixels = 1;
+    for (unsigned int i = 0; i < diffImage->GetDimension() && i < 3; ++i)
+      numberOfPixels *= diffImage->GetDimension(i);
+    for (unsigned int t = 0; t < numberOfTimeSteps; ++t)
+    {
+      ImageReadAccessor readAccess(diffImage, diffImage->GetVolumeData(t));
+      m_DiffPatches.push_back(SparseImagePatch::Create(nullptr, readAccess.GetData(), numberOfPixels, pixelSize));
+    }
   }
 }
 
@@ -60,8 +78,30 @@ void mitk::ApplyDiffImageOperation::OnImageDeleted()
 
 mitk::Image::Pointer mitk::ApplyDiffImageOperation::GetDiffImage()
 {
-  // uncompress image to create a valid mitk::Image
-  Image::Pointer image = zlibContainer->GetImage().GetPointer();
+  if (m_DiffPatches.empty())
+    return nullptr;
+
+  // restore the difference image from the non-zero pixels
+  Image::Pointer image = Image::New();
+  image->Initialize(*m_DiffPixelType,
+                    static_cast<unsigned int>(m_DiffImageDimensions.size()),
+                    m_DiffImageDimensions.data());
+
+  for (unsigned int t = 0; t < m_DiffPatches.size(); ++t)
+  {
+    ImageWriteAccessor writeAccess(image, image->GetVolumeData(t));
+    std::memset(writeAccess.GetData(), 0, m_DiffPatches[t].GetNumberOfPixels() * m_DiffPatches[t].GetPixelSize());
+    m_DiffPatches[t].Apply(writeAccess.GetData());
+  }
 
+  image->SetGeometry(m_DiffImageGeometry->Clone());
   return image;
 }
+
+std::size_t mitk::ApplyDiffImageOperation::GetMemorySize() const
+{
+  std::size_t size = sizeof(*this);
+  for (const auto &patch : m_DiffPatches)
+    size += patch.GetMemorySize();
+  return size;
+}
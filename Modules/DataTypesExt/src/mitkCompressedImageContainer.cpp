@@ -176,3 +176,13 @@ mitk::Image::Pointer mitk::CompressedImageContainer::GetImage()
 
   return image;
 }
+
+std::size_t mitk::CompressedImageContainer::GetCompressedSize() const
+{
+  std::size_t size = 0;
+  for (auto iter = m_ByteBuffers.begin(); iter != m_ByteBuffers.end(); ++iter)
+  {
+    size += iter->second;
+  }
+  return size;
+}
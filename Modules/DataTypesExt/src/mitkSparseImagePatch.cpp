@@ -0,0 +1,97 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkSparseImagePatch.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+  /** Offset (in bytes) of the first byte of target that differs from reference (or is not zero), or size.*/
+  std::size_t FindNextDifference(const char *reference, const char *target, std::size_t begin, std::size_t size)
+  {
+    if (nullptr != reference)
+      return std::mismatch(target + begin, target + size, reference + begin).first - target;
+
+    return std::find_if(target + begin, target + size, [](char value) { return 0 != value; }) - target;
+  }
+
+  bool PixelDiffers(const char *reference, const char *target, std::size_t pixel, std::size_t pixelSize)
+  {
+    const char *targetPixel = target + pixel * pixelSize;
+    if (nullptr != reference)
+      return 0 != std::memcmp(targetPixel, reference + pixel * pixelSize, pixelSize);
+
+    return std::any_of(targetPixel, targetPixel + pixelSize, [](char value) { return 0 != value; });
+  }
+}
+
+mitk::SparseImagePatch::SparseImagePatch() : m_PixelSize(0), m_NumberOfPixels(0)
+{
+}
+
+mitk::SparseImagePatch mitk::SparseImagePatch::Create(const void *reference,
+                                                      const void *target,
+                                                      std::size_t numberOfPixels,
+                                                      std::size_t pixelSize)
+{
+  SparseImagePatch patch;
+  patch.m_PixelSize = pixelSize;
+  patch.m_NumberOfPixels = numberOfPixels;
+
+  if (0 == pixelSize)
+    return patch;
+
+  const auto *referenceBytes = static_cast<const char *>(reference);
+  const auto *targetBytes = static_cast<const char *>(target);
+  const std::size_t size = numberOfPixels * pixelSize;
+
+  // skip equal pixels bytewise, then collect the differing pixels of the run
+  std::size_t byte = FindNextDifference(referenceBytes, targetBytes, 0, size);
+  while (byte < size)
+  {
+    const std::size_t begin = byte / pixelSize;
+    std::size_t end = begin + 1;
+    while (end < numberOfPixels && PixelDiffers(referenceBytes, targetBytes, end, pixelSize))
+      ++end;
+
+    patch.m_Runs.push_back({begin, end - begin});
+    patch.m_Values.insert(patch.m_Values.end(), targetBytes + begin * pixelSize, targetBytes + end * pixelSize);
+
+    byte = FindNextDifference(referenceBytes, targetBytes, end * pixelSize, size);
+  }
+
+  return patch;
+}
+
+void mitk::SparseImagePatch::Apply(void *buffer) const
+{
+  auto *bytes = static_cast<char *>(buffer);
+  const char *values = m_Values.data();
+  for (const auto &run : m_Runs)
+  {
+    const std::size_t length = run.Length * m_PixelSize;
+    std::memcpy(bytes + run.Offset * m_PixelSize, values, length);
+    values += length;
+  }
+}
+
+std::size_t mitk::SparseImagePatch::GetNumberOfChangedPixels() const
+{
+  return 0 != m_PixelSize ? m_Values.size() / m_PixelSize : 0;
+}
+
+std::size_t mitk::SparseImagePatch::GetMemorySize() const
+{
+  return sizeof(*this) + m_Runs.capacity() * sizeof(Run) + m_Values.capacity();
+}
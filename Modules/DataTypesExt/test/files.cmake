@@ -2,6 +2,7 @@ set(MODULE_TESTS
   mitkColorSequenceRainbowTest.cpp
   mitkMeshTest.cpp
   mitkMultiStepperTest.cpp
+  mitkSparseImagePatchTest.cpp
   mitkUnstructuredGridTest.cpp
 )
 
@@ -0,0 +1,155 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkApplyDiffImageOperation.h>
+#include <mitkImageGenerator.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkImageWriteAccessor.h>
+#include <mitkInteractionConst.h>
+#include <mitkSparseImagePatch.h>
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+class mitkSparseImagePatchTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkSparseImagePatchTestSuite);
+  MITK_TEST(Create_EqualBuffers_IsEmpty);
+  MITK_TEST(Create_ChangedPixels_StoresRuns);
+  MITK_TEST(Apply_OriginalBuffer_YieldsTarget);
+  MITK_TEST(Create_ChangedHighByte_StoresWholePixel);
+  MITK_TEST(Create_NoReference_StoresNonZeroPixels);
+  MITK_TEST(ApplyDiffImageOperation_GetDiffImage_EqualsDiffImage);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void Create_EqualBuffers_IsEmpty()
+  {
+    std::vector<short> original(1000, 7);
+    auto patch = mitk::SparseImagePatch::Create(original.data(), original.data(), original.size(), sizeof(short));
+
+    CPPUNIT_ASSERT(patch.IsEmpty());
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), patch.GetNumberOfChangedPixels());
+    CPPUNIT_ASSERT_EQUAL(original.size(), patch.GetNumberOfPixels());
+  }
+
+  void Create_ChangedPixels_StoresRuns()
+  {
+    std::vector<short> original(1000, 7);
+    std::vector<short> modified = original;
+    for (std::size_t i = 100; i < 110; ++i)
+      modified[i] = 1;
+    modified[500] = 1;
+    modified[999] = 1;
+
+    auto patch = mitk::SparseImagePatch::Create(original.data(), modified.data(), original.size(), sizeof(short));
+
+    CPPUNIT_ASSERT_EQUAL(std::size_t(3), patch.GetRuns().size());
+    CPPUNIT_ASSERT_EQUAL(std::size_t(100), patch.GetRuns()[0].Offset);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(10), patch.GetRuns()[0].Length);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(999), patch.GetRuns()[2].Offset);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(12), patch.GetNumberOfChangedPixels());
+    CPPUNIT_ASSERT(patch.GetMemorySize() < original.size() * sizeof(short));
+  }
+
+  void Apply_OriginalBuffer_YieldsTarget()
+  {
+    std::vector<float> original(4096);
+    for (std::size_t i = 0; i < original.size(); ++i)
+      original[i] = static_cast<float>(i % 17);
+
+    std::vector<float> modified = original;
+    for (std::size_t i = 1000; i < 1500; i += 3)
+      modified[i] = -1.5f;
+
+    auto redo = mitk::SparseImagePatch::Create(original.data(), modified.data(), original.size(), sizeof(float));
+    auto undo = mitk::SparseImagePatch::Create(modified.data(), original.data(), original.size(), sizeof(float));
+
+    std::vector<float> buffer = original;
+    redo.Apply(buffer.data());
+    CPPUNIT_ASSERT(modified == buffer);
+
+    undo.Apply(buffer.data());
+    CPPUNIT_ASSERT(original == buffer);
+  }
+
+  void Create_ChangedHighByte_StoresWholePixel()
+  {
+    std::vector<int> original(64, 0);
+    std::vector<int> modified = original;
+    modified[10] = 1 << 24;
+
+    auto patch = mitk::SparseImagePatch::Create(original.data(), modified.data(), original.size(), sizeof(int));
+
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), patch.GetRuns().size());
+    CPPUNIT_ASSERT_EQUAL(std::size_t(10), patch.GetRuns()[0].Offset);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), patch.GetRuns()[0].Length);
+
+    std::vector<int> buffer = original;
+    patch.Apply(buffer.data());
+    CPPUNIT_ASSERT(modified == buffer);
+  }
+
+  void Create_NoReference_StoresNonZeroPixels()
+  {
+    std::vector<short> diff(256, 0);
+    diff[3] = -1;
+    diff[4] = 1;
+    diff[200] = 1;
+
+    auto patch = mitk::SparseImagePatch::Create(nullptr, diff.data(), diff.size(), sizeof(short));
+
+    CPPUNIT_ASSERT_EQUAL(std::size_t(2), patch.GetRuns().size());
+    CPPUNIT_ASSERT_EQUAL(std::size_t(3), patch.GetNumberOfChangedPixels());
+
+    std::vector<short> buffer(256, 0);
+    patch.Apply(buffer.data());
+    CPPUNIT_ASSERT(diff == buffer);
+  }
+
+  void ApplyDiffImageOperation_GetDiffImage_EqualsDiffImage()
+  {
+    auto image = mitk::ImageGenerator::GenerateGradientImage<unsigned char>(16, 16, 4);
+    unsigned int dimensions[2] = {16, 16};
+    auto diffImage = mitk::Image::New();
+    diffImage->Initialize(mitk::MakeScalarPixelType<short>(), 2, dimensions);
+    {
+      mitk::ImageWriteAccessor writeAccess(diffImage);
+      auto *pixels = static_cast<short *>(writeAccess.GetData());
+      std::fill(pixels, pixels + 16 * 16, short(0));
+      pixels[17] = 1;
+      pixels[18] = -1;
+    }
+
+    std::unique_ptr<mitk::ApplyDiffImageOperation> operation(
+      new mitk::ApplyDiffImageOperation(mitk::OpTEST, image, diffImage, 0, 2, 1));
+    CPPUNIT_ASSERT_EQUAL(std::size_t(2), operation->GetDiffPatch().GetNumberOfChangedPixels());
+
+    auto restoredImage = operation->GetDiffImage();
+    CPPUNIT_ASSERT_EQUAL(2u, restoredImage->GetDimension());
+    CPPUNIT_ASSERT(restoredImage->GetPixelType() == diffImage->GetPixelType());
+
+    mitk::ImageReadAccessor readAccess(diffImage);
+    mitk::ImageReadAccessor restoredAccess(restoredImage);
+    const auto *pixels = static_cast<const short *>(readAccess.GetData());
+    const auto *restoredPixels = static_cast<const short *>(restoredAccess.GetData());
+    for (unsigned int i = 0; i < 16 * 16; ++i)
+    {
+      CPPUNIT_ASSERT_EQUAL(pixels[i], restoredPixels[i]);
+    }
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkSparseImagePatch)
@@ -54,6 +54,7 @@ class mitkImageStatisticsCalculatorTestSuite : public mitk::TestFixture
   MITK_TEST(TestUS4DCroppedPlanarFigureTimeStep1);
   MITK_TEST(TestUS4DCroppedAllTimesteps);
   MITK_TEST(TestUS4DCropped3DMask);
+  MITK_TEST(TestSinglePassEqualsTwoPassMultilabelMask);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -84,6 +85,8 @@ public:
   void TestUS4DCroppedPlanarFigureTimeStep1();
   void TestUS4DCroppedAllTimesteps();
   void TestUS4DCropped3DMask();
+
+  void TestSinglePassEqualsTwoPassMultilabelMask();
 private:
 	mitk::Image::ConstPointer m_TestImage;
 
@@ -1059,6 +1062,83 @@ mitkImageStatisticsCalculatorTestSuite::ComputeStatistics(mitk::Image::ConstPoin
 	return imgStatCalc->GetStatistics(label);
 }
 
+void mitkImageStatisticsCalculatorTestSuite::TestSinglePassEqualsTwoPassMultilabelMask()
+{
+	MITK_INFO << std::endl << "Test single pass statistics with multilabel masks:-----------------------------------------------------------------------------------";
+
+	std::string US4DCroppedFile = this->GetTestDataFilePath("ImageStatisticsTestData/US4D_cropped.nrrd");
+	m_US4DCroppedImage = mitk::IOUtil::Load<mitk::Image>(US4DCroppedFile);
+	CPPUNIT_ASSERT_MESSAGE("Failed loading US4D_cropped", m_US4DCroppedImage.IsNotNull());
+
+	std::string US4DCroppedMultilabelMaskFile = this->GetTestDataFilePath("ImageStatisticsTestData/US4D_croppedMultilabelMask.nrrd");
+	m_US4DCroppedMultilabelMask = mitk::IOUtil::Load<mitk::Image>(US4DCroppedMultilabelMaskFile);
+	CPPUNIT_ASSERT_MESSAGE("Failed loading US4D multilabel mask", m_US4DCroppedMultilabelMask.IsNotNull());
+
+	for (bool useBinSize : { false, true })
+	{
+		mitk::ImageMaskGenerator::Pointer imgMaskGen = mitk::ImageMaskGenerator::New();
+		imgMaskGen->SetImageMask(m_US4DCroppedMultilabelMask);
+
+		mitk::ImageStatisticsCalculator::Pointer twoPassCalc = mitk::ImageStatisticsCalculator::New();
+		twoPassCalc->SetInputImage(m_US4DCroppedImage);
+		twoPassCalc->SetMask(imgMaskGen.GetPointer());
+
+		mitk::ImageStatisticsCalculator::Pointer singlePassCalc = mitk::ImageStatisticsCalculator::New();
+		singlePassCalc->SetInputImage(m_US4DCroppedImage);
+		singlePassCalc->SetMask(imgMaskGen.GetPointer());
+		singlePassCalc->SetUseSinglePassStatistics(true);
+
+		if (useBinSize)
+		{
+			twoPassCalc->SetBinSizeForHistogramStatistics(5);
+			singlePassCalc->SetBinSizeForHistogramStatistics(5);
+		}
+
+		for (unsigned short label : { 1, 2 })
+		{
+			mitk::ImageStatisticsContainer::Pointer expectedContainer;
+			mitk::ImageStatisticsContainer::Pointer singlePassContainer;
+			CPPUNIT_ASSERT_NO_THROW(expectedContainer = twoPassCalc->GetStatistics(label));
+			CPPUNIT_ASSERT_NO_THROW(singlePassContainer = singlePassCalc->GetStatistics(label));
+
+			for (unsigned int timeStep = 0; timeStep < m_US4DCroppedImage->GetTimeSteps(); ++timeStep)
+			{
+				auto expected = expectedContainer->GetStatisticsForTimeStep(timeStep);
+				auto singlePass = singlePassContainer->GetStatisticsForTimeStep(timeStep);
+
+				for (const auto &key : expected.GetExistingStatisticNames())
+				{
+					if (key == mitk::ImageStatisticsConstants::MINIMUMPOSITION() || key == mitk::ImageStatisticsConstants::MAXIMUMPOSITION())
+					{
+						auto expectedIndex = expected.GetValueConverted<mitk::ImageStatisticsContainer::IndexType>(key);
+						auto singlePassIndex = singlePass.GetValueConverted<mitk::ImageStatisticsContainer::IndexType>(key);
+						CPPUNIT_ASSERT_MESSAGE("Single pass " + key + " differs", expectedIndex == singlePassIndex);
+					}
+					else if (key == mitk::ImageStatisticsConstants::NUMBEROFVOXELS())
+					{
+						auto expectedCount = expected.GetValueConverted<mitk::ImageStatisticsContainer::VoxelCountType>(key);
+						auto singlePassCount = singlePass.GetValueConverted<mitk::ImageStatisticsContainer::VoxelCountType>(key);
+						CPPUNIT_ASSERT_MESSAGE("Single pass " + key + " differs", expectedCount == singlePassCount);
+					}
+					else
+					{
+						auto expectedValue = expected.GetValueConverted<mitk::ImageStatisticsContainer::RealType>(key);
+						auto singlePassValue = singlePass.GetValueConverted<mitk::ImageStatisticsContainer::RealType>(key);
+						CPPUNIT_ASSERT_MESSAGE("Single pass " + key + " differs",
+							(std::isnan(expectedValue) && std::isnan(singlePassValue)) || std::abs(expectedValue - singlePassValue) < mitk::eps);
+					}
+				}
+
+				CPPUNIT_ASSERT_MESSAGE("Single pass histogram differs", expected.m_Histogram->Size() == singlePass.m_Histogram->Size());
+				for (unsigned int bin = 0; bin < expected.m_Histogram->Size(); ++bin)
+				{
+					CPPUNIT_ASSERT_MESSAGE("Single pass histogram differs", expected.m_Histogram->GetFrequency(bin) == singlePass.m_Histogram->GetFrequency(bin));
+				}
+			}
+		}
+	}
+}
+
 void mitkImageStatisticsCalculatorTestSuite::VerifyStatistics(mitk::ImageStatisticsContainer::ImageStatisticsObject stats,
 	mitk::ImageStatisticsContainer::RealType testMean, mitk::ImageStatisticsContainer::RealType testSD, mitk::ImageStatisticsContainer::RealType testMedian)
 {
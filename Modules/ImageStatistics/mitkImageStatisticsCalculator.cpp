@@ -22,8 +22,11 @@ found in the LICENSE file.
 #include <mitkMaskUtilities.h>
 #include <mitkMinMaxImageFilterWithIndex.h>
 #include <mitkMinMaxLabelmageFilterWithIndex.h>
+#include <mitkSinglePassLabelStatisticsImageFilter.h>
 #include <mitkitkMaskImageFilter.h>
 
+#include <limits>
+
 namespace mitk
 {
   void ImageStatisticsCalculator::SetInputImage(const mitk::Image *image)
@@ -90,6 +93,17 @@ namespace mitk
 
   double ImageStatisticsCalculator::GetBinSizeForHistogramStatistics() const { return m_binSizeForHistogramStatistics; }
 
+  void ImageStatisticsCalculator::SetUseSinglePassStatistics(bool useSinglePass)
+  {
+    if (useSinglePass != m_UseSinglePassStatistics)
+    {
+      m_UseSinglePassStatistics = useSinglePass;
+      this->Modified();
+    }
+  }
+
+  bool ImageStatisticsCalculator::GetUseSinglePassStatistics() const { return m_UseSinglePassStatistics; }
+
   mitk::ImageStatisticsContainer* ImageStatisticsCalculator::GetStatistics(LabelIndex label)
   {
     if (m_Image.IsNull())
@@ -373,6 +387,21 @@ namespace mitk
 
     adaptedImage = maskUtil->ExtractMaskImageRegion(); // this also checks mask sanity
 
+    // value frequencies of floating point images are (nearly) unique per voxel, keep the two passes for them
+    if (m_UseSinglePassStatistics && std::numeric_limits<TPixel>::is_integer)
+    {
+      this->InternalCalculateStatisticsSinglePass<TPixel, VImageDimension>(
+        image, adaptedImage.GetPointer(), maskImage.GetPointer(), timeGeometry, timeStep);
+
+      // swap maskGenerators back
+      if (swapMasks)
+      {
+        m_SecondaryMask = m_InternalMask;
+        m_InternalMask = nullptr;
+      }
+      return;
+    }
+
     // find min, max, minindex and maxindex
     typename MinMaxLabelFilterType::Pointer minMaxFilter = MinMaxLabelFilterType::New();
     minMaxFilter->SetInput(adaptedImage);
@@ -470,8 +499,7 @@ namespace mitk
       assert(std::abs(minMaxFilter->GetMin(*it) - imageStatisticsFilter->GetMinimum(*it)) < mitk::eps);
 
       auto voxelVolume = GetVoxelVolume<TPixel, VImageDimension>(image);
-      auto numberOfVoxels =
-        static_cast<unsigned long>(imageStatisticsFilter->GetSum(*it) / (double)imageStatisticsFilter->GetMean(*it));
+      auto numberOfVoxels = static_cast<unsigned long>(imageStatisticsFilter->GetCount(*it));
       auto volume = static_cast<double>(numberOfVoxels) * voxelVolume;
       auto rms = std::sqrt(std::pow(imageStatisticsFilter->GetMean(*it), 2.) +
                            imageStatisticsFilter->GetVariance(*it)); // variance = sigma^2
@@ -506,6 +534,113 @@ namespace mitk
     }
   }
 
+  template <typename TPixel, unsigned int VImageDimension>
+  void ImageStatisticsCalculator::InternalCalculateStatisticsSinglePass(
+    typename itk::Image<TPixel, VImageDimension> *image,
+    const typename itk::Image<TPixel, VImageDimension> *adaptedImage,
+    const typename itk::Image<MaskPixelType, VImageDimension> *maskImage,
+    const TimeGeometry *timeGeometry,
+    unsigned int timeStep)
+  {
+    typedef itk::Image<TPixel, VImageDimension> ImageType;
+    typedef itk::Image<MaskPixelType, VImageDimension> MaskType;
+    typedef itk::SinglePassLabelStatisticsImageFilter<ImageType, MaskType> LabelStatisticsFilterType;
+
+    // min/max (with indices), moments and histograms of all labels in one pass
+    typename LabelStatisticsFilterType::Pointer statisticsFilter = LabelStatisticsFilterType::New();
+    statisticsFilter->SetDirectionTolerance(0.001);
+    statisticsFilter->SetCoordinateTolerance(0.001);
+    statisticsFilter->SetInput(adaptedImage);
+    statisticsFilter->SetLabelInput(maskImage);
+    if (m_UseBinSizeOverNBins)
+    {
+      statisticsFilter->SetHistogramBinSize(m_binSizeForHistogramStatistics);
+    }
+    else
+    {
+      statisticsFilter->SetHistogramNumberOfBins(m_nBinsForHistogramStatistics);
+    }
+
+    try
+    {
+      statisticsFilter->UpdateLargestPossibleRegion();
+    }
+    catch (const itk::ExceptionObject &e)
+    {
+      mitkThrow() << "Image statistics calculation failed due to following ITK Exception: \n " << e.what();
+    }
+
+    auto voxelVolume = GetVoxelVolume<TPixel, VImageDimension>(image);
+
+    for (auto label : statisticsFilter->GetRelevantLabels())
+    {
+      ImageStatisticsContainer::Pointer statisticContainerForLabelImage;
+      auto labelIt = m_StatisticContainers.find(label);
+      // reset if statisticContainer already exist
+      if (labelIt != m_StatisticContainers.end())
+      {
+        statisticContainerForLabelImage = labelIt->second;
+      }
+      // create new statisticContainer
+      else
+      {
+        statisticContainerForLabelImage = ImageStatisticsContainer::New();
+        statisticContainerForLabelImage->SetTimeGeometry(const_cast<mitk::TimeGeometry*>(timeGeometry));
+        m_StatisticContainers.emplace(label, statisticContainerForLabelImage);
+      }
+
+      const auto &labelStats = statisticsFilter->GetLabelStatistics(label);
+      ImageStatisticsContainer::ImageStatisticsObject statObj;
+
+      vnl_vector<int> minIndex, maxIndex;
+      mitk::Point3D worldCoordinateMin;
+      mitk::Point3D worldCoordinateMax;
+      mitk::Point3D indexCoordinateMin;
+      mitk::Point3D indexCoordinateMax;
+      m_InternalImageForStatistics->GetGeometry()->IndexToWorld(labelStats.m_MinimumIndex, worldCoordinateMin);
+      m_InternalImageForStatistics->GetGeometry()->IndexToWorld(labelStats.m_MaximumIndex, worldCoordinateMax);
+      m_Image->GetGeometry()->WorldToIndex(worldCoordinateMin, indexCoordinateMin);
+      m_Image->GetGeometry()->WorldToIndex(worldCoordinateMax, indexCoordinateMax);
+
+      minIndex.set_size(3);
+      maxIndex.set_size(3);
+      for (unsigned int i = 0; i < 3; i++)
+      {
+        minIndex[i] = indexCoordinateMin[i];
+        maxIndex[i] = indexCoordinateMax[i];
+      }
+
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::MINIMUMPOSITION(), minIndex);
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::MAXIMUMPOSITION(), maxIndex);
+
+      auto numberOfVoxels = static_cast<unsigned long>(labelStats.m_Count);
+      auto volume = static_cast<double>(numberOfVoxels) * voxelVolume;
+      auto rms = std::sqrt(std::pow(labelStats.m_Mean, 2.) + labelStats.m_Variance); // variance = sigma^2
+      auto variance = labelStats.m_Sigma * labelStats.m_Sigma;
+
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::NUMBEROFVOXELS(), numberOfVoxels);
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::VOLUME(), volume);
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::MEAN(), labelStats.m_Mean);
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::MINIMUM(),
+                           static_cast<ImageStatisticsContainer::RealType>(labelStats.m_Minimum));
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::MAXIMUM(),
+                           static_cast<ImageStatisticsContainer::RealType>(labelStats.m_Maximum));
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::STANDARDDEVIATION(), labelStats.m_Sigma);
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::VARIANCE(), variance);
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::SKEWNESS(), labelStats.m_Skewness);
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::KURTOSIS(), labelStats.m_Kurtosis);
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::RMS(), rms);
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::MPP(), labelStats.m_MPP);
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::ENTROPY(), labelStats.m_Entropy);
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::MEDIAN(), labelStats.m_Median);
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::UNIFORMITY(), labelStats.m_Uniformity);
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::UPP(), labelStats.m_UPP);
+      statObj.m_Histogram = labelStats.m_Histogram;
+
+      statisticContainerForLabelImage->SetStatisticsForTimeStep(timeStep, statObj);
+    }
+  }
+
   bool ImageStatisticsCalculator::IsUpdateRequired(LabelIndex label) const
   {
     unsigned long thisClassTimeStamp = this->GetMTime();
@@ -70,6 +70,14 @@ namespace mitk
         That solely depends on which parameter has been set last.*/
         double GetBinSizeForHistogramStatistics() const;
 
+        /**Documentation
+        @brief If enabled, the statistics (including the histograms) of all labels of the mask are computed in a single multi-threaded
+        pass over the voxels instead of a min/max pass followed by a statistics pass. The single pass is only used for images with
+        integral pixel types; floating point images are always computed with two passes. Default is false.*/
+        void SetUseSinglePassStatistics(bool useSinglePass);
+
+        bool GetUseSinglePassStatistics() const;
+
         /**Documentation
         @brief Returns the statistics for label @a label. If these requested statistics are not computed yet the computation is done as well.
         For performance reasons, statistics for all labels in the image are computed at once.
@@ -81,6 +89,7 @@ namespace mitk
             m_nBinsForHistogramStatistics = 100;
             m_binSizeForHistogramStatistics = 10;
             m_UseBinSizeOverNBins = false;
+            m_UseSinglePassStatistics = false;
         };
 
 
@@ -93,6 +102,12 @@ namespace mitk
                 typename itk::Image< TPixel, VImageDimension >* image, const TimeGeometry* timeGeometry,
                 unsigned int timeStep);
 
+        template < typename TPixel, unsigned int VImageDimension > void InternalCalculateStatisticsSinglePass(
+                typename itk::Image< TPixel, VImageDimension >* image,
+                const typename itk::Image< TPixel, VImageDimension >* adaptedImage,
+                const typename itk::Image< MaskPixelType, VImageDimension >* maskImage,
+                const TimeGeometry* timeGeometry, unsigned int timeStep);
+
         template < typename TPixel, unsigned int VImageDimension >
         double GetVoxelVolume(typename itk::Image<TPixel, VImageDimension>* image) const;
 
@@ -111,6 +126,7 @@ namespace mitk
         unsigned int m_nBinsForHistogramStatistics;
         double m_binSizeForHistogramStatistics;
         bool m_UseBinSizeOverNBins;
+        bool m_UseSinglePassStatistics;
 
         std::map<LabelIndex,ImageStatisticsContainer::Pointer> m_StatisticContainers;
     };
@@ -0,0 +1,156 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef MITK_SINGLEPASSLABELSTATISTICSIMAGEFILTER_H
+#define MITK_SINGLEPASSLABELSTATISTICSIMAGEFILTER_H
+
+#include <itkImage.h>
+#include <itkImageToImageFilter.h>
+#include <itkHistogram.h>
+
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+namespace itk
+{
+  /**
+  * \class SinglePassLabelStatisticsImageFilter
+  * \brief Computes the statistics of all labels of a label image in one multi-threaded pass over the voxels.
+  *
+  * In contrast to the combination of MinMaxLabelImageFilterWithIndex and ExtendedLabelStatisticsImageFilter
+  * (which needs the label extrema before the histograms can be set up), every thread collects per label the
+  * moments, the extrema with their indices and the frequency of each distinct pixel value. The per-thread
+  * accumulators are merged after the pass and the histograms are built from the value frequencies, using
+  * the per-label extrema as bounds. The histograms are therefore identical to the ones of the two-pass approach.
+  *
+  * The value frequency tables are bounded by the number of distinct values per label. This is cheap for integral
+  * pixel types but may approach the number of voxels for floating point images.
+  *
+  * The input is passed through as output.
+  */
+  template <typename TInputImage, typename TLabelImage>
+  class SinglePassLabelStatisticsImageFilter : public ImageToImageFilter<TInputImage, TInputImage>
+  {
+  public:
+    typedef SinglePassLabelStatisticsImageFilter Self;
+    typedef ImageToImageFilter<TInputImage, TInputImage> Superclass;
+    typedef SmartPointer<Self> Pointer;
+    typedef SmartPointer<const Self> ConstPointer;
+
+    itkNewMacro(Self);
+    itkTypeMacro(SinglePassLabelStatisticsImageFilter, ImageToImageFilter);
+
+    typedef typename TInputImage::RegionType RegionType;
+    typedef typename TInputImage::IndexType IndexType;
+    typedef typename TInputImage::PixelType PixelType;
+    typedef typename NumericTraits<PixelType>::RealType RealType;
+    typedef typename TLabelImage::PixelType LabelPixelType;
+    typedef itk::Statistics::Histogram<double> HistogramType;
+
+    /** \brief Final statistics of one label. */
+    class LabelStatistics
+    {
+    public:
+      SizeValueType m_Count = 0;
+      SizeValueType m_PositivePixelCount = 0;
+      RealType m_Sum = 0;
+      RealType m_SumOfPositivePixels = 0;
+      RealType m_SumOfSquares = 0;
+      RealType m_SumOfCubes = 0;
+      RealType m_SumOfQuadruples = 0;
+
+      PixelType m_Minimum = NumericTraits<PixelType>::max();
+      PixelType m_Maximum = NumericTraits<PixelType>::NonpositiveMin();
+      IndexType m_MinimumIndex;
+      IndexType m_MaximumIndex;
+
+      RealType m_Mean = 0;
+      RealType m_Sigma = 0;
+      RealType m_Variance = 0;
+      RealType m_Skewness = 0;
+      RealType m_Kurtosis = 0;
+      RealType m_MPP = 0;
+      RealType m_Median = 0;
+      RealType m_Entropy = 0;
+      RealType m_Uniformity = 0;
+      RealType m_UPP = 0;
+
+      HistogramType::Pointer m_Histogram;
+
+      /** Number of voxels per distinct pixel value, only valid during the update. */
+      std::unordered_map<PixelType, SizeValueType> m_ValueFrequencies;
+    };
+
+    typedef std::map<LabelPixelType, LabelStatistics> StatisticsMapType;
+
+    /** Set the label image */
+    void SetLabelInput(const TLabelImage *input)
+    {
+      // Process object is not const-correct so the const casting is required.
+      this->SetNthInput(1, const_cast<TLabelImage *>(input));
+    }
+
+    /** Get the label image */
+    const TLabelImage *GetLabelInput() const
+    {
+      return itkDynamicCastInDebugMode<TLabelImage *>(const_cast<DataObject *>(this->ProcessObject::GetInput(1)));
+    }
+
+    /** Use a fixed number of bins for the histogram of every label. This is the default (100 bins). */
+    void SetHistogramNumberOfBins(unsigned int numberOfBins);
+
+    /** Derive the number of bins of each label histogram from its value range (at least 10 bins). */
+    void SetHistogramBinSize(double binSize);
+
+    /** Returns all labels that occur in the label image (within the input region). */
+    std::vector<LabelPixelType> GetRelevantLabels() const;
+
+    bool HasLabel(LabelPixelType label) const { return m_LabelStatistics.find(label) != m_LabelStatistics.end(); }
+
+    /** Returns the statistics of @a label. Throws an itk::ExceptionObject for labels that do not occur. */
+    const LabelStatistics &GetLabelStatistics(LabelPixelType label) const;
+
+  protected:
+    SinglePassLabelStatisticsImageFilter();
+    ~SinglePassLabelStatisticsImageFilter() override {}
+
+    void AllocateOutputs() override;
+
+    void BeforeThreadedGenerateData() override;
+
+    void ThreadedGenerateData(const RegionType &outputRegionForThread, ThreadIdType threadId) override;
+
+    void AfterThreadedGenerateData() override;
+
+  private:
+    SinglePassLabelStatisticsImageFilter(const Self &) = delete;
+    void operator=(const Self &) = delete;
+
+    void MergeLabelStatistics(LabelStatistics &target, const LabelStatistics &source) const;
+
+    unsigned int GetNumberOfBins(const LabelStatistics &labelStats) const;
+
+    void ComputeFinalStatistics(LabelStatistics &labelStats) const;
+
+    std::vector<StatisticsMapType> m_LabelStatisticsPerThread;
+    StatisticsMapType m_LabelStatistics;
+
+    unsigned int m_HistogramNumberOfBins;
+    double m_HistogramBinSize;
+    bool m_UseHistogramBinSize;
+  };
+}
+
+#include "mitkSinglePassLabelStatisticsImageFilter.hxx"
+
+#endif
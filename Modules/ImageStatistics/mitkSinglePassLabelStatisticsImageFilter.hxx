@@ -0,0 +1,290 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef MITK_SINGLEPASSLABELSTATISTICSIMAGEFILTER_HXX
+#define MITK_SINGLEPASSLABELSTATISTICSIMAGEFILTER_HXX
+
+#include <mitkSinglePassLabelStatisticsImageFilter.h>
+
+#include <itkImageScanlineConstIterator.h>
+#include <itkProgressReporter.h>
+#include <mitkHistogramStatisticsCalculator.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace itk
+{
+  template <typename TInputImage, typename TLabelImage>
+  SinglePassLabelStatisticsImageFilter<TInputImage, TLabelImage>::SinglePassLabelStatisticsImageFilter()
+    : m_HistogramNumberOfBins(100), m_HistogramBinSize(10.), m_UseHistogramBinSize(false)
+  {
+    this->SetNumberOfRequiredInputs(2);
+  }
+
+  template <typename TInputImage, typename TLabelImage>
+  void SinglePassLabelStatisticsImageFilter<TInputImage, TLabelImage>::SetHistogramNumberOfBins(
+    unsigned int numberOfBins)
+  {
+    m_HistogramNumberOfBins = numberOfBins;
+    m_UseHistogramBinSize = false;
+    this->Modified();
+  }
+
+  template <typename TInputImage, typename TLabelImage>
+  void SinglePassLabelStatisticsImageFilter<TInputImage, TLabelImage>::SetHistogramBinSize(double binSize)
+  {
+    m_HistogramBinSize = binSize;
+    m_UseHistogramBinSize = true;
+    this->Modified();
+  }
+
+  template <typename TInputImage, typename TLabelImage>
+  std::vector<typename SinglePassLabelStatisticsImageFilter<TInputImage, TLabelImage>::LabelPixelType>
+    SinglePassLabelStatisticsImageFilter<TInputImage, TLabelImage>::GetRelevantLabels() const
+  {
+    std::vector<LabelPixelType> labels;
+    labels.reserve(m_LabelStatistics.size());
+    for (const auto &labelStats : m_LabelStatistics)
+    {
+      labels.push_back(labelStats.first);
+    }
+    return labels;
+  }
+
+  template <typename TInputImage, typename TLabelImage>
+  const typename SinglePassLabelStatisticsImageFilter<TInputImage, TLabelImage>::LabelStatistics &
+    SinglePassLabelStatisticsImageFilter<TInputImage, TLabelImage>::GetLabelStatistics(LabelPixelType label) const
+  {
+    auto mapIt = m_LabelStatistics.find(label);
+    if (mapIt == m_LabelStatistics.end())
+    {
+      itkExceptionMacro(<< "Label " << static_cast<double>(label) << " does not exist in the label image.");
+    }
+    return mapIt->second;
+  }
+
+  template <typename TInputImage, typename TLabelImage>
+  void SinglePassLabelStatisticsImageFilter<TInputImage, TLabelImage>::AllocateOutputs()
+  {
+    // Pass the input through as the output
+    typename TInputImage::Pointer image = const_cast<TInputImage *>(this->GetInput());
+
+    this->GraftOutput(image);
+
+    // Nothing that needs to be allocated for the remaining outputs
+  }
+
+  template <typename TInputImage, typename TLabelImage>
+  void SinglePassLabelStatisticsImageFilter<TInputImage, TLabelImage>::BeforeThreadedGenerateData()
+  {
+    m_LabelStatisticsPerThread.clear();
+    m_LabelStatisticsPerThread.resize(this->GetNumberOfThreads());
+    m_LabelStatistics.clear();
+  }
+
+  template <typename TInputImage, typename TLabelImage>
+  void SinglePassLabelStatisticsImageFilter<TInputImage, TLabelImage>::ThreadedGenerateData(
+    const RegionType &outputRegionForThread, ThreadIdType threadId)
+  {
+    const SizeValueType size0 = outputRegionForThread.GetSize(0);
+    if (size0 == 0)
+    {
+      return;
+    }
+
+    ImageScanlineConstIterator<TInputImage> it(this->GetInput(), outputRegionForThread);
+    ImageScanlineConstIterator<TLabelImage> labelIt(this->GetLabelInput(), outputRegionForThread);
+
+    StatisticsMapType &threadStatistics = m_LabelStatisticsPerThread[threadId];
+
+    // labels are spatially coherent, so the accumulator of the previous voxel is usually the right one
+    LabelPixelType currentLabel = labelIt.Get();
+    LabelStatistics *labelStats = &threadStatistics[currentLabel];
+
+    ProgressReporter progress(this, threadId, outputRegionForThread.GetNumberOfPixels() / size0);
+
+    while (!it.IsAtEnd())
+    {
+      while (!it.IsAtEndOfLine())
+      {
+        const LabelPixelType label = labelIt.Get();
+        if (label != currentLabel)
+        {
+          currentLabel = label;
+          labelStats = &threadStatistics[currentLabel];
+        }
+
+        const PixelType pixel = it.Get();
+        const RealType value = static_cast<RealType>(pixel);
+        const RealType squaredValue = value * value;
+
+        if (pixel < labelStats->m_Minimum)
+        {
+          labelStats->m_Minimum = pixel;
+          labelStats->m_MinimumIndex = it.ComputeIndex();
+        }
+        if (pixel > labelStats->m_Maximum)
+        {
+          labelStats->m_Maximum = pixel;
+          labelStats->m_MaximumIndex = it.ComputeIndex();
+        }
+
+        labelStats->m_Count++;
+        labelStats->m_Sum += value;
+        labelStats->m_SumOfSquares += squaredValue;
+        labelStats->m_SumOfCubes += squaredValue * value;
+        labelStats->m_SumOfQuadruples += squaredValue * squaredValue;
+
+        if (value > 0)
+        {
+          labelStats->m_PositivePixelCount++;
+          labelStats->m_SumOfPositivePixels += value;
+        }
+
+        labelStats->m_ValueFrequencies[pixel]++;
+
+        ++it;
+        ++labelIt;
+      }
+      it.NextLine();
+      labelIt.NextLine();
+      progress.CompletedPixel();
+    }
+  }
+
+  template <typename TInputImage, typename TLabelImage>
+  void SinglePassLabelStatisticsImageFilter<TInputImage, TLabelImage>::MergeLabelStatistics(
+    LabelStatistics &target, const LabelStatistics &source) const
+  {
+    target.m_Count += source.m_Count;
+    target.m_PositivePixelCount += source.m_PositivePixelCount;
+    target.m_Sum += source.m_Sum;
+    target.m_SumOfPositivePixels += source.m_SumOfPositivePixels;
+    target.m_SumOfSquares += source.m_SumOfSquares;
+    target.m_SumOfCubes += source.m_SumOfCubes;
+    target.m_SumOfQuadruples += source.m_SumOfQuadruples;
+
+    // threads are merged in region order, so ties resolve to the first voxel like in MinMaxLabelImageFilterWithIndex
+    if (source.m_Minimum < target.m_Minimum)
+    {
+      target.m_Minimum = source.m_Minimum;
+      target.m_MinimumIndex = source.m_MinimumIndex;
+    }
+    if (source.m_Maximum > target.m_Maximum)
+    {
+      target.m_Maximum = source.m_Maximum;
+      target.m_MaximumIndex = source.m_MaximumIndex;
+    }
+
+    for (const auto &frequency : source.m_ValueFrequencies)
+    {
+      target.m_ValueFrequencies[frequency.first] += frequency.second;
+    }
+  }
+
+  template <typename TInputImage, typename TLabelImage>
+  unsigned int SinglePassLabelStatisticsImageFilter<TInputImage, TLabelImage>::GetNumberOfBins(
+    const LabelStatistics &labelStats) const
+  {
+    if (m_UseHistogramBinSize)
+    {
+      // same rule as in mitk::ImageStatisticsCalculator: do not allow less than 10 bins
+      const double range = static_cast<double>(labelStats.m_Maximum) - static_cast<double>(labelStats.m_Minimum);
+      return static_cast<unsigned int>(std::max(std::ceil(range) / m_HistogramBinSize, 10.));
+    }
+    return m_HistogramNumberOfBins;
+  }
+
+  template <typename TInputImage, typename TLabelImage>
+  void SinglePassLabelStatisticsImageFilter<TInputImage, TLabelImage>::ComputeFinalStatistics(
+    LabelStatistics &labelStats) const
+  {
+    const RealType count = static_cast<RealType>(labelStats.m_Count);
+
+    labelStats.m_Mean = labelStats.m_Sum / count;
+    labelStats.m_MPP = labelStats.m_SumOfPositivePixels / static_cast<RealType>(labelStats.m_PositivePixelCount);
+
+    // moments, see ExtendedLabelStatisticsImageFilter
+    labelStats.m_Variance = (labelStats.m_SumOfSquares - labelStats.m_Sum * labelStats.m_Sum / count) / count;
+
+    const RealType secondMoment = labelStats.m_SumOfSquares / count;
+    const RealType thirdMoment = labelStats.m_SumOfCubes / count;
+    const RealType fourthMoment = labelStats.m_SumOfQuadruples / count;
+    const RealType mean = labelStats.m_Mean;
+
+    labelStats.m_Skewness = (thirdMoment - 3. * secondMoment * mean + 2. * std::pow(mean, 3.)) /
+                            std::pow(secondMoment - std::pow(mean, 2.), 1.5);
+    labelStats.m_Kurtosis = (fourthMoment - 4. * thirdMoment * mean + 6. * secondMoment * std::pow(mean, 2.) -
+                             3. * std::pow(mean, 4.)) /
+                            std::pow(secondMoment - std::pow(mean, 2.), 2.);
+    labelStats.m_Sigma = std::sqrt(labelStats.m_Variance);
+
+    // histogram with the label extrema as bounds, filled from the value frequencies
+    HistogramType::SizeType histogramSize(1);
+    HistogramType::MeasurementVectorType lowerBound(1);
+    HistogramType::MeasurementVectorType upperBound(1);
+    histogramSize[0] = this->GetNumberOfBins(labelStats);
+    lowerBound[0] = static_cast<RealType>(labelStats.m_Minimum);
+    upperBound[0] = static_cast<RealType>(labelStats.m_Maximum);
+
+    labelStats.m_Histogram = HistogramType::New();
+    labelStats.m_Histogram->SetMeasurementVectorSize(1);
+    labelStats.m_Histogram->Initialize(histogramSize, lowerBound, upperBound);
+
+    HistogramType::IndexType histogramIndex(1);
+    HistogramType::MeasurementVectorType histogramMeasurement(1);
+    for (const auto &frequency : labelStats.m_ValueFrequencies)
+    {
+      histogramMeasurement[0] = static_cast<RealType>(frequency.first);
+      labelStats.m_Histogram->GetIndex(histogramMeasurement, histogramIndex);
+      labelStats.m_Histogram->IncreaseFrequencyOfIndex(histogramIndex, frequency.second);
+    }
+    labelStats.m_ValueFrequencies.clear();
+
+    mitk::HistogramStatisticsCalculator histStatCalc;
+    histStatCalc.SetHistogram(labelStats.m_Histogram);
+    histStatCalc.CalculateStatistics();
+    labelStats.m_Median = histStatCalc.GetMedian();
+    labelStats.m_Entropy = histStatCalc.GetEntropy();
+    labelStats.m_Uniformity = histStatCalc.GetUniformity();
+    labelStats.m_UPP = histStatCalc.GetUPP();
+  }
+
+  template <typename TInputImage, typename TLabelImage>
+  void SinglePassLabelStatisticsImageFilter<TInputImage, TLabelImage>::AfterThreadedGenerateData()
+  {
+    for (auto &threadStatistics : m_LabelStatisticsPerThread)
+    {
+      for (auto &threadLabelStats : threadStatistics)
+      {
+        auto mapIt = m_LabelStatistics.find(threadLabelStats.first);
+        if (mapIt == m_LabelStatistics.end())
+        {
+          m_LabelStatistics.emplace(threadLabelStats.first, std::move(threadLabelStats.second));
+        }
+        else
+        {
+          this->MergeLabelStatistics(mapIt->second, threadLabelStats.second);
+        }
+      }
+    }
+    m_LabelStatisticsPerThread.clear();
+
+    for (auto &labelStats : m_LabelStatistics)
+    {
+      this->ComputeFinalStatistics(labelStats.second);
+    }
+  }
+}
+
+#endif
@@ -39,6 +39,7 @@ set(CPP_FILES
   Functors/mitkSVModelFitCostFunction.cpp
   Functors/mitkModelFitFunctorBase.cpp
   Functors/mitkLevenbergMarquardtModelFitFunctor.cpp
+  Functors/mitkBatchedLevenbergMarquardtModelFitFunctor.cpp
   Functors/mitkDummyModelFitFunctor.cpp
   Functors/mitkModelFitInfoSignalGenerationFunctor.cpp
   Functors/mitkIndexedValueFunctorPolicy.cpp
@@ -63,6 +64,7 @@ set(CPP_FILES
 
 set(TPP_FILES
     include/itkMultiOutputNaryFunctorImageFilter.tpp
+    include/itkMultiOutputNaryBatchFunctorImageFilter.tpp
     include/itkMaskedStatisticsImageFilter.hxx
     include/itkMaskedNaryStatisticsImageFilter.hxx
 	include/mitkModelFitProviderBase.tpp
@@ -0,0 +1,81 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef __itkMultiOutputNaryBatchFunctorImageFilter_h
+#define __itkMultiOutputNaryBatchFunctorImageFilter_h
+
+#include "itkMultiOutputNaryFunctorImageFilter.h"
+
+namespace itk
+{
+/** \class MultiOutputNaryBatchFunctorImageFilter
+ * \brief Variant of MultiOutputNaryFunctorImageFilter that passes the value vectors of several pixels
+ * to the functor at once.
+ *
+ * Each thread collects up to BatchSize (unmasked) pixels of its region and calls
+ * m_Functor.ComputeBatch(values, indices, results) for them. values and results are passed in
+ * structure of arrays layout, i.e. value i of pixel p is values[i*indices.size()+p] and output o
+ * of pixel p is results[o*indices.size()+p]. The buffers are allocated once per thread.
+ * Pixels outside the mask are set to 0 like in the superclass.
+ *
+ * \ingroup IntensityImageFilters MultiThreaded
+ * \ingroup ITKImageIntensity
+ */
+
+template< class TInputImage, class TOutputImage, class TFunction, class TMaskImage = ::itk::Image<unsigned char, TInputImage::ImageDimension> >
+class ITK_EXPORT MultiOutputNaryBatchFunctorImageFilter:
+  public MultiOutputNaryFunctorImageFilter< TInputImage, TOutputImage, TFunction, TMaskImage >
+
+{
+public:
+  /** Standard class typedefs. */
+  typedef MultiOutputNaryBatchFunctorImageFilter                                            Self;
+  typedef MultiOutputNaryFunctorImageFilter< TInputImage, TOutputImage, TFunction, TMaskImage > Superclass;
+  typedef SmartPointer< Self >                            Pointer;
+  typedef SmartPointer< const Self >                      ConstPointer;
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(MultiOutputNaryBatchFunctorImageFilter, MultiOutputNaryFunctorImageFilter);
+
+  typedef typename Superclass::InputImageType         InputImageType;
+  typedef typename Superclass::OutputImageType        OutputImageType;
+  typedef typename Superclass::OutputImageRegionType  OutputImageRegionType;
+  typedef typename Superclass::NaryInputArrayType     NaryInputArrayType;
+  typedef typename Superclass::NaryOutputArrayType    NaryOutputArrayType;
+  typedef typename Superclass::MaskImageType          MaskImageType;
+
+  /** Maximum number of pixels that are passed to the functor at once.*/
+  itkSetMacro(BatchSize, unsigned int);
+  itkGetConstMacro(BatchSize, unsigned int);
+
+protected:
+  MultiOutputNaryBatchFunctorImageFilter();
+  ~MultiOutputNaryBatchFunctorImageFilter() override {}
+
+  void ThreadedGenerateData(const OutputImageRegionType & outputRegionForThread,
+                            ThreadIdType threadId) override;
+
+private:
+  MultiOutputNaryBatchFunctorImageFilter(const Self &); //purposely not implemented
+  void operator=(const Self &);         //purposely not implemented
+
+  unsigned int m_BatchSize;
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#include "itkMultiOutputNaryBatchFunctorImageFilter.tpp"
+#endif
+
+#endif
@@ -0,0 +1,162 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef __itkMultiOutputNaryBatchFunctorImageFilter_hxx
+#define __itkMultiOutputNaryBatchFunctorImageFilter_hxx
+
+#include "itkMultiOutputNaryBatchFunctorImageFilter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkProgressReporter.h"
+
+#include <vector>
+
+namespace itk
+{
+  /**
+  * Constructor
+  */
+  template< class TInputImage, class TOutputImage, class TFunction, class TMaskImage >
+  MultiOutputNaryBatchFunctorImageFilter< TInputImage, TOutputImage, TFunction, TMaskImage >
+    ::MultiOutputNaryBatchFunctorImageFilter() : m_BatchSize(64)
+  {
+  }
+
+  template< class TInputImage, class TOutputImage, class TFunction, class TMaskImage >
+  void
+    MultiOutputNaryBatchFunctorImageFilter< TInputImage, TOutputImage, TFunction, TMaskImage >
+    ::ThreadedGenerateData(const OutputImageRegionType & outputRegionForThread,
+    ThreadIdType threadId)
+  {
+    ProgressReporter progress( this, threadId,
+      outputRegionForThread.GetNumberOfPixels() );
+
+    std::vector< const TInputImage * > inputs;
+    for ( unsigned int i = 0; i < this->GetNumberOfIndexedInputs(); ++i )
+    {
+      const TInputImage * inputPtr = dynamic_cast< const TInputImage * >( ProcessObject::GetInput(i) );
+      if ( inputPtr )
+      {
+        inputs.push_back(inputPtr);
+      }
+    }
+
+    std::vector< TOutputImage * > outputs;
+    for ( unsigned int i = 0; i < this->GetNumberOfIndexedOutputs(); ++i )
+    {
+      TOutputImage * outputPtr = dynamic_cast< TOutputImage * >( ProcessObject::GetOutput(i) );
+      if ( outputPtr )
+      {
+        outputs.push_back(outputPtr);
+      }
+    }
+
+    if ( inputs.empty() || outputs.empty() )
+    {
+      return;
+    }
+
+    const MaskImageType * mask = this->GetMask();
+    if (mask && !mask->GetLargestPossibleRegion().IsInside(outputRegionForThread))
+    {
+      itkExceptionMacro("Mask of filter is set but does not cover region of thread. Mask region: "<< mask->GetLargestPossibleRegion() <<"Thread region: "<<outputRegionForThread)
+    }
+
+    const unsigned int batchSize = m_BatchSize > 0 ? m_BatchSize : 1;
+    const unsigned int numberOfInputs = inputs.size();
+    const unsigned int numberOfOutputs = outputs.size();
+
+    typedef typename InputImageType::IndexType IndexType;
+    std::vector< IndexType > indices;
+    indices.reserve(batchSize);
+    NaryInputArrayType values;
+    values.reserve(numberOfInputs * batchSize);
+    NaryOutputArrayType results;
+    results.reserve(numberOfOutputs * batchSize);
+
+    auto processBatch = [&]()
+    {
+      const unsigned int numberOfPixels = indices.size();
+      values.resize(numberOfInputs * numberOfPixels);
+      results.resize(numberOfOutputs * numberOfPixels);
+
+      for ( unsigned int i = 0; i < numberOfInputs; ++i )
+      {
+        for ( unsigned int p = 0; p < numberOfPixels; ++p )
+        {
+          values[i * numberOfPixels + p] = inputs[i]->GetPixel(indices[p]);
+        }
+      }
+
+      this->GetFunctor().ComputeBatch(values, indices, results);
+
+      for ( unsigned int o = 0; o < numberOfOutputs; ++o )
+      {
+        for ( unsigned int p = 0; p < numberOfPixels; ++p )
+        {
+          outputs[o]->SetPixel(indices[p], results[o * numberOfPixels + p]);
+        }
+      }
+
+      for ( unsigned int p = 0; p < numberOfPixels; ++p )
+      {
+        progress.CompletedPixel();
+      }
+      indices.clear();
+    };
+
+    typedef ImageRegionConstIteratorWithIndex< TInputImage > IndexIteratorType;
+    typedef ImageRegionConstIterator< TMaskImage > MaskImageRegionIteratorType;
+
+    IndexIteratorType indexIterator(inputs.front(), outputRegionForThread);
+    MaskImageRegionIteratorType maskIterator;
+    if (mask)
+    {
+      maskIterator = MaskImageRegionIteratorType(mask, outputRegionForThread);
+    }
+
+    for ( ; !indexIterator.IsAtEnd(); ++indexIterator )
+    {
+      bool isValid = true;
+
+      if (mask)
+      {
+        isValid = maskIterator.Get() > 0;
+        ++maskIterator;
+      }
+
+      if (isValid)
+      {
+        indices.push_back(indexIterator.GetIndex());
+        if (indices.size() == batchSize)
+        {
+          processBatch();
+        }
+      }
+      else
+      {
+        for ( auto output : outputs )
+        {
+          output->SetPixel(indexIterator.GetIndex(), 0.0);
+        }
+        progress.CompletedPixel();
+      }
+    }
+
+    if (!indices.empty())
+    {
+      processBatch();
+    }
+  }
+} // end namespace itk
+
+#endif
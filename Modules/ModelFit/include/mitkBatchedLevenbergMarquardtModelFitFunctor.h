@@ -0,0 +1,120 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef BATCHEDLEVENBERGMARQUARDTMODELFITFUNCTOR_H
+#define BATCHEDLEVENBERGMARQUARDTMODELFITFUNCTOR_H
+
+#include <itkObject.h>
+
+#include "mitkModelBase.h"
+#include "mitkModelFitFunctorBase.h"
+#include "mitkConstraintCheckerBase.h"
+
+#include "MitkModelFitExports.h"
+
+namespace mitk
+{
+
+  /** Fit functor that fits several signals at once with the Levenberg-Marquardt algorithm.
+   * In contrast to LevenbergMarquardtModelFitFunctor, which uses one itk::LevenbergMarquardtOptimizer per signal,
+   * all signals of a batch (see ComputeBatch()) are iterated in lock step. Thus the model is evaluated for all
+   * signals of an iteration with one call of ModelBase::GetSignalBatch() (including the parameter sets needed
+   * for the central difference Jacobians), and all working memory is allocated once per batch.
+   * Signals that have converged are excluded from the following model evaluations.
+   * The functor minimizes the sum of squared differences, which is also returned as criterion.
+   * If a constraint checker is set, its penalty is added to the cost of each step and steps that reach the
+   * failure threshold of the checker are rejected.*/
+  class MITKMODELFIT_EXPORT BatchedLevenbergMarquardtModelFitFunctor : public ModelFitFunctorBase
+  {
+  public:
+    typedef BatchedLevenbergMarquardtModelFitFunctor Self;
+    typedef ModelFitFunctorBase Superclass;
+    typedef itk::SmartPointer< Self >                            Pointer;
+    typedef itk::SmartPointer< const Self >                      ConstPointer;
+
+    itkNewMacro(Self);
+    itkTypeMacro(BatchedLevenbergMarquardtModelFitFunctor, ModelFitFunctorBase);
+
+    typedef Superclass::InputPixelArrayType InputPixelArrayType;
+    typedef Superclass::OutputPixelArrayType OutputPixelArrayType;
+
+    /** Fit stops if the relative norm of an accepted step is below this tolerance.*/
+    itkSetMacro(StepTolerance, double);
+    itkGetConstMacro(StepTolerance, double);
+    /** Fit stops if the cosine between the residual and every column of the Jacobian is below this tolerance.*/
+    itkSetMacro(GradientTolerance, double);
+    itkGetConstMacro(GradientTolerance, double);
+    /** Fit stops if the relative reduction of the cost by an accepted step is below this tolerance.*/
+    itkSetMacro(ValueTolerance, double);
+    itkGetConstMacro(ValueTolerance, double);
+    itkSetMacro(DerivativeStepLength, double);
+    itkGetConstMacro(DerivativeStepLength, double);
+    /** Maximum number of steps (accepted or rejected) per signal.*/
+    itkSetMacro(Iterations, unsigned int);
+    itkGetConstMacro(Iterations, unsigned int);
+
+    itkSetConstObjectMacro(ConstraintChecker, ConstraintCheckerBase);
+    itkGetConstObjectMacro(ConstraintChecker, ConstraintCheckerBase);
+    itkSetMacro(ActivateFailureThreshold, bool);
+    itkGetConstMacro(ActivateFailureThreshold, bool);
+
+    ParameterNamesType GetCriterionNames() const override;
+
+    void ComputeBatch(const ParameterImagePixelType* values, unsigned int numberOfValues,
+                      unsigned int numberOfSignals, const ModelBase* model,
+                      const ParameterImagePixelType* initialParameters,
+                      ParameterImagePixelType* results) const override;
+
+  protected:
+
+    typedef Superclass::ParametersType ParametersType;
+    typedef Superclass::SignalType SignalType;
+
+    BatchedLevenbergMarquardtModelFitFunctor();
+
+    ~BatchedLevenbergMarquardtModelFitFunctor() override;
+
+    ParametersType DoModelFit(const SignalType& value, const ModelBase* model,
+                              const ModelBase::ParametersType& initialParameters,
+                              DebugParameterMapType& debugParameters) const override;
+
+    OutputPixelArrayType GetCriteria(const ModelBase* model, const ParametersType& parameters,
+        const SignalType& sample) const override;
+
+    ParameterNamesType DefineDebugParameterNames() const override;
+
+    /** Fits all signals of the batch. values, initialParameters and parameters use the layout of ComputeBatch().
+     * @param [out] parameters Fitted parameters of all signals.
+     * @param [out] sumsOfSquaredDifferences Final criterion of every signal.
+     * @param [out] iterations Number of steps done for every signal.*/
+    void FitBatch(const ParameterImagePixelType* values, unsigned int numberOfValues,
+                  unsigned int numberOfSignals, const ModelBase* model,
+                  const ParameterImagePixelType* initialParameters, ParameterImagePixelType* parameters,
+                  ParameterImagePixelType* sumsOfSquaredDifferences, unsigned int* iterations) const;
+
+  private:
+    double m_StepTolerance;
+    double m_GradientTolerance;
+    double m_ValueTolerance;
+    unsigned int m_Iterations;
+    double m_DerivativeStepLength;
+
+    ConstraintCheckerBase::ConstPointer m_ConstraintChecker;
+    /**If set to true and an constraint checker is set, steps that reach the failure threshold of the checker are
+     rejected.*/
+    bool m_ActivateFailureThreshold;
+  };
+
+}
+
+
+#endif // BATCHEDLEVENBERGMARQUARDTMODELFITFUNCTOR_H
@@ -168,10 +168,25 @@ namespace mitk
 
     ModelResultType GetSignal(const ParametersType& parameters) const;
 
+    /** Computes the signals of several parameter sets at once. Parameters and signals are passed in
+     * structure of arrays layout: parameter p of set s is parameters[p*numberOfSets+s] and the signal value
+     * of set s at time point t is signals[t*numberOfSets+s]. Thus the values of all sets are contiguous for
+     * each parameter and time point, which allows models to evaluate the sets in vectorized loops.
+     * @pre parameters must contain GetNumberOfParameters()*numberOfSets values.
+     * @pre signals must have room for GetTimeGrid().GetSize()*numberOfSets values.*/
+    void GetSignalBatch(const ParameterValueType* parameters, unsigned int numberOfSets,
+                        ModelResultType::ValueType* signals) const;
+
   protected:
 
     virtual ModelResultType ComputeModelfunction(const ParametersType& parameters) const = 0;
 
+    /** Member is called by GetSignalBatch() to compute the signals of all passed parameter sets.
+     * The default implementation calls ComputeModelfunction() for every set. Reimplement it in derived
+     * classes to compute the signals of all sets together (see GetSignalBatch() for the data layout).*/
+    virtual void ComputeModelfunctionBatch(const ParameterValueType* parameters, unsigned int numberOfSets,
+                                           ModelResultType::ValueType* signals) const;
+
     /** Member is called by GetSignal() before ComputeModelfunction(). It indicates if model is in a valid state and
      * ready to compute the signal. The default implementation checks nothing and always returns true.
      * Reimplement to realize special behavior for derived classes.
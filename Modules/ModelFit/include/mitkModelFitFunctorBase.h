@@ -54,6 +54,26 @@ namespace mitk
     OutputPixelArrayType Compute(const InputPixelArrayType& value, const ModelBase* model,
                                  const ModelBase::ParametersType& initialParameters) const;
 
+    /** Fits the passed model onto several signals at once and stores the values of every signal in the
+     * sequence of Compute(). All arrays are passed in structure of arrays layout:
+     * - value t of signal s is values[t*numberOfSignals+s]
+     * - initial parameter p of signal s is initialParameters[p*numberOfSignals+s]
+     * - output o of signal s is results[o*numberOfSignals+s]
+     * .
+     * The default implementation calls Compute() for every signal. Reimplement it in derived classes that are able
+     * to fit several signals together (e.g. BatchedLevenbergMarquardtModelFitFunctor).
+     * @param values Signals the model should be fitted onto
+     * @param numberOfValues Number of values of each signal
+     * @param numberOfSignals Number of signals
+     * @param model Pointer to the preconfigured/ready to use model instance, that is used for all signals.
+     * @param initialParameters Starting points of the fitting processes.
+     * @param [out] results Must have room for GetNumberOfOutputs(model)*numberOfSignals values.
+     * @pre model must point to a valid instance.*/
+    virtual void ComputeBatch(const ParameterImagePixelType* values, unsigned int numberOfValues,
+                              unsigned int numberOfSignals, const ModelBase* model,
+                              const ParameterImagePixelType* initialParameters,
+                              ParameterImagePixelType* results) const;
+
     /** Returns the number of outputs the fit functor will return if compute is called.
      * The number depends in parts on the passed model.
      * @exception Exception will be thrown if no valid model is passed.*/
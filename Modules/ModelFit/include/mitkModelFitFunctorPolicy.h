@@ -14,6 +14,8 @@ found in the LICENSE file.
 #define MODELFITFUNCTOR_POLICY_H
 
 #include "itkIndex.h"
+#include <algorithm>
+#include <vector>
 #include "mitkModelFitFunctorBase.h"
 #include "MitkModelFitExports.h"
 
@@ -105,6 +107,73 @@ namespace mitk
       return result;
     }
 
+    /** Fits the voxels at the passed indices at once (see ModelFitFunctorBase::ComputeBatch()).
+     * values and results use structure of arrays layout, e.g. value i of voxel v is values[i*indices.size()+v].
+     * The voxels share one parameterized model, as long as the parameterizer defines no local static parameters
+     * for them. Otherwise every voxel is fitted on its own.
+     * @pre results must have room for GetNumberOfOutputs()*indices.size() values.*/
+    inline void ComputeBatch(const InputPixelArrayType& values, const std::vector<IndexType>& indices,
+                             OutputPixelArrayType& results) const
+    {
+      if (!m_Functor)
+      {
+        itkGenericExceptionMacro( << "Error. Cannot process ComputeBatch(). Functor is Null.");
+      }
+
+      if (!m_ModelParameterizer)
+      {
+        itkGenericExceptionMacro( << "Error. Cannot process ComputeBatch(). Parameterizer is Null.");
+      }
+
+      const unsigned int numberOfVoxels = indices.size();
+      if (numberOfVoxels == 0)
+      {
+        return;
+      }
+
+      const unsigned int numberOfValues = values.size() / numberOfVoxels;
+      const bool hasLocalParameters = std::any_of(indices.begin(), indices.end(), [this](const IndexType& index)
+      {
+        return !m_ModelParameterizer->GetLocalStaticParameters(index).empty();
+      });
+
+      if (hasLocalParameters)
+      {
+        InputPixelArrayType value(numberOfValues);
+        for (unsigned int v = 0; v < numberOfVoxels; ++v)
+        {
+          for (unsigned int i = 0; i < numberOfValues; ++i)
+          {
+            value[i] = values[i * numberOfVoxels + v];
+          }
+
+          const OutputPixelArrayType result = (*this)(value, indices[v]);
+          for (OutputPixelArrayType::size_type i = 0; i < result.size(); ++i)
+          {
+            results[i * numberOfVoxels + v] = result[i];
+          }
+        }
+        return;
+      }
+
+      ParameterizerType::ModelBasePointer parameterizedModel =
+        m_ModelParameterizer->GenerateParameterizedModel(indices.front());
+      const unsigned int numberOfParameters = parameterizedModel->GetNumberOfParameters();
+
+      InputPixelArrayType initialParams(numberOfParameters * numberOfVoxels);
+      for (unsigned int v = 0; v < numberOfVoxels; ++v)
+      {
+        const ParameterizerType::ParametersType voxelParams = m_ModelParameterizer->GetInitialParameterization(indices[v]);
+        for (unsigned int i = 0; i < numberOfParameters; ++i)
+        {
+          initialParams[i * numberOfVoxels + v] = voxelParams[i];
+        }
+      }
+
+      m_Functor->ComputeBatch(values.data(), numberOfValues, numberOfVoxels, parameterizedModel,
+                              initialParams.data(), results.data());
+    }
+
   private:
 
     FunctorConstPointer m_Functor;
@@ -71,6 +71,11 @@ public:
     itkGetMacro(TimeGridByParameterizer, bool);
     itkBooleanMacro(TimeGridByParameterizer);
 
+    /** Number of voxels that are passed at once to the fit functor (see ModelFitFunctorBase::ComputeBatch()).
+     * 0 (default) fits every voxel on its own.*/
+    itkSetMacro(BatchSize, unsigned int);
+    itkGetConstMacro(BatchSize, unsigned int);
+
     double GetProgress() const override;
 
     ParameterNamesType GetParameterNames() const override;
@@ -82,7 +87,7 @@ public:
     ParameterNamesType GetEvaluationParameterNames() const override;
 
 protected:
-  PixelBasedParameterFitImageGenerator() : m_Progress(0), m_TimeGridByParameterizer(false)
+  PixelBasedParameterFitImageGenerator() : m_Progress(0), m_TimeGridByParameterizer(false), m_BatchSize(0)
   {
     m_InternalMask = nullptr;
     m_Mask = nullptr;
@@ -123,6 +128,7 @@ private:
     /**Indicates if the time grid defined in the parameterizer should be used (True)
     or if the filter should extract the time grid from the input image (False).*/
     bool m_TimeGridByParameterizer;
+    unsigned int m_BatchSize;
 };
 
 }
@@ -68,6 +68,9 @@ namespace mitk
 
     ModelResultType ComputeModelfunction(const ParametersType& parameters) const override;
 
+    void ComputeModelfunctionBatch(const ParameterValueType* parameters, unsigned int numberOfSets,
+                                   ModelResultType::ValueType* signals) const override;
+
     void SetStaticParameter(const ParameterNameType& name,
                                     const StaticParameterValuesType& values) override;
     StaticParameterValuesType GetStaticParameterValue(const ParameterNameType& name) const override;
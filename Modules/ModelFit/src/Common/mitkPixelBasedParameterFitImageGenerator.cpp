@@ -12,6 +12,7 @@ found in the LICENSE file.
 
 #include "itkCommand.h"
 #include "itkMultiOutputNaryFunctorImageFilter.h"
+#include "itkMultiOutputNaryBatchFunctorImageFilter.h"
 
 #include "mitkPixelBasedParameterFitImageGenerator.h"
 #include "mitkImageTimeSelector.h"
@@ -86,7 +87,19 @@ void
 
   using FitFilterType = itk::MultiOutputNaryFunctorImageFilter<InputFrameImageType, ParameterImageType, ModelFitFunctorPolicy, InternalMaskType>;
 
-  typename FitFilterType::Pointer fitFilter = FitFilterType::New();
+  using BatchFitFilterType = itk::MultiOutputNaryBatchFunctorImageFilter<InputFrameImageType, ParameterImageType, ModelFitFunctorPolicy, InternalMaskType>;
+
+  typename FitFilterType::Pointer fitFilter;
+  if (this->m_BatchSize > 0)
+  {
+    typename BatchFitFilterType::Pointer batchFitFilter = BatchFitFilterType::New();
+    batchFitFilter->SetBatchSize(this->m_BatchSize);
+    fitFilter = batchFitFilter.GetPointer();
+  }
+  else
+  {
+    fitFilter = FitFilterType::New();
+  }
 
   typename ::itk::MemberCommand<Self>::Pointer spProgressCommand = ::itk::MemberCommand<Self>::New();
   spProgressCommand->SetCallbackFunction(this, &Self::onFitProgressEvent);
@@ -0,0 +1,509 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkBatchedLevenbergMarquardtModelFitFunctor.h"
+
+#include "mitkSumOfSquaredDifferencesFitCostFunction.h"
+#include <mitkLogMacros.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace
+{
+  enum class FitState : unsigned char
+  {
+    NeedsJacobian,
+    NeedsStep,
+    Finished
+  };
+
+  const double INITIAL_DAMPING = 1e-3;
+  const double MINIMUM_DAMPING = 1e-12;
+  const double MAXIMUM_DAMPING = 1e16;
+
+  /** Solves (A + lambda*diag(A)) * step = gradient via a Cholesky decomposition. Element (i,j) of the symmetric
+   * matrix A is normalMatrix[(i*size+j)*stride] (only the lower triangle is used), element i of the gradient is
+   * gradient[i*stride]. Returns false if the damped matrix is not positive definite.*/
+  bool SolveDampedSystem(const double* normalMatrix, const double* gradient, unsigned int size, unsigned int stride,
+                         double lambda, double* decomposition, double* step)
+  {
+    for (unsigned int i = 0; i < size; ++i)
+    {
+      for (unsigned int j = 0; j <= i; ++j)
+      {
+        double sum = normalMatrix[(i * size + j) * stride];
+
+        if (i == j)
+        {
+          sum += lambda * std::max(sum, std::numeric_limits<double>::min());
+        }
+
+        for (unsigned int k = 0; k < j; ++k)
+        {
+          sum -= decomposition[i * size + k] * decomposition[j * size + k];
+        }
+
+        if (i == j)
+        {
+          if (!(sum > 0.0))
+          {
+            return false;
+          }
+          decomposition[i * size + i] = std::sqrt(sum);
+        }
+        else
+        {
+          decomposition[i * size + j] = sum / decomposition[j * size + j];
+        }
+      }
+    }
+
+    for (unsigned int i = 0; i < size; ++i)
+    {
+      double sum = gradient[i * stride];
+      for (unsigned int k = 0; k < i; ++k)
+      {
+        sum -= decomposition[i * size + k] * step[k];
+      }
+      step[i] = sum / decomposition[i * size + i];
+    }
+
+    for (unsigned int i = size; i-- > 0;)
+    {
+      double sum = step[i];
+      for (unsigned int k = i + 1; k < size; ++k)
+      {
+        sum -= decomposition[k * size + i] * step[k];
+      }
+      step[i] = sum / decomposition[i * size + i];
+    }
+
+    return true;
+  }
+}
+
+mitk::BatchedLevenbergMarquardtModelFitFunctor::
+BatchedLevenbergMarquardtModelFitFunctor(): m_StepTolerance(1e-8), m_GradientTolerance(1e-5),
+  m_ValueTolerance(1e-8), m_Iterations(1000), m_DerivativeStepLength(1e-5),
+  m_ActivateFailureThreshold(true)
+{};
+
+mitk::BatchedLevenbergMarquardtModelFitFunctor::
+~BatchedLevenbergMarquardtModelFitFunctor()
+{};
+
+mitk::BatchedLevenbergMarquardtModelFitFunctor::ParameterNamesType
+mitk::BatchedLevenbergMarquardtModelFitFunctor::
+GetCriterionNames() const
+{
+  ParameterNamesType names;
+  names.push_back("sum_diff^2");
+  return names;
+};
+
+mitk::BatchedLevenbergMarquardtModelFitFunctor::OutputPixelArrayType
+mitk::BatchedLevenbergMarquardtModelFitFunctor::
+GetCriteria(const ModelBase* model, const ParametersType& parameters,
+              const SignalType& sample) const
+{
+  ::mitk::SumOfSquaredDifferencesFitCostFunction::Pointer metric
+    = ::mitk::SumOfSquaredDifferencesFitCostFunction::New();
+  metric->SetModel(model);
+  metric->SetSample(sample);
+
+  mitk::BatchedLevenbergMarquardtModelFitFunctor::OutputPixelArrayType result(1);
+  result[0] = metric->GetValue(parameters);
+
+  return result;
+};
+
+mitk::BatchedLevenbergMarquardtModelFitFunctor::ParameterNamesType
+mitk::BatchedLevenbergMarquardtModelFitFunctor::DefineDebugParameterNames() const
+{
+  ParameterNamesType result;
+  result.push_back("nr_of_iterations");
+  return result;
+};
+
+mitk::BatchedLevenbergMarquardtModelFitFunctor::ParametersType
+mitk::BatchedLevenbergMarquardtModelFitFunctor::
+DoModelFit(const SignalType& value, const ModelBase* model,
+           const ModelBase::ParametersType& initialParameters,
+           DebugParameterMapType& debugParameters) const
+{
+  ParametersType internalInitParam = initialParameters;
+
+  if (initialParameters.GetNumberOfElements() != model->GetNumberOfParameters())
+  {
+    MITK_DEBUG <<
+               "Size of initial parameters of fit functor optimizer do not match number of model parameters. Renitialize parameters with 0.0.";
+    internalInitParam.SetSize(model->GetNumberOfParameters());
+    internalInitParam.Fill(0.0);
+  }
+
+  ParametersType position(model->GetNumberOfParameters());
+  ParameterImagePixelType sumOfSquaredDifferences = 0.0;
+  unsigned int iterations = 0;
+
+  this->FitBatch(value.data_block(), value.GetSize(), 1, model, internalInitParam.data_block(),
+                 position.data_block(), &sumOfSquaredDifferences, &iterations);
+
+  debugParameters.clear();
+  if (this->GetDebugParameterMaps())
+  {
+    debugParameters.insert(std::make_pair("nr_of_iterations", iterations));
+  }
+
+  return position;
+};
+
+void
+mitk::BatchedLevenbergMarquardtModelFitFunctor::
+ComputeBatch(const ParameterImagePixelType* values, unsigned int numberOfValues, unsigned int numberOfSignals,
+             const ModelBase* model, const ParameterImagePixelType* initialParameters,
+             ParameterImagePixelType* results) const
+{
+  if (!model)
+  {
+    itkExceptionMacro("Cannot compute fit. Passed model is not defined.");
+  }
+
+  const unsigned int numberOfParameters = model->GetNumberOfParameters();
+
+  std::vector<ParameterImagePixelType> sumsOfSquaredDifferences(numberOfSignals);
+  std::vector<unsigned int> iterations(numberOfSignals);
+
+  //the fitted parameters are the first outputs
+  this->FitBatch(values, numberOfValues, numberOfSignals, model, initialParameters, results,
+                 sumsOfSquaredDifferences.data(), iterations.data());
+
+  const ParameterNamesType evaluationNames = this->GetEvaluationParameterNames();
+  const unsigned int numberOfDerivedParameters = model->GetNumberOfDerivedParameters();
+  unsigned int offset = numberOfParameters;
+
+  if (numberOfDerivedParameters > 0 || !evaluationNames.empty())
+  {
+    ParametersType parameters(numberOfParameters);
+    SignalType sample(numberOfValues);
+
+    for (unsigned int signal = 0; signal < numberOfSignals; ++signal)
+    {
+      for (unsigned int i = 0; i < numberOfParameters; ++i)
+      {
+        parameters[i] = results[i * numberOfSignals + signal];
+      }
+
+      if (numberOfDerivedParameters > 0)
+      {
+        const OutputPixelArrayType derivedParameters = this->GetDerivedParameters(model, parameters);
+        for (OutputPixelArrayType::size_type j = 0; j < derivedParameters.size(); ++j)
+        {
+          results[(offset + j) * numberOfSignals + signal] = derivedParameters[j];
+        }
+      }
+
+      if (!evaluationNames.empty())
+      {
+        for (unsigned int i = 0; i < numberOfValues; ++i)
+        {
+          sample[i] = values[i * numberOfSignals + signal];
+        }
+
+        const OutputPixelArrayType evaluationParameters = this->GetEvaluationParameters(model, parameters, sample);
+        const unsigned int evaluationOffset = offset + numberOfDerivedParameters + 1;
+        for (OutputPixelArrayType::size_type j = 0; j < evaluationParameters.size(); ++j)
+        {
+          results[(evaluationOffset + j) * numberOfSignals + signal] = evaluationParameters[j];
+        }
+      }
+    }
+  }
+
+  offset += numberOfDerivedParameters;
+  std::copy(sumsOfSquaredDifferences.begin(), sumsOfSquaredDifferences.end(), results + offset * numberOfSignals);
+
+  offset += 1 + evaluationNames.size();
+  if (this->GetDebugParameterMaps())
+  {
+    std::copy(iterations.begin(), iterations.end(), results + offset * numberOfSignals);
+  }
+};
+
+void
+mitk::BatchedLevenbergMarquardtModelFitFunctor::
+FitBatch(const ParameterImagePixelType* values, unsigned int numberOfValues, unsigned int numberOfSignals,
+         const ModelBase* model, const ParameterImagePixelType* initialParameters,
+         ParameterImagePixelType* parameters, ParameterImagePixelType* sumsOfSquaredDifferences,
+         unsigned int* iterations) const
+{
+  if (model->GetTimeGrid().GetSize() != numberOfValues)
+  {
+    itkExceptionMacro("Cannot compute fit. Signal size does not match the time grid of the model. Signal size: "
+                      << numberOfValues << "; time grid size: " << model->GetTimeGrid().GetSize());
+  }
+
+  const unsigned int numberOfParameters = model->GetNumberOfParameters();
+  const double stepLength = m_DerivativeStepLength;
+
+  std::copy(initialParameters, initialParameters + numberOfParameters * numberOfSignals, parameters);
+  std::fill(iterations, iterations + numberOfSignals, 0);
+
+  //all working memory of the fit; the evaluation buffers can hold the Jacobian evaluations of all signals
+  std::vector<double> residuals(numberOfValues * numberOfSignals);
+  std::vector<double> costs(numberOfSignals);
+  std::vector<double> lambdas(numberOfSignals, INITIAL_DAMPING);
+  std::vector<double> normalMatrices(numberOfParameters * numberOfParameters * numberOfSignals);
+  std::vector<double> gradients(numberOfParameters * numberOfSignals);
+  std::vector<FitState> states(numberOfSignals, FitState::NeedsJacobian);
+  std::vector<char> validSteps(numberOfSignals);
+  std::vector<unsigned int> currentSignals;
+  currentSignals.reserve(numberOfSignals);
+  std::vector<double> evaluationParameters(2 * numberOfParameters * numberOfParameters * numberOfSignals);
+  std::vector<double> evaluationSignals(2 * numberOfParameters * numberOfValues * numberOfSignals);
+  std::vector<double> jacobianRow(numberOfParameters);
+  std::vector<double> decomposition(numberOfParameters * numberOfParameters);
+  std::vector<double> step(numberOfParameters);
+  ParametersType constraintParameters(numberOfParameters);
+
+  auto getPenalty = [&](const double* setParameters, unsigned int numberOfSets, unsigned int set)
+  {
+    if (m_ConstraintChecker.IsNull())
+    {
+      return 0.0;
+    }
+
+    for (unsigned int i = 0; i < numberOfParameters; ++i)
+    {
+      constraintParameters[i] = setParameters[i * numberOfSets + set];
+    }
+
+    const double penalty = m_ConstraintChecker->GetPenaltySum(constraintParameters);
+    if (m_ActivateFailureThreshold && penalty >= m_ConstraintChecker->GetFailedConstraintValue())
+    {
+      return std::numeric_limits<double>::infinity();
+    }
+    return penalty;
+  };
+
+  model->GetSignalBatch(parameters, numberOfSignals, evaluationSignals.data());
+
+  std::fill(sumsOfSquaredDifferences, sumsOfSquaredDifferences + numberOfSignals, 0.0);
+  for (unsigned int t = 0; t < numberOfValues; ++t)
+  {
+    for (unsigned int signal = 0; signal < numberOfSignals; ++signal)
+    {
+      const double residual = values[t * numberOfSignals + signal] - evaluationSignals[t * numberOfSignals + signal];
+      residuals[t * numberOfSignals + signal] = residual;
+      sumsOfSquaredDifferences[signal] += residual * residual;
+    }
+  }
+
+  for (unsigned int signal = 0; signal < numberOfSignals; ++signal)
+  {
+    costs[signal] = sumsOfSquaredDifferences[signal] + getPenalty(parameters, numberOfSignals, signal);
+  }
+
+  while (true)
+  {
+    //Jacobians (central differences) of all signals whose parameters have changed
+    currentSignals.clear();
+    for (unsigned int signal = 0; signal < numberOfSignals; ++signal)
+    {
+      if (states[signal] == FitState::NeedsJacobian)
+      {
+        currentSignals.push_back(signal);
+      }
+    }
+
+    if (!currentSignals.empty())
+    {
+      const unsigned int numberOfCurrentSignals = currentSignals.size();
+      const unsigned int numberOfEvaluations = 2 * numberOfParameters * numberOfCurrentSignals;
+
+      for (unsigned int j = 0; j < numberOfParameters; ++j)
+      {
+        for (unsigned int direction = 0; direction < 2; ++direction)
+        {
+          const double delta = direction == 0 ? -stepLength : stepLength;
+          const unsigned int evaluationOffset = (2 * j + direction) * numberOfCurrentSignals;
+
+          for (unsigned int i = 0; i < numberOfParameters; ++i)
+          {
+            double* evaluationRow = evaluationParameters.data() + i * numberOfEvaluations + evaluationOffset;
+            const double* parameterRow = parameters + i * numberOfSignals;
+
+            for (unsigned int current = 0; current < numberOfCurrentSignals; ++current)
+            {
+              evaluationRow[current] = parameterRow[currentSignals[current]] + (i == j ? delta : 0.0);
+            }
+          }
+        }
+      }
+
+      model->GetSignalBatch(evaluationParameters.data(), numberOfEvaluations, evaluationSignals.data());
+
+      for (const auto signal : currentSignals)
+      {
+        for (unsigned int i = 0; i < numberOfParameters; ++i)
+        {
+          gradients[i * numberOfSignals + signal] = 0.0;
+          for (unsigned int j = 0; j < numberOfParameters; ++j)
+          {
+            normalMatrices[(i * numberOfParameters + j) * numberOfSignals + signal] = 0.0;
+          }
+        }
+      }
+
+      for (unsigned int t = 0; t < numberOfValues; ++t)
+      {
+        const double* signalRow = evaluationSignals.data() + t * numberOfEvaluations;
+
+        for (unsigned int current = 0; current < numberOfCurrentSignals; ++current)
+        {
+          const unsigned int signal = currentSignals[current];
+          const double residual = residuals[t * numberOfSignals + signal];
+
+          for (unsigned int j = 0; j < numberOfParameters; ++j)
+          {
+            jacobianRow[j] = (signalRow[(2 * j + 1) * numberOfCurrentSignals + current]
+                              - signalRow[2 * j * numberOfCurrentSignals + current]) / (2 * stepLength);
+          }
+
+          for (unsigned int i = 0; i < numberOfParameters; ++i)
+          {
+            gradients[i * numberOfSignals + signal] += jacobianRow[i] * residual;
+            for (unsigned int j = 0; j <= i; ++j)
+            {
+              normalMatrices[(i * numberOfParameters + j) * numberOfSignals + signal] += jacobianRow[i] * jacobianRow[j];
+            }
+          }
+        }
+      }
+
+      for (const auto signal : currentSignals)
+      {
+        //cosine between the residual and the columns of the Jacobian (like MINPACK)
+        const double residualNorm = std::sqrt(sumsOfSquaredDifferences[signal]);
+        double gradientNorm = 0.0;
+
+        if (residualNorm > 0.0)
+        {
+          for (unsigned int j = 0; j < numberOfParameters; ++j)
+          {
+            const double columnNorm = std::sqrt(normalMatrices[(j * numberOfParameters + j) * numberOfSignals + signal]);
+            if (columnNorm > 0.0)
+            {
+              gradientNorm = std::max(gradientNorm,
+                std::abs(gradients[j * numberOfSignals + signal]) / (columnNorm * residualNorm));
+            }
+          }
+        }
+
+        states[signal] = (residualNorm > 0.0 && gradientNorm > m_GradientTolerance) ? FitState::NeedsStep
+                                                                                   : FitState::Finished;
+      }
+    }
+
+    //damped Gauss-Newton steps of all signals that are not finished
+    currentSignals.clear();
+    for (unsigned int signal = 0; signal < numberOfSignals; ++signal)
+    {
+      if (states[signal] == FitState::NeedsStep)
+      {
+        currentSignals.push_back(signal);
+      }
+    }
+
+    if (currentSignals.empty())
+    {
+      break;
+    }
+
+    const unsigned int numberOfCurrentSignals = currentSignals.size();
+
+    for (unsigned int current = 0; current < numberOfCurrentSignals; ++current)
+    {
+      const unsigned int signal = currentSignals[current];
+      const bool solved = SolveDampedSystem(normalMatrices.data() + signal, gradients.data() + signal,
+                                            numberOfParameters, numberOfSignals, lambdas[signal],
+                                            decomposition.data(), step.data());
+      validSteps[signal] = solved;
+
+      for (unsigned int i = 0; i < numberOfParameters; ++i)
+      {
+        evaluationParameters[i * numberOfCurrentSignals + current] =
+          parameters[i * numberOfSignals + signal] + (solved ? step[i] : 0.0);
+      }
+    }
+
+    model->GetSignalBatch(evaluationParameters.data(), numberOfCurrentSignals, evaluationSignals.data());
+
+    for (unsigned int current = 0; current < numberOfCurrentSignals; ++current)
+    {
+      const unsigned int signal = currentSignals[current];
+      ++iterations[signal];
+
+      double trialSumOfSquaredDifferences = 0.0;
+      for (unsigned int t = 0; t < numberOfValues; ++t)
+      {
+        const double residual = values[t * numberOfSignals + signal] - evaluationSignals[t * numberOfCurrentSignals + current];
+        trialSumOfSquaredDifferences += residual * residual;
+      }
+
+      const double trialCost = validSteps[signal]
+        ? trialSumOfSquaredDifferences + getPenalty(evaluationParameters.data(), numberOfCurrentSignals, current)
+        : std::numeric_limits<double>::infinity();
+
+      if (trialCost < costs[signal])
+      {
+        double stepNorm = 0.0;
+        double parameterNorm = 0.0;
+        for (unsigned int i = 0; i < numberOfParameters; ++i)
+        {
+          const double newParameter = evaluationParameters[i * numberOfCurrentSignals + current];
+          const double difference = newParameter - parameters[i * numberOfSignals + signal];
+          stepNorm += difference * difference;
+          parameterNorm += newParameter * newParameter;
+          parameters[i * numberOfSignals + signal] = newParameter;
+        }
+
+        for (unsigned int t = 0; t < numberOfValues; ++t)
+        {
+          residuals[t * numberOfSignals + signal] =
+            values[t * numberOfSignals + signal] - evaluationSignals[t * numberOfCurrentSignals + current];
+        }
+
+        const double reduction = (costs[signal] - trialCost) / costs[signal];
+        costs[signal] = trialCost;
+        sumsOfSquaredDifferences[signal] = trialSumOfSquaredDifferences;
+        lambdas[signal] = std::max(lambdas[signal] * 0.1, MINIMUM_DAMPING);
+
+        const bool converged = reduction <= m_ValueTolerance ||
+          std::sqrt(stepNorm) <= m_StepTolerance * (std::sqrt(parameterNorm) + m_StepTolerance);
+        states[signal] = converged ? FitState::Finished : FitState::NeedsJacobian;
+      }
+      else
+      {
+        lambdas[signal] *= 10.0;
+        states[signal] = lambdas[signal] > MAXIMUM_DAMPING ? FitState::Finished : FitState::NeedsStep;
+      }
+
+      if (iterations[signal] >= m_Iterations)
+      {
+        states[signal] = FitState::Finished;
+      }
+    }
+  }
+};
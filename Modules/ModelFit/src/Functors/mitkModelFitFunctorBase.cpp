@@ -100,6 +100,41 @@ Compute(const InputPixelArrayType& value, const ModelBase* model,
   return result;
 };
 
+void
+mitk::ModelFitFunctorBase::
+ComputeBatch(const ParameterImagePixelType* values, unsigned int numberOfValues, unsigned int numberOfSignals,
+             const ModelBase* model, const ParameterImagePixelType* initialParameters,
+             ParameterImagePixelType* results) const
+{
+  if (!model)
+  {
+    itkExceptionMacro("Cannot compute fit. Passed model is not defined.");
+  }
+
+  InputPixelArrayType value(numberOfValues);
+  ModelBase::ParametersType parameters(model->GetNumberOfParameters());
+
+  for (unsigned int signal = 0; signal < numberOfSignals; ++signal)
+  {
+    for (unsigned int i = 0; i < numberOfValues; ++i)
+    {
+      value[i] = values[i * numberOfSignals + signal];
+    }
+
+    for (ParametersType::SizeValueType i = 0; i < parameters.Size(); ++i)
+    {
+      parameters[i] = initialParameters[i * numberOfSignals + signal];
+    }
+
+    const OutputPixelArrayType result = this->Compute(value, model, parameters);
+
+    for (OutputPixelArrayType::size_type i = 0; i < result.size(); ++i)
+    {
+      results[i * numberOfSignals + signal] = result[i];
+    }
+  }
+};
+
 unsigned int
 mitk::ModelFitFunctorBase::GetNumberOfOutputs(const ModelBase* model) const
 {
@@ -146,6 +146,53 @@ mitk::ModelBase::ModelResultType mitk::ModelBase::GetSignal(const ParametersType
   return signal;
 }
 
+void mitk::ModelBase::GetSignalBatch(const ParameterValueType* parameters, unsigned int numberOfSets,
+                                     ModelResultType::ValueType* signals) const
+{
+  std::string error;
+
+  if (!ValidateModel(error))
+  {
+    itkExceptionMacro("Cannot evaluate model and return signals. Model is in an invalid state. Validation error: "
+                      << error);
+  }
+
+  if (numberOfSets > 0)
+  {
+    ComputeModelfunctionBatch(parameters, numberOfSets, signals);
+  }
+}
+
+void mitk::ModelBase::ComputeModelfunctionBatch(const ParameterValueType* parameters, unsigned int numberOfSets,
+                                                ModelResultType::ValueType* signals) const
+{
+  const ParametersSizeType numberOfParameters = this->GetNumberOfParameters();
+  const TimeGridType::SizeValueType numberOfTimePoints = this->m_TimeGrid.GetSize();
+
+  ParametersType setParameters(numberOfParameters);
+
+  for (unsigned int set = 0; set < numberOfSets; ++set)
+  {
+    for (ParametersSizeType i = 0; i < numberOfParameters; ++i)
+    {
+      setParameters[i] = parameters[i * numberOfSets + set];
+    }
+
+    const ModelResultType signal = ComputeModelfunction(setParameters);
+
+    if (signal.GetSize() != numberOfTimePoints)
+    {
+      itkExceptionMacro("Cannot evaluate model. Signal size does not match the time grid. Signal size: "
+                        << signal.GetSize() << "; time grid size: " << numberOfTimePoints);
+    }
+
+    for (TimeGridType::SizeValueType t = 0; t < numberOfTimePoints; ++t)
+    {
+      signals[t * numberOfSets + set] = signal[t];
+    }
+  }
+}
+
 bool mitk::ModelBase::ValidateModel(std::string& /*error*/) const
 {
   return true;
@@ -57,11 +57,30 @@ mitk::T2DecayModel::ComputeModelfunction(const ParametersType& parameters) const
   for (const auto& gridPos : m_TimeGrid)
   {
     *signalPos = parameters[0] * exp(-1.0 * gridPos/ parameters[1]);
+    ++signalPos;
   }
 
   return signal;
 };
 
+void mitk::T2DecayModel::ComputeModelfunctionBatch(const ParameterValueType* parameters, unsigned int numberOfSets,
+                                                   ModelResultType::ValueType* signals) const
+{
+  const ParameterValueType* m0 = parameters;
+  const ParameterValueType* t2 = parameters + numberOfSets;
+
+  for (TimeGridType::SizeValueType t = 0; t < m_TimeGrid.GetSize(); ++t)
+  {
+    const double gridPos = m_TimeGrid[t];
+    ModelResultType::ValueType* signal = signals + t * numberOfSets;
+
+    for (unsigned int set = 0; set < numberOfSets; ++set)
+    {
+      signal[set] = m0[set] * exp(-1.0 * gridPos / t2[set]);
+    }
+  }
+};
+
 mitk::T2DecayModel::ParameterNamesType mitk::T2DecayModel::GetStaticParameterNames() const
 {
   ParameterNamesType result;
@@ -3,6 +3,7 @@ SET(MODULE_TESTS
   itkMaskedStatisticsImageFilterTest.cpp
   itkMaskedNaryStatisticsImageFilterTest.cpp
   mitkLevenbergMarquardtModelFitFunctorTest.cpp
+  mitkBatchedLevenbergMarquardtModelFitFunctorTest.cpp
   mitkPixelBasedParameterFitImageGeneratorTest.cpp
   mitkROIBasedParameterFitImageGeneratorTest.cpp
   mitkMaskedDynamicImageStatisticsGeneratorTest.cpp
@@ -14,3 +15,8 @@ SET(MODULE_TESTS
   mitkConcreteModelFactoryBaseTest.cpp
   mitkFormulaParserTest.cpp
 )
+
+# Built into a driver of their own with MITK_BUILD_BENCHMARKS, not run by ctest
+SET(MODULE_BENCHMARKS
+  mitkBatchedLevenbergMarquardtModelFitFunctorBenchmark.cpp
+)
@@ -0,0 +1,108 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkBatchedLevenbergMarquardtModelFitFunctor.h"
+#include "mitkLevenbergMarquardtModelFitFunctor.h"
+#include "mitkT2DecayModel.h"
+
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+#include <itkTimeProbe.h>
+
+#include <algorithm>
+
+/** Times the BatchedLevenbergMarquardtModelFitFunctor against the per signal
+ * LevenbergMarquardtModelFitFunctor. Only built with MITK_BUILD_BENCHMARKS.*/
+class mitkBatchedLevenbergMarquardtModelFitFunctorBenchmarkSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkBatchedLevenbergMarquardtModelFitFunctorBenchmarkSuite);
+
+  MITK_TEST(FitT2DecayModel);
+
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+
+  typedef std::vector<double> ValueArrayType;
+
+  mitk::ModelBase::TimeGridType m_Grid;
+
+public:
+
+  void setUp() override
+  {
+    m_Grid.SetSize(16);
+    for (unsigned int i = 0; i < m_Grid.GetSize(); ++i)
+    {
+      m_Grid[i] = 10. * i;
+    }
+  }
+
+  void FitT2DecayModel()
+  {
+    mitk::T2DecayModel::Pointer model = mitk::T2DecayModel::New();
+    model->SetTimeGrid(m_Grid);
+
+    const unsigned int numberOfSignals = 4096;
+    const unsigned int numberOfValues = m_Grid.GetSize();
+
+    ValueArrayType parameters(2 * numberOfSignals);
+    for (unsigned int s = 0; s < numberOfSignals; ++s)
+    {
+      parameters[s] = 50. + (s % 17) * 10.;
+      parameters[numberOfSignals + s] = 20. + (s % 23) * 5.;
+    }
+
+    ValueArrayType values(numberOfValues * numberOfSignals);
+    model->GetSignalBatch(parameters.data(), numberOfSignals, values.data());
+
+    ValueArrayType initialParameters(2 * numberOfSignals);
+    std::fill(initialParameters.begin(), initialParameters.begin() + numberOfSignals, 10.);
+    std::fill(initialParameters.begin() + numberOfSignals, initialParameters.end(), 1000.);
+
+    mitk::BatchedLevenbergMarquardtModelFitFunctor::Pointer batchedFunctor =
+      mitk::BatchedLevenbergMarquardtModelFitFunctor::New();
+    ValueArrayType results(batchedFunctor->GetNumberOfOutputs(model) * numberOfSignals);
+
+    itk::TimeProbe batchedProbe;
+    batchedProbe.Start();
+    batchedFunctor->ComputeBatch(values.data(), numberOfValues, numberOfSignals, model, initialParameters.data(),
+                                 results.data());
+    batchedProbe.Stop();
+
+    mitk::LevenbergMarquardtModelFitFunctor::Pointer functor = mitk::LevenbergMarquardtModelFitFunctor::New();
+    mitk::ModelBase::ParametersType initParams(2);
+    initParams[0] = 10.;
+    initParams[1] = 1000.;
+    ValueArrayType sample(numberOfValues);
+
+    itk::TimeProbe probe;
+    for (unsigned int s = 0; s < numberOfSignals; ++s)
+    {
+      for (unsigned int t = 0; t < numberOfValues; ++t)
+      {
+        sample[t] = values[t * numberOfSignals + s];
+      }
+
+      probe.Start();
+      functor->Compute(sample, model, initParams);
+      probe.Stop();
+    }
+
+    MITK_INFO << "Fit of " << numberOfSignals << " T2 decay signals: " << probe.GetTotal()
+              << " s (LevenbergMarquardtModelFitFunctor), " << batchedProbe.GetTotal()
+              << " s (BatchedLevenbergMarquardtModelFitFunctor)";
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkBatchedLevenbergMarquardtModelFitFunctorBenchmark)
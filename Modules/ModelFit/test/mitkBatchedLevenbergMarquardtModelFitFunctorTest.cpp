@@ -0,0 +1,210 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkBatchedLevenbergMarquardtModelFitFunctor.h"
+#include "mitkLevenbergMarquardtModelFitFunctor.h"
+#include "mitkPixelBasedParameterFitImageGenerator.h"
+#include "mitkLinearModelParameterizer.h"
+#include "mitkLinearModel.h"
+#include "mitkT2DecayModel.h"
+#include "mitkTestDynamicImageGenerator.h"
+
+#include "mitkImagePixelReadAccessor.h"
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+class mitkBatchedLevenbergMarquardtModelFitFunctorTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkBatchedLevenbergMarquardtModelFitFunctorTestSuite);
+
+  MITK_TEST(GetSignalBatchEqualsGetSignal);
+  MITK_TEST(FitLinearModel);
+  MITK_TEST(FitT2DecayModel);
+  MITK_TEST(GeneratorWithBatchSize);
+
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+
+  typedef std::vector<double> ValueArrayType;
+
+  mitk::ModelBase::TimeGridType m_Grid;
+
+  /** Generates numberOfSignals T2 decay signals (SoA layout) with varying M0 and T2.*/
+  void GenerateT2Signals(const mitk::T2DecayModel* model, unsigned int numberOfSignals, ValueArrayType& parameters,
+                         ValueArrayType& signals)
+  {
+    parameters.resize(2 * numberOfSignals);
+    for (unsigned int s = 0; s < numberOfSignals; ++s)
+    {
+      parameters[s] = 50. + (s % 17) * 10.;
+      parameters[numberOfSignals + s] = 20. + (s % 23) * 5.;
+    }
+
+    signals.resize(m_Grid.GetSize() * numberOfSignals);
+    model->GetSignalBatch(parameters.data(), numberOfSignals, signals.data());
+  }
+
+public:
+
+  void setUp() override
+  {
+    m_Grid.SetSize(16);
+    for (unsigned int i = 0; i < m_Grid.GetSize(); ++i)
+    {
+      m_Grid[i] = 10. * i;
+    }
+  }
+
+  void GetSignalBatchEqualsGetSignal()
+  {
+    mitk::T2DecayModel::Pointer model = mitk::T2DecayModel::New();
+    model->SetTimeGrid(m_Grid);
+
+    const unsigned int numberOfSignals = 7;
+    ValueArrayType parameters;
+    ValueArrayType signals;
+    GenerateT2Signals(model, numberOfSignals, parameters, signals);
+
+    for (unsigned int s = 0; s < numberOfSignals; ++s)
+    {
+      mitk::ModelBase::ParametersType params(2);
+      params[0] = parameters[s];
+      params[1] = parameters[numberOfSignals + s];
+      const mitk::ModelBase::ModelResultType signal = model->GetSignal(params);
+
+      for (unsigned int t = 0; t < m_Grid.GetSize(); ++t)
+      {
+        CPPUNIT_ASSERT_MESSAGE("Batched signal differs from GetSignal().",
+                               mitk::Equal(signal[t], signals[t * numberOfSignals + s], 1e-10, true));
+      }
+    }
+  }
+
+  void FitLinearModel()
+  {
+    mitk::LinearModel::Pointer model = mitk::LinearModel::New();
+    model->SetTimeGrid(m_Grid);
+
+    // sample 0: 5*x; sample 1: 2*x+10
+    const unsigned int numberOfSignals = 2;
+    ValueArrayType values(m_Grid.GetSize() * numberOfSignals);
+    for (unsigned int t = 0; t < m_Grid.GetSize(); ++t)
+    {
+      values[t * numberOfSignals] = 5 * m_Grid[t];
+      values[t * numberOfSignals + 1] = 2 * m_Grid[t] + 10;
+    }
+    ValueArrayType initialParameters(2 * numberOfSignals, 0.0);
+
+    mitk::BatchedLevenbergMarquardtModelFitFunctor::Pointer functor = mitk::BatchedLevenbergMarquardtModelFitFunctor::New();
+    CPPUNIT_ASSERT_EQUAL(4u, functor->GetNumberOfOutputs(model));
+
+    ValueArrayType results(functor->GetNumberOfOutputs(model) * numberOfSignals);
+    functor->ComputeBatch(values.data(), m_Grid.GetSize(), numberOfSignals, model, initialParameters.data(),
+                          results.data());
+
+    CPPUNIT_ASSERT_MESSAGE("Check slope of sample 1.", mitk::Equal(5, results[0], 1e-6, true));
+    CPPUNIT_ASSERT_MESSAGE("Check slope of sample 2.", mitk::Equal(2, results[1], 1e-6, true));
+    CPPUNIT_ASSERT_MESSAGE("Check offset of sample 1.", mitk::Equal(0, results[2], 1e-6, true));
+    CPPUNIT_ASSERT_MESSAGE("Check offset of sample 2.", mitk::Equal(10, results[3], 1e-6, true));
+    CPPUNIT_ASSERT_MESSAGE("Check x-intercept of sample 2.", mitk::Equal(-5, results[5], 1e-6, true));
+    CPPUNIT_ASSERT_MESSAGE("Check criterion of sample 1.", mitk::Equal(0, results[6], 1e-6, true));
+
+    // the single signal interface has to yield the same results
+    ValueArrayType sample(m_Grid.GetSize());
+    for (unsigned int t = 0; t < m_Grid.GetSize(); ++t)
+    {
+      sample[t] = values[t * numberOfSignals + 1];
+    }
+    mitk::ModelBase::ParametersType initParams(2);
+    initParams.Fill(0.0);
+    const ValueArrayType output = functor->Compute(sample, model, initParams);
+    CPPUNIT_ASSERT_EQUAL(static_cast<ValueArrayType::size_type>(4), output.size());
+    CPPUNIT_ASSERT_MESSAGE("Check slope of Compute().", mitk::Equal(2, output[0], 1e-6, true));
+    CPPUNIT_ASSERT_MESSAGE("Check offset of Compute().", mitk::Equal(10, output[1], 1e-6, true));
+  }
+
+  void FitT2DecayModel()
+  {
+    mitk::T2DecayModel::Pointer model = mitk::T2DecayModel::New();
+    model->SetTimeGrid(m_Grid);
+
+    const unsigned int numberOfSignals = 4096;
+    const unsigned int numberOfValues = m_Grid.GetSize();
+    ValueArrayType parameters;
+    ValueArrayType values;
+    GenerateT2Signals(model, numberOfSignals, parameters, values);
+
+    ValueArrayType initialParameters(2 * numberOfSignals);
+    std::fill(initialParameters.begin(), initialParameters.begin() + numberOfSignals, 10.);
+    std::fill(initialParameters.begin() + numberOfSignals, initialParameters.end(), 1000.);
+
+    mitk::BatchedLevenbergMarquardtModelFitFunctor::Pointer batchedFunctor =
+      mitk::BatchedLevenbergMarquardtModelFitFunctor::New();
+    const unsigned int numberOfOutputs = batchedFunctor->GetNumberOfOutputs(model);
+    ValueArrayType results(numberOfOutputs * numberOfSignals);
+
+    batchedFunctor->ComputeBatch(values.data(), numberOfValues, numberOfSignals, model, initialParameters.data(),
+                                 results.data());
+
+    for (unsigned int s = 0; s < numberOfSignals; ++s)
+    {
+      for (unsigned int p = 0; p < 2; ++p)
+      {
+        const double expected = parameters[p * numberOfSignals + s];
+        CPPUNIT_ASSERT_MESSAGE("Batched fit failed.",
+                               std::abs(results[p * numberOfSignals + s] - expected) <= 1e-4 * expected);
+      }
+    }
+  }
+
+  void GeneratorWithBatchSize()
+  {
+    mitk::Image::Pointer dynamicImage = mitk::GenerateDynamicTestImageMITK();
+
+    mitk::PixelBasedParameterFitImageGenerator::Pointer generator = mitk::PixelBasedParameterFitImageGenerator::New();
+    CPPUNIT_ASSERT_EQUAL(0u, generator->GetBatchSize());
+
+    generator->SetDynamicImage(dynamicImage);
+    generator->SetModelParameterizer(mitk::LinearModelParameterizer::New());
+    generator->SetFitFunctor(mitk::LevenbergMarquardtModelFitFunctor::New());
+    generator->Generate();
+    auto referenceImages = generator->GetParameterImages();
+
+    generator->SetFitFunctor(mitk::BatchedLevenbergMarquardtModelFitFunctor::New());
+    generator->SetBatchSize(4);
+    generator->Generate();
+    auto batchedImages = generator->GetParameterImages();
+
+    CPPUNIT_ASSERT_EQUAL(referenceImages.size(), batchedImages.size());
+    for (const auto& reference : referenceImages)
+    {
+      CPPUNIT_ASSERT(batchedImages.find(reference.first) != batchedImages.end());
+      CPPUNIT_ASSERT_MESSAGE("Batched parameter image differs: " + reference.first,
+                             mitk::Equal(*(reference.second), *(batchedImages[reference.first]), 1e-3, true));
+    }
+
+    // the batched path must also respect the mask
+    generator->SetMask(mitk::GenerateTestMaskMITK());
+    generator->Generate();
+    batchedImages = generator->GetParameterImages();
+
+    itk::Index<3> maskedIndex;
+    maskedIndex[0] = 1;
+    maskedIndex[1] = 1;
+    maskedIndex[2] = 2;
+    mitk::ImagePixelReadAccessor<mitk::ScalarType, 3> slopeAccessor(batchedImages["slope"]);
+    CPPUNIT_ASSERT_MESSAGE("Masked voxel was fitted.", mitk::Equal(0, slopeAccessor.GetPixelByIndex(maskedIndex), 1e-5, true));
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkBatchedLevenbergMarquardtModelFitFunctor)
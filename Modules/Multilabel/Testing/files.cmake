@@ -4,5 +4,7 @@ set(MODULE_TESTS
     mitkLabelSetImageTest.cpp
     mitkLabelSetImageIOTest.cpp
     mitkLabelSetImageSurfaceStampFilterTest.cpp
+    mitkSparseLabelLayerTest.cpp
+    mitkLabelRegionIndexTest.cpp
 )
 
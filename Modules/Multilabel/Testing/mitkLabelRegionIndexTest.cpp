@@ -0,0 +1,145 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkLabelRegionIndex.h>
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <algorithm>
+#include <vector>
+
+class mitkLabelRegionIndexTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkLabelRegionIndexTestSuite);
+  MITK_TEST(TestUpdate);
+  MITK_TEST(TestUpdateModifiedRegion);
+  MITK_TEST(TestAbsentLabel);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  mitk::LabelRegionIndex::Pointer m_Index;
+  std::vector<mitk::LabelRegionIndex::PixelType> m_Volume;
+
+  // not a multiple of the brick size on purpose
+  unsigned int m_Dimensions[3] = {45, 40, 70};
+
+  void SetValue(unsigned int x, unsigned int y, unsigned int z, mitk::LabelRegionIndex::PixelType value)
+  {
+    m_Volume[(z * m_Dimensions[1] + y) * m_Dimensions[0] + x] = value;
+  }
+
+  // brute force reference for the region of a label
+  void CheckLabelRegion(mitk::LabelRegionIndex::PixelType pixelValue)
+  {
+    std::size_t count = 0;
+    double sum[3] = {0.0, 0.0, 0.0};
+    long min[3] = {1000, 1000, 1000};
+    long max[3] = {-1, -1, -1};
+
+    for (unsigned int z = 0; z < m_Dimensions[2]; ++z)
+      for (unsigned int y = 0; y < m_Dimensions[1]; ++y)
+        for (unsigned int x = 0; x < m_Dimensions[0]; ++x)
+        {
+          if (m_Volume[(z * m_Dimensions[1] + y) * m_Dimensions[0] + x] != pixelValue)
+            continue;
+
+          const long index[3] = {static_cast<long>(x), static_cast<long>(y), static_cast<long>(z)};
+          ++count;
+          for (int dim = 0; dim < 3; ++dim)
+          {
+            sum[dim] += index[dim];
+            min[dim] = std::min(min[dim], index[dim]);
+            max[dim] = std::max(max[dim], index[dim]);
+          }
+        }
+
+    auto labelRegion = m_Index->GetLabelRegion(pixelValue);
+    CPPUNIT_ASSERT_MESSAGE("Wrong number of voxels", labelRegion.NumberOfVoxels == count);
+    for (unsigned int dim = 0; dim < 3; ++dim)
+    {
+      CPPUNIT_ASSERT_MESSAGE("Wrong center of mass", mitk::Equal(labelRegion.CenterOfMassIndex[dim], sum[dim] / count));
+      CPPUNIT_ASSERT_MESSAGE("Wrong bounding box", labelRegion.BoundingBox.GetIndex(dim) == min[dim]);
+      CPPUNIT_ASSERT_MESSAGE("Wrong bounding box",
+                             static_cast<long>(labelRegion.BoundingBox.GetSize(dim)) == max[dim] - min[dim] + 1);
+    }
+  }
+
+public:
+  void setUp() override
+  {
+    m_Index = mitk::LabelRegionIndex::New();
+    m_Index->Initialize(m_Dimensions);
+
+    m_Volume.assign(45 * 40 * 70, 0);
+    // a block spanning several bricks
+    for (unsigned int z = 20; z < 50; ++z)
+      for (unsigned int y = 10; y < 35; ++y)
+        for (unsigned int x = 25; x < 40; ++x)
+          SetValue(x, y, z, 1);
+
+    // a label whose y extent is not monotonic along z
+    SetValue(3, 30, 2, 2);
+    SetValue(40, 5, 60, 2);
+    SetValue(44, 39, 69, 2);
+  }
+
+  void tearDown() override
+  {
+    m_Index = nullptr;
+    m_Volume.clear();
+  }
+
+  void TestUpdate()
+  {
+    m_Index->Update(m_Volume.data());
+
+    auto labels = m_Index->GetLabels();
+    CPPUNIT_ASSERT_MESSAGE("Wrong number of labels", labels.size() == 3);
+    CheckLabelRegion(0);
+    CheckLabelRegion(1);
+    CheckLabelRegion(2);
+  }
+
+  void TestUpdateModifiedRegion()
+  {
+    m_Index->Update(m_Volume.data());
+
+    SetValue(30, 20, 30, 3);
+    SetValue(31, 20, 30, 3);
+    SetValue(40, 5, 60, 0);
+
+    mitk::LabelRegionIndex::RegionType modifiedRegion;
+    modifiedRegion.SetIndex(0, 30);
+    modifiedRegion.SetIndex(1, 5);
+    modifiedRegion.SetIndex(2, 30);
+    modifiedRegion.SetSize(0, 11);
+    modifiedRegion.SetSize(1, 16);
+    modifiedRegion.SetSize(2, 31);
+    m_Index->Update(m_Volume.data(), modifiedRegion);
+
+    CPPUNIT_ASSERT_MESSAGE("New label is missing", m_Index->HasLabel(3));
+    CheckLabelRegion(0);
+    CheckLabelRegion(1);
+    CheckLabelRegion(2);
+    CheckLabelRegion(3);
+  }
+
+  void TestAbsentLabel()
+  {
+    m_Index->Update(m_Volume.data());
+
+    CPPUNIT_ASSERT_MESSAGE("Absent label is reported", !m_Index->HasLabel(5));
+    CPPUNIT_ASSERT_MESSAGE("Absent label has voxels", m_Index->GetLabelRegion(5).NumberOfVoxels == 0);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkLabelRegionIndex)
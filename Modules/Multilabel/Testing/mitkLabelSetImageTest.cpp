@@ -11,8 +11,12 @@ found in the LICENSE file.
 ============================================================================*/
 
 #include <mitkIOUtil.h>
+#include <mitkImagePixelReadAccessor.h>
+#include <mitkImagePixelWriteAccessor.h>
+#include <mitkImageWriteAccessor.h>
 #include <mitkImageStatisticsHolder.h>
 #include <mitkLabelSetImage.h>
+#include <mitkPlaneGeometry.h>
 #include <mitkTestFixture.h>
 #include <mitkTestingMacros.h>
 
@@ -31,9 +35,13 @@ class mitkLabelSetImageTestSuite : public mitk::TestFixture
   MITK_TEST(TestExistsLabel);
   MITK_TEST(TestExistsLabelSet);
   MITK_TEST(TestSetActiveLayer);
+  MITK_TEST(TestSetActiveLayer_LayerContentIsPreserved);
+  MITK_TEST(TestGetLayerImage_InactiveLayerIsWritable);
   MITK_TEST(TestRemoveLayer);
   MITK_TEST(TestRemoveLabels);
   MITK_TEST(TestMergeLabel);
+  MITK_TEST(TestGetLabelRegion);
+  MITK_TEST(TestGetLabelRegion_TimeSteps);
   // TODO check it these functionalities can be moved into a process object
   //  MITK_TEST(TestMergeLabels);
   //  MITK_TEST(TestConcatenate);
@@ -332,6 +340,112 @@ public:
                            mitk::Equal(*newlayer, *m_LabelSetImage->GetActiveLabelSet(), 0.00001, true));
   }
 
+  void TestSetActiveLayer_LayerContentIsPreserved()
+  {
+    itk::Index<3> index0 = {{10, 20, 30}};
+    itk::Index<3> index1 = {{200, 100, 300}};
+
+    {
+      mitk::ImagePixelWriteAccessor<mitk::Label::PixelType, 3> writeAccessor(m_LabelSetImage.GetPointer());
+      writeAccessor.SetPixelByIndex(index0, 1);
+    }
+
+    unsigned int layerID = m_LabelSetImage->AddLayer();
+    {
+      mitk::ImagePixelReadAccessor<mitk::Label::PixelType, 3> readAccessor(m_LabelSetImage.GetPointer());
+      CPPUNIT_ASSERT_MESSAGE("New layer is not empty", readAccessor.GetPixelByIndex(index0) == 0);
+    }
+    {
+      mitk::ImagePixelWriteAccessor<mitk::Label::PixelType, 3> writeAccessor(m_LabelSetImage.GetPointer());
+      writeAccessor.SetPixelByIndex(index1, 2);
+    }
+
+    m_LabelSetImage->SetActiveLayer(0);
+    {
+      mitk::ImagePixelReadAccessor<mitk::Label::PixelType, 3> readAccessor(m_LabelSetImage.GetPointer());
+      CPPUNIT_ASSERT_MESSAGE("Content of layer 0 was lost", readAccessor.GetPixelByIndex(index0) == 1);
+      CPPUNIT_ASSERT_MESSAGE("Content of layer 1 leaked into layer 0", readAccessor.GetPixelByIndex(index1) == 0);
+    }
+
+    // inactive layers only store the bricks containing labels
+    CPPUNIT_ASSERT_MESSAGE("Inactive layer is not stored sparse",
+                           m_LabelSetImage->GetLayerStorage(layerID)->GetNumberOfAllocatedBricks() == 1);
+    CPPUNIT_ASSERT_MESSAGE("Wrong value in layer storage",
+                           m_LabelSetImage->GetLayerStorage(layerID)->GetValue(200, 100, 300) == 2);
+
+    {
+      mitk::ImagePixelReadAccessor<mitk::Label::PixelType, 3> readAccessor(m_LabelSetImage->GetLayerImage(layerID));
+      CPPUNIT_ASSERT_MESSAGE("Wrong layer image of inactive layer", readAccessor.GetPixelByIndex(index1) == 2);
+      CPPUNIT_ASSERT_MESSAGE("Wrong layer image of inactive layer", readAccessor.GetPixelByIndex(index0) == 0);
+    }
+    CPPUNIT_ASSERT_MESSAGE("Layer image of the active layer is not the image itself",
+                           m_LabelSetImage->GetLayerImage(0) == m_LabelSetImage.GetPointer());
+
+    // the image of a plane only covers the voxels around the plane
+    mitk::Vector3D right;
+    mitk::Vector3D down;
+    mitk::FillVector3D(right, 1.0, 0.0, 0.0);
+    mitk::FillVector3D(down, 0.0, 1.0, 0.0);
+    auto plane = mitk::PlaneGeometry::New();
+    plane->InitializeStandardPlane(256, 256, right, down);
+    mitk::Point3D planeOrigin;
+    mitk::FillVector3D(planeOrigin, 0.0, 0.0, 300.0);
+    plane->SetOrigin(planeOrigin);
+
+    mitk::Image::Pointer planeImage = m_LabelSetImage->CreateLayerImage(layerID, plane, 0);
+    CPPUNIT_ASSERT_MESSAGE("No image of the plane", planeImage.IsNotNull());
+    CPPUNIT_ASSERT_MESSAGE("Wrong size of the image of the plane",
+                           planeImage->GetDimension(0) == 256 && planeImage->GetDimension(1) == 256 &&
+                             planeImage->GetDimension(2) == 4);
+    {
+      mitk::ImagePixelReadAccessor<mitk::Label::PixelType, 3> readAccessor(planeImage);
+      itk::Index<3> planeIndex = {{200, 100, 1}};
+      CPPUNIT_ASSERT_MESSAGE("Wrong image of the plane", readAccessor.GetPixelByIndex(planeIndex) == 2);
+    }
+
+    m_LabelSetImage->SetActiveLayer(layerID);
+    {
+      mitk::ImagePixelReadAccessor<mitk::Label::PixelType, 3> readAccessor(m_LabelSetImage.GetPointer());
+      CPPUNIT_ASSERT_MESSAGE("Content of layer 1 was lost", readAccessor.GetPixelByIndex(index1) == 2);
+      CPPUNIT_ASSERT_MESSAGE("Content of layer 0 leaked into layer 1", readAccessor.GetPixelByIndex(index0) == 0);
+    }
+  }
+
+  void TestGetLayerImage_InactiveLayerIsWritable()
+  {
+    itk::Index<3> index = {{200, 100, 300}};
+
+    unsigned int layerID = m_LabelSetImage->AddLayer();
+    m_LabelSetImage->SetActiveLayer(0);
+
+    mitk::Image *layerImage = m_LabelSetImage->GetLayerImage(layerID);
+    CPPUNIT_ASSERT_MESSAGE("Image of the inactive layer is not kept",
+                           layerImage == m_LabelSetImage->GetLayerImage(layerID));
+    {
+      mitk::ImagePixelWriteAccessor<mitk::Label::PixelType, 3> writeAccessor(layerImage);
+      writeAccessor.SetPixelByIndex(index, 3);
+    }
+    layerImage->Modified();
+
+    CPPUNIT_ASSERT_MESSAGE("Layer storage was not updated from the layer image",
+                           m_LabelSetImage->GetLayerStorage(layerID)->GetValue(200, 100, 300) == 3);
+    {
+      mitk::ImagePixelReadAccessor<mitk::Label::PixelType, 3> readAccessor(
+        m_LabelSetImage->CreateLayerImage(layerID));
+      CPPUNIT_ASSERT_MESSAGE("Created layer image misses the change", readAccessor.GetPixelByIndex(index) == 3);
+    }
+    {
+      mitk::ImagePixelReadAccessor<mitk::Label::PixelType, 3> readAccessor(m_LabelSetImage.GetPointer());
+      CPPUNIT_ASSERT_MESSAGE("Change leaked into the active layer", readAccessor.GetPixelByIndex(index) == 0);
+    }
+
+    m_LabelSetImage->SetActiveLayer(layerID);
+    {
+      mitk::ImagePixelReadAccessor<mitk::Label::PixelType, 3> readAccessor(m_LabelSetImage.GetPointer());
+      CPPUNIT_ASSERT_MESSAGE("Change was lost on activation", readAccessor.GetPixelByIndex(index) == 3);
+    }
+  }
+
   void TestRemoveLayer()
   {
     // Cache active layer
@@ -439,6 +553,125 @@ public:
     // Check if merge label has 507 + 823 = 1330 pixels
     CPPUNIT_ASSERT_MESSAGE("Label with value 7 was not remove from the image", m_LabelSetImage->GetStatistics()->GetCountOfMaxValuedVoxels() == 1330);
   }
+
+  void TestGetLabelRegion()
+  {
+    itk::Index<3> index0 = {{10, 20, 30}};
+    itk::Index<3> index1 = {{12, 25, 31}};
+
+    {
+      mitk::ImagePixelWriteAccessor<mitk::Label::PixelType, 3> writeAccessor(m_LabelSetImage.GetPointer());
+      writeAccessor.SetPixelByIndex(index0, 1);
+      writeAccessor.SetPixelByIndex(index1, 1);
+    }
+
+    auto labelRegion = m_LabelSetImage->GetLabelRegion(1);
+    CPPUNIT_ASSERT_MESSAGE("Wrong number of voxels", labelRegion.NumberOfVoxels == 2);
+    CPPUNIT_ASSERT_MESSAGE("Wrong center of mass",
+                           mitk::Equal(labelRegion.CenterOfMassIndex[0], 11.0) &&
+                             mitk::Equal(labelRegion.CenterOfMassIndex[1], 22.5) &&
+                             mitk::Equal(labelRegion.CenterOfMassIndex[2], 30.5));
+    CPPUNIT_ASSERT_MESSAGE("Wrong bounding box", labelRegion.BoundingBox.GetIndex() == index0);
+    CPPUNIT_ASSERT_MESSAGE("Wrong bounding box", labelRegion.BoundingBox.GetSize()[0] == 3 &&
+                                                   labelRegion.BoundingBox.GetSize()[1] == 6 &&
+                                                   labelRegion.BoundingBox.GetSize()[2] == 2);
+    CPPUNIT_ASSERT_MESSAGE("Absent label has voxels", m_LabelSetImage->GetLabelRegion(5).NumberOfVoxels == 0);
+
+    // a modification of the image invalidates the cached regions
+    {
+      mitk::ImagePixelWriteAccessor<mitk::Label::PixelType, 3> writeAccessor(m_LabelSetImage.GetPointer());
+      writeAccessor.SetPixelByIndex(index1, 0);
+    }
+    m_LabelSetImage->Modified();
+    CPPUNIT_ASSERT_MESSAGE("Cached region was not updated", m_LabelSetImage->GetLabelRegion(1).NumberOfVoxels == 1);
+
+    // the cropped mask only covers the bounding box plus a margin of one voxel
+    mitk::Image::Pointer mask = m_LabelSetImage->CreateCroppedLabelMask(1);
+    CPPUNIT_ASSERT_MESSAGE("No cropped mask", mask.IsNotNull());
+    CPPUNIT_ASSERT_MESSAGE("Wrong size of cropped mask",
+                           mask->GetDimension(0) == 3 && mask->GetDimension(1) == 3 && mask->GetDimension(2) == 3);
+    {
+      mitk::ImagePixelReadAccessor<mitk::Label::PixelType, 3> readAccessor(mask);
+      itk::Index<3> center = {{1, 1, 1}};
+      itk::Index<3> corner = {{0, 0, 0}};
+      CPPUNIT_ASSERT_MESSAGE("Label is not in the cropped mask", readAccessor.GetPixelByIndex(center) == 1);
+      CPPUNIT_ASSERT_MESSAGE("Margin is not empty", readAccessor.GetPixelByIndex(corner) == 0);
+    }
+    CPPUNIT_ASSERT_MESSAGE("Cropped mask of absent label", m_LabelSetImage->CreateCroppedLabelMask(5).IsNull());
+  }
+
+  void TestGetLabelRegion_TimeSteps()
+  {
+    auto regularImage = mitk::Image::New();
+    unsigned int dimensions[4] = {40, 30, 20, 2};
+    regularImage->Initialize(mitk::MakeScalarPixelType<mitk::Label::PixelType>(), 4, dimensions);
+    auto labelSetImage = mitk::LabelSetImage::New();
+    labelSetImage->Initialize(regularImage);
+
+    auto newLabel = mitk::Label::New();
+    newLabel->SetValue(1);
+    labelSetImage->GetActiveLabelSet()->AddLabel(newLabel);
+    mitk::Label *label = labelSetImage->GetLabel(1);
+    CPPUNIT_ASSERT_MESSAGE("Label was not added", nullptr != label);
+
+    const std::size_t sliceSize = dimensions[0] * dimensions[1];
+    const std::size_t offset = 12 * sliceSize + 5 * dimensions[0] + 7; // index (7, 5, 12)
+    {
+      mitk::ImageWriteAccessor writeAccessor(labelSetImage, labelSetImage->GetVolumeData(1));
+      static_cast<mitk::Label::PixelType *>(writeAccessor.GetData())[offset] = 1;
+    }
+    labelSetImage->Modified();
+
+    CPPUNIT_ASSERT_MESSAGE("Label found in time step 0", labelSetImage->GetLabelRegion(1, 0, 0).NumberOfVoxels == 0);
+    CPPUNIT_ASSERT_MESSAGE("Label not found in time step 1", labelSetImage->GetLabelRegion(1, 0, 1).NumberOfVoxels == 1);
+
+    // an incremental update of the modified region keeps the index of the time step up to date
+    {
+      mitk::ImageWriteAccessor writeAccessor(labelSetImage, labelSetImage->GetVolumeData(1));
+      static_cast<mitk::Label::PixelType *>(writeAccessor.GetData())[offset + 1] = 1;
+    }
+    labelSetImage->Modified();
+    itk::Index<3> modifiedIndex = {{8, 5, 12}};
+    itk::Size<3> modifiedSize = {{1, 1, 1}};
+    itk::ImageRegion<3> modifiedRegion(modifiedIndex, modifiedSize);
+    labelSetImage->UpdateLabelRegions(modifiedRegion, 1);
+
+    auto labelRegion = labelSetImage->GetLabelRegion(1, 0, 1);
+    CPPUNIT_ASSERT_MESSAGE("Region was not updated", labelRegion.NumberOfVoxels == 2);
+    CPPUNIT_ASSERT_MESSAGE("Wrong center of mass", mitk::Equal(labelRegion.CenterOfMassIndex[0], 7.5));
+
+    // the center of mass covers all time steps
+    labelSetImage->UpdateCenterOfMass(1);
+    CPPUNIT_ASSERT_MESSAGE("Wrong center of mass of the label",
+                           mitk::Equal(label->GetCenterOfMassIndex()[0], 7.5) &&
+                             mitk::Equal(label->GetCenterOfMassIndex()[1], 5.0) &&
+                             mitk::Equal(label->GetCenterOfMassIndex()[2], 12.0));
+
+    // the cropped mask of a later time step is a 3D image at the position of the label
+    CPPUNIT_ASSERT_MESSAGE("Cropped mask of absent label", labelSetImage->CreateCroppedLabelMask(1, true, 0, 0).IsNull());
+    mitk::Image::Pointer mask = labelSetImage->CreateCroppedLabelMask(1, true, 0, 1);
+    CPPUNIT_ASSERT_MESSAGE("No cropped mask", mask.IsNotNull());
+    CPPUNIT_ASSERT_MESSAGE("Wrong size of cropped mask",
+                           mask->GetDimension() == 3 && mask->GetDimension(0) == 4 && mask->GetDimension(1) == 3 &&
+                             mask->GetDimension(2) == 3);
+
+    mitk::Point3D labelPosition;
+    labelSetImage->GetGeometry(1)->IndexToWorld(label->GetCenterOfMassIndex(), labelPosition);
+    mitk::Point3D maskIndex;
+    mask->GetGeometry()->WorldToIndex(labelPosition, maskIndex);
+    CPPUNIT_ASSERT_MESSAGE("Cropped mask at wrong position",
+                           mitk::Equal(maskIndex[0], 1.5) && mitk::Equal(maskIndex[1], 1.0) &&
+                             mitk::Equal(maskIndex[2], 1.0));
+    {
+      mitk::ImagePixelReadAccessor<mitk::Label::PixelType, 3> readAccessor(mask);
+      itk::Index<3> first = {{1, 1, 1}};
+      itk::Index<3> second = {{2, 1, 1}};
+      itk::Index<3> corner = {{0, 0, 0}};
+      CPPUNIT_ASSERT_MESSAGE("Label is not in the cropped mask",
+                             readAccessor.GetPixelByIndex(first) == 1 && readAccessor.GetPixelByIndex(second) == 1);
+      CPPUNIT_ASSERT_MESSAGE("Margin is not empty", readAccessor.GetPixelByIndex(corner) == 0);
+    }
+  }
 };
 
 MITK_TEST_SUITE_REGISTRATION(mitkLabelSetImage)
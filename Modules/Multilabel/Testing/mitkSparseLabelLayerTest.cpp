@@ -0,0 +1,146 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkSparseLabelLayer.h>
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <vector>
+
+class mitkSparseLabelLayerTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkSparseLabelLayerTestSuite);
+  MITK_TEST(TestInitialize);
+  MITK_TEST(TestImportExport);
+  MITK_TEST(TestImportExport4D);
+  MITK_TEST(TestExportRegion);
+  MITK_TEST(TestClone);
+  MITK_TEST(TestClear);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  mitk::SparseLabelLayer::Pointer m_Layer;
+  std::vector<mitk::SparseLabelLayer::PixelType> m_Buffer;
+
+  // not a multiple of the brick size on purpose
+  unsigned int m_Dimensions[4] = {45, 33, 70, 3};
+
+public:
+  void setUp() override
+  {
+    m_Layer = mitk::SparseLabelLayer::New();
+    m_Layer->Initialize(3, m_Dimensions);
+
+    m_Buffer.assign(45 * 33 * 70, 0);
+    // a label in the first brick and one at the last voxel of the last (partial) brick
+    m_Buffer[(2 * 33 + 3) * 45 + 4] = 1;
+    m_Buffer[(2 * 33 + 3) * 45 + 5] = 1;
+    m_Buffer.back() = 7;
+  }
+
+  void tearDown() override
+  {
+    m_Layer = nullptr;
+    m_Buffer.clear();
+  }
+
+  void TestInitialize()
+  {
+    CPPUNIT_ASSERT_MESSAGE("Wrong number of voxels", m_Layer->GetNumberOfVoxels() == 45 * 33 * 70);
+    CPPUNIT_ASSERT_MESSAGE("Wrong number of bricks", m_Layer->GetNumberOfBricks() == 2 * 2 * 3);
+    CPPUNIT_ASSERT_MESSAGE("Empty layer allocates bricks", m_Layer->GetNumberOfAllocatedBricks() == 0);
+    CPPUNIT_ASSERT_MESSAGE("Empty layer uses memory", m_Layer->GetMemorySize() == 0);
+    CPPUNIT_ASSERT_MESSAGE("Empty layer is not exterior", m_Layer->GetValue(44, 32, 69) == 0);
+  }
+
+  void TestImportExport()
+  {
+    m_Layer->Import(m_Buffer.data());
+    CPPUNIT_ASSERT_MESSAGE("Empty bricks are allocated", m_Layer->GetNumberOfAllocatedBricks() == 2);
+    CPPUNIT_ASSERT_MESSAGE("Wrong value", m_Layer->GetValue(4, 3, 2) == 1);
+    CPPUNIT_ASSERT_MESSAGE("Wrong value", m_Layer->GetValue(5, 3, 2) == 1);
+    CPPUNIT_ASSERT_MESSAGE("Wrong value", m_Layer->GetValue(6, 3, 2) == 0);
+    CPPUNIT_ASSERT_MESSAGE("Wrong value", m_Layer->GetValue(44, 32, 69) == 7);
+
+    std::vector<mitk::SparseLabelLayer::PixelType> exported(m_Buffer.size(), 42);
+    m_Layer->Export(exported.data());
+    CPPUNIT_ASSERT_MESSAGE("Exported buffer differs from imported buffer", exported == m_Buffer);
+  }
+
+  void TestImportExport4D()
+  {
+    m_Layer->Initialize(4, m_Dimensions);
+    CPPUNIT_ASSERT_MESSAGE("Wrong number of voxels", m_Layer->GetNumberOfVoxels() == 45 * 33 * 70 * 3);
+
+    std::vector<mitk::SparseLabelLayer::PixelType> buffer(m_Layer->GetNumberOfVoxels(), 0);
+    // first voxel of the second time step
+    buffer[45 * 33 * 70] = 3;
+    m_Layer->Import(buffer.data());
+    CPPUNIT_ASSERT_MESSAGE("Wrong value", m_Layer->GetValue(0, 0, 70) == 3);
+
+    std::vector<mitk::SparseLabelLayer::PixelType> exported(buffer.size(), 42);
+    m_Layer->Export(exported.data());
+    CPPUNIT_ASSERT_MESSAGE("Exported buffer differs from imported buffer", exported == buffer);
+  }
+
+  void TestExportRegion()
+  {
+    m_Layer->Import(m_Buffer.data());
+
+    // a region across the border of the first brick and one within the last brick
+    itk::Index<3> index = {{3, 2, 1}};
+    itk::Size<3> size = {{40, 2, 2}};
+    mitk::SparseLabelLayer::RegionType region(index, size);
+
+    std::vector<mitk::SparseLabelLayer::PixelType> exported(region.GetNumberOfPixels(), 42);
+    m_Layer->Export(exported.data(), region);
+    for (std::size_t z = 0; z < size[2]; ++z)
+      for (std::size_t y = 0; y < size[1]; ++y)
+        for (std::size_t x = 0; x < size[0]; ++x)
+          CPPUNIT_ASSERT_MESSAGE("Exported region differs from imported buffer",
+                                 exported[(z * size[1] + y) * size[0] + x] ==
+                                   m_Buffer[((index[2] + z) * 33 + index[1] + y) * 45 + index[0] + x]);
+
+    itk::Index<3> lastIndex = {{44, 32, 69}};
+    itk::Size<3> lastSize = {{1, 1, 1}};
+    mitk::SparseLabelLayer::PixelType value = 0;
+    m_Layer->Export(&value, mitk::SparseLabelLayer::RegionType(lastIndex, lastSize));
+    CPPUNIT_ASSERT_MESSAGE("Wrong value of last voxel", value == 7);
+
+    itk::Size<3> tooLarge = {{2, 1, 1}};
+    CPPUNIT_ASSERT_THROW(m_Layer->Export(exported.data(), mitk::SparseLabelLayer::RegionType(lastIndex, tooLarge)),
+                         mitk::Exception);
+  }
+
+  void TestClone()
+  {
+    m_Layer->Import(m_Buffer.data());
+    mitk::SparseLabelLayer::Pointer clone = m_Layer->Clone();
+
+    // the clone must not share bricks with the original
+    m_Layer->Clear();
+
+    std::vector<mitk::SparseLabelLayer::PixelType> exported(m_Buffer.size(), 42);
+    clone->Export(exported.data());
+    CPPUNIT_ASSERT_MESSAGE("Clone differs from original", exported == m_Buffer);
+  }
+
+  void TestClear()
+  {
+    m_Layer->Import(m_Buffer.data());
+    m_Layer->Clear();
+    CPPUNIT_ASSERT_MESSAGE("Bricks are not released", m_Layer->GetNumberOfAllocatedBricks() == 0);
+    CPPUNIT_ASSERT_MESSAGE("Wrong value after clear", m_Layer->GetValue(44, 32, 69) == 0);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkSparseLabelLayer)
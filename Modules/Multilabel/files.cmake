@@ -12,6 +12,8 @@ set(CPP_FILES
   mitkLabelSetIOHelper.cpp
   mitkDICOMSegmentationPropertyHelper.cpp
   mitkDICOMSegmentationConstants.cpp
+  mitkSparseLabelLayer.cpp
+  mitkLabelRegionIndex.cpp
 )
 
 set(RESOURCE_FILES
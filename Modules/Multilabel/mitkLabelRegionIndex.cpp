@@ -0,0 +1,213 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkLabelRegionIndex.h"
+
+#include <algorithm>
+
+const unsigned int mitk::LabelRegionIndex::BRICK_EDGE_LENGTH;
+
+mitk::LabelRegionIndex::LabelRegion::LabelRegion() : NumberOfVoxels(0)
+{
+  CenterOfMassIndex.Fill(0.0);
+}
+
+mitk::LabelRegionIndex::LabelRegionIndex() : m_LabelRegionsValid(false)
+{
+  std::fill(m_Dimensions, m_Dimensions + 3, 0);
+  std::fill(m_BricksPerDimension, m_BricksPerDimension + 3, 0);
+}
+
+mitk::LabelRegionIndex::~LabelRegionIndex()
+{
+}
+
+void mitk::LabelRegionIndex::Initialize(const unsigned int *dimensions)
+{
+  for (int dim = 0; dim < 3; ++dim)
+  {
+    m_Dimensions[dim] = dimensions[dim];
+    m_BricksPerDimension[dim] = (m_Dimensions[dim] + BRICK_EDGE_LENGTH - 1) / BRICK_EDGE_LENGTH;
+  }
+
+  m_Bricks.clear();
+  m_Bricks.resize(m_BricksPerDimension[0] * m_BricksPerDimension[1] * m_BricksPerDimension[2]);
+  m_LabelRegions.clear();
+  m_LabelRegionsValid = false;
+  this->Modified();
+}
+
+void mitk::LabelRegionIndex::Update(const PixelType *volume)
+{
+  RegionType largestRegion;
+  for (unsigned int dim = 0; dim < 3; ++dim)
+    largestRegion.SetSize(dim, m_Dimensions[dim]);
+
+  this->Update(volume, largestRegion);
+}
+
+void mitk::LabelRegionIndex::Update(const PixelType *volume, const RegionType &modifiedRegion)
+{
+  std::size_t firstBrick[3];
+  std::size_t endBrick[3];
+  for (unsigned int dim = 0; dim < 3; ++dim)
+  {
+    const auto begin = std::max<RegionType::IndexValueType>(modifiedRegion.GetIndex(dim), 0);
+    const auto end = std::min<RegionType::IndexValueType>(
+      modifiedRegion.GetIndex(dim) + static_cast<RegionType::IndexValueType>(modifiedRegion.GetSize(dim)),
+      m_Dimensions[dim]);
+    if (end <= begin)
+      return;
+
+    firstBrick[dim] = begin / BRICK_EDGE_LENGTH;
+    endBrick[dim] = (end + BRICK_EDGE_LENGTH - 1) / BRICK_EDGE_LENGTH;
+  }
+
+  for (std::size_t bz = firstBrick[2]; bz < endBrick[2]; ++bz)
+    for (std::size_t by = firstBrick[1]; by < endBrick[1]; ++by)
+      for (std::size_t bx = firstBrick[0]; bx < endBrick[0]; ++bx)
+        this->UpdateBrick(volume, bx, by, bz);
+
+  m_LabelRegionsValid = false;
+  this->Modified();
+}
+
+void mitk::LabelRegionIndex::UpdateBrick(const PixelType *volume, std::size_t bx, std::size_t by, std::size_t bz)
+{
+  BrickType &brick = m_Bricks[(bz * m_BricksPerDimension[1] + by) * m_BricksPerDimension[0] + bx];
+  brick.clear();
+
+  const std::size_t x0 = bx * BRICK_EDGE_LENGTH;
+  const std::size_t y0 = by * BRICK_EDGE_LENGTH;
+  const std::size_t z0 = bz * BRICK_EDGE_LENGTH;
+  const std::size_t x1 = std::min<std::size_t>(x0 + BRICK_EDGE_LENGTH, m_Dimensions[0]);
+  const std::size_t y1 = std::min<std::size_t>(y0 + BRICK_EDGE_LENGTH, m_Dimensions[1]);
+  const std::size_t z1 = std::min<std::size_t>(z0 + BRICK_EDGE_LENGTH, m_Dimensions[2]);
+
+  // labels are spatially coherent, so the entry of the previous voxel is usually the right one
+  std::size_t current = 0;
+
+  for (std::size_t z = z0; z < z1; ++z)
+  {
+    for (std::size_t y = y0; y < y1; ++y)
+    {
+      const PixelType *row = volume + (z * m_Dimensions[1] + y) * m_Dimensions[0];
+      for (std::size_t x = x0; x < x1; ++x)
+      {
+        const PixelType value = row[x];
+        if (brick.empty() || brick[current].first != value)
+        {
+          auto it = std::find_if(brick.begin(), brick.end(), [value](const std::pair<PixelType, BrickEntry> &entry) {
+            return entry.first == value;
+          });
+
+          if (it == brick.end())
+          {
+            BrickEntry entry;
+            entry.NumberOfVoxels = 0;
+            std::fill(entry.IndexSum, entry.IndexSum + 3, 0.0);
+            entry.Min[0] = entry.Max[0] = x;
+            entry.Min[1] = entry.Max[1] = y;
+            entry.Min[2] = entry.Max[2] = z;
+            brick.emplace_back(value, entry);
+            it = brick.end() - 1;
+          }
+          current = it - brick.begin();
+        }
+
+        BrickEntry &entry = brick[current].second;
+        ++entry.NumberOfVoxels;
+        entry.IndexSum[0] += x;
+        entry.IndexSum[1] += y;
+        entry.IndexSum[2] += z;
+
+        // z only grows while scanning the brick, so its minimum is the one of the first voxel
+        entry.Min[0] = std::min<RegionType::IndexValueType>(entry.Min[0], x);
+        entry.Max[0] = std::max<RegionType::IndexValueType>(entry.Max[0], x);
+        entry.Min[1] = std::min<RegionType::IndexValueType>(entry.Min[1], y);
+        entry.Max[1] = std::max<RegionType::IndexValueType>(entry.Max[1], y);
+        entry.Max[2] = z;
+      }
+    }
+  }
+}
+
+void mitk::LabelRegionIndex::MergeBricks() const
+{
+  std::map<PixelType, BrickEntry> merged;
+  for (const auto &brick : m_Bricks)
+  {
+    for (const auto &brickEntry : brick)
+    {
+      auto result = merged.insert(brickEntry);
+      if (result.second)
+        continue;
+
+      BrickEntry &target = result.first->second;
+      const BrickEntry &source = brickEntry.second;
+      target.NumberOfVoxels += source.NumberOfVoxels;
+      for (int dim = 0; dim < 3; ++dim)
+      {
+        target.IndexSum[dim] += source.IndexSum[dim];
+        target.Min[dim] = std::min(target.Min[dim], source.Min[dim]);
+        target.Max[dim] = std::max(target.Max[dim], source.Max[dim]);
+      }
+    }
+  }
+
+  m_LabelRegions.clear();
+  for (const auto &entry : merged)
+  {
+    LabelRegion &labelRegion = m_LabelRegions[entry.first];
+    labelRegion.NumberOfVoxels = entry.second.NumberOfVoxels;
+    for (unsigned int dim = 0; dim < 3; ++dim)
+    {
+      labelRegion.CenterOfMassIndex[dim] = entry.second.IndexSum[dim] / entry.second.NumberOfVoxels;
+      labelRegion.BoundingBox.SetIndex(dim, entry.second.Min[dim]);
+      labelRegion.BoundingBox.SetSize(dim, entry.second.Max[dim] - entry.second.Min[dim] + 1);
+    }
+  }
+  m_LabelRegionsValid = true;
+}
+
+std::vector<mitk::LabelRegionIndex::PixelType> mitk::LabelRegionIndex::GetLabels() const
+{
+  if (!m_LabelRegionsValid)
+    this->MergeBricks();
+
+  std::vector<PixelType> labels;
+  labels.reserve(m_LabelRegions.size());
+  for (const auto &entry : m_LabelRegions)
+    labels.push_back(entry.first);
+
+  return labels;
+}
+
+bool mitk::LabelRegionIndex::HasLabel(PixelType pixelValue) const
+{
+  if (!m_LabelRegionsValid)
+    this->MergeBricks();
+
+  return m_LabelRegions.find(pixelValue) != m_LabelRegions.end();
+}
+
+mitk::LabelRegionIndex::LabelRegion mitk::LabelRegionIndex::GetLabelRegion(PixelType pixelValue) const
+{
+  if (!m_LabelRegionsValid)
+    this->MergeBricks();
+
+  auto it = m_LabelRegions.find(pixelValue);
+  if (it == m_LabelRegions.end())
+    return LabelRegion();
+
+  return it->second;
+}
@@ -0,0 +1,120 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef __mitkLabelRegionIndex_H_
+#define __mitkLabelRegionIndex_H_
+
+#include "MitkMultilabelExports.h"
+
+#include <mitkCommon.h>
+#include <mitkLabel.h>
+
+#include <itkImageRegion.h>
+#include <itkObject.h>
+#include <itkObjectFactory.h>
+
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace mitk
+{
+  //
+  // Documentation
+  // @brief Voxel count, center of mass and bounding box of all labels of a label volume.
+  //
+  // All labels are collected in a single pass over the volume. The volume is divided into bricks of
+  // BRICK_EDGE_LENGTH^3 voxels and the index keeps the partial results of every brick, so that after a
+  // modification only the bricks intersecting the modified region have to be scanned again.
+  //
+  // All results are given in index coordinates of the volume.
+  // @ingroup Data
+  //
+  class MITKMULTILABEL_EXPORT LabelRegionIndex : public itk::Object
+  {
+  public:
+    mitkClassMacroItkParent(LabelRegionIndex, itk::Object);
+    itkNewMacro(Self);
+
+    typedef mitk::Label::PixelType PixelType;
+    typedef itk::ImageRegion<3> RegionType;
+
+    /** Edge length of a brick in voxels. */
+    static const unsigned int BRICK_EDGE_LENGTH = 32;
+
+    struct LabelRegion
+    {
+      LabelRegion();
+
+      std::size_t NumberOfVoxels;
+      mitk::Point3D CenterOfMassIndex;
+      RegionType BoundingBox;
+    };
+
+    /**
+     * @brief Sets the size of the indexed volume and clears the index.
+     */
+    void Initialize(const unsigned int *dimensions);
+
+    /**
+     * @brief Rebuilds the index from the volume @a volume, which has the size given to Initialize().
+     */
+    void Update(const PixelType *volume);
+
+    /**
+     * @brief Updates the index after only the voxels within @a modifiedRegion of @a volume have been changed.
+     */
+    void Update(const PixelType *volume, const RegionType &modifiedRegion);
+
+    /**
+     * @brief Returns all label values that occur in the volume, including the exterior label.
+     */
+    std::vector<PixelType> GetLabels() const;
+
+    bool HasLabel(PixelType pixelValue) const;
+
+    /**
+     * @brief Returns the region of the label @a pixelValue. The number of voxels is zero for labels that do
+     *        not occur in the volume.
+     */
+    LabelRegion GetLabelRegion(PixelType pixelValue) const;
+
+  protected:
+    LabelRegionIndex();
+    ~LabelRegionIndex() override;
+
+  private:
+    struct BrickEntry
+    {
+      std::size_t NumberOfVoxels;
+      double IndexSum[3];
+      RegionType::IndexValueType Min[3];
+      RegionType::IndexValueType Max[3];
+    };
+
+    typedef std::vector<std::pair<PixelType, BrickEntry>> BrickType;
+
+    void UpdateBrick(const PixelType *volume, std::size_t bx, std::size_t by, std::size_t bz);
+
+    void MergeBricks() const;
+
+    std::size_t m_Dimensions[3];
+    std::size_t m_BricksPerDimension[3];
+
+    std::vector<BrickType> m_Bricks;
+
+    mutable std::map<PixelType, LabelRegion> m_LabelRegions;
+    mutable bool m_LabelRegionsValid;
+  };
+} // namespace mitk
+
+#endif // __mitkLabelRegionIndex_H_
@@ -16,6 +16,8 @@ found in the LICENSE file.
 #include "mitkImageCast.h"
 #include "mitkImagePixelReadAccessor.h"
 #include "mitkImagePixelWriteAccessor.h"
+#include "mitkImageReadAccessor.h"
+#include "mitkImageWriteAccessor.h"
 #include "mitkInteractionConst.h"
 #include "mitkLookupTableProperty.h"
 #include "mitkPadImageFilter.h"
@@ -34,30 +36,26 @@ found in the LICENSE file.
 
 #include <itkCommand.h>
 
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
 template <typename TPixel, unsigned int VDimensions>
 void SetToZero(itk::Image<TPixel, VDimensions> *source)
 {
   source->FillBuffer(0);
 }
 
-template <unsigned int VImageDimension = 3>
-void CreateLabelMaskProcessing(mitk::Image *layerImage, mitk::Image *mask, mitk::LabelSet::PixelType index)
+template <typename TPixel, unsigned int VDimensions>
+void ImportLayerProcessing(itk::Image<TPixel, VDimensions> *source, mitk::SparseLabelLayer *layer)
 {
-  mitk::ImagePixelReadAccessor<mitk::LabelSet::PixelType, VImageDimension> readAccessor(layerImage);
-  mitk::ImagePixelWriteAccessor<mitk::LabelSet::PixelType, VImageDimension> writeAccessor(mask);
-
-  std::size_t numberOfPixels = 1;
-  for (int dim = 0; dim < static_cast<int>(VImageDimension); ++dim)
-    numberOfPixels *= static_cast<std::size_t>(readAccessor.GetDimension(dim));
-
-  auto src = readAccessor.GetData();
-  auto dest = writeAccessor.GetData();
-
-  for (std::size_t i = 0; i < numberOfPixels; ++i)
-  {
-    if (index == *(src + i))
-      *(dest + i) = 1;
-  }
+  const auto numberOfPixels = source->GetLargestPossibleRegion().GetNumberOfPixels();
+  std::vector<mitk::SparseLabelLayer::PixelType> buffer(numberOfPixels);
+  std::transform(source->GetBufferPointer(),
+                 source->GetBufferPointer() + numberOfPixels,
+                 buffer.begin(),
+                 [](TPixel value) { return static_cast<mitk::SparseLabelLayer::PixelType>(value); });
+  layer->Import(buffer.data());
 }
 
 mitk::LabelSetImage::LabelSetImage()
@@ -93,10 +91,12 @@ mitk::LabelSetImage::LabelSetImage(const mitk::LabelSetImage &other)
     lsClone->AddObserver(itk::ModifiedEvent(), command);
     m_LabelSetContainer.push_back(lsClone);
 
-    // clone layer Image data
-    mitk::Image::Pointer liClone = other.GetLayerImage(i)->Clone();
-    m_LayerContainer.push_back(liClone);
+    // clone layer data
+    other.UpdateLayerStorage(i);
+    m_LayerContainer.push_back(other.m_LayerContainer[i]->Clone());
   }
+  m_LayerImages.resize(m_LayerContainer.size());
+  m_LabelRegionIndices.resize(m_LayerContainer.size());
 
   // Add some DICOM Tags as properties to segmentation image
   DICOMSegmentationPropertyHelper::DeriveDICOMSegmentationProperties(this);
@@ -104,7 +104,21 @@ mitk::LabelSetImage::LabelSetImage(const mitk::LabelSetImage &other)
 
 void mitk::LabelSetImage::OnLabelSetModified()
 {
+  // label properties do not change the image data, so label regions that are up to date stay valid
+  std::vector<LabelRegionIndex *> upToDateIndices;
+  if (GetActiveLayer() < m_LabelRegionIndices.size())
+  {
+    for (auto &index : m_LabelRegionIndices[GetActiveLayer()])
+    {
+      if (index.IsNotNull() && index->GetMTime() > this->GetMTime())
+        upToDateIndices.push_back(index);
+    }
+  }
+
   Superclass::Modified();
+
+  for (auto index : upToDateIndices)
+    index->Modified();
 }
 
 void mitk::LabelSetImage::SetExteriorLabel(mitk::Label *label)
@@ -162,14 +176,183 @@ mitk::LabelSetImage::~LabelSetImage()
 
 mitk::Image *mitk::LabelSetImage::GetLayerImage(unsigned int layer)
 {
-  return m_LayerContainer[layer];
+  return const_cast<mitk::Image *>(static_cast<const Self *>(this)->GetLayerImage(layer));
 }
 
 const mitk::Image *mitk::LabelSetImage::GetLayerImage(unsigned int layer) const
 {
+  if (layer >= this->GetNumberOfLayers())
+    mitkThrow() << "Invalid layer.";
+
+  if (layer == this->GetActiveLayer() && !m_activeLayerInvalid)
+    return this;
+
+  // the image is the reference for the layer from now on, the storage is updated from it before it is read
+  if (m_LayerImages[layer].IsNull())
+    m_LayerImages[layer] = this->CreateLayerImage(layer);
+
+  return m_LayerImages[layer];
+}
+
+const mitk::SparseLabelLayer *mitk::LabelSetImage::GetLayerStorage(unsigned int layer) const
+{
+  this->UpdateLayerStorage(layer);
   return m_LayerContainer[layer];
 }
 
+mitk::Image::Pointer mitk::LabelSetImage::CreateLayerImage(unsigned int layer) const
+{
+  if (layer >= this->GetNumberOfLayers())
+    mitkThrow() << "Invalid layer.";
+
+  mitk::Image::Pointer layerImage = mitk::Image::New();
+  layerImage->Initialize(this->GetPixelType(),
+                         this->GetDimension(),
+                         this->GetDimensions(),
+                         this->GetImageDescriptor()->GetNumberOfChannels());
+  layerImage->SetTimeGeometry(this->GetTimeGeometry()->Clone());
+
+  if (layer == this->GetActiveLayer() && !m_activeLayerInvalid)
+  {
+    // the volumes are copied not before one of the images is written
+    for (unsigned int timeStep = 0; timeStep < this->GetTimeSteps(); ++timeStep)
+      layerImage->SetSharedVolume(this, timeStep, 0, timeStep, 0);
+    return layerImage;
+  }
+
+  this->UpdateLayerStorage(layer);
+  ImageWriteAccessor accessor(layerImage);
+  m_LayerContainer[layer]->Export(static_cast<PixelType *>(accessor.GetData()));
+
+  return layerImage;
+}
+
+void mitk::LabelSetImage::UpdateLayerStorage(unsigned int layer) const
+{
+  const mitk::Image *layerImage = m_LayerImages[layer];
+  if (nullptr == layerImage || layerImage->GetMTime() <= m_LayerContainer[layer]->GetMTime())
+    return;
+
+  ImageReadAccessor accessor(layerImage);
+  m_LayerContainer[layer]->Import(static_cast<const PixelType *>(accessor.GetData()));
+}
+
+mitk::Image::Pointer mitk::LabelSetImage::CreateLayerImage(unsigned int layer,
+                                                           const mitk::PlaneGeometry *plane,
+                                                           unsigned int timeStep) const
+{
+  if (layer >= this->GetNumberOfLayers() || nullptr == plane || !this->IsValidTimeStep(timeStep))
+    mitkThrow() << "Invalid layer, plane or time step.";
+
+  itk::ImageRegion<3> largestRegion;
+  for (unsigned int dim = 0; dim < 3; ++dim)
+    largestRegion.SetSize(dim, this->GetDimension(dim));
+
+  itk::ImageRegion<3> region = this->GetIndexRegion(plane, timeStep);
+  if (!region.Crop(largestRegion))
+    return nullptr;
+
+  // the image covers the region within the geometry of the time step
+  auto geometry = this->GetGeometry(timeStep)->Clone();
+  mitk::Point3D origin;
+  for (unsigned int dim = 0; dim < 3; ++dim)
+    origin[dim] = region.GetIndex(dim);
+  geometry->IndexToWorld(origin, origin);
+  geometry->SetOrigin(origin);
+
+  mitk::BaseGeometry::BoundsArrayType bounds = geometry->GetBounds();
+  for (unsigned int dim = 0; dim < 3; ++dim)
+  {
+    bounds[2 * dim] = 0;
+    bounds[2 * dim + 1] = region.GetSize(dim);
+  }
+  geometry->SetBounds(bounds);
+
+  mitk::Image::Pointer layerImage = mitk::Image::New();
+  layerImage->Initialize(this->GetPixelType(), *geometry);
+
+  ImageWriteAccessor accessor(layerImage);
+  this->ExportLayerRegion(layer, timeStep, region, static_cast<PixelType *>(accessor.GetData()));
+
+  return layerImage;
+}
+
+void mitk::LabelSetImage::ExportLayerRegion(unsigned int layer,
+                                            unsigned int timeStep,
+                                            const itk::ImageRegion<3> &region,
+                                            PixelType *buffer) const
+{
+  const unsigned int *dimensions = this->GetDimensions();
+
+  if (layer != this->GetActiveLayer() || m_activeLayerInvalid)
+  {
+    // the layer storage stacks the volumes of all time steps along z
+    itk::ImageRegion<3> layerRegion = region;
+    layerRegion.SetIndex(2, region.GetIndex(2) + static_cast<itk::IndexValueType>(timeStep) * dimensions[2]);
+    this->UpdateLayerStorage(layer);
+    m_LayerContainer[layer]->Export(buffer, layerRegion);
+    return;
+  }
+
+  ImageReadAccessor accessor(this, this->GetVolumeData(timeStep));
+  auto volume = static_cast<const PixelType *>(accessor.GetData());
+
+  const auto &start = region.GetIndex();
+  const auto &size = region.GetSize();
+  for (std::size_t z = 0; z < size[2]; ++z)
+  {
+    for (std::size_t y = 0; y < size[1]; ++y)
+    {
+      const PixelType *row = volume + ((start[2] + z) * dimensions[1] + start[1] + y) * dimensions[0] + start[0];
+      buffer = std::copy(row, row + size[0], buffer);
+    }
+  }
+}
+
+itk::ImageRegion<3> mitk::LabelSetImage::GetIndexRegion(const mitk::PlaneGeometry *plane, unsigned int timeStep) const
+{
+  const mitk::BaseGeometry *geometry = this->GetGeometry(timeStep);
+  itk::Index<3> min;
+  itk::Index<3> max;
+  for (int corner = 0; corner < 8; ++corner)
+  {
+    mitk::Point3D index;
+    geometry->WorldToIndex(plane->GetCornerPoint(corner), index);
+    for (unsigned int dim = 0; dim < 3; ++dim)
+    {
+      const auto value = static_cast<itk::IndexValueType>(std::floor(index[dim] + 0.5));
+      min[dim] = 0 == corner ? value : std::min(min[dim], value);
+      max[dim] = 0 == corner ? value : std::max(max[dim], value);
+    }
+  }
+
+  // the margin covers the voxels touched by a slice along the plane
+  itk::ImageRegion<3> region;
+  for (unsigned int dim = 0; dim < 3; ++dim)
+  {
+    region.SetIndex(dim, min[dim] - 1);
+    region.SetSize(dim, static_cast<itk::SizeValueType>(max[dim] - min[dim] + 3));
+  }
+
+  return region;
+}
+
+void mitk::LabelSetImage::LayerContainerToImage(unsigned int layer)
+{
+  // the active layer is edited in the image buffer, the dense image of the layer is not needed anymore
+  this->UpdateLayerStorage(layer);
+  m_LayerImages[layer] = nullptr;
+
+  ImageWriteAccessor accessor(this);
+  m_LayerContainer[layer]->Export(static_cast<PixelType *>(accessor.GetData()));
+}
+
+void mitk::LabelSetImage::ImageToLayerContainer(unsigned int layer)
+{
+  ImageReadAccessor accessor(this);
+  m_LayerContainer[layer]->Import(static_cast<const PixelType *>(accessor.GetData()));
+}
+
 unsigned int mitk::LabelSetImage::GetActiveLayer() const
 {
   return m_ActiveLayer;
@@ -200,6 +383,8 @@ void mitk::LabelSetImage::RemoveLayer()
   // remove labelset and image data
   m_LabelSetContainer.erase(m_LabelSetContainer.begin() + layerToDelete);
   m_LayerContainer.erase(m_LayerContainer.begin() + layerToDelete);
+  m_LayerImages.erase(m_LayerImages.begin() + layerToDelete);
+  m_LabelRegionIndices.erase(m_LabelRegionIndices.begin() + layerToDelete);
 
   if (layerToDelete == 0)
   {
@@ -211,28 +396,52 @@ void mitk::LabelSetImage::RemoveLayer()
 
 unsigned int mitk::LabelSetImage::AddLayer(mitk::LabelSet::Pointer lset)
 {
-  mitk::Image::Pointer newImage = mitk::Image::New();
-  newImage->Initialize(this->GetPixelType(),
-                       this->GetDimension(),
-                       this->GetDimensions(),
-                       this->GetImageDescriptor()->GetNumberOfChannels());
-  newImage->SetTimeGeometry(this->GetTimeGeometry()->Clone());
+  // a new layer only contains the exterior label and therefore does not allocate any bricks
+  mitk::SparseLabelLayer::Pointer newLayer = mitk::SparseLabelLayer::New();
+  newLayer->Initialize(this->GetDimension(), this->GetDimensions());
+
+  unsigned int newLabelSetId = this->InsertLayer(newLayer, lset);
+
+  return newLabelSetId;
+}
+
+unsigned int mitk::LabelSetImage::AddLayer(mitk::Image::Pointer layerImage, mitk::LabelSet::Pointer lset)
+{
+  mitk::SparseLabelLayer::Pointer newLayer = mitk::SparseLabelLayer::New();
+  newLayer->Initialize(this->GetDimension(), this->GetDimensions());
+
+  std::size_t numberOfPixels = 1;
+  for (unsigned int dim = 0; dim < layerImage->GetDimension(); ++dim)
+    numberOfPixels *= layerImage->GetDimension(dim);
+
+  if (numberOfPixels != newLayer->GetNumberOfVoxels())
+    mitkThrow() << "Layer image does not match the size of the label set image.";
 
-  if (newImage->GetDimension() < 4)
+  try
   {
-    AccessByItk(newImage, SetToZero);
+    if (layerImage->GetPixelType() == this->GetPixelType())
+    {
+      ImageReadAccessor accessor(layerImage);
+      newLayer->Import(static_cast<const PixelType *>(accessor.GetData()));
+    }
+    else if (4 == layerImage->GetDimension())
+    {
+      AccessFixedDimensionByItk_1(layerImage, ImportLayerProcessing, 4, newLayer.GetPointer());
+    }
+    else
+    {
+      AccessByItk_1(layerImage, ImportLayerProcessing, newLayer.GetPointer());
+    }
   }
-  else
+  catch (itk::ExceptionObject &e)
   {
-    AccessFixedDimensionByItk(newImage, SetToZero, 4);
+    mitkThrow() << e.GetDescription();
   }
 
-  unsigned int newLabelSetId = this->AddLayer(newImage, lset);
-
-  return newLabelSetId;
+  return this->InsertLayer(newLayer, lset);
 }
 
-unsigned int mitk::LabelSetImage::AddLayer(mitk::Image::Pointer layerImage, mitk::LabelSet::Pointer lset)
+unsigned int mitk::LabelSetImage::InsertLayer(mitk::SparseLabelLayer::Pointer layer, mitk::LabelSet::Pointer lset)
 {
   unsigned int newLabelSetId = m_LayerContainer.size();
 
@@ -253,8 +462,10 @@ unsigned int mitk::LabelSetImage::AddLayer(mitk::Image::Pointer layerImage, mitk
   // Add exterior Label to label set
   // mitk::Label::Pointer exteriorLabel = CreateExteriorLabel();
 
-  // push a new working image for the new layer
-  m_LayerContainer.push_back(layerImage);
+  // push the storage for the new layer
+  m_LayerContainer.push_back(layer);
+  m_LayerImages.emplace_back();
+  m_LabelRegionIndices.emplace_back();
 
   // push a new labelset for the new layer
   m_LabelSetContainer.push_back(ls);
@@ -299,47 +510,25 @@ void mitk::LabelSetImage::SetActiveLayer(unsigned int layer)
 {
   try
   {
-    if (4 == this->GetDimension())
+    if ((layer != GetActiveLayer() || m_activeLayerInvalid) && (layer < this->GetNumberOfLayers()))
     {
-      if ((layer != GetActiveLayer() || m_activeLayerInvalid) && (layer < this->GetNumberOfLayers()))
-      {
-        BeforeChangeLayerEvent.Send();
+      BeforeChangeLayerEvent.Send();
 
-        if (m_activeLayerInvalid)
-        {
-          // We should not write the invalid layer back to the vector
-          m_activeLayerInvalid = false;
-        }
-        else
-        {
-          AccessFixedDimensionByItk_n(this, ImageToLayerContainerProcessing, 4, (GetActiveLayer()));
-        }
-        m_ActiveLayer = layer; // only at this place m_ActiveLayer should be manipulated!!! Use Getter and Setter
-        AccessFixedDimensionByItk_n(this, LayerContainerToImageProcessing, 4, (GetActiveLayer()));
-
-        AfterChangeLayerEvent.Send();
+      if (m_activeLayerInvalid)
+      {
+        // We should not write the invalid layer back to the vector
+        m_activeLayerInvalid = false;
       }
-    }
-    else
-    {
-      if ((layer != GetActiveLayer() || m_activeLayerInvalid) && (layer < this->GetNumberOfLayers()))
+      else
       {
-        BeforeChangeLayerEvent.Send();
-
-        if (m_activeLayerInvalid)
-        {
-          // We should not write the invalid layer back to the vector
-          m_activeLayerInvalid = false;
-        }
-        else
-        {
-          AccessByItk_1(this, ImageToLayerContainerProcessing, GetActiveLayer());
-        }
-        m_ActiveLayer = layer; // only at this place m_ActiveLayer should be manipulated!!! Use Getter and Setter
-        AccessByItk_1(this, LayerContainerToImageProcessing, GetActiveLayer());
-
-        AfterChangeLayerEvent.Send();
+        this->ImageToLayerContainer(GetActiveLayer());
+        m_LabelRegionIndices[GetActiveLayer()].clear();
       }
+      m_ActiveLayer = layer; // only at this place m_ActiveLayer should be manipulated!!! Use Getter and Setter
+      this->LayerContainerToImage(GetActiveLayer());
+      m_LabelRegionIndices[GetActiveLayer()].clear();
+
+      AfterChangeLayerEvent.Send();
     }
   }
   catch (itk::ExceptionObject &e)
@@ -517,14 +706,116 @@ mitk::LabelSet *mitk::LabelSetImage::GetActiveLabelSet()
 
 void mitk::LabelSetImage::UpdateCenterOfMass(PixelType pixelValue, unsigned int layer)
 {
-  if (4 == this->GetDimension())
+  mitk::Label *label = GetLabel(pixelValue, layer);
+  if (label == nullptr)
+    return;
+
+  // the center of mass of all time steps, weighted by the number of voxels of the label in each time step
+  std::size_t numberOfVoxels = 0;
+  mitk::Vector3D indexSum;
+  mitk::Vector3D worldSum;
+  indexSum.Fill(0.0);
+  worldSum.Fill(0.0);
+
+  for (unsigned int timeStep = 0; timeStep < this->GetTimeSteps(); ++timeStep)
   {
-    AccessFixedDimensionByItk_2(this, CalculateCenterOfMassProcessing, 4, pixelValue, layer);
+    const auto labelRegion = this->GetLabelRegion(pixelValue, layer, timeStep);
+    if (labelRegion.NumberOfVoxels == 0)
+      continue;
+
+    mitk::Point3D world;
+    this->GetSlicedGeometry(timeStep)->IndexToWorld(labelRegion.CenterOfMassIndex, world);
+
+    const double weight = static_cast<double>(labelRegion.NumberOfVoxels);
+    indexSum += labelRegion.CenterOfMassIndex.GetVectorFromOrigin() * weight;
+    worldSum += world.GetVectorFromOrigin() * weight;
+    numberOfVoxels += labelRegion.NumberOfVoxels;
+  }
+
+  mitk::Point3D pos;
+  mitk::Point3D world;
+  pos.Fill(0.0);
+  world.Fill(0.0);
+  if (numberOfVoxels > 0)
+  {
+    pos += indexSum / static_cast<double>(numberOfVoxels);
+    world += worldSum / static_cast<double>(numberOfVoxels);
+  }
+
+  label->SetCenterOfMassIndex(pos);
+  label->SetCenterOfMassCoordinates(world);
+}
+
+mitk::LabelRegionIndex *mitk::LabelSetImage::GetLabelRegionIndex(unsigned int layer, unsigned int timeStep)
+{
+  if (layer >= this->GetNumberOfLayers() || !this->IsValidTimeStep(timeStep))
+    mitkThrow() << "Invalid layer or time step.";
+
+  auto &indices = m_LabelRegionIndices[layer];
+  if (indices.size() <= timeStep)
+    indices.resize(timeStep + 1);
+
+  // inactive layers are modified only through their image (see GetLayerImage()), which updates their storage
+  auto &index = indices[timeStep];
+  const bool isActiveLayer = layer == this->GetActiveLayer() && !m_activeLayerInvalid;
+  if (!isActiveLayer)
+    this->UpdateLayerStorage(layer);
+  const auto modifiedTime = isActiveLayer ? this->GetMTime() : m_LayerContainer[layer]->GetMTime();
+  if (index.IsNotNull() && index->GetMTime() > modifiedTime)
+    return index;
+
+  index = LabelRegionIndex::New();
+  index->Initialize(this->GetDimensions());
+
+  if (isActiveLayer)
+  {
+    ImageReadAccessor accessor(this, this->GetVolumeData(timeStep));
+    index->Update(static_cast<const PixelType *>(accessor.GetData()));
   }
   else
   {
-    AccessByItk_2(this, CalculateCenterOfMassProcessing, pixelValue, layer);
+    itk::ImageRegion<3> largestRegion;
+    for (unsigned int dim = 0; dim < 3; ++dim)
+      largestRegion.SetSize(dim, this->GetDimension(dim));
+
+    std::vector<PixelType> volume(largestRegion.GetNumberOfPixels());
+    this->ExportLayerRegion(layer, timeStep, largestRegion, volume.data());
+    index->Update(volume.data());
   }
+
+  return index;
+}
+
+mitk::LabelRegionIndex::LabelRegion mitk::LabelSetImage::GetLabelRegion(PixelType pixelValue,
+                                                                        unsigned int layer,
+                                                                        unsigned int timeStep)
+{
+  return this->GetLabelRegionIndex(layer, timeStep)->GetLabelRegion(pixelValue);
+}
+
+void mitk::LabelSetImage::UpdateLabelRegions(const itk::ImageRegion<3> &modifiedRegion, unsigned int timeStep)
+{
+  if (GetActiveLayer() >= m_LabelRegionIndices.size() || !this->IsValidTimeStep(timeStep))
+    return;
+
+  // indices that do not exist yet are built completely on the next request
+  auto &indices = m_LabelRegionIndices[GetActiveLayer()];
+  if (indices.size() <= timeStep || indices[timeStep].IsNull())
+    return;
+
+  ImageReadAccessor accessor(this, this->GetVolumeData(timeStep));
+  indices[timeStep]->Update(static_cast<const PixelType *>(accessor.GetData()), modifiedRegion);
+
+  // marks the index as up to date with the modification, also if the region is outside of the image
+  indices[timeStep]->Modified();
+}
+
+void mitk::LabelSetImage::UpdateLabelRegions(const mitk::PlaneGeometry *plane, unsigned int timeStep)
+{
+  if (nullptr == plane || !this->IsValidTimeStep(timeStep))
+    return;
+
+  this->UpdateLabelRegions(this->GetIndexRegion(plane, timeStep), timeStep);
 }
 
 unsigned int mitk::LabelSetImage::GetNumberOfLabels(unsigned int layer) const
@@ -570,50 +861,114 @@ void mitk::LabelSetImage::MaskStamp(mitk::Image *mask, bool forceOverwrite)
 
 mitk::Image::Pointer mitk::LabelSetImage::CreateLabelMask(PixelType index, bool useActiveLayer, unsigned int layer)
 {
-  auto previousActiveLayer = this->GetActiveLayer();
   auto mask = mitk::Image::New();
 
   try
   {
+    const unsigned int sourceLayer = useActiveLayer ? this->GetActiveLayer() : layer;
+
     mask->Initialize(this);
 
-    auto byteSize = sizeof(LabelSetImage::PixelType);
-    for (unsigned int dim = 0; dim < mask->GetDimension(); ++dim)
-      byteSize *= mask->GetDimension(dim);
+    const unsigned int *dimensions = this->GetDimensions();
+    const std::size_t sliceSize = static_cast<std::size_t>(dimensions[0]) * dimensions[1];
+    const std::size_t volumeSize = sliceSize * dimensions[2];
 
+    for (unsigned int timeStep = 0; timeStep < this->GetTimeSteps(); ++timeStep)
     {
-      ImageWriteAccessor accessor(mask);
-      memset(accessor.GetData(), 0, byteSize);
+      ImageWriteAccessor maskAccessor(mask, mask->GetVolumeData(timeStep));
+      auto dest = static_cast<PixelType *>(maskAccessor.GetData());
+      std::fill(dest, dest + volumeSize, 0);
+
+      // only the bounding box of the label has to be scanned
+      const auto labelRegion = this->GetLabelRegion(index, sourceLayer, timeStep);
+      if (labelRegion.NumberOfVoxels == 0)
+        continue;
+
+      std::vector<PixelType> box(labelRegion.BoundingBox.GetNumberOfPixels());
+      this->ExportLayerRegion(sourceLayer, timeStep, labelRegion.BoundingBox, box.data());
+      auto src = box.data();
+
+      const auto &start = labelRegion.BoundingBox.GetIndex();
+      const auto &size = labelRegion.BoundingBox.GetSize();
+      for (std::size_t z = start[2]; z < start[2] + size[2]; ++z)
+      {
+        for (std::size_t y = start[1]; y < start[1] + size[1]; ++y)
+        {
+          const std::size_t rowOffset = z * sliceSize + y * dimensions[0];
+          for (std::size_t x = start[0]; x < start[0] + size[0]; ++x, ++src)
+          {
+            if (index == *src)
+              dest[rowOffset + x] = 1;
+          }
+        }
+      }
     }
+  }
+  catch (...)
+  {
+    mitkThrow() << "Could not create a mask out of the selected label.";
+  }
 
-    if (!useActiveLayer)
-      this->SetActiveLayer(layer);
+  return mask;
+}
 
-    if (4 == this->GetDimension())
-    {
-      ::CreateLabelMaskProcessing<4>(this, mask, index);
-    }
-    else if (3 == this->GetDimension())
-    {
-      ::CreateLabelMaskProcessing(this, mask, index);
-    }
-    else
+mitk::Image::Pointer mitk::LabelSetImage::CreateCroppedLabelMask(PixelType index,
+                                                                 bool useActiveLayer,
+                                                                 unsigned int layer,
+                                                                 unsigned int timeStep)
+{
+  try
+  {
+    const unsigned int sourceLayer = useActiveLayer ? this->GetActiveLayer() : layer;
+    const auto labelRegion = this->GetLabelRegion(index, sourceLayer, timeStep);
+    if (labelRegion.NumberOfVoxels == 0)
+      return nullptr;
+
+    // the margin keeps the label off the border, e.g. for closed surfaces
+    LabelRegionIndex::RegionType largestRegion;
+    for (unsigned int dim = 0; dim < 3; ++dim)
+      largestRegion.SetSize(dim, this->GetDimension(dim));
+
+    LabelRegionIndex::RegionType cropRegion = labelRegion.BoundingBox;
+    cropRegion.PadByRadius(1);
+    cropRegion.Crop(largestRegion);
+
+    const auto &start = cropRegion.GetIndex();
+    const auto &size = cropRegion.GetSize();
+
+    // the mask covers the crop region within the geometry of the time step
+    auto geometry = this->GetGeometry(timeStep)->Clone();
+    mitk::Point3D origin;
+    for (unsigned int dim = 0; dim < 3; ++dim)
+      origin[dim] = start[dim];
+    geometry->IndexToWorld(origin, origin);
+    geometry->SetOrigin(origin);
+
+    mitk::BaseGeometry::BoundsArrayType bounds = geometry->GetBounds();
+    for (unsigned int dim = 0; dim < 3; ++dim)
     {
-      mitkThrow();
+      bounds[2 * dim] = 0;
+      bounds[2 * dim + 1] = size[dim];
     }
+    geometry->SetBounds(bounds);
+
+    auto mask = mitk::Image::New();
+    mask->Initialize(mitk::MakeScalarPixelType<PixelType>(), *geometry);
+
+    // the label values are copied into the mask and binarized in place
+    ImageWriteAccessor maskAccessor(mask, mask->GetVolumeData(0));
+    auto dest = static_cast<PixelType *>(maskAccessor.GetData());
+    this->ExportLayerRegion(sourceLayer, timeStep, cropRegion, dest);
+    std::transform(dest, dest + cropRegion.GetNumberOfPixels(), dest, [index](PixelType value) {
+      return static_cast<PixelType>(index == value ? 1 : 0);
+    });
+
+    return mask;
   }
   catch (...)
   {
-    if (!useActiveLayer)
-      this->SetActiveLayer(previousActiveLayer);
-
     mitkThrow() << "Could not create a mask out of the selected label.";
   }
-
-  if (!useActiveLayer)
-    this->SetActiveLayer(previousActiveLayer);
-
-  return mask;
 }
 
 void mitk::LabelSetImage::InitializeByLabeledImage(mitk::Image::Pointer image)
@@ -740,48 +1095,6 @@ void mitk::LabelSetImage::MaskStampProcessing(ImageType *itkImage, mitk::Image *
   this->Modified();
 }
 
-template <typename ImageType>
-void mitk::LabelSetImage::CalculateCenterOfMassProcessing(ImageType *itkImage, PixelType pixelValue, unsigned int layer)
-{
-  // for now, we just retrieve the voxel in the middle
-  typedef itk::ImageRegionConstIterator<ImageType> IteratorType;
-  IteratorType iter(itkImage, itkImage->GetLargestPossibleRegion());
-  iter.GoToBegin();
-
-  std::vector<typename ImageType::IndexType> indexVector;
-
-  while (!iter.IsAtEnd())
-  {
-    // TODO fix comparison warning more effective
-    if (iter.Get() == pixelValue)
-    {
-      indexVector.push_back(iter.GetIndex());
-    }
-    ++iter;
-  }
-
-  mitk::Point3D pos;
-  pos.Fill(0.0);
-
-  if (!indexVector.empty())
-  {
-    typename itk::ImageRegionConstIteratorWithIndex<ImageType>::IndexType centerIndex;
-    centerIndex = indexVector.at(indexVector.size() / 2);
-    if (centerIndex.GetIndexDimension() == 3)
-    {
-      pos[0] = centerIndex[0];
-      pos[1] = centerIndex[1];
-      pos[2] = centerIndex[2];
-    }
-    else
-      return;
-  }
-
-  GetLabelSet(layer)->GetLabel(pixelValue)->SetCenterOfMassIndex(pos);
-  this->GetSlicedGeometry()->IndexToWorld(pos, pos); // TODO: TimeGeometry?
-  GetLabelSet(layer)->GetLabel(pixelValue)->SetCenterOfMassCoordinates(pos);
-}
-
 template <typename ImageType>
 void mitk::LabelSetImage::ClearBufferProcessing(ImageType *itkImage)
 {
@@ -818,57 +1131,6 @@ void mitk::LabelSetImage::ConcatenateProcessing(ImageType *itkTarget, mitk::Labe
   }
 }
 
-template <typename TPixel, unsigned int VImageDimension>
-void mitk::LabelSetImage::LayerContainerToImageProcessing(itk::Image<TPixel, VImageDimension> *target,
-                                                          unsigned int layer)
-{
-  typedef itk::Image<TPixel, VImageDimension> ImageType;
-  typename ImageType::Pointer itkSource;
-  // mitk::CastToItkImage(m_LayerContainer[layer], itkSource);
-  itkSource = ImageToItkImage<TPixel, VImageDimension>(m_LayerContainer[layer]);
-  typedef itk::ImageRegionConstIterator<ImageType> SourceIteratorType;
-  typedef itk::ImageRegionIterator<ImageType> TargetIteratorType;
-
-  SourceIteratorType sourceIter(itkSource, itkSource->GetLargestPossibleRegion());
-  sourceIter.GoToBegin();
-
-  TargetIteratorType targetIter(target, target->GetLargestPossibleRegion());
-  targetIter.GoToBegin();
-
-  while (!sourceIter.IsAtEnd())
-  {
-    targetIter.Set(sourceIter.Get());
-    ++sourceIter;
-    ++targetIter;
-  }
-}
-
-template <typename TPixel, unsigned int VImageDimension>
-void mitk::LabelSetImage::ImageToLayerContainerProcessing(itk::Image<TPixel, VImageDimension> *source,
-                                                          unsigned int layer) const
-{
-  typedef itk::Image<TPixel, VImageDimension> ImageType;
-  typename ImageType::Pointer itkTarget;
-  // mitk::CastToItkImage(m_LayerContainer[layer], itkTarget);
-  itkTarget = ImageToItkImage<TPixel, VImageDimension>(m_LayerContainer[layer]);
-
-  typedef itk::ImageRegionConstIterator<ImageType> SourceIteratorType;
-  typedef itk::ImageRegionIterator<ImageType> TargetIteratorType;
-
-  SourceIteratorType sourceIter(source, source->GetLargestPossibleRegion());
-  sourceIter.GoToBegin();
-
-  TargetIteratorType targetIter(itkTarget, itkTarget->GetLargestPossibleRegion());
-  targetIter.GoToBegin();
-
-  while (!sourceIter.IsAtEnd())
-  {
-    targetIter.Set(sourceIter.Get());
-    ++sourceIter;
-    ++targetIter;
-  }
-}
-
 template <typename ImageType>
 void mitk::LabelSetImage::EraseLabelProcessing(ImageType *itkImage, PixelType pixelValue, unsigned int /*layer*/)
 {
@@ -966,8 +1228,8 @@ bool mitk::Equal(const mitk::LabelSetImage &leftHandSide,
     else
     {
       // layer image data
-      returnValue =
-        mitk::Equal(*leftHandSide.GetLayerImage(layerIndex), *rightHandSide.GetLayerImage(layerIndex), eps, verbose);
+      returnValue = mitk::Equal(
+        *leftHandSide.CreateLayerImage(layerIndex), *rightHandSide.CreateLayerImage(layerIndex), eps, verbose);
       if (!returnValue)
       {
         MITK_INFO(verbose) << "Layer image data not equal.";
@@ -14,7 +14,9 @@ found in the LICENSE file.
 #define __mitkLabelSetImage_H_
 
 #include <mitkImage.h>
+#include <mitkLabelRegionIndex.h>
 #include <mitkLabelSet.h>
+#include <mitkSparseLabelLayer.h>
 
 #include <MitkMultilabelExports.h>
 
@@ -24,6 +26,9 @@ namespace mitk
   //## @brief LabelSetImage class for handling labels and layers in a segmentation session.
   //##
   //## Handles operations for adding, removing, erasing and editing labels and layers.
+  //##
+  //## The image buffer always holds the active layer. All other layers are kept in a block-sparse
+  //## storage (see SparseLabelLayer), so that their memory consumption scales with the segmented volume.
   //## @ingroup Data
 
   class MITKMULTILABEL_EXPORT LabelSetImage : public Image
@@ -83,9 +88,37 @@ namespace mitk
     void MergeLabels(PixelType pixelValue, std::vector<PixelType>& vectorOfSourcePixelValues, unsigned int layer = 0);
 
     /**
-      * \brief  */
+     * @brief Sets the center of mass of the label @a pixelValue of the given layer, averaged over all time steps
+     *        and weighted by the number of voxels of the label in each time step.
+     *        The values are taken from the label region index, see GetLabelRegion().
+     */
     void UpdateCenterOfMass(PixelType pixelValue, unsigned int layer = 0);
 
+    /**
+     * @brief Returns voxel count, center of mass and bounding box (in index coordinates) of a label.
+     *        The regions of all labels of a layer are computed in one pass and kept until the layer changes.
+     * @param pixelValue the label value
+     * @param layer the layer of the label
+     * @param timeStep the time step
+     */
+    LabelRegionIndex::LabelRegion GetLabelRegion(PixelType pixelValue, unsigned int layer = 0, unsigned int timeStep = 0);
+
+    /**
+     * @brief Updates the label regions of the active layer after only the voxels within @a modifiedRegion have
+     *        been changed. Only the part of the image around the region is scanned again. Has to be called after
+     *        the Modified() call of the change. Without this call, any modification of the image causes a complete
+     *        rescan on the next request.
+     * @param modifiedRegion the modified region in index coordinates
+     * @param timeStep the modified time step
+     */
+    void UpdateLabelRegions(const itk::ImageRegion<3> &modifiedRegion, unsigned int timeStep = 0);
+
+    /**
+     * @brief Updates the label regions of the active layer after a slice along @a plane has been written
+     *        into the image, see UpdateLabelRegions(const itk::ImageRegion<3> &, unsigned int).
+     */
+    void UpdateLabelRegions(const mitk::PlaneGeometry *plane, unsigned int timeStep = 0);
+
     /**
      * @brief Removes labels from the mitk::LabelSet of given layer.
      *        Calls mitk::LabelSetImage::EraseLabels() which also removes the labels from within the image.
@@ -185,6 +218,20 @@ namespace mitk
       * \brief  */
     mitk::Image::Pointer CreateLabelMask(PixelType index, bool useActiveLayer = true, unsigned int layer = 0);
 
+    /**
+     * @brief Creates a 3D mask of a label that only covers the bounding box of the label plus a margin of one voxel
+     *        (within the image). The mask is positioned at the same world coordinates as the label.
+     * @param index the label value
+     * @param useActiveLayer if true, the label is taken from the active layer, otherwise from @a layer
+     * @param layer the layer of the label
+     * @param timeStep the time step of the label, the mask is positioned within the geometry of this time step
+     * @return the 3D mask or nullptr if the label does not occur in the given time step
+     */
+    mitk::Image::Pointer CreateCroppedLabelMask(PixelType index,
+                                                bool useActiveLayer = true,
+                                                unsigned int layer = 0,
+                                                unsigned int timeStep = 0);
+
     /**
      * @brief Initialize a new mitk::LabelSetImage by an given image.
      * For all distinct pixel values of the parameter image new labels will
@@ -242,11 +289,43 @@ namespace mitk
     void RemoveLayer();
 
     /**
-      * \brief  */
+     * @brief Returns the image data of a layer, through which the layer can also be edited.
+     *        For the active layer this is the LabelSetImage itself. An inactive layer is held as dense image from the
+     *        first call on until the layer is activated or removed, and its sparse storage is updated from the image
+     *        whenever the image was modified. Prefer CreateLayerImage() to read and SetActiveLayer() to edit a layer.
+     * @param layer the layer ID
+     */
     mitk::Image *GetLayerImage(unsigned int layer);
 
     const mitk::Image *GetLayerImage(unsigned int layer) const;
 
+    /**
+     * @brief Creates an image of a layer, which is not kept by the LabelSetImage. Changes to the image do not reach
+     *        the layer. The image of the active layer shares the memory of the LabelSetImage until either is written.
+     * @param layer the layer ID
+     */
+    mitk::Image::Pointer CreateLayerImage(unsigned int layer) const;
+
+    /**
+     * @brief Creates a 3D image of the voxels of a layer around @a plane, e.g. to extract the slice of @a plane
+     *        without creating the whole layer image. The image covers the bounding box of the plane within the
+     *        image plus a margin of one voxel and is positioned at the same world coordinates as the layer.
+     * @param layer the layer ID
+     * @param plane the plane, in world coordinates
+     * @param timeStep the time step of the layer
+     * @return the image or nullptr if the plane does not intersect the image
+     */
+    mitk::Image::Pointer CreateLayerImage(unsigned int layer,
+                                          const mitk::PlaneGeometry *plane,
+                                          unsigned int timeStep) const;
+
+    /**
+     * @brief Returns the sparse storage of a layer. The storage of the active layer is only updated when another
+     *        layer is activated.
+     * @param layer the layer ID
+     */
+    const mitk::SparseLabelLayer *GetLayerStorage(unsigned int layer) const;
+
     void OnLabelSetModified();
 
     /**
@@ -273,14 +352,31 @@ namespace mitk
     template <typename ImageType1, typename ImageType2>
     void ChangeLayerProcessing(ImageType1 *source, ImageType2 *target);
 
-    template <typename TPixel, unsigned int VImageDimension>
-    void LayerContainerToImageProcessing(itk::Image<TPixel, VImageDimension> *source, unsigned int layer);
+    /** Adds the given layer storage as new layer and activates it. */
+    unsigned int InsertLayer(mitk::SparseLabelLayer::Pointer layer, mitk::LabelSet::Pointer lset);
 
-    template <typename TPixel, unsigned int VImageDimension>
-    void ImageToLayerContainerProcessing(itk::Image<TPixel, VImageDimension> *source, unsigned int layer) const;
+    /** Copies the layer storage of the given layer into the image buffer. */
+    void LayerContainerToImage(unsigned int layer);
 
-    template <typename ImageType>
-    void CalculateCenterOfMassProcessing(ImageType *input, PixelType index, unsigned int layer);
+    /** Copies the image buffer into the layer storage of the given layer. */
+    void ImageToLayerContainer(unsigned int layer);
+
+    /** Updates the storage of an inactive layer from the image handed out by GetLayerImage(), if it was modified. */
+    void UpdateLayerStorage(unsigned int layer) const;
+
+    /** Writes the voxels of a layer and time step within @a region to the dense buffer @a buffer, which has the size
+     * of the region. The voxels of inactive layers are read from the layer storage. */
+    void ExportLayerRegion(unsigned int layer,
+                           unsigned int timeStep,
+                           const itk::ImageRegion<3> &region,
+                           PixelType *buffer) const;
+
+    /** Returns the bounding box of @a plane in index coordinates of the given time step, plus a margin of one voxel.
+     * The region is not cropped to the image. */
+    itk::ImageRegion<3> GetIndexRegion(const mitk::PlaneGeometry *plane, unsigned int timeStep) const;
+
+    /** Returns the up to date label region index of a layer and time step. */
+    LabelRegionIndex *GetLabelRegionIndex(unsigned int layer, unsigned int timeStep);
 
     template <typename ImageType>
     void ClearBufferProcessing(ImageType *input);
@@ -304,7 +400,13 @@ namespace mitk
     void InitializeByLabeledImageProcessing(LabelSetImageType *input, ImageType *other);
 
     std::vector<LabelSet::Pointer> m_LabelSetContainer;
-    std::vector<Image::Pointer> m_LayerContainer;
+    std::vector<SparseLabelLayer::Pointer> m_LayerContainer;
+
+    /** Dense images of inactive layers handed out by GetLayerImage(), per layer. */
+    mutable std::vector<mitk::Image::Pointer> m_LayerImages;
+
+    /** Label regions per layer and time step, built on demand. */
+    std::vector<std::vector<LabelRegionIndex::Pointer>> m_LabelRegionIndices;
 
     int m_ActiveLayer;
 
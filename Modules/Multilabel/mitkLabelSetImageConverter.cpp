@@ -34,12 +34,14 @@ static void ConvertLabelSetImageToImage(const itk::Image<TPixel, VDimension> *,
   if (numberOfLayers > 1)
   {
     auto vectorImageComposer = ComposeFilterType::New();
-    auto activeLayer = labelSetImage->GetActiveLayer();
+
+    // the layer images are temporary, they have to be kept until the composer was updated
+    std::vector<mitk::Image::ConstPointer> layerImages;
 
     for (decltype(numberOfLayers) layer = 0; layer < numberOfLayers; ++layer)
     {
-      auto layerImage = mitk::ImageToItkImage<TPixel, VDimension>(
-        layer != activeLayer ? labelSetImage->GetLayerImage(layer) : labelSetImage);
+      layerImages.push_back(labelSetImage->CreateLayerImage(layer).GetPointer());
+      auto layerImage = mitk::ImageToItkImage<TPixel, VDimension>(layerImages.back().GetPointer());
 
       vectorImageComposer->SetInput(layer, layerImage);
     }
@@ -75,7 +77,7 @@ mitk::Image::Pointer mitk::ConvertLabelSetImageToImage(LabelSetImage::ConstPoint
     }
     else
     {
-      AccessByItk_2(labelSetImage->GetLayerImage(0), ::ConvertLabelSetImageToImage, labelSetImage, image);
+      AccessByItk_2(labelSetImage, ::ConvertLabelSetImageToImage, labelSetImage, image);
     }
   }
 
@@ -145,21 +145,35 @@ void mitk::LabelSetImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer
 
   for (int lidx = 0; lidx < numberOfLayers; ++lidx)
   {
-    mitk::Image *layerImage = nullptr;
+    mitk::Image::ConstPointer layerImage;
+    int layerTimeStep = this->GetTimestep();
 
     // set main input for ExtractSliceFilter
     if (lidx == activeLayer)
+    {
       layerImage = image;
-    else
-      layerImage = image->GetLayerImage(lidx);
+    }
+    else if (image->IsValidTimeStep(layerTimeStep))
+    {
+      // inactive layers are only read around the plane from their sparse storage, the image covers one time step
+      layerImage = image->CreateLayerImage(lidx, worldGeometry, layerTimeStep).GetPointer();
+      layerTimeStep = 0;
+    }
+
+    if (layerImage.IsNull())
+    {
+      localStorage->m_ReslicedImageVector[lidx] = nullptr;
+      localStorage->m_LayerMapperVector[lidx]->SetInputData(localStorage->m_EmptyPolyData);
+      continue;
+    }
 
     localStorage->m_ReslicerVector[lidx]->SetInput(layerImage);
     localStorage->m_ReslicerVector[lidx]->SetWorldGeometry(worldGeometry);
-    localStorage->m_ReslicerVector[lidx]->SetTimeStep(this->GetTimestep());
+    localStorage->m_ReslicerVector[lidx]->SetTimeStep(layerTimeStep);
 
     // set the transformation of the image to adapt reslice axis
     localStorage->m_ReslicerVector[lidx]->SetResliceTransformByGeometry(
-      layerImage->GetTimeGeometry()->GetGeometryForTimeStep(this->GetTimestep()));
+      layerImage->GetTimeGeometry()->GetGeometryForTimeStep(layerTimeStep));
 
     // is the geometry of the slice based on the image image or the worldgeometry?
     bool inPlaneResampleExtentByGeometry = false;
@@ -0,0 +1,201 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkSparseLabelLayer.h"
+
+#include <mitkExceptionMacro.h>
+
+#include <algorithm>
+#include <cstring>
+
+const unsigned int mitk::SparseLabelLayer::BRICK_EDGE_LENGTH;
+const std::size_t mitk::SparseLabelLayer::VOXELS_PER_BRICK;
+
+mitk::SparseLabelLayer::SparseLabelLayer()
+{
+  std::fill(m_Dimensions, m_Dimensions + 3, 0);
+  std::fill(m_BricksPerDimension, m_BricksPerDimension + 3, 0);
+}
+
+mitk::SparseLabelLayer::SparseLabelLayer(const SparseLabelLayer &other) : itk::Object()
+{
+  std::copy(other.m_Dimensions, other.m_Dimensions + 3, m_Dimensions);
+  std::copy(other.m_BricksPerDimension, other.m_BricksPerDimension + 3, m_BricksPerDimension);
+
+  m_Bricks.resize(other.m_Bricks.size());
+  for (std::size_t i = 0; i < m_Bricks.size(); ++i)
+  {
+    if (other.m_Bricks[i])
+    {
+      m_Bricks[i].reset(new PixelType[VOXELS_PER_BRICK]);
+      std::copy(other.m_Bricks[i].get(), other.m_Bricks[i].get() + VOXELS_PER_BRICK, m_Bricks[i].get());
+    }
+  }
+}
+
+mitk::SparseLabelLayer::~SparseLabelLayer()
+{
+}
+
+void mitk::SparseLabelLayer::Initialize(unsigned int dimension, const unsigned int *dimensions)
+{
+  m_Dimensions[0] = dimension > 0 ? dimensions[0] : 1;
+  m_Dimensions[1] = dimension > 1 ? dimensions[1] : 1;
+  m_Dimensions[2] = 1;
+  for (unsigned int dim = 2; dim < dimension; ++dim)
+    m_Dimensions[2] *= dimensions[dim];
+
+  for (int dim = 0; dim < 3; ++dim)
+    m_BricksPerDimension[dim] = (m_Dimensions[dim] + BRICK_EDGE_LENGTH - 1) / BRICK_EDGE_LENGTH;
+
+  m_Bricks.clear();
+  m_Bricks.resize(m_BricksPerDimension[0] * m_BricksPerDimension[1] * m_BricksPerDimension[2]);
+  this->Modified();
+}
+
+void mitk::SparseLabelLayer::Clear()
+{
+  for (auto &brick : m_Bricks)
+    brick.reset();
+  this->Modified();
+}
+
+std::size_t mitk::SparseLabelLayer::GetBrickIndex(std::size_t x, std::size_t y, std::size_t z) const
+{
+  return ((z / BRICK_EDGE_LENGTH) * m_BricksPerDimension[1] + y / BRICK_EDGE_LENGTH) * m_BricksPerDimension[0] +
+         x / BRICK_EDGE_LENGTH;
+}
+
+void mitk::SparseLabelLayer::Import(const PixelType *buffer)
+{
+  for (auto &brick : m_Bricks)
+    brick.reset();
+
+  // walk the buffer row by row and copy every brick row that is not empty
+  const PixelType *row = buffer;
+  for (std::size_t z = 0; z < m_Dimensions[2]; ++z)
+  {
+    for (std::size_t y = 0; y < m_Dimensions[1]; ++y, row += m_Dimensions[0])
+    {
+      const std::size_t rowOffsetInBrick = ((z % BRICK_EDGE_LENGTH) * BRICK_EDGE_LENGTH + y % BRICK_EDGE_LENGTH) *
+                                           BRICK_EDGE_LENGTH;
+
+      for (std::size_t x = 0; x < m_Dimensions[0]; x += BRICK_EDGE_LENGTH)
+      {
+        const std::size_t length = std::min<std::size_t>(BRICK_EDGE_LENGTH, m_Dimensions[0] - x);
+        const PixelType *run = row + x;
+        if (std::all_of(run, run + length, [](PixelType value) { return value == 0; }))
+          continue;
+
+        auto &brick = m_Bricks[this->GetBrickIndex(x, y, z)];
+        if (!brick)
+          brick.reset(new PixelType[VOXELS_PER_BRICK]()); // value initialized, i.e. exterior
+
+        std::memcpy(brick.get() + rowOffsetInBrick, run, length * sizeof(PixelType));
+      }
+    }
+  }
+  this->Modified();
+}
+
+void mitk::SparseLabelLayer::Export(PixelType *buffer) const
+{
+  RegionType largestRegion;
+  for (unsigned int dim = 0; dim < 3; ++dim)
+    largestRegion.SetSize(dim, m_Dimensions[dim]);
+
+  this->Export(buffer, largestRegion);
+}
+
+void mitk::SparseLabelLayer::Export(PixelType *buffer, const RegionType &region) const
+{
+  std::size_t begin[3];
+  std::size_t end[3];
+  for (unsigned int dim = 0; dim < 3; ++dim)
+  {
+    if (region.GetIndex(dim) < 0 || region.GetIndex(dim) + region.GetSize(dim) > m_Dimensions[dim])
+      mitkThrow() << "Region is not within the layer.";
+
+    begin[dim] = region.GetIndex(dim);
+    end[dim] = begin[dim] + region.GetSize(dim);
+  }
+
+  const std::size_t rowLength = region.GetSize(0);
+  const std::size_t sliceSize = rowLength * region.GetSize(1);
+  std::memset(buffer, 0, sliceSize * region.GetSize(2) * sizeof(PixelType));
+
+  // only the allocated bricks that intersect the region are copied
+  for (std::size_t bz = begin[2] / BRICK_EDGE_LENGTH; bz * BRICK_EDGE_LENGTH < end[2]; ++bz)
+  {
+    for (std::size_t by = begin[1] / BRICK_EDGE_LENGTH; by * BRICK_EDGE_LENGTH < end[1]; ++by)
+    {
+      for (std::size_t bx = begin[0] / BRICK_EDGE_LENGTH; bx * BRICK_EDGE_LENGTH < end[0]; ++bx)
+      {
+        const auto &brick = m_Bricks[(bz * m_BricksPerDimension[1] + by) * m_BricksPerDimension[0] + bx];
+        if (!brick)
+          continue;
+
+        const std::size_t x0 = std::max<std::size_t>(bx * BRICK_EDGE_LENGTH, begin[0]);
+        const std::size_t y0 = std::max<std::size_t>(by * BRICK_EDGE_LENGTH, begin[1]);
+        const std::size_t z0 = std::max<std::size_t>(bz * BRICK_EDGE_LENGTH, begin[2]);
+        const std::size_t xEnd = std::min<std::size_t>((bx + 1) * BRICK_EDGE_LENGTH, end[0]);
+        const std::size_t yEnd = std::min<std::size_t>((by + 1) * BRICK_EDGE_LENGTH, end[1]);
+        const std::size_t zEnd = std::min<std::size_t>((bz + 1) * BRICK_EDGE_LENGTH, end[2]);
+
+        for (std::size_t z = z0; z < zEnd; ++z)
+        {
+          for (std::size_t y = y0; y < yEnd; ++y)
+          {
+            const PixelType *source = brick.get() +
+                                      ((z % BRICK_EDGE_LENGTH) * BRICK_EDGE_LENGTH + y % BRICK_EDGE_LENGTH) *
+                                        BRICK_EDGE_LENGTH +
+                                      x0 % BRICK_EDGE_LENGTH;
+            std::memcpy(buffer + (z - begin[2]) * sliceSize + (y - begin[1]) * rowLength + (x0 - begin[0]),
+                        source,
+                        (xEnd - x0) * sizeof(PixelType));
+          }
+        }
+      }
+    }
+  }
+}
+
+mitk::SparseLabelLayer::PixelType mitk::SparseLabelLayer::GetValue(std::size_t x, std::size_t y, std::size_t z) const
+{
+  const auto &brick = m_Bricks[this->GetBrickIndex(x, y, z)];
+  if (!brick)
+    return 0;
+
+  return brick[((z % BRICK_EDGE_LENGTH) * BRICK_EDGE_LENGTH + y % BRICK_EDGE_LENGTH) * BRICK_EDGE_LENGTH +
+               x % BRICK_EDGE_LENGTH];
+}
+
+std::size_t mitk::SparseLabelLayer::GetNumberOfVoxels() const
+{
+  return m_Dimensions[0] * m_Dimensions[1] * m_Dimensions[2];
+}
+
+std::size_t mitk::SparseLabelLayer::GetNumberOfBricks() const
+{
+  return m_Bricks.size();
+}
+
+std::size_t mitk::SparseLabelLayer::GetNumberOfAllocatedBricks() const
+{
+  return std::count_if(
+    m_Bricks.begin(), m_Bricks.end(), [](const std::unique_ptr<PixelType[]> &brick) { return brick != nullptr; });
+}
+
+std::size_t mitk::SparseLabelLayer::GetMemorySize() const
+{
+  return this->GetNumberOfAllocatedBricks() * VOXELS_PER_BRICK * sizeof(PixelType);
+}
@@ -0,0 +1,119 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef __mitkSparseLabelLayer_H_
+#define __mitkSparseLabelLayer_H_
+
+#include "MitkMultilabelExports.h"
+
+#include <mitkCommon.h>
+#include <mitkLabel.h>
+
+#include <itkImageRegion.h>
+#include <itkObject.h>
+#include <itkObjectFactory.h>
+
+#include <memory>
+#include <vector>
+
+namespace mitk
+{
+  //
+  // Documentation
+  // @brief Block-sparse storage of the label values of one layer of a LabelSetImage.
+  //
+  // The layer is split into bricks of BRICK_EDGE_LENGTH^3 voxels. Only bricks that contain at least one
+  // non-exterior (i.e. non-zero) voxel are allocated, so the memory consumption scales with the segmented
+  // volume instead of the image size. 4D layers are stored as a stack of their volumes along the z axis.
+  //
+  // The storage is filled from and written to dense buffers in the memory layout of mitk::Image.
+  // @ingroup Data
+  //
+  class MITKMULTILABEL_EXPORT SparseLabelLayer : public itk::Object
+  {
+  public:
+    mitkClassMacroItkParent(SparseLabelLayer, itk::Object);
+    itkNewMacro(Self);
+
+    typedef mitk::Label::PixelType PixelType;
+    typedef itk::ImageRegion<3> RegionType;
+
+    /** Edge length of a brick in voxels. */
+    static const unsigned int BRICK_EDGE_LENGTH = 32;
+
+    /**
+     * @brief Sets the extent of the layer. All voxels are set to the exterior label.
+     * @param dimension the number of dimensions of the image
+     * @param dimensions the size of the image along each dimension
+     */
+    void Initialize(unsigned int dimension, const unsigned int *dimensions);
+
+    /**
+     * @brief Sets all voxels to the exterior label and releases all bricks.
+     */
+    void Clear();
+
+    /**
+     * @brief Replaces the content of the layer by the dense buffer @a buffer.
+     *        Bricks that only contain the exterior label are not allocated.
+     */
+    void Import(const PixelType *buffer);
+
+    /**
+     * @brief Writes the content of the layer to the dense buffer @a buffer, which has to be large enough
+     *        to hold all voxels of the layer.
+     */
+    void Export(PixelType *buffer) const;
+
+    /**
+     * @brief Writes the voxels within @a region to the dense buffer @a buffer, which has the size of the region.
+     *        For 4D layers the z index of the region includes the time step (see GetValue()).
+     */
+    void Export(PixelType *buffer, const RegionType &region) const;
+
+    /**
+     * @brief Returns the label value at the given voxel. For 4D layers @a z is the z index plus the time step
+     *        times the number of slices.
+     */
+    PixelType GetValue(std::size_t x, std::size_t y, std::size_t z) const;
+
+    std::size_t GetNumberOfVoxels() const;
+
+    std::size_t GetNumberOfBricks() const;
+
+    std::size_t GetNumberOfAllocatedBricks() const;
+
+    /**
+     * @brief Returns the number of bytes used by the allocated bricks.
+     */
+    std::size_t GetMemorySize() const;
+
+  protected:
+    mitkCloneMacro(Self);
+
+    SparseLabelLayer();
+    SparseLabelLayer(const SparseLabelLayer &other);
+    ~SparseLabelLayer() override;
+
+  private:
+    static const std::size_t VOXELS_PER_BRICK = BRICK_EDGE_LENGTH * BRICK_EDGE_LENGTH * BRICK_EDGE_LENGTH;
+
+    std::size_t GetBrickIndex(std::size_t x, std::size_t y, std::size_t z) const;
+
+    std::size_t m_Dimensions[3];
+    std::size_t m_BricksPerDimension[3];
+
+    std::vector<std::unique_ptr<PixelType[]>> m_Bricks;
+  };
+} // namespace mitk
+
+#endif // __mitkSparseLabelLayer_H_
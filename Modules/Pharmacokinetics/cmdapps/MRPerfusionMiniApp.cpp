@@ -15,6 +15,7 @@ found in the LICENSE file.
 
 // itk includes
 #include "itksys/SystemTools.hxx"
+#include <itkTimeProbe.h>
 
 // CTK includes
 #include "mitkCommandLineParser.h"
@@ -741,8 +742,12 @@ void doFitting()
         {
             std::cout << "Started fitting process..." << std::endl;
             generator->AddObserver(::itk::AnyEvent(), command);
+
+            itk::TimeProbe clock;
+            clock.Start();
             generator->Generate();
-            std::cout << std::endl << "Finished fitting process" << std::endl;
+            clock.Stop();
+            std::cout << std::endl << "Finished fitting process (" << clock.GetTotal() << " s)" << std::endl;
 
             mitk::storeModelFitGeneratorResults(outFileName, generator, fitSession);
         }
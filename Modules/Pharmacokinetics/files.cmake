@@ -3,6 +3,7 @@ file(GLOB_RECURSE H_FILES RELATIVE "${CMAKE_CURRENT_SOURCE_DIR}" "${CMAKE_CURREN
 set(CPP_FILES
   Common/mitkAterialInputFunctionGenerator.cpp
   Common/mitkAIFParametrizerHelper.cpp
+  Common/mitkCompartmentSystemIntegrator.cpp
   Common/mitkConcentrationCurveGenerator.cpp
   Common/mitkDescriptionParameterImageGeneratorBase.cpp
   Common/mitkPixelBasedDescriptionParameterImageGenerator.cpp
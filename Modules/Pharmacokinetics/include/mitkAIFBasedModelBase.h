@@ -17,6 +17,9 @@ found in the LICENSE file.
 #include "mitkModelBase.h"
 #include "itkArray2D.h"
 
+#include <memory>
+#include <mutex>
+
 namespace mitk
 {
 
@@ -74,6 +77,44 @@ namespace mitk
      * if currentTimeGrid.Size() = 0 , the Original AIF will be returned*/
     const AterialInputFunctionType GetAterialInputFunction(TimeGridType currentTimeGrid) const;
 
+    /** Representation of the AIF on the time grid of the model. It is computed once and reused by all signal
+     * computations of the model (and of all models that share it, see SetAterialInputFunctionCache()).
+     * Between two grid points the AIF is linear: aif(t) = slopes[i]*t + offsets[i] for
+     * t in [timeGrid[i], timeGrid[i+1]] and timeSteps[i] = timeGrid[i+1]-timeGrid[i].*/
+    struct AterialInputFunctionCache
+    {
+      /** AIF values and time grids the cache was computed from.*/
+      AterialInputFunctionType sourceValues;
+      TimeGridType sourceTimeGrid;
+      TimeGridType timeGrid;
+
+      /** AIF interpolated to timeGrid.*/
+      AterialInputFunctionType values;
+      itk::Array<double> timeSteps;
+      itk::Array<double> slopes;
+      itk::Array<double> offsets;
+
+      /** Indicates if the cache was computed for the passed AIF and time grids.*/
+      bool Matches(const AterialInputFunctionType& aifValues, const TimeGridType& aifTimeGrid,
+                   const TimeGridType& currentTimeGrid) const;
+    };
+
+    typedef std::shared_ptr<const AterialInputFunctionCache> AterialInputFunctionCachePointer;
+
+    /** Computes the cache of the AIF (aifValues, aifTimeGrid) for the time grid currentTimeGrid.*/
+    static AterialInputFunctionCachePointer ComputeAterialInputFunctionCache(const AterialInputFunctionType& aifValues,
+      const TimeGridType& aifTimeGrid, const TimeGridType& currentTimeGrid);
+
+    /** Returns the cache of the AIF for the time grid of the model. It is computed on the first call and
+     * recomputed only if the AIF, the AIF time grid or the time grid of the model have changed.
+     * The method is thread safe.*/
+    AterialInputFunctionCachePointer GetAterialInputFunctionCache() const;
+
+    /** Passes a precomputed cache to the model (e.g. by a parameterizer that shares one cache
+     * between all models it generates). The cache is only used if it matches the current AIF and
+     * time grids of the model (see AterialInputFunctionCache::Matches()). Otherwise it will be recomputed.*/
+    void SetAterialInputFunctionCache(AterialInputFunctionCachePointer cache);
+
     ParameterNamesType GetStaticParameterNames() const override;
     ParametersSizeType GetNumberOfStaticParameters() const override;
     ParamterUnitMapType GetStaticParameterUnits() const override;
@@ -102,7 +143,10 @@ namespace mitk
 
 
   private:
-
+    mutable AterialInputFunctionCachePointer m_AterialInputFunctionCache;
+    /** Modification time of the model when m_AterialInputFunctionCache was checked the last time.*/
+    mutable itk::ModifiedTimeType m_AterialInputFunctionCacheMTime;
+    mutable std::mutex m_AterialInputFunctionCacheMutex;
 
     //No copy constructor allowed
     AIFBasedModelBase(const Self& source);
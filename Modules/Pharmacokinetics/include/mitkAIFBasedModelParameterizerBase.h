@@ -16,6 +16,8 @@ found in the LICENSE file.
 #include "mitkAIFParametrizerHelper.h"
 #include "mitkAIFBasedModelBase.h"
 
+#include <mutex>
+
 namespace mitk
 {
   /** Base class for model parameterizers for Models using an Aterial Input Function
@@ -68,11 +70,42 @@ namespace mitk
     };
 
 
+    /** Reimplementation that passes the AIF cache (see AIFBasedModelBase::GetAterialInputFunctionCache()) of
+     * the last generated model to the new model. Thus the AIF is only interpolated once for all voxels of a fit.*/
+    ModelBasePointer GenerateParameterizedModel(const IndexType& currentPosition) const override
+    {
+      ModelBasePointer newModel = Superclass::GenerateParameterizedModel(currentPosition);
+      this->ShareAterialInputFunctionCache(newModel);
+      return newModel;
+    };
+
+    ModelBasePointer GenerateParameterizedModel() const override
+    {
+      ModelBasePointer newModel = Superclass::GenerateParameterizedModel();
+      this->ShareAterialInputFunctionCache(newModel);
+      return newModel;
+    };
+
   protected:
 
     AIFBasedModelParameterizerBase()
     {};
 
+    void ShareAterialInputFunctionCache(ModelBaseType* model) const
+    {
+      auto* aifModel = dynamic_cast<mitk::AIFBasedModelBase*>(model);
+      if (aifModel)
+      {
+        std::lock_guard<std::mutex> lock(m_AterialInputFunctionCacheMutex);
+        if (m_AterialInputFunctionCache)
+        {
+          aifModel->SetAterialInputFunctionCache(m_AterialInputFunctionCache);
+        }
+        //returns the passed cache if it matches the settings of the model, otherwise a recomputed one.
+        m_AterialInputFunctionCache = aifModel->GetAterialInputFunctionCache();
+      }
+    };
+
     ~AIFBasedModelParameterizerBase() override
     {};
 
@@ -80,6 +113,8 @@ namespace mitk
     mitk::AIFBasedModelBase::AterialInputFunctionType m_AIF;
     mitk::ModelBase::TimeGridType m_AIFTimeGrid;
 
+    mutable mitk::AIFBasedModelBase::AterialInputFunctionCachePointer m_AterialInputFunctionCache;
+    mutable std::mutex m_AterialInputFunctionCacheMutex;
 
   private:
 
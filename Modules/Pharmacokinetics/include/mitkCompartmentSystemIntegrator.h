@@ -0,0 +1,79 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef MITKCOMPARTMENTSYSTEMINTEGRATOR_H
+#define MITKCOMPARTMENTSYSTEMINTEGRATOR_H
+
+#include "mitkAIFBasedModelBase.h"
+#include "MitkPharmacokineticsExports.h"
+
+#include <vector>
+
+namespace mitk
+{
+  /** Solvers that can be used by the numeric compartment models to integrate their mass balance equations.*/
+  enum class CompartmentModelSolverType
+  {
+    /** Exact integration of the equations for the piecewise linear AIF (see CompartmentSystemIntegrator).*/
+    ExponentialIntegrator,
+    /** Numeric integration with the runge_kutta_cash_karp54 stepper of boost::numeric::odeint.*/
+    ODEINT
+  };
+
+  /** @class CompartmentSystemIntegrator
+   * @brief Exact integrator for linear systems of two compartments with the AIF as input:
+   *
+   * dx(t)/dt = A * x(t) + b * Ca(t)
+   *
+   * As the AIF Ca(t) is linear between the points of the model time grid, the solution at the next grid point is
+   * given exactly by x(t+h) = Phi(h) * (x(t), Ca(t), m), where m is the slope of the AIF segment and Phi(h) is the
+   * upper part of the matrix exponential of the augmented system matrix
+   *
+   *     | A  b  0 |
+   * h * | 0  0  1 |
+   *     | 0  0  0 |
+   *
+   * Phi(h) only depends on the system and the step length. It is therefore computed once per distinct step length
+   * of the time grid (e.g. once for equidistant grids) and reused for all steps. In contrast to odeint, no internal
+   * grid and no interpolation back to the model time grid are needed.*/
+  class MITKPHARMACOKINETICS_EXPORT CompartmentSystemIntegrator
+  {
+  public:
+    /** Row major 2x2 system matrix A.*/
+    typedef double SystemMatrixType[2][2];
+    typedef double InputVectorType[2];
+
+    CompartmentSystemIntegrator(const SystemMatrixType& systemMatrix, const InputVectorType& inputVector);
+
+    /** Integrates the system over the time grid of the cache, starting with x = 0 at the first time point.
+     * @param [out] x1 Values of the first compartment at all time points of the grid.
+     * @param [out] x2 Values of the second compartment at all time points of the grid.*/
+    void Integrate(const AIFBasedModelBase::AterialInputFunctionCache& aif, itk::Array<double>& x1,
+                   itk::Array<double>& x2) const;
+
+  private:
+    /** Upper 2x4 part of the matrix exponential of the augmented system for one step length.*/
+    struct Propagator
+    {
+      double stepLength;
+      double values[2][4];
+    };
+
+    /** Returns the propagator for the passed step length. It is computed on demand and then cached.*/
+    const Propagator& GetPropagator(double stepLength) const;
+
+    double m_AugmentedMatrix[4][4];
+    mutable std::vector<Propagator> m_Propagators;
+  };
+}
+
+#endif // MITKCOMPARTMENTSYSTEMINTEGRATOR_H
@@ -128,6 +128,27 @@ inline    itk::Array<double> wrap1d(itk::Array<double> kernel)
   }
 
 
+  /** @brief Variant of convoluteAIFWithExponential() that uses the precomputed AIF segments of the cache.
+   * Thus only the exponential kernel has to be evaluated for each lambda.*/
+  inline itk::Array<double> convoluteAIFWithExponential(const mitk::AIFBasedModelBase::AterialInputFunctionCache& aif, double lambda)
+  {
+      typedef itk::Array<double> ConvolutionResultType;
+      const mitk::ModelBase::TimeGridType& timeGrid = aif.timeGrid;
+      ConvolutionResultType convolution(timeGrid.GetSize());
+      convolution.fill(0.0);
+
+      for(unsigned int i = 0; i< aif.timeSteps.GetSize(); ++i)
+      {
+          double edt = exp(-lambda * aif.timeSteps(i));
+
+          convolution(i+1) =edt * convolution(i)
+                           + aif.offsets(i)/lambda * (1 - edt )
+                           + aif.slopes(i)/(lambda * lambda) * ((lambda * timeGrid(i+1) - 1) - edt*(lambda*timeGrid(i) -1));
+
+      }
+      return convolution;
+  }
+
   inline itk::Array<double> convoluteAIFWithConstant(mitk::ModelBase::TimeGridType timeGrid, mitk::AIFBasedModelBase::AterialInputFunctionType aif, double constant)
   {
       /** @brief Iterative Formula to Convolve aif(t) with a constant value by linear interpolation of the Aif between sampling points
@@ -148,6 +169,25 @@ inline    itk::Array<double> wrap1d(itk::Array<double> kernel)
       return convolution;
   }
 
+  /** @brief Variant of convoluteAIFWithConstant() that uses the precomputed AIF segments of the cache.*/
+  inline itk::Array<double> convoluteAIFWithConstant(const mitk::AIFBasedModelBase::AterialInputFunctionCache& aif, double constant)
+  {
+      typedef itk::Array<double> ConvolutionResultType;
+      const mitk::ModelBase::TimeGridType& timeGrid = aif.timeGrid;
+      ConvolutionResultType convolution(timeGrid.GetSize());
+      convolution.fill(0.0);
+
+      for(unsigned int i = 0; i< aif.timeSteps.GetSize(); ++i)
+      {
+          double dt = aif.timeSteps(i);
+          double m = aif.slopes(i);
+
+          convolution(i+1) = convolution(i) + constant * (aif.values(i)*dt + m*timeGrid(i)*dt + m/2*(timeGrid(i+1)*timeGrid(i+1) - timeGrid(i)*timeGrid(i)));
+
+      }
+      return convolution;
+  }
+
 }
 
 #endif // mitkConvolutionHelper_h
@@ -14,6 +14,7 @@ found in the LICENSE file.
 #define MITKNUMERICTWOCOMPARTMENTEXCHANGEMODEL_H
 
 #include "mitkAIFBasedModelBase.h"
+#include "mitkCompartmentSystemIntegrator.h"
 #include "MitkPharmacokineticsExports.h"
 
 
@@ -89,6 +90,11 @@ namespace mitk
 
     ParamterUnitMapType GetParameterUnits() const override;
 
+    /** Solver used to integrate the mass balance equations. Default is CompartmentModelSolverType::ExponentialIntegrator,
+     * CompartmentModelSolverType::ODEINT is the numeric integration of former versions and can be used for validation.*/
+    itkSetEnumMacro(Solver, CompartmentModelSolverType);
+    itkGetEnumMacro(Solver, CompartmentModelSolverType);
+
     ParameterNamesType GetStaticParameterNames() const override;
     ParametersSizeType GetNumberOfStaticParameters() const override;
 
@@ -105,6 +111,9 @@ namespace mitk
 
     ModelResultType ComputeModelfunction(const ParametersType& parameters) const override;
 
+    /** Computes the model function with the CompartmentSystemIntegrator.*/
+    ModelResultType ComputeModelfunctionByExponentialIntegrator(const ParametersType& parameters) const;
+
     void SetStaticParameter(const ParameterNameType& name, const StaticParameterValuesType& values) override;
     StaticParameterValuesType GetStaticParameterValue(const ParameterNameType& name) const override;
 
@@ -119,6 +128,7 @@ namespace mitk
     void operator=(const Self&);  //purposely not implemented
 
     double m_ODEINTStepSize;
+    CompartmentModelSolverType m_Solver;
 
 
 
@@ -46,6 +46,13 @@ namespace mitk
 
     typedef Superclass::IndexType IndexType;
 
+    /** Solver that is set for all generated models (see NumericTwoCompartmentExchangeModel::SetSolver()).*/
+    itkSetEnumMacro(Solver, CompartmentModelSolverType);
+    itkGetEnumMacro(Solver, CompartmentModelSolverType);
+
+    ModelBasePointer GenerateParameterizedModel(const IndexType& currentPosition) const override;
+    ModelBasePointer GenerateParameterizedModel() const override;
+
     itkSetMacro(ODEINTStepSize, double);
     itkGetConstReferenceMacro(ODEINTStepSize, double);
 
@@ -62,6 +69,7 @@ namespace mitk
   protected:
 
     double m_ODEINTStepSize;
+    CompartmentModelSolverType m_Solver;
 
     NumericTwoCompartmentExchangeModelParameterizer();
 
@@ -14,6 +14,7 @@ found in the LICENSE file.
 #define MITKNUMERICTWOTISSUECOMPARTMENTMODEL_H
 
 #include "mitkAIFBasedModelBase.h"
+#include "mitkCompartmentSystemIntegrator.h"
 #include "MitkPharmacokineticsExports.h"
 
 
@@ -70,6 +71,11 @@ namespace mitk
 
     ParamterUnitMapType GetParameterUnits() const override;
 
+    /** Solver used to integrate the mass balance equations. Default is CompartmentModelSolverType::ExponentialIntegrator,
+     * CompartmentModelSolverType::ODEINT is the numeric integration of former versions and can be used for validation.*/
+    itkSetEnumMacro(Solver, CompartmentModelSolverType);
+    itkGetEnumMacro(Solver, CompartmentModelSolverType);
+
   protected:
     NumericTwoTissueCompartmentModel();
     ~NumericTwoTissueCompartmentModel() override;
@@ -82,6 +88,9 @@ namespace mitk
 
     ModelResultType ComputeModelfunction(const ParametersType& parameters) const override;
 
+    /** Computes the model function with the CompartmentSystemIntegrator.*/
+    ModelResultType ComputeModelfunctionByExponentialIntegrator(const ParametersType& parameters) const;
+
     void PrintSelf(std::ostream& os, ::itk::Indent indent) const override;
 
   private:
@@ -91,6 +100,8 @@ namespace mitk
     NumericTwoTissueCompartmentModel(const Self& source);
     void operator=(const Self&);  //purposely not implemented
 
+    CompartmentModelSolverType m_Solver;
+
   };
 }
 
@@ -46,11 +46,20 @@ namespace mitk
 
     typedef Superclass::IndexType IndexType;
 
+    /** Solver that is set for all generated models (see NumericTwoTissueCompartmentModel::SetSolver()).*/
+    itkSetEnumMacro(Solver, CompartmentModelSolverType);
+    itkGetEnumMacro(Solver, CompartmentModelSolverType);
+
+    ModelBasePointer GenerateParameterizedModel(const IndexType& currentPosition) const override;
+    ModelBasePointer GenerateParameterizedModel() const override;
+
     /** This function returns the default parameterization (e.g. initial parametrization for fitting)
      defined by the model developer for  for the given model.*/
     ParametersType GetDefaultInitialParameterization() const override;
 
   protected:
+    CompartmentModelSolverType m_Solver;
+
     NumericTwoTissueCompartmentModelParameterizer();
 
     ~NumericTwoTissueCompartmentModelParameterizer() override;
@@ -84,6 +84,11 @@ namespace mitk
 
     ModelResultType ComputeModelfunction(const ParametersType& parameters) const override;
 
+    /** Computes the convolution of all parameter sets in one pass over the time grid, so that the AIF is only
+     * interpolated once and the inner loop runs over the sets.*/
+    void ComputeModelfunctionBatch(const ParameterValueType* parameters, unsigned int numberOfSets,
+                                   ModelResultType::ValueType* signals) const override;
+
     DerivedParameterMapType ComputeDerivedParameters(const mitk::ModelBase::ParametersType&
         parameters) const override;
 
@@ -0,0 +1,180 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkCompartmentSystemIntegrator.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+  typedef double Matrix4Type[4][4];
+
+  void Multiply(const Matrix4Type& a, const Matrix4Type& b, Matrix4Type& result)
+  {
+    for (unsigned int row = 0; row < 4; ++row)
+    {
+      for (unsigned int col = 0; col < 4; ++col)
+      {
+        double sum = 0.0;
+        for (unsigned int k = 0; k < 4; ++k)
+        {
+          sum += a[row][k] * b[k][col];
+        }
+        result[row][col] = sum;
+      }
+    }
+  }
+
+  /** Computes exp(matrix) by scaling and squaring. The scaled matrix has a norm <= 0.5,
+   * thus the truncated Taylor series is accurate to machine precision.*/
+  void MatrixExponential(const Matrix4Type& matrix, Matrix4Type& result)
+  {
+    double norm = 0.0;
+    for (unsigned int row = 0; row < 4; ++row)
+    {
+      double rowSum = 0.0;
+      for (unsigned int col = 0; col < 4; ++col)
+      {
+        rowSum += std::abs(matrix[row][col]);
+      }
+      norm = std::max(norm, rowSum);
+    }
+
+    int squarings = 0;
+    if (norm > 0.5)
+    {
+      squarings = static_cast<int>(std::ceil(std::log2(norm / 0.5)));
+    }
+    const double scale = std::ldexp(1.0, -squarings);
+
+    Matrix4Type scaled;
+    Matrix4Type term;
+    for (unsigned int row = 0; row < 4; ++row)
+    {
+      for (unsigned int col = 0; col < 4; ++col)
+      {
+        scaled[row][col] = matrix[row][col] * scale;
+        term[row][col] = (row == col) ? 1.0 : 0.0;
+        result[row][col] = term[row][col];
+      }
+    }
+
+    Matrix4Type next;
+    for (unsigned int order = 1; order <= 18; ++order)
+    {
+      Multiply(term, scaled, next);
+      for (unsigned int row = 0; row < 4; ++row)
+      {
+        for (unsigned int col = 0; col < 4; ++col)
+        {
+          term[row][col] = next[row][col] / order;
+          result[row][col] += term[row][col];
+        }
+      }
+    }
+
+    for (int i = 0; i < squarings; ++i)
+    {
+      Multiply(result, result, next);
+      std::copy(&next[0][0], &next[0][0] + 16, &result[0][0]);
+    }
+  }
+}
+
+mitk::CompartmentSystemIntegrator::CompartmentSystemIntegrator(const SystemMatrixType& systemMatrix,
+    const InputVectorType& inputVector)
+{
+  std::fill(&m_AugmentedMatrix[0][0], &m_AugmentedMatrix[0][0] + 16, 0.0);
+
+  for (unsigned int row = 0; row < 2; ++row)
+  {
+    m_AugmentedMatrix[row][0] = systemMatrix[row][0];
+    m_AugmentedMatrix[row][1] = systemMatrix[row][1];
+    m_AugmentedMatrix[row][2] = inputVector[row];
+  }
+  //the input Ca(t) grows with the slope of the current AIF segment
+  m_AugmentedMatrix[2][3] = 1.0;
+}
+
+const mitk::CompartmentSystemIntegrator::Propagator&
+mitk::CompartmentSystemIntegrator::GetPropagator(double stepLength) const
+{
+  //Steps of grids that are equidistant in theory differ in the last digits, so nearly equal steps share a propagator.
+  for (const auto& propagator : m_Propagators)
+  {
+    if (std::abs(propagator.stepLength - stepLength) <= 1e-12 * std::abs(stepLength))
+    {
+      return propagator;
+    }
+  }
+
+  Matrix4Type scaled;
+  for (unsigned int row = 0; row < 4; ++row)
+  {
+    for (unsigned int col = 0; col < 4; ++col)
+    {
+      scaled[row][col] = m_AugmentedMatrix[row][col] * stepLength;
+    }
+  }
+
+  Matrix4Type exponential;
+  MatrixExponential(scaled, exponential);
+
+  Propagator propagator;
+  propagator.stepLength = stepLength;
+  for (unsigned int row = 0; row < 2; ++row)
+  {
+    for (unsigned int col = 0; col < 4; ++col)
+    {
+      propagator.values[row][col] = exponential[row][col];
+    }
+  }
+
+  m_Propagators.push_back(propagator);
+  return m_Propagators.back();
+}
+
+void mitk::CompartmentSystemIntegrator::Integrate(const AIFBasedModelBase::AterialInputFunctionCache& aif,
+    itk::Array<double>& x1, itk::Array<double>& x2) const
+{
+  const unsigned int timeSteps = aif.timeGrid.GetSize();
+  x1.SetSize(timeSteps);
+  x2.SetSize(timeSteps);
+
+  if (timeSteps == 0)
+  {
+    return;
+  }
+
+  double state0 = 0.0;
+  double state1 = 0.0;
+  x1[0] = state0;
+  x2[0] = state1;
+
+  for (unsigned int i = 0; i < aif.timeSteps.GetSize(); ++i)
+  {
+    const Propagator& propagator = this->GetPropagator(aif.timeSteps[i]);
+    const double input = aif.values[i];
+    const double slope = aif.slopes[i];
+
+    const double next0 = propagator.values[0][0] * state0 + propagator.values[0][1] * state1
+                         + propagator.values[0][2] * input + propagator.values[0][3] * slope;
+    const double next1 = propagator.values[1][0] * state0 + propagator.values[1][1] * state1
+                         + propagator.values[1][2] * input + propagator.values[1][3] * slope;
+
+    state0 = next0;
+    state1 = next1;
+    x1[i + 1] = state0;
+    x2[i + 1] = state1;
+  }
+}
@@ -46,7 +46,7 @@ std::string mitk::AIFBasedModelBase::GetYAxisUnit() const
   return "";
 }
 
-mitk::AIFBasedModelBase::AIFBasedModelBase()
+mitk::AIFBasedModelBase::AIFBasedModelBase() : m_AterialInputFunctionCacheMTime(0)
 {
 }
 
@@ -81,6 +81,70 @@ mitk::AIFBasedModelBase::GetAterialInputFunction(TimeGridType CurrentTimeGrid) c
   }
 }
 
+bool mitk::AIFBasedModelBase::AterialInputFunctionCache::Matches(const AterialInputFunctionType& aifValues,
+    const TimeGridType& aifTimeGrid, const TimeGridType& currentTimeGrid) const
+{
+  return sourceValues == aifValues && sourceTimeGrid == aifTimeGrid && timeGrid == currentTimeGrid;
+}
+
+mitk::AIFBasedModelBase::AterialInputFunctionCachePointer
+mitk::AIFBasedModelBase::ComputeAterialInputFunctionCache(const AterialInputFunctionType& aifValues,
+    const TimeGridType& aifTimeGrid, const TimeGridType& currentTimeGrid)
+{
+  auto cache = std::make_shared<AterialInputFunctionCache>();
+  cache->sourceValues = aifValues;
+  cache->sourceTimeGrid = aifTimeGrid;
+  cache->timeGrid = currentTimeGrid;
+  cache->values = mitk::InterpolateSignalToNewTimeGrid(aifValues, aifTimeGrid, currentTimeGrid);
+
+  const unsigned int segments = currentTimeGrid.GetSize() > 0 ? currentTimeGrid.GetSize() - 1 : 0;
+  cache->timeSteps.SetSize(segments);
+  cache->slopes.SetSize(segments);
+  cache->offsets.SetSize(segments);
+
+  for (unsigned int i = 0; i < segments; ++i)
+  {
+    const double dt = currentTimeGrid(i + 1) - currentTimeGrid(i);
+    const double m = (cache->values(i + 1) - cache->values(i)) / dt;
+
+    cache->timeSteps(i) = dt;
+    cache->slopes(i) = m;
+    cache->offsets(i) = cache->values(i) - m * currentTimeGrid(i);
+  }
+
+  return cache;
+}
+
+mitk::AIFBasedModelBase::AterialInputFunctionCachePointer
+mitk::AIFBasedModelBase::GetAterialInputFunctionCache() const
+{
+  std::lock_guard<std::mutex> lock(m_AterialInputFunctionCacheMutex);
+
+  if (!m_AterialInputFunctionCache || m_AterialInputFunctionCacheMTime != this->GetMTime())
+  {
+    const TimeGridType& aifTimeGrid = GetCurrentAterialInputFunctionTimeGrid();
+
+    if (!m_AterialInputFunctionCache ||
+        !m_AterialInputFunctionCache->Matches(m_AterialInputFunctionValues, aifTimeGrid, m_TimeGrid))
+    {
+      m_AterialInputFunctionCache = ComputeAterialInputFunctionCache(m_AterialInputFunctionValues, aifTimeGrid,
+                                                                     m_TimeGrid);
+    }
+
+    m_AterialInputFunctionCacheMTime = this->GetMTime();
+  }
+
+  return m_AterialInputFunctionCache;
+}
+
+void mitk::AIFBasedModelBase::SetAterialInputFunctionCache(AterialInputFunctionCachePointer cache)
+{
+  std::lock_guard<std::mutex> lock(m_AterialInputFunctionCacheMutex);
+  m_AterialInputFunctionCache = cache;
+  //force a check of the passed cache with the next call of GetAterialInputFunctionCache()
+  m_AterialInputFunctionCacheMTime = 0;
+}
+
 mitk::AIFBasedModelBase::ParameterNamesType mitk::AIFBasedModelBase::GetStaticParameterNames() const
 {
   ParameterNamesType result;
@@ -88,8 +88,8 @@ mitk::ExtendedOneTissueCompartmentModel::ModelResultType mitk::ExtendedOneTissue
     itkExceptionMacro("No Time Grid Set! Cannot Calculate Signal");
   }
 
-  AterialInputFunctionType aterialInputFunction;
-  aterialInputFunction = GetAterialInputFunction(this->m_TimeGrid);
+  const AterialInputFunctionCachePointer aifCache = this->GetAterialInputFunctionCache();
+  const AterialInputFunctionType& aterialInputFunction = aifCache->values;
 
 
 
@@ -102,8 +102,7 @@ mitk::ExtendedOneTissueCompartmentModel::ModelResultType mitk::ExtendedOneTissue
 
 
 
-  mitk::ModelBase::ModelResultType convolution = mitk::convoluteAIFWithExponential(this->m_TimeGrid,
-      aterialInputFunction, k2);
+  mitk::ModelBase::ModelResultType convolution = mitk::convoluteAIFWithExponential(*aifCache, k2);
 
   //Signal that will be returned by ComputeModelFunction
   mitk::ModelBase::ModelResultType signal(timeSteps);
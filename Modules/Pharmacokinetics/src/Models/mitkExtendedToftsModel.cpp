@@ -113,8 +113,8 @@ mitk::ExtendedToftsModel::ModelResultType mitk::ExtendedToftsModel::ComputeModel
     itkExceptionMacro("No Time Grid Set! Cannot Calculate Signal");
   }
 
-  AterialInputFunctionType aterialInputFunction;
-  aterialInputFunction = GetAterialInputFunction(this->m_TimeGrid);
+  const AterialInputFunctionCachePointer aifCache = this->GetAterialInputFunctionCache();
+  const AterialInputFunctionType& aterialInputFunction = aifCache->values;
 
 
 
@@ -128,8 +128,7 @@ mitk::ExtendedToftsModel::ModelResultType mitk::ExtendedToftsModel::ComputeModel
 
   double lambda =  ktrans / ve;
 
-  mitk::ModelBase::ModelResultType convolution = mitk::convoluteAIFWithExponential(this->m_TimeGrid,
-      aterialInputFunction, lambda);
+  mitk::ModelBase::ModelResultType convolution = mitk::convoluteAIFWithExponential(*aifCache, lambda);
 
   //Signal that will be returned by ComputeModelFunction
   mitk::ModelBase::ModelResultType signal(timeSteps);
@@ -139,7 +138,7 @@ mitk::ExtendedToftsModel::ModelResultType mitk::ExtendedToftsModel::ComputeModel
   mitk::ModelBase::ModelResultType::const_iterator res = convolution.begin();
 
 
-  for (AterialInputFunctionType::iterator Cp = aterialInputFunction.begin();
+  for (AterialInputFunctionType::const_iterator Cp = aterialInputFunction.begin();
        Cp != aterialInputFunction.end(); ++res, ++signalPos, ++Cp)
   {
     *signalPos = (*Cp) * vp + ktrans * (*res);
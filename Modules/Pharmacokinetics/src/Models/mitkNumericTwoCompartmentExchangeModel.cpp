@@ -52,7 +52,7 @@ std::string mitk::NumericTwoCompartmentExchangeModel::GetModelType() const
 };
 
 
-mitk::NumericTwoCompartmentExchangeModel::NumericTwoCompartmentExchangeModel()
+mitk::NumericTwoCompartmentExchangeModel::NumericTwoCompartmentExchangeModel() : m_Solver(CompartmentModelSolverType::ExponentialIntegrator)
 {
 
 }
@@ -171,8 +171,13 @@ const
     itkExceptionMacro("No Time Grid Set! Cannot Calculate Signal");
   }
 
-  AterialInputFunctionType aterialInputFunction;
-  aterialInputFunction = GetAterialInputFunction(this->m_TimeGrid);
+  if (m_Solver == CompartmentModelSolverType::ExponentialIntegrator)
+  {
+    return ComputeModelfunctionByExponentialIntegrator(parameters);
+  }
+
+  const AterialInputFunctionCachePointer aifCache = this->GetAterialInputFunctionCache();
+  const AterialInputFunctionType& aterialInputFunction = aifCache->values;
 
   unsigned int timeSteps = this->m_TimeGrid.GetSize();
 
@@ -266,11 +271,42 @@ const
 
 
 
+mitk::NumericTwoCompartmentExchangeModel::ModelResultType
+mitk::NumericTwoCompartmentExchangeModel::ComputeModelfunctionByExponentialIntegrator(const ParametersType& parameters) const
+{
+  const AterialInputFunctionCachePointer aifCache = this->GetAterialInputFunctionCache();
+
+  //Model Parameters
+  double F = (double) parameters[POSITION_PARAMETER_F] / 6000.0;
+  double PS  = (double) parameters[POSITION_PARAMETER_PS] / 6000.0;
+  double ve = (double) parameters[POSITION_PARAMETER_ve];
+  double vp = (double) parameters[POSITION_PARAMETER_vp];
+
+  /** @brief Mass balance equations (see TwoCompartmentExchangeModelDifferentialEquations) as linear system*/
+  const CompartmentSystemIntegrator::SystemMatrixType systemMatrix = { { -(F + PS) / vp, PS / vp }, { PS / ve, -PS / ve } };
+  const CompartmentSystemIntegrator::InputVectorType inputVector = { F / vp, 0.0 };
+  CompartmentSystemIntegrator integrator(systemMatrix, inputVector);
+
+  itk::Array<double> plasmaConcentration;
+  itk::Array<double> EESConcentration;
+  integrator.Integrate(*aifCache, plasmaConcentration, EESConcentration);
+
+  const unsigned int timeSteps = this->m_TimeGrid.GetSize();
+  mitk::ModelBase::ModelResultType signal(timeSteps);
+  for (unsigned int i = 0; i < timeSteps; ++i)
+  {
+    signal[i] = vp * plasmaConcentration[i] + ve * EESConcentration[i];
+  }
+
+  return signal;
+}
+
 itk::LightObject::Pointer mitk::NumericTwoCompartmentExchangeModel::InternalClone() const
 {
   NumericTwoCompartmentExchangeModel::Pointer newClone = NumericTwoCompartmentExchangeModel::New();
 
   newClone->SetTimeGrid(this->m_TimeGrid);
+  newClone->SetSolver(this->m_Solver);
 
   return newClone.GetPointer();
 }
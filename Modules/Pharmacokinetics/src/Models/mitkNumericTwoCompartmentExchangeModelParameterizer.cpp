@@ -26,9 +26,26 @@ mitk::NumericTwoCompartmentExchangeModelParameterizer::GetDefaultInitialParamete
 };
 
 mitk::NumericTwoCompartmentExchangeModelParameterizer::NumericTwoCompartmentExchangeModelParameterizer()
+  : m_Solver(CompartmentModelSolverType::ExponentialIntegrator)
 {
 };
 
+mitk::NumericTwoCompartmentExchangeModelParameterizer::ModelBasePointer
+mitk::NumericTwoCompartmentExchangeModelParameterizer::GenerateParameterizedModel(const IndexType& currentPosition) const
+{
+  ModelBasePointer newModel = Superclass::GenerateParameterizedModel(currentPosition);
+  static_cast<ModelType*>(newModel.GetPointer())->SetSolver(m_Solver);
+  return newModel;
+};
+
+mitk::NumericTwoCompartmentExchangeModelParameterizer::ModelBasePointer
+mitk::NumericTwoCompartmentExchangeModelParameterizer::GenerateParameterizedModel() const
+{
+  ModelBasePointer newModel = Superclass::GenerateParameterizedModel();
+  static_cast<ModelType*>(newModel.GetPointer())->SetSolver(m_Solver);
+  return newModel;
+};
+
 mitk::NumericTwoCompartmentExchangeModelParameterizer::~NumericTwoCompartmentExchangeModelParameterizer()
 {
 };
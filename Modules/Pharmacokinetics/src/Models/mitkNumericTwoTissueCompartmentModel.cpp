@@ -52,7 +52,7 @@ std::string mitk::NumericTwoTissueCompartmentModel::GetModelType() const
   return "Dynamic.PET";
 };
 
-mitk::NumericTwoTissueCompartmentModel::NumericTwoTissueCompartmentModel()
+mitk::NumericTwoTissueCompartmentModel::NumericTwoTissueCompartmentModel() : m_Solver(CompartmentModelSolverType::ExponentialIntegrator)
 {
 
 }
@@ -108,8 +108,13 @@ mitk::NumericTwoTissueCompartmentModel::ComputeModelfunction(const ParametersTyp
     itkExceptionMacro("No Time Grid Set! Cannot Calculate Signal");
   }
 
-  AterialInputFunctionType aterialInputFunction;
-  aterialInputFunction = GetAterialInputFunction(this->m_TimeGrid);
+  if (m_Solver == CompartmentModelSolverType::ExponentialIntegrator)
+  {
+    return ComputeModelfunctionByExponentialIntegrator(parameters);
+  }
+
+  const AterialInputFunctionCachePointer aifCache = this->GetAterialInputFunctionCache();
+  const AterialInputFunctionType& aterialInputFunction = aifCache->values;
 
   unsigned int timeSteps = this->m_TimeGrid.GetSize();
 
@@ -195,11 +200,43 @@ mitk::NumericTwoTissueCompartmentModel::ComputeModelfunction(const ParametersTyp
 
 }
 
+mitk::NumericTwoTissueCompartmentModel::ModelResultType
+mitk::NumericTwoTissueCompartmentModel::ComputeModelfunctionByExponentialIntegrator(const ParametersType& parameters) const
+{
+  const AterialInputFunctionCachePointer aifCache = this->GetAterialInputFunctionCache();
+
+  //Model Parameters
+  double K1 = (double)parameters[POSITION_PARAMETER_K1] / 60.0;
+  double k2 = (double)parameters[POSITION_PARAMETER_k2] / 60.0;
+  double k3 = (double)parameters[POSITION_PARAMETER_k3] / 60.0;
+  double k4 = (double)parameters[POSITION_PARAMETER_k4] / 60.0;
+  double VB = parameters[POSITION_PARAMETER_VB];
+
+  /** @brief Mass balance equations (see TwoTissueCompartmentModelDifferentialEquations) as linear system*/
+  const CompartmentSystemIntegrator::SystemMatrixType systemMatrix = { { -(k2 + k3), k4 }, { k3, -k4 } };
+  const CompartmentSystemIntegrator::InputVectorType inputVector = { K1, 0.0 };
+  CompartmentSystemIntegrator integrator(systemMatrix, inputVector);
+
+  itk::Array<double> C1;
+  itk::Array<double> C2;
+  integrator.Integrate(*aifCache, C1, C2);
+
+  const unsigned int timeSteps = this->m_TimeGrid.GetSize();
+  mitk::ModelBase::ModelResultType signal(timeSteps);
+  for (unsigned int i = 0; i < timeSteps; ++i)
+  {
+    signal[i] = VB * aifCache->values[i] + (1 - VB) * (C1[i] + C2[i]);
+  }
+
+  return signal;
+}
+
 itk::LightObject::Pointer mitk::NumericTwoTissueCompartmentModel::InternalClone() const
 {
   NumericTwoTissueCompartmentModel::Pointer newClone = NumericTwoTissueCompartmentModel::New();
 
   newClone->SetTimeGrid(this->m_TimeGrid);
+  newClone->SetSolver(this->m_Solver);
 
   return newClone.GetPointer();
 }
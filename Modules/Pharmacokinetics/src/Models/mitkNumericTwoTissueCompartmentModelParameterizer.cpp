@@ -27,9 +27,26 @@ mitk::NumericTwoTissueCompartmentModelParameterizer::GetDefaultInitialParameteri
 };
 
 mitk::NumericTwoTissueCompartmentModelParameterizer::NumericTwoTissueCompartmentModelParameterizer()
+  : m_Solver(CompartmentModelSolverType::ExponentialIntegrator)
 {
 };
 
+mitk::NumericTwoTissueCompartmentModelParameterizer::ModelBasePointer
+mitk::NumericTwoTissueCompartmentModelParameterizer::GenerateParameterizedModel(const IndexType& currentPosition) const
+{
+  ModelBasePointer newModel = Superclass::GenerateParameterizedModel(currentPosition);
+  static_cast<ModelType*>(newModel.GetPointer())->SetSolver(m_Solver);
+  return newModel;
+};
+
+mitk::NumericTwoTissueCompartmentModelParameterizer::ModelBasePointer
+mitk::NumericTwoTissueCompartmentModelParameterizer::GenerateParameterizedModel() const
+{
+  ModelBasePointer newModel = Superclass::GenerateParameterizedModel();
+  static_cast<ModelType*>(newModel.GetPointer())->SetSolver(m_Solver);
+  return newModel;
+};
+
 mitk::NumericTwoTissueCompartmentModelParameterizer::~NumericTwoTissueCompartmentModelParameterizer()
 {
 };
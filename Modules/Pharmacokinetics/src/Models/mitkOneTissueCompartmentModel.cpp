@@ -84,8 +84,7 @@ mitk::OneTissueCompartmentModel::ModelResultType mitk::OneTissueCompartmentModel
     itkExceptionMacro("No Time Grid Set! Cannot Calculate Signal");
   }
 
-  AterialInputFunctionType aterialInputFunction;
-  aterialInputFunction = GetAterialInputFunction(this->m_TimeGrid);
+  const AterialInputFunctionCachePointer aifCache = this->GetAterialInputFunctionCache();
 
 
 
@@ -97,8 +96,7 @@ mitk::OneTissueCompartmentModel::ModelResultType mitk::OneTissueCompartmentModel
 
 
 
-  mitk::ModelBase::ModelResultType convolution = mitk::convoluteAIFWithExponential(this->m_TimeGrid,
-      aterialInputFunction, k2);
+  mitk::ModelBase::ModelResultType convolution = mitk::convoluteAIFWithExponential(*aifCache, k2);
 
   //Signal that will be returned by ComputeModelFunction
   mitk::ModelBase::ModelResultType signal(timeSteps);
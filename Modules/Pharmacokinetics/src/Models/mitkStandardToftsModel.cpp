@@ -12,6 +12,7 @@ found in the LICENSE file.
 
 #include "mitkStandardToftsModel.h"
 #include "mitkConvolutionHelper.h"
+#include <algorithm>
 #include <vnl/algo/vnl_fft_1d.h>
 #include <fstream>
 
@@ -105,8 +106,8 @@ mitk::StandardToftsModel::ModelResultType mitk::StandardToftsModel::ComputeModel
     itkExceptionMacro("No Time Grid Set! Cannot Calculate Signal");
   }
 
-  AterialInputFunctionType aterialInputFunction;
-  aterialInputFunction = GetAterialInputFunction(this->m_TimeGrid);
+  const AterialInputFunctionCachePointer aifCache = this->GetAterialInputFunctionCache();
+  const AterialInputFunctionType& aterialInputFunction = aifCache->values;
 
 
 
@@ -119,8 +120,7 @@ mitk::StandardToftsModel::ModelResultType mitk::StandardToftsModel::ComputeModel
 
   double lambda =  ktrans / ve;
 
-  mitk::ModelBase::ModelResultType convolution = mitk::convoluteAIFWithExponential(this->m_TimeGrid,
-      aterialInputFunction, lambda);
+  mitk::ModelBase::ModelResultType convolution = mitk::convoluteAIFWithExponential(*aifCache, lambda);
 
   //Signal that will be returned by ComputeModelFunction
   mitk::ModelBase::ModelResultType signal(timeSteps);
@@ -130,7 +130,7 @@ mitk::StandardToftsModel::ModelResultType mitk::StandardToftsModel::ComputeModel
   mitk::ModelBase::ModelResultType::const_iterator res = convolution.begin();
 
 
-  for (AterialInputFunctionType::iterator Cp = aterialInputFunction.begin();
+  for (AterialInputFunctionType::const_iterator Cp = aterialInputFunction.begin();
        Cp != aterialInputFunction.end(); ++res, ++signalPos, ++Cp)
   {
     *signalPos = ktrans * (*res);
@@ -140,6 +140,57 @@ mitk::StandardToftsModel::ModelResultType mitk::StandardToftsModel::ComputeModel
 
 }
 
+void mitk::StandardToftsModel::ComputeModelfunctionBatch(const ParameterValueType* parameters,
+    unsigned int numberOfSets, ModelResultType::ValueType* signals) const
+{
+  if (this->m_TimeGrid.GetSize() == 0)
+  {
+    itkExceptionMacro("No Time Grid Set! Cannot Calculate Signal");
+  }
+
+  const AterialInputFunctionCachePointer aifCache = this->GetAterialInputFunctionCache();
+
+  const unsigned int timeSteps = this->m_TimeGrid.GetSize();
+
+  const ParameterValueType* ktransValues = parameters + POSITION_PARAMETER_Ktrans * numberOfSets;
+  const ParameterValueType* veValues = parameters + POSITION_PARAMETER_ve * numberOfSets;
+
+  //The signal rows are used to store the convolution (see convoluteAIFWithExponential()) of all sets
+  std::fill(signals, signals + numberOfSets, 0.0);
+
+  for (unsigned int i = 0; i < (timeSteps - 1); ++i)
+  {
+    const double t0 = this->m_TimeGrid(i);
+    const double t1 = this->m_TimeGrid(i + 1);
+    const double dt = aifCache->timeSteps(i);
+    const double m = aifCache->slopes(i);
+    const double offset = aifCache->offsets(i);
+
+    const ModelResultType::ValueType* convolution = signals + i * numberOfSets;
+    ModelResultType::ValueType* nextConvolution = signals + (i + 1) * numberOfSets;
+
+    for (unsigned int set = 0; set < numberOfSets; ++set)
+    {
+      const double lambda = ktransValues[set] / 6000.0 / veValues[set];
+      const double edt = exp(-lambda * dt);
+
+      nextConvolution[set] = edt * convolution[set]
+                             + offset / lambda * (1 - edt)
+                             + m / (lambda * lambda) * ((lambda * t1 - 1) - edt * (lambda * t0 - 1));
+    }
+  }
+
+  for (unsigned int i = 0; i < timeSteps; ++i)
+  {
+    ModelResultType::ValueType* signal = signals + i * numberOfSets;
+
+    for (unsigned int set = 0; set < numberOfSets; ++set)
+    {
+      signal[set] *= ktransValues[set] / 6000.0;
+    }
+  }
+}
+
 
 mitk::ModelBase::DerivedParameterMapType mitk::StandardToftsModel::ComputeDerivedParameters(
   const mitk::ModelBase::ParametersType& parameters) const
@@ -103,8 +103,7 @@ mitk::TwoCompartmentExchangeModel::ComputeModelfunction(const ParametersType& pa
     itkExceptionMacro("No Time Grid Set! Cannot Calculate Signal");
     }
 
-    AterialInputFunctionType aterialInputFunction;
-    aterialInputFunction = GetAterialInputFunction(this->m_TimeGrid);
+    const AterialInputFunctionCachePointer aifCache = this->GetAterialInputFunctionCache();
 
     unsigned int timeSteps = this->m_TimeGrid.GetSize();
     mitk::ModelBase::ModelResultType signal(timeSteps);
@@ -129,8 +128,8 @@ mitk::TwoCompartmentExchangeModel::ComputeModelfunction(const ParametersType& pa
 
 
 
-        ConvolutionResultType expp = mitk::convoluteAIFWithExponential(this->m_TimeGrid, aterialInputFunction,Kp);
-        ConvolutionResultType expm = mitk::convoluteAIFWithExponential(this->m_TimeGrid, aterialInputFunction,Km);
+        ConvolutionResultType expp = mitk::convoluteAIFWithExponential(*aifCache, Kp);
+        ConvolutionResultType expm = mitk::convoluteAIFWithExponential(*aifCache, Km);
 
         //Signal that will be returned by ComputeModelFunction
 
@@ -147,7 +146,7 @@ mitk::TwoCompartmentExchangeModel::ComputeModelfunction(const ParametersType& pa
     else
     {
         double Kp = F/vp;
-        ConvolutionResultType exp = mitk::convoluteAIFWithExponential(this->m_TimeGrid, aterialInputFunction,Kp);
+        ConvolutionResultType exp = mitk::convoluteAIFWithExponential(*aifCache, Kp);
         mitk::ModelBase::ModelResultType::const_iterator expPos = exp.begin();
 
         for( mitk::ModelBase::ModelResultType::iterator signalPos = signal.begin(); signalPos!=signal.end(); ++expPos, ++signalPos)
@@ -92,8 +92,8 @@ mitk::TwoTissueCompartmentFDGModel::ComputeModelfunction(const ParametersType& p
     itkExceptionMacro("No Time Grid Set! Cannot Calculate Signal");
   }
 
-  AterialInputFunctionType aterialInputFunction;
-  aterialInputFunction = GetAterialInputFunction(this->m_TimeGrid);
+  const AterialInputFunctionCachePointer aifCache = this->GetAterialInputFunctionCache();
+  const AterialInputFunctionType& aterialInputFunction = aifCache->values;
 
 
   unsigned int timeSteps = this->m_TimeGrid.GetSize();
@@ -109,9 +109,8 @@ mitk::TwoTissueCompartmentFDGModel::ComputeModelfunction(const ParametersType& p
 
   double lambda = k2+k3;
   //double lambda2 = -alpha2;
-  mitk::ModelBase::ModelResultType exp = mitk::convoluteAIFWithExponential(this->m_TimeGrid,
-                                          aterialInputFunction, lambda);
-  mitk::ModelBase::ModelResultType CA = mitk::convoluteAIFWithConstant(this->m_TimeGrid, aterialInputFunction, k3);
+  mitk::ModelBase::ModelResultType exp = mitk::convoluteAIFWithExponential(*aifCache, lambda);
+  mitk::ModelBase::ModelResultType CA = mitk::convoluteAIFWithConstant(*aifCache, k3);
 
 
   //Signal that will be returned by ComputeModelFunction
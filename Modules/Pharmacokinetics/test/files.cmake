@@ -1,4 +1,13 @@
 SET(MODULE_TESTS
   mitkDescriptivePharmacokineticBrixModelTest.cpp
+  mitkAIFBasedModelBaseTest.cpp
+  mitkStandardToftsModelBatchTest.cpp
+  mitkNumericCompartmentModelSolverTest.cpp
   #ConvertToConcentrationTest.cpp
 )
+
+# Built into a driver of their own with MITK_BUILD_BENCHMARKS, not run by ctest
+SET(MODULE_BENCHMARKS
+  mitkStandardToftsModelBatchBenchmark.cpp
+  mitkNumericCompartmentModelSolverBenchmark.cpp
+)
@@ -0,0 +1,153 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkStandardToftsModel.h"
+#include "mitkStandardToftsModelParameterizer.h"
+#include "mitkConvolutionHelper.h"
+#include "mitkTimeGridHelper.h"
+
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+#include <algorithm>
+#include <cmath>
+
+class mitkAIFBasedModelBaseTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkAIFBasedModelBaseTestSuite);
+
+  MITK_TEST(CacheIsReused);
+  MITK_TEST(CacheIsRecomputedAfterChanges);
+  MITK_TEST(CachedSignalEqualsUncachedSignal);
+  MITK_TEST(ParameterizerSharesCache);
+
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+
+  mitk::ModelBase::TimeGridType m_Grid;
+  mitk::ModelBase::TimeGridType m_AIFGrid;
+  mitk::AIFBasedModelBase::AterialInputFunctionType m_AIF;
+
+public:
+
+  void setUp() override
+  {
+    // the AIF is sampled with a higher temporal resolution than the signal
+    m_Grid.SetSize(30);
+    for (unsigned int i = 0; i < m_Grid.GetSize(); ++i)
+    {
+      m_Grid[i] = 7. * i;
+    }
+
+    m_AIFGrid.SetSize(100);
+    m_AIF.SetSize(100);
+    for (unsigned int i = 0; i < m_AIFGrid.GetSize(); ++i)
+    {
+      m_AIFGrid[i] = 2.5 * i;
+      const double t = std::max(0., m_AIFGrid[i] - 20.) / 10.;
+      m_AIF[i] = 5. * t * t * std::exp(-t);
+    }
+  }
+
+  mitk::StandardToftsModel::Pointer CreateModel()
+  {
+    mitk::StandardToftsModel::Pointer model = mitk::StandardToftsModel::New();
+    model->SetTimeGrid(m_Grid);
+    model->SetAterialInputFunctionValues(m_AIF);
+    model->SetAterialInputFunctionTimeGrid(m_AIFGrid);
+    return model;
+  }
+
+  void CacheIsReused()
+  {
+    auto model = CreateModel();
+    auto cache = model->GetAterialInputFunctionCache();
+
+    CPPUNIT_ASSERT(cache != nullptr);
+    CPPUNIT_ASSERT_EQUAL(m_Grid.GetSize(), cache->values.GetSize());
+    CPPUNIT_ASSERT_EQUAL(m_Grid.GetSize() - 1, cache->slopes.GetSize());
+    CPPUNIT_ASSERT(cache == model->GetAterialInputFunctionCache());
+
+    mitk::ModelBase::ParametersType params(2);
+    params[0] = 20.;
+    params[1] = 0.3;
+    model->GetSignal(params);
+    CPPUNIT_ASSERT_MESSAGE("Signal computation has recomputed the cache.", cache == model->GetAterialInputFunctionCache());
+  }
+
+  void CacheIsRecomputedAfterChanges()
+  {
+    auto model = CreateModel();
+    auto cache = model->GetAterialInputFunctionCache();
+
+    auto scaledAIF = m_AIF;
+    scaledAIF *= 2.;
+    model->SetAterialInputFunctionValues(scaledAIF);
+    auto newCache = model->GetAterialInputFunctionCache();
+    CPPUNIT_ASSERT(cache != newCache);
+    CPPUNIT_ASSERT(mitk::Equal(2. * cache->values[10], newCache->values[10], 1e-10, true));
+
+    auto grid = m_Grid;
+    grid[m_Grid.GetSize() - 1] += 1.;
+    model->SetTimeGrid(grid);
+    CPPUNIT_ASSERT(newCache != model->GetAterialInputFunctionCache());
+    CPPUNIT_ASSERT(model->GetAterialInputFunctionCache()->timeGrid == grid);
+  }
+
+  void CachedSignalEqualsUncachedSignal()
+  {
+    auto model = CreateModel();
+
+    mitk::ModelBase::ParametersType params(2);
+    params[mitk::StandardToftsModel::POSITION_PARAMETER_Ktrans] = 20.;
+    params[mitk::StandardToftsModel::POSITION_PARAMETER_ve] = 0.3;
+    const mitk::ModelBase::ModelResultType signal = model->GetSignal(params);
+
+    const double ktrans = params[mitk::StandardToftsModel::POSITION_PARAMETER_Ktrans] / 6000.;
+    const auto aif = mitk::InterpolateSignalToNewTimeGrid(m_AIF, m_AIFGrid, m_Grid);
+    const auto convolution = mitk::convoluteAIFWithExponential(m_Grid, aif, ktrans / params[1]);
+
+    for (unsigned int i = 0; i < m_Grid.GetSize(); ++i)
+    {
+      CPPUNIT_ASSERT(mitk::Equal(ktrans * convolution[i], signal[i], 1e-10, true));
+    }
+  }
+
+  void ParameterizerSharesCache()
+  {
+    mitk::StandardToftsModelParameterizer::Pointer parameterizer = mitk::StandardToftsModelParameterizer::New();
+    parameterizer->SetDefaultTimeGrid(m_Grid);
+    parameterizer->SetAIF(m_AIF);
+    parameterizer->SetAIFTimeGrid(m_AIFGrid);
+
+    mitk::StandardToftsModelParameterizer::IndexType index;
+    index.Fill(0);
+    mitk::ModelBase::Pointer generated1 = parameterizer->GenerateParameterizedModel(index);
+    mitk::ModelBase::Pointer generated2 = parameterizer->GenerateParameterizedModel(index);
+    auto model1 = dynamic_cast<mitk::AIFBasedModelBase*>(generated1.GetPointer());
+    auto model2 = dynamic_cast<mitk::AIFBasedModelBase*>(generated2.GetPointer());
+    CPPUNIT_ASSERT(model1 && model2);
+    CPPUNIT_ASSERT(model1->GetAterialInputFunctionCache() == model2->GetAterialInputFunctionCache());
+
+    // a model with other settings must not use the shared cache
+    auto scaledAIF = m_AIF;
+    scaledAIF *= 2.;
+    parameterizer->SetAIF(scaledAIF);
+    mitk::ModelBase::Pointer generated3 = parameterizer->GenerateParameterizedModel(index);
+    auto model3 = dynamic_cast<mitk::AIFBasedModelBase*>(generated3.GetPointer());
+    CPPUNIT_ASSERT(model1->GetAterialInputFunctionCache() != model3->GetAterialInputFunctionCache());
+    CPPUNIT_ASSERT(model3->GetAterialInputFunctionCache()->sourceValues == scaledAIF);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkAIFBasedModelBase)
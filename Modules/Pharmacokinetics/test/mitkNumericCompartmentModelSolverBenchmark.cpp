@@ -0,0 +1,143 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkNumericTwoTissueCompartmentModel.h"
+#include "mitkTwoTissueCompartmentModel.h"
+#include "mitkNumericTwoCompartmentExchangeModel.h"
+#include "mitkTwoCompartmentExchangeModel.h"
+
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+#include <itkTimeProbe.h>
+
+#include <algorithm>
+#include <cmath>
+
+/** Reports run time and accuracy of the exponential integrator and of odeint.
+ * Only built with MITK_BUILD_BENCHMARKS.*/
+class mitkNumericCompartmentModelSolverBenchmarkSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkNumericCompartmentModelSolverBenchmarkSuite);
+
+  MITK_TEST(TwoTissueCompartmentModel);
+  MITK_TEST(TwoCompartmentExchangeModel);
+
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+
+  mitk::ModelBase::TimeGridType m_Grid;
+  mitk::AIFBasedModelBase::AterialInputFunctionType m_AIF;
+
+  void InitModel(mitk::AIFBasedModelBase* model)
+  {
+    model->SetTimeGrid(m_Grid);
+    model->SetAterialInputFunctionValues(m_AIF);
+  }
+
+  /** Maximum difference of the signals relative to the maximum of the reference.*/
+  double GetMaximumError(const mitk::ModelBase::ModelResultType& reference, const mitk::ModelBase::ModelResultType& signal)
+  {
+    double maximum = 0.;
+    double error = 0.;
+    for (unsigned int i = 0; i < reference.GetSize(); ++i)
+    {
+      maximum = std::max(maximum, std::abs(reference[i]));
+      error = std::max(error, std::abs(reference[i] - signal[i]));
+    }
+    return error / maximum;
+  }
+
+  /** Times repeated signal computations of the model with both solvers.*/
+  template <class TNumericModel>
+  void CompareSolvers(TNumericModel* model, const mitk::ModelBase::ParametersType& parameters,
+                      const mitk::ModelBase::ModelResultType& reference, const std::string& name)
+  {
+    const unsigned int repetitions = 200;
+
+    model->SetSolver(mitk::CompartmentModelSolverType::ExponentialIntegrator);
+    mitk::ModelBase::ModelResultType exactSignal;
+    itk::TimeProbe exactProbe;
+    exactProbe.Start();
+    for (unsigned int i = 0; i < repetitions; ++i)
+    {
+      exactSignal = model->GetSignal(parameters);
+    }
+    exactProbe.Stop();
+
+    model->SetSolver(mitk::CompartmentModelSolverType::ODEINT);
+    mitk::ModelBase::ModelResultType odeintSignal;
+    itk::TimeProbe odeintProbe;
+    odeintProbe.Start();
+    for (unsigned int i = 0; i < repetitions; ++i)
+    {
+      odeintSignal = model->GetSignal(parameters);
+    }
+    odeintProbe.Stop();
+
+    MITK_INFO << name << ": " << repetitions << " signals with exponential integrator: " << exactProbe.GetTotal()
+              << " s (max. rel. error " << GetMaximumError(reference, exactSignal) << "); with odeint: "
+              << odeintProbe.GetTotal() << " s (max. rel. error " << GetMaximumError(reference, odeintSignal) << ")";
+  }
+
+public:
+
+  void setUp() override
+  {
+    const unsigned int timeSteps = 60;
+    m_Grid.SetSize(timeSteps);
+    m_AIF.SetSize(timeSteps);
+    for (unsigned int i = 0; i < timeSteps; ++i)
+    {
+      m_Grid[i] = 5. * i;
+      const double t = std::max(0., m_Grid[i] - 20.) / 10.;
+      m_AIF[i] = 5. * t * t * std::exp(-t) + 0.3 * (1. - std::exp(-t));
+    }
+  }
+
+  void TwoTissueCompartmentModel()
+  {
+    mitk::ModelBase::ParametersType parameters(5);
+    parameters[mitk::TwoTissueCompartmentModel::POSITION_PARAMETER_K1] = 0.5;
+    parameters[mitk::TwoTissueCompartmentModel::POSITION_PARAMETER_k2] = 0.3;
+    parameters[mitk::TwoTissueCompartmentModel::POSITION_PARAMETER_k3] = 0.1;
+    parameters[mitk::TwoTissueCompartmentModel::POSITION_PARAMETER_k4] = 0.05;
+    parameters[mitk::TwoTissueCompartmentModel::POSITION_PARAMETER_VB] = 0.04;
+
+    mitk::TwoTissueCompartmentModel::Pointer analyticModel = mitk::TwoTissueCompartmentModel::New();
+    InitModel(analyticModel);
+    mitk::NumericTwoTissueCompartmentModel::Pointer numericModel = mitk::NumericTwoTissueCompartmentModel::New();
+    InitModel(numericModel);
+
+    CompareSolvers(numericModel.GetPointer(), parameters, analyticModel->GetSignal(parameters), "NumericTwoTissueCompartmentModel");
+  }
+
+  void TwoCompartmentExchangeModel()
+  {
+    mitk::ModelBase::ParametersType parameters(4);
+    parameters[mitk::TwoCompartmentExchangeModel::POSITION_PARAMETER_F] = 60.;
+    parameters[mitk::TwoCompartmentExchangeModel::POSITION_PARAMETER_PS] = 10.;
+    parameters[mitk::TwoCompartmentExchangeModel::POSITION_PARAMETER_ve] = 0.2;
+    parameters[mitk::TwoCompartmentExchangeModel::POSITION_PARAMETER_vp] = 0.05;
+
+    mitk::TwoCompartmentExchangeModel::Pointer analyticModel = mitk::TwoCompartmentExchangeModel::New();
+    InitModel(analyticModel);
+    mitk::NumericTwoCompartmentExchangeModel::Pointer numericModel = mitk::NumericTwoCompartmentExchangeModel::New();
+    InitModel(numericModel);
+    numericModel->SetODEINTStepSize(0.05);
+
+    CompareSolvers(numericModel.GetPointer(), parameters, analyticModel->GetSignal(parameters), "NumericTwoCompartmentExchangeModel");
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkNumericCompartmentModelSolverBenchmark)
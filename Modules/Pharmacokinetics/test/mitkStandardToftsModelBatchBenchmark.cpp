@@ -0,0 +1,121 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkStandardToftsModel.h"
+#include "mitkBatchedLevenbergMarquardtModelFitFunctor.h"
+#include "mitkLevenbergMarquardtModelFitFunctor.h"
+
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+#include <itkTimeProbe.h>
+
+#include <algorithm>
+#include <cmath>
+
+/** Times the batched fit of the standard Tofts model against the per signal
+ * LevenbergMarquardtModelFitFunctor. Only built with MITK_BUILD_BENCHMARKS.*/
+class mitkStandardToftsModelBatchBenchmarkSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkStandardToftsModelBatchBenchmarkSuite);
+
+  MITK_TEST(BatchedFit);
+
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+
+  typedef std::vector<double> ValueArrayType;
+
+  mitk::StandardToftsModel::Pointer m_Model;
+
+public:
+
+  void setUp() override
+  {
+    const unsigned int timeSteps = 40;
+    mitk::ModelBase::TimeGridType grid(timeSteps);
+    mitk::AIFBasedModelBase::AterialInputFunctionType aif(timeSteps);
+    for (unsigned int i = 0; i < timeSteps; ++i)
+    {
+      // 6s between frames, gamma variate shaped bolus arriving at 30s
+      grid[i] = 6. * i;
+      const double t = std::max(0., grid[i] - 30.) / 10.;
+      aif[i] = 5. * t * t * std::exp(-t) + 0.5 * (1. - std::exp(-t));
+    }
+
+    m_Model = mitk::StandardToftsModel::New();
+    m_Model->SetTimeGrid(grid);
+    m_Model->SetAterialInputFunctionValues(aif);
+    m_Model->SetAterialInputFunctionTimeGrid(grid);
+  }
+
+  void tearDown() override
+  {
+    m_Model = nullptr;
+  }
+
+  void BatchedFit()
+  {
+    const unsigned int numberOfSignals = 1024;
+    const unsigned int timeSteps = m_Model->GetTimeGrid().GetSize();
+
+    ValueArrayType parameters(2 * numberOfSignals);
+    for (unsigned int s = 0; s < numberOfSignals; ++s)
+    {
+      parameters[mitk::StandardToftsModel::POSITION_PARAMETER_Ktrans * numberOfSignals + s] = 5. + (s % 8) * 5.;
+      parameters[mitk::StandardToftsModel::POSITION_PARAMETER_ve * numberOfSignals + s] = 0.1 + (s % 5) * 0.1;
+    }
+
+    ValueArrayType values(timeSteps * numberOfSignals);
+    m_Model->GetSignalBatch(parameters.data(), numberOfSignals, values.data());
+
+    ValueArrayType initialParameters(2 * numberOfSignals);
+    std::fill(initialParameters.begin(), initialParameters.begin() + numberOfSignals, 15.);
+    std::fill(initialParameters.begin() + numberOfSignals, initialParameters.end(), 0.3);
+
+    mitk::BatchedLevenbergMarquardtModelFitFunctor::Pointer batchedFunctor =
+      mitk::BatchedLevenbergMarquardtModelFitFunctor::New();
+    ValueArrayType results(batchedFunctor->GetNumberOfOutputs(m_Model) * numberOfSignals);
+
+    itk::TimeProbe batchedProbe;
+    batchedProbe.Start();
+    batchedFunctor->ComputeBatch(values.data(), timeSteps, numberOfSignals, m_Model, initialParameters.data(),
+                                 results.data());
+    batchedProbe.Stop();
+
+    mitk::LevenbergMarquardtModelFitFunctor::Pointer functor = mitk::LevenbergMarquardtModelFitFunctor::New();
+    mitk::ModelBase::ParametersType initParams(2);
+    initParams[0] = 15.;
+    initParams[1] = 0.3;
+    ValueArrayType sample(timeSteps);
+
+    itk::TimeProbe probe;
+    for (unsigned int s = 0; s < numberOfSignals; ++s)
+    {
+      for (unsigned int t = 0; t < timeSteps; ++t)
+      {
+        sample[t] = values[t * numberOfSignals + s];
+      }
+
+      probe.Start();
+      functor->Compute(sample, m_Model, initParams);
+      probe.Stop();
+    }
+
+    MITK_INFO << "Fit of " << numberOfSignals << " standard Tofts signals: " << probe.GetTotal()
+              << " s (LevenbergMarquardtModelFitFunctor), " << batchedProbe.GetTotal()
+              << " s (BatchedLevenbergMarquardtModelFitFunctor)";
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkStandardToftsModelBatchBenchmark)
@@ -0,0 +1,148 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkStandardToftsModel.h"
+#include "mitkBatchedLevenbergMarquardtModelFitFunctor.h"
+#include "mitkLevenbergMarquardtModelFitFunctor.h"
+
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+#include <algorithm>
+#include <cmath>
+
+class mitkStandardToftsModelBatchTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkStandardToftsModelBatchTestSuite);
+
+  MITK_TEST(GetSignalBatchEqualsGetSignal);
+  MITK_TEST(BatchedFitEqualsPerSignalFit);
+
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+
+  typedef std::vector<double> ValueArrayType;
+
+  mitk::StandardToftsModel::Pointer m_Model;
+
+  /** Parameters (SoA layout) of numberOfSets tissues with ktrans in [5, 40] and ve in [0.1, 0.5].*/
+  ValueArrayType GenerateParameters(unsigned int numberOfSets)
+  {
+    ValueArrayType parameters(2 * numberOfSets);
+    for (unsigned int s = 0; s < numberOfSets; ++s)
+    {
+      parameters[mitk::StandardToftsModel::POSITION_PARAMETER_Ktrans * numberOfSets + s] = 5. + (s % 8) * 5.;
+      parameters[mitk::StandardToftsModel::POSITION_PARAMETER_ve * numberOfSets + s] = 0.1 + (s % 5) * 0.1;
+    }
+    return parameters;
+  }
+
+public:
+
+  void setUp() override
+  {
+    const unsigned int timeSteps = 40;
+    mitk::ModelBase::TimeGridType grid(timeSteps);
+    mitk::AIFBasedModelBase::AterialInputFunctionType aif(timeSteps);
+    for (unsigned int i = 0; i < timeSteps; ++i)
+    {
+      // 6s between frames, gamma variate shaped bolus arriving at 30s
+      grid[i] = 6. * i;
+      const double t = std::max(0., grid[i] - 30.) / 10.;
+      aif[i] = 5. * t * t * std::exp(-t) + 0.5 * (1. - std::exp(-t));
+    }
+
+    m_Model = mitk::StandardToftsModel::New();
+    m_Model->SetTimeGrid(grid);
+    m_Model->SetAterialInputFunctionValues(aif);
+    m_Model->SetAterialInputFunctionTimeGrid(grid);
+  }
+
+  void tearDown() override
+  {
+    m_Model = nullptr;
+  }
+
+  void GetSignalBatchEqualsGetSignal()
+  {
+    const unsigned int numberOfSets = 13;
+    const ValueArrayType parameters = GenerateParameters(numberOfSets);
+    const unsigned int timeSteps = m_Model->GetTimeGrid().GetSize();
+
+    ValueArrayType signals(timeSteps * numberOfSets);
+    m_Model->GetSignalBatch(parameters.data(), numberOfSets, signals.data());
+
+    for (unsigned int s = 0; s < numberOfSets; ++s)
+    {
+      mitk::ModelBase::ParametersType params(2);
+      params[0] = parameters[s];
+      params[1] = parameters[numberOfSets + s];
+      const mitk::ModelBase::ModelResultType signal = m_Model->GetSignal(params);
+
+      for (unsigned int t = 0; t < timeSteps; ++t)
+      {
+        CPPUNIT_ASSERT_MESSAGE("Batched signal differs from GetSignal().",
+                               mitk::Equal(signal[t], signals[t * numberOfSets + s], 1e-10, true));
+      }
+    }
+  }
+
+  /** Compares the batched fit against the per signal LevenbergMarquardtModelFitFunctor.*/
+  void BatchedFitEqualsPerSignalFit()
+  {
+    const unsigned int numberOfSignals = 1024;
+    const ValueArrayType parameters = GenerateParameters(numberOfSignals);
+    const unsigned int timeSteps = m_Model->GetTimeGrid().GetSize();
+
+    ValueArrayType values(timeSteps * numberOfSignals);
+    m_Model->GetSignalBatch(parameters.data(), numberOfSignals, values.data());
+
+    ValueArrayType initialParameters(2 * numberOfSignals);
+    std::fill(initialParameters.begin(), initialParameters.begin() + numberOfSignals, 15.);
+    std::fill(initialParameters.begin() + numberOfSignals, initialParameters.end(), 0.3);
+
+    mitk::BatchedLevenbergMarquardtModelFitFunctor::Pointer batchedFunctor =
+      mitk::BatchedLevenbergMarquardtModelFitFunctor::New();
+    ValueArrayType results(batchedFunctor->GetNumberOfOutputs(m_Model) * numberOfSignals);
+
+    batchedFunctor->ComputeBatch(values.data(), timeSteps, numberOfSignals, m_Model, initialParameters.data(),
+                                 results.data());
+
+    mitk::LevenbergMarquardtModelFitFunctor::Pointer functor = mitk::LevenbergMarquardtModelFitFunctor::New();
+    mitk::ModelBase::ParametersType initParams(2);
+    initParams[0] = 15.;
+    initParams[1] = 0.3;
+    ValueArrayType sample(timeSteps);
+
+    for (unsigned int s = 0; s < numberOfSignals; ++s)
+    {
+      for (unsigned int t = 0; t < timeSteps; ++t)
+      {
+        sample[t] = values[t * numberOfSignals + s];
+      }
+
+      const auto perSignalResult = functor->Compute(sample, m_Model, initParams);
+
+      for (unsigned int p = 0; p < 2; ++p)
+      {
+        const double expected = parameters[p * numberOfSignals + s];
+        CPPUNIT_ASSERT_MESSAGE("Batched fit failed.",
+                               std::abs(results[p * numberOfSignals + s] - expected) <= 1e-4 * expected);
+        CPPUNIT_ASSERT_MESSAGE("Batched fit differs from the per signal fit.",
+                               std::abs(results[p * numberOfSignals + s] - perSignalResult[p]) <= 1e-3 * expected);
+      }
+    }
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkStandardToftsModelBatch)
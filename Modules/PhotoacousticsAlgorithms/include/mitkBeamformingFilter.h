@@ -80,6 +80,10 @@ namespace mitk {
     /** \brief Pointer to the GPU beamforming filter class; for performance reasons the filter is initialized within the constructor and kept for all later computations.
     */
     mitk::PhotoacousticOCLBeamformingFilter::Pointer m_BeamformingOclFilter;
+
+    /** \brief Worker threads for beamforming on CPU without OpenMP; they are kept alive for all slices and later computations.
+    */
+    BeamformingUtils::WorkerPool m_WorkerPool;
   };
 } // namespace mitk
 
@@ -14,16 +14,21 @@ found in the LICENSE file.
 #define MITK_BEAMFORMING_FILTER_UTILS
 
 #include "mitkImageToImageFilter.h"
+#include <condition_variable>
 #include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
 #include "./OpenCLFilter/mitkPhotoacousticOCLBeamformingFilter.h"
 #include "mitkBeamformingSettings.h"
+#include "MitkPhotoacousticsAlgorithmsExports.h"
 
 namespace mitk {
   /*!
   * \brief Class implementing util functionality for beamforming on CPU
   *
   */
-  class BeamformingUtils final
+  class MITKPHOTOACOUSTICSALGORITHMS_EXPORT BeamformingUtils final
   {
   public:
 
@@ -39,6 +44,78 @@ namespace mitk {
     */
     static void sDMASSphericalLine(float* input, float* output, float inputDim[2], float outputDim[2], const short& line, const mitk::BeamformingSettings::Pointer config);
 
+    /** \brief A persistent pool of worker threads, which is used by BeamformSlice() if OpenMP is not available
+    *
+    * The threads are started by the first call of Run() and are kept alive until the pool is destroyed, so a pool
+    * should be created once, e.g. per filter, and reused for all slices.
+    */
+    class MITKPHOTOACOUSTICSALGORITHMS_EXPORT WorkerPool final
+    {
+    public:
+      WorkerPool();
+      ~WorkerPool();
+
+      WorkerPool(const WorkerPool&) = delete;
+      WorkerPool& operator=(const WorkerPool&) = delete;
+
+      /** \brief Runs the job on all worker threads and the calling thread and returns when all of them finished it
+      */
+      void Run(const std::function<void()>& job);
+
+    private:
+      void WorkerLoop();
+
+      std::vector<std::thread> m_Threads;
+      std::mutex m_Mutex;
+      std::condition_variable m_JobAvailable;
+      std::condition_variable m_JobFinished;
+      const std::function<void()>* m_Job;
+      unsigned long m_Generation;
+      unsigned int m_RunningWorkers;
+      bool m_Stop;
+    };
+
+    /** \brief Function to perform beamforming on CPU for a whole slice using the algorithm set in config
+    *
+    * The slice is split into tiles of lines and samples, which are processed by persistent worker threads
+    * using the *SphericalTile() functions: the OpenMP runtime if available, otherwise the given pool. Without
+    * OpenMP and pool, the slice is processed on the calling thread.
+    * The result equals the one of the *SphericalLine() functions up to floating point rounding.
+    */
+    static void BeamformSlice(const float* input, float* output, const float inputDim[2], const float outputDim[2], const mitk::BeamformingSettings::Pointer config, WorkerPool* pool = nullptr);
+
+    /** \brief A rectangular part of the output slice given by the line range [LineBegin, LineEnd) and the sample range [SampleBegin, SampleEnd)
+    */
+    struct Tile
+    {
+      unsigned int LineBegin;
+      unsigned int LineEnd;
+      unsigned int SampleBegin;
+      unsigned int SampleEnd;
+    };
+
+    /** \brief Per thread working memory of the tile functions, sized for one delay and value per transducer element
+    */
+    struct TileScratch
+    {
+      std::vector<int> Delays;
+      std::vector<float> Values;
+    };
+
+    /** \brief Function to perform beamforming on CPU for a tile, using DAS and spherical delay
+    */
+    static void DASSphericalTile(const float* input, float* output, const float inputDim[2], const float outputDim[2], const Tile& tile, TileScratch& scratch, const mitk::BeamformingSettings::Pointer config);
+
+    /** \brief Function to perform beamforming on CPU for a tile, using DMAS and spherical delay
+    *
+    * The sum over all signal pairs is computed in linear time as ((sum s)^2 - sum s^2) / 2 of the signed square roots s.
+    */
+    static void DMASSphericalTile(const float* input, float* output, const float inputDim[2], const float outputDim[2], const Tile& tile, TileScratch& scratch, const mitk::BeamformingSettings::Pointer config);
+
+    /** \brief Function to perform beamforming on CPU for a tile, using signed DMAS and spherical delay
+    */
+    static void sDMASSphericalTile(const float* input, float* output, const float inputDim[2], const float outputDim[2], const Tile& tile, TileScratch& scratch, const mitk::BeamformingSettings::Pointer config);
+
     /** \brief Pointer holding the Von-Hann apodization window for beamforming
     * @param samples the resolution at which the window is created
     */
@@ -14,8 +14,6 @@ found in the LICENSE file.
 #include "mitkImageReadAccessor.h"
 #include <algorithm>
 #include <itkImageIOBase.h>
-#include <chrono>
-#include <thread>
 #include <itkImageIOBase.h>
 #include "mitkImageCast.h"
 #include "mitkBeamformingFilter.h"
@@ -103,8 +101,6 @@ void mitk::BeamformingFilter::GenerateData()
   if (!output->IsInitialized())
     return;
 
-  auto begin = std::chrono::high_resolution_clock::now(); // debbuging the performance...
-
   if (!m_Conf->GetUseGPU())
   {
     int progInterval = output->GetDimension(2) / 20 > 1 ? output->GetDimension(2) / 20 : 1;
@@ -120,47 +116,8 @@ void mitk::BeamformingFilter::GenerateData()
 
       m_OutputData = new float[m_Conf->GetReconstructionLines()*m_Conf->GetSamplesPerLine()];
 
-      // fill the image with zeros
-      for (int l = 0; l < outputDim[0]; ++l)
-      {
-        for (int s = 0; s < outputDim[1]; ++s)
-        {
-          m_OutputData[l*(short)outputDim[1] + s] = 0;
-        }
-      }
-
-      std::thread *threads = new std::thread[(short)outputDim[0]];
-
-      // every line will be beamformed in a seperate thread
-      if (m_Conf->GetAlgorithm() == BeamformingSettings::BeamformingAlgorithm::DAS)
-      {
-        for (short line = 0; line < outputDim[0]; ++line)
-        {
-          threads[line] = std::thread(&BeamformingUtils::DASSphericalLine, m_InputData,
-            m_OutputData, inputDim, outputDim, line, m_Conf);
-        }
-      }
-      else if (m_Conf->GetAlgorithm() == BeamformingSettings::BeamformingAlgorithm::DMAS)
-      {
-        for (short line = 0; line < outputDim[0]; ++line)
-        {
-          threads[line] = std::thread(&BeamformingUtils::DMASSphericalLine, m_InputData,
-            m_OutputData, inputDim, outputDim, line, m_Conf);
-        }
-      }
-      else if (m_Conf->GetAlgorithm() == BeamformingSettings::BeamformingAlgorithm::sDMAS)
-      {
-        for (short line = 0; line < outputDim[0]; ++line)
-        {
-          threads[line] = std::thread(&BeamformingUtils::sDMASSphericalLine, m_InputData,
-            m_OutputData, inputDim, outputDim, line, m_Conf);
-        }
-      }
-      // wait for all lines to finish
-      for (short line = 0; line < outputDim[0]; ++line)
-      {
-        threads[line].join();
-      }
+      // the slice is split into tiles which are beamformed by a pool of worker threads
+      BeamformingUtils::BeamformSlice(m_InputData, m_OutputData, inputDim, outputDim, m_Conf, &m_WorkerPool);
 
       output->SetSlice(m_OutputData, i);
 
@@ -256,6 +213,5 @@ void mitk::BeamformingFilter::GenerateData()
 #endif
   m_TimeOfHeaderInitialization.Modified();
 
-  auto end = std::chrono::high_resolution_clock::now();
-  MITK_INFO << "Beamforming of " << output->GetDimension(2) << " Images completed in " << ((float)std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count()) / 1000000 << "ms" << std::endl;
+  MITK_INFO << "Beamforming of " << output->GetDimension(2) << " Images completed";
 }
@@ -19,6 +19,155 @@ found in the LICENSE file.
 #include <itkImageIOBase.h>
 #include "mitkImageCast.h"
 #include "mitkBeamformingUtils.h"
+#include <atomic>
+
+namespace
+{
+  // size of the tiles the output slice is split into; a tile should be large enough to amortize scheduling,
+  // but small enough to balance the load, as the number of used lines varies strongly with depth
+  const unsigned int TILE_LINES = 16;
+  const unsigned int TILE_SAMPLES = 128;
+
+  /** \brief Parameters of the spherical delay calculation which are constant for a whole slice
+  */
+  struct SphericalDelayParameters
+  {
+    SphericalDelayParameters(const float inputDim[2], const float outputDim[2], const mitk::BeamformingSettings::Pointer config)
+      : Apodisation(config->GetApodizationFunction()),
+        ApodArraySize((float)config->GetApodizationArraySize()),
+        ElementHeights(config->GetElementHeights()),
+        ElementPositions(config->GetElementPositions()),
+        MinMaxLines(config->GetMinMaxLines()),
+        SoundTimeSpacing(config->GetSpeedOfSound() * config->GetTimeSpacing()),
+        PulseEchoFactor((float)(1 - config->GetIsPhotoacousticImage())),
+        HorizontalExtent(config->GetHorizontalExtent()),
+        InputL((unsigned int)inputDim[0]),
+        InputS(inputDim[1]),
+        OutputL((unsigned int)outputDim[0]),
+        OutputS(outputDim[1])
+    {
+      TotalSamples_i = config->GetReconstructionDepth() / SoundTimeSpacing;
+      TotalSamples_i = TotalSamples_i <= InputS ? TotalSamples_i : InputS;
+    }
+
+    const float* Apodisation;
+    float ApodArraySize;
+    const float* ElementHeights;
+    const float* ElementPositions;
+    const unsigned short* MinMaxLines;
+    float SoundTimeSpacing;
+    float PulseEchoFactor;
+    float HorizontalExtent;
+    float TotalSamples_i;
+    unsigned int InputL;
+    float InputS;
+    unsigned int OutputL;
+    float OutputS;
+  };
+
+  /** \brief Computes the delays of the elements [minLine, maxLine) for one output pixel and fetches their signals.
+  *
+  *  Elements whose delay lies outside of the input get a delay of -1 and a signal of 0.
+  */
+  inline void GatherDelayedSignals(const float* input, const SphericalDelayParameters& p, float l_p, float s_i,
+    unsigned short minLine, unsigned short maxLine, mitk::BeamformingUtils::TileScratch& scratch)
+  {
+    const int usedLines = maxLine - minLine;
+    const float* heights = p.ElementHeights + minLine;
+    const float* positions = p.ElementPositions + minLine;
+    const float* inputLines = input + minLine;
+    int* delays = scratch.Delays.data();
+    float* values = scratch.Values.data();
+
+#if defined(_OPENMP)
+#pragma omp simd
+#endif
+    for (int k = 0; k < usedLines; ++k)
+    {
+      const float dy = s_i - heights[k] / p.SoundTimeSpacing;
+      const float dx = (l_p - positions[k]) / p.SoundTimeSpacing;
+      const int delay = (int)((float)(int)std::sqrt(dy * dy + dx * dx) + p.PulseEchoFactor * s_i);
+      delays[k] = (delay < p.InputS && delay >= 0) ? delay : -1;
+    }
+
+#if defined(_OPENMP)
+#pragma omp simd
+#endif
+    for (int k = 0; k < usedLines; ++k)
+    {
+      values[k] = delays[k] >= 0 ? inputLines[k + delays[k] * p.InputL] : 0.f;
+    }
+  }
+
+  /** \brief Iterates over all pixels of a tile, gathers their delayed signals and stores the result of kernel
+  */
+  template <typename TKernel>
+  void ProcessTile(const float* input, float* output, const SphericalDelayParameters& p,
+    const mitk::BeamformingUtils::Tile& tile, mitk::BeamformingUtils::TileScratch& scratch, TKernel kernel)
+  {
+    if (scratch.Delays.size() < p.InputL)
+    {
+      scratch.Delays.resize(p.InputL);
+      scratch.Values.resize(p.InputL);
+    }
+
+    for (unsigned int sample = tile.SampleBegin; sample < tile.SampleEnd; ++sample)
+    {
+      const float s_i = (float)sample / p.OutputS * p.TotalSamples_i;
+      const unsigned short* minMaxLines = p.MinMaxLines + 2 * sample * p.OutputL;
+
+      for (unsigned int line = tile.LineBegin; line < tile.LineEnd; ++line)
+      {
+        const float l_p = (float)line / p.OutputL * p.HorizontalExtent;
+        const unsigned short minLine = minMaxLines[2 * line];
+        const unsigned short maxLine = minMaxLines[2 * line + 1];
+
+        GatherDelayedSignals(input, p, l_p, s_i, minLine, maxLine, scratch);
+        output[sample * p.OutputL + line] = kernel(maxLine - minLine, scratch);
+      }
+    }
+  }
+
+  /** \brief Sums the signed square roots of the apodized signals and their squares, needed for (s)DMAS
+  */
+  inline void SumSignedRoots(const SphericalDelayParameters& p, int usedLines, const float* values, double& sum, double& squaredSum)
+  {
+    const float apod_mult = p.ApodArraySize / (float)usedLines;
+    double rootSum = 0;
+    double absSum = 0;
+
+#if defined(_OPENMP)
+#pragma omp simd reduction(+:rootSum,absSum)
+#endif
+    for (int k = 0; k < usedLines; ++k)
+    {
+      const float value = values[k] * p.Apodisation[(int)(k * apod_mult)];
+      const float root = std::sqrt(std::fabs(value));
+      rootSum += value < 0 ? -root : root;
+      absSum += std::fabs(value);
+    }
+
+    sum = rootSum;
+    squaredSum = absSum;
+  }
+
+  /** \brief Number of invalid elements as counted by the reference implementation of (s)DMAS, which ignores the last element
+  */
+  inline int CountInvalidPairElements(int usedLines, const int* delays)
+  {
+    int invalid = 0;
+
+#if defined(_OPENMP)
+#pragma omp simd reduction(+:invalid)
+#endif
+    for (int k = 0; k < usedLines - 1; ++k)
+    {
+      invalid += delays[k] < 0;
+    }
+
+    return invalid;
+  }
+}
 
 mitk::BeamformingUtils::BeamformingUtils()
 {
@@ -406,3 +555,211 @@ void mitk::BeamformingUtils::sDMASSphericalLine(
     delete[] AddSample;
   }
 }
+
+void mitk::BeamformingUtils::DASSphericalTile(
+  const float* input, float* output, const float inputDim[2], const float outputDim[2],
+  const Tile& tile, TileScratch& scratch, const mitk::BeamformingSettings::Pointer config)
+{
+  const SphericalDelayParameters p(inputDim, outputDim, config);
+
+  ProcessTile(input, output, p, tile, scratch, [&p](int usedLines, const TileScratch& signals)
+  {
+    const float apod_mult = p.ApodArraySize / (float)usedLines;
+    const int* delays = signals.Delays.data();
+    const float* values = signals.Values.data();
+    float sum = 0;
+    int invalid = 0;
+
+#if defined(_OPENMP)
+#pragma omp simd reduction(+:sum,invalid)
+#endif
+    for (int k = 0; k < usedLines; ++k)
+    {
+      sum += values[k] * p.Apodisation[(short)(k * apod_mult)];
+      invalid += delays[k] < 0;
+    }
+
+    return sum / (usedLines - invalid);
+  });
+}
+
+void mitk::BeamformingUtils::DMASSphericalTile(
+  const float* input, float* output, const float inputDim[2], const float outputDim[2],
+  const Tile& tile, TileScratch& scratch, const mitk::BeamformingSettings::Pointer config)
+{
+  const SphericalDelayParameters p(inputDim, outputDim, config);
+
+  ProcessTile(input, output, p, tile, scratch, [&p](int usedLines, const TileScratch& signals)
+  {
+    double sum = 0;
+    double squaredSum = 0;
+    SumSignedRoots(p, usedLines, signals.Values.data(), sum, squaredSum);
+
+    // sum over all pairs i < j of s_i * s_j
+    const float pairSum = (float)((sum * sum - squaredSum) / 2);
+    const int validLines = usedLines - CountInvalidPairElements(usedLines, signals.Delays.data());
+
+    return pairSum / (float)(pow(validLines, 2) - (validLines - 1));
+  });
+}
+
+void mitk::BeamformingUtils::sDMASSphericalTile(
+  const float* input, float* output, const float inputDim[2], const float outputDim[2],
+  const Tile& tile, TileScratch& scratch, const mitk::BeamformingSettings::Pointer config)
+{
+  const SphericalDelayParameters p(inputDim, outputDim, config);
+
+  ProcessTile(input, output, p, tile, scratch, [&p](int usedLines, const TileScratch& signals)
+  {
+    double sum = 0;
+    double squaredSum = 0;
+    SumSignedRoots(p, usedLines, signals.Values.data(), sum, squaredSum);
+
+    const float* values = signals.Values.data();
+    float sign = 0;
+
+#if defined(_OPENMP)
+#pragma omp simd reduction(+:sign)
+#endif
+    for (int k = 0; k < usedLines - 1; ++k)
+    {
+      sign += values[k];
+    }
+
+    const float pairSum = (float)((sum * sum - squaredSum) / 2);
+    const int validLines = usedLines - CountInvalidPairElements(usedLines, signals.Delays.data());
+
+    return pairSum / (float)(pow(validLines, 2) - (validLines - 1)) * ((sign > 0) - (sign < 0));
+  });
+}
+
+mitk::BeamformingUtils::WorkerPool::WorkerPool() :
+  m_Job(nullptr),
+  m_Generation(0),
+  m_RunningWorkers(0),
+  m_Stop(false)
+{
+}
+
+mitk::BeamformingUtils::WorkerPool::~WorkerPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Stop = true;
+  }
+  m_JobAvailable.notify_all();
+
+  for (auto& thread : m_Threads)
+  {
+    thread.join();
+  }
+}
+
+void mitk::BeamformingUtils::WorkerPool::Run(const std::function<void()>& job)
+{
+  // the calling thread works as well, so one thread less than cores is started
+  if (m_Threads.empty())
+  {
+    const unsigned int numberOfThreads = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned int i = 1; i < numberOfThreads; ++i)
+    {
+      m_Threads.emplace_back(&WorkerPool::WorkerLoop, this);
+    }
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Job = &job;
+    m_RunningWorkers = (unsigned int)m_Threads.size();
+    ++m_Generation;
+  }
+  m_JobAvailable.notify_all();
+
+  job();
+
+  std::unique_lock<std::mutex> lock(m_Mutex);
+  m_JobFinished.wait(lock, [this] { return 0 == m_RunningWorkers; });
+  m_Job = nullptr;
+}
+
+void mitk::BeamformingUtils::WorkerPool::WorkerLoop()
+{
+  unsigned long generation = 0;
+
+  std::unique_lock<std::mutex> lock(m_Mutex);
+  while (true)
+  {
+    m_JobAvailable.wait(lock, [&] { return m_Stop || generation != m_Generation; });
+    if (m_Stop)
+      return;
+
+    generation = m_Generation;
+    const std::function<void()>* job = m_Job;
+
+    lock.unlock();
+    (*job)();
+    lock.lock();
+
+    if (0 == --m_RunningWorkers)
+      m_JobFinished.notify_one();
+  }
+}
+
+void mitk::BeamformingUtils::BeamformSlice(const float* input, float* output, const float inputDim[2], const float outputDim[2],
+  const mitk::BeamformingSettings::Pointer config, WorkerPool* pool)
+{
+  // the min/max lines are computed lazily by the settings; make sure this does not happen concurrently in the workers
+  config->GetMinMaxLines();
+
+  const unsigned int outputL = (unsigned int)outputDim[0];
+  const unsigned int outputS = (unsigned int)outputDim[1];
+
+  std::vector<Tile> tiles;
+  for (unsigned int sample = 0; sample < outputS; sample += TILE_SAMPLES)
+  {
+    for (unsigned int line = 0; line < outputL; line += TILE_LINES)
+    {
+      tiles.push_back({ line, std::min(line + TILE_LINES, outputL), sample, std::min(sample + TILE_SAMPLES, outputS) });
+    }
+  }
+
+  const BeamformingSettings::BeamformingAlgorithm algorithm = config->GetAlgorithm();
+  auto processTile = [&](const Tile& tile, TileScratch& scratch)
+  {
+    if (algorithm == BeamformingSettings::BeamformingAlgorithm::DAS)
+      DASSphericalTile(input, output, inputDim, outputDim, tile, scratch, config);
+    else if (algorithm == BeamformingSettings::BeamformingAlgorithm::DMAS)
+      DMASSphericalTile(input, output, inputDim, outputDim, tile, scratch, config);
+    else if (algorithm == BeamformingSettings::BeamformingAlgorithm::sDMAS)
+      sDMASSphericalTile(input, output, inputDim, outputDim, tile, scratch, config);
+  };
+
+#if defined(_OPENMP)
+  // the OpenMP runtime keeps its worker threads alive between slices
+#pragma omp parallel
+  {
+    TileScratch scratch;
+
+#pragma omp for schedule(dynamic)
+    for (int tile = 0; tile < (int)tiles.size(); ++tile)
+    {
+      processTile(tiles[tile], scratch);
+    }
+  }
+#else
+  std::atomic<size_t> nextTile(0);
+  auto worker = [&]()
+  {
+    TileScratch scratch;
+    for (size_t tile = nextTile++; tile < tiles.size(); tile = nextTile++)
+    {
+      processTile(tiles[tile], scratch);
+    }
+  };
+
+  if (nullptr != pool)
+    pool->Run(worker);
+  else
+    worker();
+#endif
+}
@@ -17,5 +17,10 @@ set(MODULE_TESTS
   mitkPAFilterServiceTest.cpp
   mitkCastToFloatImageFilterTest.cpp
   mitkCropImageFilterTest.cpp
+  mitkBeamformingUtilsTest.cpp
+  )
+# Built into a driver of their own with MITK_BUILD_BENCHMARKS, not run by ctest
+set(MODULE_BENCHMARKS
+  mitkBeamformingThroughputBenchmark.cpp
   )
 set(RESOURCE_FILES)
@@ -0,0 +1,113 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+#include <mitkImage.h>
+#include <mitkBeamformingFilter.h>
+#include <chrono>
+#include <random>
+
+/** Reports the number of frames per second the CPU beamforming filter achieves.
+ * Only built with MITK_BUILD_BENCHMARKS. */
+class mitkBeamformingThroughputBenchmarkSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkBeamformingThroughputBenchmarkSuite);
+  MITK_TEST(testThroughput_DAS);
+  MITK_TEST(testThroughput_DMAS);
+  MITK_TEST(testThroughput_sDMAS);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  const unsigned int ELEMENTS = 128;
+  const unsigned int SAMPLES = 2048;
+  const unsigned int RECONSTRUCTED_LINES = 128;
+  const unsigned int RECONSTRUCTED_SAMPLES = 512;
+  const unsigned int FRAMES = 8;
+  const float SPEED_OF_SOUND = 1540; // m/s
+  const float SPACING_X = 0.3; // mm
+  const float SPACING_Y = 0.00625; // us
+
+  unsigned int m_InputDim[3];
+  std::vector<float> m_Data;
+
+public:
+
+  void setUp() override
+  {
+    m_InputDim[0] = ELEMENTS;
+    m_InputDim[1] = SAMPLES;
+    m_InputDim[2] = FRAMES;
+
+    std::default_random_engine randGen(42);
+    std::normal_distribution<float> noise(0.f, 100.f);
+    m_Data.resize(ELEMENTS * SAMPLES * FRAMES);
+    for (auto& value : m_Data)
+    {
+      value = noise(randGen);
+    }
+  }
+
+  void tearDown() override
+  {
+    m_Data.clear();
+  }
+
+  mitk::BeamformingSettings::Pointer createConfig(mitk::BeamformingSettings::BeamformingAlgorithm alg)
+  {
+    return mitk::BeamformingSettings::New(SPACING_X / 1000,
+      SPEED_OF_SOUND,
+      SPACING_Y / 1000000,
+      27.f,
+      true,
+      RECONSTRUCTED_SAMPLES,
+      RECONSTRUCTED_LINES,
+      m_InputDim,
+      SPEED_OF_SOUND * (SPACING_Y / 1000000) * SAMPLES,
+      false,
+      16,
+      mitk::BeamformingSettings::DelayCalc::Spherical,
+      mitk::BeamformingSettings::Apodization::Hann,
+      ELEMENTS * 2,
+      alg);
+  }
+
+  void testThroughput(mitk::BeamformingSettings::BeamformingAlgorithm alg, const std::string& name)
+  {
+    mitk::Image::Pointer inputImage = mitk::Image::New();
+    inputImage->Initialize(mitk::MakeScalarPixelType<float>(), 3, m_InputDim);
+    mitk::Vector3D spacing;
+    spacing[0] = SPACING_X;
+    spacing[1] = SPACING_Y;
+    spacing[2] = 1;
+    inputImage->SetSpacing(spacing);
+    inputImage->SetImportVolume((const void*)m_Data.data(), mitk::Image::CopyMemory);
+
+    auto filter = mitk::BeamformingFilter::New(createConfig(alg));
+    filter->SetInput(inputImage);
+
+    auto begin = std::chrono::high_resolution_clock::now();
+    filter->Update();
+    auto end = std::chrono::high_resolution_clock::now();
+
+    double seconds = std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count() / 1000000.;
+    MITK_INFO << name << ": " << FRAMES / seconds << " frames/s (" << ELEMENTS << "x" << SAMPLES << " -> "
+              << RECONSTRUCTED_LINES << "x" << RECONSTRUCTED_SAMPLES << ")";
+
+    CPPUNIT_ASSERT_MESSAGE("Output has the expected number of frames", filter->GetOutput()->GetDimension(2) == FRAMES);
+  }
+
+  void testThroughput_DAS() { testThroughput(mitk::BeamformingSettings::BeamformingAlgorithm::DAS, "DAS"); }
+  void testThroughput_DMAS() { testThroughput(mitk::BeamformingSettings::BeamformingAlgorithm::DMAS, "DMAS"); }
+  void testThroughput_sDMAS() { testThroughput(mitk::BeamformingSettings::BeamformingAlgorithm::sDMAS, "sDMAS"); }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkBeamformingThroughputBenchmark)
@@ -0,0 +1,139 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+#include <mitkBeamformingUtils.h>
+#include <cstring>
+#include <random>
+
+class mitkBeamformingUtilsTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkBeamformingUtilsTestSuite);
+  MITK_TEST(testTilesMatchLines_DAS);
+  MITK_TEST(testTilesMatchLines_DMAS);
+  MITK_TEST(testTilesMatchLines_sDMAS);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  const unsigned int ELEMENTS = 128;
+  const unsigned int SAMPLES = 2048;
+  const unsigned int RECONSTRUCTED_LINES = 128;
+  const unsigned int RECONSTRUCTED_SAMPLES = 512;
+  const unsigned int FRAMES = 1;
+  const float SPEED_OF_SOUND = 1540; // m/s
+  const float SPACING_X = 0.3; // mm
+  const float SPACING_Y = 0.00625; // us
+
+  unsigned int m_InputDim[3];
+  std::vector<float> m_Data;
+
+public:
+
+  void setUp() override
+  {
+    m_InputDim[0] = ELEMENTS;
+    m_InputDim[1] = SAMPLES;
+    m_InputDim[2] = FRAMES;
+
+    std::default_random_engine randGen(42);
+    std::normal_distribution<float> noise(0.f, 100.f);
+    m_Data.resize(ELEMENTS * SAMPLES * FRAMES);
+    for (auto& value : m_Data)
+    {
+      value = noise(randGen);
+    }
+  }
+
+  void tearDown() override
+  {
+    m_Data.clear();
+  }
+
+  mitk::BeamformingSettings::Pointer createConfig(mitk::BeamformingSettings::BeamformingAlgorithm alg)
+  {
+    return mitk::BeamformingSettings::New(SPACING_X / 1000,
+      SPEED_OF_SOUND,
+      SPACING_Y / 1000000,
+      27.f,
+      true,
+      RECONSTRUCTED_SAMPLES,
+      RECONSTRUCTED_LINES,
+      m_InputDim,
+      SPEED_OF_SOUND * (SPACING_Y / 1000000) * SAMPLES,
+      false,
+      16,
+      mitk::BeamformingSettings::DelayCalc::Spherical,
+      mitk::BeamformingSettings::Apodization::Hann,
+      ELEMENTS * 2,
+      alg);
+  }
+
+  /** The tiled slice beamforming has to reproduce the reference implementation which beamforms line by line */
+  void testTilesMatchLines(mitk::BeamformingSettings::BeamformingAlgorithm alg)
+  {
+    auto config = createConfig(alg);
+    float inputDim[2] = { (float)ELEMENTS, (float)SAMPLES };
+    float outputDim[2] = { (float)RECONSTRUCTED_LINES, (float)RECONSTRUCTED_SAMPLES };
+
+    std::vector<float> reference(RECONSTRUCTED_LINES * RECONSTRUCTED_SAMPLES, 0.f);
+    std::vector<float> tiled(RECONSTRUCTED_LINES * RECONSTRUCTED_SAMPLES, 0.f);
+    std::vector<float> pooled(RECONSTRUCTED_LINES * RECONSTRUCTED_SAMPLES, 0.f);
+
+    config->GetMinMaxLines();
+    for (short line = 0; line < (short)RECONSTRUCTED_LINES; ++line)
+    {
+      if (alg == mitk::BeamformingSettings::BeamformingAlgorithm::DAS)
+        mitk::BeamformingUtils::DASSphericalLine(m_Data.data(), reference.data(), inputDim, outputDim, line, config);
+      else if (alg == mitk::BeamformingSettings::BeamformingAlgorithm::DMAS)
+        mitk::BeamformingUtils::DMASSphericalLine(m_Data.data(), reference.data(), inputDim, outputDim, line, config);
+      else
+        mitk::BeamformingUtils::sDMASSphericalLine(m_Data.data(), reference.data(), inputDim, outputDim, line, config);
+    }
+
+    mitk::BeamformingUtils::BeamformSlice(m_Data.data(), tiled.data(), inputDim, outputDim, config);
+
+    // the slices beamformed by a worker pool equal the ones of the calling thread, also when the pool is reused
+    mitk::BeamformingUtils::WorkerPool pool;
+    for (int run = 0; run < 2; ++run)
+    {
+      mitk::BeamformingUtils::BeamformSlice(m_Data.data(), pooled.data(), inputDim, outputDim, config, &pool);
+      CPPUNIT_ASSERT_MESSAGE("Beamforming with a worker pool differs",
+        0 == std::memcmp(tiled.data(), pooled.data(), tiled.size() * sizeof(float)));
+    }
+
+    // delays are truncated to integer samples, so rounding may pick a neighbouring sample for single elements
+    double maxReference = 0;
+    for (auto value : reference)
+    {
+      if (std::isfinite(value))
+        maxReference = std::max(maxReference, (double)std::abs(value));
+    }
+
+    unsigned int mismatches = 0;
+    for (size_t i = 0; i < reference.size(); ++i)
+    {
+      if (!std::isfinite(reference[i]) && !std::isfinite(tiled[i]))
+        continue;
+      if (std::abs(reference[i] - tiled[i]) > 0.01 * maxReference)
+        ++mismatches;
+    }
+
+    CPPUNIT_ASSERT_MESSAGE("Tiled beamforming deviates from line-wise beamforming in " + std::to_string(mismatches) + " pixels",
+      mismatches < reference.size() / 1000 + 1);
+  }
+
+  void testTilesMatchLines_DAS() { testTilesMatchLines(mitk::BeamformingSettings::BeamformingAlgorithm::DAS); }
+  void testTilesMatchLines_DMAS() { testTilesMatchLines(mitk::BeamformingSettings::BeamformingAlgorithm::DMAS); }
+  void testTilesMatchLines_sDMAS() { testTilesMatchLines(mitk::BeamformingSettings::BeamformingAlgorithm::sDMAS); }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkBeamformingUtils)
@@ -18,15 +18,58 @@ found in the LICENSE file.
 #include "mitkImageTimeSelector.h"
 #include "mitkRenderingManager.h"
 #include "mitkSegmentationInterpolationController.h"
+#include "mitkSparseImagePatch.h"
 
-#include <itkImageRegionConstIterator.h>
-#include <itkImageSliceIteratorWithIndex.h>
+#include <itkImageRegionIterator.h>
 
+#include <cstring>
 #include <type_traits>
 
+namespace
+{
+  template <typename TPixel>
+  double ReadDiffValue(const char *value)
+  {
+    TPixel pixel;
+    std::memcpy(&pixel, value, sizeof(TPixel));
+    return static_cast<double>(pixel);
+  }
+
+  typedef double (*DiffValueReaderType)(const char *);
+
+  DiffValueReaderType GetDiffValueReader(int typeId)
+  {
+    if (typeId == mitk::MapPixelComponentType<double>::value)
+      return &ReadDiffValue<double>;
+    if (typeId == mitk::MapPixelComponentType<float>::value)
+      return &ReadDiffValue<float>;
+    if (typeId == mitk::MapPixelComponentType<long>::value)
+      return &ReadDiffValue<long>;
+    if (typeId == mitk::MapPixelComponentType<unsigned long>::value)
+      return &ReadDiffValue<unsigned long>;
+    if (typeId == mitk::MapPixelComponentType<int>::value)
+      return &ReadDiffValue<int>;
+    if (typeId == mitk::MapPixelComponentType<unsigned int>::value)
+      return &ReadDiffValue<unsigned int>;
+    if (typeId == mitk::MapPixelComponentType<short>::value)
+      return &ReadDiffValue<short>;
+    if (typeId == mitk::MapPixelComponentType<unsigned short>::value)
+      return &ReadDiffValue<unsigned short>;
+    if (typeId == mitk::MapPixelComponentType<char>::value)
+      return &ReadDiffValue<char>;
+    if (typeId == mitk::MapPixelComponentType<unsigned char>::value)
+      return &ReadDiffValue<unsigned char>;
+    return nullptr;
+  }
+}
+
 mitk::DiffImageApplier::DiffImageApplier()
   : m_Image(nullptr),
     m_SliceDifferenceImage(nullptr),
+    m_DiffPatch(nullptr),
+    m_DiffValueReader(nullptr),
+    m_DiffImageDimension(0),
+    m_DiffWidth(0),
     m_SliceIndex(0),
     m_SliceDimension(0),
     m_TimeStep(0),
@@ -50,12 +93,13 @@ void mitk::DiffImageApplier::ExecuteOperation(Operation *operation)
     m_Image = imageOperation->GetImage();
     Image::Pointer image3D = m_Image; // will be changed later in case of 3D+t
 
-    m_SliceDifferenceImage = imageOperation->GetDiffImage();
+    const std::vector<unsigned int> &diffDimensions = imageOperation->GetDiffImageDimensions();
+    m_DiffImageDimension = static_cast<unsigned int>(diffDimensions.size());
     m_TimeStep = imageOperation->GetTimeStep();
 
     m_Factor = imageOperation->GetFactor();
 
-    if (m_SliceDifferenceImage->GetDimension() == 2)
+    if (m_DiffImageDimension == 2)
     {
       m_SliceIndex = imageOperation->GetSliceIndex();
       m_SliceDimension = imageOperation->GetSliceDimension();
@@ -76,132 +120,97 @@ void mitk::DiffImageApplier::ExecuteOperation(Operation *operation)
           break;
       }
 
-      if (m_SliceDifferenceImage->GetDimension() != 2 || (m_Image->GetDimension() < 3 || m_Image->GetDimension() > 4) ||
-          m_SliceDifferenceImage->GetDimension(0) != m_Image->GetDimension(m_Dimension0) ||
-          m_SliceDifferenceImage->GetDimension(1) != m_Image->GetDimension(m_Dimension1) ||
+      if ((m_Image->GetDimension() < 3 || m_Image->GetDimension() > 4) ||
+          diffDimensions[0] != m_Image->GetDimension(m_Dimension0) ||
+          diffDimensions[1] != m_Image->GetDimension(m_Dimension1) ||
           m_SliceIndex >= m_Image->GetDimension(m_SliceDimension))
       {
         itkExceptionMacro(
           "Slice and image dimensions differ or slice index is too large. Sorry, cannot work like this.");
         return;
       }
-
-      if (m_Image->GetDimension() == 4)
-      {
-        ImageTimeSelector::Pointer timeSelector = ImageTimeSelector::New();
-        timeSelector->SetInput(m_Image);
-        timeSelector->SetTimeNr(m_TimeStep);
-        timeSelector->UpdateLargestPossibleRegion();
-        image3D = timeSelector->GetOutput();
-      }
-
-      // this will do a long long if/else to find out both pixel types
-      AccessFixedDimensionByItk(image3D, ItkImageSwitch2DDiff, 3);
-
-      if (m_Factor == 1 || m_Factor == -1)
-      {
-        if (m_Factor == -1)
-        {
-          // multiply diff pixels by factor and then send this diff slice
-          AccessFixedDimensionByItk(m_SliceDifferenceImage, ItkInvertPixelValues, 2);
-        }
-
-        // just send the diff to SegmentationInterpolationController
-        SegmentationInterpolationController *interpolator =
-          SegmentationInterpolationController::InterpolatorForImage(m_Image);
-        if (interpolator)
-        {
-          interpolator->BlockModified(true);
-          interpolator->SetChangedSlice(m_SliceDifferenceImage, m_SliceDimension, m_SliceIndex, m_TimeStep);
-        }
-
-        m_Image->Modified();
-
-        if (interpolator)
-        {
-          interpolator->BlockModified(false);
-        }
-
-        if (m_Factor == -1) // return to normal values
-        {
-          AccessFixedDimensionByItk(m_SliceDifferenceImage, ItkInvertPixelValues, 2);
-        }
-      }
-      else // no trivial case, too lazy to do something else
-      {
-        m_Image->Modified(); // check if interpolation is called. prefer to send diff directly
-      }
-
-      RenderingManager::GetInstance()->RequestUpdateAll();
     }
-    else if (m_SliceDifferenceImage->GetDimension() == 3)
+    else if (m_DiffImageDimension == 3)
     {
-      // ...
-      if (m_SliceDifferenceImage->GetDimension(0) != m_Image->GetDimension(0) ||
-          m_SliceDifferenceImage->GetDimension(1) != m_Image->GetDimension(1) ||
-          m_SliceDifferenceImage->GetDimension(2) != m_Image->GetDimension(2) || m_TimeStep >= m_Image->GetDimension(3))
+      if (diffDimensions[0] != m_Image->GetDimension(0) || diffDimensions[1] != m_Image->GetDimension(1) ||
+          diffDimensions[2] != m_Image->GetDimension(2) || m_TimeStep >= m_Image->GetDimension(3))
       {
         itkExceptionMacro("Diff image size differs from original image size. Sorry, cannot work like this.");
         return;
       }
+    }
+    else
+    {
+      itkExceptionMacro("Diff image must be 2D or 3D. Sorry, cannot work like this.");
+      return;
+    }
 
-      if (m_Image->GetDimension() == 4)
-      {
-        ImageTimeSelector::Pointer timeSelector = ImageTimeSelector::New();
-        timeSelector->SetInput(m_Image);
-        timeSelector->SetTimeNr(m_TimeStep);
-        timeSelector->UpdateLargestPossibleRegion();
-        image3D = timeSelector->GetOutput();
-      }
+    m_DiffPatch = &imageOperation->GetDiffPatch();
+    m_DiffValueReader = GetDiffValueReader(imageOperation->GetDiffPixelType()->GetComponentType());
+    m_DiffWidth = diffDimensions[0];
+    if (m_DiffValueReader == nullptr)
+    {
+      itkExceptionMacro("Pixel type of the diff image is not supported. Sorry, cannot work like this.");
+      return;
+    }
 
-      // this will do a long long if/else to find out both pixel types
-      AccessFixedDimensionByItk(image3D, ItkImageSwitch3DDiff, 3);
+    if (m_Image->GetDimension() == 4)
+    {
+      ImageTimeSelector::Pointer timeSelector = ImageTimeSelector::New();
+      timeSelector->SetInput(m_Image);
+      timeSelector->SetTimeNr(m_TimeStep);
+      timeSelector->UpdateLargestPossibleRegion();
+      image3D = timeSelector->GetOutput();
+    }
 
-      if (m_Factor == 1 || m_Factor == -1)
-      {
-        if (m_Factor == -1)
-        {
-          // multiply diff pixels by factor and then send this diff slice
-          AccessFixedDimensionByItk(m_SliceDifferenceImage, ItkInvertPixelValues, 3);
-        }
+    // only the changed pixels are touched
+    AccessFixedDimensionByItk(image3D, ItkApplyDiffPatch, 3);
 
-        // just send the diff to SegmentationInterpolationController
-        SegmentationInterpolationController *interpolator =
-          SegmentationInterpolationController::InterpolatorForImage(m_Image);
-        if (interpolator)
-        {
-          interpolator->BlockModified(true);
-          interpolator->SetChangedVolume(m_SliceDifferenceImage, m_TimeStep);
-        }
+    SegmentationInterpolationController *interpolator = nullptr;
+    if (m_Factor == 1 || m_Factor == -1)
+    {
+      interpolator = SegmentationInterpolationController::InterpolatorForImage(m_Image);
+    }
 
-        m_Image->Modified();
+    if (interpolator)
+    {
+      // just send the diff to SegmentationInterpolationController
+      m_SliceDifferenceImage = imageOperation->GetDiffImage();
+      interpolator->BlockModified(true);
 
-        if (interpolator)
+      if (m_DiffImageDimension == 2)
+      {
+        if (m_Factor == -1)
         {
-          interpolator->BlockModified(false);
+          // multiply diff pixels by factor and then send this diff slice
+          AccessFixedDimensionByItk(m_SliceDifferenceImage, ItkInvertPixelValues, 2);
         }
-
-        if (m_Factor == -1) // return to normal values
+        interpolator->SetChangedSlice(m_SliceDifferenceImage, m_SliceDimension, m_SliceIndex, m_TimeStep);
+      }
+      else
+      {
+        if (m_Factor == -1)
         {
           AccessFixedDimensionByItk(m_SliceDifferenceImage, ItkInvertPixelValues, 3);
         }
+        interpolator->SetChangedVolume(m_SliceDifferenceImage, m_TimeStep);
       }
-      else // no trivial case, too lazy to do something else
-      {
-        m_Image->Modified(); // check if interpolation is called. prefer to send diff directly
-      }
-
-      RenderingManager::GetInstance()->RequestUpdateAll();
     }
-    else
+
+    // this image is modified (good to know for the renderer)
+    m_Image->Modified();
+
+    if (interpolator)
     {
-      itkExceptionMacro("Diff image must be 2D or 3D. Sorry, cannot work like this.");
-      return;
+      interpolator->BlockModified(false);
     }
+
+    RenderingManager::GetInstance()->RequestUpdateAll();
   }
 
   m_Image = nullptr;
   m_SliceDifferenceImage = nullptr;
+  m_DiffPatch = nullptr;
 }
 
 mitk::DiffImageApplier *mitk::DiffImageApplier::GetInstanceForUndo()
@@ -211,127 +220,32 @@ mitk::DiffImageApplier *mitk::DiffImageApplier::GetInstanceForUndo()
   return s_Instance;
 }
 
-// basically copied from mitk/Core/Algorithms/mitkImageAccessByItk.h
-#define myMITKDiffImageApplierFilterAccessByItk(mitkImage, itkImageTypeFunction, pixeltype, dimension, itkimage2)      \
-  if (typeId == MapPixelComponentType<pixeltype>::value)                                                               \
-  \
-{                                                                                                                 \
-    typedef itk::Image<pixeltype, dimension> ImageType;                                                                \
-    typedef mitk::ImageToItk<ImageType> ImageToItkType;                                                                \
-    itk::SmartPointer<ImageToItkType> imagetoitk = ImageToItkType::New();                                              \
-    const mitk::Image *constImage = mitkImage;                                                                         \
-    mitk::Image *nonConstImage = const_cast<mitk::Image *>(constImage);                                                \
-    nonConstImage->Update();                                                                                           \
-    imagetoitk->SetInput(nonConstImage);                                                                               \
-    imagetoitk->Update();                                                                                              \
-    itkImageTypeFunction(imagetoitk->GetOutput(), itkimage2);                                                          \
-  \
-}
-
-#define myMITKDiffImageApplierFilterAccessAllTypesByItk(mitkImage, itkImageTypeFunction, dimension, itkimage2)                                                                                                                                                                                                                                                                                                                                                                                                                              \
-  \
-{                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                      \
-    myMITKDiffImageApplierFilterAccessByItk(mitkImage, itkImageTypeFunction, double, dimension, itkimage2) else myMITKDiffImageApplierFilterAccessByItk(                                                                                                                                                                                                                                                                                                                                                                                    \
-      mitkImage,                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                            \
-      itkImageTypeFunction,                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                 \
-      float,                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                \
-      dimension,                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                            \
-      itkimage2) else myMITKDiffImageApplierFilterAccessByItk(mitkImage, itkImageTypeFunction, int, dimension, itkimage2) else myMITKDiffImageApplierFilterAccessByItk(mitkImage,                                                                                                                                                                                                                                                                                                                                                           \
-                                                                                                                                                                       itkImageTypeFunction,                                                                                                                                                                                                                                                                                                                                                \
-                                                                                                                                                                       unsigned int,                                                                                                                                                                                                                                                                                                                                                        \
-                                                                                                                                                                       dimension,                                                                                                                                                                                                                                                                                                                                                           \
-                                                                                                                                                                       itkimage2) else myMITKDiffImageApplierFilterAccessByItk(mitkImage, itkImageTypeFunction, short, dimension, itkimage2) else myMITKDiffImageApplierFilterAccessByItk(mitkImage, itkImageTypeFunction, unsigned short, dimension, itkimage2) else myMITKDiffImageApplierFilterAccessByItk(mitkImage,                                                                    \
-                                                                                                                                                                                                                                                                                                                                                                                                                                                              itkImageTypeFunction,                                                         \
-                                                                                                                                                                                                                                                                                                                                                                                                                                                              char,                                                                         \
-                                                                                                                                                                                                                                                                                                                                                                                                                                                              dimension,                                                                    \
-                                                                                                                                                                                                                                                                                                                                                                                                                                                              itkimage2) else myMITKDiffImageApplierFilterAccessByItk(mitkImage,            \
-                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                      itkImageTypeFunction, \
-                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                      unsigned char,        \
-                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                      dimension,            \
-                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                      itkimage2)            \
-  \
-}
-
 template <typename TPixel, unsigned int VImageDimension>
-void mitk::DiffImageApplier::ItkImageSwitch2DDiff(itk::Image<TPixel, VImageDimension> *itkImage)
+void mitk::DiffImageApplier::ItkApplyDiffPatch(itk::Image<TPixel, VImageDimension> *image)
 {
-  const int typeId = m_SliceDifferenceImage->GetPixelType().GetComponentType();
-
-  myMITKDiffImageApplierFilterAccessAllTypesByItk(m_SliceDifferenceImage, ItkImageProcessing2DDiff, 2, itkImage);
-}
-
-template <typename TPixel, unsigned int VImageDimension>
-void mitk::DiffImageApplier::ItkImageSwitch3DDiff(itk::Image<TPixel, VImageDimension> *itkImage)
-{
-  const int typeId = m_SliceDifferenceImage->GetPixelType().GetComponentType();
-
-  myMITKDiffImageApplierFilterAccessAllTypesByItk(m_SliceDifferenceImage, ItkImageProcessing3DDiff, 3, itkImage);
-}
-
-template <typename TPixel1, unsigned int VImageDimension1, typename TPixel2, unsigned int VImageDimension2>
-void mitk::DiffImageApplier::ItkImageProcessing2DDiff(itk::Image<TPixel1, VImageDimension1> *diffImage,
-                                                      itk::Image<TPixel2, VImageDimension2> *outputImage)
-{
-  typedef itk::Image<TPixel1, VImageDimension1> DiffImageType;
-  typedef itk::Image<TPixel2, VImageDimension2> VolumeImageType;
-
-  typedef itk::ImageSliceIteratorWithIndex<VolumeImageType> OutputSliceIteratorType;
-  typedef itk::ImageRegionConstIterator<DiffImageType> DiffSliceIteratorType;
+  typedef itk::Image<TPixel, VImageDimension> VolumeImageType;
 
-  typename VolumeImageType::RegionType sliceInVolumeRegion;
+  TPixel *buffer = image->GetBufferPointer();
+  const std::size_t pixelSize = m_DiffPatch->GetPixelSize();
+  const char *value = m_DiffPatch->GetValues().data();
 
-  sliceInVolumeRegion = outputImage->GetLargestPossibleRegion();
-  sliceInVolumeRegion.SetSize(m_SliceDimension, 1);             // just one slice
-  sliceInVolumeRegion.SetIndex(m_SliceDimension, m_SliceIndex); // exactly this slice, please
-
-  OutputSliceIteratorType outputIterator(outputImage, sliceInVolumeRegion);
-  outputIterator.SetFirstDirection(m_Dimension0);
-  outputIterator.SetSecondDirection(m_Dimension1);
-
-  DiffSliceIteratorType diffIterator(diffImage, diffImage->GetLargestPossibleRegion());
-
-  // iterate over output slice (and over input slice simultaneously)
-  outputIterator.GoToBegin();
-  diffIterator.GoToBegin();
-  while (!outputIterator.IsAtEnd())
+  for (const auto &run : m_DiffPatch->GetRuns())
   {
-    while (!outputIterator.IsAtEndOfSlice())
+    for (std::size_t pixel = run.Offset; pixel < run.Offset + run.Length; ++pixel, value += pixelSize)
     {
-      while (!outputIterator.IsAtEndOfLine())
+      auto offset = static_cast<typename VolumeImageType::OffsetValueType>(pixel);
+      if (m_DiffImageDimension == 2)
       {
-        TPixel2 newValue = outputIterator.Get() + (TPixel2)((double)diffIterator.Get() * m_Factor);
-        outputIterator.Set(newValue);
-        ++outputIterator;
-        ++diffIterator;
+        // position of the slice pixel in the volume
+        typename VolumeImageType::IndexType index;
+        index[m_Dimension0] = static_cast<typename VolumeImageType::IndexValueType>(pixel % m_DiffWidth);
+        index[m_Dimension1] = static_cast<typename VolumeImageType::IndexValueType>(pixel / m_DiffWidth);
+        index[m_SliceDimension] = m_SliceIndex;
+        offset = image->ComputeOffset(index);
       }
-      outputIterator.NextLine();
-    }
-    outputIterator.NextSlice();
-  }
-}
 
-template <typename TPixel1, unsigned int VImageDimension1, typename TPixel2, unsigned int VImageDimension2>
-void mitk::DiffImageApplier::ItkImageProcessing3DDiff(itk::Image<TPixel1, VImageDimension1> *diffImage,
-                                                      itk::Image<TPixel2, VImageDimension2> *outputImage)
-{
-  typedef itk::Image<TPixel1, VImageDimension1> DiffImageType;
-  typedef itk::Image<TPixel2, VImageDimension2> VolumeImageType;
-
-  typedef itk::ImageRegionIterator<VolumeImageType> OutputSliceIteratorType;
-  typedef itk::ImageRegionConstIterator<DiffImageType> DiffSliceIteratorType;
-
-  OutputSliceIteratorType outputIterator(outputImage, outputImage->GetLargestPossibleRegion());
-  DiffSliceIteratorType diffIterator(diffImage, diffImage->GetLargestPossibleRegion());
-
-  // iterate over output slice (and over input slice simultaneously)
-  outputIterator.GoToBegin();
-  diffIterator.GoToBegin();
-  while (!outputIterator.IsAtEnd())
-  {
-    TPixel2 newValue = outputIterator.Get() + (TPixel2)((double)diffIterator.Get() * m_Factor);
-    outputIterator.Set(newValue);
-    ++outputIterator;
-    ++diffIterator;
+      buffer[offset] = buffer[offset] + (TPixel)(m_DiffValueReader(value) * m_Factor);
+    }
   }
 }
 
@@ -23,11 +23,15 @@ found in the LICENSE file.
 
 namespace mitk
 {
+  class SparseImagePatch;
+
   /**
     \brief Applies difference images to 3D images.
 
     This class is supposed to execute ApplyDiffImageOperations, which contain information about pixel changes within one
     image slice.
+    Only the changed pixels stored in the operation are touched, the full difference image is
+    restored for the SegmentationInterpolationController only.
     Class should be called from the undo stack. At the moment, ApplyDiffImageOperations are only created by
     OverwriteSliceImageFilter.
 
@@ -49,18 +53,7 @@ namespace mitk
     ~DiffImageApplier() override;
 
     template <typename TPixel, unsigned int VImageDimension>
-    void ItkImageSwitch2DDiff(itk::Image<TPixel, VImageDimension> *image);
-
-    template <typename TPixel, unsigned int VImageDimension>
-    void ItkImageSwitch3DDiff(itk::Image<TPixel, VImageDimension> *image);
-
-    template <typename TPixel1, unsigned int VImageDimension1, typename TPixel2, unsigned int VImageDimension2>
-    void ItkImageProcessing2DDiff(itk::Image<TPixel1, VImageDimension1> *itkImage1,
-                                  itk::Image<TPixel2, VImageDimension2> *itkImage2);
-
-    template <typename TPixel1, unsigned int VImageDimension1, typename TPixel2, unsigned int VImageDimension2>
-    void ItkImageProcessing3DDiff(itk::Image<TPixel1, VImageDimension1> *itkImage1,
-                                  itk::Image<TPixel2, VImageDimension2> *itkImage2);
+    void ItkApplyDiffPatch(itk::Image<TPixel, VImageDimension> *image);
 
     template <typename TPixel, unsigned int VImageDimension>
     void ItkInvertPixelValues(itk::Image<TPixel, VImageDimension> *itkImage);
@@ -68,6 +61,11 @@ namespace mitk
     Image::Pointer m_Image;
     Image::Pointer m_SliceDifferenceImage;
 
+    const SparseImagePatch *m_DiffPatch;
+    double (*m_DiffValueReader)(const char *);
+    unsigned int m_DiffImageDimension;
+    unsigned int m_DiffWidth;
+
     unsigned int m_SliceIndex;
     unsigned int m_SliceDimension;
     unsigned int m_TimeStep;
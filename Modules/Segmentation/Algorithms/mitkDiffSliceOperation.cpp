@@ -12,14 +12,30 @@ found in the LICENSE file.
 
 #include "mitkDiffSliceOperation.h"
 
+#include <mitkExtractSliceFilter.h>
 #include <mitkImage.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkImageWriteAccessor.h>
+#include <mitkVtkImageOverwrite.h>
 
 #include <itkCommand.h>
 
+namespace
+{
+  std::size_t GetNumberOfPixels(const mitk::Image *image)
+  {
+    std::size_t numberOfPixels = 1;
+    for (unsigned int i = 0; i < image->GetDimension() && i < 3; ++i)
+      numberOfPixels *= image->GetDimension(i);
+    return numberOfPixels;
+  }
+}
+
 mitk::DiffSliceOperation::DiffSliceOperation() : Operation(1)
 {
   m_TimeStep = 0;
   m_zlibSliceContainer = nullptr;
+  m_IsSparse = false;
   m_Image = nullptr;
   m_WorldGeometry = nullptr;
   m_SliceGeometry = nullptr;
@@ -34,6 +50,47 @@ mitk::DiffSliceOperation::DiffSliceOperation(mitk::Image *imageVolume,
                                              BaseGeometry *currentWorldGeometry)
   : Operation(1)
 
+{
+  this->Initialize(imageVolume, sliceGeometry, timestep, currentWorldGeometry);
+
+  m_IsSparse = false;
+  m_zlibSliceContainer = CompressedImageContainer::New();
+  m_zlibSliceContainer->SetImage(slice);
+}
+
+mitk::DiffSliceOperation::DiffSliceOperation(mitk::Image *imageVolume,
+                                             Image *slice,
+                                             Image *referenceSlice,
+                                             SlicedGeometry3D *sliceGeometry,
+                                             unsigned int timestep,
+                                             BaseGeometry *currentWorldGeometry)
+  : Operation(1)
+{
+  this->Initialize(imageVolume, sliceGeometry, timestep, currentWorldGeometry);
+
+  m_IsSparse = referenceSlice != nullptr && referenceSlice->GetPixelType() == slice->GetPixelType() &&
+               GetNumberOfPixels(referenceSlice) == GetNumberOfPixels(slice);
+
+  if (m_IsSparse)
+  {
+    ImageReadAccessor referenceAccess(referenceSlice);
+    ImageReadAccessor sliceAccess(slice);
+    m_SlicePatch = SparseImagePatch::Create(referenceAccess.GetData(),
+                                            sliceAccess.GetData(),
+                                            GetNumberOfPixels(slice),
+                                            slice->GetPixelType().GetSize());
+  }
+  else
+  {
+    m_zlibSliceContainer = CompressedImageContainer::New();
+    m_zlibSliceContainer->SetImage(slice);
+  }
+}
+
+void mitk::DiffSliceOperation::Initialize(mitk::Image *imageVolume,
+                                          SlicedGeometry3D *sliceGeometry,
+                                          unsigned int timestep,
+                                          BaseGeometry *currentWorldGeometry)
 {
   m_WorldGeometry = currentWorldGeometry->Clone();
 
@@ -48,9 +105,6 @@ mitk::DiffSliceOperation::DiffSliceOperation(mitk::Image *imageVolume,
 
   m_TimeStep = timestep;
 
-  m_zlibSliceContainer = CompressedImageContainer::New();
-  m_zlibSliceContainer->SetImage(slice);
-
   m_Image = imageVolume;
   m_DeleteObserverTag = 0;
 
@@ -84,13 +138,59 @@ mitk::DiffSliceOperation::~DiffSliceOperation()
 
 mitk::Image::Pointer mitk::DiffSliceOperation::GetSlice()
 {
-  Image::Pointer image = m_zlibSliceContainer->GetImage();
-  return image;
+  if (!m_IsSparse)
+  {
+    Image::Pointer image = m_zlibSliceContainer->GetImage();
+    return image;
+  }
+
+  // extract the current slice exactly like SegTool2D does before it overwrites the slice
+  vtkSmartPointer<mitkVtkImageOverwrite> reslice = vtkSmartPointer<mitkVtkImageOverwrite>::New();
+  reslice->SetOverwriteMode(false);
+  reslice->Modified();
+
+  ExtractSliceFilter::Pointer extractor = ExtractSliceFilter::New(reslice);
+  extractor->SetInput(m_Image);
+  extractor->SetTimeStep(m_TimeStep);
+  extractor->SetWorldGeometry(dynamic_cast<PlaneGeometry *>(m_WorldGeometry.GetPointer()));
+  extractor->SetVtkOutputRequest(false);
+  extractor->SetResliceTransformByGeometry(m_Image->GetTimeGeometry()->GetGeometryForTimeStep(m_TimeStep));
+  extractor->Modified();
+  extractor->Update();
+
+  Image::Pointer slice = extractor->GetOutput();
+  slice->DisconnectPipeline();
+
+  if (GetNumberOfPixels(slice) != m_SlicePatch.GetNumberOfPixels() ||
+      slice->GetPixelType().GetSize() != m_SlicePatch.GetPixelSize())
+  {
+    return nullptr;
+  }
+
+  // overwrite the changed pixels only
+  {
+    ImageWriteAccessor sliceAccess(slice);
+    m_SlicePatch.Apply(sliceAccess.GetData());
+  }
+  slice->Modified();
+
+  return slice;
 }
 
 bool mitk::DiffSliceOperation::IsValid()
 {
-  return m_ImageIsValid && m_zlibSliceContainer.IsNotNull() && (m_WorldGeometry.IsNotNull()); // TODO improve
+  return m_ImageIsValid && (m_IsSparse || m_zlibSliceContainer.IsNotNull()) &&
+         (m_WorldGeometry.IsNotNull()); // TODO improve
+}
+
+std::size_t mitk::DiffSliceOperation::GetMemorySize() const
+{
+  std::size_t size = sizeof(*this);
+  if (m_IsSparse)
+    size += m_SlicePatch.GetMemorySize();
+  else if (m_zlibSliceContainer.IsNotNull())
+    size += m_zlibSliceContainer->GetCompressedSize();
+  return size;
 }
 
 void mitk::DiffSliceOperation::OnImageDeleted()
@@ -14,6 +14,7 @@ found in the LICENSE file.
 #define mitkDiffSliceOperation_h_Included
 
 #include "mitkCompressedImageContainer.h"
+#include "mitkSparseImagePatch.h"
 #include <MitkSegmentationExports.h>
 #include <mitkOperation.h>
 
@@ -34,6 +35,11 @@ namespace mitk
      currentWorldGeometry   specifies the axis where the slice has to be applied in the volume.
 
     This Operation can be used to realize undo-redo functionality for e.g. segmentation purposes.
+
+    If a reference slice is passed (the slice that the volume contains before the operation is executed),
+    only the pixels that differ from it are stored (see SparseImagePatch). GetSlice() then extracts the
+    current slice from the volume and overwrites these pixels, so the undo stack holds the changed pixels
+    only. Otherwise the full slice is kept compressed.
   */
   class MITKSEGMENTATION_EXPORT DiffSliceOperation : public Operation
   {
@@ -57,6 +63,16 @@ namespace mitk
                        unsigned int timestep,
                        BaseGeometry *currentWorldGeometry);
 
+    /** \brief Stores the pixels of slice that differ from referenceSlice only.
+      Falls back to storing the full slice if both slices differ in size or pixel type.
+    */
+    DiffSliceOperation(mitk::Image *imageVolume,
+                       mitk::Image *slice,
+                       mitk::Image *referenceSlice,
+                       SlicedGeometry3D *sliceGeometry,
+                       unsigned int timestep,
+                       BaseGeometry *currentWorldGeometry);
+
     /** \brief Check if it is a valid operation.*/
     bool IsValid();
 
@@ -66,7 +82,8 @@ namespace mitk
     mitk::Image *GetImage() { return this->m_Image; }
     /** \brief Set thee slice to be applied.*/
     void SetImage(vtkImageData *slice) { this->m_Slice = slice; }
-    /** \brief Get the slice that is applied in the operation.*/
+    /** \brief Get the slice that is applied in the operation.
+      Returns nullptr if the slice cannot be restored (i.e. the volume changed its size).*/
     Image::Pointer GetSlice();
 
     /** \brief Get timeStep.*/
@@ -81,14 +98,27 @@ namespace mitk
     void SetCurrentWorldGeometry(BaseGeometry *worldGeometry) { this->m_WorldGeometry = worldGeometry; }
     /** \brief Get the axis where the slice has to be applied in the volume.*/
     BaseGeometry *GetWorldGeometry() { return this->m_WorldGeometry; }
+
+    std::size_t GetMemorySize() const override;
+
   protected:
     ~DiffSliceOperation() override;
 
+    void Initialize(mitk::Image *imageVolume,
+                    SlicedGeometry3D *sliceGeometry,
+                    unsigned int timestep,
+                    BaseGeometry *currentWorldGeometry);
+
     /** \brief Callback for image observer.*/
     void OnImageDeleted();
 
     CompressedImageContainer::Pointer m_zlibSliceContainer;
 
+    /** \brief The changed pixels, used if m_zlibSliceContainer is not set.*/
+    SparseImagePatch m_SlicePatch;
+
+    bool m_IsSparse;
+
     mitk::Image *m_Image;
 
     vtkSmartPointer<vtkImageData> m_Slice;
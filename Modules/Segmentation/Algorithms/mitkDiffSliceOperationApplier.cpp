@@ -13,6 +13,7 @@ found in the LICENSE file.
 #include "mitkDiffSliceOperationApplier.h"
 
 #include "mitkDiffSliceOperation.h"
+#include "mitkLabelSetImage.h"
 #include "mitkRenderingManager.h"
 #include "mitkSegTool2D.h"
 #include <mitkExtractSliceFilter.h>
@@ -44,6 +45,9 @@ void mitk::DiffSliceOperationApplier::ExecuteOperation(Operation *operation)
     vtkSmartPointer<mitkVtkImageOverwrite> reslice = vtkSmartPointer<mitkVtkImageOverwrite>::New();
 
     mitk::Image::Pointer slice = imageOperation->GetSlice();
+    if (slice.IsNull())
+      return;
+
     // Set the slice as 'input'
     reslice->SetInputSlice(slice->GetVtkImageData());
 
@@ -66,6 +70,12 @@ void mitk::DiffSliceOperationApplier::ExecuteOperation(Operation *operation)
     RenderingManager::GetInstance()->RequestUpdateAll();
     imageOperation->GetImage()->Modified();
 
+    // only the label regions around the slice have to be scanned again
+    auto *labelSetImage = dynamic_cast<LabelSetImage *>(imageOperation->GetImage());
+    if (nullptr != labelSetImage)
+      labelSetImage->UpdateLabelRegions(dynamic_cast<PlaneGeometry *>(imageOperation->GetWorldGeometry()),
+                                        imageOperation->GetTimeStep());
+
     mitk::ExtractSliceFilter::Pointer extractor2 = mitk::ExtractSliceFilter::New();
     extractor2->SetInput(imageOperation->GetImage());
     extractor2->SetTimeStep(imageOperation->GetTimeStep());
@@ -109,7 +109,7 @@ namespace mitk
           if (0 == labelIter->first)
             continue; // Do not process background label
 
-          auto labelImage = labelSetImage->CreateLabelMask(labelIter->first, false, layerIndex);
+          auto labelImage = labelSetImage->CreateCroppedLabelMask(labelIter->first, false, layerIndex);
 
           if (labelImage.IsNull())
             continue;
@@ -31,7 +31,6 @@ found in the LICENSE file.
 #include "usGetModuleContext.h"
 
 // Includes for 3DSurfaceInterpolation
-#include "mitkImageTimeSelector.h"
 #include "mitkImageToContourFilter.h"
 #include "mitkSurfaceInterpolationController.h"
 
@@ -178,14 +177,7 @@ void mitk::SegTool2D::UpdateSurfaceInterpolation(const Image *slice,
   contourExtractor->Update();
   contour = contourExtractor->GetOutput();
 
-  mitk::ImageTimeSelector::Pointer timeSelector = mitk::ImageTimeSelector::New();
-  timeSelector->SetInput(workingImage);
-  timeSelector->SetTimeNr(0);
-  timeSelector->SetChannelNr(0);
-  timeSelector->Update();
-  Image::Pointer dimRefImg = timeSelector->GetOutput();
-
-  if (contour->GetVtkPolyData()->GetNumberOfPoints() != 0 && dimRefImg->GetDimension() == 3)
+  if (contour->GetVtkPolyData()->GetNumberOfPoints() != 0 && workingImage->GetDimension() >= 3)
   {
     mitk::SurfaceInterpolationController::GetInstance()->AddNewContour(contour);
     contour->DisconnectPipeline();
@@ -336,19 +328,12 @@ void mitk::SegTool2D::WriteBackSegmentationResult(const std::vector<SegTool2D::S
   DataNode *workingNode(m_ToolManager->GetWorkingData(0));
   auto *image = dynamic_cast<Image *>(workingNode->GetData());
 
-  mitk::ImageTimeSelector::Pointer timeSelector = mitk::ImageTimeSelector::New();
-  timeSelector->SetInput(image);
-  timeSelector->SetTimeNr(0);
-  timeSelector->SetChannelNr(0);
-  timeSelector->Update();
-  Image::Pointer dimRefImg = timeSelector->GetOutput();
-
   for (unsigned int i = 0; i < sliceList.size(); ++i)
   {
     SliceInformation currentSliceInfo = sliceList.at(i);
     if (writeSliceToVolume)
       this->WriteSliceToVolume(currentSliceInfo);
-    if (m_SurfaceInterpolationEnabled && dimRefImg->GetDimension() == 3)
+    if (m_SurfaceInterpolationEnabled && image->GetDimension() >= 3)
     {
       currentSliceInfo.slice->DisconnectPipeline();
       contourExtractor->SetInput(currentSliceInfo.slice);
@@ -369,14 +354,8 @@ void mitk::SegTool2D::WriteSliceToVolume(const mitk::SegTool2D::SliceInformation
   auto *image = dynamic_cast<Image *>(workingNode->GetData());
 
   /*============= BEGIN undo/redo feature block ========================*/
-  // Create undo operation by caching the not yet modified slices
+  // Cache the not yet modified slice for the undo operation
   mitk::Image::Pointer originalSlice = GetAffectedImageSliceAs2DImage(sliceInfo.plane, image, sliceInfo.timestep);
-  auto *undoOperation =
-    new DiffSliceOperation(image,
-                           originalSlice,
-                           dynamic_cast<SlicedGeometry3D *>(originalSlice->GetGeometry()),
-                           sliceInfo.timestep,
-                           sliceInfo.plane);
   /*============= END undo/redo feature block ========================*/
 
   // Make sure that for reslicing and overwriting the same alogrithm is used. We can specify the mode of the vtk
@@ -404,11 +383,26 @@ void mitk::SegTool2D::WriteSliceToVolume(const mitk::SegTool2D::SliceInformation
   image->Modified();
   image->GetVtkImageData()->Modified();
 
+  // only the label regions around the slice have to be scanned again
+  auto *labelSetImage = dynamic_cast<LabelSetImage *>(image);
+  if (nullptr != labelSetImage)
+    labelSetImage->UpdateLabelRegions(sliceInfo.plane, sliceInfo.timestep);
+
   /*============= BEGIN undo/redo feature block ========================*/
-  // specify the undo operation with the edited slice
+  // specify the undo operation with the not yet modified slice and the do operation with the edited slice,
+  // both store only the pixels that differ between these slices
+  mitk::Image::Pointer modifiedSlice = extractor->GetOutput();
+  auto *undoOperation =
+    new DiffSliceOperation(image,
+                           originalSlice,
+                           modifiedSlice,
+                           dynamic_cast<SlicedGeometry3D *>(originalSlice->GetGeometry()),
+                           sliceInfo.timestep,
+                           sliceInfo.plane);
   auto *doOperation =
     new DiffSliceOperation(image,
-                           extractor->GetOutput(),
+                           modifiedSlice,
+                           originalSlice,
                            dynamic_cast<SlicedGeometry3D *>(sliceInfo.slice->GetGeometry()),
                            sliceInfo.timestep,
                            sliceInfo.plane);
@@ -486,6 +486,7 @@ void QmitkSliceBasedInterpolatorWidget::OnAcceptInterpolationClicked()
 
     // the image was modified within the pipeline, but not marked so
     m_WorkingImage->Modified();
+    m_WorkingImage->UpdateLabelRegions(planeGeometry, timeStep);
 
     int clickedSliceDimension(-1);
     int clickedSliceIndex(-1);
@@ -593,6 +594,7 @@ void QmitkSliceBasedInterpolatorWidget::AcceptAllInterpolations(mitk::SliceNavig
       }
 
       m_WorkingImage->Modified();
+      m_WorkingImage->UpdateLabelRegions(reslicePlane, timeStep);
 
       mitk::RenderingManager::GetInstance()->RequestUpdateAll(mitk::RenderingManager::REQUEST_UPDATE_2DWINDOWS);
     }
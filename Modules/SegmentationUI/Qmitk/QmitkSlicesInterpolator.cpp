@@ -20,6 +20,7 @@ found in the LICENSE file.
 #include "mitkCoreObjectFactory.h"
 #include "mitkDiffImageApplier.h"
 #include "mitkInteractionConst.h"
+#include "mitkLabelSetImage.h"
 #include "mitkLevelWindowProperty.h"
 #include "mitkOperationEvent.h"
 #include "mitkOverwriteSliceImageFilter.h"
@@ -137,6 +138,12 @@ QmitkSlicesInterpolator::QmitkSlicesInterpolator(QWidget *parent, const char * /
   command2->SetCallbackFunction(this, &QmitkSlicesInterpolator::OnSurfaceInterpolationInfoChanged);
   SurfaceInterpolationInfoChangedObserverTag = m_SurfaceInterpolator->AddObserver(itk::ModifiedEvent(), command2);
 
+  itk::ReceptorMemberCommand<QmitkSlicesInterpolator>::Pointer command3 =
+    itk::ReceptorMemberCommand<QmitkSlicesInterpolator>::New();
+  command3->SetCallbackFunction(this, &QmitkSlicesInterpolator::OnSurfaceInterpolationFinishedEvent);
+  SurfaceInterpolationFinishedObserverTag =
+    m_SurfaceInterpolator->AddObserver(mitk::SurfaceInterpolationFinishedEvent(), command3);
+
   // feedback node and its visualization properties
   m_FeedbackNode = mitk::DataNode::New();
   mitk::CoreObjectFactory::GetInstance()->SetDefaultProperties(m_FeedbackNode);
@@ -183,12 +190,7 @@ QmitkSlicesInterpolator::QmitkSlicesInterpolator(QWidget *parent, const char * /
     QWidget::layout()->setContentsMargins(0, 0, 0, 0);
   }
 
-  // For running 3D Interpolation in background
-  // create a QFuture and a QFutureWatcher
-
-  connect(&m_Watcher, SIGNAL(started()), this, SLOT(StartUpdateInterpolationTimer()));
-  connect(&m_Watcher, SIGNAL(finished()), this, SLOT(OnSurfaceInterpolationFinished()));
-  connect(&m_Watcher, SIGNAL(finished()), this, SLOT(StopUpdateInterpolationTimer()));
+  // The 3D interpolation runs in the background, see Run3DInterpolation()
   m_Timer = new QTimer(this);
   connect(m_Timer, SIGNAL(timeout()), this, SLOT(ChangeSurfaceColor()));
 }
@@ -333,6 +335,7 @@ QmitkSlicesInterpolator::~QmitkSlicesInterpolator()
   // remove observer
   m_Interpolator->RemoveObserver(InterpolationInfoChangedObserverTag);
   m_SurfaceInterpolator->RemoveObserver(SurfaceInterpolationInfoChangedObserverTag);
+  m_SurfaceInterpolator->RemoveObserver(SurfaceInterpolationFinishedObserverTag);
 
   delete m_Timer;
 }
@@ -587,8 +590,19 @@ void QmitkSlicesInterpolator::Interpolate(mitk::PlaneGeometry *plane,
   }
 }
 
+void QmitkSlicesInterpolator::OnSurfaceInterpolationFinishedEvent(const itk::EventObject & /*e*/)
+{
+  // the controller invokes the event from the GUI thread
+  this->OnSurfaceInterpolationFinished();
+}
+
 void QmitkSlicesInterpolator::OnSurfaceInterpolationFinished()
 {
+  if (!m_SurfaceInterpolator->IsInterpolating())
+  {
+    this->StopUpdateInterpolationTimer();
+  }
+
   mitk::Surface::Pointer interpolatedSurface = m_SurfaceInterpolator->GetInterpolationResult();
   mitk::DataNode *workingNode = m_ToolManager->GetWorkingData(0);
 
@@ -661,6 +675,10 @@ void QmitkSlicesInterpolator::OnAcceptInterpolationClicked()
     m_Segmentation->Modified();
     m_Segmentation->GetVtkImageData()->Modified();
 
+    auto *labelSetImage = dynamic_cast<mitk::LabelSetImage *>(m_Segmentation);
+    if (nullptr != labelSetImage)
+      labelSetImage->UpdateLabelRegions(m_LastSNC->GetCurrentPlaneGeometry(), timestep);
+
     m_FeedbackNode->SetData(nullptr);
     mitk::RenderingManager::GetInstance()->RequestUpdateAll();
   }
@@ -1065,7 +1083,9 @@ void QmitkSlicesInterpolator::OnInterpolationActivated(bool on)
 
 void QmitkSlicesInterpolator::Run3DInterpolation()
 {
-  m_SurfaceInterpolator->Interpolate();
+  // returns immediately, the contours drawn in the meantime are interpolated afterwards
+  this->StartUpdateInterpolationTimer();
+  m_SurfaceInterpolator->InterpolateAsync();
 }
 
 void QmitkSlicesInterpolator::StartUpdateInterpolationTimer()
@@ -1142,13 +1162,9 @@ void QmitkSlicesInterpolator::On3DInterpolationActivated(bool on)
             ret = msgBox.exec();
           }
 
-          if (m_Watcher.isRunning())
-            m_Watcher.waitForFinished();
-
           if (ret == QMessageBox::Yes)
           {
-            m_Future = QtConcurrent::run(this, &QmitkSlicesInterpolator::Run3DInterpolation);
-            m_Watcher.setFuture(m_Future);
+            this->Run3DInterpolation();
           }
           else
           {
@@ -1211,10 +1227,7 @@ void QmitkSlicesInterpolator::OnSurfaceInterpolationInfoChanged(const itk::Event
 {
   if (m_3DInterpolationEnabled)
   {
-    if (m_Watcher.isRunning())
-      m_Watcher.waitForFinished();
-    m_Future = QtConcurrent::run(this, &QmitkSlicesInterpolator::Run3DInterpolation);
-    m_Watcher.setFuture(m_Future);
+    this->Run3DInterpolation();
   }
 }
 
@@ -1271,10 +1284,7 @@ void QmitkSlicesInterpolator::SetCurrentContourListID()
 
         if (m_3DInterpolationEnabled)
         {
-          if (m_Watcher.isRunning())
-            m_Watcher.waitForFinished();
-          m_Future = QtConcurrent::run(this, &QmitkSlicesInterpolator::Run3DInterpolation);
-          m_Watcher.setFuture(m_Future);
+          this->Run3DInterpolation();
         }
       }
     }
@@ -1329,10 +1339,7 @@ void QmitkSlicesInterpolator::OnSliceNavigationControllerDeleted(const itk::Obje
 
 void QmitkSlicesInterpolator::WaitForFutures()
 {
-  if (m_Watcher.isRunning())
-  {
-    m_Watcher.waitForFinished();
-  }
+  m_SurfaceInterpolator->WaitForInterpolation();
 
   if (m_PlaneWatcher.isRunning())
   {
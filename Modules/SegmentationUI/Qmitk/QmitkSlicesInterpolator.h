@@ -114,6 +114,11 @@ public:
   */
   void OnSurfaceInterpolationInfoChanged(const itk::EventObject &);
 
+  /**
+    Called from the GUI thread when the 3D interpolation has finished
+  */
+  void OnSurfaceInterpolationFinishedEvent(const itk::EventObject &);
+
   /**
    * @brief Set the visibility of the 3d interpolation
    */
@@ -249,6 +254,7 @@ private:
 
   unsigned int InterpolationInfoChangedObserverTag;
   unsigned int SurfaceInterpolationInfoChangedObserverTag;
+  unsigned int SurfaceInterpolationFinishedObserverTag;
 
   QGroupBox *m_GroupBoxEnableExclusiveInterpolationMode;
   QComboBox *m_CmbInterpolation;
@@ -278,8 +284,6 @@ private:
 
   mitk::DataStorage::Pointer m_DataStorage;
 
-  QFuture<void> m_Future;
-  QFutureWatcher<void> m_Watcher;
   QTimer *m_Timer;
 
   QFuture<void> m_PlaneFuture;
@@ -6,3 +6,8 @@ set(MODULE_TESTS
   mitkReduceContourSetFilterTest.cpp
   mitkSurfaceInterpolationControllerTest.cpp
 )
+
+# Built into a driver of their own with MITK_BUILD_BENCHMARKS, not run by ctest
+set(MODULE_BENCHMARKS
+  mitkCreateDistanceImageFromSurfaceFilterBenchmark.cpp
+)
@@ -0,0 +1,171 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkCreateDistanceImageFromSurfaceFilter.h>
+#include <mitkMemoryUtilities.h>
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <itkMath.h>
+#include <itkTimeProbe.h>
+
+#include <vtkCellArray.h>
+#include <vtkCellData.h>
+#include <vtkDoubleArray.h>
+#include <vtkPoints.h>
+#include <vtkPolyData.h>
+#include <vtkSmartPointer.h>
+
+#include <cmath>
+
+namespace
+{
+  const double SPHERE_RADIUS = 30.0;
+  const double SPHERE_CENTER = 50.0;
+}
+
+/** Reports the time and the memory the distance image filter needs. Only built with MITK_BUILD_BENCHMARKS. */
+class mitkCreateDistanceImageFromSurfaceFilterBenchmarkSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkCreateDistanceImageFromSurfaceFilterBenchmarkSuite);
+  MITK_TEST(GlobalAgainstCompactlySupportedRBF);
+  MITK_TEST(ReuseDistanceValuesForChangedContour);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  // A circular contour of a sphere. Like ComputeContourSetNormalsFilter, the normals are stored per point
+  // in the cell data.
+  mitk::Surface::Pointer CreateSphereContour(double z, unsigned int numberOfPoints)
+  {
+    const double dz = z - SPHERE_CENTER;
+    const double radius = std::sqrt(SPHERE_RADIUS * SPHERE_RADIUS - dz * dz);
+
+    auto points = vtkSmartPointer<vtkPoints>::New();
+    auto normals = vtkSmartPointer<vtkDoubleArray>::New();
+    normals->SetNumberOfComponents(3);
+    auto polys = vtkSmartPointer<vtkCellArray>::New();
+    polys->InsertNextCell(numberOfPoints);
+
+    for (unsigned int i = 0; i < numberOfPoints; ++i)
+    {
+      const double angle = 2.0 * itk::Math::pi * i / numberOfPoints;
+      points->InsertNextPoint(
+        SPHERE_CENTER + radius * std::cos(angle), SPHERE_CENTER + radius * std::sin(angle), z);
+      normals->InsertNextTuple3(std::cos(angle), std::sin(angle), 0.0);
+      polys->InsertCellPoint(i);
+    }
+
+    auto polyData = vtkSmartPointer<vtkPolyData>::New();
+    polyData->SetPoints(points);
+    polyData->SetPolys(polys);
+    polyData->GetCellData()->SetNormals(normals);
+
+    mitk::Surface::Pointer contour = mitk::Surface::New();
+    contour->SetVtkPolyData(polyData);
+    return contour;
+  }
+
+  mitk::CreateDistanceImageFromSurfaceFilter::Pointer CreateSphereFilter(unsigned int numberOfContours,
+                                                                          unsigned int pointsPerContour)
+  {
+    typedef itk::Image<unsigned char, 3> ReferenceImageType;
+    ReferenceImageType::RegionType region;
+    region.SetSize(0, 100);
+    region.SetSize(1, 100);
+    region.SetSize(2, 100);
+    ReferenceImageType::Pointer referenceImage = ReferenceImageType::New();
+    referenceImage->SetRegions(region);
+
+    mitk::CreateDistanceImageFromSurfaceFilter::Pointer filter = mitk::CreateDistanceImageFromSurfaceFilter::New();
+    filter->SetReferenceImage(referenceImage.GetPointer());
+
+    // contours between the poles of the sphere
+    for (unsigned int i = 0; i < numberOfContours; ++i)
+    {
+      const double z = SPHERE_CENTER + SPHERE_RADIUS * (-0.9 + 1.8 * i / (numberOfContours - 1));
+      filter->SetInput(i, CreateSphereContour(z, pointsPerContour));
+    }
+    return filter;
+  }
+
+public:
+  /**
+    Compares the time and the memory needed by the global and the compactly supported RBF for an increasing
+    number of contours. The global RBF is skipped for the largest inputs, it would take minutes.
+  */
+  void GlobalAgainstCompactlySupportedRBF()
+  {
+    const unsigned int pointsPerContour = 60;
+    const unsigned int numberOfContours[] = {4, 8, 16, 32, 64};
+
+    for (const unsigned int contours : numberOfContours)
+    {
+      for (const auto rbfType : {mitk::CreateDistanceImageFromSurfaceFilter::RBF_GLOBAL,
+                                 mitk::CreateDistanceImageFromSurfaceFilter::RBF_COMPACTLY_SUPPORTED})
+      {
+        const bool global = rbfType == mitk::CreateDistanceImageFromSurfaceFilter::RBF_GLOBAL;
+        if (global && contours > 16)
+          continue;
+
+        auto filter = CreateSphereFilter(contours, pointsPerContour);
+        filter->SetRBFType(rbfType);
+
+        // the filter keeps its equation system, so the memory usage afterwards includes it
+        const std::size_t memoryBefore = mitk::MemoryUtilities::GetProcessMemoryUsage();
+        itk::TimeProbe probe;
+        probe.Start();
+        filter->Update();
+        probe.Stop();
+        const std::size_t memoryAfter = mitk::MemoryUtilities::GetProcessMemoryUsage();
+
+        CPPUNIT_ASSERT(filter->GetOutput()->IsInitialized());
+        MITK_INFO << (global ? "global" : "compactly supported") << " RBF, " << contours << " contours ("
+                  << 3 * contours * pointsPerContour << " centers): " << probe.GetTotal() << " s, "
+                  << (memoryAfter > memoryBefore ? (memoryAfter - memoryBefore) / (1024 * 1024) : 0) << " MB";
+      }
+    }
+  }
+
+  /** Compares the update after a redrawn contour with and without reuse of the previous distance values. */
+  void ReuseDistanceValuesForChangedContour()
+  {
+    auto filter = CreateSphereFilter(16, 60);
+    filter->SetRBFType(mitk::CreateDistanceImageFromSurfaceFilter::RBF_COMPACTLY_SUPPORTED);
+    filter->ReuseDistanceValuesOn();
+    filter->Update();
+
+    auto reference = CreateSphereFilter(16, 60);
+    reference->SetRBFType(mitk::CreateDistanceImageFromSurfaceFilter::RBF_COMPACTLY_SUPPORTED);
+    const unsigned int changedContour = 7;
+    mitk::Surface::Pointer redrawnContour = CreateSphereContour(
+      SPHERE_CENTER + SPHERE_RADIUS * (-0.9 + 1.8 * changedContour / 15), 72);
+    filter->SetInput(changedContour, redrawnContour);
+    reference->SetInput(changedContour, redrawnContour);
+
+    itk::TimeProbe incrementalProbe;
+    incrementalProbe.Start();
+    filter->Update();
+    incrementalProbe.Stop();
+
+    itk::TimeProbe referenceProbe;
+    referenceProbe.Start();
+    reference->Update();
+    referenceProbe.Stop();
+
+    MITK_INFO << "Changed contour: " << filter->GetNumberOfEvaluatedDistanceValues() << " distance values evaluated, "
+              << filter->GetNumberOfReusedDistanceValues() << " reused (" << incrementalProbe.GetTotal()
+              << " s), without reuse " << reference->GetNumberOfEvaluatedDistanceValues() << " evaluated ("
+              << referenceProbe.GetTotal() << " s)";
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkCreateDistanceImageFromSurfaceFilterBenchmark)
@@ -14,10 +14,28 @@ found in the LICENSE file.
 #include <mitkCreateDistanceImageFromSurfaceFilter.h>
 #include <mitkIOUtil.h>
 #include <mitkImageAccessByItk.h>
+#include <mitkImagePixelReadAccessor.h>
 #include <mitkTestFixture.h>
 #include <mitkTestingMacros.h>
 
+#include <itkMath.h>
+
+#include <vtkCellArray.h>
+#include <vtkCellData.h>
 #include <vtkDebugLeaks.h>
+#include <vtkDoubleArray.h>
+#include <vtkPoints.h>
+#include <vtkPolyData.h>
+#include <vtkSmartPointer.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+  const double SPHERE_RADIUS = 30.0;
+  const double SPHERE_CENTER = 50.0;
+}
 
 class mitkCreateDistanceImageFromSurfaceFilterTestSuite : public mitk::TestFixture
 {
@@ -25,11 +43,98 @@ class mitkCreateDistanceImageFromSurfaceFilterTestSuite : public mitk::TestFixtu
   vtkDebugLeaks::SetExitError(0);
   MITK_TEST(TestCreateDistanceImageForLiver);
   MITK_TEST(TestCreateDistanceImageForTube);
+  MITK_TEST(TestCompactlySupportedRBFForSphere);
+  MITK_TEST(TestReuseDistanceValuesForChangedContour);
+  MITK_TEST(TestCompactlySupportedRBFApproximatesGlobalRBF);
   CPPUNIT_TEST_SUITE_END();
 
 private:
   std::vector<mitk::Surface::Pointer> contourList;
 
+  // A circular contour of a sphere. Like ComputeContourSetNormalsFilter, the normals are stored per point
+  // in the cell data.
+  mitk::Surface::Pointer CreateSphereContour(double z, unsigned int numberOfPoints)
+  {
+    const double dz = z - SPHERE_CENTER;
+    const double radius = std::sqrt(SPHERE_RADIUS * SPHERE_RADIUS - dz * dz);
+
+    auto points = vtkSmartPointer<vtkPoints>::New();
+    auto normals = vtkSmartPointer<vtkDoubleArray>::New();
+    normals->SetNumberOfComponents(3);
+    auto polys = vtkSmartPointer<vtkCellArray>::New();
+    polys->InsertNextCell(numberOfPoints);
+
+    for (unsigned int i = 0; i < numberOfPoints; ++i)
+    {
+      const double angle = 2.0 * itk::Math::pi * i / numberOfPoints;
+      points->InsertNextPoint(
+        SPHERE_CENTER + radius * std::cos(angle), SPHERE_CENTER + radius * std::sin(angle), z);
+      normals->InsertNextTuple3(std::cos(angle), std::sin(angle), 0.0);
+      polys->InsertCellPoint(i);
+    }
+
+    auto polyData = vtkSmartPointer<vtkPolyData>::New();
+    polyData->SetPoints(points);
+    polyData->SetPolys(polys);
+    polyData->GetCellData()->SetNormals(normals);
+
+    mitk::Surface::Pointer contour = mitk::Surface::New();
+    contour->SetVtkPolyData(polyData);
+    return contour;
+  }
+
+  mitk::CreateDistanceImageFromSurfaceFilter::Pointer CreateSphereFilter(unsigned int numberOfContours,
+                                                                          unsigned int pointsPerContour)
+  {
+    typedef itk::Image<unsigned char, 3> ReferenceImageType;
+    ReferenceImageType::RegionType region;
+    region.SetSize(0, 100);
+    region.SetSize(1, 100);
+    region.SetSize(2, 100);
+    ReferenceImageType::Pointer referenceImage = ReferenceImageType::New();
+    referenceImage->SetRegions(region);
+
+    mitk::CreateDistanceImageFromSurfaceFilter::Pointer filter = mitk::CreateDistanceImageFromSurfaceFilter::New();
+    filter->SetReferenceImage(referenceImage.GetPointer());
+
+    // contours between the poles of the sphere
+    for (unsigned int i = 0; i < numberOfContours; ++i)
+    {
+      const double z = SPHERE_CENTER + SPHERE_RADIUS * (-0.9 + 1.8 * i / (numberOfContours - 1));
+      filter->SetInput(i, CreateSphereContour(z, pointsPerContour));
+    }
+    return filter;
+  }
+
+  double GetDistanceValue(mitk::Image *distanceImage, const mitk::Point3D &worldPoint)
+  {
+    itk::Index<3> index;
+    distanceImage->GetGeometry()->WorldToIndex(worldPoint, index);
+    mitk::ImagePixelReadAccessor<double, 3> accessor(distanceImage);
+    return accessor.GetPixelByIndex(index);
+  }
+
+  /** Distance from the start to the first point with a positive distance value along the direction, or to the
+      border of the distance image. */
+  double FindZeroCrossing(mitk::CreateDistanceImageFromSurfaceFilter *filter,
+                          const mitk::Point3D &start,
+                          const mitk::Vector3D &direction)
+  {
+    mitk::Image *distanceImage = filter->GetOutput();
+    const double step = filter->GetDistanceImageSpacing();
+
+    double distance = 0.0;
+    itk::Index<3> index;
+    distanceImage->GetGeometry()->WorldToIndex(start, index);
+    while (distanceImage->GetGeometry()->IsIndexInside(index) &&
+           GetDistanceValue(distanceImage, start + direction * distance) < 0.0)
+    {
+      distance += step;
+      distanceImage->GetGeometry()->WorldToIndex(start + direction * distance, index);
+    }
+    return distance;
+  }
+
 public:
   void setUp() override {}
   template <typename TPixel, unsigned int VImageDimension>
@@ -127,6 +232,102 @@ public:
     CPPUNIT_ASSERT_MESSAGE("HolesDistanceImages are not equal!",
                            mitk::Equal(*(holesDistanceImageReference), *(holeDistanceImage), 0.0001, true));
   }
+
+  void TestCompactlySupportedRBFForSphere()
+  {
+    auto filter = CreateSphereFilter(10, 60);
+    filter->SetRBFType(mitk::CreateDistanceImageFromSurfaceFilter::RBF_COMPACTLY_SUPPORTED);
+    filter->Update();
+
+    mitk::Image::Pointer distanceImage = filter->GetOutput();
+    CPPUNIT_ASSERT(distanceImage.IsNotNull());
+
+    mitk::Point3D center;
+    center.Fill(SPHERE_CENTER);
+    CPPUNIT_ASSERT_MESSAGE("Center of the sphere is not inside", GetDistanceValue(distanceImage, center) < 0.0);
+
+    // the corners of the slices through the sphere's center are outside
+    const mitk::BaseGeometry *geometry = distanceImage->GetGeometry();
+    mitk::Point3D corner;
+    corner[0] = geometry->GetOrigin()[0] + 2 * filter->GetDistanceImageSpacing();
+    corner[1] = geometry->GetOrigin()[1] + 2 * filter->GetDistanceImageSpacing();
+    corner[2] = SPHERE_CENTER;
+    CPPUNIT_ASSERT_MESSAGE("Corner is not outside", GetDistanceValue(distanceImage, corner) > 0.0);
+
+    // the zero crossing along the x axis lies close to the sphere
+    mitk::Point3D p = center;
+    double previousValue = GetDistanceValue(distanceImage, p);
+    while (previousValue < 0.0 && p[0] < SPHERE_CENTER + 2 * SPHERE_RADIUS)
+    {
+      p[0] += filter->GetDistanceImageSpacing();
+      previousValue = GetDistanceValue(distanceImage, p);
+    }
+    CPPUNIT_ASSERT_MESSAGE("Surface is not at the sphere",
+                           std::abs(p[0] - SPHERE_CENTER - SPHERE_RADIUS) <= 2 * filter->GetDistanceImageSpacing());
+  }
+
+  void TestReuseDistanceValuesForChangedContour()
+  {
+    auto filter = CreateSphereFilter(16, 60);
+    filter->SetRBFType(mitk::CreateDistanceImageFromSurfaceFilter::RBF_COMPACTLY_SUPPORTED);
+    filter->ReuseDistanceValuesOn();
+    filter->Update();
+    CPPUNIT_ASSERT_MESSAGE("Distance values are reused without a previous update",
+                           filter->GetNumberOfReusedDistanceValues() == 0);
+    const unsigned long initiallyEvaluated = filter->GetNumberOfEvaluatedDistanceValues();
+
+    // a contour in the middle is redrawn with more points, the bounds and the support radius stay the same
+    auto reference = CreateSphereFilter(16, 60);
+    reference->SetRBFType(mitk::CreateDistanceImageFromSurfaceFilter::RBF_COMPACTLY_SUPPORTED);
+    const unsigned int changedContour = 7;
+    mitk::Surface::Pointer redrawnContour = CreateSphereContour(
+      SPHERE_CENTER + SPHERE_RADIUS * (-0.9 + 1.8 * changedContour / 15), 72);
+    filter->SetInput(changedContour, redrawnContour);
+    reference->SetInput(changedContour, redrawnContour);
+
+    filter->Update();
+    reference->Update();
+
+    CPPUNIT_ASSERT_MESSAGE("No distance values are reused", filter->GetNumberOfReusedDistanceValues() > 0);
+    CPPUNIT_ASSERT_MESSAGE("All distance values are evaluated again",
+                           filter->GetNumberOfEvaluatedDistanceValues() < initiallyEvaluated);
+    CPPUNIT_ASSERT_MESSAGE("Reused distance values differ",
+                           mitk::Equal(*(reference->GetOutput()), *(filter->GetOutput()), 0.0001, true));
+  }
+
+  /**
+    The compactly supported RBF approximates the global RBF: the surfaces of both distance images cross the
+    axes through the center of the sphere at nearly the same positions.
+  */
+  void TestCompactlySupportedRBFApproximatesGlobalRBF()
+  {
+    auto globalFilter = CreateSphereFilter(8, 60);
+    globalFilter->SetRBFType(mitk::CreateDistanceImageFromSurfaceFilter::RBF_GLOBAL);
+    globalFilter->Update();
+
+    auto compactFilter = CreateSphereFilter(8, 60);
+    compactFilter->SetRBFType(mitk::CreateDistanceImageFromSurfaceFilter::RBF_COMPACTLY_SUPPORTED);
+    compactFilter->Update();
+
+    const double spacing = std::max(globalFilter->GetDistanceImageSpacing(), compactFilter->GetDistanceImageSpacing());
+    mitk::Point3D center;
+    center.Fill(SPHERE_CENTER);
+
+    for (unsigned int axis = 0; axis < 3; ++axis)
+    {
+      for (const double sign : {-1.0, 1.0})
+      {
+        mitk::Vector3D direction;
+        direction.Fill(0.0);
+        direction[axis] = sign;
+
+        const double globalCrossing = FindZeroCrossing(globalFilter, center, direction);
+        const double compactCrossing = FindZeroCrossing(compactFilter, center, direction);
+        CPPUNIT_ASSERT_MESSAGE("Surfaces of the global and the compactly supported RBF differ",
+                               std::abs(globalCrossing - compactCrossing) <= 2 * spacing);
+      }
+    }
+  }
 };
 
 MITK_TEST_SUITE_REGISTRATION(mitkCreateDistanceImageFromSurfaceFilter)
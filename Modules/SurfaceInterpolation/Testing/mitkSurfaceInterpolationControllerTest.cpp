@@ -20,6 +20,11 @@ found in the LICENSE file.
 #include "mitkImagePixelWriteAccessor.h"
 #include "mitkImageTimeSelector.h"
 
+#include <itkCommand.h>
+
+#include <atomic>
+#include <cmath>
+
 class mitkSurfaceInterpolationControllerTestSuite : public mitk::TestFixture
 {
   CPPUNIT_TEST_SUITE(mitkSurfaceInterpolationControllerTestSuite);
@@ -41,10 +46,39 @@ class mitkSurfaceInterpolationControllerTestSuite : public mitk::TestFixture
 
   MITK_TEST(TestAddNewContour);
   MITK_TEST(TestRemoveContour);
+
+  MITK_TEST(TestIncrementalInterpolation);
+  MITK_TEST(TestInterpolateAsync);
   CPPUNIT_TEST_SUITE_END();
 
 private:
   mitk::SurfaceInterpolationController::Pointer m_Controller;
+  std::atomic<unsigned int> m_NumberOfFinishedInterpolations;
+
+  // An axial contour of a sphere with radius 30 around (50, 50, 50)
+  mitk::Surface::Pointer createSphereContour(double z, double radiusFactor = 1.0)
+  {
+    vtkSmartPointer<vtkRegularPolygonSource> polygonSource = vtkSmartPointer<vtkRegularPolygonSource>::New();
+    polygonSource->SetNumberOfSides(40);
+    polygonSource->SetCenter(50.0, 50.0, z);
+    polygonSource->SetRadius(radiusFactor * std::sqrt(900.0 - (z - 50.0) * (z - 50.0)));
+    polygonSource->SetNormal(0.0, 0.0, 1.0);
+    polygonSource->Update();
+    mitk::Surface::Pointer contour = mitk::Surface::New();
+    contour->SetVtkPolyData(polygonSource->GetOutput());
+    return contour;
+  }
+
+  mitk::SurfaceInterpolationController::Pointer createController(mitk::Image *segmentation)
+  {
+    mitk::SurfaceInterpolationController::Pointer controller = mitk::SurfaceInterpolationController::New();
+    controller->SetCurrentInterpolationSession(segmentation);
+    controller->SetMinSpacing(1.0);
+    controller->SetMaxSpacing(1.0);
+    return controller;
+  }
+
+  void OnInterpolationFinished(const itk::EventObject &) { ++m_NumberOfFinishedInterpolations; }
 
 public:
   mitk::Image::Pointer createImage(unsigned int *dimensions)
@@ -512,6 +546,91 @@ public:
         mitk::Equal(*(surf_1->GetVtkPolyData()), *(remainingContour->GetVtkPolyData()), 0.000001, true) && success);
   }
 
+  void TestIncrementalInterpolation()
+  {
+    unsigned int dimensions[] = {100, 100, 100};
+    mitk::Image::Pointer segmentation = createImage(dimensions);
+
+    // Interpolate after each contour like the segmentation view does while the user draws
+    auto incremental = createController(segmentation);
+    for (const double z : {30.0, 40.0, 60.0, 70.0})
+    {
+      incremental->AddNewContour(createSphereContour(z));
+      incremental->Interpolate();
+    }
+    mitk::Surface::Pointer middleContour = createSphereContour(50.0);
+    incremental->AddNewContour(middleContour);
+    incremental->Interpolate();
+
+    // Redraw a contour, it replaces the previous one in the same plane
+    mitk::Surface::Pointer redrawnContour = createSphereContour(40.0, 0.9);
+    incremental->AddNewContour(redrawnContour);
+    incremental->Interpolate();
+    CPPUNIT_ASSERT_MESSAGE("Wrong number of contours!", incremental->GetNumberOfContours() == 5);
+
+    auto reference = createController(segmentation);
+    reference->AddNewContour(createSphereContour(30.0));
+    reference->AddNewContour(redrawnContour);
+    reference->AddNewContour(createSphereContour(60.0));
+    reference->AddNewContour(createSphereContour(70.0));
+    reference->AddNewContour(middleContour);
+    reference->Interpolate();
+
+    mitk::Surface::Pointer incrementalResult = incremental->GetInterpolationResult();
+    mitk::Surface::Pointer referenceResult = reference->GetInterpolationResult();
+    CPPUNIT_ASSERT_MESSAGE("No interpolation result", incrementalResult.IsNotNull() && referenceResult.IsNotNull());
+    CPPUNIT_ASSERT_MESSAGE("Incremental interpolation differs",
+                           mitk::Equal(*(referenceResult->GetVtkPolyData()),
+                                       *(incrementalResult->GetVtkPolyData()),
+                                       0.000001,
+                                       true));
+  }
+
+  void TestInterpolateAsync()
+  {
+    unsigned int dimensions[] = {100, 100, 100};
+    mitk::Image::Pointer segmentation = createImage(dimensions);
+
+    auto controller = createController(segmentation);
+    m_NumberOfFinishedInterpolations = 0;
+    itk::ReceptorMemberCommand<mitkSurfaceInterpolationControllerTestSuite>::Pointer command =
+      itk::ReceptorMemberCommand<mitkSurfaceInterpolationControllerTestSuite>::New();
+    command->SetCallbackFunction(this, &mitkSurfaceInterpolationControllerTestSuite::OnInterpolationFinished);
+    controller->AddObserver(mitk::SurfaceInterpolationFinishedEvent(), command);
+
+    controller->AddNewContour(createSphereContour(30.0));
+    controller->AddNewContour(createSphereContour(50.0));
+    controller->AddNewContour(createSphereContour(70.0));
+    controller->InterpolateAsync();
+
+    // Requests while the interpolation is running are merged
+    mitk::Surface::Pointer lastContour = createSphereContour(40.0);
+    controller->AddNewContour(lastContour);
+    controller->InterpolateAsync();
+    controller->InterpolateAsync();
+
+    controller->WaitForInterpolation();
+    CPPUNIT_ASSERT_MESSAGE("Interpolation is still running", !controller->IsInterpolating());
+    CPPUNIT_ASSERT_MESSAGE("Wrong number of finished interpolations",
+                           m_NumberOfFinishedInterpolations >= 1 && m_NumberOfFinishedInterpolations <= 3);
+
+    // The last interpolation includes all contours
+    auto reference = createController(segmentation);
+    reference->AddNewContour(createSphereContour(30.0));
+    reference->AddNewContour(createSphereContour(50.0));
+    reference->AddNewContour(createSphereContour(70.0));
+    reference->AddNewContour(lastContour);
+    reference->Interpolate();
+
+    mitk::Surface::Pointer result = controller->GetInterpolationResult();
+    CPPUNIT_ASSERT_MESSAGE("No interpolation result", result.IsNotNull());
+    CPPUNIT_ASSERT_MESSAGE("Interpolation does not contain the last contour",
+                           mitk::Equal(*(reference->GetInterpolationResult()->GetVtkPolyData()),
+                                       *(result->GetVtkPolyData()),
+                                       0.000001,
+                                       true));
+  }
+
   bool AssertImagesEqual4D(mitk::Image *img1, mitk::Image *img2)
   {
     mitk::ImageTimeSelector::Pointer selector1 = mitk::ImageTimeSelector::New();
@@ -22,7 +22,51 @@ found in the LICENSE file.
 #include "itkImageRegionIteratorWithIndex.h"
 #include "itkNeighborhoodIterator.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <queue>
+#include <set>
+
+const unsigned int mitk::CreateDistanceImageFromSurfaceFilter::MAXIMUM_NUMBER_OF_GLOBAL_RBF_CENTERS;
+
+namespace
+{
+  // edge length of the bricks in which distance values are invalidated
+  const long DISTANCE_VALUE_BRICK_SIZE = 8;
+
+  // maximum error (relative to the spacing) of a reused distance value
+  const double DISTANCE_VALUE_TOLERANCE = 1e-5;
+
+  std::array<double, 3> ToKey(const mitk::CreateDistanceImageFromSurfaceFilter::PointType &p)
+  {
+    return {{p[0], p[1], p[2]}};
+  }
+
+  // Wendland's C2 function for q = r / R
+  inline double WendlandC2(double q)
+  {
+    if (q >= 1.0)
+      return 0.0;
+
+    const double t = 1.0 - q;
+    return t * t * t * t * (4.0 * q + 1.0);
+  }
+
+  // calls visit(index) for all centers in the grid cells around cell
+  template <typename Visitor>
+  void VisitCentersNear(const long cell[3],
+                        const long gridSize[3],
+                        const std::vector<std::vector<unsigned int>> &gridCells,
+                        Visitor visit)
+  {
+    for (long z = std::max(0L, cell[2] - 1); z <= std::min(gridSize[2] - 1, cell[2] + 1); ++z)
+      for (long y = std::max(0L, cell[1] - 1); y <= std::min(gridSize[1] - 1, cell[1] + 1); ++y)
+        for (long x = std::max(0L, cell[0] - 1); x <= std::min(gridSize[0] - 1, cell[0] + 1); ++x)
+          for (const unsigned int index : gridCells[(z * gridSize[1] + y) * gridSize[0] + x])
+            visit(index);
+  }
+}
 
 void mitk::CreateDistanceImageFromSurfaceFilter::CreateEmptyDistanceImage()
 {
@@ -105,8 +149,23 @@ void mitk::CreateDistanceImageFromSurfaceFilter::CreateEmptyDistanceImage()
 }
 
 mitk::CreateDistanceImageFromSurfaceFilter::CreateDistanceImageFromSurfaceFilter()
-  : m_DistanceImageSpacing(0.0), m_DistanceImageDefaultBufferValue(0.0)
+  : m_DistanceImageSpacing(0.0),
+    m_DistanceImageDefaultBufferValue(0.0),
+    m_RBFType(RBF_GLOBAL),
+    m_UseCompactSupport(false),
+    m_SupportRadius(0.0),
+    m_CurrentSupportRadius(0.0),
+    m_GridCellSize(0.0),
+    m_ReuseDistanceValues(false),
+    m_DistanceValuesSpacing(0.0),
+    m_DistanceValuesSupportRadius(0.0),
+    m_NumberOfEvaluatedDistanceValues(0),
+    m_NumberOfReusedDistanceValues(0)
 {
+  std::fill(m_GridSize, m_GridSize + 3, 0);
+  m_DistanceValuesSize.Fill(0);
+  m_DistanceValuesOrigin.Fill(0.0);
+
   m_DistanceImageVolume = 50000;
   this->m_UseProgressBar = false;
   this->m_ProgressStepSize = 5;
@@ -124,17 +183,24 @@ void mitk::CreateDistanceImageFromSurfaceFilter::GenerateData()
   this->PreprocessContourPoints();
   this->CreateEmptyDistanceImage();
 
+  // each contour point results in three centers
+  m_UseCompactSupport =
+    m_RBFType == RBF_COMPACTLY_SUPPORTED ||
+    (m_RBFType == RBF_AUTOMATIC && 3 * m_Centers.size() > MAXIMUM_NUMBER_OF_GLOBAL_RBF_CENTERS);
+
   // First of all we have to build the equation-system from the existing contour-edge-points
   this->CreateSolutionMatrixAndFunctionValues();
 
   if (this->m_UseProgressBar)
     mitk::ProgressBar::GetInstance()->Progress(1);
 
-  m_Weights = m_SolutionMatrix.partialPivLu().solve(m_FunctionValues);
+  this->SolveEquationSystem();
 
   if (this->m_UseProgressBar)
     mitk::ProgressBar::GetInstance()->Progress(2);
 
+  this->PrepareDistanceValueReuse();
+
   // The last step is to create the distance map with the interpolated distance function
   this->FillDistanceImage();
 
@@ -143,6 +209,44 @@ void mitk::CreateDistanceImageFromSurfaceFilter::GenerateData()
 
   m_Centers.clear();
   m_Normals.clear();
+  m_FirstCenterOfInput.clear();
+  m_GridCells.clear();
+}
+
+void mitk::CreateDistanceImageFromSurfaceFilter::SolveEquationSystem()
+{
+  if (!m_UseCompactSupport)
+  {
+    m_Weights = m_SolutionMatrix.partialPivLu().solve(m_FunctionValues);
+    return;
+  }
+
+  // the matrix of a compactly supported RBF is symmetric positive definite
+  Eigen::ConjugateGradient<Eigen::SparseMatrix<double>, Eigen::Lower | Eigen::Upper> solver;
+  solver.compute(m_SparseSolutionMatrix);
+
+  if (m_ReuseDistanceValues && !m_PreviousWeights.empty())
+  {
+    // a changed contour barely affects the weights of distant centers
+    Eigen::VectorXd guess = Eigen::VectorXd::Zero(m_Centers.size());
+    for (unsigned int i = 0; i < m_Centers.size(); ++i)
+    {
+      const auto previous = m_PreviousWeights.find(ToKey(m_Centers[i]));
+      if (previous != m_PreviousWeights.end())
+        guess[i] = previous->second;
+    }
+    m_Weights = solver.solveWithGuess(m_FunctionValues, guess);
+  }
+  else
+  {
+    m_Weights = solver.solve(m_FunctionValues);
+  }
+
+  if (solver.info() != Eigen::Success)
+  {
+    MITK_WARN << "mitk::CreateDistanceImageFromSurfaceFilter: RBF weights did not converge after "
+              << solver.iterations() << " iterations (error " << solver.error() << ")";
+  }
 }
 
 void mitk::CreateDistanceImageFromSurfaceFilter::PreprocessContourPoints()
@@ -167,9 +271,12 @@ void mitk::CreateDistanceImageFromSurfaceFilter::PreprocessContourPoints()
   double p[3];
   PointType currentPoint;
   PointType normal;
+  std::set<std::array<double, 3>> uniquePoints;
 
   for (unsigned int i = 0; i < numberOfInputs; i++)
   {
+    m_FirstCenterOfInput.push_back(m_Centers.size());
+
     auto currentSurface = this->GetInput(i);
     polyData = currentSurface->GetVtkPolyData();
 
@@ -199,9 +306,8 @@ void mitk::CreateDistanceImageFromSurfaceFilter::PreprocessContourPoints()
 
         currentPoint.copy_in(p);
 
-        int count = std::count(m_Centers.begin(), m_Centers.end(), currentPoint);
-
-        if (count == 0)
+        const std::array<double, 3> key = {{p[0], p[1], p[2]}};
+        if (uniquePoints.insert(key).second)
         {
           double currentNormal[3];
           currentCellNormals->GetTuple(cell[j], currentNormal);
@@ -264,6 +370,14 @@ void mitk::CreateDistanceImageFromSurfaceFilter::CreateSolutionMatrixAndFunction
   // Now we have created all centers and all function values. Next step is to create the solution matrix
   numberOfCenters = m_Centers.size();
 
+  if (m_UseCompactSupport)
+  {
+    m_SolutionMatrix.resize(0, 0);
+    this->CreateSparseSolutionMatrix();
+    return;
+  }
+  m_SparseSolutionMatrix.resize(0, 0);
+
   m_SolutionMatrix.resize(numberOfCenters, numberOfCenters);
 
   m_Weights.resize(numberOfCenters);
@@ -351,7 +465,7 @@ void mitk::CreateDistanceImageFromSurfaceFilter::FillDistanceImage()
         currentPoint[2] = currentPointAsPoint[2];
 
         // and check the distance
-        distance = this->CalculateDistanceValue(currentPoint);
+        distance = this->GetDistanceValue(currentIndex, currentPoint);
         if (std::fabs(distance) <= m_DistanceImageSpacing * 2)
         {
           nIt.SetPixel(*relativeNb, distance);
@@ -419,8 +533,255 @@ void mitk::CreateDistanceImageFromSurfaceFilter::FillDistanceImage()
   CastToMitkImage(m_DistanceImageITK, resultImage);
 }
 
+void mitk::CreateDistanceImageFromSurfaceFilter::PrepareDistanceValueReuse()
+{
+  m_NumberOfEvaluatedDistanceValues = 0;
+  m_NumberOfReusedDistanceValues = 0;
+
+  if (!m_ReuseDistanceValues || !m_UseCompactSupport)
+  {
+    m_PreviousWeights.clear();
+    m_DistanceValues.clear();
+    m_BrickErrors.clear();
+    return;
+  }
+
+  std::map<std::array<double, 3>, double> weights;
+  for (unsigned int i = 0; i < m_Centers.size(); ++i)
+  {
+    weights[ToKey(m_Centers[i])] = m_Weights[i];
+  }
+
+  const DistanceImageType::SizeType size = m_DistanceImageITK->GetLargestPossibleRegion().GetSize();
+  const std::size_t numberOfVoxels = size[0] * size[1] * size[2];
+  long numberOfBricks[3];
+  for (unsigned int dim = 0; dim < 3; ++dim)
+    numberOfBricks[dim] = (size[dim] + DISTANCE_VALUE_BRICK_SIZE - 1) / DISTANCE_VALUE_BRICK_SIZE;
+
+  const bool sameGeometry = m_DistanceValues.size() == numberOfVoxels && m_DistanceValuesSize == size &&
+                            m_DistanceValuesOrigin == m_DistanceImageITK->GetOrigin() &&
+                            m_DistanceValuesSpacing == m_DistanceImageSpacing &&
+                            m_DistanceValuesSupportRadius == m_CurrentSupportRadius;
+
+  if (!sameGeometry)
+  {
+    m_DistanceValues.assign(numberOfVoxels, std::numeric_limits<double>::quiet_NaN());
+    m_BrickErrors.assign(numberOfBricks[0] * numberOfBricks[1] * numberOfBricks[2], 0.0);
+    m_DistanceValuesSize = size;
+    m_DistanceValuesOrigin = m_DistanceImageITK->GetOrigin();
+    m_DistanceValuesSpacing = m_DistanceImageSpacing;
+    m_DistanceValuesSupportRadius = m_CurrentSupportRadius;
+    m_PreviousWeights.swap(weights);
+    return;
+  }
+
+  // A center changes the distance values within the support radius by at most the change of its weight.
+  // The spacing is isotropic, so the support radius is the same in index coordinates along every axis.
+  const double radius = m_CurrentSupportRadius / m_DistanceImageSpacing;
+  DistanceImageType::PointType point;
+  itk::ContinuousIndex<double, 3> index;
+
+  auto addError = [&](const std::array<double, 3> &center, double error) {
+    point[0] = center[0];
+    point[1] = center[1];
+    point[2] = center[2];
+    m_DistanceImageITK->TransformPhysicalPointToContinuousIndex(point, index);
+
+    long first[3];
+    long last[3];
+    for (unsigned int dim = 0; dim < 3; ++dim)
+    {
+      first[dim] = std::max(0L, static_cast<long>(std::floor((index[dim] - radius) / DISTANCE_VALUE_BRICK_SIZE)));
+      last[dim] = std::min(numberOfBricks[dim] - 1,
+                           static_cast<long>(std::floor((index[dim] + radius) / DISTANCE_VALUE_BRICK_SIZE)));
+    }
+
+    for (long z = first[2]; z <= last[2]; ++z)
+      for (long y = first[1]; y <= last[1]; ++y)
+        for (long x = first[0]; x <= last[0]; ++x)
+          m_BrickErrors[(z * numberOfBricks[1] + y) * numberOfBricks[0] + x] += error;
+  };
+
+  // added and removed centers also change which voxels belong to the narrow band
+  const double infinite = std::numeric_limits<double>::infinity();
+  for (const auto &weight : weights)
+  {
+    const auto previous = m_PreviousWeights.find(weight.first);
+    if (previous == m_PreviousWeights.end())
+      addError(weight.first, infinite);
+    else if (previous->second != weight.second)
+      addError(weight.first, std::abs(previous->second - weight.second));
+  }
+  for (const auto &previous : m_PreviousWeights)
+  {
+    if (weights.find(previous.first) == weights.end())
+      addError(previous.first, infinite);
+  }
+  m_PreviousWeights.swap(weights);
+
+  // The errors accumulate over the updates until the brick is evaluated again
+  const double tolerance = DISTANCE_VALUE_TOLERANCE * m_DistanceImageSpacing;
+  for (long z = 0; z < static_cast<long>(size[2]); ++z)
+    for (long y = 0; y < static_cast<long>(size[1]); ++y)
+      for (long x = 0; x < static_cast<long>(size[0]); ++x)
+      {
+        const long brick = ((z / DISTANCE_VALUE_BRICK_SIZE) * numberOfBricks[1] + y / DISTANCE_VALUE_BRICK_SIZE) *
+                             numberOfBricks[0] +
+                           x / DISTANCE_VALUE_BRICK_SIZE;
+        if (m_BrickErrors[brick] > tolerance)
+          m_DistanceValues[(z * size[1] + y) * size[0] + x] = std::numeric_limits<double>::quiet_NaN();
+      }
+
+  for (auto &error : m_BrickErrors)
+  {
+    if (error > tolerance)
+      error = 0.0;
+  }
+}
+
+double mitk::CreateDistanceImageFromSurfaceFilter::GetDistanceValue(const IndexType &index, const PointType &p)
+{
+  if (m_DistanceValues.empty())
+  {
+    ++m_NumberOfEvaluatedDistanceValues;
+    return this->CalculateDistanceValue(p);
+  }
+
+  double &value = m_DistanceValues[m_DistanceImageITK->ComputeOffset(index)];
+  if (std::isnan(value))
+  {
+    value = this->CalculateDistanceValue(p);
+    ++m_NumberOfEvaluatedDistanceValues;
+  }
+  else
+  {
+    ++m_NumberOfReusedDistanceValues;
+  }
+  return value;
+}
+
+void mitk::CreateDistanceImageFromSurfaceFilter::CreateSparseSolutionMatrix()
+{
+  m_CurrentSupportRadius = m_SupportRadius > 0.0 ? m_SupportRadius : this->DetermineSupportRadius();
+  this->BuildCenterGrid();
+
+  const unsigned int numberOfCenters = m_Centers.size();
+  std::vector<Eigen::Triplet<double>> entries;
+  long cell[3];
+
+  for (unsigned int i = 0; i < numberOfCenters; ++i)
+  {
+    const PointType &center = m_Centers[i];
+    this->GetGridCell(center, cell);
+    VisitCentersNear(cell, m_GridSize, m_GridCells, [&](unsigned int j) {
+      const double q = (center - m_Centers[j]).two_norm() / m_CurrentSupportRadius;
+      if (q < 1.0)
+        entries.emplace_back(i, j, WendlandC2(q));
+    });
+  }
+
+  m_SparseSolutionMatrix.resize(numberOfCenters, numberOfCenters);
+  m_SparseSolutionMatrix.setFromTriplets(entries.begin(), entries.end());
+}
+
+double mitk::CreateDistanceImageFromSurfaceFilter::DetermineSupportRadius() const
+{
+  // the contour points are the first third of the centers
+  const unsigned int numberOfContourPoints = m_Centers.size() / 3;
+
+  std::vector<PointType> centroids;
+  for (std::size_t input = 0; input < m_FirstCenterOfInput.size(); ++input)
+  {
+    const unsigned int begin = m_FirstCenterOfInput[input];
+    const unsigned int end =
+      input + 1 < m_FirstCenterOfInput.size() ? m_FirstCenterOfInput[input + 1] : numberOfContourPoints;
+    if (end <= begin)
+      continue;
+
+    PointType centroid(0.0);
+    for (unsigned int i = begin; i < end; ++i)
+      centroid += m_Centers[i];
+    centroids.push_back(centroid / static_cast<double>(end - begin));
+  }
+
+  // the support has to bridge the gap from each contour to its nearest neighbor
+  double largestGap = 0.0;
+  for (std::size_t i = 0; i < centroids.size(); ++i)
+  {
+    double nearest = std::numeric_limits<double>::max();
+    for (std::size_t j = 0; j < centroids.size(); ++j)
+    {
+      if (i != j)
+        nearest = std::min(nearest, (centroids[i] - centroids[j]).two_norm());
+    }
+    if (nearest < std::numeric_limits<double>::max())
+      largestGap = std::max(largestGap, nearest);
+  }
+
+  return std::max(4.0 * m_DistanceImageSpacing, 1.5 * largestGap);
+}
+
+void mitk::CreateDistanceImageFromSurfaceFilter::BuildCenterGrid()
+{
+  PointType minPoint = m_Centers.front();
+  PointType maxPoint = minPoint;
+  for (const auto &center : m_Centers)
+  {
+    for (unsigned int dim = 0; dim < 3; ++dim)
+    {
+      minPoint[dim] = std::min(minPoint[dim], center[dim]);
+      maxPoint[dim] = std::max(maxPoint[dim], center[dim]);
+    }
+  }
+
+  // cells must not be smaller than the support radius, but their number is limited for tiny radii
+  const double largestExtent = (maxPoint - minPoint).max_value();
+  m_GridCellSize = std::max(m_CurrentSupportRadius, largestExtent / 128.0);
+  m_GridOrigin = minPoint;
+  for (unsigned int dim = 0; dim < 3; ++dim)
+    m_GridSize[dim] = static_cast<long>((maxPoint[dim] - minPoint[dim]) / m_GridCellSize) + 1;
+
+  m_GridCells.clear();
+  m_GridCells.resize(m_GridSize[0] * m_GridSize[1] * m_GridSize[2]);
+
+  long cell[3];
+  for (unsigned int i = 0; i < m_Centers.size(); ++i)
+  {
+    this->GetGridCell(m_Centers[i], cell);
+    m_GridCells[(cell[2] * m_GridSize[1] + cell[1]) * m_GridSize[0] + cell[0]].push_back(i);
+  }
+}
+
+void mitk::CreateDistanceImageFromSurfaceFilter::GetGridCell(const PointType &p, long cell[3]) const
+{
+  for (unsigned int dim = 0; dim < 3; ++dim)
+    cell[dim] = static_cast<long>(std::floor((p[dim] - m_GridOrigin[dim]) / m_GridCellSize));
+}
+
 double mitk::CreateDistanceImageFromSurfaceFilter::CalculateDistanceValue(PointType p)
 {
+  if (m_UseCompactSupport)
+  {
+    long cell[3];
+    this->GetGridCell(p, cell);
+
+    double distanceValue = 0.0;
+    double support = 0.0;
+    VisitCentersNear(cell, m_GridSize, m_GridCells, [&](unsigned int i) {
+      const double phi = WendlandC2((p - m_Centers[i]).two_norm() / m_CurrentSupportRadius);
+      distanceValue += phi * m_Weights[i];
+      support += phi;
+    });
+
+    // The interpolant fades to zero at the border of the support, which must not be mistaken for
+    // the surface. Points that are not at least as close as half the radius to some center
+    // do not belong to the narrow band.
+    if (support < WendlandC2(0.5))
+      return m_DistanceImageDefaultBufferValue;
+
+    return distanceValue;
+  }
+
   double distanceValue(0);
   PointType p1;
   PointType p2;
@@ -447,6 +808,11 @@ void mitk::CreateDistanceImageFromSurfaceFilter::GenerateOutputInformation()
 void mitk::CreateDistanceImageFromSurfaceFilter::PrintEquationSystem()
 {
   std::stringstream out;
+  if (m_UseCompactSupport)
+  {
+    out << "Sparse matrix with support radius " << m_CurrentSupportRadius << ":" << endl
+        << m_SparseSolutionMatrix << endl;
+  }
   out << "Nummber of rows: " << m_SolutionMatrix.rows() << " ****** Number of columns: " << m_SolutionMatrix.cols()
       << endl;
   out << "[ ";
@@ -522,6 +888,10 @@ void mitk::CreateDistanceImageFromSurfaceFilter::Reset()
 
   mitk::Image::Pointer output = mitk::Image::New();
   this->SetNthOutput(0, output.GetPointer());
+
+  m_PreviousWeights.clear();
+  m_DistanceValues.clear();
+  m_BrickErrors.clear();
 }
 
 void mitk::CreateDistanceImageFromSurfaceFilter::SetUseProgressBar(bool status)
@@ -24,6 +24,10 @@ found in the LICENSE file.
 #include "itkImageBase.h"
 
 #include <Eigen/Dense>
+#include <Eigen/Sparse>
+
+#include <array>
+#include <map>
 
 namespace mitk
 {
@@ -57,6 +61,10 @@ namespace mitk
          adjusted by calling SetDistanceImageVolume(unsigned int volume) which specifies the number ob pixels enclosed
   by the image.
 
+         The radial basis function is chosen via SetRBFType(). The global function Phi(r) = r needs a dense
+         equation system, i.e. memory grows quadratically and time cubically with the number of contour points.
+         The compactly supported function scales to many contour points, see RBFType.
+
   \ingroup Process
 
   $Author: fetzer$
@@ -74,6 +82,26 @@ namespace mitk
 
     typedef std::vector<Surface::Pointer> SurfaceList;
 
+    /**
+      \brief Radial basis functions for the interpolation.
+
+      - RBF_GLOBAL: Phi(r) = r. A dense equation system is solved and every voxel evaluates all centers.
+      - RBF_COMPACTLY_SUPPORTED: Wendland's function Phi(r) = (1 - r/R)^4 (4r/R + 1) for r < R and 0 beyond.
+        The equation system is sparse and positive definite and solved iteratively. Every voxel evaluates
+        only the centers within R, which are looked up in a uniform grid. Voxels farther than R from all
+        centers do not belong to the narrow band around the surface.
+      - RBF_AUTOMATIC: RBF_GLOBAL up to MAXIMUM_NUMBER_OF_GLOBAL_RBF_CENTERS centers, RBF_COMPACTLY_SUPPORTED beyond.
+    */
+    enum RBFType
+    {
+      RBF_GLOBAL,
+      RBF_COMPACTLY_SUPPORTED,
+      RBF_AUTOMATIC
+    };
+
+    /** \brief Number of centers (three per contour point) up to which RBF_AUTOMATIC uses RBF_GLOBAL. */
+    static const unsigned int MAXIMUM_NUMBER_OF_GLOBAL_RBF_CENTERS = 3000;
+
     mitkClassMacro(CreateDistanceImageFromSurfaceFilter, ImageSource);
     itkFactorylessNewMacro(Self);
     itkCloneMacro(Self);
@@ -99,9 +127,45 @@ namespace mitk
     */
     itkSetMacro(DistanceImageVolume, unsigned int);
 
+    /**
+    \brief Set the radial basis function, see RBFType. Default is RBF_GLOBAL.
+    */
+    itkSetEnumMacro(RBFType, RBFType);
+    itkGetEnumMacro(RBFType, RBFType);
+
+    /**
+    \brief Set the support radius R (in mm) of RBF_COMPACTLY_SUPPORTED.
+           If it is zero (default), R is 1.5 times the largest distance between the centroids of
+           neighboring contours, but at least four times the spacing of the distance image.
+           The radius has to bridge the gaps between the contours, otherwise the result has holes.
+    */
+    itkSetMacro(SupportRadius, double);
+    itkGetConstMacro(SupportRadius, double);
+
+    /**
+    \brief Reuse the distance values of the previous update where they cannot have changed (default false).
+
+           Only takes effect for RBF_COMPACTLY_SUPPORTED: a voxel only depends on the centers within the support
+           radius. Centers are identified by their position. The distance image is divided into bricks of
+           8x8x8 voxels. A brick is evaluated again if new or removed centers lie within the support radius
+           or if the weights of the centers within the support radius changed by more than 1e-5 times the spacing
+           in total. The weights of the previous update are the initial guess of the solver.
+           Everything is evaluated again if the geometry of the distance image or the support radius changes.
+           This is meant for adding or changing single contours of a large set, see Reset().
+    */
+    itkSetMacro(ReuseDistanceValues, bool);
+    itkGetConstMacro(ReuseDistanceValues, bool);
+    itkBooleanMacro(ReuseDistanceValues);
+
+    /** \brief Number of distance values that were calculated during the last update. */
+    itkGetConstMacro(NumberOfEvaluatedDistanceValues, unsigned long);
+
+    /** \brief Number of distance values that were taken from the previous update, see SetReuseDistanceValues(). */
+    itkGetConstMacro(NumberOfReusedDistanceValues, unsigned long);
+
     void PrintEquationSystem();
 
-    // Resets the filter, i.e. removes all inputs and outputs
+    // Resets the filter, i.e. removes all inputs and outputs and discards the reusable distance values
     void Reset();
 
     /**
@@ -128,8 +192,23 @@ namespace mitk
 
   private:
     void CreateSolutionMatrixAndFunctionValues();
+    void CreateSparseSolutionMatrix();
+    void SolveEquationSystem();
     double CalculateDistanceValue(PointType p);
 
+    /** Returns the reusable distance value of the voxel or calculates it. */
+    double GetDistanceValue(const IndexType &index, const PointType &p);
+
+    /** Invalidates the distance values of the previous update around the changed centers. */
+    void PrepareDistanceValueReuse();
+
+    /** Determines the support radius of RBF_COMPACTLY_SUPPORTED if none has been set. */
+    double DetermineSupportRadius() const;
+
+    /** Sorts the centers into cubic grid cells with the support radius as edge length. */
+    void BuildCenterGrid();
+    void GetGridCell(const PointType &p, long cell[3]) const;
+
     void FillDistanceImage();
 
     /**
@@ -157,8 +236,11 @@ namespace mitk
     // Datastructures for the interpolation
     CenterList m_Centers;
     NormalList m_Normals;
+    /** Index of the first contour point of each input, used to derive the support radius */
+    std::vector<unsigned int> m_FirstCenterOfInput;
 
     Eigen::MatrixXd m_SolutionMatrix;
+    Eigen::SparseMatrix<double> m_SparseSolutionMatrix;
     Eigen::VectorXd m_FunctionValues;
     Eigen::VectorXd m_Weights;
 
@@ -169,6 +251,30 @@ namespace mitk
     double m_DistanceImageDefaultBufferValue;
     unsigned int m_DistanceImageVolume;
 
+    RBFType m_RBFType;
+    bool m_UseCompactSupport;
+    double m_SupportRadius;
+    double m_CurrentSupportRadius;
+
+    PointType m_GridOrigin;
+    double m_GridCellSize;
+    long m_GridSize[3];
+    std::vector<std::vector<unsigned int>> m_GridCells;
+
+    bool m_ReuseDistanceValues;
+    /** Weights of the previous update, identified by the position of their center */
+    std::map<std::array<double, 3>, double> m_PreviousWeights;
+    /** Distance values of all voxels, NaN if not yet evaluated */
+    std::vector<double> m_DistanceValues;
+    /** Upper bound of the error of the reused distance values per brick */
+    std::vector<double> m_BrickErrors;
+    DistanceImageType::SizeType m_DistanceValuesSize;
+    DistanceImageType::PointType m_DistanceValuesOrigin;
+    double m_DistanceValuesSpacing;
+    double m_DistanceValuesSupportRadius;
+    unsigned long m_NumberOfEvaluatedDistanceValues;
+    unsigned long m_NumberOfReusedDistanceValues;
+
     bool m_UseProgressBar;
     unsigned int m_ProgressStepSize;
   };
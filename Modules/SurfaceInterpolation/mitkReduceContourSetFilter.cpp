@@ -23,6 +23,7 @@ mitk::ReduceContourSetFilter::ReduceContourSetFilter()
   this->m_UseProgressBar = false;
   this->m_ProgressStepSize = 1;
   m_NumberOfPointsAfterReduction = 0;
+  m_ReduceFirstInputOnly = false;
 
   mitk::Surface::Pointer output = mitk::Surface::New();
   this->SetNthOutput(0, output.GetPointer());
@@ -48,6 +49,10 @@ void mitk::ReduceContourSetFilter::GenerateData()
   unsigned int numberOfInputs = this->GetNumberOfIndexedInputs();
   unsigned int numberOfOutputs(0);
 
+  // the remaining inputs are still considered by CheckForIntersection
+  if (m_ReduceFirstInputOnly && numberOfInputs > 1)
+    numberOfInputs = 1;
+
   vtkSmartPointer<vtkPolyData> newPolyData;
   vtkSmartPointer<vtkCellArray> newPolygons;
   vtkSmartPointer<vtkPoints> newPoints;
@@ -73,6 +73,14 @@ namespace mitk
     itkSetMacro(StepSize, unsigned int);
     itkSetMacro(Tolerance, double);
 
+    /**
+      \brief If set, only the first input is reduced. The other inputs are just used to detect whether
+             the first input is an intersection contour. That way the reduction of a single contour can be
+             updated without reducing the others again.
+    */
+    itkSetMacro(ReduceFirstInputOnly, bool);
+    itkGetConstMacro(ReduceFirstInputOnly, bool);
+
     itkGetMacro(NumberOfPointsAfterReduction, unsigned int);
 
     // Resets the filter, i.e. removes all inputs and outputs
@@ -128,6 +136,8 @@ namespace mitk
 
     unsigned int m_NumberOfPointsAfterReduction;
 
+    bool m_ReduceFirstInputOnly;
+
   }; // class
 
 } // namespace
@@ -13,12 +13,16 @@ found in the LICENSE file.
 #include "mitkSurfaceInterpolationController.h"
 #include "mitkImageAccessByItk.h"
 #include "mitkImageCast.h"
+#include "mitkImageReadAccessor.h"
+#include "mitkCallbackFromGUIThread.h"
 #include "mitkMemoryUtilities.h"
 
 #include "mitkImageToSurfaceFilter.h"
 //#include "vtkXMLPolyDataWriter.h"
 #include "vtkPolyDataWriter.h"
 
+#include <algorithm>
+
 // Check whether the given contours are coplanar
 bool ContoursCoplanar(mitk::SurfaceInterpolationController::ContourPositionInformation leftHandSide,
                       mitk::SurfaceInterpolationController::ContourPositionInformation rightHandSide)
@@ -59,6 +63,14 @@ bool ContoursCoplanar(mitk::SurfaceInterpolationController::ContourPositionInfor
     return false;
 }
 
+// Check whether the planes of the given contours are parallel. Only contours that are not parallel can intersect.
+bool ContoursParallel(const mitk::Vector3D &leftHandSide, const mitk::Vector3D &rightHandSide)
+{
+  double dot = leftHandSide[0] * rightHandSide[0] + leftHandSide[1] * rightHandSide[1] +
+               leftHandSide[2] * rightHandSide[2];
+  return mitk::Equal(fabs(leftHandSide.GetNorm() * rightHandSide.GetNorm()), fabs(dot), 0.001);
+}
+
 mitk::SurfaceInterpolationController::ContourPositionInformation CreateContourPositionInformation(
   mitk::Surface::Pointer contour)
 {
@@ -73,8 +85,48 @@ mitk::SurfaceInterpolationController::ContourPositionInformation CreateContourPo
   return contourInfo;
 }
 
+namespace
+{
+  /** Invokes the finished events of a controller from the GUI thread, unless the controller has been destroyed */
+  class InterpolationFinishedCommand : public itk::Command
+  {
+  public:
+    typedef InterpolationFinishedCommand Self;
+    typedef itk::SmartPointer<Self> Pointer;
+    itkNewMacro(Self);
+
+    void SetTarget(const std::shared_ptr<std::atomic<itk::Object *>> &target) { m_Target = target; }
+
+    void Execute(itk::Object *, const itk::EventObject &) override { this->InvokeEvents(); }
+
+    void Execute(const itk::Object *, const itk::EventObject &) override { this->InvokeEvents(); }
+
+  private:
+    void InvokeEvents()
+    {
+      auto controller = static_cast<mitk::SurfaceInterpolationController *>(m_Target->load());
+      if (nullptr != controller)
+        controller->InvokeInterpolationFinishedEvents();
+    }
+
+    std::shared_ptr<std::atomic<itk::Object *>> m_Target;
+  };
+}
+
 mitk::SurfaceInterpolationController::SurfaceInterpolationController()
-  : m_SelectedSegmentation(nullptr), m_CurrentTimeStep(0)
+  : m_SelectedSegmentation(nullptr),
+    m_CurrentTimeStep(0),
+    m_MinSpacing(-1.0),
+    m_MaxSpacing(-1.0),
+    m_DistanceImageVolume(50000),
+    m_ReducedContoursSegmentation(nullptr),
+    m_ReducedContoursTimeStep(0),
+    m_ReducedContoursMinSpacing(-1.0),
+    m_ReducedContoursMaxSpacing(-1.0),
+    m_NumberOfPointsAfterReduction(0),
+    m_InterpolationThreadRunning(false),
+    m_NumberOfFinishedInterpolations(0),
+    m_GUIThreadCallbackTarget(std::make_shared<std::atomic<itk::Object *>>(this))
 {
   m_DistanceImageSpacing = 0.0;
   m_ReduceFilter = ReduceContourSetFilter::New();
@@ -84,10 +136,14 @@ mitk::SurfaceInterpolationController::SurfaceInterpolationController()
 
   m_ReduceFilter->SetUseProgressBar(false);
   //  m_ReduceFilter->SetProgressStepSize(1);
-  m_NormalsFilter->SetUseProgressBar(true);
-  m_NormalsFilter->SetProgressStepSize(1);
+  // the contours are reduced one by one, see UpdateReducedContours()
+  m_ReduceFilter->SetReduceFirstInputOnly(true);
+  m_NormalsFilter->SetUseProgressBar(false);
   m_InterpolateSurfaceFilter->SetUseProgressBar(true);
   m_InterpolateSurfaceFilter->SetProgressStepSize(7);
+  // many contours would make the dense equation system of the global RBF unusable
+  m_InterpolateSurfaceFilter->SetRBFType(CreateDistanceImageFromSurfaceFilter::RBF_AUTOMATIC);
+  m_InterpolateSurfaceFilter->SetReuseDistanceValues(true);
 
   m_Contours = Surface::New();
 
@@ -101,6 +157,10 @@ mitk::SurfaceInterpolationController::SurfaceInterpolationController()
 
 mitk::SurfaceInterpolationController::~SurfaceInterpolationController()
 {
+  // events of the remaining interpolations are dropped
+  m_GUIThreadCallbackTarget->store(nullptr);
+  this->WaitForInterpolation();
+
   // Removing all observers
   auto dataIter = m_SegmentationObserverTags.begin();
   for (; dataIter != m_SegmentationObserverTags.end(); ++dataIter)
@@ -177,14 +237,11 @@ void mitk::SurfaceInterpolationController::AddToInterpolationPipeline(ContourPos
   // Don't save a new empty contour
   if (pos == -1 && newContour->GetVtkPolyData()->GetNumberOfPoints() > 0)
   {
-    m_ReduceFilter->SetInput(m_ListOfInterpolationSessions[m_SelectedSegmentation][m_CurrentTimeStep].size(),
-                             newContour);
     m_ListOfInterpolationSessions[m_SelectedSegmentation][m_CurrentTimeStep].push_back(contourInfo);
   }
   else if (pos != -1 && newContour->GetVtkPolyData()->GetNumberOfPoints() > 0)
   {
     m_ListOfInterpolationSessions[m_SelectedSegmentation][m_CurrentTimeStep].at(pos) = contourInfo;
-    m_ReduceFilter->SetInput(pos, newContour);
   }
   else if (newContour->GetVtkPolyData()->GetNumberOfPoints() == 0)
   {
@@ -261,41 +318,185 @@ unsigned int mitk::SurfaceInterpolationController::GetNumberOfContours()
 
 void mitk::SurfaceInterpolationController::Interpolate()
 {
-  m_ReduceFilter->Update();
+  this->Interpolate(this->GetInterpolationInput());
+}
 
-  m_CurrentNumberOfReducedContours = m_ReduceFilter->GetNumberOfOutputs();
-  if (m_CurrentNumberOfReducedContours == 1)
+void mitk::SurfaceInterpolationController::InterpolateAsync()
+{
+  std::unique_ptr<InterpolationInput> input(new InterpolationInput(this->GetInterpolationInput()));
+
+  // the segmentation may be edited while the interpolation is running
+  if (input->segmentation.IsNotNull())
   {
-    vtkPolyData *tmp = m_ReduceFilter->GetOutput(0)->GetVtkPolyData();
-    if (tmp == nullptr)
+    mitk::ImageReadAccessor accessor(input->segmentation, input->segmentation->GetVolumeData(input->timeStep));
+    input->timeStepImage = mitk::Image::New();
+    input->timeStepImage->Initialize(input->segmentation->GetPixelType(),
+                                     *input->segmentation->GetSlicedGeometry(input->timeStep));
+    input->timeStepImage->SetVolume(accessor.GetData());
+  }
+
+  std::lock_guard<std::mutex> lock(m_InterpolationThreadMutex);
+  // a pending request is replaced, its contours are outdated anyway
+  m_PendingInterpolationInput = std::move(input);
+
+  if (m_InterpolationThreadRunning)
+    return;
+
+  // the previous thread has finished its last interpolation
+  if (m_InterpolationThread.joinable())
+    m_InterpolationThread.join();
+
+  m_InterpolationThreadRunning = true;
+  m_InterpolationThread = std::thread(&SurfaceInterpolationController::RunInterpolationThread, this);
+}
+
+bool mitk::SurfaceInterpolationController::IsInterpolating() const
+{
+  std::lock_guard<std::mutex> lock(m_InterpolationThreadMutex);
+  return m_InterpolationThreadRunning;
+}
+
+void mitk::SurfaceInterpolationController::WaitForInterpolation()
+{
+  std::unique_lock<std::mutex> lock(m_InterpolationThreadMutex);
+  m_InterpolationThreadFinished.wait(lock, [this] { return !m_InterpolationThreadRunning; });
+
+  // the thread does not lock the mutex anymore
+  if (m_InterpolationThread.joinable())
+    m_InterpolationThread.join();
+  lock.unlock();
+
+  if (!mitk::CallbackFromGUIThread::HasImplementation() && nullptr != m_GUIThreadCallbackTarget->load())
+    this->InvokeInterpolationFinishedEvents();
+}
+
+void mitk::SurfaceInterpolationController::InvokeInterpolationFinishedEvents()
+{
+  unsigned int numberOfFinishedInterpolations = 0;
+  {
+    std::lock_guard<std::mutex> lock(m_InterpolationThreadMutex);
+    std::swap(numberOfFinishedInterpolations, m_NumberOfFinishedInterpolations);
+  }
+
+  for (unsigned int i = 0; i < numberOfFinishedInterpolations; ++i)
+  {
+    this->InvokeEvent(SurfaceInterpolationFinishedEvent());
+  }
+}
+
+void mitk::SurfaceInterpolationController::RunInterpolationThread()
+{
+  bool finished = false;
+  while (!finished)
+  {
+    std::unique_ptr<InterpolationInput> input;
+    {
+      std::lock_guard<std::mutex> lock(m_InterpolationThreadMutex);
+      input = std::move(m_PendingInterpolationInput);
+    }
+
+    try
+    {
+      this->Interpolate(*input);
+    }
+    catch (const std::exception &e)
+    {
+      MITK_ERROR << "3D interpolation failed: " << e.what();
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(m_InterpolationThreadMutex);
+      ++m_NumberOfFinishedInterpolations;
+      if (!m_PendingInterpolationInput)
+      {
+        m_InterpolationThreadRunning = false;
+        finished = true;
+      }
+    }
+
+    // observers are not thread-safe, so the event is invoked from the GUI thread. The last event is invoked
+    // when IsInterpolating() already returns false
+    if (mitk::CallbackFromGUIThread::HasImplementation())
     {
-      m_CurrentNumberOfReducedContours = 0;
+      InterpolationFinishedCommand::Pointer command = InterpolationFinishedCommand::New();
+      command->SetTarget(m_GUIThreadCallbackTarget);
+      mitk::CallbackFromGUIThread::GetInstance()->CallThisFromGUIThread(command);
     }
+    if (finished)
+      m_InterpolationThreadFinished.notify_all();
   }
+}
 
-  mitk::ImageTimeSelector::Pointer timeSelector = mitk::ImageTimeSelector::New();
-  timeSelector->SetInput(m_SelectedSegmentation);
-  timeSelector->SetTimeNr(m_CurrentTimeStep);
-  timeSelector->SetChannelNr(0);
-  timeSelector->Update();
-  mitk::Image::Pointer refSegImage = timeSelector->GetOutput();
+mitk::SurfaceInterpolationController::InterpolationInput mitk::SurfaceInterpolationController::GetInterpolationInput()
+{
+  InterpolationInput input;
+  input.segmentation = m_SelectedSegmentation;
+  input.timeStep = m_CurrentTimeStep;
+  input.minSpacing = m_MinSpacing;
+  input.maxSpacing = m_MaxSpacing;
+  input.distanceImageVolume = m_DistanceImageVolume;
 
-  m_NormalsFilter->SetSegmentationBinaryImage(refSegImage);
-  for (unsigned int i = 0; i < m_CurrentNumberOfReducedContours; i++)
+  auto it = m_ListOfInterpolationSessions.find(m_SelectedSegmentation);
+  if (m_SelectedSegmentation && it != m_ListOfInterpolationSessions.end() && m_CurrentTimeStep < it->second.size())
   {
-    mitk::Surface::Pointer reducedContour = m_ReduceFilter->GetOutput(i);
-    reducedContour->DisconnectPipeline();
-    m_NormalsFilter->SetInput(i, reducedContour);
-    m_InterpolateSurfaceFilter->SetInput(i, m_NormalsFilter->GetOutput(i));
+    for (const auto &contourInfo : it->second[m_CurrentTimeStep])
+    {
+      input.contours.push_back(contourInfo.contour);
+    }
+  }
+  return input;
+}
+
+void mitk::SurfaceInterpolationController::Interpolate(const InterpolationInput &input)
+{
+  std::lock_guard<std::mutex> interpolationLock(m_InterpolationMutex);
+
+  if (input.segmentation.IsNull())
+  {
+    return;
+  }
+
+  mitk::Image::Pointer refSegImage = input.timeStepImage;
+  if (refSegImage.IsNull())
+  {
+    mitk::ImageTimeSelector::Pointer timeSelector = mitk::ImageTimeSelector::New();
+    timeSelector->SetInput(input.segmentation);
+    timeSelector->SetTimeNr(input.timeStep);
+    timeSelector->SetChannelNr(0);
+    timeSelector->Update();
+    refSegImage = timeSelector->GetOutput();
+  }
+
+  this->UpdateReducedContours(input, refSegImage);
+
+  unsigned int numberOfReducedContours(0);
+  unsigned int numberOfPointsAfterReduction(0);
+  for (const auto &reducedContour : m_ReducedContours)
+  {
+    numberOfPointsAfterReduction += reducedContour.numberOfPoints;
+    if (reducedContour.reducedContour.IsNotNull())
+    {
+      m_InterpolateSurfaceFilter->SetInput(numberOfReducedContours, reducedContour.reducedContour);
+      ++numberOfReducedContours;
+    }
   }
+  m_InterpolateSurfaceFilter->SetNumberOfIndexedInputs(numberOfReducedContours);
 
-  if (m_CurrentNumberOfReducedContours < 2)
+  if (numberOfReducedContours < 2)
   {
     // If no interpolation is possible reset the interpolation result
+    std::lock_guard<std::mutex> resultLock(m_ResultMutex);
     m_InterpolationResult = nullptr;
+    m_CurrentNumberOfReducedContours = numberOfReducedContours;
+    m_NumberOfPointsAfterReduction = numberOfPointsAfterReduction;
     return;
   }
 
+  itk::ImageBase<3>::Pointer itkImage = itk::ImageBase<3>::New();
+  AccessFixedDimensionByItk_1(refSegImage, GetImageBase, 3, itkImage);
+  m_InterpolateSurfaceFilter->SetReferenceImage(itkImage.GetPointer());
+  m_InterpolateSurfaceFilter->SetDistanceImageVolume(input.distanceImageVolume);
+
   // Setting up progress bar
   mitk::ProgressBar::GetInstance()->AddStepsToDo(10);
 
@@ -308,33 +509,156 @@ void mitk::SurfaceInterpolationController::Interpolate()
   imageToSurfaceFilter->Update();
 
   mitk::Surface::Pointer interpolationResult = mitk::Surface::New();
-  interpolationResult->SetVtkPolyData(imageToSurfaceFilter->GetOutput()->GetVtkPolyData(), m_CurrentTimeStep);
-  m_InterpolationResult = interpolationResult;
+  interpolationResult->SetVtkPolyData(imageToSurfaceFilter->GetOutput()->GetVtkPolyData(), input.timeStep);
+  interpolationResult->DisconnectPipeline();
 
-  m_DistanceImageSpacing = m_InterpolateSurfaceFilter->GetDistanceImageSpacing();
+  // the next interpolation must not overwrite the published distance image
+  mitk::Image::Pointer distanceImage = m_InterpolateSurfaceFilter->GetOutput();
+  distanceImage->DisconnectPipeline();
 
   vtkSmartPointer<vtkAppendPolyData> polyDataAppender = vtkSmartPointer<vtkAppendPolyData>::New();
-  for (unsigned int i = 0; i < m_ListOfInterpolationSessions[m_SelectedSegmentation][m_CurrentTimeStep].size(); i++)
+  for (const auto &contour : input.contours)
   {
-    polyDataAppender->AddInputData(
-      m_ListOfInterpolationSessions[m_SelectedSegmentation][m_CurrentTimeStep].at(i).contour->GetVtkPolyData());
+    polyDataAppender->AddInputData(contour->GetVtkPolyData());
   }
   polyDataAppender->Update();
-  m_Contours->SetVtkPolyData(polyDataAppender->GetOutput());
+
+  {
+    std::lock_guard<std::mutex> resultLock(m_ResultMutex);
+    m_InterpolationResult = interpolationResult;
+    m_DistanceImage = distanceImage;
+    m_DistanceImageSpacing = m_InterpolateSurfaceFilter->GetDistanceImageSpacing();
+    m_CurrentNumberOfReducedContours = numberOfReducedContours;
+    m_NumberOfPointsAfterReduction = numberOfPointsAfterReduction;
+    m_Contours->SetVtkPolyData(polyDataAppender->GetOutput());
+  }
 
   // Last progress step
   mitk::ProgressBar::GetInstance()->Progress(20);
+}
+
+void mitk::SurfaceInterpolationController::UpdateReducedContours(const InterpolationInput &input,
+                                                                 mitk::Image *referenceImage)
+{
+  if (input.segmentation.GetPointer() != m_ReducedContoursSegmentation ||
+      input.timeStep != m_ReducedContoursTimeStep || input.minSpacing != m_ReducedContoursMinSpacing ||
+      input.maxSpacing != m_ReducedContoursMaxSpacing)
+  {
+    m_ReducedContours.clear();
+    m_InterpolateSurfaceFilter->Reset();
+    m_ReducedContoursSegmentation = input.segmentation;
+    m_ReducedContoursTimeStep = input.timeStep;
+    m_ReducedContoursMinSpacing = input.minSpacing;
+    m_ReducedContoursMaxSpacing = input.maxSpacing;
+  }
+
+  std::map<const mitk::Surface *, std::size_t> cachedContours;
+  for (std::size_t i = 0; i < m_ReducedContours.size(); ++i)
+  {
+    cachedContours[m_ReducedContours[i].contour] = i;
+  }
+
+  // Contours that were added, changed or removed since the last interpolation
+  std::vector<mitk::Vector3D> changedNormals;
+  std::vector<bool> cachedContourUsed(m_ReducedContours.size(), false);
+  std::vector<ReducedContour> reducedContours;
+  std::vector<bool> reduce;
+
+  for (const auto &contour : input.contours)
+  {
+    auto cached = cachedContours.find(contour);
+    if (cached != cachedContours.end() && m_ReducedContours[cached->second].contourMTime == contour->GetMTime())
+    {
+      cachedContourUsed[cached->second] = true;
+      reducedContours.push_back(m_ReducedContours[cached->second]);
+      reduce.push_back(false);
+    }
+    else
+    {
+      ReducedContour reducedContour;
+      reducedContour.contour = contour;
+      reducedContour.contourMTime = contour->GetMTime();
+      reducedContour.contourNormal = CreateContourPositionInformation(contour).contourNormal;
+      reducedContour.numberOfPoints = 0;
+      reducedContours.push_back(reducedContour);
+      reduce.push_back(true);
+      changedNormals.push_back(reducedContour.contourNormal);
+    }
+  }
+
+  for (std::size_t i = 0; i < m_ReducedContours.size(); ++i)
+  {
+    if (!cachedContourUsed[i])
+      changedNormals.push_back(m_ReducedContours[i].contourNormal);
+  }
+
+  // A changed contour can turn other contours into intersection contours or end that
+  for (std::size_t i = 0; i < reducedContours.size(); ++i)
+  {
+    for (std::size_t j = 0; j < changedNormals.size() && !reduce[i]; ++j)
+    {
+      reduce[i] = !ContoursParallel(reducedContours[i].contourNormal, changedNormals[j]);
+    }
+  }
+
+  m_ReduceFilter->SetMinSpacing(input.minSpacing);
+  m_ReduceFilter->SetMaxSpacing(input.maxSpacing);
+  m_NormalsFilter->SetMaxSpacing(input.maxSpacing);
+  m_NormalsFilter->SetSegmentationBinaryImage(referenceImage);
+
+  for (std::size_t i = 0; i < reducedContours.size(); ++i)
+  {
+    if (!reduce[i])
+      continue;
+
+    // The other contours are only needed to detect intersection contours
+    m_ReduceFilter->Reset();
+    m_ReduceFilter->SetInput(0, input.contours[i]);
+    unsigned int index(1);
+    for (std::size_t j = 0; j < input.contours.size(); ++j)
+    {
+      if (j != i)
+        m_ReduceFilter->SetInput(index++, input.contours[j]);
+    }
+    m_ReduceFilter->Update();
 
-  m_InterpolationResult->DisconnectPipeline();
+    mitk::Surface::Pointer reducedContour = m_ReduceFilter->GetOutput(0);
+    vtkPolyData *polyData = reducedContour->GetVtkPolyData();
+    if (polyData == nullptr || polyData->GetNumberOfPolys() == 0)
+    {
+      reducedContours[i].reducedContour = nullptr;
+      reducedContours[i].numberOfPoints = 0;
+      continue;
+    }
+    reducedContour->DisconnectPipeline();
+
+    m_NormalsFilter->Reset();
+    m_NormalsFilter->SetInput(0, reducedContour);
+    m_NormalsFilter->Update();
+
+    reducedContours[i].reducedContour = m_NormalsFilter->GetOutput(0);
+    reducedContours[i].reducedContour->DisconnectPipeline();
+    reducedContours[i].numberOfPoints = m_ReduceFilter->GetNumberOfPointsAfterReduction();
+  }
+
+  m_ReducedContours.swap(reducedContours);
 }
 
 mitk::Surface::Pointer mitk::SurfaceInterpolationController::GetInterpolationResult()
 {
+  std::lock_guard<std::mutex> lock(m_ResultMutex);
   return m_InterpolationResult;
 }
 
+double mitk::SurfaceInterpolationController::GetDistanceImageSpacing() const
+{
+  std::lock_guard<std::mutex> lock(m_ResultMutex);
+  return m_DistanceImageSpacing;
+}
+
 mitk::Surface *mitk::SurfaceInterpolationController::GetContoursAsSurface()
 {
+  std::lock_guard<std::mutex> lock(m_ResultMutex);
   return m_Contours;
 }
 
@@ -345,18 +669,17 @@ void mitk::SurfaceInterpolationController::SetDataStorage(DataStorage::Pointer d
 
 void mitk::SurfaceInterpolationController::SetMinSpacing(double minSpacing)
 {
-  m_ReduceFilter->SetMinSpacing(minSpacing);
+  m_MinSpacing = minSpacing;
 }
 
 void mitk::SurfaceInterpolationController::SetMaxSpacing(double maxSpacing)
 {
-  m_ReduceFilter->SetMaxSpacing(maxSpacing);
-  m_NormalsFilter->SetMaxSpacing(maxSpacing);
+  m_MaxSpacing = maxSpacing;
 }
 
 void mitk::SurfaceInterpolationController::SetDistanceImageVolume(unsigned int distImgVolume)
 {
-  m_InterpolateSurfaceFilter->SetDistanceImageVolume(distImgVolume);
+  m_DistanceImageVolume = distImgVolume;
 }
 
 mitk::Image::Pointer mitk::SurfaceInterpolationController::GetCurrentSegmentation()
@@ -366,12 +689,28 @@ mitk::Image::Pointer mitk::SurfaceInterpolationController::GetCurrentSegmentatio
 
 mitk::Image *mitk::SurfaceInterpolationController::GetImage()
 {
-  return m_InterpolateSurfaceFilter->GetOutput();
+  std::lock_guard<std::mutex> lock(m_ResultMutex);
+  return m_DistanceImage;
 }
 
 double mitk::SurfaceInterpolationController::EstimatePortionOfNeededMemory()
 {
-  double numberOfPointsAfterReduction = m_ReduceFilter->GetNumberOfPointsAfterReduction() * 3;
+  unsigned int numberOfPoints(0);
+  {
+    std::lock_guard<std::mutex> lock(m_ResultMutex);
+    numberOfPoints = m_NumberOfPointsAfterReduction;
+  }
+
+  // Before the first interpolation the unreduced contours are an upper bound
+  if (numberOfPoints == 0)
+  {
+    for (const auto &contour : this->GetInterpolationInput().contours)
+    {
+      numberOfPoints += contour->GetVtkPolyData()->GetNumberOfPoints();
+    }
+  }
+
+  double numberOfPointsAfterReduction = numberOfPoints * 3;
   double sizeOfPoints = pow(numberOfPointsAfterReduction, 2) * sizeof(double);
   double totalMem = mitk::MemoryUtilities::GetTotalSizeOfPhysicalRam();
   double percentage = sizeOfPoints / totalMem;
@@ -458,14 +797,6 @@ bool mitk::SurfaceInterpolationController::ReplaceInterpolationSession(mitk::Ima
   if (m_SelectedSegmentation == oldSession)
     m_SelectedSegmentation = newSession;
 
-  mitk::ImageTimeSelector::Pointer timeSelector = mitk::ImageTimeSelector::New();
-  timeSelector->SetInput(m_SelectedSegmentation);
-  timeSelector->SetTimeNr(m_CurrentTimeStep);
-  timeSelector->SetChannelNr(0);
-  timeSelector->Update();
-  mitk::Image::Pointer refSegImage = timeSelector->GetOutput();
-  m_NormalsFilter->SetSegmentationBinaryImage(refSegImage);
-
   this->RemoveInterpolationSession(oldSession);
   return true;
 }
@@ -481,7 +812,6 @@ void mitk::SurfaceInterpolationController::RemoveInterpolationSession(mitk::Imag
   {
     if (m_SelectedSegmentation == segmentationImage)
     {
-      m_NormalsFilter->SetSegmentationBinaryImage(nullptr);
       m_SelectedSegmentation = nullptr;
     }
     m_ListOfInterpolationSessions.erase(segmentationImage);
@@ -627,7 +957,6 @@ void mitk::SurfaceInterpolationController::OnSegmentationDeleted(const itk::Obje
   {
     if (m_SelectedSegmentation == tempImage)
     {
-      m_NormalsFilter->SetSegmentationBinaryImage(nullptr);
       m_SelectedSegmentation = nullptr;
     }
     m_SegmentationObserverTags.erase(tempImage);
@@ -637,24 +966,9 @@ void mitk::SurfaceInterpolationController::OnSegmentationDeleted(const itk::Obje
 
 void mitk::SurfaceInterpolationController::ReinitializeInterpolation()
 {
-  // If session has changed reset the pipeline
-  m_ReduceFilter->Reset();
-  m_NormalsFilter->Reset();
-  m_InterpolateSurfaceFilter->Reset();
-
-  itk::ImageBase<3>::Pointer itkImage = itk::ImageBase<3>::New();
-
+  // The reduced contours of the session are updated by the next interpolation
   if (m_SelectedSegmentation)
   {
-    mitk::ImageTimeSelector::Pointer timeSelector = mitk::ImageTimeSelector::New();
-    timeSelector->SetInput(m_SelectedSegmentation);
-    timeSelector->SetTimeNr(m_CurrentTimeStep);
-    timeSelector->SetChannelNr(0);
-    timeSelector->Update();
-    mitk::Image::Pointer refSegImage = timeSelector->GetOutput();
-    AccessFixedDimensionByItk_1(refSegImage, GetImageBase, 3, itkImage);
-    m_InterpolateSurfaceFilter->SetReferenceImage(itkImage.GetPointer());
-
     unsigned int numTimeSteps = m_SelectedSegmentation->GetTimeSteps();
     unsigned int size = m_ListOfInterpolationSessions[m_SelectedSegmentation].size();
     if (size != numTimeSteps)
@@ -662,34 +976,6 @@ void mitk::SurfaceInterpolationController::ReinitializeInterpolation()
       m_ListOfInterpolationSessions[m_SelectedSegmentation].resize(numTimeSteps);
     }
 
-    if (m_CurrentTimeStep < numTimeSteps)
-    {
-      unsigned int numContours = m_ListOfInterpolationSessions[m_SelectedSegmentation][m_CurrentTimeStep].size();
-      for (unsigned int c = 0; c < numContours; ++c)
-      {
-        m_ReduceFilter->SetInput(c,
-                                 m_ListOfInterpolationSessions[m_SelectedSegmentation][m_CurrentTimeStep][c].contour);
-      }
-
-      m_ReduceFilter->Update();
-
-      m_CurrentNumberOfReducedContours = m_ReduceFilter->GetNumberOfOutputs();
-      if (m_CurrentNumberOfReducedContours == 1)
-      {
-        vtkPolyData *tmp = m_ReduceFilter->GetOutput(0)->GetVtkPolyData();
-        if (tmp == nullptr)
-        {
-          m_CurrentNumberOfReducedContours = 0;
-        }
-      }
-
-      for (unsigned int i = 0; i < m_CurrentNumberOfReducedContours; i++)
-      {
-        m_NormalsFilter->SetInput(i, m_ReduceFilter->GetOutput(i));
-        m_InterpolateSurfaceFilter->SetInput(i, m_NormalsFilter->GetOutput(i));
-      }
-    }
-
     Modified();
   }
 }
@@ -43,15 +43,38 @@ found in the LICENSE file.
 
 #include "mitkProgressBar.h"
 
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
 namespace mitk
 {
+  /**
+   * \brief Invoked by the SurfaceInterpolationController after each interpolation started by InterpolateAsync().
+   *
+   * The event is invoked from the GUI thread if a mitk::CallbackFromGUIThreadImplementation is registered,
+   * otherwise from WaitForInterpolation().
+   */
+  itkEventMacro(SurfaceInterpolationFinishedEvent, itk::AnyEvent);
+
+  /**
+   * \brief Manages the contours of the 3D interpolation for several segmentations and interpolates their surfaces.
+   *
+   * The reduced contours and their normals are cached per contour. An interpolation only reduces the contours
+   * that have been added or changed since the last one and the contours that are not parallel to them, since only
+   * these can intersect. The distance image is only evaluated again near changed contours if the compactly
+   * supported RBF is used, see CreateDistanceImageFromSurfaceFilter::SetReuseDistanceValues().
+   */
   class MITKSURFACEINTERPOLATION_EXPORT SurfaceInterpolationController : public itk::Object
   {
   public:
     mitkClassMacroItkParent(SurfaceInterpolationController, itk::Object);
     itkFactorylessNewMacro(Self);
     itkCloneMacro(Self);
-    itkGetMacro(DistanceImageSpacing, double);
+
+    double GetDistanceImageSpacing() const;
 
     struct ContourPositionInformation
     {
@@ -120,6 +143,34 @@ namespace mitk
      */
     void Interpolate();
 
+    /**
+     * @brief Interpolates the 3D surface from the given extracted contours in a background thread and returns
+     *        immediately.
+     *
+     * The contours and a copy of the current time step of the segmentation are taken at the time of the call. If an
+     * interpolation is already running, they are interpolated as soon as it has finished. Requests in the meantime
+     * are merged, so that only the most recent contours are interpolated. A SurfaceInterpolationFinishedEvent is
+     * invoked from the GUI thread after each interpolation, see mitk::CallbackFromGUIThread. Without a GUI thread,
+     * the events are invoked by WaitForInterpolation().
+     */
+    void InterpolateAsync();
+
+    /**
+     * @brief Returns true while an interpolation started by InterpolateAsync() is running or pending
+     */
+    bool IsInterpolating() const;
+
+    /**
+     * @brief Blocks until all interpolations started by InterpolateAsync() have finished
+     */
+    void WaitForInterpolation();
+
+    /**
+     * @brief Invokes a SurfaceInterpolationFinishedEvent for each interpolation that has finished since the last call.
+     *        Called from the GUI thread.
+     */
+    void InvokeInterpolationFinishedEvents();
+
     mitk::Surface::Pointer GetInterpolationResult();
 
     /**
@@ -216,6 +267,39 @@ namespace mitk
     void GetImageBase(itk::Image<TPixel, VImageDimension> *input, itk::ImageBase<3>::Pointer &result);
 
   private:
+    /** The contours of the current session and the settings at the time an interpolation is requested */
+    struct InterpolationInput
+    {
+      mitk::Image::Pointer segmentation;
+      unsigned int timeStep;
+      /** Copy of the time step of the segmentation, taken by InterpolateAsync() before the interpolation starts */
+      mitk::Image::Pointer timeStepImage;
+      std::vector<Surface::Pointer> contours;
+      double minSpacing;
+      double maxSpacing;
+      unsigned int distanceImageVolume;
+    };
+
+    /** The cached result of ReduceContourSetFilter and ComputeContourSetNormalsFilter for a single contour */
+    struct ReducedContour
+    {
+      Surface::Pointer contour;
+      itk::ModifiedTimeType contourMTime;
+      Vector3D contourNormal;
+      /** The reduced contour with normals, nullptr if it has been eliminated as intersection contour */
+      Surface::Pointer reducedContour;
+      unsigned int numberOfPoints;
+    };
+
+    InterpolationInput GetInterpolationInput();
+
+    void Interpolate(const InterpolationInput &input);
+
+    /** Updates m_ReducedContours to the contours of the input */
+    void UpdateReducedContours(const InterpolationInput &input, mitk::Image *referenceImage);
+
+    void RunInterpolationThread();
+
     void ReinitializeInterpolation();
 
     void OnSegmentationDeleted(const itk::Object *caller, const itk::EventObject &event);
@@ -245,6 +329,35 @@ namespace mitk
     std::map<mitk::Image *, unsigned long> m_SegmentationObserverTags;
 
     unsigned int m_CurrentTimeStep;
+
+    double m_MinSpacing;
+    double m_MaxSpacing;
+    unsigned int m_DistanceImageVolume;
+
+    // cache of the reduced contours, only used while m_InterpolationMutex is locked
+    std::vector<ReducedContour> m_ReducedContours;
+    const mitk::Image *m_ReducedContoursSegmentation;
+    unsigned int m_ReducedContoursTimeStep;
+    double m_ReducedContoursMinSpacing;
+    double m_ReducedContoursMaxSpacing;
+
+    mitk::Image::Pointer m_DistanceImage;
+    unsigned int m_NumberOfPointsAfterReduction;
+
+    /** Serializes the interpolations, which share the filters and the cache of the reduced contours */
+    std::mutex m_InterpolationMutex;
+    /** Guards the results, i.e. m_InterpolationResult, m_Contours, m_DistanceImage and the numbers */
+    mutable std::mutex m_ResultMutex;
+
+    mutable std::mutex m_InterpolationThreadMutex;
+    std::condition_variable m_InterpolationThreadFinished;
+    std::thread m_InterpolationThread;
+    std::unique_ptr<InterpolationInput> m_PendingInterpolationInput;
+    bool m_InterpolationThreadRunning;
+    /** Number of finished interpolations whose event has not been invoked yet */
+    unsigned int m_NumberOfFinishedInterpolations;
+    /** Points to this controller as long as it exists, shared with the callbacks posted to the GUI thread */
+    std::shared_ptr<std::atomic<itk::Object *>> m_GUIThreadCallbackTarget;
   };
 }
 #endif